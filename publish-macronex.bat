@@ -11,16 +11,11 @@ set OUTPUT=artifacts\publish\%RID%
 
 cd /d "%~dp0"
 
+REM Single-file, ReadyToRun and tiered PGO settings live in the publish profile:
+REM   src\MacroNex.Presentation\Properties\PublishProfiles\%RID%.pubxml
 dotnet publish "%PROJECT%" ^
   -c %CONFIG% ^
-  -r %RID% ^
-  --self-contained true ^
-  /p:PublishSingleFile=true ^
-  /p:EnableCompressionInSingleFile=true ^
-  /p:IncludeNativeLibrariesForSelfExtract=true ^
-  /p:PublishReadyToRun=true ^
-  /p:DebugType=None ^
-  /p:DebugSymbols=false ^
+  /p:PublishProfile=%RID% ^
   -o "%OUTPUT%"
 
 if errorlevel 1 (
@@ -0,0 +1,152 @@
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Input simulator seen by one execution: every input call takes a turn on the shared device through the
+/// execution's <see cref="InputLane"/>. Delays and cursor reads deliver an open batch first, so they take a
+/// turn for that part only; a sleeping script never holds the device.
+/// </summary>
+public sealed class ArbitratedInputSimulator : IInputSimulator
+{
+    private readonly IInputSimulator _inner;
+    private readonly InputLane _lane;
+
+    public ArbitratedInputSimulator(IInputSimulator inner, InputLane lane)
+    {
+        _inner = inner ?? throw new ArgumentNullException(nameof(inner));
+        _lane = lane ?? throw new ArgumentNullException(nameof(lane));
+    }
+
+    public async Task SimulateMouseMoveAsync(Point position)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMoveAsync(position).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMoveAsync(Point position, CancellationToken cancellationToken)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMoveAsync(position, cancellationToken).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMoveLowLevelAsync(Point position)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMoveLowLevelAsync(position).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMoveRelativeAsync(int deltaX, int deltaY)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMoveRelativeAsync(deltaX, deltaY).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMoveRelativeLowLevelAsync(deltaX, deltaY).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMotionAsync(samples).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseMotionLowLevelAsync(samples).ConfigureAwait(false);
+    }
+
+    public async Task SimulateMouseClickAsync(MouseButton button, ClickType type)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateMouseClickAsync(button, type).ConfigureAwait(false);
+    }
+
+    public async Task SimulateKeyboardInputAsync(string text)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateKeyboardInputAsync(text).ConfigureAwait(false);
+    }
+
+    public async Task SimulateKeyPressAsync(VirtualKey key, bool isDown)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateKeyPressAsync(key, isDown).ConfigureAwait(false);
+    }
+
+    public async Task SimulateKeyComboAsync(IEnumerable<VirtualKey> keys)
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        await _inner.SimulateKeyComboAsync(keys).ConfigureAwait(false);
+    }
+
+    public async Task DelayAsync(TimeSpan duration)
+    {
+        if (duration < TimeSpan.Zero)
+            throw new ArgumentException("Duration cannot be negative", nameof(duration));
+
+        // A zero delay only delivers what this execution has batched; the sleep itself runs without the turn
+        using (await _lane.AcquireAsync().ConfigureAwait(false))
+        {
+            await _inner.DelayAsync(TimeSpan.Zero).ConfigureAwait(false);
+        }
+
+        if (duration > TimeSpan.Zero)
+            await _inner.DelayAsync(duration).ConfigureAwait(false);
+    }
+
+    public async Task<Point> GetCursorPositionAsync()
+    {
+        using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+        return await _inner.GetCursorPositionAsync().ConfigureAwait(false);
+    }
+
+    public Task<bool> IsReadyAsync() => _inner.IsReadyAsync();
+
+    /// <summary>
+    /// Skips the lane: an emergency release must not queue behind the script it stops.
+    /// </summary>
+    public Task ReleaseAllAsync() => _inner.ReleaseAllAsync();
+
+    public IInputBatch BeginBatch()
+    {
+        var batch = _inner.BeginBatch();
+        return ReferenceEquals(batch, ImmediateInputBatch.Instance) ? batch : new ArbitratedInputBatch(batch, _lane);
+    }
+
+    /// <summary>
+    /// Submits the buffered events of an inner batch during a turn, so a batch stays atomic on the device.
+    /// </summary>
+    private sealed class ArbitratedInputBatch : IInputBatch
+    {
+        private readonly IInputBatch _inner;
+        private readonly InputLane _lane;
+
+        public ArbitratedInputBatch(IInputBatch inner, InputLane lane)
+        {
+            _inner = inner;
+            _lane = lane;
+        }
+
+        public int PendingCount => _inner.PendingCount;
+
+        public async Task FlushAsync()
+        {
+            using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+            await _inner.FlushAsync().ConfigureAwait(false);
+        }
+
+        public async Task CommitAsync()
+        {
+            using var turn = await _lane.AcquireAsync().ConfigureAwait(false);
+            await _inner.CommitAsync().ConfigureAwait(false);
+        }
+
+        public ValueTask DisposeAsync() => _inner.DisposeAsync();
+    }
+}
@@ -21,6 +21,8 @@ public sealed class ArduinoConnectionService : IDisposable
         // Subscribe to connection state changes
         _arduinoService.ConnectionStateChanged += OnConnectionStateChanged;
         _arduinoService.ErrorOccurred += OnErrorOccurred;
+        if (_arduinoService is IArduinoDevicePool pool)
+            pool.DeviceStateChanged += OnDeviceStateChanged;
     }
 
     /// <summary>
@@ -28,6 +30,12 @@ public sealed class ArduinoConnectionService : IDisposable
     /// </summary>
     public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
 
+    /// <summary>
+    /// Raised when the state of a single device changes. Only raised when the Arduino service is an
+    /// <see cref="IArduinoDevicePool"/>; <see cref="ConnectionStateChanged"/> covers the aggregate state.
+    /// </summary>
+    public event EventHandler<ArduinoConnectionStateChangedEventArgs>? DeviceStateChanged;
+
     /// <summary>
     /// Gets the current connection state.
     /// </summary>
@@ -43,6 +51,74 @@ public sealed class ArduinoConnectionService : IDisposable
     /// </summary>
     public string? ConnectedPortName => _arduinoService.ConnectedPortName;
 
+    /// <summary>
+    /// Gets the ports of all connected devices, primary first. Holds at most one port unless the Arduino
+    /// service is an <see cref="IArduinoDevicePool"/>.
+    /// </summary>
+    public IReadOnlyList<string> ConnectedPortNames
+    {
+        get
+        {
+            if (_arduinoService is IArduinoDevicePool pool)
+                return pool.ConnectedPortNames;
+
+            var portName = _arduinoService.ConnectedPortName;
+            return _arduinoService.IsConnected && portName != null ? new[] { portName } : Array.Empty<string>();
+        }
+    }
+
+    /// <summary>
+    /// Gets whether more than one Arduino can be connected at the same time.
+    /// </summary>
+    public bool SupportsMultipleDevices => _arduinoService is IArduinoDevicePool;
+
+    /// <summary>
+    /// Gets whether another device can be connected: always with a device pool, otherwise only while disconnected.
+    /// </summary>
+    public bool CanConnectMoreDevices => SupportsMultipleDevices || !_arduinoService.IsConnected;
+
+    /// <summary>
+    /// Gets whether a device is connected on the specified port.
+    /// </summary>
+    public bool IsPortConnected(string portName)
+        => ConnectedPortNames.Contains(portName, StringComparer.OrdinalIgnoreCase);
+
+    /// <summary>
+    /// Gets or sets how commands are routed across connected devices, or null when only one device is supported.
+    /// </summary>
+    /// <exception cref="NotSupportedException">Thrown when set and the Arduino service is not a device pool.</exception>
+    public ArduinoRoutingOptions? Routing
+    {
+        get => (_arduinoService as IArduinoDevicePool)?.Routing;
+        set
+        {
+            ArgumentNullException.ThrowIfNull(value);
+            if (_arduinoService is not IArduinoDevicePool pool)
+                throw new NotSupportedException("The Arduino service does not support multiple devices.");
+
+            pool.Routing = value;
+            _logger.LogInformation("Arduino routing set to {RoutingMode}", value.Mode);
+        }
+    }
+
+    /// <summary>
+    /// Gets the health of every device and of the connection as a whole.
+    /// </summary>
+    public ArduinoPoolHealth GetHealth()
+    {
+        if (_arduinoService is IArduinoDevicePool pool)
+            return pool.GetHealth();
+
+        var state = _arduinoService.ConnectionState;
+        var portName = _arduinoService.ConnectedPortName;
+        var connected = state == ArduinoConnectionState.Connected;
+        var roles = connected ? ArduinoDeviceRoles.Mouse | ArduinoDeviceRoles.Keyboard : ArduinoDeviceRoles.None;
+        var devices = portName != null
+            ? new[] { new ArduinoDeviceHealth(portName, state, connected, 0, null, null, roles) }
+            : Array.Empty<ArduinoDeviceHealth>();
+        return new ArduinoPoolHealth(state, _arduinoService.IsConnected ? 1 : 0, devices);
+    }
+
     /// <summary>
     /// Gets a list of available serial ports.
     /// </summary>
@@ -58,6 +134,19 @@ public sealed class ArduinoConnectionService : IDisposable
     /// </summary>
     public Task DisconnectAsync() => _arduinoService.DisconnectAsync();
 
+    /// <summary>
+    /// Disconnects the Arduino on one port, leaving any other connected devices in place.
+    /// </summary>
+    public Task DisconnectAsync(string portName)
+    {
+        if (_arduinoService is IArduinoDevicePool pool)
+            return pool.DisconnectAsync(portName);
+
+        return string.Equals(_arduinoService.ConnectedPortName, portName, StringComparison.OrdinalIgnoreCase)
+            ? _arduinoService.DisconnectAsync()
+            : Task.CompletedTask;
+    }
+
     /// <summary>
     /// Sends a command to the Arduino.
     /// </summary>
@@ -66,15 +155,40 @@ public sealed class ArduinoConnectionService : IDisposable
     public Task SendCommandAsync(ArduinoCommand command) => _arduinoService.SendCommandAsync(command);
 
     /// <summary>
-    /// Automatically detects and connects to an Arduino device.
-    /// Tries each available port until a successful connection is established.
+    /// Sends several commands to the Arduino as one contiguous write.
+    /// </summary>
+    /// <param name="commands">The commands to send, in order.</param>
+    /// <returns>A task that represents the asynchronous operation.</returns>
+    public Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands) => _arduinoService.SendCommandsAsync(commands);
+
+    /// <summary>
+    /// Waits until every queued command has been written to the Arduino.
+    /// </summary>
+    public Task FlushAsync() => _arduinoService.FlushAsync();
+
+    /// <summary>
+    /// Drops every queued command and has the firmware release all keys and buttons.
+    /// </summary>
+    public Task EmergencyStopAsync() => _arduinoService.EmergencyStopAsync();
+
+    /// <summary>
+    /// Automatically detects and connects to Arduino devices.
+    /// Tries each available port until <paramref name="deviceCount"/> devices are connected.
     /// </summary>
-    /// <returns>True if connection was successful, false otherwise.</returns>
-    public async Task<bool> AutoConnectAsync()
+    /// <param name="deviceCount">Number of devices wanted; more than one needs a device pool.</param>
+    /// <returns>True if at least one device is connected, false otherwise.</returns>
+    public async Task<bool> AutoConnectAsync(int deviceCount = 1)
     {
-        if (_arduinoService.IsConnected)
+        if (deviceCount < 1)
+            throw new ArgumentOutOfRangeException(nameof(deviceCount), "Device count must be at least 1.");
+
+        if (!SupportsMultipleDevices)
+            deviceCount = 1;
+
+        var connectedPorts = ConnectedPortNames;
+        if (connectedPorts.Count >= deviceCount)
         {
-            _logger.LogInformation("Arduino is already connected on port {PortName}", _arduinoService.ConnectedPortName);
+            _logger.LogInformation("Arduino is already connected on port {PortName}", string.Join(", ", connectedPorts));
             return true;
         }
 
@@ -82,13 +196,16 @@ public sealed class ArduinoConnectionService : IDisposable
         if (ports.Count == 0)
         {
             _logger.LogWarning("No serial ports available for Arduino connection");
-            return false;
+            return connectedPorts.Count > 0;
         }
 
         _logger.LogInformation("Attempting to auto-connect to Arduino. Checking {PortCount} available ports", ports.Count);
 
         foreach (var port in ports)
         {
+            if (connectedPorts.Contains(port, StringComparer.OrdinalIgnoreCase))
+                continue;
+
             try
             {
                 _logger.LogDebug("Attempting to connect to Arduino on port {PortName}", port);
@@ -97,10 +214,12 @@ public sealed class ArduinoConnectionService : IDisposable
                 // Wait a moment to see if connection succeeds
                 await Task.Delay(500);
                 
-                if (_arduinoService.IsConnected)
+                connectedPorts = ConnectedPortNames;
+                if (connectedPorts.Contains(port, StringComparer.OrdinalIgnoreCase))
                 {
                     _logger.LogInformation("Successfully auto-connected to Arduino on port {PortName}", port);
-                    return true;
+                    if (connectedPorts.Count >= deviceCount)
+                        return true;
                 }
             }
             catch (Exception ex)
@@ -110,6 +229,12 @@ public sealed class ArduinoConnectionService : IDisposable
             }
         }
 
+        if (connectedPorts.Count > 0)
+        {
+            _logger.LogWarning("Auto-connected {ConnectedCount} of {DeviceCount} requested Arduino devices", connectedPorts.Count, deviceCount);
+            return true;
+        }
+
         _logger.LogWarning("Failed to auto-connect to Arduino on any available port");
         return false;
     }
@@ -150,6 +275,11 @@ public sealed class ArduinoConnectionService : IDisposable
         ConnectionStateChanged?.Invoke(this, e);
     }
 
+    private void OnDeviceStateChanged(object? sender, ArduinoConnectionStateChangedEventArgs e)
+    {
+        DeviceStateChanged?.Invoke(this, e);
+    }
+
     private void OnErrorOccurred(object? sender, ArduinoErrorEventArgs e)
     {
         _logger.LogError(e.Exception, "Arduino error: {Message}", e.Message);
@@ -170,5 +300,7 @@ public sealed class ArduinoConnectionService : IDisposable
 
         _arduinoService.ConnectionStateChanged -= OnConnectionStateChanged;
         _arduinoService.ErrorOccurred -= OnErrorOccurred;
+        if (_arduinoService is IArduinoDevicePool pool)
+            pool.DeviceStateChanged -= OnDeviceStateChanged;
     }
 }
@@ -1,3 +1,4 @@
+using System.Collections.Concurrent;
 using MacroNex.Domain.Entities;
 using MacroNex.Domain.Events;
 using MacroNex.Domain.Interfaces;
@@ -9,6 +10,10 @@ namespace MacroNex.Application.Services;
 /// <summary>
 /// Application service for executing automation scripts.
 /// Provides start/pause/resume/stop/step/terminate controls and progress events.
+/// Several scripts can run at once, each with its own context; their input calls share each device
+/// through an <see cref="InputArbiter"/> according to <see cref="ExecutionOptions.Priority"/>.
+/// Terminating, or activating the kill switch, cancels every run and then releases whatever the devices
+/// still hold, without waiting for the runs to unwind.
 /// </summary>
 public sealed class ExecutionService : IExecutionService, IDisposable
 {
@@ -17,17 +22,17 @@ public sealed class ExecutionService : IExecutionService, IDisposable
     private readonly IGlobalHotkeyService _globalHotkeyService;
     private readonly ISafetyService _safetyService;
     private readonly LuaScriptRunner _luaRunner;
+    private readonly IInputLatencyMonitor? _latencyMonitor;
     private readonly ILogger<ExecutionService> _logger;
     private readonly object _lockObject = new();
 
     // 追蹤每個腳本的執行狀態（以腳本ID為鍵）
     private readonly Dictionary<Guid, ScriptExecutionContext> _activeExecutions = new();
 
-    // 向後兼容：保留最後啟動的腳本作為"當前"腳本
-    private CancellationTokenSource? _cts;
-    private Task? _executionTask;
-    private readonly ManualResetEventSlim _pauseEvent = new(true);
+    // 每個輸入裝置一個仲裁器（以模擬器實例為鍵，HighLevel/LowLevel 共用同一個軟體裝置）
+    private readonly ConcurrentDictionary<IInputSimulator, InputArbiter> _inputArbiters = new(ReferenceEqualityComparer.Instance);
 
+    // 向後兼容：保留最後啟動的腳本作為"當前"腳本
     private ExecutionSession? _session;
     private Script? _currentScript;
     private int _currentCommandIndex;
@@ -65,7 +70,7 @@ public sealed class ExecutionService : IExecutionService, IDisposable
         }
     }
 
-    public ExecutionService(IInputSimulatorFactory inputSimulatorFactory, ArduinoConnectionService arduinoConnectionService, IGlobalHotkeyService globalHotkeyService, ISafetyService safetyService, LuaScriptRunner luaRunner, ILogger<ExecutionService> logger)
+    public ExecutionService(IInputSimulatorFactory inputSimulatorFactory, ArduinoConnectionService arduinoConnectionService, IGlobalHotkeyService globalHotkeyService, ISafetyService safetyService, LuaScriptRunner luaRunner, ILogger<ExecutionService> logger, IInputLatencyMonitor? latencyMonitor = null)
     {
         _inputSimulatorFactory = inputSimulatorFactory ?? throw new ArgumentNullException(nameof(inputSimulatorFactory));
         _arduinoConnectionService = arduinoConnectionService ?? throw new ArgumentNullException(nameof(arduinoConnectionService));
@@ -73,6 +78,9 @@ public sealed class ExecutionService : IExecutionService, IDisposable
         _safetyService = safetyService ?? throw new ArgumentNullException(nameof(safetyService));
         _luaRunner = luaRunner ?? throw new ArgumentNullException(nameof(luaRunner));
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _latencyMonitor = latencyMonitor;
+
+        _safetyService.KillSwitchActivated += OnKillSwitchActivated;
     }
 
     public ExecutionState State
@@ -159,8 +167,6 @@ public sealed class ExecutionService : IExecutionService, IDisposable
             _activeExecutions[script.Id] = context;
 
             // 向後兼容：更新"當前"腳本為最後啟動的腳本
-            _cts = context.CancellationTokenSource;
-            _pauseEvent.Set(); // 保持向後兼容
             CurrentScript = script;
             CurrentCommandIndex = 0;
             CurrentSession = session;
@@ -172,12 +178,6 @@ public sealed class ExecutionService : IExecutionService, IDisposable
 
         // 啟動執行任務
         context.ExecutionTask = Task.Run(async () => await ExecutionLoopAsync(context), context.CancellationTokenSource.Token);
-
-        // 向後兼容：更新單一執行任務
-        lock (_lockObject)
-        {
-            _executionTask = context.ExecutionTask;
-        }
     }
 
     public Task PauseExecutionAsync()
@@ -326,7 +326,7 @@ public sealed class ExecutionService : IExecutionService, IDisposable
         throw new NotSupportedException("Step execution is not supported. Scripts are executed as a single unit.");
     }
 
-    public Task TerminateExecutionAsync()
+    public async Task TerminateExecutionAsync()
     {
         _logger.LogWarning("Terminate requested for all executions");
 
@@ -337,13 +337,26 @@ public sealed class ExecutionService : IExecutionService, IDisposable
             contextsToTerminate = _activeExecutions.Values.ToList();
         }
 
+        // Emergency path first: stop every run from issuing input, then release what the devices hold
         foreach (var context in contextsToTerminate)
         {
             try
             {
                 context.CancellationTokenSource.Cancel();
                 context.PauseEvent.Set();
+            }
+            catch (ObjectDisposedException)
+            {
+                // The run finished meanwhile
+            }
+        }
 
+        await ReleaseHeldInputAsync().ConfigureAwait(false);
+
+        foreach (var context in contextsToTerminate)
+        {
+            try
+            {
                 var prev = context.State;
                 context.State = ExecutionState.Terminated;
                 context.Session.ChangeState(ExecutionState.Terminated);
@@ -364,8 +377,48 @@ public sealed class ExecutionService : IExecutionService, IDisposable
                 State = ExecutionState.Terminated;
             }
         }
+    }
 
-        return Task.CompletedTask;
+    /// <summary>
+    /// Releases the held keys and buttons of every device a run has used, all devices at once.
+    /// </summary>
+    private async Task ReleaseHeldInputAsync()
+    {
+        var devices = _inputArbiters.Keys.ToList();
+        if (devices.Count == 0)
+            return;
+
+        var start = System.Diagnostics.Stopwatch.GetTimestamp();
+        var releases = devices.Select(ReleaseDeviceAsync).ToList();
+        await Task.WhenAll(releases).ConfigureAwait(false);
+
+        _logger.LogWarning("Released held input on {DeviceCount} devices in {ElapsedMs:F3}ms",
+            devices.Count, System.Diagnostics.Stopwatch.GetElapsedTime(start).TotalMilliseconds);
+    }
+
+    private async Task ReleaseDeviceAsync(IInputSimulator device)
+    {
+        try
+        {
+            await device.ReleaseAllAsync().ConfigureAwait(false);
+        }
+        catch (Exception ex)
+        {
+            // One failing device must not keep the others held
+            _logger.LogError(ex, "Failed to release held input on {Device}", device.GetType().Name);
+        }
+    }
+
+    private async void OnKillSwitchActivated(object? sender, KillSwitchActivatedEventArgs e)
+    {
+        try
+        {
+            await TerminateExecutionAsync().ConfigureAwait(false);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to terminate executions for kill switch: {Reason}", e.Reason);
+        }
     }
 
     public Task<ExecutionValidationResult> ValidateScriptForExecutionAsync(Script script)
@@ -388,17 +441,33 @@ public sealed class ExecutionService : IExecutionService, IDisposable
             : ExecutionValidationResult.Success(warnings, dangerous));
     }
 
+    public IReadOnlyList<ExecutionSession> GetActiveSessions()
+    {
+        lock (_lockObject)
+        {
+            return _activeExecutions.Values
+                .Where(c => c.ExecutionTask is not { IsCompleted: true })
+                .Select(c => c.Session)
+                .OrderBy(s => s.StartedAt)
+                .ToList();
+        }
+    }
+
     public ExecutionStatistics? GetExecutionStatistics()
     {
         var session = CurrentSession;
         if (session == null || CurrentScript == null) return null;
 
-        return new ExecutionStatistics
+        var statistics = new ExecutionStatistics
         {
             TotalCommands = 1,
             ExecutedCommands = session.ExecutedCommandCount,
             ElapsedTime = session.ElapsedTime
         };
+        session.FillLatenessStatistics(statistics);
+        if (_latencyMonitor != null)
+            statistics.InputLatency = _latencyMonitor.GetStatistics();
+        return statistics;
     }
 
     public TimeSpan? GetEstimatedRemainingTime()
@@ -429,8 +498,10 @@ public sealed class ExecutionService : IExecutionService, IDisposable
 
             var started = DateTime.UtcNow;
 
-            // Get the appropriate input simulator for countdown delay
-            var inputSimulator = _inputSimulatorFactory.GetInputSimulator(session.Options.InputMode);
+            // This execution's view of the device: input calls wait their turn behind other running scripts
+            var device = _inputSimulatorFactory.GetInputSimulator(session.Options.InputMode);
+            var arbiter = _inputArbiters.GetOrAdd(device, static _ => new InputArbiter());
+            var inputSimulator = new ArbitratedInputSimulator(device, arbiter.CreateLane(session.Options.Priority, ct));
 
             // Optional countdown warning
             if (session.Options.ShowCountdown && session.Options.CountdownDuration > TimeSpan.Zero)
@@ -442,6 +513,15 @@ public sealed class ExecutionService : IExecutionService, IDisposable
             if (string.IsNullOrWhiteSpace(source))
                 throw new InvalidOperationException("Script has no source text.");
 
+            // Deadline mode: schedule every delay against one timeline so action time does not drift playback
+            var timeline = session.Options.TimingMode == ExecutionTimingMode.Deadline
+                ? new PlaybackTimeline(
+                    session.Options.OverrunPolicy,
+                    session.Options.MaxCatchUpLateness,
+                    session.RecordActionLateness,
+                    session.RecordTimelineResync)
+                : null;
+
             if (session.Options.ControlMode == ExecutionControlMode.DebugInteractive)
             {
                 ProgressChanged?.Invoke(this, new ExecutionProgressEventArgs(session.Id, 0, 1, session.ElapsedTime, null));
@@ -455,7 +535,11 @@ public sealed class ExecutionService : IExecutionService, IDisposable
                 if (DateTime.UtcNow - started > session.Options.MaxExecutionTime)
                     throw new InvalidOperationException("Execution time limit exceeded.");
 
-                await _luaRunner.RunAsync(source, ct, inputMode: session.Options.InputMode);
+                await _luaRunner.RunAsync(source, ct, new LuaExecutionLimits
+                {
+                    UseDebugger = true,
+                    UseHighPrecisionTiming = session.Options.UseHighPrecisionTiming
+                }, session.Options.InputMode, timeline, inputSimulator);
                 ProgressChanged?.Invoke(this, new ExecutionProgressEventArgs(session.Id, 1, 1, session.ElapsedTime, TimeSpan.Zero));
             }
             else
@@ -470,12 +554,25 @@ public sealed class ExecutionService : IExecutionService, IDisposable
                 if (DateTime.UtcNow - started > session.Options.MaxExecutionTime)
                     throw new InvalidOperationException("Execution time limit exceeded.");
 
-                await _luaRunner.RunAsync(source, ct, inputMode: session.Options.InputMode);
+                await _luaRunner.RunAsync(source, ct, new LuaExecutionLimits
+                {
+                    UseHighPrecisionTiming = session.Options.UseHighPrecisionTiming
+                }, session.Options.InputMode, timeline, inputSimulator);
 
                 // Best-effort progress update at completion.
                 ProgressChanged?.Invoke(this, new ExecutionProgressEventArgs(session.Id, 1, 1, session.ElapsedTime, TimeSpan.Zero));
             }
 
+            if (timeline != null)
+            {
+                var timing = new ExecutionStatistics();
+                session.FillLatenessStatistics(timing);
+                _logger.LogInformation(
+                    "Deadline playback of script {ScriptId}: {Actions} actions, average lateness {AverageMs:F2}ms, max {MaxMs:F2}ms, {Resyncs} resyncs",
+                    script.Id, timing.TimedActionCount, timing.AverageActionLateness.TotalMilliseconds,
+                    timing.MaxActionLateness.TotalMilliseconds, timing.TimelineResyncCount);
+            }
+
             lock (_lockObject)
             {
                 context.CurrentCommandIndex = 1;
@@ -581,6 +678,8 @@ public sealed class ExecutionService : IExecutionService, IDisposable
 
     public void Dispose()
     {
+        _safetyService.KillSwitchActivated -= OnKillSwitchActivated;
+
         // 終止所有正在執行的腳本
         List<ScriptExecutionContext> contextsToDispose;
         lock (_lockObject)
@@ -593,10 +692,6 @@ public sealed class ExecutionService : IExecutionService, IDisposable
         {
             try { context.Dispose(); } catch { }
         }
-
-        try { _cts?.Cancel(); } catch { }
-        try { _pauseEvent.Set(); } catch { }
-        _pauseEvent.Dispose();
     }
 }
 
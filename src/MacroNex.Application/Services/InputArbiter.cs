@@ -0,0 +1,202 @@
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Grants concurrent executions turns on one input device, so each input call reaches the device whole
+/// and scripts interleave between calls instead of inside them.
+/// Waiters of the same priority are served first come, first served; since a script has at most one input
+/// call in flight this is round-robin across scripts. Higher priorities go first, but a waiting lower
+/// priority is served after <see cref="StarvationLimit"/> consecutive grants passed it over.
+/// The arbiter has its own small lock, held only to hand over a turn.
+/// </summary>
+public sealed class InputArbiter
+{
+    /// <summary>
+    /// Default number of consecutive higher-priority grants after which a waiting lower priority gets a turn.
+    /// </summary>
+    public const int DefaultStarvationLimit = 4;
+
+    private static readonly int PriorityLevels = Enum.GetValues<ExecutionPriority>().Length;
+
+    private readonly object _gate = new();
+    private readonly Queue<Waiter>[] _waiting;
+    private bool _busy;
+    private int _passedOver;
+
+    public InputArbiter(int starvationLimit = DefaultStarvationLimit)
+    {
+        if (starvationLimit < 1)
+            throw new ArgumentOutOfRangeException(nameof(starvationLimit), "Starvation limit must be at least 1.");
+
+        StarvationLimit = starvationLimit;
+        _waiting = new Queue<Waiter>[PriorityLevels];
+        for (var i = 0; i < _waiting.Length; i++)
+            _waiting[i] = new Queue<Waiter>();
+    }
+
+    /// <summary>
+    /// Gets the number of consecutive grants a waiting lower priority can be passed over.
+    /// </summary>
+    public int StarvationLimit { get; }
+
+    /// <summary>
+    /// Creates the lane one execution uses to take turns on this device.
+    /// </summary>
+    /// <param name="priority">Priority of the execution.</param>
+    /// <param name="cancellationToken">Cancels waits of the lane, e.g. when the execution is terminated.</param>
+    public InputLane CreateLane(ExecutionPriority priority, CancellationToken cancellationToken = default) =>
+        new(this, priority, cancellationToken);
+
+    /// <summary>
+    /// Waits for the device. Completes synchronously when the device is free and nobody is waiting.
+    /// </summary>
+    internal ValueTask<InputTurn> AcquireAsync(ExecutionPriority priority, CancellationToken cancellationToken)
+    {
+        cancellationToken.ThrowIfCancellationRequested();
+
+        Waiter waiter;
+        lock (_gate)
+        {
+            if (!_busy)
+            {
+                _busy = true;
+                return new ValueTask<InputTurn>(new InputTurn(this));
+            }
+
+            waiter = new Waiter();
+
+            // Registered before the waiter is visible to Release, which disposes the registration it hands a turn to;
+            // a callback running inline only completes the waiter and never takes the gate
+            if (cancellationToken.CanBeCanceled)
+                waiter.Registration = cancellationToken.Register(static state => ((Waiter)state!).TrySetCanceled(), waiter);
+
+            _waiting[(int)priority].Enqueue(waiter);
+        }
+
+        return new ValueTask<InputTurn>(waiter.Task);
+    }
+
+    /// <summary>
+    /// Hands the device to the next waiter, or marks it free.
+    /// </summary>
+    internal void Release()
+    {
+        while (true)
+        {
+            Waiter? next;
+            lock (_gate)
+            {
+                next = DequeueNext();
+                if (next == null)
+                {
+                    _busy = false;
+                    return;
+                }
+            }
+
+            // The turn passes straight to the waiter; a waiter that was cancelled meanwhile is skipped
+            if (next.TrySetResult(new InputTurn(this)))
+            {
+                next.Registration.Dispose();
+                return;
+            }
+        }
+    }
+
+    private Waiter? DequeueNext()
+    {
+        var top = -1;
+        for (var level = _waiting.Length - 1; level >= 0; level--)
+        {
+            if (_waiting[level].Count > 0)
+            {
+                top = level;
+                break;
+            }
+        }
+
+        if (top < 0)
+            return null;
+
+        var lower = -1;
+        for (var level = top - 1; level >= 0; level--)
+        {
+            if (_waiting[level].Count > 0)
+            {
+                lower = level;
+                break;
+            }
+        }
+
+        if (lower < 0)
+        {
+            _passedOver = 0;
+            return _waiting[top].Dequeue();
+        }
+
+        if (_passedOver >= StarvationLimit)
+        {
+            _passedOver = 0;
+            return _waiting[lower].Dequeue();
+        }
+
+        _passedOver++;
+        return _waiting[top].Dequeue();
+    }
+
+    private sealed class Waiter : TaskCompletionSource<InputTurn>
+    {
+        public Waiter()
+            : base(TaskCreationOptions.RunContinuationsAsynchronously)
+        {
+        }
+
+        public CancellationTokenRegistration Registration { get; set; }
+    }
+}
+
+/// <summary>
+/// One execution's access to an <see cref="InputArbiter"/>.
+/// </summary>
+public sealed class InputLane
+{
+    private readonly InputArbiter _arbiter;
+
+    internal InputLane(InputArbiter arbiter, ExecutionPriority priority, CancellationToken cancellationToken)
+    {
+        _arbiter = arbiter;
+        Priority = priority;
+        CancellationToken = cancellationToken;
+    }
+
+    /// <summary>
+    /// Gets the priority the lane waits with.
+    /// </summary>
+    public ExecutionPriority Priority { get; }
+
+    /// <summary>
+    /// Gets the token that cancels the lane's waits.
+    /// </summary>
+    public CancellationToken CancellationToken { get; }
+
+    /// <summary>
+    /// Waits for a turn on the device. Dispose the turn as soon as the input call has been submitted.
+    /// </summary>
+    public ValueTask<InputTurn> AcquireAsync() => _arbiter.AcquireAsync(Priority, CancellationToken);
+}
+
+/// <summary>
+/// Exclusive use of an input device, returned by <see cref="InputLane.AcquireAsync"/>. Dispose exactly once.
+/// </summary>
+public readonly struct InputTurn : IDisposable
+{
+    private readonly InputArbiter? _arbiter;
+
+    internal InputTurn(InputArbiter arbiter)
+    {
+        _arbiter = arbiter;
+    }
+
+    public void Dispose() => _arbiter?.Release();
+}
@@ -0,0 +1,101 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Per-stage input latency histograms, also published through the "MacroNex.Input" <see cref="Meter"/>
+/// so that dotnet-counters or an OpenTelemetry listener can read p50/p99/max in production.
+/// </summary>
+public sealed class InputLatencyMonitor : IInputLatencyMonitor, IDisposable
+{
+    /// <summary>
+    /// Name of the meter that publishes the latency instruments.
+    /// </summary>
+    public const string MeterName = "MacroNex.Input";
+
+    private static readonly InputLatencyStage[] Stages = Enum.GetValues<InputLatencyStage>();
+    private static readonly double MicrosecondsPerTimestampTick = 1_000_000.0 / Stopwatch.Frequency;
+
+    private readonly LatencyHistogram[] _histograms;
+    private readonly KeyValuePair<string, object?>[] _stageTags;
+    private readonly Meter _meter;
+    private readonly Histogram<double> _latencyInstrument;
+
+    public InputLatencyMonitor()
+    {
+        _histograms = new LatencyHistogram[Stages.Length];
+        _stageTags = new KeyValuePair<string, object?>[Stages.Length];
+        foreach (var stage in Stages)
+        {
+            _histograms[(int)stage] = new LatencyHistogram();
+            _stageTags[(int)stage] = new KeyValuePair<string, object?>("stage", stage.ToString());
+        }
+
+        _meter = new Meter(MeterName);
+        _latencyInstrument = _meter.CreateHistogram<double>("macronex.input.latency", "us", "Latency of one input path stage.");
+        _meter.CreateObservableGauge("macronex.input.latency.p50", () => Observe(h => h.GetValueAtPercentile(50)), "us", "Median latency per stage.");
+        _meter.CreateObservableGauge("macronex.input.latency.p99", () => Observe(h => h.GetValueAtPercentile(99)), "us", "99th percentile latency per stage.");
+        _meter.CreateObservableGauge("macronex.input.latency.max", () => Observe(h => h.MaxMicroseconds), "us", "Largest latency per stage.");
+    }
+
+    /// <inheritdoc />
+    public void Record(InputLatencyStage stage, long startTimestamp)
+    {
+        var microseconds = (long)((Stopwatch.GetTimestamp() - startTimestamp) * MicrosecondsPerTimestampTick);
+        _histograms[(int)stage].Record(microseconds);
+
+        // Cheap no-op unless a listener has enabled the instrument
+        if (_latencyInstrument.Enabled)
+            _latencyInstrument.Record(microseconds, _stageTags[(int)stage]);
+    }
+
+    /// <inheritdoc />
+    public IReadOnlyList<InputLatencyStageStatistics> GetStatistics()
+    {
+        var statistics = new List<InputLatencyStageStatistics>(Stages.Length);
+        foreach (var stage in Stages)
+        {
+            var histogram = _histograms[(int)stage];
+            var count = histogram.Count;
+            if (count == 0)
+                continue;
+
+            statistics.Add(new InputLatencyStageStatistics(
+                stage,
+                count,
+                FromMicroseconds(histogram.GetValueAtPercentile(50)),
+                FromMicroseconds(histogram.GetValueAtPercentile(99)),
+                FromMicroseconds(histogram.MaxMicroseconds)));
+        }
+
+        return statistics;
+    }
+
+    /// <inheritdoc />
+    public void Reset()
+    {
+        foreach (var histogram in _histograms)
+        {
+            histogram.Reset();
+        }
+    }
+
+    public void Dispose()
+    {
+        _meter.Dispose();
+    }
+
+    private IEnumerable<Measurement<double>> Observe(Func<LatencyHistogram, long> read)
+    {
+        foreach (var stage in Stages)
+        {
+            var histogram = _histograms[(int)stage];
+            if (histogram.Count > 0)
+                yield return new Measurement<double>(read(histogram), _stageTags[(int)stage]);
+        }
+    }
+
+    private static TimeSpan FromMicroseconds(long microseconds) => TimeSpan.FromTicks(microseconds * (TimeSpan.TicksPerMillisecond / 1000));
+}
@@ -0,0 +1,122 @@
+using System.Numerics;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Lock-free log-linear latency histogram in the style of HdrHistogram.
+/// Values are whole microseconds. Each power of two is split into 16 sub-buckets, so a reported percentile
+/// is within about 6% of the true value; values below 32 µs are exact. Recording is two interlocked adds plus
+/// a compare-exchange when a new maximum is seen, and allocates nothing.
+/// </summary>
+public sealed class LatencyHistogram
+{
+    private const int SubBucketBits = 4;
+    private const int SubBucketCount = 1 << SubBucketBits;       // 16 sub-buckets per power of two
+    private const int LinearLimit = SubBucketCount * 2;          // values below this get a bucket each
+    private const int MaxExponent = 36;                          // 2^37 µs, about 38 hours
+
+    /// <summary>
+    /// Largest value tracked exactly in the buckets; larger samples are clamped (the maximum is still exact).
+    /// </summary>
+    public const long MaxTrackableMicroseconds = (1L << (MaxExponent + 1)) - 1;
+
+    private readonly long[] _counts = new long[BucketIndex(MaxTrackableMicroseconds) + 1];
+    private long _totalCount;
+    private long _max;
+
+    /// <summary>
+    /// Gets the number of recorded samples.
+    /// </summary>
+    public long Count => Interlocked.Read(ref _totalCount);
+
+    /// <summary>
+    /// Gets the largest recorded value in microseconds.
+    /// </summary>
+    public long MaxMicroseconds => Interlocked.Read(ref _max);
+
+    /// <summary>
+    /// Records one sample. Negative values are recorded as zero. Safe to call from any thread.
+    /// </summary>
+    public void Record(long microseconds)
+    {
+        if (microseconds < 0)
+            microseconds = 0;
+
+        Interlocked.Increment(ref _counts[BucketIndex(Math.Min(microseconds, MaxTrackableMicroseconds))]);
+        Interlocked.Increment(ref _totalCount);
+
+        var max = Interlocked.Read(ref _max);
+        while (microseconds > max)
+        {
+            var observed = Interlocked.CompareExchange(ref _max, microseconds, max);
+            if (observed == max)
+                break;
+            max = observed;
+        }
+    }
+
+    /// <summary>
+    /// Gets the value at or below which <paramref name="percentile"/> percent of samples fall.
+    /// Reports the upper edge of the containing bucket, capped at the recorded maximum; 0 when empty.
+    /// Concurrent recording may make the result lag by the samples in flight.
+    /// </summary>
+    /// <param name="percentile">Percentile between 0 and 100.</param>
+    public long GetValueAtPercentile(double percentile)
+    {
+        if (percentile < 0 || percentile > 100)
+            throw new ArgumentOutOfRangeException(nameof(percentile), "Percentile must be between 0 and 100.");
+
+        // Sum the buckets instead of trusting _totalCount so the walk is consistent with what it reads
+        long total = 0;
+        for (int i = 0; i < _counts.Length; i++)
+            total += Volatile.Read(ref _counts[i]);
+
+        if (total == 0)
+            return 0;
+
+        var rank = Math.Max(1, (long)Math.Ceiling(percentile / 100.0 * total));
+        long seen = 0;
+        for (int i = 0; i < _counts.Length; i++)
+        {
+            seen += Volatile.Read(ref _counts[i]);
+            if (seen >= rank)
+                return Math.Min(BucketUpperBound(i), MaxMicroseconds);
+        }
+
+        return MaxMicroseconds;
+    }
+
+    /// <summary>
+    /// Clears all samples. Samples recorded concurrently with a reset may be kept or dropped.
+    /// </summary>
+    public void Reset()
+    {
+        for (int i = 0; i < _counts.Length; i++)
+            Interlocked.Exchange(ref _counts[i], 0);
+
+        Interlocked.Exchange(ref _totalCount, 0);
+        Interlocked.Exchange(ref _max, 0);
+    }
+
+    private static int BucketIndex(long value)
+    {
+        if (value < LinearLimit)
+            return (int)value;
+
+        // value >= 32: keep the top SubBucketBits + 1 bits, i.e. a sub-bucket in [16, 31] of its power of two
+        var shift = (63 - BitOperations.LeadingZeroCount((ulong)value)) - SubBucketBits;
+        var subBucket = (int)(value >> shift) - SubBucketCount;
+        return LinearLimit + (shift - 1) * SubBucketCount + subBucket;
+    }
+
+    private static long BucketUpperBound(int index)
+    {
+        if (index < LinearLimit)
+            return index;
+
+        var offset = index - LinearLimit;
+        var shift = offset / SubBucketCount + 1;
+        var subBucket = (long)(offset % SubBucketCount + SubBucketCount);
+        return ((subBucket + 1) << shift) - 1;
+    }
+}
@@ -0,0 +1,266 @@
+using MacroNex.Domain.Interfaces;
+using DomainLogLevel = MacroNex.Domain.Interfaces.LogLevel;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Fixed-capacity ring of recent log entries used by <see cref="LoggingService"/>.
+/// Appends are lock-free: a writer reserves a sequence number, stores the entry in its slot and then stamps
+/// the slot, evicting the entry one capacity older. Queries walk from the newest entry backwards and stop
+/// once enough matches are found; complete blocks of <see cref="BlockSize"/> slots get a summary (levels
+/// present and time range) the first time they are scanned, so later queries skip blocks that cannot match.
+/// </summary>
+public sealed class LogEntryStore
+{
+    /// <summary>
+    /// Number of consecutive entries covered by one block summary.
+    /// </summary>
+    public const int BlockSize = 256;
+
+    private readonly LogEntry?[] _entries;
+    private readonly long[] _stamps; // sequence + 1 once the slot holds that entry; 0 while it is being replaced
+    private readonly long[] _levelCounts = new long[3];
+    private readonly BlockSummary[] _summaries;
+    private readonly object _queryLock = new();
+
+    private long _next;
+    private long _floor;
+
+    /// <summary>
+    /// Initializes a new store.
+    /// </summary>
+    /// <param name="capacity">Minimum number of entries retained; rounded up to a whole number of blocks.</param>
+    public LogEntryStore(int capacity)
+    {
+        if (capacity < 1)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be at least 1.");
+
+        var blocks = (capacity + BlockSize - 1) / BlockSize;
+        Capacity = blocks * BlockSize;
+        _entries = new LogEntry?[Capacity];
+        _stamps = new long[Capacity];
+        _summaries = new BlockSummary[blocks];
+        for (var i = 0; i < blocks; i++)
+            _summaries[i].Block = -1;
+    }
+
+    /// <summary>
+    /// Gets the maximum number of retained entries.
+    /// </summary>
+    public int Capacity { get; }
+
+    /// <summary>
+    /// Gets the number of retained entries.
+    /// </summary>
+    public int Count => (int)(Interlocked.Read(ref _levelCounts[0]) + Interlocked.Read(ref _levelCounts[1]) + Interlocked.Read(ref _levelCounts[2]));
+
+    /// <summary>
+    /// Appends an entry, evicting the oldest one when the store is full. Safe to call from any thread.
+    /// </summary>
+    public void Append(LogEntry entry)
+    {
+        if (entry == null) throw new ArgumentNullException(nameof(entry));
+
+        var sequence = Interlocked.Increment(ref _next) - 1;
+        var index = (int)(sequence % Capacity);
+
+        // Invalidate the stamp first so readers never pair the old stamp with the new entry
+        Interlocked.Exchange(ref _stamps[index], 0);
+        var evicted = Interlocked.Exchange(ref _entries[index], entry);
+        if (evicted != null)
+            Interlocked.Decrement(ref _levelCounts[LevelIndex(evicted.Level)]);
+        Interlocked.Increment(ref _levelCounts[LevelIndex(entry.Level)]);
+        Interlocked.Exchange(ref _stamps[index], sequence + 1);
+
+        // A concurrent Clear may have passed this slot before it was stamped
+        if (sequence < Interlocked.Read(ref _floor))
+            TryEvict(sequence);
+    }
+
+    /// <summary>
+    /// Removes all retained entries.
+    /// </summary>
+    public void Clear()
+    {
+        var end = Interlocked.Read(ref _next);
+        var start = Math.Max(Interlocked.Exchange(ref _floor, end), end - Capacity);
+        for (var sequence = start; sequence < end; sequence++)
+            TryEvict(sequence);
+    }
+
+    /// <summary>
+    /// Returns matching entries, newest first, up to <see cref="LogFilter.MaxResults"/>.
+    /// </summary>
+    public List<LogEntry> Query(LogFilter filter)
+    {
+        if (filter == null) throw new ArgumentNullException(nameof(filter));
+
+        var maxResults = filter.MaxResults ?? int.MaxValue;
+        var results = new List<LogEntry>(Math.Min(maxResults, 1024));
+        if (maxResults <= 0)
+            return results;
+
+        var levelMask = LevelMask(filter.MinLevel, filter.MaxLevel);
+        var startTicks = filter.StartTime?.Ticks ?? long.MinValue;
+        var endTicks = filter.EndTime?.Ticks ?? long.MaxValue;
+        var searchTerm = filter.SearchTerm;
+
+        lock (_queryLock)
+        {
+            var end = Interlocked.Read(ref _next);
+            var start = Math.Max(Interlocked.Read(ref _floor), end - Capacity);
+
+            for (var block = (end - 1) / BlockSize; end > start && block >= start / BlockSize && results.Count < maxResults; block--)
+            {
+                var blockFirst = block * BlockSize;
+                ref var summary = ref _summaries[block % _summaries.Length];
+                if (summary.Block == block &&
+                    ((summary.LevelMask & levelMask) == 0 || summary.MaxTicks < startTicks || summary.MinTicks > endTicks))
+                {
+                    continue;
+                }
+
+                var from = Math.Max(blockFirst, start);
+                var to = Math.Min(blockFirst + BlockSize, end);
+                var complete = from == blockFirst && to == blockFirst + BlockSize;
+                var scanned = new BlockSummary { Block = block, MinTicks = long.MaxValue, MaxTicks = long.MinValue };
+
+                for (var sequence = to - 1; sequence >= from; sequence--)
+                {
+                    if (!TryRead(sequence, out var entry))
+                    {
+                        complete = false;
+                        continue;
+                    }
+
+                    var ticks = entry.Timestamp.Ticks;
+                    scanned.LevelMask |= LevelBit(entry.Level);
+                    scanned.MinTicks = Math.Min(scanned.MinTicks, ticks);
+                    scanned.MaxTicks = Math.Max(scanned.MaxTicks, ticks);
+
+                    if ((LevelBit(entry.Level) & levelMask) != 0 &&
+                        ticks >= startTicks && ticks <= endTicks &&
+                        MatchesSearch(entry, searchTerm))
+                    {
+                        results.Add(entry);
+                        if (results.Count >= maxResults)
+                        {
+                            complete = complete && sequence == from;
+                            break;
+                        }
+                    }
+                }
+
+                if (complete)
+                    summary = scanned;
+            }
+        }
+
+        // Concurrent writers may publish slightly out of timestamp order
+        results.Sort((a, b) => b.Timestamp.CompareTo(a.Timestamp));
+        return results;
+    }
+
+    /// <summary>
+    /// Gets per-level counts and the time span of the retained entries.
+    /// </summary>
+    public LogStatistics GetStatistics()
+    {
+        var stats = new LogStatistics
+        {
+            InfoCount = (int)Interlocked.Read(ref _levelCounts[LevelIndex(DomainLogLevel.Info)]),
+            WarningCount = (int)Interlocked.Read(ref _levelCounts[LevelIndex(DomainLogLevel.Warning)]),
+            ErrorCount = (int)Interlocked.Read(ref _levelCounts[LevelIndex(DomainLogLevel.Error)])
+        };
+        stats.TotalEntries = stats.InfoCount + stats.WarningCount + stats.ErrorCount;
+
+        var end = Interlocked.Read(ref _next);
+        var start = Math.Max(Interlocked.Read(ref _floor), end - Capacity);
+        DateTime? oldest = null;
+        DateTime? newest = null;
+        for (var sequence = start; sequence < end && oldest == null; sequence++)
+        {
+            if (TryRead(sequence, out var entry))
+                oldest = entry.Timestamp;
+        }
+        for (var sequence = end - 1; sequence >= start && newest == null; sequence--)
+        {
+            if (TryRead(sequence, out var entry))
+                newest = entry.Timestamp;
+        }
+
+        if (oldest.HasValue && newest.HasValue)
+        {
+            stats.OldestEntry = oldest.Value <= newest.Value ? oldest.Value : newest.Value;
+            stats.NewestEntry = oldest.Value <= newest.Value ? newest.Value : oldest.Value;
+        }
+
+        return stats;
+    }
+
+    private bool TryRead(long sequence, out LogEntry entry)
+    {
+        var index = (int)(sequence % Capacity);
+        entry = null!;
+        if (Volatile.Read(ref _stamps[index]) != sequence + 1)
+            return false;
+
+        var candidate = Volatile.Read(ref _entries[index]);
+        if (candidate == null || Volatile.Read(ref _stamps[index]) != sequence + 1)
+            return false;
+
+        entry = candidate;
+        return true;
+    }
+
+    private void TryEvict(long sequence)
+    {
+        var index = (int)(sequence % Capacity);
+        if (!TryRead(sequence, out var entry))
+            return;
+
+        if (Interlocked.CompareExchange(ref _entries[index], null, entry) == entry)
+            Interlocked.Decrement(ref _levelCounts[LevelIndex(entry.Level)]);
+    }
+
+    private static bool MatchesSearch(LogEntry entry, string? searchTerm)
+    {
+        if (string.IsNullOrWhiteSpace(searchTerm))
+            return true;
+
+        return entry.Message.Contains(searchTerm, StringComparison.OrdinalIgnoreCase) ||
+               (entry.ExceptionDetails != null && entry.ExceptionDetails.Contains(searchTerm, StringComparison.OrdinalIgnoreCase));
+    }
+
+    private static int LevelIndex(DomainLogLevel level) => level switch
+    {
+        DomainLogLevel.Warning => 1,
+        DomainLogLevel.Error => 2,
+        _ => 0
+    };
+
+    private static int LevelBit(DomainLogLevel level) => 1 << LevelIndex(level);
+
+    private static int LevelMask(DomainLogLevel? minLevel, DomainLogLevel? maxLevel)
+    {
+        var mask = 0;
+        foreach (var level in new[] { DomainLogLevel.Info, DomainLogLevel.Warning, DomainLogLevel.Error })
+        {
+            if ((!minLevel.HasValue || level >= minLevel.Value) && (!maxLevel.HasValue || level <= maxLevel.Value))
+                mask |= LevelBit(level);
+        }
+
+        return mask;
+    }
+
+    /// <summary>
+    /// Levels present and time range of one complete block; Block is -1 until computed.
+    /// </summary>
+    private struct BlockSummary
+    {
+        public long Block;
+        public int LevelMask;
+        public long MinTicks;
+        public long MaxTicks;
+    }
+}
@@ -1,3 +1,4 @@
+using System.Buffers.Binary;
 using MacroNex.Domain.Interfaces;
 using DomainLogLevel = MacroNex.Domain.Interfaces.LogLevel;
 using Microsoft.Extensions.Logging;
@@ -7,24 +8,32 @@ namespace MacroNex.Application.Services;
 /// <summary>
 /// Application service for comprehensive logging of automation activities.
 /// Provides real-time logging, persistent storage, filtering, and search capabilities.
+/// Recent entries are kept in a lock-free <see cref="LogEntryStore"/>, so logging never blocks on queries.
 /// </summary>
 public class LoggingService : ILoggingService
 {
     private readonly ILogger<LoggingService> _logger;
     private readonly IFileLogWriter _fileLogWriter;
-    private readonly object _lock = new();
-    private readonly List<LogEntry> _inMemoryLogs = new();
-    private const int MaxInMemoryEntries = 10000;
+    private readonly LogEntryStore _store;
+    private readonly Guid _entryIdBase = Guid.NewGuid();
+    private long _entryCounter;
+
+    /// <summary>
+    /// Default number of entries kept in memory for filtering and search.
+    /// </summary>
+    public const int DefaultMaxInMemoryEntries = 100_000;
 
     /// <summary>
     /// Initializes a new instance of the LoggingService class.
     /// </summary>
     /// <param name="logger">Microsoft.Extensions.Logging logger for diagnostic information.</param>
     /// <param name="fileLogWriter">File log writer for persistent storage.</param>
-    public LoggingService(ILogger<LoggingService> logger, IFileLogWriter fileLogWriter)
+    /// <param name="maxInMemoryEntries">Number of recent entries kept in memory.</param>
+    public LoggingService(ILogger<LoggingService> logger, IFileLogWriter fileLogWriter, int maxInMemoryEntries = DefaultMaxInMemoryEntries)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
         _fileLogWriter = fileLogWriter ?? throw new ArgumentNullException(nameof(fileLogWriter));
+        _store = new LogEntryStore(maxInMemoryEntries);
         _logger.LogDebug("LoggingService initialized");
     }
 
@@ -61,19 +70,9 @@ public class LoggingService : ILoggingService
             throw new ArgumentException("Log message cannot be null or whitespace", nameof(message));
 
         var timestamp = DateTime.UtcNow;
-        var logEntry = new LogEntry(Guid.NewGuid(), timestamp, level, message, exceptionDetails, context);
+        var logEntry = new LogEntry(NextEntryId(), timestamp, level, message, exceptionDetails, context);
 
-        lock (_lock)
-        {
-            _inMemoryLogs.Add(logEntry);
-
-            // Trim in-memory logs if exceeding limit
-            if (_inMemoryLogs.Count > MaxInMemoryEntries)
-            {
-                var removeCount = _inMemoryLogs.Count - MaxInMemoryEntries;
-                _inMemoryLogs.RemoveRange(0, removeCount);
-            }
-        }
+        _store.Append(logEntry);
 
         // Write to persistent storage asynchronously
         try
@@ -110,50 +109,8 @@ public class LoggingService : ILoggingService
     {
         if (filter == null) throw new ArgumentNullException(nameof(filter));
 
-        lock (_lock)
-        {
-            var query = _inMemoryLogs.AsEnumerable();
-
-            // Apply level filter
-            if (filter.MinLevel.HasValue)
-            {
-                query = query.Where(e => e.Level >= filter.MinLevel.Value);
-            }
-            if (filter.MaxLevel.HasValue)
-            {
-                query = query.Where(e => e.Level <= filter.MaxLevel.Value);
-            }
-
-            // Apply time range filter
-            if (filter.StartTime.HasValue)
-            {
-                query = query.Where(e => e.Timestamp >= filter.StartTime.Value);
-            }
-            if (filter.EndTime.HasValue)
-            {
-                query = query.Where(e => e.Timestamp <= filter.EndTime.Value);
-            }
-
-            // Apply search term filter
-            if (!string.IsNullOrWhiteSpace(filter.SearchTerm))
-            {
-                var searchTerm = filter.SearchTerm.ToLowerInvariant();
-                query = query.Where(e =>
-                    e.Message.ToLowerInvariant().Contains(searchTerm) ||
-                    (e.ExceptionDetails != null && e.ExceptionDetails.ToLowerInvariant().Contains(searchTerm)));
-            }
-
-            // Order by timestamp descending (newest first)
-            query = query.OrderByDescending(e => e.Timestamp);
-
-            // Apply max results limit
-            if (filter.MaxResults.HasValue)
-            {
-                query = query.Take(filter.MaxResults.Value);
-            }
-
-            return Task.FromResult(query.ToList().AsEnumerable());
-        }
+        // Newest first; the store stops scanning once MaxResults entries match
+        return Task.FromResult<IEnumerable<LogEntry>>(_store.Query(filter));
     }
 
     /// <inheritdoc />
@@ -174,10 +131,7 @@ public class LoggingService : ILoggingService
     /// <inheritdoc />
     public async Task ClearLogsAsync()
     {
-        lock (_lock)
-        {
-            _inMemoryLogs.Clear();
-        }
+        _store.Clear();
 
         try
         {
@@ -214,24 +168,18 @@ public class LoggingService : ILoggingService
     /// <inheritdoc />
     public Task<LogStatistics> GetLogStatisticsAsync()
     {
-        lock (_lock)
-        {
-            if (_inMemoryLogs.Count == 0)
-            {
-                return Task.FromResult(new LogStatistics());
-            }
-
-            var stats = new LogStatistics
-            {
-                TotalEntries = _inMemoryLogs.Count,
-                InfoCount = _inMemoryLogs.Count(e => e.Level == DomainLogLevel.Info),
-                WarningCount = _inMemoryLogs.Count(e => e.Level == DomainLogLevel.Warning),
-                ErrorCount = _inMemoryLogs.Count(e => e.Level == DomainLogLevel.Error),
-                OldestEntry = _inMemoryLogs.Min(e => e.Timestamp),
-                NewestEntry = _inMemoryLogs.Max(e => e.Timestamp)
-            };
-
-            return Task.FromResult(stats);
-        }
+        return Task.FromResult(_store.GetStatistics());
+    }
+
+    /// <summary>
+    /// Returns an id unique within this service without a random-number call per entry.
+    /// </summary>
+    private Guid NextEntryId()
+    {
+        Span<byte> bytes = stackalloc byte[16];
+        _entryIdBase.TryWriteBytes(bytes);
+        var counter = Interlocked.Increment(ref _entryCounter);
+        BinaryPrimitives.WriteInt64LittleEndian(bytes[8..], BinaryPrimitives.ReadInt64LittleEndian(bytes[8..]) ^ counter);
+        return new Guid(bytes);
     }
 }
@@ -1,3 +1,6 @@
+using System.Diagnostics;
+using System.Security.Cryptography;
+using System.Text;
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using Microsoft.Extensions.Logging;
@@ -8,18 +11,104 @@ namespace MacroNex.Application.Services;
 
 public sealed class LuaScriptRunner
 {
+    /// <summary>
+    /// Maximum number of compiled scripts kept ready between runs.
+    /// </summary>
+    public const int MaxCachedScripts = 32;
+
+    // Builds batch(fn, ...), which runs fn with input batching open so its inputs are submitted together
+    // when it returns. The batch markers stay upvalues, out of the script's reach. The batch is closed even
+    // when fn fails (a caller may catch the error with pcall): committed on success, discarded on error.
+    private const string HostPrelude = @"
+local batch_begin, batch_end = ...
+local type, error, pcall = type, error, pcall
+return function(fn, ...)
+  if type(fn) ~= 'function' then
+    error(""bad argument #1 to 'batch' (function expected)"", 2)
+  end
+  batch_begin()
+  local ok, err = pcall(fn, ...)
+  batch_end(ok)
+  if not ok then
+    error(err, 0)
+  end
+end
+";
+
+    // Builds the Lua-side wrapper of each host function. A host call that returns true left an operation
+    // pending: the wrapper suspends the script for the driver to await it. MoonSharp cannot yield from code
+    // entered through a host callback (sort comparators, gsub replacements, __tostring, ...); the failed
+    // yield is caught and the operation is waited for in place instead. pcall is captured so a script that
+    // replaces the global cannot break or bypass the suspend.
+    private const string HostCallWrapper = @"
+local suspend, wait = ...
+local pcall = pcall
+local function yield() suspend() end
+return function(call)
+  return function(...)
+    if call(...) and not pcall(yield) then
+      wait()
+    end
+  end
+end
+";
+
     private readonly IInputSimulatorFactory _inputSimulatorFactory;
     private readonly ISafetyService _safetyService;
     private readonly ILogger<LuaScriptRunner> _logger;
+    private readonly IPrecisionTimer? _precisionTimer;
+    private readonly IInputLatencyMonitor? _latencyMonitor;
+
+    // Compiled sandboxes keyed by source hash. A sandbox is leased to one run at a time.
+    private readonly Dictionary<string, LuaSandbox> _cache = new(StringComparer.Ordinal);
+    private readonly object _cacheLock = new();
+    private long _cacheHits;
+    private long _cacheMisses;
 
-    public LuaScriptRunner(IInputSimulatorFactory inputSimulatorFactory, ISafetyService safetyService, ILogger<LuaScriptRunner> logger)
+    public LuaScriptRunner(IInputSimulatorFactory inputSimulatorFactory, ISafetyService safetyService, ILogger<LuaScriptRunner> logger, IPrecisionTimer? precisionTimer = null, IInputLatencyMonitor? latencyMonitor = null)
     {
         _inputSimulatorFactory = inputSimulatorFactory ?? throw new ArgumentNullException(nameof(inputSimulatorFactory));
         _safetyService = safetyService ?? throw new ArgumentNullException(nameof(safetyService));
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _precisionTimer = precisionTimer;
+        _latencyMonitor = latencyMonitor;
     }
 
-    public async Task RunAsync(string? sourceText, CancellationToken ct, LuaExecutionLimits? limits = null, InputMode inputMode = InputMode.HighLevel)
+    /// <summary>
+    /// Gets a snapshot of the compile cache counters.
+    /// </summary>
+    public LuaCompileCacheStatistics GetCacheStatistics()
+    {
+        lock (_cacheLock)
+        {
+            return new LuaCompileCacheStatistics(Interlocked.Read(ref _cacheHits), Interlocked.Read(ref _cacheMisses), _cache.Count);
+        }
+    }
+
+    /// <summary>
+    /// Drops all cached compiled scripts. Counters are kept.
+    /// </summary>
+    public void ClearCache()
+    {
+        lock (_cacheLock)
+        {
+            _cache.Clear();
+        }
+    }
+
+    /// <summary>
+    /// Runs a Lua script.
+    /// </summary>
+    /// <param name="sourceText">The Lua source.</param>
+    /// <param name="ct">Cancels the run.</param>
+    /// <param name="limits">Limits and timing options; defaults when null.</param>
+    /// <param name="inputMode">Selects the input simulator.</param>
+    /// <param name="timeline">When set, sleeps are scheduled against this absolute timeline (deadline mode).</param>
+    /// <param name="inputSimulator">
+    /// Simulator to drive instead of the factory's one for <paramref name="inputMode"/>, e.g. an execution's
+    /// <see cref="ArbitratedInputSimulator"/> when several scripts share the device.
+    /// </param>
+    public async Task RunAsync(string? sourceText, CancellationToken ct, LuaExecutionLimits? limits = null, InputMode inputMode = InputMode.HighLevel, PlaybackTimeline? timeline = null, IInputSimulator? inputSimulator = null)
     {
         limits ??= LuaExecutionLimits.Default();
 
@@ -30,124 +119,345 @@ public sealed class LuaScriptRunner
         if (string.IsNullOrWhiteSpace(code))
             throw new InvalidOperationException("Script source is empty.");
 
-        // Sandbox: only keep safe core modules.
-        var script = new Script(CoreModules.Basic | CoreModules.String | CoreModules.Table | CoreModules.Math);
+        // Get the appropriate input simulator based on input mode
+        inputSimulator ??= _inputSimulatorFactory.GetInputSimulator(inputMode);
 
-        script.Options.DebugPrint = s => _logger.LogInformation("[lua] {Text}", s);
+        // Opt-in precise sleeps: keep the system timer at 1 ms for the duration of the run
+        var precisionTimer = limits.UseHighPrecisionTiming ? _precisionTimer : null;
+        using var timerSession = precisionTimer?.BeginHighResolutionSession();
 
-        // Enforce step limits & cancellation through a minimal debugger implementation.
-        script.DebuggerEnabled = true;
-        script.AttachDebugger(new LimiterDebugger(_safetyService, ct, limits));
+        // Execute: start on the threadpool so the caller can await without blocking UI.
+        // The script only holds a thread while Lua code runs; host I/O and sleeps are awaited.
+        await Task.Run(async () =>
+        {
+            var sandbox = AcquireSandbox(code);
+            var completed = false;
+            try
+            {
+                sandbox.Begin(inputSimulator, inputMode, precisionTimer, timeline, ct, limits, _latencyMonitor);
+                await sandbox.RunAsync().ConfigureAwait(false);
+                completed = true;
+            }
+            finally
+            {
+                ReleaseSandbox(sandbox, completed);
+            }
+        }, ct);
+    }
 
-        // Get the appropriate input simulator based on input mode
-        var inputSimulator = _inputSimulatorFactory.GetInputSimulator(inputMode);
+    private LuaSandbox AcquireSandbox(string code)
+    {
+        var hash = ComputeSourceHash(code);
 
-        // Host API
-        script.Globals["sleep"] = (Func<double, DynValue>)(seconds =>
+        lock (_cacheLock)
         {
-            DelayWithCancellation(TimeSpan.FromSeconds(seconds), ct).GetAwaiter().GetResult();
-            return DynValue.Nil;
-        });
+            if (_cache.TryGetValue(hash, out var cached) && !cached.IsLeased)
+            {
+                cached.IsLeased = true;
+                cached.LastUsedTicks = Environment.TickCount64;
+                Interlocked.Increment(ref _cacheHits);
+                _logger.LogTrace("Lua compile cache hit for {Hash}", hash);
+                return cached;
+            }
+        }
 
-        script.Globals["msleep"] = (Func<double, DynValue>)(ms =>
-        {
-            DelayWithCancellation(TimeSpan.FromMilliseconds(ms), ct).GetAwaiter().GetResult();
-            return DynValue.Nil;
-        });
+        Interlocked.Increment(ref _cacheMisses);
+        _logger.LogTrace("Lua compile cache miss for {Hash}", hash);
 
-        // Unified move function - uses high-level or low-level based on input mode
-        script.Globals["move"] = (Action<int, int>)((x, y) =>
+        // Compile outside the lock; syntax errors propagate to the caller and nothing is cached.
+        var sandbox = CreateSandbox(hash, code);
+
+        lock (_cacheLock)
         {
-            ct.ThrowIfCancellationRequested();
-            if (inputMode == InputMode.LowLevel)
+            // Another run of the same source may hold the cached copy; this one stays transient.
+            if (!_cache.ContainsKey(hash))
             {
-                inputSimulator.SimulateMouseMoveLowLevelAsync(new Point(x, y)).GetAwaiter().GetResult();
+                EvictIfFull();
+                _cache[hash] = sandbox;
+                sandbox.IsCached = true;
             }
-            else
+        }
+
+        return sandbox;
+    }
+
+    private void ReleaseSandbox(LuaSandbox sandbox, bool completed)
+    {
+        sandbox.End();
+
+        lock (_cacheLock)
+        {
+            sandbox.IsLeased = false;
+
+            // A run aborted mid-instruction (error, cancellation, limits) may leave interpreter state behind.
+            if (!completed && sandbox.IsCached && _cache.TryGetValue(sandbox.SourceHash, out var cached) && ReferenceEquals(cached, sandbox))
             {
-                inputSimulator.SimulateMouseMoveAsync(new Point(x, y)).GetAwaiter().GetResult();
+                _cache.Remove(sandbox.SourceHash);
+                sandbox.IsCached = false;
             }
-        });
+        }
+    }
 
-        // Unified relative move function - uses high-level or low-level based on input mode setting
-        script.Globals["move_rel"] = (Action<int, int>)((dx, dy) =>
+    private void EvictIfFull()
+    {
+        while (_cache.Count >= MaxCachedScripts)
         {
-            ct.ThrowIfCancellationRequested();
-            if (inputMode == InputMode.LowLevel)
+            LuaSandbox? oldest = null;
+            foreach (var entry in _cache.Values)
             {
-                inputSimulator.SimulateMouseMoveRelativeLowLevelAsync(dx, dy).GetAwaiter().GetResult();
+                if (!entry.IsLeased && (oldest == null || entry.LastUsedTicks < oldest.LastUsedTicks))
+                    oldest = entry;
             }
-            else
+
+            if (oldest == null)
+                return;
+
+            _cache.Remove(oldest.SourceHash);
+            oldest.IsCached = false;
+        }
+    }
+
+    private LuaSandbox CreateSandbox(string hash, string code)
+    {
+        // Sandbox: only keep safe core modules; pcall backs the host call wrapper.
+        var script = new Script(CoreModules.Basic | CoreModules.String | CoreModules.Table | CoreModules.Math | CoreModules.ErrorHandling);
+
+        script.Options.DebugPrint = s => _logger.LogInformation("[lua] {Text}", s);
+
+        var run = new LuaRunContext(new LuaRunGuard(_safetyService));
+
+        // The debugger is only enabled for interactive runs; see LuaSandbox.Begin.
+        script.AttachDebugger(new LimiterDebugger(run.Guard));
+        script.DebuggerEnabled = false;
+
+        RegisterHostApi(script, run);
+
+        var chunk = script.LoadString(code);
+        var sandbox = new LuaSandbox(hash, script, chunk, run)
+        {
+            IsLeased = true,
+            LastUsedTicks = Environment.TickCount64
+        };
+        return sandbox;
+    }
+
+    private static void RegisterHostApi(Script script, LuaRunContext run)
+    {
+        // Host API: bindings read the current run from the context so the sandbox can be reused.
+        // Each binding returns a Task; unfinished tasks suspend the script coroutine instead of blocking a thread.
+        var wrap = script.Call(
+            script.LoadString(HostCallWrapper, null, "host"),
+            DynValue.NewCallback((_, _) => DynValue.NewYieldReq(Array.Empty<DynValue>()), "suspend"),
+            DynValue.NewCallback((_, _) =>
             {
-                inputSimulator.SimulateMouseMoveRelativeAsync(dx, dy).GetAwaiter().GetResult();
-            }
-        });
+                run.WaitForPendingOperation();
+                return DynValue.Nil;
+            }, "wait"));
+
+        RegisterHostFunction(script, run, wrap, "sleep", args =>
+            run.SleepAsync(TimeSpan.FromSeconds(ReadNumber(args, 0, "sleep"))), timedAction: false);
 
-        script.Globals["type_text"] = (Action<string>)(text =>
+        RegisterHostFunction(script, run, wrap, "msleep", args =>
+            run.SleepAsync(TimeSpan.FromMilliseconds(ReadNumber(args, 0, "msleep"))), timedAction: false);
+
+        // Unified move function - uses high-level or low-level based on input mode
+        RegisterHostFunction(script, run, wrap, "move", args =>
         {
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateKeyboardInputAsync(text ?? string.Empty).GetAwaiter().GetResult();
+            var position = new Point(ReadInt(args, 0, "move"), ReadInt(args, 1, "move"));
+            return run.InputMode == InputMode.LowLevel
+                ? run.InputSimulator.SimulateMouseMoveLowLevelAsync(position)
+                : run.InputSimulator.SimulateMouseMoveAsync(position, run.CancellationToken);
         });
 
-        script.Globals["mouse_click"] = (Action<string>)(button =>
+        // Unified relative move function - uses high-level or low-level based on input mode setting
+        RegisterHostFunction(script, run, wrap, "move_rel", args =>
         {
-            var b = ParseMouseButton(button);
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateMouseClickAsync(b, ClickType.Click).GetAwaiter().GetResult();
+            var dx = ReadInt(args, 0, "move_rel");
+            var dy = ReadInt(args, 1, "move_rel");
+            return run.InputMode == InputMode.LowLevel
+                ? run.InputSimulator.SimulateMouseMoveRelativeLowLevelAsync(dx, dy)
+                : run.InputSimulator.SimulateMouseMoveRelativeAsync(dx, dy);
         });
 
-        script.Globals["mouse_down"] = (Action<string>)(button =>
+        // Packed relative motion: move_stream({dx1, dy1, dt1, dx2, dy2, dt2, ...}), each dt waited before its move.
+        // Hardware mode hands the whole run to the device clock; other modes pace it here.
+        RegisterHostFunction(script, run, wrap, "move_stream", args =>
         {
-            var b = ParseMouseButton(button);
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateMouseClickAsync(b, ClickType.Down).GetAwaiter().GetResult();
-        });
+            var samples = ParseMotionSamples(args[0].Type == DataType.Table ? args[0].Table : null);
+            return PlayMotionStreamAsync(run, samples);
+        }, timedAction: false);
+
+        RegisterHostFunction(script, run, wrap, "type_text", args =>
+            run.InputSimulator.SimulateKeyboardInputAsync(args[0].CastToString() ?? string.Empty));
+
+        RegisterHostFunction(script, run, wrap, "mouse_click", args =>
+            run.InputSimulator.SimulateMouseClickAsync(ParseMouseButton(args[0].CastToString()), ClickType.Click));
+
+        RegisterHostFunction(script, run, wrap, "mouse_down", args =>
+            run.InputSimulator.SimulateMouseClickAsync(ParseMouseButton(args[0].CastToString()), ClickType.Down));
 
-        script.Globals["mouse_release"] = (Action<string>)(button =>
+        RegisterHostFunction(script, run, wrap, "mouse_release", args =>
+            run.InputSimulator.SimulateMouseClickAsync(ParseMouseButton(args[0].CastToString()), ClickType.Up));
+
+        RegisterHostFunction(script, run, wrap, "key_down", args =>
+            run.InputSimulator.SimulateKeyPressAsync(ParseVirtualKey(args[0].CastToString()), true));
+
+        RegisterHostFunction(script, run, wrap, "key_release", args =>
+            run.InputSimulator.SimulateKeyPressAsync(ParseVirtualKey(args[0].CastToString()), false));
+
+        // Back the prelude's batch(); committing may suspend the script while the inputs are sent.
+        var batchBegin = CreateHostFunction(script, run, wrap, "batch_begin", _ =>
         {
-            var b = ParseMouseButton(button);
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateMouseClickAsync(b, ClickType.Up).GetAwaiter().GetResult();
-        });
+            run.BeginBatch();
+            return Task.CompletedTask;
+        }, timedAction: false);
+
+        var batchEnd = CreateHostFunction(script, run, wrap, "batch_end", args =>
+            run.EndBatchAsync(commit: args[0].CastToBool()), timedAction: false);
+
+        script.Globals["batch"] = script.Call(script.LoadString(HostPrelude, null, "prelude"), batchBegin, batchEnd);
+    }
 
-        script.Globals["key_down"] = (Action<string>)(key =>
+    private static void RegisterHostFunction(Script script, LuaRunContext run, DynValue wrap, string name, Func<CallbackArguments, Task> invoke, bool timedAction = true)
+    {
+        script.Globals[name] = CreateHostFunction(script, run, wrap, name, invoke, timedAction);
+    }
+
+    private static DynValue CreateHostFunction(Script script, LuaRunContext run, DynValue wrap, string name, Func<CallbackArguments, Task> invoke, bool timedAction)
+    {
+        return script.Call(wrap, DynValue.NewCallback((_, args) =>
         {
-            var vk = ParseVirtualKey(key);
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateKeyPressAsync(vk, true).GetAwaiter().GetResult();
-        });
+            run.CheckLimits();
+
+            if (timedAction)
+                run.Timeline?.MarkAction();
+
+            // Only input actions are measured; batch markers and streams would skew the per-call numbers
+            var latency = timedAction ? run.LatencyMonitor : null;
+            var start = latency != null ? Stopwatch.GetTimestamp() : 0;
+
+            var operation = invoke(args);
+            latency?.Record(InputLatencyStage.HostCall, start);
+            if (operation.IsCompleted)
+            {
+                // Already done (e.g. a queued serial write): surface faults and carry on without a round-trip.
+                operation.GetAwaiter().GetResult();
+                return DynValue.False;
+            }
+
+            // The wrapper suspends the script; the driver awaits the operation and resumes it.
+            run.PendingOperation = operation;
+            run.PendingOperationTimestamp = start;
+            return DynValue.True;
+        }, name));
+    }
+
+    private static async Task PlayMotionStreamAsync(LuaRunContext run, IReadOnlyList<MotionSample> samples)
+    {
+        var ct = run.CancellationToken;
+        var inputSimulator = run.InputSimulator;
+        var inputMode = run.InputMode;
 
-        script.Globals["key_release"] = (Action<string>)(key =>
+        if (inputMode == InputMode.Hardware)
         {
-            var vk = ParseVirtualKey(key);
-            ct.ThrowIfCancellationRequested();
-            inputSimulator.SimulateKeyPressAsync(vk, false).GetAwaiter().GetResult();
-        });
+            run.Timeline?.MarkAction();
+            await inputSimulator.SimulateMouseMotionAsync(samples).ConfigureAwait(false);
 
-        // Execute: run on threadpool so the caller can await without blocking UI.
-        await Task.Run(() =>
+            // Keep script timing identical to host-paced playback
+            var totalMs = samples.Sum(s => (long)s.DelayMs);
+            await run.SleepAsync(TimeSpan.FromMilliseconds(totalMs)).ConfigureAwait(false);
+            return;
+        }
+
+        foreach (var sample in samples)
         {
-            var chunk = script.LoadString(code);
-            script.Call(chunk);
-        }, ct);
+            if (sample.DelayMs > 0)
+            {
+                await run.SleepAsync(TimeSpan.FromMilliseconds(sample.DelayMs)).ConfigureAwait(false);
+            }
+
+            ct.ThrowIfCancellationRequested();
+            run.Timeline?.MarkAction();
+            if (inputMode == InputMode.LowLevel)
+            {
+                await inputSimulator.SimulateMouseMoveRelativeLowLevelAsync(sample.DeltaX, sample.DeltaY).ConfigureAwait(false);
+            }
+            else
+            {
+                await inputSimulator.SimulateMouseMoveRelativeAsync(sample.DeltaX, sample.DeltaY).ConfigureAwait(false);
+            }
+        }
+    }
+
+    private static double ReadNumber(CallbackArguments args, int index, string name)
+    {
+        var value = args[index].CastToNumber();
+        if (value == null)
+            throw new ScriptRuntimeException($"bad argument #{index + 1} to '{name}' (number expected)");
+
+        return value.Value;
+    }
+
+    private static int ReadInt(CallbackArguments args, int index, string name)
+    {
+        // Truncate toward zero; Convert.ToInt32 would round half to even (2.5 -> 2, 3.5 -> 4)
+        var value = Math.Truncate(ReadNumber(args, index, name));
+        if (double.IsNaN(value) || value < int.MinValue || value > int.MaxValue)
+            throw new ScriptRuntimeException($"bad argument #{index + 1} to '{name}' (number has no integer representation)");
+
+        return (int)value;
+    }
+
+    private static string ComputeSourceHash(string code)
+    {
+        return Convert.ToHexString(SHA256.HashData(Encoding.UTF8.GetBytes(code)));
     }
 
-    private static async Task DelayWithCancellation(TimeSpan duration, CancellationToken ct)
+    private static Task DelayWithCancellation(TimeSpan duration, CancellationToken ct)
     {
         if (duration <= TimeSpan.Zero)
-            return;
+            return ct.IsCancellationRequested ? Task.FromCanceled(ct) : Task.CompletedTask;
+
+        // One timer per sleep; the token cancels it immediately, so no polling slices are needed.
+        return Task.Delay(duration, ct);
+    }
+
+    private static IReadOnlyList<MotionSample> ParseMotionSamples(Table? table)
+    {
+        if (table == null)
+            throw new ScriptRuntimeException("move_stream expects a table of {dx, dy, dt, ...}");
 
-        // Use small slices so cancellation is responsive.
-        var remaining = duration;
-        var slice = TimeSpan.FromMilliseconds(50);
+        var length = table.Length;
+        if (length == 0 || length % 3 != 0)
+            throw new ScriptRuntimeException("move_stream expects a non-empty table of {dx, dy, dt} triples");
 
-        while (remaining > TimeSpan.Zero)
+        var samples = new MotionSample[length / 3];
+        for (int i = 0; i < samples.Length; i++)
         {
-            ct.ThrowIfCancellationRequested();
-            var current = remaining < slice ? remaining : slice;
-            await Task.Delay(current, ct);
-            remaining -= current;
+            var dx = ReadInteger(table, i * 3 + 1);
+            var dy = ReadInteger(table, i * 3 + 2);
+            var dt = ReadInteger(table, i * 3 + 3);
+            if (dt < 0)
+                throw new ScriptRuntimeException("move_stream delay cannot be negative");
+
+            samples[i] = new MotionSample(dx, dy, dt);
         }
+
+        return samples;
+    }
+
+    private static int ReadInteger(Table table, int index)
+    {
+        var value = table.Get(index);
+        if (value.Type != DataType.Number)
+            throw new ScriptRuntimeException($"move_stream element {index} is not a number");
+
+        // Same conversion as ReadInt, so move_stream({2.5, 0, 0}) moves like move_rel(2.5, 0)
+        var number = Math.Truncate(value.Number);
+        if (double.IsNaN(number) || number < int.MinValue || number > int.MaxValue)
+            throw new ScriptRuntimeException($"move_stream element {index} has no integer representation");
+
+        return (int)number;
     }
 
     private static MouseButton ParseMouseButton(string? button)
@@ -196,19 +506,360 @@ public sealed class LuaScriptRunner
         throw new ScriptRuntimeException($"unsupported key '{k}'");
     }
 
-    private sealed class LimiterDebugger : IDebugger
+    /// <summary>
+    /// A compiled chunk together with its Script, bound host API and limiter, reusable across runs.
+    /// </summary>
+    private sealed class LuaSandbox
+    {
+        private readonly LuaRunContext _run;
+        private readonly TableSnapshot _baselineGlobals;
+        private readonly List<TableSnapshot> _baselineLibraries;
+
+        public LuaSandbox(string sourceHash, Script script, DynValue chunk, LuaRunContext run)
+        {
+            SourceHash = sourceHash;
+            Script = script;
+            Chunk = chunk;
+            _run = run;
+            _baselineGlobals = new TableSnapshot(script.Globals);
+
+            // Library tables (string, math, table, ...) are shared by reference, so a script that patches
+            // string.format would otherwise leak the change into every later run of the cached sandbox.
+            _baselineLibraries = script.Globals.Pairs
+                .Where(pair => pair.Value.Type == DataType.Table && !ReferenceEquals(pair.Value.Table, script.Globals))
+                .Select(pair => new TableSnapshot(pair.Value.Table))
+                .ToList();
+            if (script.GetTypeMetatable(DataType.String) is { } stringMetatable)
+                _baselineLibraries.Add(new TableSnapshot(stringMetatable));
+        }
+
+        public string SourceHash { get; }
+        public Script Script { get; }
+        public DynValue Chunk { get; }
+
+        // Guarded by the runner's cache lock
+        public bool IsLeased { get; set; }
+        public bool IsCached { get; set; }
+        public long LastUsedTicks { get; set; }
+
+        public void Begin(IInputSimulator inputSimulator, InputMode inputMode, IPrecisionTimer? precisionTimer, PlaybackTimeline? timeline, CancellationToken ct, LuaExecutionLimits limits, IInputLatencyMonitor? latencyMonitor)
+        {
+            _run.InputSimulator = inputSimulator;
+            _run.LatencyMonitor = latencyMonitor;
+            _run.InputMode = inputMode;
+            _run.PrecisionTimer = precisionTimer;
+            _run.Timeline = timeline;
+            timeline?.Start();
+            _run.CancellationToken = ct;
+            _run.Guard.Reset(ct, limits);
+
+            // The per-instruction debugger hook forces MoonSharp onto its slower dispatch path
+            Script.DebuggerEnabled = limits.UseDebugger;
+        }
+
+        public async Task RunAsync()
+        {
+            var guard = _run.Guard;
+
+            // Always run as a coroutine so host functions can suspend the script while their task runs.
+            // Without the debugger, the VM also force-suspends every CheckInterval instructions so limits
+            // are checked in batches instead of per instruction.
+            var coroutine = Script.CreateCoroutine(Chunk).Coroutine;
+            coroutine.AutoYieldCounter = Script.DebuggerEnabled ? 0 : guard.CheckInterval;
+
+            try
+            {
+                coroutine.Resume();
+                while (coroutine.State != CoroutineState.Dead)
+                {
+                    if (coroutine.State == CoroutineState.ForceSuspended)
+                    {
+                        guard.AddSteps(guard.CheckInterval);
+                        guard.Check();
+                    }
+                    else if (_run.PendingOperation is { } operation)
+                    {
+                        _run.PendingOperation = null;
+                        await operation.ConfigureAwait(false);
+                        _run.RecordResume();
+
+                        // MoonSharp restarts its auto-yield count on every Resume, so a script that suspends
+                        // more often than CheckInterval is never force-suspended: charge each suspension instead.
+                        if (!Script.DebuggerEnabled)
+                            guard.AddSteps(1);
+                        guard.Check();
+                    }
+
+                    coroutine.Resume();
+                }
+            }
+            catch (LuaRunStoppedException ex)
+            {
+                // Out of the VM now, so the stop is reported as the script error callers expect
+                throw new ScriptRuntimeException(ex.Message);
+            }
+        }
+
+        public void End()
+        {
+            // A run that stopped inside batch() drops its uncommitted inputs rather than sending them late
+            _run.DiscardBatches();
+            _run.InputSimulator = null!;
+            _run.PrecisionTimer = null;
+            _run.Timeline = null;
+            _run.PendingOperation = null;
+            _run.PendingOperationTimestamp = 0;
+            _run.LatencyMonitor = null;
+            _run.CancellationToken = CancellationToken.None;
+
+            // Drop globals the script defined and restore any it overwrote, so each run starts clean.
+            _baselineGlobals.Restore();
+            foreach (var library in _baselineLibraries)
+            {
+                library.Restore();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Contents and metatable of a table, captured so a run's changes to it can be undone.
+    /// </summary>
+    private sealed class TableSnapshot
+    {
+        private readonly Table _table;
+        private readonly List<TablePair> _pairs;
+        private readonly Table? _metaTable;
+
+        public TableSnapshot(Table table)
+        {
+            _table = table;
+            _pairs = table.Pairs.ToList();
+            _metaTable = table.MetaTable;
+        }
+
+        public void Restore()
+        {
+            foreach (var key in _table.Keys.ToList())
+            {
+                _table.Remove(key);
+            }
+            foreach (var pair in _pairs)
+            {
+                _table.Set(pair.Key, pair.Value);
+            }
+            _table.MetaTable = _metaTable;
+        }
+    }
+
+    /// <summary>
+    /// Per-run state read by the host API bindings of a cached sandbox.
+    /// </summary>
+    private sealed class LuaRunContext
+    {
+        private readonly Stack<IInputBatch> _batches = new();
+
+        public LuaRunContext(LuaRunGuard guard)
+        {
+            Guard = guard;
+        }
+
+        public LuaRunGuard Guard { get; }
+        public IInputSimulator InputSimulator { get; set; } = null!;
+        public InputMode InputMode { get; set; }
+        public CancellationToken CancellationToken { get; set; }
+        public IPrecisionTimer? PrecisionTimer { get; set; }
+        public PlaybackTimeline? Timeline { get; set; }
+
+        /// <summary>
+        /// Host operation the script coroutine is suspended on, if any.
+        /// </summary>
+        public Task? PendingOperation { get; set; }
+
+        /// <summary>
+        /// Stopwatch timestamp of the host call behind <see cref="PendingOperation"/>; 0 when not measured.
+        /// </summary>
+        public long PendingOperationTimestamp { get; set; }
+
+        public IInputLatencyMonitor? LatencyMonitor { get; set; }
+
+        /// <summary>
+        /// Blocks until <see cref="PendingOperation"/> finishes, for host calls made where the script cannot be suspended.
+        /// </summary>
+        public void WaitForPendingOperation()
+        {
+            var operation = PendingOperation;
+            PendingOperation = null;
+            if (operation == null)
+                return;
+
+            operation.GetAwaiter().GetResult();
+            RecordResume();
+        }
+
+        /// <summary>
+        /// Records the time from a host call to the script continuing after its operation, if it was measured.
+        /// </summary>
+        public void RecordResume()
+        {
+            if (PendingOperationTimestamp == 0)
+                return;
+
+            LatencyMonitor?.Record(InputLatencyStage.HostResume, PendingOperationTimestamp);
+            PendingOperationTimestamp = 0;
+        }
+
+        /// <summary>
+        /// Script sleep: precision timer when the run opted in, otherwise the default timer.
+        /// </summary>
+        public Task DelayAsync(TimeSpan duration)
+        {
+            if (PrecisionTimer != null && duration > TimeSpan.Zero)
+                return PrecisionTimer.DelayAsync(duration, CancellationToken);
+
+            return DelayWithCancellation(duration, CancellationToken);
+        }
+
+        /// <summary>
+        /// Script-level delay: relative by default, or up to the next deadline when a timeline is active.
+        /// </summary>
+        public Task SleepAsync(TimeSpan duration)
+        {
+            // Inputs queued before a sleep inside batch() belong before it
+            if (_batches.Count > 0)
+                return FlushThenSleepAsync(_batches.Peek(), duration);
+
+            return SleepCoreAsync(duration);
+        }
+
+        /// <summary>
+        /// Opens an input batch for the script's batch() call.
+        /// </summary>
+        public void BeginBatch()
+        {
+            _batches.Push(InputSimulator.BeginBatch());
+        }
+
+        /// <summary>
+        /// Closes the innermost batch, submitting its inputs or discarding them.
+        /// </summary>
+        /// <param name="commit">True to submit the buffered inputs; false to drop them.</param>
+        public Task EndBatchAsync(bool commit)
+        {
+            if (_batches.Count == 0)
+                throw new ScriptRuntimeException("batch end without a matching begin");
+
+            var batch = _batches.Pop();
+            return commit ? batch.CommitAsync() : batch.DisposeAsync().AsTask();
+        }
+
+        /// <summary>
+        /// Closes any batches left open without submitting them.
+        /// </summary>
+        public void DiscardBatches()
+        {
+            while (_batches.Count > 0)
+            {
+                _batches.Pop().DisposeAsync().AsTask().GetAwaiter().GetResult();
+            }
+        }
+
+        private async Task FlushThenSleepAsync(IInputBatch batch, TimeSpan duration)
+        {
+            await batch.FlushAsync().ConfigureAwait(false);
+            await SleepCoreAsync(duration).ConfigureAwait(false);
+        }
+
+        private Task SleepCoreAsync(TimeSpan duration)
+        {
+            if (Timeline == null)
+                return DelayAsync(duration);
+
+            var wait = Timeline.Advance(duration);
+            return wait > TimeSpan.Zero ? DelayAsync(wait) : Task.CompletedTask;
+        }
+
+        /// <summary>
+        /// Host API boundary check: prompt cancellation plus kill switch and limits.
+        /// </summary>
+        public void CheckLimits()
+        {
+            CancellationToken.ThrowIfCancellationRequested();
+            Guard.Check();
+        }
+    }
+
+    /// <summary>
+    /// Tracks steps and elapsed time for one run and enforces cancellation, kill switch and limits.
+    /// </summary>
+    private sealed class LuaRunGuard
     {
         private readonly ISafetyService _safetyService;
-        private readonly CancellationToken _ct;
-        private readonly LuaExecutionLimits _limits;
-        private readonly DateTime _startedUtc = DateTime.UtcNow;
+        private CancellationToken _ct;
+        private LuaExecutionLimits _limits = LuaExecutionLimits.Default();
+        private long _startTimestamp = Stopwatch.GetTimestamp();
+        private long _maxElapsedTicks;
         private long _steps;
 
-        public LimiterDebugger(ISafetyService safetyService, CancellationToken ct, LuaExecutionLimits limits)
+        public LuaRunGuard(ISafetyService safetyService)
         {
             _safetyService = safetyService;
+        }
+
+        public int CheckInterval { get; private set; } = LuaExecutionLimits.DefaultCheckInterval;
+
+        public void Reset(CancellationToken ct, LuaExecutionLimits limits)
+        {
             _ct = ct;
             _limits = limits;
+            _steps = 0;
+            CheckInterval = Math.Max(1, limits.CheckInterval);
+            _maxElapsedTicks = limits.MaxExecutionTime > TimeSpan.Zero
+                ? (long)(limits.MaxExecutionTime.TotalSeconds * Stopwatch.Frequency)
+                : 0;
+            _startTimestamp = Stopwatch.GetTimestamp();
+        }
+
+        public void AddSteps(long steps) => _steps += steps;
+
+        public void Check()
+        {
+            if (_ct.IsCancellationRequested)
+                throw new LuaRunStoppedException("cancelled");
+
+            if (_safetyService.IsKillSwitchActive)
+                throw new LuaRunStoppedException("kill_switch");
+
+            if (_limits.MaxSteps > 0 && _steps > _limits.MaxSteps)
+                throw new LuaRunStoppedException("step_limit");
+
+            if (_maxElapsedTicks > 0 && Stopwatch.GetTimestamp() - _startTimestamp > _maxElapsedTicks)
+                throw new LuaRunStoppedException("time_limit");
+        }
+    }
+
+    /// <summary>
+    /// Stops a run from inside the VM. Deliberately not an <see cref="InterpreterException"/>: pcall and xpcall
+    /// only catch those, so a script cannot swallow a stop. The driver rethrows it as a script error.
+    /// </summary>
+    private sealed class LuaRunStoppedException : Exception
+    {
+        public LuaRunStoppedException(string reason)
+            : base(reason)
+        {
+        }
+    }
+
+    /// <summary>
+    /// Per-instruction hook used for interactive runs; limits are still checked every CheckInterval steps.
+    /// </summary>
+    private sealed class LimiterDebugger : IDebugger
+    {
+        private readonly LuaRunGuard _guard;
+        private int _pendingSteps;
+
+        public LimiterDebugger(LuaRunGuard guard)
+        {
+            _guard = guard;
         }
 
         public DebuggerCaps GetDebuggerCaps() => (DebuggerCaps)0;
@@ -226,24 +877,17 @@ public sealed class LuaScriptRunner
 
         public DebuggerAction GetAction(int ip, SourceRef sourceref)
         {
-            _steps++;
-
-            if (_ct.IsCancellationRequested)
-                throw new ScriptRuntimeException("cancelled");
-
-            if (_safetyService.IsKillSwitchActive)
-                throw new ScriptRuntimeException("kill_switch");
-
-            if (_limits.MaxSteps > 0 && _steps > _limits.MaxSteps)
-                throw new ScriptRuntimeException("step_limit");
-
-            if (_limits.MaxExecutionTime > TimeSpan.Zero && DateTime.UtcNow - _startedUtc > _limits.MaxExecutionTime)
-                throw new ScriptRuntimeException("time_limit");
+            if (++_pendingSteps >= _guard.CheckInterval)
+            {
+                _guard.AddSteps(_pendingSteps);
+                _pendingSteps = 0;
+                _guard.Check();
+            }
 
             return new DebuggerAction { Action = DebuggerAction.ActionType.Run };
         }
 
-        public void SignalExecutionEnded() { }
+        public void SignalExecutionEnded() => _pendingSteps = 0;
         public void Update(WatchType watchType, IEnumerable<WatchItem> items) { }
         public List<DynamicExpression> GetWatchItems() => new();
         public void RefreshBreakpoints(IEnumerable<SourceRef> refs) { }
@@ -252,9 +896,37 @@ public sealed class LuaScriptRunner
 
 public sealed class LuaExecutionLimits
 {
+    public const int DefaultCheckInterval = 1000;
+
+    /// <summary>
+    /// Maximum VM instructions per run; 0 for no limit. Without the debugger, instructions followed by a host
+    /// call that suspends the script are not counted and the suspension is charged as one step instead.
+    /// </summary>
     public long MaxSteps { get; init; } = 200_000;
     public TimeSpan MaxExecutionTime { get; init; } = TimeSpan.FromMinutes(2);
 
+    /// <summary>
+    /// Number of VM instructions between limit checks. Step limits are enforced at this granularity.
+    /// </summary>
+    public int CheckInterval { get; init; } = DefaultCheckInterval;
+
+    /// <summary>
+    /// Attach the per-instruction debugger hook (interactive runs). Off by default because it slows the VM.
+    /// </summary>
+    public bool UseDebugger { get; init; }
+
+    /// <summary>
+    /// Use the precision timer (if one is registered) for sleep/msleep and move_stream pacing.
+    /// </summary>
+    public bool UseHighPrecisionTiming { get; init; }
+
     public static LuaExecutionLimits Default() => new();
 }
 
+/// <summary>
+/// Counters for the LuaScriptRunner compile cache.
+/// </summary>
+/// <param name="Hits">Runs that reused a compiled sandbox.</param>
+/// <param name="Misses">Runs that had to compile the source.</param>
+/// <param name="CachedScripts">Compiled sandboxes currently cached.</param>
+public readonly record struct LuaCompileCacheStatistics(long Hits, long Misses, int CachedScripts);
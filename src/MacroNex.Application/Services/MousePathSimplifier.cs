@@ -0,0 +1,207 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// A mouse sample kept by <see cref="MousePathSimplifier"/>.
+/// </summary>
+/// <param name="Position">Absolute (or accumulated) cursor position.</param>
+/// <param name="Timestamp">When the sample was captured.</param>
+public readonly record struct MousePathPoint(Point Position, DateTime Timestamp);
+
+/// <summary>
+/// Streaming mouse path simplifier used while recording.
+/// Samples closer together than the coalesce interval are merged (latest position wins), then each
+/// stroke is reduced with Ramer–Douglas–Peucker so only points that deviate from the drawn path by
+/// more than the tolerance survive. Stroke endpoints are always kept, so the final position is exact.
+/// </summary>
+public sealed class MousePathSimplifier
+{
+    /// <summary>
+    /// Default maximum number of buffered samples before a stroke is simplified and emitted.
+    /// </summary>
+    public const int DefaultMaxBufferedPoints = 256;
+
+    /// <summary>
+    /// Default idle gap that ends a stroke; keeps hover pauses at their original time.
+    /// </summary>
+    public static readonly TimeSpan DefaultStrokeBreakGap = TimeSpan.FromMilliseconds(100);
+
+    private readonly TimeSpan _coalesceInterval;
+    private readonly double _toleranceSquared;
+    private readonly TimeSpan _strokeBreakGap;
+    private readonly int _maxBufferedPoints;
+    private readonly List<MousePathPoint> _buffer = new();
+    private readonly Stack<(int Start, int End)> _ranges = new();
+    private bool[] _keep = Array.Empty<bool>();
+
+    private MousePathPoint _anchor;
+    private bool _hasAnchor;
+    private DateTime _coalesceStart; // capture time of the sample that opened the last buffered slot
+
+    /// <summary>
+    /// Initializes a new simplifier.
+    /// </summary>
+    /// <param name="coalesceInterval">Samples arriving within this interval of the first sample in a slot replace
+    /// that slot's sample, so at most one sample is kept per interval.</param>
+    /// <param name="tolerance">Maximum perpendicular deviation, in pixels, of a dropped sample.</param>
+    /// <param name="strokeBreakGap">An idle gap longer than this ends the current stroke.</param>
+    /// <param name="maxBufferedPoints">Samples buffered before a stroke is emitted early.</param>
+    public MousePathSimplifier(
+        TimeSpan coalesceInterval,
+        double tolerance,
+        TimeSpan? strokeBreakGap = null,
+        int maxBufferedPoints = DefaultMaxBufferedPoints)
+    {
+        if (coalesceInterval < TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(coalesceInterval), "Coalesce interval cannot be negative.");
+        if (tolerance < 0 || double.IsNaN(tolerance))
+            throw new ArgumentOutOfRangeException(nameof(tolerance), "Tolerance cannot be negative.");
+        if (maxBufferedPoints < 2)
+            throw new ArgumentOutOfRangeException(nameof(maxBufferedPoints), "At least two points must be buffered.");
+
+        _coalesceInterval = coalesceInterval;
+        _toleranceSquared = tolerance * tolerance;
+        _strokeBreakGap = strokeBreakGap ?? DefaultStrokeBreakGap;
+        _maxBufferedPoints = maxBufferedPoints;
+    }
+
+    /// <summary>
+    /// Gets whether an anchor (the last emitted point) is set.
+    /// </summary>
+    public bool HasAnchor => _hasAnchor;
+
+    /// <summary>
+    /// Gets the number of samples waiting to be simplified.
+    /// </summary>
+    public int PendingCount => _buffer.Count;
+
+    /// <summary>
+    /// Sets the point the next stroke starts from (typically the last recorded position).
+    /// Pending samples are discarded; call <see cref="Flush"/> first to keep them.
+    /// </summary>
+    public void SetAnchor(Point position, DateTime timestamp)
+    {
+        _buffer.Clear();
+        _anchor = new MousePathPoint(position, timestamp);
+        _hasAnchor = true;
+    }
+
+    /// <summary>
+    /// Clears the anchor and pending samples; the next sample is emitted as-is and becomes the anchor.
+    /// </summary>
+    public void Reset()
+    {
+        _buffer.Clear();
+        _hasAnchor = false;
+    }
+
+    /// <summary>
+    /// Adds a sample, appending any points that become final to <paramref name="output"/>.
+    /// </summary>
+    public void Add(Point position, DateTime timestamp, List<MousePathPoint> output)
+    {
+        var point = new MousePathPoint(position, timestamp);
+
+        if (!_hasAnchor)
+        {
+            _anchor = point;
+            _hasAnchor = true;
+            output.Add(point);
+            return;
+        }
+
+        var previous = _buffer.Count > 0 ? _buffer[^1] : _anchor;
+        if (timestamp - previous.Timestamp > _strokeBreakGap)
+        {
+            // The cursor rested: close the stroke so the rest point keeps its own timestamp
+            Flush(output);
+        }
+        else if (_buffer.Count > 0 && timestamp - _coalesceStart < _coalesceInterval)
+        {
+            // Measured from the slot's first sample: a steady stream faster than the interval must not
+            // keep replacing the same slot forever
+            _buffer[^1] = point;
+            return;
+        }
+
+        _buffer.Add(point);
+        _coalesceStart = timestamp;
+        if (_buffer.Count >= _maxBufferedPoints)
+            Flush(output);
+    }
+
+    /// <summary>
+    /// Simplifies and emits all pending samples. The last pending sample becomes the new anchor.
+    /// </summary>
+    public void Flush(List<MousePathPoint> output)
+    {
+        if (_buffer.Count == 0)
+            return;
+
+        // Path is anchor followed by the buffer; index 0 refers to the anchor
+        var count = _buffer.Count + 1;
+        if (_keep.Length < count)
+            _keep = new bool[Math.Max(count, _maxBufferedPoints + 1)];
+        Array.Clear(_keep, 0, count);
+        _keep[0] = true;
+        _keep[count - 1] = true;
+
+        _ranges.Push((0, count - 1));
+        while (_ranges.Count > 0)
+        {
+            var (start, end) = _ranges.Pop();
+            if (end - start < 2)
+                continue;
+
+            var a = PointAt(start).Position;
+            var b = PointAt(end).Position;
+            var maxDistance = -1.0;
+            var maxIndex = -1;
+            for (var i = start + 1; i < end; i++)
+            {
+                var distance = DistanceToSegmentSquared(PointAt(i).Position, a, b);
+                if (distance > maxDistance)
+                {
+                    maxDistance = distance;
+                    maxIndex = i;
+                }
+            }
+
+            if (maxDistance > _toleranceSquared)
+            {
+                _keep[maxIndex] = true;
+                _ranges.Push((start, maxIndex));
+                _ranges.Push((maxIndex, end));
+            }
+        }
+
+        for (var i = 1; i < count; i++)
+        {
+            if (_keep[i])
+                output.Add(_buffer[i - 1]);
+        }
+
+        _anchor = _buffer[^1];
+        _buffer.Clear();
+    }
+
+    private MousePathPoint PointAt(int index) => index == 0 ? _anchor : _buffer[index - 1];
+
+    private static double DistanceToSegmentSquared(Point p, Point a, Point b)
+    {
+        double dx = b.X - a.X;
+        double dy = b.Y - a.Y;
+        double px = p.X - a.X;
+        double py = p.Y - a.Y;
+
+        var lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared == 0)
+            return px * px + py * py;
+
+        var t = Math.Clamp((px * dx + py * dy) / lengthSquared, 0, 1);
+        var ex = px - t * dx;
+        var ey = py - t * dy;
+        return ex * ex + ey * ey;
+    }
+}
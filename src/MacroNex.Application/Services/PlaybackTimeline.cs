@@ -0,0 +1,98 @@
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Application.Services;
+
+/// <summary>
+/// Absolute playback timeline for deadline-based execution.
+/// Script delays advance the scheduled offset, and each wait targets origin + offset,
+/// so time spent inside input calls is absorbed instead of accumulating as drift.
+/// </summary>
+public sealed class PlaybackTimeline
+{
+    private readonly DeadlineOverrunPolicy _overrunPolicy;
+    private readonly long _maxCatchUpTicks;
+    private readonly Action<TimeSpan>? _onActionLateness;
+    private readonly Action? _onResync;
+    private readonly TimeProvider _timeProvider;
+
+    private long _originTimestamp;
+    private long _scheduledTicks;
+
+    /// <summary>
+    /// Initializes a new timeline.
+    /// </summary>
+    /// <param name="overrunPolicy">What to do when playback falls behind.</param>
+    /// <param name="maxCatchUpLateness">Lateness beyond which <see cref="DeadlineOverrunPolicy.Resync"/> re-bases.</param>
+    /// <param name="onActionLateness">Receives the lateness of each action.</param>
+    /// <param name="onResync">Invoked whenever the timeline is re-based.</param>
+    /// <param name="timeProvider">Clock the timeline runs on; the system clock when null.</param>
+    public PlaybackTimeline(
+        DeadlineOverrunPolicy overrunPolicy,
+        TimeSpan maxCatchUpLateness,
+        Action<TimeSpan>? onActionLateness = null,
+        Action? onResync = null,
+        TimeProvider? timeProvider = null)
+    {
+        if (maxCatchUpLateness < TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(maxCatchUpLateness), "Lateness limit cannot be negative.");
+
+        _timeProvider = timeProvider ?? TimeProvider.System;
+        _overrunPolicy = overrunPolicy;
+        _maxCatchUpTicks = ToTimestampTicks(maxCatchUpLateness);
+        _onActionLateness = onActionLateness;
+        _onResync = onResync;
+        Start();
+    }
+
+    /// <summary>
+    /// Gets the scheduled offset of the next action from the timeline origin.
+    /// </summary>
+    public TimeSpan ScheduledOffset => _timeProvider.GetElapsedTime(0, _scheduledTicks);
+
+    /// <summary>
+    /// Resets the origin to now.
+    /// </summary>
+    public void Start()
+    {
+        _originTimestamp = _timeProvider.GetTimestamp();
+        _scheduledTicks = 0;
+    }
+
+    /// <summary>
+    /// Advances the timeline by a script delay and returns how long to wait to hit the new deadline.
+    /// </summary>
+    /// <param name="delay">The delay written in the script.</param>
+    /// <returns>The remaining wait, or zero when playback is already behind.</returns>
+    public TimeSpan Advance(TimeSpan delay)
+    {
+        if (delay > TimeSpan.Zero)
+            _scheduledTicks += ToTimestampTicks(delay);
+
+        var remaining = _originTimestamp + _scheduledTicks - _timeProvider.GetTimestamp();
+        if (remaining >= 0)
+            return _timeProvider.GetElapsedTime(0, remaining);
+
+        if (_overrunPolicy == DeadlineOverrunPolicy.Resync && -remaining > _maxCatchUpTicks)
+        {
+            // Too far behind: forget the backlog and keep the remaining gaps intact from here.
+            _originTimestamp -= remaining;
+            _onResync?.Invoke();
+        }
+
+        return TimeSpan.Zero;
+    }
+
+    /// <summary>
+    /// Reports the lateness of an action that is about to run.
+    /// </summary>
+    /// <returns>How far behind its scheduled time the action is (zero when on time).</returns>
+    public TimeSpan MarkAction()
+    {
+        var late = _timeProvider.GetTimestamp() - (_originTimestamp + _scheduledTicks);
+        var lateness = late > 0 ? _timeProvider.GetElapsedTime(0, late) : TimeSpan.Zero;
+        _onActionLateness?.Invoke(lateness);
+        return lateness;
+    }
+
+    private long ToTimestampTicks(TimeSpan value) => (long)(value.TotalSeconds * _timeProvider.TimestampFrequency);
+}
@@ -29,6 +29,14 @@ public class RecordingService : IRecordingService
     private HotkeyDefinition? _ignoreStart;
     private HotkeyDefinition? _ignorePause;
     private HotkeyDefinition? _ignoreStop;
+
+    // Path simplification state (only used when RecordingOptions.SimplifyMousePath is set)
+    private readonly object _pathLock = new();
+    private readonly List<MousePathPoint> _simplifiedPoints = new();
+    private MousePathSimplifier? _pathSimplifier;
+    private Point _lastSimplifiedPosition;
+    private Point _relativeCursor;
+    private bool _simplifyingRelativeInput;
     
     /// <summary>
     /// Tracks keys that are currently pressed to filter out key repeat events.
@@ -170,6 +178,15 @@ public class RecordingService : IRecordingService
                 _pressedKeys.Clear();
             }
 
+            lock (_pathLock)
+            {
+                _pathSimplifier = recordingOptions.SimplifyMousePath && recordingOptions.RecordMouseMovements
+                    ? new MousePathSimplifier(recordingOptions.MinimumDelay, recordingOptions.MousePathTolerance)
+                    : null;
+                _simplifiedPoints.Clear();
+                _relativeCursor = Point.Zero;
+            }
+
             // Install hooks for mouse and keyboard events
             EnsureHookSubscriptions(inputHookService);
             await inputHookService.InstallHooksAsync(recordingOptions);
@@ -228,6 +245,9 @@ public class RecordingService : IRecordingService
                 }
             }
 
+            // Emit the tail of the last stroke now that no more samples can arrive
+            FlushMousePath(session);
+
             // Change state to stopped
             session.ChangeState(RecordingState.Stopped);
 
@@ -240,7 +260,7 @@ public class RecordingService : IRecordingService
             RaiseStateChanged(previousState, RecordingState.Stopped, session.Id, "Recording stopped");
 
             _logger.LogInformation("Recording session {SessionId} stopped. Recorded {CommandCount} commands.",
-                session.Id, session.Commands.Count);
+                session.Id, session.CommandCount);
 
             await Task.CompletedTask;
         }
@@ -335,6 +355,8 @@ public class RecordingService : IRecordingService
             if (MatchesIgnore(_ignoreStart) || MatchesIgnore(_ignorePause) || MatchesIgnore(_ignoreStop))
                 return;
 
+            FlushMousePath(session);
+
             var now = DateTime.UtcNow;
             var delay = now - _lastEventTime;
 
@@ -387,6 +409,7 @@ public class RecordingService : IRecordingService
             _logger.LogDebug("Pausing recording session {SessionId}", session.Id);
 
             session.ChangeState(RecordingState.Paused);
+            FlushMousePath(session);
 
             // Raise state changed event
             RaiseStateChanged(previousState, RecordingState.Paused, session.Id, "Recording paused");
@@ -585,6 +608,24 @@ public class RecordingService : IRecordingService
         try
         {
             var now = DateTime.UtcNow;
+
+            lock (_pathLock)
+            {
+                if (_pathSimplifier != null)
+                {
+                    if (!_pathSimplifier.HasAnchor && (session.Options.UseRelativeMouseMove || !_isFirstEventInSegment))
+                    {
+                        _pathSimplifier.SetAnchor(_lastMousePosition, _lastEventTime);
+                        _lastSimplifiedPosition = _lastMousePosition;
+                    }
+
+                    _simplifyingRelativeInput = false;
+                    _pathSimplifier.Add(position, now, _simplifiedPoints);
+                    EmitSimplifiedMoves(session);
+                    return;
+                }
+            }
+
             var delay = now - _lastEventTime;
 
             // Apply minimum delay filter
@@ -666,6 +707,26 @@ public class RecordingService : IRecordingService
         try
         {
             var now = DateTime.UtcNow;
+
+            lock (_pathLock)
+            {
+                if (_pathSimplifier != null)
+                {
+                    // Simplify in accumulated-delta space so the emitted deltas always sum to the raw ones
+                    if (!_pathSimplifier.HasAnchor)
+                    {
+                        _pathSimplifier.SetAnchor(_relativeCursor, _lastEventTime);
+                        _lastSimplifiedPosition = _relativeCursor;
+                    }
+
+                    _relativeCursor = new Point(_relativeCursor.X + deltaX, _relativeCursor.Y + deltaY);
+                    _simplifyingRelativeInput = true;
+                    _pathSimplifier.Add(_relativeCursor, now, _simplifiedPoints);
+                    EmitSimplifiedMoves(session);
+                    return;
+                }
+            }
+
             var delay = now - _lastEventTime;
 
             // Apply minimum delay filter
@@ -738,6 +799,8 @@ public class RecordingService : IRecordingService
 
         try
         {
+            FlushMousePath(session);
+
             var now = DateTime.UtcNow;
             var delay = now - _lastEventTime;
 
@@ -800,6 +863,8 @@ public class RecordingService : IRecordingService
 
         try
         {
+            FlushMousePath(session);
+
             var now = DateTime.UtcNow;
             var delay = now - _lastEventTime;
 
@@ -851,6 +916,64 @@ public class RecordingService : IRecordingService
         }
     }
 
+    /// <summary>
+    /// Emits the pending simplified stroke and clears the anchor so the next move re-anchors
+    /// after whatever non-move event follows.
+    /// </summary>
+    private void FlushMousePath(RecordingSession session)
+    {
+        lock (_pathLock)
+        {
+            if (_pathSimplifier == null)
+                return;
+
+            _pathSimplifier.Flush(_simplifiedPoints);
+            EmitSimplifiedMoves(session);
+            _pathSimplifier.Reset();
+        }
+    }
+
+    /// <summary>
+    /// Converts points released by the simplifier into move commands. Caller holds _pathLock.
+    /// </summary>
+    private void EmitSimplifiedMoves(RecordingSession session)
+    {
+        if (_simplifiedPoints.Count == 0)
+            return;
+
+        var relative = _simplifyingRelativeInput || session.Options.UseRelativeMouseMove;
+
+        foreach (var point in _simplifiedPoints)
+        {
+            var delay = _isFirstEventInSegment ? TimeSpan.Zero : point.Timestamp - _lastEventTime;
+            if (delay < TimeSpan.Zero)
+                delay = TimeSpan.Zero;
+            if (delay > session.Options.MaximumDelay)
+                delay = session.Options.MaximumDelay;
+
+            Command command = relative
+                ? new MouseMoveRelativeCommand(point.Position.X - _lastSimplifiedPosition.X, point.Position.Y - _lastSimplifiedPosition.Y)
+                : new MouseMoveCommand(point.Position);
+            command.Delay = delay;
+
+            _lastSimplifiedPosition = point.Position;
+            _lastEventTime = point.Timestamp;
+            _isFirstEventInSegment = false;
+            // Hardware deltas are simplified in their own accumulated space, not screen coordinates
+            if (!_simplifyingRelativeInput)
+                _lastMousePosition = point.Position;
+
+            // Zero-length moves can appear when a stroke returns to its anchor
+            if (command is MouseMoveRelativeCommand { DeltaX: 0, DeltaY: 0 })
+                continue;
+
+            session.AddCommand(command);
+            RaiseCommandRecorded(command, session.Id);
+        }
+
+        _simplifiedPoints.Clear();
+    }
+
     /// <summary>
     /// Raises the CommandRecorded event.
     /// </summary>
@@ -11,6 +11,8 @@ public sealed class SafetyService : ISafetyService
     private readonly ILogger<SafetyService> _logger;
     private readonly object _lockObject = new();
     private bool _isKillSwitchActive;
+    // Completed when the kill switch activates, so authorization waits end at once
+    private TaskCompletionSource _killSwitchSignal = new(TaskCreationOptions.RunContinuationsAsynchronously);
 
     private readonly List<AuthorizedOperation> _authorizedOperations = new();
 
@@ -33,24 +35,37 @@ public sealed class SafetyService : ISafetyService
         if (string.IsNullOrWhiteSpace(reason))
             reason = "Kill switch activated";
 
-        if (IsKillSwitchActive)
-            return Task.CompletedTask;
+        TaskCompletionSource signal;
+        lock (_lockObject)
+        {
+            if (_isKillSwitchActive)
+                return Task.CompletedTask;
 
-        IsKillSwitchActive = true;
-        _logger.LogWarning("Kill switch activated: {Reason}", reason);
+            _isKillSwitchActive = true;
+            signal = _killSwitchSignal;
+        }
+
+        // Subscribers stop executions; nothing slow may run before them
+        signal.TrySetResult();
 
         try { KillSwitchActivated?.Invoke(this, new KillSwitchActivatedEventArgs(reason)); }
         catch { }
 
+        _logger.LogWarning("Kill switch activated: {Reason}", reason);
         return Task.CompletedTask;
     }
 
     public Task DeactivateKillSwitchAsync()
     {
-        if (!IsKillSwitchActive)
-            return Task.CompletedTask;
+        lock (_lockObject)
+        {
+            if (!_isKillSwitchActive)
+                return Task.CompletedTask;
+
+            _isKillSwitchActive = false;
+            _killSwitchSignal = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        }
 
-        IsKillSwitchActive = false;
         _logger.LogInformation("Kill switch deactivated");
         return Task.CompletedTask;
     }
@@ -88,13 +103,27 @@ public sealed class SafetyService : ISafetyService
             return AuthorizationResult.Authorized("Previously authorized", rememberDecision: true);
         }
 
+        Task killSwitch;
+        lock (_lockObject)
+        {
+            if (_isKillSwitchActive)
+                return AuthorizationResult.Denied("Kill switch is active");
+
+            killSwitch = _killSwitchSignal.Task;
+        }
+
         var args = new AuthorizationRequiredEventArgs(operation, context);
 
         try { AuthorizationRequired?.Invoke(this, args); }
         catch { }
 
         // If no UI handler is attached, default to deny for safety.
-        var completed = await Task.WhenAny(args.ResultCallback.Task, Task.Delay(TimeSpan.FromSeconds(2)));
+        var completed = await Task.WhenAny(args.ResultCallback.Task, killSwitch, Task.Delay(TimeSpan.FromSeconds(2)));
+        if (completed == killSwitch)
+        {
+            return AuthorizationResult.Denied("Kill switch is active");
+        }
+
         if (completed != args.ResultCallback.Task)
         {
             return AuthorizationResult.Denied("No authorization handler available");
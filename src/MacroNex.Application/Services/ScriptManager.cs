@@ -8,32 +8,63 @@ namespace MacroNex.Application.Services;
 /// <summary>
 /// Application service for managing automation scripts.
 /// Handles CRUD operations, validation, and persistence.
+/// The library is tracked through lightweight metadata; script bodies are loaded on demand
+/// and kept in a small least-recently-used cache.
 /// </summary>
 public class ScriptManager : IScriptManager
 {
+    /// <summary>
+    /// Default number of script bodies kept in memory.
+    /// </summary>
+    public const int DefaultMaxCachedScripts = 16;
+
     private readonly IFileStorageService _storageService;
     private readonly IScriptHotkeyHookService _scriptHotkeyHookService;
     private readonly ILogger<ScriptManager> _logger;
-    private readonly Dictionary<Guid, Script> _scriptCache;
+    private readonly int _maxCachedScripts;
+    private readonly Dictionary<Guid, CachedScript> _scriptCache;
     private readonly Dictionary<Guid, HotkeyDefinition> _registeredHotkeys = new();
     private readonly object _cacheLock = new();
 
+    // Library metadata in storage order; null until first loaded
+    private List<ScriptMetadata>? _metadata;
+    private long _cacheUseCounter;
+
     /// <summary>
     /// Initializes a new instance of the ScriptManager class.
     /// </summary>
     /// <param name="storageService">File storage service for persistence.</param>
     /// <param name="scriptHotkeyHookService">Hook-based hotkey service for script trigger hotkeys.</param>
     /// <param name="logger">Logger for diagnostic information.</param>
-    public ScriptManager(IFileStorageService storageService, IScriptHotkeyHookService scriptHotkeyHookService, ILogger<ScriptManager> logger)
+    /// <param name="maxCachedScripts">Number of script bodies kept in memory.</param>
+    public ScriptManager(IFileStorageService storageService, IScriptHotkeyHookService scriptHotkeyHookService, ILogger<ScriptManager> logger, int maxCachedScripts = DefaultMaxCachedScripts)
     {
         _storageService = storageService ?? throw new ArgumentNullException(nameof(storageService));
         _scriptHotkeyHookService = scriptHotkeyHookService ?? throw new ArgumentNullException(nameof(scriptHotkeyHookService));
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
-        _scriptCache = new Dictionary<Guid, Script>();
+        if (maxCachedScripts < 1)
+            throw new ArgumentOutOfRangeException(nameof(maxCachedScripts), "At least one script must be cacheable.");
+
+        _maxCachedScripts = maxCachedScripts;
+        _scriptCache = new Dictionary<Guid, CachedScript>();
 
         _logger.LogDebug("ScriptManager initialized");
     }
 
+    /// <summary>
+    /// Gets the number of script bodies currently held in memory.
+    /// </summary>
+    public int CachedScriptCount
+    {
+        get
+        {
+            lock (_cacheLock)
+            {
+                return _scriptCache.Count;
+            }
+        }
+    }
+
     /// <inheritdoc />
     public async Task<IEnumerable<Script>> GetAllScriptsAsync()
     {
@@ -47,10 +78,11 @@ public class ScriptManager : IScriptManager
             // Update cache
             lock (_cacheLock)
             {
+                _metadata = scriptList.Select(s => s.ToMetadata()).ToList();
                 _scriptCache.Clear();
                 foreach (var script in scriptList)
                 {
-                    _scriptCache[script.Id] = script;
+                    CacheScript(script);
                 }
             }
 
@@ -64,6 +96,37 @@ public class ScriptManager : IScriptManager
         }
     }
 
+    /// <inheritdoc />
+    public async Task<IEnumerable<ScriptMetadata>> GetScriptMetadataAsync()
+    {
+        try
+        {
+            _logger.LogDebug("Loading script metadata from storage");
+
+            var metadata = (await _storageService.LoadScriptMetadataAsync()).ToList();
+
+            lock (_cacheLock)
+            {
+                _metadata = metadata;
+
+                // Drop bodies of scripts that no longer exist
+                var ids = metadata.Select(m => m.Id).ToHashSet();
+                foreach (var id in _scriptCache.Keys.Where(id => !ids.Contains(id)).ToList())
+                {
+                    _scriptCache.Remove(id);
+                }
+            }
+
+            _logger.LogInformation("Loaded metadata for {Count} scripts", metadata.Count);
+            return metadata.ToList();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Error loading script metadata");
+            throw;
+        }
+    }
+
     /// <inheritdoc />
     public async Task<Script?> GetScriptAsync(Guid id)
     {
@@ -74,19 +137,30 @@ public class ScriptManager : IScriptManager
             // Check cache first
             lock (_cacheLock)
             {
-                if (_scriptCache.TryGetValue(id, out var cachedScript))
+                if (_scriptCache.TryGetValue(id, out var cached))
                 {
+                    cached.LastUsed = ++_cacheUseCounter;
                     _logger.LogDebug("Script {ScriptId} found in cache", id);
-                    return cachedScript;
+                    return cached.Script;
                 }
             }
 
-            // Load from storage if not in cache
-            var allScripts = await GetAllScriptsAsync();
-            var script = allScripts.FirstOrDefault(s => s.Id == id);
+            // Load just this script from storage if not in cache
+            var script = await _storageService.LoadScriptAsync(id);
 
             if (script != null)
             {
+                lock (_cacheLock)
+                {
+                    // A concurrent load may have won; keep a single instance per script
+                    if (_scriptCache.TryGetValue(id, out var cached))
+                    {
+                        cached.LastUsed = ++_cacheUseCounter;
+                        return cached.Script;
+                    }
+
+                    CacheScript(script);
+                }
                 _logger.LogDebug("Script {ScriptId} found in storage", id);
             }
             else
@@ -129,7 +203,8 @@ public class ScriptManager : IScriptManager
             // Update cache
             lock (_cacheLock)
             {
-                _scriptCache[script.Id] = script;
+                CacheScript(script);
+                UpsertMetadata(script);
             }
 
             _logger.LogInformation("Created new script {ScriptId} with name: {ScriptName}", script.Id, name);
@@ -152,9 +227,9 @@ public class ScriptManager : IScriptManager
         {
             _logger.LogDebug("Updating script {ScriptId}", script.Id);
 
-            // Verify script exists
-            var existingScript = await GetScriptAsync(script.Id);
-            if (existingScript == null)
+            // Verify script exists (metadata only; the body is about to be replaced anyway)
+            var exists = (await GetMetadataSnapshotAsync()).Any(m => m.Id == script.Id);
+            if (!exists)
             {
                 throw new InvalidOperationException($"Script with ID {script.Id} does not exist.");
             }
@@ -200,7 +275,8 @@ public class ScriptManager : IScriptManager
             // Update cache
             lock (_cacheLock)
             {
-                _scriptCache[script.Id] = script;
+                CacheScript(script);
+                UpsertMetadata(script);
             }
 
             // Update mapping with new hotkey if specified
@@ -232,7 +308,8 @@ public class ScriptManager : IScriptManager
     {
         try
         {
-            var scripts = await GetAllScriptsAsync();
+            // Hotkeys are part of the metadata, so no script body has to be loaded
+            var scripts = await GetMetadataSnapshotAsync();
             var hotkeys = new Dictionary<Guid, HotkeyDefinition>();
             foreach (var script in scripts)
             {
@@ -277,6 +354,7 @@ public class ScriptManager : IScriptManager
                 lock (_cacheLock)
                 {
                     _scriptCache.Remove(id);
+                    _metadata?.RemoveAll(m => m.Id == id);
                     _registeredHotkeys.Remove(id);
                 }
                 ApplyHotkeyMappingsToHook();
@@ -342,7 +420,8 @@ public class ScriptManager : IScriptManager
             // Update cache
             lock (_cacheLock)
             {
-                _scriptCache[duplicatedScript.Id] = duplicatedScript;
+                CacheScript(duplicatedScript);
+                UpsertMetadata(duplicatedScript);
             }
 
             _logger.LogInformation("Duplicated script {SourceId} to {NewId} with name: {NewName}",
@@ -403,7 +482,7 @@ public class ScriptManager : IScriptManager
 
         try
         {
-            var allScripts = await GetAllScriptsAsync();
+            var allScripts = await GetMetadataSnapshotAsync();
             var trimmedName = name.Trim();
 
             return !allScripts.Any(s =>
@@ -458,8 +537,8 @@ public class ScriptManager : IScriptManager
     {
         try
         {
-            var allScripts = await GetAllScriptsAsync();
-            return allScripts.Count();
+            var allScripts = await GetMetadataSnapshotAsync();
+            return allScripts.Count;
         }
         catch (Exception ex)
         {
@@ -478,12 +557,17 @@ public class ScriptManager : IScriptManager
         {
             _logger.LogDebug("Searching scripts with term: {SearchTerm}", searchTerm);
 
-            var allScripts = await GetAllScriptsAsync();
+            var allScripts = await GetMetadataSnapshotAsync();
             var trimmedTerm = searchTerm.Trim();
 
-            var matchingScripts = allScripts
-                .Where(s => s.Name.Contains(trimmedTerm, StringComparison.OrdinalIgnoreCase))
-                .ToList();
+            // Match on metadata, then load only the matching bodies
+            var matchingScripts = new List<Script>();
+            foreach (var metadata in allScripts.Where(s => s.Name.Contains(trimmedTerm, StringComparison.OrdinalIgnoreCase)))
+            {
+                var script = await GetScriptAsync(metadata.Id);
+                if (script != null)
+                    matchingScripts.Add(script);
+            }
 
             _logger.LogDebug("Found {Count} scripts matching search term: {SearchTerm}", matchingScripts.Count, searchTerm);
 
@@ -520,7 +604,8 @@ public class ScriptManager : IScriptManager
 
         lock (_cacheLock)
         {
-            _scriptCache[imported.Id] = imported;
+            CacheScript(imported);
+            UpsertMetadata(imported);
         }
 
         return imported;
@@ -538,4 +623,85 @@ public class ScriptManager : IScriptManager
         _logger.LogInformation("Exporting script {ScriptId} to {FilePath}", id, filePath);
         await _storageService.ExportScriptAsync(script, filePath);
     }
+
+    /// <summary>
+    /// Gets the cached library metadata, loading it from storage on first use.
+    /// </summary>
+    private async Task<IReadOnlyList<ScriptMetadata>> GetMetadataSnapshotAsync()
+    {
+        lock (_cacheLock)
+        {
+            if (_metadata != null)
+                return _metadata.ToList();
+        }
+
+        var loaded = (await _storageService.LoadScriptMetadataAsync()).ToList();
+
+        lock (_cacheLock)
+        {
+            _metadata ??= loaded;
+            return _metadata.ToList();
+        }
+    }
+
+    /// <summary>
+    /// Adds or refreshes a script body in the cache, evicting the least recently used one when full.
+    /// Caller holds _cacheLock.
+    /// </summary>
+    private void CacheScript(Script script)
+    {
+        if (_scriptCache.TryGetValue(script.Id, out var existing))
+        {
+            existing.Script = script;
+            existing.LastUsed = ++_cacheUseCounter;
+            return;
+        }
+
+        while (_scriptCache.Count >= _maxCachedScripts)
+        {
+            CachedScript? oldest = null;
+            foreach (var entry in _scriptCache.Values)
+            {
+                if (oldest == null || entry.LastUsed < oldest.LastUsed)
+                    oldest = entry;
+            }
+
+            _scriptCache.Remove(oldest!.Script.Id);
+        }
+
+        _scriptCache[script.Id] = new CachedScript(script, ++_cacheUseCounter);
+    }
+
+    /// <summary>
+    /// Replaces or appends a script's metadata. Caller holds _cacheLock.
+    /// </summary>
+    private void UpsertMetadata(Script script)
+    {
+        if (_metadata == null)
+            return;
+
+        var metadata = script.ToMetadata();
+        var index = _metadata.FindIndex(m => m.Id == script.Id);
+        if (index >= 0)
+        {
+            _metadata[index] = metadata;
+        }
+        else
+        {
+            _metadata.Add(metadata);
+        }
+    }
+
+    private sealed class CachedScript
+    {
+        public CachedScript(Script script, long lastUsed)
+        {
+            Script = script;
+            LastUsed = lastUsed;
+        }
+
+        public Script Script { get; set; }
+
+        public long LastUsed { get; set; }
+    }
 }
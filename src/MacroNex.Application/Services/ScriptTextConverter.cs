@@ -1,4 +1,6 @@
+using System.Collections.Concurrent;
 using System.Globalization;
+using System.Runtime.CompilerServices;
 using System.Text;
 using MacroNex.Domain.Entities;
 using MacroNex.Domain.ValueObjects;
@@ -6,107 +8,142 @@ using MacroNex.Domain.ValueObjects;
 namespace MacroNex.Application.Services;
 
 /// <summary>
-/// Converts recorded commands to Lua SourceText.
+/// Converts recorded commands to Lua SourceText and parses SourceText back into commands.
+/// Both directions work in a single pass over spans, and have streaming overloads over
+/// <see cref="TextWriter"/> and <see cref="TextReader"/> for recordings too large to hold as one string.
 /// </summary>
 public static class ScriptTextConverter
 {
+    /// <summary>
+    /// Maximum number of (dx, dy, dt) samples written on a single move_stream line.
+    /// </summary>
+    public const int MaxSamplesPerMotionStream = 32;
+
+    /// <summary>
+    /// Number of buffered characters after which <see cref="WriteCommandsAsync"/> hands text to the writer.
+    /// </summary>
+    private const int AsyncWriteThreshold = 16 * 1024;
+
+    private const string EscapedSingleQuote = "\\'";
+
+    private static readonly ConcurrentDictionary<VirtualKey, string> KeyCharNames = new();
+
     /// <summary>
     /// Converts a list of commands to Lua SourceText.
     /// </summary>
-    public static string CommandsToText(IEnumerable<Command> commands)
+    /// <param name="commands">The commands to convert.</param>
+    /// <param name="packRelativeMoves">
+    /// When true, runs of consecutive relative moves are written as move_stream(...) lines
+    /// so hardware playback can replay them on the device clock.
+    /// </param>
+    public static string CommandsToText(IEnumerable<Command> commands, bool packRelativeMoves = false)
     {
         if (commands == null) throw new ArgumentNullException(nameof(commands));
 
-        var sb = new StringBuilder();
+        using var writer = new StringWriter(CultureInfo.InvariantCulture);
+        WriteCommands(writer, commands, packRelativeMoves);
+        return writer.ToString();
+    }
+
+    /// <summary>
+    /// Writes commands as Lua SourceText in a single pass. Memory use does not grow with the
+    /// number of commands, so very large recordings can go straight to a file.
+    /// </summary>
+    /// <param name="writer">The destination for the text.</param>
+    /// <param name="commands">The commands to convert.</param>
+    /// <param name="packRelativeMoves">See <see cref="CommandsToText(IEnumerable{Command}, bool)"/>.</param>
+    public static void WriteCommands(TextWriter writer, IEnumerable<Command> commands, bool packRelativeMoves = false)
+    {
+        if (writer == null) throw new ArgumentNullException(nameof(writer));
+        if (commands == null) throw new ArgumentNullException(nameof(commands));
 
+        var emitter = new CommandTextEmitter(writer, packRelativeMoves);
         foreach (var command in commands)
         {
-            // Preserve timing: Command.Delay is the time gap since the previous command.
-            // In Lua/text form we represent that gap explicitly via msleep(...) so
-            // recorded scripts keep realistic pacing when executed by LuaScriptRunner.
-            AppendDelayIfAny(sb, command.Delay);
-
-            AppendCommand(sb, command);
+            emitter.Write(command);
         }
 
-        return sb.ToString();
+        emitter.Complete();
     }
 
     /// <summary>
-    /// Converts the commands in a script to a textual representation.
+    /// Converts a compact command buffer to Lua SourceText without creating command objects.
     /// </summary>
-    public static string ToText(Script script)
+    /// <param name="commands">The commands to convert.</param>
+    /// <param name="packRelativeMoves">See <see cref="CommandsToText(IEnumerable{Command}, bool)"/>.</param>
+    public static string CommandsToText(CommandBuffer commands, bool packRelativeMoves = false)
     {
-        if (script == null) throw new ArgumentNullException(nameof(script));
-        return CommandsToText(script.Commands);
+        if (commands == null) throw new ArgumentNullException(nameof(commands));
+
+        using var writer = new StringWriter(CultureInfo.InvariantCulture);
+        WriteCommands(writer, commands, packRelativeMoves);
+        return writer.ToString();
     }
 
-    private static void AppendCommand(StringBuilder sb, Command command)
+    /// <summary>
+    /// Writes a compact command buffer as Lua SourceText, reading the rows in place.
+    /// </summary>
+    /// <param name="writer">The destination for the text.</param>
+    /// <param name="commands">The commands to convert.</param>
+    /// <param name="packRelativeMoves">See <see cref="CommandsToText(IEnumerable{Command}, bool)"/>.</param>
+    public static void WriteCommands(TextWriter writer, CommandBuffer commands, bool packRelativeMoves = false)
     {
-        switch (command)
-        {
-            // All move commands use unified functions - actual behavior depends on InputMode setting
-            case MouseMoveCommand move:
-                sb.AppendLine($"move({move.Position.X}, {move.Position.Y})");
-                break;
-
-            case MouseMoveRelativeCommand moveRel:
-                sb.AppendLine($"move_rel({moveRel.DeltaX}, {moveRel.DeltaY})");
-                break;
+        if (writer == null) throw new ArgumentNullException(nameof(writer));
+        if (commands == null) throw new ArgumentNullException(nameof(commands));
 
-            case MouseClickCommand click:
-                var buttonName = ToButtonName(click.Button);
-                var fn = click.Type switch
-                {
-                    ClickType.Down => "mouse_down",
-                    ClickType.Up => "mouse_release",
-                    ClickType.Click => "mouse_click",
-                    _ => "mouse_click"
-                };
-                sb.AppendLine($"{fn}('{buttonName}')");
-                break;
+        var emitter = new CommandTextEmitter(writer, packRelativeMoves);
+        foreach (var record in commands)
+        {
+            emitter.Write(record);
+        }
 
-            case SleepCommand sleep:
-                AppendMsleepIfAny(sb, sleep.Duration);
-                break;
+        emitter.Complete();
+    }
 
-            case KeyboardCommand keyboard when !string.IsNullOrEmpty(keyboard.Text):
-                sb.AppendLine($"type_text('{EscapeSingleQuotes(keyboard.Text)}')");
-                break;
+    /// <summary>
+    /// Writes commands as Lua SourceText as they arrive. Text is staged in a bounded buffer and
+    /// handed to <paramref name="writer"/> asynchronously, so a slow destination never blocks the producer thread.
+    /// </summary>
+    /// <param name="writer">The destination for the text.</param>
+    /// <param name="commands">The commands to convert.</param>
+    /// <param name="packRelativeMoves">See <see cref="CommandsToText(IEnumerable{Command}, bool)"/>.</param>
+    /// <param name="cancellationToken">Token to stop the conversion.</param>
+    public static async Task WriteCommandsAsync(
+        TextWriter writer,
+        IAsyncEnumerable<Command> commands,
+        bool packRelativeMoves = false,
+        CancellationToken cancellationToken = default)
+    {
+        if (writer == null) throw new ArgumentNullException(nameof(writer));
+        if (commands == null) throw new ArgumentNullException(nameof(commands));
 
-            case KeyPressCommand kp:
-                var keyName = ToKeyCharName(kp.Key);
-                sb.AppendLine($"{(kp.IsDown ? "key_down" : "key_release")}('{keyName}')");
-                break;
+        var staged = new StringBuilder();
+        using var staging = new StringWriter(staged, CultureInfo.InvariantCulture) { NewLine = writer.NewLine };
+        var emitter = new CommandTextEmitter(staging, packRelativeMoves);
 
-            case KeyboardCommand keyboard:
-                var keyList = string.Join("+", keyboard.Keys.Select(k => k.ToString()));
-                sb.AppendLine($"# keys: {keyList}");
-                break;
+        await foreach (var command in commands.WithCancellation(cancellationToken).ConfigureAwait(false))
+        {
+            emitter.Write(command);
 
-            default:
-                sb.AppendLine($"# Unsupported command type: {command.DisplayName}");
-                break;
+            if (staged.Length >= AsyncWriteThreshold)
+            {
+                await writer.WriteAsync(staged, cancellationToken).ConfigureAwait(false);
+                staged.Clear();
+            }
         }
-    }
 
-    private static void AppendDelayIfAny(StringBuilder sb, TimeSpan delay)
-    {
-        AppendMsleepIfAny(sb, delay);
+        emitter.Complete();
+        if (staged.Length > 0)
+            await writer.WriteAsync(staged, cancellationToken).ConfigureAwait(false);
     }
 
-    private static void AppendMsleepIfAny(StringBuilder sb, TimeSpan duration)
+    /// <summary>
+    /// Converts the commands in a script to a textual representation.
+    /// </summary>
+    public static string ToText(Script script)
     {
-        if (duration <= TimeSpan.Zero)
-            return;
-
-        // As requested: always emit msleep with integer milliseconds.
-        // Round to nearest millisecond to avoid systematic bias.
-        var ms = (long)Math.Round(duration.TotalMilliseconds, MidpointRounding.AwayFromZero);
-        if (ms <= 0)
-            return;
-
-        sb.AppendLine($"msleep({ms.ToString(CultureInfo.InvariantCulture)})");
+        if (script == null) throw new ArgumentNullException(nameof(script));
+        return script.CommandBuffer is { } buffer ? CommandsToText(buffer) : CommandsToText(script.Commands);
     }
 
     /// <summary>
@@ -119,105 +156,206 @@ public static class ScriptTextConverter
         if (string.IsNullOrWhiteSpace(scriptText))
             return commands;
 
-        var lines = scriptText.Split(new[] { "\r\n", "\n" }, StringSplitOptions.None);
+        // Walk the text in place; lines and arguments are spans, never substrings
+        var remaining = scriptText.AsSpan();
+        var lineNumber = 0;
+        while (true)
+        {
+            lineNumber++;
+            var newline = remaining.IndexOf('\n');
+            if (newline < 0)
+            {
+                ParseLine(remaining, lineNumber, commands);
+                break;
+            }
+
+            ParseLine(remaining[..newline], lineNumber, commands);
+            remaining = remaining[(newline + 1)..];
+        }
+
+        return commands;
+    }
+
+    /// <summary>
+    /// Parses text from a reader, yielding commands line by line as they are read.
+    /// Throws <see cref="FormatException"/> on invalid syntax when the offending line is reached.
+    /// </summary>
+    /// <param name="reader">The source of the text.</param>
+    public static IEnumerable<Command> ReadCommands(TextReader reader)
+    {
+        if (reader == null) throw new ArgumentNullException(nameof(reader));
+        return ReadCommandsIterator(reader);
+    }
+
+    /// <summary>
+    /// Parses text from a reader asynchronously, yielding commands line by line as they are read.
+    /// Throws <see cref="FormatException"/> on invalid syntax when the offending line is reached.
+    /// </summary>
+    /// <param name="reader">The source of the text.</param>
+    /// <param name="cancellationToken">Token to stop reading.</param>
+    public static IAsyncEnumerable<Command> ReadCommandsAsync(TextReader reader, CancellationToken cancellationToken = default)
+    {
+        if (reader == null) throw new ArgumentNullException(nameof(reader));
+        return ReadCommandsAsyncIterator(reader, cancellationToken);
+    }
+
+    private static IEnumerable<Command> ReadCommandsIterator(TextReader reader)
+    {
+        var lines = new LineReader(reader);
+        var parsed = new List<Command>();
+        var lineNumber = 0;
 
-        for (var i = 0; i < lines.Length; i++)
+        while (lines.TryReadLine())
         {
-            var rawLine = lines[i];
-            var lineNumber = i + 1;
+            ParseCurrentLine(lines, ++lineNumber, parsed);
+            foreach (var command in parsed)
+            {
+                yield return command;
+            }
+
+            parsed.Clear();
+        }
+    }
 
-            // Strip comments
-            var codePart = rawLine.Split('#', 2)[0].Trim();
-            if (string.IsNullOrWhiteSpace(codePart))
-                continue;
+    private static async IAsyncEnumerable<Command> ReadCommandsAsyncIterator(
+        TextReader reader,
+        [EnumeratorCancellation] CancellationToken cancellationToken)
+    {
+        var lines = new LineReader(reader);
+        var parsed = new List<Command>();
+        var lineNumber = 0;
 
-            try
+        while (await lines.TryReadLineAsync(cancellationToken).ConfigureAwait(false))
+        {
+            ParseCurrentLine(lines, ++lineNumber, parsed);
+            foreach (var command in parsed)
             {
-                if (codePart.StartsWith("mouse_down", StringComparison.OrdinalIgnoreCase))
-                {
-                    var button = ParseMouseButtonSingleArg(codePart, "mouse_down");
-                    commands.Add(new MouseClickCommand(button, ClickType.Down));
-                }
-                else if (codePart.StartsWith("mouse_release", StringComparison.OrdinalIgnoreCase))
-                {
-                    var button = ParseMouseButtonSingleArg(codePart, "mouse_release");
-                    commands.Add(new MouseClickCommand(button, ClickType.Up));
-                }
-                else if (codePart.StartsWith("mouse_click", StringComparison.OrdinalIgnoreCase))
-                {
-                    var button = ParseMouseButtonSingleArg(codePart, "mouse_click");
-                    commands.Add(new MouseClickCommand(button, ClickType.Click));
-                }
-                else if (codePart.StartsWith("sleep", StringComparison.OrdinalIgnoreCase))
-                {
-                    var seconds = ParseSingleDoubleArg(codePart, "sleep");
-                    commands.Add(new SleepCommand(TimeSpan.FromSeconds(seconds)));
-                }
-                else if (codePart.StartsWith("msleep", StringComparison.OrdinalIgnoreCase))
-                {
-                    var ms = ParseSingleDoubleArg(codePart, "msleep");
-                    commands.Add(new SleepCommand(TimeSpan.FromMilliseconds(ms)));
-                }
-                else if (codePart.StartsWith("move_rel", StringComparison.OrdinalIgnoreCase))
-                {
-                    var (dx, dy) = ParseTwoIntArgs(codePart, "move_rel");
-                    commands.Add(new MouseMoveRelativeCommand(dx, dy));
-                }
-                else if (codePart.StartsWith("move", StringComparison.OrdinalIgnoreCase))
-                {
-                    var (x, y) = ParseTwoIntArgs(codePart, "move");
-                    commands.Add(new MouseMoveCommand(new Point(x, y)));
-                }
-                else if (codePart.StartsWith("type_text", StringComparison.OrdinalIgnoreCase))
-                {
-                    var text = ParseSingleStringArg(codePart, "type_text");
-                    if (string.IsNullOrEmpty(text))
-                    {
-                        throw new FormatException("type_text cannot be empty. Provide text to type or remove the command.");
-                    }
-                    commands.Add(new KeyboardCommand(text));
-                }
-                else if (codePart.StartsWith("key_down", StringComparison.OrdinalIgnoreCase) ||
-                         codePart.StartsWith("key_release", StringComparison.OrdinalIgnoreCase))
-                {
-                    var isDown = codePart.StartsWith("key_down", StringComparison.OrdinalIgnoreCase);
-                    var keyChar = ParseSingleStringArg(codePart, isDown ? "key_down" : "key_release");
-                    var vk = ParseVirtualKeyFromChar(keyChar);
-                    commands.Add(new KeyPressCommand(vk, isDown));
-                }
-                else
+                yield return command;
+            }
+
+            parsed.Clear();
+        }
+    }
+
+    // Iterators cannot hold spans, so they parse through this helper
+    private static void ParseCurrentLine(LineReader lines, int lineNumber, List<Command> commands) =>
+        ParseLine(lines.CurrentLine, lineNumber, commands);
+
+    private static void ParseLine(ReadOnlySpan<char> rawLine, int lineNumber, List<Command> commands)
+    {
+        // Strip comments
+        var commentIdx = rawLine.IndexOf('#');
+        var codePart = (commentIdx < 0 ? rawLine : rawLine[..commentIdx]).Trim();
+        if (codePart.IsEmpty)
+            return;
+
+        try
+        {
+            if (codePart.StartsWith("mouse_down", StringComparison.OrdinalIgnoreCase))
+            {
+                var button = ParseMouseButtonSingleArg(codePart, "mouse_down");
+                commands.Add(new MouseClickCommand(button, ClickType.Down));
+            }
+            else if (codePart.StartsWith("mouse_release", StringComparison.OrdinalIgnoreCase))
+            {
+                var button = ParseMouseButtonSingleArg(codePart, "mouse_release");
+                commands.Add(new MouseClickCommand(button, ClickType.Up));
+            }
+            else if (codePart.StartsWith("mouse_click", StringComparison.OrdinalIgnoreCase))
+            {
+                var button = ParseMouseButtonSingleArg(codePart, "mouse_click");
+                commands.Add(new MouseClickCommand(button, ClickType.Click));
+            }
+            else if (codePart.StartsWith("sleep", StringComparison.OrdinalIgnoreCase))
+            {
+                var seconds = ParseSingleDoubleArg(codePart, "sleep");
+                commands.Add(new SleepCommand(TimeSpan.FromSeconds(seconds)));
+            }
+            else if (codePart.StartsWith("msleep", StringComparison.OrdinalIgnoreCase))
+            {
+                var ms = ParseSingleDoubleArg(codePart, "msleep");
+                commands.Add(new SleepCommand(TimeSpan.FromMilliseconds(ms)));
+            }
+            else if (codePart.StartsWith("move_stream", StringComparison.OrdinalIgnoreCase))
+            {
+                ParseMotionStream(codePart, commands);
+            }
+            else if (codePart.StartsWith("move_rel", StringComparison.OrdinalIgnoreCase))
+            {
+                var (dx, dy) = ParseTwoIntArgs(codePart, "move_rel");
+                commands.Add(new MouseMoveRelativeCommand(dx, dy));
+            }
+            else if (codePart.StartsWith("move", StringComparison.OrdinalIgnoreCase))
+            {
+                var (x, y) = ParseTwoIntArgs(codePart, "move");
+                commands.Add(new MouseMoveCommand(new Point(x, y)));
+            }
+            else if (codePart.StartsWith("type_text", StringComparison.OrdinalIgnoreCase))
+            {
+                var text = Unescape(ParseSingleStringArg(codePart, "type_text"));
+                if (string.IsNullOrEmpty(text))
                 {
-                    throw new FormatException($"Unknown command: {codePart}");
+                    throw new FormatException("type_text cannot be empty. Provide text to type or remove the command.");
                 }
+                commands.Add(new KeyboardCommand(text));
             }
-            catch (Exception ex) when (ex is FormatException || ex is ArgumentException)
+            else if (codePart.StartsWith("key_down", StringComparison.OrdinalIgnoreCase) ||
+                     codePart.StartsWith("key_release", StringComparison.OrdinalIgnoreCase))
             {
-                throw new FormatException($"Error on line {lineNumber}: {ex.Message}", ex);
+                var isDown = codePart.StartsWith("key_down", StringComparison.OrdinalIgnoreCase);
+                var keyChar = ParseSingleStringArg(codePart, isDown ? "key_down" : "key_release");
+                var vk = keyChar.Contains(EscapedSingleQuote, StringComparison.Ordinal)
+                    ? ParseVirtualKeyFromChar(Unescape(keyChar))
+                    : ParseVirtualKeyFromChar(keyChar);
+                commands.Add(new KeyPressCommand(vk, isDown));
             }
+            else
+            {
+                throw new FormatException($"Unknown command: {codePart}");
+            }
+        }
+        catch (Exception ex) when (ex is FormatException || ex is ArgumentException)
+        {
+            throw new FormatException($"Error on line {lineNumber}: {ex.Message}", ex);
         }
+    }
 
-        return commands;
+    private static void WriteEscapedSingleQuotes(TextWriter writer, string text)
+    {
+        var remaining = text.AsSpan();
+        int quoteIdx;
+        while ((quoteIdx = remaining.IndexOf('\'')) >= 0)
+        {
+            writer.Write(remaining[..quoteIdx]);
+            writer.Write(EscapedSingleQuote);
+            remaining = remaining[(quoteIdx + 1)..];
+        }
+
+        writer.Write(remaining);
     }
 
-    private static string EscapeSingleQuotes(string text) =>
-        text.Replace("'", "\\'");
+    private static string Unescape(ReadOnlySpan<char> content)
+    {
+        var text = content.ToString();
+        return content.Contains(EscapedSingleQuote, StringComparison.Ordinal) ? text.Replace(EscapedSingleQuote, "'") : text;
+    }
 
-    private static string ParseSingleStringArg(string code, string name)
+    /// <summary>
+    /// Returns the still-escaped content between the single quotes.
+    /// </summary>
+    private static ReadOnlySpan<char> ParseSingleStringArg(ReadOnlySpan<char> code, string name)
     {
-        var (inner, _) = ExtractInnerArgs(code, name);
-        inner = inner.Trim();
+        var inner = ExtractInnerArgs(code, name).Trim();
 
         if (inner.Length < 2 || inner[0] != '\'' || inner[^1] != '\'')
             throw new FormatException($"Expected '{name}('value')' with single quotes.");
 
-        var content = inner.Substring(1, inner.Length - 2);
-        return content.Replace("\\'", "'");
+        return inner[1..^1];
     }
 
-    private static double ParseSingleDoubleArg(string code, string name)
+    private static double ParseSingleDoubleArg(ReadOnlySpan<char> code, string name)
     {
-        var (inner, _) = ExtractInnerArgs(code, name);
-        inner = inner.Trim();
+        var inner = ExtractInnerArgs(code, name).Trim();
 
         if (!double.TryParse(inner, NumberStyles.Float, CultureInfo.InvariantCulture, out var value))
             throw new FormatException($"Invalid numeric value for {name}: {inner}");
@@ -228,18 +366,26 @@ public static class ScriptTextConverter
         return value;
     }
 
-    private static (int x, int y) ParseTwoIntArgs(string code, string name)
+    private static (int x, int y) ParseTwoIntArgs(ReadOnlySpan<char> code, string name)
     {
-        var (inner, _) = ExtractInnerArgs(code, name);
-        var parts = inner.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries);
-        if (parts.Length != 2)
+        var remaining = ExtractInnerArgs(code, name);
+        int x = 0, y = 0;
+        var valid = true;
+        var count = 0;
+        while (TryReadArgument(ref remaining, out var argument))
+        {
+            if (count == 0)
+                valid &= int.TryParse(argument, NumberStyles.Integer, CultureInfo.InvariantCulture, out x);
+            else if (count == 1)
+                valid &= int.TryParse(argument, NumberStyles.Integer, CultureInfo.InvariantCulture, out y);
+            count++;
+        }
+
+        if (count != 2)
             throw new FormatException($"Expected two arguments for {name}(x, y).");
 
-        if (!int.TryParse(parts[0], NumberStyles.Integer, CultureInfo.InvariantCulture, out var x) ||
-            !int.TryParse(parts[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var y))
-        {
+        if (!valid)
             throw new FormatException($"Invalid integer arguments for {name}(x, y).");
-        }
 
         // Only validate non-negative for absolute positions (move)
         // Relative movements (move_rel) can have negative values
@@ -252,42 +398,102 @@ public static class ScriptTextConverter
         return (x, y);
     }
 
-    private static MouseButton ParseMouseButtonSingleArg(string code, string name)
+    private static void ParseMotionStream(ReadOnlySpan<char> code, List<Command> commands)
     {
-        var arg = ParseSingleStringArg(code, name).ToLowerInvariant();
+        var inner = ExtractInnerArgs(code, "move_stream").Trim();
+
+        if (inner.Length < 2 || inner[0] != '{' || inner[^1] != '}')
+            throw new FormatException("Expected move_stream({dx, dy, dt, ...}).");
+
+        var samples = inner[1..^1];
 
-        return arg switch
+        // Validate the shape before parsing any sample, as the error for a bad count takes precedence
+        var remaining = samples;
+        var count = 0;
+        while (TryReadArgument(ref remaining, out _))
         {
-            "left" => MouseButton.Left,
-            "right" => MouseButton.Right,
-            "middle" => MouseButton.Middle,
-            _ => throw new FormatException($"Unsupported mouse button '{arg}'. Expected 'left', 'right', or 'middle'.")
-        };
+            count++;
+        }
+
+        if (count == 0 || count % 3 != 0)
+            throw new FormatException("move_stream expects a non-empty list of dx, dy, dt triples.");
+
+        commands.EnsureCapacity(commands.Count + count / 3);
+        remaining = samples;
+        while (TryReadArgument(ref remaining, out var dxText) &&
+               TryReadArgument(ref remaining, out var dyText) &&
+               TryReadArgument(ref remaining, out var dtText))
+        {
+            if (!int.TryParse(dxText, NumberStyles.Integer, CultureInfo.InvariantCulture, out var dx) ||
+                !int.TryParse(dyText, NumberStyles.Integer, CultureInfo.InvariantCulture, out var dy) ||
+                !int.TryParse(dtText, NumberStyles.Integer, CultureInfo.InvariantCulture, out var dt))
+            {
+                throw new FormatException("Invalid integer arguments for move_stream.");
+            }
+
+            if (dt < 0)
+                throw new FormatException("move_stream delay cannot be negative.");
+
+            commands.Add(new MouseMoveRelativeCommand(dx, dy) { Delay = TimeSpan.FromMilliseconds(dt) });
+        }
+    }
+
+    /// <summary>
+    /// Reads the next comma-separated argument, trimmed and skipping empty entries.
+    /// </summary>
+    private static bool TryReadArgument(ref ReadOnlySpan<char> remaining, out ReadOnlySpan<char> argument)
+    {
+        while (!remaining.IsEmpty)
+        {
+            var commaIdx = remaining.IndexOf(',');
+            if (commaIdx < 0)
+            {
+                argument = remaining.Trim();
+                remaining = default;
+            }
+            else
+            {
+                argument = remaining[..commaIdx].Trim();
+                remaining = remaining[(commaIdx + 1)..];
+            }
+
+            if (!argument.IsEmpty)
+                return true;
+        }
+
+        argument = default;
+        return false;
+    }
+
+    private static MouseButton ParseMouseButtonSingleArg(ReadOnlySpan<char> code, string name)
+    {
+        var arg = ParseSingleStringArg(code, name);
+
+        if (arg.Equals("left", StringComparison.OrdinalIgnoreCase))
+            return MouseButton.Left;
+        if (arg.Equals("right", StringComparison.OrdinalIgnoreCase))
+            return MouseButton.Right;
+        if (arg.Equals("middle", StringComparison.OrdinalIgnoreCase))
+            return MouseButton.Middle;
+
+        throw new FormatException($"Unsupported mouse button '{Unescape(arg).ToLowerInvariant()}'. Expected 'left', 'right', or 'middle'.");
     }
 
-    private static VirtualKey ParseVirtualKeyFromChar(string key)
+    private static VirtualKey ParseVirtualKeyFromChar(ReadOnlySpan<char> key)
     {
-        if (string.IsNullOrEmpty(key))
+        if (key.IsEmpty)
             throw new FormatException("Key cannot be empty.");
 
         if (key.Length == 1)
         {
+            // VK_A..VK_Z and VK_0..VK_9 share their codes with the upper-case ASCII characters
             var c = key[0];
 
-            if (char.IsLetter(c))
-            {
-                var upper = char.ToUpperInvariant(c);
-                var name = $"VK_{upper}";
-                if (Enum.TryParse<VirtualKey>(name, out var vk))
-                    return vk;
-            }
+            if (char.IsAsciiLetter(c))
+                return (VirtualKey)char.ToUpperInvariant(c);
 
-            if (char.IsDigit(c))
-            {
-                var name = $"VK_{c}";
-                if (Enum.TryParse<VirtualKey>(name, out var vk))
-                    return vk;
-            }
+            if (char.IsAsciiDigit(c))
+                return (VirtualKey)c;
         }
 
         // Fallback: try raw enum name
@@ -297,7 +503,7 @@ public static class ScriptTextConverter
         throw new FormatException($"Unsupported key '{key}'.");
     }
 
-    private static (string inner, int startIndex) ExtractInnerArgs(string code, string name)
+    private static ReadOnlySpan<char> ExtractInnerArgs(ReadOnlySpan<char> code, string name)
     {
         var openIdx = code.IndexOf('(');
         var closeIdx = code.LastIndexOf(')');
@@ -309,8 +515,7 @@ public static class ScriptTextConverter
         if (!fnName.Equals(name, StringComparison.OrdinalIgnoreCase))
             throw new FormatException($"Expected function name '{name}', got '{fnName}'.");
 
-        var inner = code.Substring(openIdx + 1, closeIdx - openIdx - 1);
-        return (inner, openIdx + 1);
+        return code[(openIdx + 1)..closeIdx];
     }
 
     private static string ToButtonName(MouseButton button) =>
@@ -322,17 +527,301 @@ public static class ScriptTextConverter
             _ => button.ToString().ToLowerInvariant()
         };
 
-    private static string ToKeyCharName(VirtualKey vk)
+    private static string ToKeyCharName(VirtualKey vk) =>
+        KeyCharNames.GetOrAdd(vk, static key =>
+        {
+            var name = key.ToString();
+            if (name.StartsWith("VK_", StringComparison.Ordinal))
+            {
+                var shortName = name.Substring(3);
+                if (shortName.Length == 1)
+                    return shortName.ToLowerInvariant();
+            }
+
+            return name;
+        });
+
+    private static void WriteInteger(TextWriter writer, long value)
+    {
+        Span<char> digits = stackalloc char[20];
+        value.TryFormat(digits, out var written, default, CultureInfo.InvariantCulture);
+        writer.Write(digits[..written]);
+    }
+
+    private static void WriteMsleepIfAny(TextWriter writer, TimeSpan duration)
+    {
+        if (duration <= TimeSpan.Zero)
+            return;
+
+        // As requested: always emit msleep with integer milliseconds.
+        // Round to nearest millisecond to avoid systematic bias.
+        var ms = (long)Math.Round(duration.TotalMilliseconds, MidpointRounding.AwayFromZero);
+        if (ms <= 0)
+            return;
+
+        writer.Write("msleep(");
+        WriteInteger(writer, ms);
+        writer.WriteLine(')');
+    }
+
+    private static void WriteCommand(TextWriter writer, in CommandRecord command)
+    {
+        switch (command.Opcode)
+        {
+            // All move commands use unified functions - actual behavior depends on InputMode setting
+            case CommandOpcode.MouseMove:
+                writer.Write("move(");
+                WriteInteger(writer, command.X);
+                writer.Write(", ");
+                WriteInteger(writer, command.Y);
+                writer.WriteLine(')');
+                break;
+
+            case CommandOpcode.MouseMoveRelative:
+                writer.Write("move_rel(");
+                WriteInteger(writer, command.X);
+                writer.Write(", ");
+                WriteInteger(writer, command.Y);
+                writer.WriteLine(')');
+                break;
+
+            case CommandOpcode.MouseClick:
+                var fn = command.ClickType switch
+                {
+                    ClickType.Down => "mouse_down",
+                    ClickType.Up => "mouse_release",
+                    ClickType.Click => "mouse_click",
+                    _ => "mouse_click"
+                };
+                writer.Write(fn);
+                writer.Write("('");
+                writer.Write(ToButtonName(command.Button));
+                writer.WriteLine("')");
+                break;
+
+            case CommandOpcode.Sleep:
+                WriteMsleepIfAny(writer, command.Duration);
+                break;
+
+            case CommandOpcode.Keyboard when !string.IsNullOrEmpty(command.Text):
+                writer.Write("type_text('");
+                WriteEscapedSingleQuotes(writer, command.Text);
+                writer.WriteLine("')");
+                break;
+
+            case CommandOpcode.KeyPress:
+                writer.Write(command.IsDown ? "key_down('" : "key_release('");
+                writer.Write(ToKeyCharName(command.Key));
+                writer.WriteLine("')");
+                break;
+
+            case CommandOpcode.Keyboard:
+                var keyList = string.Join("+", command.Keys.Select(k => k.ToString()));
+                writer.WriteLine($"# keys: {keyList}");
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Writes commands one at a time. A run of relative moves is held back only until
+    /// <see cref="MaxSamplesPerMotionStream"/> samples have been seen, so memory stays bounded.
+    /// </summary>
+    private sealed class CommandTextEmitter
     {
-        var name = vk.ToString();
-        if (name.StartsWith("VK_", StringComparison.Ordinal))
+        private readonly TextWriter _writer;
+        private readonly CommandRecord[]? _motionRun;
+        private int _motionRunCount;
+        private bool _motionRunSplit;
+
+        public CommandTextEmitter(TextWriter writer, bool packRelativeMoves)
+        {
+            _writer = writer;
+            _motionRun = packRelativeMoves ? new CommandRecord[MaxSamplesPerMotionStream] : null;
+        }
+
+        public void Write(Command command)
+        {
+            if (CommandRecord.TryCreate(command, out var record))
+            {
+                Write(record);
+                return;
+            }
+
+            FlushMotionRun();
+            WriteMsleepIfAny(_writer, command.Delay);
+            _writer.WriteLine($"# Unsupported command type: {command.DisplayName}");
+        }
+
+        public void Write(in CommandRecord command)
+        {
+            if (_motionRun != null && command.Opcode == CommandOpcode.MouseMoveRelative)
+            {
+                if (_motionRunCount == _motionRun.Length)
+                {
+                    WriteMotionStream();
+                    _motionRunSplit = true;
+                }
+
+                _motionRun[_motionRunCount++] = command;
+                return;
+            }
+
+            FlushMotionRun();
+
+            // Preserve timing: Command.Delay is the time gap since the previous command.
+            // In Lua/text form we represent that gap explicitly via msleep(...) so
+            // recorded scripts keep realistic pacing when executed by LuaScriptRunner.
+            WriteMsleepIfAny(_writer, command.Delay);
+
+            WriteCommand(_writer, command);
+        }
+
+        public void Complete() => FlushMotionRun();
+
+        private void FlushMotionRun()
         {
-            var shortName = name.Substring(3);
-            if (shortName.Length == 1)
-                return shortName.ToLowerInvariant();
+            if (_motionRunCount == 0)
+                return;
+
+            // A lone move reads better as move_rel
+            if (_motionRunCount == 1 && !_motionRunSplit)
+            {
+                WriteMsleepIfAny(_writer, _motionRun![0].Delay);
+                WriteCommand(_writer, _motionRun[0]);
+                _motionRunCount = 0;
+            }
+            else
+            {
+                WriteMotionStream();
+            }
+
+            _motionRunSplit = false;
         }
 
-        return name;
+        private void WriteMotionStream()
+        {
+            _writer.Write("move_stream({");
+            for (var i = 0; i < _motionRunCount; i++)
+            {
+                if (i > 0)
+                    _writer.Write(", ");
+
+                ref readonly var move = ref _motionRun![i];
+                var ms = Math.Max(0, (long)Math.Round(move.Delay.TotalMilliseconds, MidpointRounding.AwayFromZero));
+                WriteInteger(_writer, move.X);
+                _writer.Write(", ");
+                WriteInteger(_writer, move.Y);
+                _writer.Write(", ");
+                WriteInteger(_writer, ms);
+            }
+            _writer.WriteLine("})");
+
+            _motionRunCount = 0;
+        }
     }
-}
 
+    /// <summary>
+    /// Splits a reader into lines over a reusable character buffer, so no string is created per line.
+    /// A line is available through <see cref="CurrentLine"/> until the next read.
+    /// </summary>
+    private sealed class LineReader
+    {
+        private const int InitialBufferSize = 4096;
+
+        private readonly TextReader _reader;
+        private char[] _buffer = new char[InitialBufferSize];
+        private int _start;
+        private int _end;
+        private int _scanned;
+        private int _lineStart;
+        private int _lineLength;
+        private bool _endOfInput;
+
+        public LineReader(TextReader reader)
+        {
+            _reader = reader;
+        }
+
+        public ReadOnlySpan<char> CurrentLine => _buffer.AsSpan(_lineStart, _lineLength);
+
+        public bool TryReadLine()
+        {
+            while (true)
+            {
+                if (TryTakeLine())
+                    return true;
+
+                if (_endOfInput)
+                    return TryTakeRemainder();
+
+                CommitRead(_reader.Read(GetFreeSpace().Span));
+            }
+        }
+
+        public async ValueTask<bool> TryReadLineAsync(CancellationToken cancellationToken)
+        {
+            while (true)
+            {
+                if (TryTakeLine())
+                    return true;
+
+                if (_endOfInput)
+                    return TryTakeRemainder();
+
+                CommitRead(await _reader.ReadAsync(GetFreeSpace(), cancellationToken).ConfigureAwait(false));
+            }
+        }
+
+        private bool TryTakeLine()
+        {
+            var newline = _buffer.AsSpan(_start + _scanned, _end - _start - _scanned).IndexOf('\n');
+            if (newline < 0)
+            {
+                _scanned = _end - _start;
+                return false;
+            }
+
+            _lineStart = _start;
+            _lineLength = _scanned + newline;
+            _start += _lineLength + 1;
+            _scanned = 0;
+            return true;
+        }
+
+        private bool TryTakeRemainder()
+        {
+            if (_start == _end)
+                return false;
+
+            _lineStart = _start;
+            _lineLength = _end - _start;
+            _start = _end;
+            _scanned = 0;
+            return true;
+        }
+
+        private Memory<char> GetFreeSpace()
+        {
+            // Move the partial line to the front, and grow only when a single line fills the buffer
+            if (_start > 0)
+            {
+                Array.Copy(_buffer, _start, _buffer, 0, _end - _start);
+                _end -= _start;
+                _start = 0;
+            }
+
+            if (_end == _buffer.Length)
+                Array.Resize(ref _buffer, _buffer.Length * 2);
+
+            return _buffer.AsMemory(_end);
+        }
+
+        private void CommitRead(int read)
+        {
+            if (read == 0)
+                _endOfInput = true;
+            else
+                _end += read;
+        }
+    }
+}
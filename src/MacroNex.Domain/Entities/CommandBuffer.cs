@@ -0,0 +1,288 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Domain.Entities;
+
+/// <summary>
+/// Struct-of-arrays storage for a script's commands: one column each for the opcode, the two operands and the
+/// delay, with the rare text and key lists of keyboard commands in a side table. A relative move costs 17 bytes
+/// instead of a command object with its own identity, timestamps and header, and the whole recording is five
+/// arrays for the GC rather than one object per command.
+/// Enumeration yields <see cref="CommandRecord"/> values straight from the columns, and the columns are exposed
+/// as spans for bulk conversion and persistence. Not thread-safe.
+/// </summary>
+public sealed class CommandBuffer
+{
+    private const int DefaultCapacity = 16;
+
+    private CommandOpcode[] _opcodes;
+    private int[] _x;
+    private int[] _y;
+    private long[] _delayTicks;
+    private int _count;
+    private readonly List<KeyboardPayload> _keyboard;
+
+    /// <summary>
+    /// Initializes an empty buffer.
+    /// </summary>
+    /// <param name="capacity">Number of commands to allocate room for.</param>
+    public CommandBuffer(int capacity = 0)
+    {
+        if (capacity < 0)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity cannot be negative.");
+
+        _opcodes = new CommandOpcode[capacity];
+        _x = new int[capacity];
+        _y = new int[capacity];
+        _delayTicks = new long[capacity];
+        _keyboard = new List<KeyboardPayload>();
+    }
+
+    private CommandBuffer(CommandOpcode[] opcodes, int[] x, int[] y, long[] delayTicks, int count, List<KeyboardPayload> keyboard)
+    {
+        _opcodes = opcodes;
+        _x = x;
+        _y = y;
+        _delayTicks = delayTicks;
+        _count = count;
+        _keyboard = keyboard;
+    }
+
+    /// <summary>
+    /// Gets the number of commands.
+    /// </summary>
+    public int Count => _count;
+
+    /// <summary>
+    /// Gets the opcode column.
+    /// </summary>
+    public ReadOnlySpan<CommandOpcode> Opcodes => _opcodes.AsSpan(0, _count);
+
+    /// <summary>
+    /// Gets the first operand column.
+    /// </summary>
+    public ReadOnlySpan<int> X => _x.AsSpan(0, _count);
+
+    /// <summary>
+    /// Gets the second operand column.
+    /// </summary>
+    public ReadOnlySpan<int> Y => _y.AsSpan(0, _count);
+
+    /// <summary>
+    /// Gets the delay column, in <see cref="TimeSpan"/> ticks.
+    /// </summary>
+    public ReadOnlySpan<long> DelayTicks => _delayTicks.AsSpan(0, _count);
+
+    /// <summary>
+    /// Gets the number of keyboard payloads; keyboard commands index them through their X operand.
+    /// </summary>
+    public int KeyboardPayloadCount => _keyboard.Count;
+
+    /// <summary>
+    /// Gets the command at <paramref name="index"/>.
+    /// </summary>
+    public CommandRecord this[int index]
+    {
+        get
+        {
+            if ((uint)index >= (uint)_count)
+                throw new ArgumentOutOfRangeException(nameof(index));
+
+            return Read(index);
+        }
+    }
+
+    /// <summary>
+    /// Gets the text and keys of keyboard payload <paramref name="index"/>.
+    /// </summary>
+    public (string? Text, IReadOnlyList<VirtualKey> Keys) GetKeyboardPayload(int index)
+    {
+        var payload = _keyboard[index];
+        return (payload.Text, payload.Keys);
+    }
+
+    /// <summary>
+    /// Appends a command.
+    /// </summary>
+    public void Add(in CommandRecord record)
+    {
+        if (record.Opcode == CommandOpcode.None || !Enum.IsDefined(record.Opcode))
+            throw new ArgumentException($"Unsupported command opcode: {record.Opcode}", nameof(record));
+
+        if (_count == _opcodes.Length)
+            Grow();
+
+        var x = record.X;
+        if (record.Opcode == CommandOpcode.Keyboard)
+        {
+            // Copy the keys: the record may share a command's mutable list
+            x = _keyboard.Count;
+            _keyboard.Add(new KeyboardPayload(record.Text, record.Keys.ToArray()));
+        }
+
+        _opcodes[_count] = record.Opcode;
+        _x[_count] = x;
+        _y[_count] = record.Opcode == CommandOpcode.Keyboard ? 0 : record.Y;
+        _delayTicks[_count] = record.Delay.Ticks;
+        _count++;
+    }
+
+    /// <summary>
+    /// Appends a command object. Fails, leaving the buffer unchanged, for command types it cannot represent.
+    /// </summary>
+    public bool TryAdd(Command command)
+    {
+        if (!CommandRecord.TryCreate(command, out var record))
+            return false;
+
+        Add(record);
+        return true;
+    }
+
+    /// <summary>
+    /// Packs command objects into a new buffer. Fails if any command type cannot be represented.
+    /// </summary>
+    public static bool TryCreate(IEnumerable<Command> commands, out CommandBuffer buffer)
+    {
+        if (commands == null)
+            throw new ArgumentNullException(nameof(commands));
+
+        buffer = new CommandBuffer(commands.TryGetNonEnumeratedCount(out var count) ? count : 0);
+        foreach (var command in commands)
+        {
+            if (!buffer.TryAdd(command))
+            {
+                buffer = null!;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Creates a buffer over existing columns, which it takes ownership of (used by deserialization).
+    /// </summary>
+    /// <param name="opcodes">Opcode column; at least <paramref name="count"/> long.</param>
+    /// <param name="x">First operand column.</param>
+    /// <param name="y">Second operand column.</param>
+    /// <param name="delayTicks">Delay column in ticks.</param>
+    /// <param name="count">Number of commands stored in the columns.</param>
+    /// <param name="keyboardPayloads">Text and keys referenced by keyboard commands.</param>
+    public static CommandBuffer FromColumns(
+        CommandOpcode[] opcodes,
+        int[] x,
+        int[] y,
+        long[] delayTicks,
+        int count,
+        IEnumerable<(string? Text, IReadOnlyList<VirtualKey> Keys)> keyboardPayloads)
+    {
+        if (opcodes == null) throw new ArgumentNullException(nameof(opcodes));
+        if (x == null) throw new ArgumentNullException(nameof(x));
+        if (y == null) throw new ArgumentNullException(nameof(y));
+        if (delayTicks == null) throw new ArgumentNullException(nameof(delayTicks));
+        if (keyboardPayloads == null) throw new ArgumentNullException(nameof(keyboardPayloads));
+        if (count < 0 || count > opcodes.Length || count > x.Length || count > y.Length || count > delayTicks.Length)
+            throw new ArgumentOutOfRangeException(nameof(count), "Count exceeds the length of a column.");
+
+        var keyboard = keyboardPayloads.Select(p => new KeyboardPayload(p.Text, p.Keys.ToArray())).ToList();
+        for (int i = 0; i < count; i++)
+        {
+            var opcode = opcodes[i];
+            if (opcode == CommandOpcode.None || !Enum.IsDefined(opcode))
+                throw new ArgumentException($"Unsupported command opcode {opcode} at index {i}.", nameof(opcodes));
+            if (opcode == CommandOpcode.Keyboard && (uint)x[i] >= (uint)keyboard.Count)
+                throw new ArgumentException($"Keyboard command at index {i} references missing payload {x[i]}.", nameof(x));
+        }
+
+        return new CommandBuffer(opcodes, x, y, delayTicks, count, keyboard);
+    }
+
+    /// <summary>
+    /// Removes all commands, keeping the allocated capacity.
+    /// </summary>
+    public void Clear()
+    {
+        _count = 0;
+        _keyboard.Clear();
+    }
+
+    /// <summary>
+    /// Creates an independent copy of the buffer.
+    /// </summary>
+    public CommandBuffer Clone()
+    {
+        return new CommandBuffer(
+            _opcodes.AsSpan(0, _count).ToArray(),
+            _x.AsSpan(0, _count).ToArray(),
+            _y.AsSpan(0, _count).ToArray(),
+            _delayTicks.AsSpan(0, _count).ToArray(),
+            _count,
+            new List<KeyboardPayload>(_keyboard));
+    }
+
+    /// <summary>
+    /// Creates command objects for every command, each with a new identity.
+    /// </summary>
+    public List<Command> ToCommandList()
+    {
+        var commands = new List<Command>(_count);
+        for (int i = 0; i < _count; i++)
+        {
+            commands.Add(Read(i).ToCommand());
+        }
+        return commands;
+    }
+
+    /// <summary>
+    /// Returns an enumerator over the commands that allocates nothing.
+    /// </summary>
+    public Enumerator GetEnumerator() => new(this);
+
+    private CommandRecord Read(int index)
+    {
+        var opcode = _opcodes[index];
+        if (opcode == CommandOpcode.Keyboard)
+        {
+            var payload = _keyboard[_x[index]];
+            return new CommandRecord(opcode, 0, 0, TimeSpan.FromTicks(_delayTicks[index]), payload.Text, payload.Keys);
+        }
+
+        return new CommandRecord(opcode, _x[index], _y[index], TimeSpan.FromTicks(_delayTicks[index]));
+    }
+
+    private void Grow()
+    {
+        var capacity = Math.Max(DefaultCapacity, _opcodes.Length * 2);
+        Array.Resize(ref _opcodes, capacity);
+        Array.Resize(ref _x, capacity);
+        Array.Resize(ref _y, capacity);
+        Array.Resize(ref _delayTicks, capacity);
+    }
+
+    private sealed record KeyboardPayload(string? Text, VirtualKey[] Keys);
+
+    /// <summary>
+    /// Enumerates the commands of a <see cref="CommandBuffer"/> as values.
+    /// </summary>
+    public struct Enumerator
+    {
+        private readonly CommandBuffer _buffer;
+        private int _index;
+
+        internal Enumerator(CommandBuffer buffer)
+        {
+            _buffer = buffer;
+            _index = -1;
+        }
+
+        /// <summary>
+        /// Gets the command at the current position.
+        /// </summary>
+        public readonly CommandRecord Current => _buffer.Read(_index);
+
+        /// <summary>
+        /// Advances to the next command.
+        /// </summary>
+        public bool MoveNext() => ++_index < _buffer._count;
+    }
+}
@@ -0,0 +1,179 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Domain.Entities;
+
+/// <summary>
+/// A command as a value: the opcode, two operands and the delay, plus the text and keys of keyboard commands.
+/// This is the row type of <see cref="CommandBuffer"/>; unlike <see cref="Command"/> it has no identity or
+/// creation time, and reading one allocates nothing. Operands are interpreted per <see cref="CommandOpcode"/>.
+/// </summary>
+public readonly struct CommandRecord
+{
+    private static readonly VirtualKey[] NoKeys = Array.Empty<VirtualKey>();
+
+    private readonly IReadOnlyList<VirtualKey>? _keys;
+
+    /// <summary>
+    /// Initializes a record from raw fields. Prefer the typed factories.
+    /// </summary>
+    public CommandRecord(CommandOpcode opcode, int x, int y, TimeSpan delay, string? text = null, IReadOnlyList<VirtualKey>? keys = null)
+    {
+        Opcode = opcode;
+        X = x;
+        Y = y;
+        Delay = delay;
+        Text = text;
+        _keys = keys;
+    }
+
+    /// <summary>
+    /// Gets the kind of command.
+    /// </summary>
+    public CommandOpcode Opcode { get; }
+
+    /// <summary>
+    /// Gets the first operand.
+    /// </summary>
+    public int X { get; }
+
+    /// <summary>
+    /// Gets the second operand.
+    /// </summary>
+    public int Y { get; }
+
+    /// <summary>
+    /// Gets the time gap between the previous command and this one.
+    /// </summary>
+    public TimeSpan Delay { get; }
+
+    /// <summary>
+    /// Gets the text of a keyboard command.
+    /// </summary>
+    public string? Text { get; }
+
+    /// <summary>
+    /// Gets the key combination of a keyboard command.
+    /// </summary>
+    public IReadOnlyList<VirtualKey> Keys => _keys ?? NoKeys;
+
+    /// <summary>
+    /// Gets the target of an absolute move.
+    /// </summary>
+    public Point Position => new(X, Y);
+
+    /// <summary>
+    /// Gets the button of a mouse click.
+    /// </summary>
+    public MouseButton Button => (MouseButton)X;
+
+    /// <summary>
+    /// Gets the click type of a mouse click.
+    /// </summary>
+    public ClickType ClickType => (ClickType)Y;
+
+    /// <summary>
+    /// Gets the key of a key press.
+    /// </summary>
+    public VirtualKey Key => (VirtualKey)X;
+
+    /// <summary>
+    /// Gets whether a key press is a key-down.
+    /// </summary>
+    public bool IsDown => Y != 0;
+
+    /// <summary>
+    /// Gets the duration of a sleep.
+    /// </summary>
+    public TimeSpan Duration => TimeSpan.FromTicks(((long)Y << 32) | (uint)X);
+
+    /// <summary>
+    /// Creates an absolute mouse move.
+    /// </summary>
+    public static CommandRecord MouseMove(Point position, TimeSpan delay = default) =>
+        new(CommandOpcode.MouseMove, position.X, position.Y, delay);
+
+    /// <summary>
+    /// Creates a relative mouse move.
+    /// </summary>
+    public static CommandRecord MouseMoveRelative(int deltaX, int deltaY, TimeSpan delay = default) =>
+        new(CommandOpcode.MouseMoveRelative, deltaX, deltaY, delay);
+
+    /// <summary>
+    /// Creates a mouse click.
+    /// </summary>
+    public static CommandRecord MouseClick(MouseButton button, ClickType type, TimeSpan delay = default) =>
+        new(CommandOpcode.MouseClick, (int)button, (int)type, delay);
+
+    /// <summary>
+    /// Creates a key press or release.
+    /// </summary>
+    public static CommandRecord KeyPress(VirtualKey key, bool isDown, TimeSpan delay = default) =>
+        new(CommandOpcode.KeyPress, (int)key, isDown ? 1 : 0, delay);
+
+    /// <summary>
+    /// Creates a text or key combination command.
+    /// </summary>
+    public static CommandRecord Keyboard(string? text, IReadOnlyList<VirtualKey> keys, TimeSpan delay = default) =>
+        new(CommandOpcode.Keyboard, 0, 0, delay, text, keys ?? throw new ArgumentNullException(nameof(keys)));
+
+    /// <summary>
+    /// Creates a sleep.
+    /// </summary>
+    public static CommandRecord Sleep(TimeSpan duration, TimeSpan delay = default) =>
+        new(CommandOpcode.Sleep, unchecked((int)duration.Ticks), (int)(duration.Ticks >> 32), delay);
+
+    /// <summary>
+    /// Creates the record for a command. Fails for command types the buffer cannot represent.
+    /// </summary>
+    public static bool TryCreate(Command command, out CommandRecord record)
+    {
+        if (command == null)
+            throw new ArgumentNullException(nameof(command));
+
+        record = command switch
+        {
+            MouseMoveCommand move => MouseMove(move.Position, move.Delay),
+            MouseMoveRelativeCommand moveRel => MouseMoveRelative(moveRel.DeltaX, moveRel.DeltaY, moveRel.Delay),
+            MouseClickCommand click => MouseClick(click.Button, click.Type, click.Delay),
+            KeyPressCommand kp => KeyPress(kp.Key, kp.IsDown, kp.Delay),
+            KeyboardCommand keyboard => Keyboard(keyboard.Text, keyboard.Keys, keyboard.Delay),
+            SleepCommand sleep => Sleep(sleep.Duration, sleep.Delay),
+            _ => default
+        };
+
+        return record.Opcode != CommandOpcode.None;
+    }
+
+    /// <summary>
+    /// Validates the record with the same rules as the equivalent <see cref="Command"/>.
+    /// </summary>
+    public bool IsValid() => Opcode switch
+    {
+        CommandOpcode.MouseMove => X >= 0 && Y >= 0,
+        CommandOpcode.MouseMoveRelative => X >= short.MinValue && X <= short.MaxValue && Y >= short.MinValue && Y <= short.MaxValue,
+        CommandOpcode.MouseClick => Enum.IsDefined(Button) && Enum.IsDefined(ClickType),
+        CommandOpcode.KeyPress => Enum.IsDefined(Key),
+        CommandOpcode.Keyboard => !string.IsNullOrEmpty(Text) || Keys.Count > 0,
+        CommandOpcode.Sleep => Duration >= TimeSpan.Zero,
+        _ => false
+    };
+
+    /// <summary>
+    /// Creates the equivalent command object, with a new identity.
+    /// </summary>
+    public Command ToCommand()
+    {
+        var id = Guid.NewGuid();
+        var createdAt = DateTime.UtcNow;
+        return Opcode switch
+        {
+            CommandOpcode.MouseMove => new MouseMoveCommand(id, Delay, createdAt, Position),
+            CommandOpcode.MouseMoveRelative => new MouseMoveRelativeCommand(id, Delay, createdAt, X, Y),
+            CommandOpcode.MouseClick => new MouseClickCommand(id, Delay, createdAt, Button, ClickType),
+            CommandOpcode.KeyPress => new KeyPressCommand(id, Delay, createdAt, Key, IsDown),
+            CommandOpcode.Keyboard => new KeyboardCommand(id, Delay, createdAt, Text, Keys),
+            CommandOpcode.Sleep => new SleepCommand(id, Delay, createdAt, Duration),
+            _ => throw new InvalidOperationException($"Unsupported command opcode: {Opcode}")
+        };
+    }
+}
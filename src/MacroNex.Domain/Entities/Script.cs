@@ -4,10 +4,16 @@ namespace MacroNex.Domain.Entities;
 
 /// <summary>
 /// Represents an automation script.
+/// Commands are held either as objects or, for large recordings, compactly in a <see cref="Entities.CommandBuffer"/>.
+/// A compact script stays compact while commands are appended, cleared or enumerated through
+/// <see cref="CommandBuffer"/>; any other access to the command objects unpacks it once, giving every command a new identity.
+/// Concurrent readers may race to unpack; the unpack runs once under a lock. Mutations are not thread-safe.
 /// </summary>
 public class Script
 {
-    private readonly List<Command> _commands;
+    private List<Command> _commands;
+    private CommandBuffer? _commandBuffer; // set while the commands are held compactly
+    private readonly object _packLock = new();
     private string _name;
     private string _sourceText = string.Empty;
 
@@ -40,7 +46,17 @@ public class Script
     /// <summary>
     /// Read-only collection of commands in this script.
     /// </summary>
-    public IReadOnlyList<Command> Commands => _commands.AsReadOnly();
+    public IReadOnlyList<Command> Commands => GetCommandList().AsReadOnly();
+
+    /// <summary>
+    /// Gets the compact command storage, or null while the commands are held as objects.
+    /// </summary>
+    public CommandBuffer? CommandBuffer => _commandBuffer;
+
+    /// <summary>
+    /// Gets whether the commands are held in a <see cref="Entities.CommandBuffer"/>.
+    /// </summary>
+    public bool IsCompact => _commandBuffer != null;
 
     /// <summary>
     /// Lua source code for this script. This is the primary representation for execution.
@@ -68,13 +84,18 @@ public class Script
     /// <summary>
     /// Gets the total number of commands in this script.
     /// </summary>
-    public int CommandCount => _commands.Count;
+    public int CommandCount => _commandBuffer?.Count ?? _commands.Count;
 
     /// <summary>
     /// Gets the length of the SourceText in characters.
     /// </summary>
     public int SourceTextLength => _sourceText.Length;
 
+    /// <summary>
+    /// Gets the metadata describing this script (everything except its body).
+    /// </summary>
+    public ScriptMetadata ToMetadata() => new(Id, Name, CreatedAt, ModifiedAt, TriggerHotkey, SourceTextLength);
+
     /// <summary>
     /// Initializes a new script with the specified name.
     /// </summary>
@@ -115,6 +136,41 @@ public class Script
         _sourceText = sourceText ?? string.Empty;
     }
 
+    /// <summary>
+    /// Initializes a compact script over a command buffer (used for deserialization).
+    /// </summary>
+    /// <param name="id">The unique identifier for this script.</param>
+    /// <param name="name">The display name for the script.</param>
+    /// <param name="commands">The commands for this script; the script takes ownership of the buffer.</param>
+    /// <param name="createdAt">The timestamp when this script was created.</param>
+    /// <param name="modifiedAt">The timestamp when this script was last modified.</param>
+    /// <param name="triggerHotkey">Optional hotkey that triggers this script execution.</param>
+    public Script(Guid id, string name, CommandBuffer commands, DateTime createdAt, DateTime modifiedAt, HotkeyDefinition? triggerHotkey = null, string? sourceText = null)
+        : this(id, name, Array.Empty<Command>(), createdAt, modifiedAt, triggerHotkey, sourceText)
+    {
+        _commandBuffer = commands ?? throw new ArgumentNullException(nameof(commands));
+    }
+
+    /// <summary>
+    /// Moves the commands into a <see cref="Entities.CommandBuffer"/>, releasing the command objects.
+    /// Does not count as a modification.
+    /// </summary>
+    /// <returns>True if the script is compact; false if it holds a command type the buffer cannot represent.</returns>
+    public bool Compact()
+    {
+        lock (_packLock)
+        {
+            if (_commandBuffer != null)
+                return true;
+            if (!CommandBuffer.TryCreate(_commands, out var buffer))
+                return false;
+
+            _commandBuffer = buffer;
+            _commands = new List<Command>();
+            return true;
+        }
+    }
+
     /// <summary>
     /// Adds a command to the end of the script.
     /// </summary>
@@ -124,7 +180,10 @@ public class Script
         if (command == null)
             throw new ArgumentNullException(nameof(command));
 
-        _commands.Add(command);
+        // Appending keeps a compact script compact (recordings grow this way)
+        if (_commandBuffer == null || !_commandBuffer.TryAdd(command))
+            GetCommandList().Add(command);
+
         ModifiedAt = DateTime.UtcNow;
     }
 
@@ -137,10 +196,11 @@ public class Script
     {
         if (command == null)
             throw new ArgumentNullException(nameof(command));
-        if (index < 0 || index > _commands.Count)
+        var commands = GetCommandList();
+        if (index < 0 || index > commands.Count)
             throw new ArgumentOutOfRangeException(nameof(index));
 
-        _commands.Insert(index, command);
+        commands.Insert(index, command);
         ModifiedAt = DateTime.UtcNow;
     }
 
@@ -151,10 +211,10 @@ public class Script
     /// <returns>True if the command was successfully removed, false otherwise.</returns>
     public bool RemoveCommandAt(int index)
     {
-        if (index < 0 || index >= _commands.Count)
+        if (index < 0 || index >= CommandCount)
             return false;
 
-        _commands.RemoveAt(index);
+        GetCommandList().RemoveAt(index);
         ModifiedAt = DateTime.UtcNow;
         return true;
     }
@@ -166,7 +226,8 @@ public class Script
     /// <returns>True if the command was successfully removed, false otherwise.</returns>
     public bool RemoveCommand(Command command)
     {
-        if (command == null)
+        // Command objects from outside are never in a compact script
+        if (command == null || _commandBuffer != null)
             return false;
 
         var removed = _commands.Remove(command);
@@ -185,14 +246,16 @@ public class Script
     /// <returns>True if the command was successfully moved, false otherwise.</returns>
     public bool MoveCommand(int fromIndex, int toIndex)
     {
-        if (fromIndex < 0 || fromIndex >= _commands.Count ||
-            toIndex < 0 || toIndex >= _commands.Count ||
+        var count = CommandCount;
+        if (fromIndex < 0 || fromIndex >= count ||
+            toIndex < 0 || toIndex >= count ||
             fromIndex == toIndex)
             return false;
 
-        var command = _commands[fromIndex];
-        _commands.RemoveAt(fromIndex);
-        _commands.Insert(toIndex, command);
+        var commands = GetCommandList();
+        var command = commands[fromIndex];
+        commands.RemoveAt(fromIndex);
+        commands.Insert(toIndex, command);
         ModifiedAt = DateTime.UtcNow;
         return true;
     }
@@ -207,10 +270,10 @@ public class Script
     {
         if (newCommand == null)
             throw new ArgumentNullException(nameof(newCommand));
-        if (index < 0 || index >= _commands.Count)
+        if (index < 0 || index >= CommandCount)
             return false;
 
-        _commands[index] = newCommand;
+        GetCommandList()[index] = newCommand;
         ModifiedAt = DateTime.UtcNow;
         return true;
     }
@@ -220,7 +283,10 @@ public class Script
     /// </summary>
     public void ClearCommands()
     {
-        _commands.Clear();
+        if (_commandBuffer != null)
+            _commandBuffer.Clear();
+        else
+            _commands.Clear();
         ModifiedAt = DateTime.UtcNow;
     }
 
@@ -231,10 +297,10 @@ public class Script
     /// <returns>The command at the specified index.</returns>
     public Command GetCommand(int index)
     {
-        if (index < 0 || index >= _commands.Count)
+        if (index < 0 || index >= CommandCount)
             throw new ArgumentOutOfRangeException(nameof(index));
 
-        return _commands[index];
+        return GetCommandList()[index];
     }
 
     /// <summary>
@@ -244,7 +310,7 @@ public class Script
     /// <returns>The zero-based index of the command, or -1 if not found.</returns>
     public int IndexOf(Command command)
     {
-        return _commands.IndexOf(command);
+        return _commandBuffer != null ? -1 : _commands.IndexOf(command);
     }
 
     /// <summary>
@@ -253,6 +319,16 @@ public class Script
     /// <returns>True if all commands are valid, false otherwise.</returns>
     public bool IsValid()
     {
+        if (_commandBuffer != null)
+        {
+            foreach (var record in _commandBuffer)
+            {
+                if (!record.IsValid())
+                    return false;
+            }
+            return true;
+        }
+
         return _commands.All(command => command.IsValid());
     }
 
@@ -267,14 +343,43 @@ public class Script
             throw new ArgumentException("New script name cannot be null or empty.", nameof(newName));
 
         var duplicatedScript = new Script(newName);
-        foreach (var command in _commands)
+        if (_commandBuffer != null)
         {
-            duplicatedScript.AddCommand(command.Clone());
+            duplicatedScript._commandBuffer = _commandBuffer.Clone();
+        }
+        else
+        {
+            foreach (var command in _commands)
+            {
+                duplicatedScript.AddCommand(command.Clone());
+            }
         }
         duplicatedScript.SourceText = SourceText;
         return duplicatedScript;
     }
 
+    /// <summary>
+    /// Returns the command objects, unpacking a compact script first.
+    /// </summary>
+    private List<Command> GetCommandList()
+    {
+        if (Volatile.Read(ref _commandBuffer) == null)
+            return _commands;
+
+        lock (_packLock)
+        {
+            var buffer = _commandBuffer;
+            if (buffer != null)
+            {
+                // Publish the list before dropping the buffer so a reader that sees no buffer sees the list
+                _commands = buffer.ToCommandList();
+                Volatile.Write(ref _commandBuffer, null);
+            }
+
+            return _commands;
+        }
+    }
+
     public override bool Equals(object? obj)
     {
         return obj is Script other && Id.Equals(other.Id);
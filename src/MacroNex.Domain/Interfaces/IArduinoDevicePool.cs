@@ -0,0 +1,157 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Domain.Interfaces;
+
+/// <summary>
+/// An <see cref="IArduinoService"/> backed by several Arduino Leonardo devices, each on its own serial link.
+/// <see cref="IArduinoService.ConnectAsync"/> adds a device to the pool and commands are routed across the
+/// connected devices according to <see cref="Routing"/>. The pool counts as connected while any device is.
+/// </summary>
+public interface IArduinoDevicePool : IArduinoService
+{
+    /// <summary>
+    /// Gets or sets how commands are distributed across the connected devices.
+    /// </summary>
+    ArduinoRoutingOptions Routing { get; set; }
+
+    /// <summary>
+    /// Gets the ports of the connected devices in connection order; the first one is the primary device.
+    /// </summary>
+    IReadOnlyList<string> ConnectedPortNames { get; }
+
+    /// <summary>
+    /// Disconnects one device and removes it from the pool. Does nothing when the port is not in the pool.
+    /// </summary>
+    /// <param name="portName">The serial port of the device.</param>
+    /// <returns>A task that represents the asynchronous operation.</returns>
+    Task DisconnectAsync(string portName);
+
+    /// <summary>
+    /// Gets the health of each device in the pool and of the pool as a whole.
+    /// </summary>
+    ArduinoPoolHealth GetHealth();
+
+    /// <summary>
+    /// Raised when the connection state of a single device changes.
+    /// <see cref="IArduinoService.ConnectionStateChanged"/> only reports changes of the aggregate state.
+    /// </summary>
+    event EventHandler<ArduinoConnectionStateChangedEventArgs>? DeviceStateChanged;
+}
+
+/// <summary>
+/// How commands are distributed across the devices of an <see cref="IArduinoDevicePool"/>.
+/// </summary>
+public enum ArduinoRoutingMode
+{
+    /// <summary>
+    /// Every command goes to the primary device; the other devices stand by.
+    /// </summary>
+    Primary,
+
+    /// <summary>
+    /// Mouse commands go to the mouse device and keyboard commands to the keyboard device.
+    /// With a single device connected both streams share it.
+    /// </summary>
+    SplitMouseKeyboard,
+
+    /// <summary>
+    /// Each send goes to the next connected device in turn. A multi-command send stays on one device.
+    /// </summary>
+    RoundRobin
+}
+
+/// <summary>
+/// Routing configuration of an <see cref="IArduinoDevicePool"/>.
+/// </summary>
+public sealed class ArduinoRoutingOptions
+{
+    /// <summary>
+    /// Gets or sets the routing mode.
+    /// </summary>
+    public ArduinoRoutingMode Mode { get; set; } = ArduinoRoutingMode.SplitMouseKeyboard;
+
+    /// <summary>
+    /// Gets or sets the port of the device that receives mouse commands in <see cref="ArduinoRoutingMode.SplitMouseKeyboard"/>.
+    /// When null or not connected, the first connected device that is not the keyboard device is used.
+    /// </summary>
+    public string? MousePortName { get; set; }
+
+    /// <summary>
+    /// Gets or sets the port of the device that receives keyboard commands in <see cref="ArduinoRoutingMode.SplitMouseKeyboard"/>.
+    /// When null or not connected, the first connected device other than the mouse device is used.
+    /// </summary>
+    public string? KeyboardPortName { get; set; }
+
+    /// <summary>
+    /// Gets or sets whether commands keep their send order across devices.
+    /// Before a command goes to another device than the previous one, the devices written since the last
+    /// such switch are flushed to their serial ports. A flush only means the bytes reached the port, not that
+    /// the firmware ran them, so a command on the next device can still overtake them by the USB and firmware
+    /// latency (typically 1-2 ms). Relative mouse moves commute, so consecutive moves may still run on several
+    /// devices in parallel. Disable only when the streams of the devices are independent.
+    /// </summary>
+    public bool PreserveOrderAcrossDevices { get; set; } = true;
+
+    /// <summary>
+    /// Creates the default routing options.
+    /// </summary>
+    public static ArduinoRoutingOptions Default() => new();
+}
+
+/// <summary>
+/// Which command streams the current routing sends to a device.
+/// </summary>
+[Flags]
+public enum ArduinoDeviceRoles
+{
+    /// <summary>
+    /// The device receives nothing (disconnected or standing by).
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// The device receives mouse commands.
+    /// </summary>
+    Mouse = 1,
+
+    /// <summary>
+    /// The device receives keyboard commands.
+    /// </summary>
+    Keyboard = 2
+}
+
+/// <summary>
+/// Health of one device of an <see cref="IArduinoDevicePool"/>.
+/// </summary>
+/// <param name="PortName">The serial port of the device.</param>
+/// <param name="State">The connection state of the device.</param>
+/// <param name="IsPrimary">Whether the device is the primary device of the pool.</param>
+/// <param name="CommandsSent">Number of commands routed to the device since it joined the pool.</param>
+/// <param name="LastError">Message of the last error the device reported, if any.</param>
+/// <param name="LastErrorTime">When the last error was reported (UTC).</param>
+/// <param name="Roles">The command streams the current routing sends to the device.</param>
+public sealed record ArduinoDeviceHealth(
+    string PortName,
+    ArduinoConnectionState State,
+    bool IsPrimary,
+    long CommandsSent,
+    string? LastError,
+    DateTime? LastErrorTime,
+    ArduinoDeviceRoles Roles = ArduinoDeviceRoles.None);
+
+/// <summary>
+/// Aggregate health of an <see cref="IArduinoDevicePool"/>.
+/// </summary>
+/// <param name="State">The aggregate connection state; connected while any device is connected.</param>
+/// <param name="ConnectedCount">Number of connected devices.</param>
+/// <param name="Devices">Health of each device in connection order.</param>
+public sealed record ArduinoPoolHealth(
+    ArduinoConnectionState State,
+    int ConnectedCount,
+    IReadOnlyList<ArduinoDeviceHealth> Devices)
+{
+    /// <summary>
+    /// Gets whether the pool is connected but some of its devices are not.
+    /// </summary>
+    public bool IsDegraded => ConnectedCount > 0 && ConnectedCount < Devices.Count;
+}
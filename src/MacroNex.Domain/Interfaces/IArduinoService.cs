@@ -22,6 +22,12 @@ public interface IArduinoService
     /// </summary>
     string? ConnectedPortName { get; }
 
+    /// <summary>
+    /// Gets the optional features the connected firmware reported; None when not connected or when the
+    /// firmware reports none.
+    /// </summary>
+    ArduinoFirmwareCapabilities Capabilities { get; }
+
     /// <summary>
     /// Gets a list of available serial ports.
     /// </summary>
@@ -52,6 +58,34 @@ public interface IArduinoService
     /// <exception cref="ArduinoCommunicationException">Thrown when communication fails.</exception>
     Task SendCommandAsync(ArduinoCommand command);
 
+    /// <summary>
+    /// Sends several commands to the Arduino as one contiguous serial write.
+    /// The frames are never interleaved with other commands.
+    /// </summary>
+    /// <param name="commands">The commands to send, in order.</param>
+    /// <returns>A task that represents the asynchronous operation.</returns>
+    /// <exception cref="InvalidOperationException">Thrown when not connected.</exception>
+    /// <exception cref="ArduinoCommunicationException">Thrown when communication fails.</exception>
+    Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands);
+
+    /// <summary>
+    /// Waits until every command queued so far has been written to the serial port.
+    /// </summary>
+    /// <returns>A task that represents the asynchronous operation.</returns>
+    /// <exception cref="ArduinoCommunicationException">Thrown when a queued write failed.</exception>
+    Task FlushAsync();
+
+    /// <summary>
+    /// Emergency stop: discards every queued command that has not been written yet, cuts the write in
+    /// progress at the next frame boundary and sends <see cref="ArduinoReleaseAllCommand"/> ahead of anything
+    /// else, or a key-up or button-up for each held input on firmware without
+    /// <see cref="ArduinoFirmwareCapabilities.ReleaseAll"/>. Pending <see cref="FlushAsync"/> calls complete.
+    /// Does nothing when not connected.
+    /// </summary>
+    /// <returns>A task that completes once the release command has been written.</returns>
+    /// <exception cref="ArduinoCommunicationException">Thrown when the release command could not be written.</exception>
+    Task EmergencyStopAsync();
+
     /// <summary>
     /// Raised when the connection state changes.
     /// </summary>
@@ -159,3 +193,58 @@ public class ArduinoCommunicationException : Exception
     {
     }
 }
+
+/// <summary>
+/// Configuration for the pipelined Arduino command transport.
+/// </summary>
+public sealed class ArduinoTransportOptions
+{
+    /// <summary>
+    /// How long the writer waits for more frames after the first one before issuing a write.
+    /// Frames queued within this window are coalesced into a single serial write.
+    /// Zero writes whatever is queued immediately.
+    /// </summary>
+    public TimeSpan BatchWindow { get; set; } = TimeSpan.FromMilliseconds(1);
+
+    /// <summary>
+    /// Maximum number of frames that may be queued but not yet written.
+    /// Senders wait once this many frames are in flight.
+    /// </summary>
+    public int MaxFramesInFlight { get; set; } = 64;
+
+    /// <summary>
+    /// Maximum size of one coalesced write (64 bytes matches one Leonardo USB CDC packet).
+    /// A single frame larger than this is still written on its own.
+    /// </summary>
+    public int MaxBatchBytes { get; set; } = 64;
+
+    /// <summary>
+    /// Maximum UTF-8 size of the text in one keyboard text frame. Longer text is sent as consecutive frames,
+    /// split between characters, so no frame outgrows the firmware's receive buffer.
+    /// The default keeps an encoded frame within one 64-byte USB packet.
+    /// </summary>
+    public int MaxTextChunkBytes { get; set; } = DefaultMaxTextChunkBytes;
+
+    /// <summary>
+    /// Default for <see cref="MaxTextChunkBytes"/>: one 64-byte USB CDC packet less the 4 bytes of frame
+    /// header and checksum. The keyboard text chunker uses the same budget.
+    /// </summary>
+    public const int DefaultMaxTextChunkBytes = 64 - 4;
+
+    /// <summary>
+    /// Whether writes wait for buffer space reported by the firmware (credit-based flow control).
+    /// Flow control starts with the firmware's first report; firmware that never reports is written to unthrottled.
+    /// </summary>
+    public bool EnableFlowControl { get; set; } = true;
+
+    /// <summary>
+    /// How long the writer waits for a flow control report while out of credit before asking the firmware
+    /// for a new one, in case a report was lost.
+    /// </summary>
+    public TimeSpan CreditStallTimeout { get; set; } = TimeSpan.FromMilliseconds(250);
+
+    /// <summary>
+    /// Creates the default transport options.
+    /// </summary>
+    public static ArduinoTransportOptions Default() => new();
+}
@@ -100,6 +100,13 @@ public interface IExecutionService
     /// <returns>A task that represents the asynchronous operation. The task result contains the validation result.</returns>
     Task<ExecutionValidationResult> ValidateScriptForExecutionAsync(Script script);
 
+    /// <summary>
+    /// Gets the sessions of every script that is executing, oldest first.
+    /// <see cref="CurrentSession"/> is only the most recently started one.
+    /// </summary>
+    /// <returns>The active sessions; empty when nothing is running.</returns>
+    IReadOnlyList<ExecutionSession> GetActiveSessions();
+
     /// <summary>
     /// Gets execution statistics for the current session.
     /// </summary>
@@ -173,6 +180,12 @@ public class ExecutionSession
     /// </summary>
     public Exception? Error { get; private set; }
 
+    private readonly object _latenessLock = new();
+    private long _timedActionCount;
+    private TimeSpan _totalLateness;
+    private TimeSpan _maxLateness;
+    private int _timelineResyncCount;
+
     /// <summary>
     /// Initializes a new execution session.
     /// </summary>
@@ -199,6 +212,54 @@ public class ExecutionSession
         ExecutedCommandCount = commandIndex;
     }
 
+    /// <summary>
+    /// Records how late an action ran against its scheduled time (deadline timing mode).
+    /// </summary>
+    /// <param name="lateness">The lateness; negative values are treated as on time.</param>
+    public void RecordActionLateness(TimeSpan lateness)
+    {
+        if (lateness < TimeSpan.Zero)
+            lateness = TimeSpan.Zero;
+
+        lock (_latenessLock)
+        {
+            _timedActionCount++;
+            _totalLateness += lateness;
+            if (lateness > _maxLateness)
+                _maxLateness = lateness;
+        }
+    }
+
+    /// <summary>
+    /// Records that the playback timeline was re-based after falling too far behind.
+    /// </summary>
+    public void RecordTimelineResync()
+    {
+        lock (_latenessLock)
+        {
+            _timelineResyncCount++;
+        }
+    }
+
+    /// <summary>
+    /// Copies the recorded lateness figures into the statistics object.
+    /// </summary>
+    /// <param name="statistics">The statistics to populate.</param>
+    public void FillLatenessStatistics(ExecutionStatistics statistics)
+    {
+        if (statistics == null) throw new ArgumentNullException(nameof(statistics));
+
+        lock (_latenessLock)
+        {
+            statistics.TimedActionCount = _timedActionCount;
+            statistics.AverageActionLateness = _timedActionCount > 0
+                ? TimeSpan.FromTicks(_totalLateness.Ticks / _timedActionCount)
+                : TimeSpan.Zero;
+            statistics.MaxActionLateness = _maxLateness;
+            statistics.TimelineResyncCount = _timelineResyncCount;
+        }
+    }
+
     /// <summary>
     /// Changes the execution state.
     /// </summary>
@@ -294,6 +355,33 @@ public class ExecutionOptions
     /// </summary>
     public InputMode InputMode { get; set; } = InputMode.HighLevel;
 
+    /// <summary>
+    /// Whether script sleeps use the precision timer (about 1 ms accuracy, short spin per sleep)
+    /// instead of the ~15.6 ms default timer.
+    /// </summary>
+    public bool UseHighPrecisionTiming { get; set; }
+
+    /// <summary>
+    /// How script delays are scheduled: relative to the previous action, or against an absolute
+    /// timeline from session start so time spent in input calls does not accumulate as drift.
+    /// </summary>
+    public ExecutionTimingMode TimingMode { get; set; } = ExecutionTimingMode.Relative;
+
+    /// <summary>
+    /// What the deadline scheduler does when actions fall behind the timeline.
+    /// </summary>
+    public DeadlineOverrunPolicy OverrunPolicy { get; set; } = DeadlineOverrunPolicy.CatchUp;
+
+    /// <summary>
+    /// Lateness beyond which <see cref="DeadlineOverrunPolicy.Resync"/> re-bases the timeline.
+    /// </summary>
+    public TimeSpan MaxCatchUpLateness { get; set; } = TimeSpan.FromMilliseconds(250);
+
+    /// <summary>
+    /// Priority of this execution's input when several scripts share a device.
+    /// </summary>
+    public ExecutionPriority Priority { get; set; } = ExecutionPriority.Normal;
+
     /// <summary>
     /// Creates default execution options.
     /// </summary>
@@ -314,6 +402,61 @@ public class ExecutionOptions
     };
 }
 
+/// <summary>
+/// How script delays are scheduled during execution.
+/// </summary>
+public enum ExecutionTimingMode
+{
+    /// <summary>
+    /// Each delay starts when the previous action finishes (time spent in actions adds up).
+    /// </summary>
+    Relative,
+
+    /// <summary>
+    /// Delays advance an absolute timeline from session start; actions run at their scheduled offsets.
+    /// </summary>
+    Deadline
+}
+
+/// <summary>
+/// Behaviour of the deadline scheduler when execution falls behind the timeline.
+/// </summary>
+public enum DeadlineOverrunPolicy
+{
+    /// <summary>
+    /// Run late actions back-to-back (shortened delays) until playback is on schedule again.
+    /// </summary>
+    CatchUp,
+
+    /// <summary>
+    /// Catch up small lateness, but once behind by more than the configured limit,
+    /// drop the backlog and continue from the current time.
+    /// </summary>
+    Resync
+}
+
+/// <summary>
+/// Priority of an execution's input calls on a device shared with other running scripts.
+/// Higher priorities are served first; lower ones still get regular turns.
+/// </summary>
+public enum ExecutionPriority
+{
+    /// <summary>
+    /// Long-running or keep-alive scripts that should yield to everything else.
+    /// </summary>
+    Background,
+
+    /// <summary>
+    /// Scripts started from the UI.
+    /// </summary>
+    Normal,
+
+    /// <summary>
+    /// Macros the user is actively triggering, e.g. by hotkey.
+    /// </summary>
+    Foreground
+}
+
 /// <summary>
 /// Describes where a script execution was initiated.
 /// </summary>
@@ -395,6 +538,31 @@ public class ExecutionStatistics
     /// Number of errors encountered during execution.
     /// </summary>
     public int ErrorCount { get; set; }
+
+    /// <summary>
+    /// Number of actions scheduled against the timeline (deadline timing mode only).
+    /// </summary>
+    public long TimedActionCount { get; set; }
+
+    /// <summary>
+    /// Average lateness of timed actions relative to their scheduled time.
+    /// </summary>
+    public TimeSpan AverageActionLateness { get; set; }
+
+    /// <summary>
+    /// Largest lateness of any timed action.
+    /// </summary>
+    public TimeSpan MaxActionLateness { get; set; }
+
+    /// <summary>
+    /// Number of times the timeline was re-based after falling too far behind.
+    /// </summary>
+    public int TimelineResyncCount { get; set; }
+
+    /// <summary>
+    /// Process-wide latency distribution of each input path stage with samples.
+    /// </summary>
+    public IReadOnlyList<InputLatencyStageStatistics> InputLatency { get; set; } = Array.Empty<InputLatencyStageStatistics>();
 }
 
 /// <summary>
@@ -1,4 +1,5 @@
 using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
 
 namespace MacroNex.Domain.Interfaces;
 
@@ -15,6 +16,21 @@ public interface IFileStorageService
     /// <exception cref="StorageException">Thrown when file operations fail or JSON parsing fails.</exception>
     Task<IEnumerable<Script>> LoadScriptsAsync();
 
+    /// <summary>
+    /// Loads the metadata of all scripts without loading their bodies.
+    /// </summary>
+    /// <returns>A task that represents the asynchronous operation. The task result contains the metadata in library order.</returns>
+    /// <exception cref="StorageException">Thrown when file operations fail or JSON parsing fails.</exception>
+    Task<IEnumerable<ScriptMetadata>> LoadScriptMetadataAsync();
+
+    /// <summary>
+    /// Loads a single script in full.
+    /// </summary>
+    /// <param name="id">The unique identifier of the script.</param>
+    /// <returns>A task that represents the asynchronous operation. The task result contains the script, or null if it does not exist.</returns>
+    /// <exception cref="StorageException">Thrown when file operations fail or JSON parsing fails.</exception>
+    Task<Script?> LoadScriptAsync(Guid id);
+
     /// <summary>
     /// Saves a script to persistent storage.
     /// If the script already exists, it will be updated; otherwise, it will be added.
@@ -0,0 +1,77 @@
+namespace MacroNex.Domain.Interfaces;
+
+/// <summary>
+/// Collects per-stage latency of the input path, from the script host call down to the OS or device.
+/// Recording is lock-free and allocation-free so it can sit on hot paths.
+/// </summary>
+public interface IInputLatencyMonitor
+{
+    /// <summary>
+    /// Records the time elapsed since <paramref name="startTimestamp"/> against a stage.
+    /// </summary>
+    /// <param name="stage">The stage that was measured.</param>
+    /// <param name="startTimestamp">A <see cref="System.Diagnostics.Stopwatch.GetTimestamp"/> value taken when the stage began.</param>
+    void Record(InputLatencyStage stage, long startTimestamp);
+
+    /// <summary>
+    /// Gets the latency distribution of every stage that has samples, in pipeline order.
+    /// </summary>
+    IReadOnlyList<InputLatencyStageStatistics> GetStatistics();
+
+    /// <summary>
+    /// Clears all recorded samples.
+    /// </summary>
+    void Reset();
+}
+
+/// <summary>
+/// Measured stages of the input path.
+/// </summary>
+public enum InputLatencyStage
+{
+    /// <summary>
+    /// Lua host function entry until the input simulator call returns its task.
+    /// </summary>
+    HostCall,
+
+    /// <summary>
+    /// Lua host function entry until the suspended script resumes, including the thread-pool hop.
+    /// Only recorded for calls that did not complete synchronously.
+    /// </summary>
+    HostResume,
+
+    /// <summary>
+    /// Time a frame waits in the serial send queue before the writer picks it up.
+    /// </summary>
+    SerialQueue,
+
+    /// <summary>
+    /// Duration of one write to the serial port.
+    /// </summary>
+    SerialWrite,
+
+    /// <summary>
+    /// Status query sent until the firmware's status response is decoded.
+    /// </summary>
+    FirmwareRoundTrip,
+
+    /// <summary>
+    /// Duration of one native SendInput call.
+    /// </summary>
+    SendInput,
+
+    /// <summary>
+    /// Emergency stop requested until the held keys and buttons of one device have been released.
+    /// </summary>
+    EmergencyStop
+}
+
+/// <summary>
+/// Latency distribution of one stage.
+/// </summary>
+/// <param name="Stage">The measured stage.</param>
+/// <param name="Count">Number of samples.</param>
+/// <param name="P50">Median latency.</param>
+/// <param name="P99">99th percentile latency.</param>
+/// <param name="Max">Largest latency observed.</param>
+public readonly record struct InputLatencyStageStatistics(InputLatencyStage Stage, long Count, TimeSpan P50, TimeSpan P99, TimeSpan Max);
@@ -17,6 +17,17 @@ public interface IInputSimulator
     /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
     Task SimulateMouseMoveAsync(Point position);
 
+    /// <summary>
+    /// Simulates moving the mouse cursor to the specified position, giving up early once
+    /// <paramref name="cancellationToken"/> is cancelled. Simulators whose moves complete immediately
+    /// need not override this.
+    /// </summary>
+    /// <param name="position">The target position to move the mouse cursor to.</param>
+    /// <param name="cancellationToken">Token of the script or run issuing the move.</param>
+    /// <returns>A task that represents the asynchronous operation.</returns>
+    /// <exception cref="OperationCanceledException">Thrown when the move was cancelled.</exception>
+    Task SimulateMouseMoveAsync(Point position, CancellationToken cancellationToken) => SimulateMouseMoveAsync(position);
+
     /// <summary>
     /// Simulates moving the mouse cursor to the specified position using a lower-level injected method (e.g., SendInput).
     /// This can work better in some games than direct cursor positioning.
@@ -44,6 +55,26 @@ public interface IInputSimulator
     /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
     Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY);
 
+    /// <summary>
+    /// Plays back a run of relative mouse moves, each preceded by its delay.
+    /// Implementations that own a device-side clock may hand the whole run over at once.
+    /// </summary>
+    /// <param name="samples">The samples in playback order.</param>
+    /// <returns>A task that completes once the run has been submitted.</returns>
+    /// <exception cref="ArgumentException">Thrown when a sample is out of valid range.</exception>
+    /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
+    Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples);
+
+    /// <summary>
+    /// Plays back a run of relative mouse moves using low-level input methods (e.g., SendInput),
+    /// each preceded by its delay.
+    /// </summary>
+    /// <param name="samples">The samples in playback order.</param>
+    /// <returns>A task that completes once the run has been submitted.</returns>
+    /// <exception cref="ArgumentException">Thrown when a sample is out of valid range.</exception>
+    /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
+    Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples);
+
     /// <summary>
     /// Simulates a mouse click action using the current cursor position.
     /// </summary>
@@ -103,6 +134,77 @@ public interface IInputSimulator
     /// </summary>
     /// <returns>A task that represents the asynchronous operation. The task result indicates whether the simulator is ready.</returns>
     Task<bool> IsReadyAsync();
+
+    /// <summary>
+    /// Opens an input batch. Until the batch is committed or disposed, input calls made on the same
+    /// asynchronous flow are buffered and submitted together, so combos and text bursts arrive atomically.
+    /// Calls that depend on the cursor (direct moves, position reads) and delays flush the batch first.
+    /// Opening a batch while one is open joins the outer batch.
+    /// </summary>
+    /// <returns>The open batch. Implementations that cannot buffer return <see cref="ImmediateInputBatch.Instance"/>.</returns>
+    IInputBatch BeginBatch();
+
+    /// <summary>
+    /// Emergency release: discards input that has been issued but not delivered yet and releases every key
+    /// and mouse button the simulator still holds down. Unlike the other calls it does not wait behind queued
+    /// input, so it can run while a script is stopping. Safe to call when nothing is held.
+    /// </summary>
+    /// <returns>A task that completes once the releases have been delivered.</returns>
+    /// <exception cref="InputSimulationException">Thrown when the releases could not be delivered.</exception>
+    Task ReleaseAllAsync();
+}
+
+/// <summary>
+/// A group of buffered input events opened by <see cref="IInputSimulator.BeginBatch"/>.
+/// Disposing a batch that has not been committed discards the events still pending.
+/// </summary>
+public interface IInputBatch : IAsyncDisposable
+{
+    /// <summary>
+    /// Gets the number of input events buffered and not yet submitted.
+    /// </summary>
+    int PendingCount { get; }
+
+    /// <summary>
+    /// Submits the buffered events now and keeps the batch open.
+    /// </summary>
+    /// <returns>A task that completes once the events have been submitted.</returns>
+    /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
+    Task FlushAsync();
+
+    /// <summary>
+    /// Submits the buffered events and closes the batch.
+    /// </summary>
+    /// <returns>A task that completes once the events have been submitted.</returns>
+    /// <exception cref="InputSimulationException">Thrown when input simulation fails.</exception>
+    Task CommitAsync();
+}
+
+/// <summary>
+/// Batch for simulators that submit each input as it is made; every call is already its own batch.
+/// </summary>
+public sealed class ImmediateInputBatch : IInputBatch
+{
+    /// <summary>
+    /// Gets the shared instance.
+    /// </summary>
+    public static ImmediateInputBatch Instance { get; } = new();
+
+    private ImmediateInputBatch()
+    {
+    }
+
+    /// <inheritdoc />
+    public int PendingCount => 0;
+
+    /// <inheritdoc />
+    public Task FlushAsync() => Task.CompletedTask;
+
+    /// <inheritdoc />
+    public Task CommitAsync() => Task.CompletedTask;
+
+    /// <inheritdoc />
+    public ValueTask DisposeAsync() => ValueTask.CompletedTask;
 }
 
 /// <summary>
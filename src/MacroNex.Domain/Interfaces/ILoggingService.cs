@@ -150,8 +150,10 @@ public class LogEntry
         Level = level;
         Message = message ?? throw new ArgumentNullException(nameof(message));
         ExceptionDetails = exceptionDetails;
-        Context = context != null ? new Dictionary<string, object>(context).AsReadOnly() : new Dictionary<string, object>().AsReadOnly();
+        Context = context is { Count: > 0 } ? new Dictionary<string, object>(context).AsReadOnly() : EmptyContext;
     }
+
+    private static readonly IReadOnlyDictionary<string, object> EmptyContext = new Dictionary<string, object>().AsReadOnly();
 }
 
 /// <summary>
@@ -0,0 +1,67 @@
+namespace MacroNex.Domain.Interfaces;
+
+/// <summary>
+/// Delay service with roughly millisecond accuracy, for callers that opt in (script sleeps, recorded replay).
+/// The default Task.Delay resolution is the ~15.6 ms system timer tick.
+/// </summary>
+public interface IPrecisionTimer
+{
+    /// <summary>
+    /// Waits for the specified duration, finishing with a short spin so the wake-up lands close to the deadline.
+    /// </summary>
+    /// <param name="duration">The requested delay.</param>
+    /// <param name="cancellationToken">Token to cancel the wait.</param>
+    /// <returns>The requested and achieved durations.</returns>
+    /// <exception cref="ArgumentException">Thrown when duration is negative.</exception>
+    Task<PrecisionDelayResult> DelayAsync(TimeSpan duration, CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Raises the system timer resolution for as long as the returned handle is alive.
+    /// Sessions are reference counted; dispose the handle when the session ends.
+    /// </summary>
+    IDisposable BeginHighResolutionSession();
+
+    /// <summary>
+    /// Gets the number of high-resolution sessions currently open. Components that share the timer but do not
+    /// manage the opt-in themselves use precise delays only while this is non-zero.
+    /// </summary>
+    int ActiveSessionCount { get; }
+
+    /// <summary>
+    /// Gets the achieved-vs-requested error over all delays since the last reset.
+    /// </summary>
+    TimingErrorStatistics GetErrorStatistics();
+
+    /// <summary>
+    /// Clears the accumulated error statistics.
+    /// </summary>
+    void ResetErrorStatistics();
+}
+
+/// <summary>
+/// Outcome of a single precision delay.
+/// </summary>
+/// <param name="Requested">The requested delay.</param>
+/// <param name="Actual">The measured delay.</param>
+public readonly record struct PrecisionDelayResult(TimeSpan Requested, TimeSpan Actual)
+{
+    /// <summary>
+    /// Gets how late (positive) or early (negative) the wake-up was.
+    /// </summary>
+    public TimeSpan Error => Actual - Requested;
+}
+
+/// <summary>
+/// Aggregated achieved-vs-requested delay error.
+/// </summary>
+/// <param name="SampleCount">Number of completed delays.</param>
+/// <param name="MeanAbsoluteError">Mean absolute error.</param>
+/// <param name="MaxError">Largest lateness observed.</param>
+/// <param name="LastError">Error of the most recent delay.</param>
+public readonly record struct TimingErrorStatistics(long SampleCount, TimeSpan MeanAbsoluteError, TimeSpan MaxError, TimeSpan LastError)
+{
+    /// <summary>
+    /// Returns empty statistics.
+    /// </summary>
+    public static TimingErrorStatistics Empty() => new(0, TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero);
+}
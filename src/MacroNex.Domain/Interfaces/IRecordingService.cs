@@ -117,11 +117,37 @@ public class RecordingSession
     public RecordingOptions Options { get; }
 
     /// <summary>
-    /// List of commands recorded in this session.
+    /// Snapshot of the commands recorded in this session, as new command objects.
+    /// Prefer <see cref="CopyCommandBuffer"/> for long recordings.
     /// </summary>
-    public IReadOnlyList<Command> Commands => _commands.AsReadOnly();
+    public IReadOnlyList<Command> Commands
+    {
+        get
+        {
+            lock (_commandsLock)
+            {
+                return (_buffer?.ToCommandList() ?? new List<Command>(_commands)).AsReadOnly();
+            }
+        }
+    }
 
-    private readonly List<Command> _commands;
+    /// <summary>
+    /// Number of commands recorded in this session.
+    /// </summary>
+    public int CommandCount
+    {
+        get
+        {
+            lock (_commandsLock)
+            {
+                return _buffer?.Count ?? _commands.Count;
+            }
+        }
+    }
+
+    private readonly object _commandsLock = new();
+    private CommandBuffer? _buffer = new(); // null once a command the buffer cannot represent was recorded
+    private List<Command> _commands;
 
     /// <summary>
     /// Initializes a new recording session.
@@ -145,7 +171,29 @@ public class RecordingSession
         if (State != RecordingState.Active)
             throw new InvalidOperationException("Cannot add commands to a non-active recording session.");
 
-        _commands.Add(command);
+        lock (_commandsLock)
+        {
+            if (_buffer != null && !_buffer.TryAdd(command))
+            {
+                _commands = _buffer.ToCommandList();
+                _buffer = null;
+            }
+
+            if (_buffer == null)
+                _commands.Add(command);
+        }
+    }
+
+    /// <summary>
+    /// Copies the recorded commands into a new <see cref="CommandBuffer"/>.
+    /// </summary>
+    /// <returns>The copy, or null if the session holds a command type the buffer cannot represent.</returns>
+    public CommandBuffer? CopyCommandBuffer()
+    {
+        lock (_commandsLock)
+        {
+            return _buffer?.Clone();
+        }
     }
 
     /// <summary>
@@ -162,7 +210,12 @@ public class RecordingSession
     /// </summary>
     public void ClearCommands()
     {
-        _commands.Clear();
+        lock (_commandsLock)
+        {
+            _buffer ??= new CommandBuffer();
+            _buffer.Clear();
+            _commands.Clear();
+        }
     }
 }
 
@@ -201,6 +254,18 @@ public class RecordingOptions
     /// </summary>
     public TimeSpan MaximumDelay { get; set; } = TimeSpan.FromSeconds(10);
 
+    /// <summary>
+    /// Whether to simplify mouse paths while recording. Samples closer than <see cref="MinimumDelay"/>
+    /// are coalesced (instead of dropped), and each stroke is reduced to the points that deviate from
+    /// the path by more than <see cref="MousePathTolerance"/>.
+    /// </summary>
+    public bool SimplifyMousePath { get; set; } = false;
+
+    /// <summary>
+    /// Maximum deviation, in pixels, of a mouse sample removed by path simplification.
+    /// </summary>
+    public double MousePathTolerance { get; set; } = 1.0;
+
     /// <summary>
     /// Whether to automatically insert sleep commands for long delays.
     /// </summary>
@@ -1,4 +1,5 @@
 using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
 
 namespace MacroNex.Domain.Interfaces;
 
@@ -14,6 +15,12 @@ public interface IScriptManager
     /// <returns>A task that represents the asynchronous operation. The task result contains all scripts.</returns>
     Task<IEnumerable<Script>> GetAllScriptsAsync();
 
+    /// <summary>
+    /// Gets the metadata of all scripts without loading their bodies, refreshing the library index from storage.
+    /// </summary>
+    /// <returns>A task that represents the asynchronous operation. The task result contains the metadata in library order.</returns>
+    Task<IEnumerable<ScriptMetadata>> GetScriptMetadataAsync();
+
     /// <summary>
     /// Retrieves a specific script by its unique identifier.
     /// </summary>
@@ -31,6 +31,23 @@ public class AppSettings
 
     public ExecutionLimits ExecutionLimits { get; set; } = ExecutionLimits.Default();
 
+    /// <summary>
+    /// Run script sleeps on the precision timer so recorded delays replay within about 1 ms.
+    /// Off by default: the spin finish costs CPU and the raised timer resolution costs power.
+    /// </summary>
+    public bool HighPrecisionTiming { get; set; }
+
+    /// <summary>
+    /// How playback schedules script delays: relative to the previous action, or against a deadline timeline.
+    /// </summary>
+    public ExecutionTimingMode PlaybackTimingMode { get; set; } = ExecutionTimingMode.Relative;
+
+    /// <summary>
+    /// Simplify recorded mouse paths (coalescing plus a 1 px tolerance) to keep recordings compact.
+    /// Off by default so recordings keep every sample unless the user opts in.
+    /// </summary>
+    public bool SimplifyRecordedMousePath { get; set; }
+
     // Recording control hotkeys (global). Defaults: F9 / F11 / F12.
     public HotkeyDefinition? RecordingStartHotkey { get; set; }
     public HotkeyDefinition? RecordingPauseHotkey { get; set; }
@@ -42,6 +59,22 @@ public class AppSettings
     /// </summary>
     public MouseCalibrationData? MouseCalibration { get; set; }
 
+    /// <summary>
+    /// Closed-loop absolute positioning used by the Arduino hardware mode.
+    /// </summary>
+    public ClosedLoopPositioningOptions ClosedLoopPositioning { get; set; } = ClosedLoopPositioningOptions.Default();
+
+    /// <summary>
+    /// Number of Arduino devices auto-connect tries to connect in hardware mode.
+    /// More than one needs the device pool.
+    /// </summary>
+    public int ArduinoDeviceCount { get; set; } = 1;
+
+    /// <summary>
+    /// How commands are routed when several Arduino devices are connected.
+    /// </summary>
+    public ArduinoRoutingOptions ArduinoRouting { get; set; } = ArduinoRoutingOptions.Default();
+
     public static AppSettings Default()
     {
         var s = new AppSettings();
@@ -64,11 +97,55 @@ public class AppSettings
         RecordingStopHotkey ??= HotkeyDefinition.Create("Recording Stop", HotkeyModifiers.None, VirtualKey.VK_F12, HotkeyTriggerMode.Once);
 
         ExecutionLimits ??= ExecutionLimits.Default();
+        ClosedLoopPositioning ??= ClosedLoopPositioningOptions.Default();
+        ArduinoRouting ??= ArduinoRoutingOptions.Default();
+        if (ArduinoDeviceCount < 1) ArduinoDeviceCount = 1;
+        if (!Enum.IsDefined(ArduinoRouting.Mode))
+            ArduinoRouting.Mode = ArduinoRoutingMode.SplitMouseKeyboard;
         if (CountdownSeconds <= 0) CountdownSeconds = 3.0;
         
         // Default to HighLevel if not set
         if (!Enum.IsDefined(typeof(InputMode), GlobalInputMode))
             GlobalInputMode = InputMode.HighLevel;
+        if (!Enum.IsDefined(PlaybackTimingMode))
+            PlaybackTimingMode = ExecutionTimingMode.Relative;
     }
 }
 
+/// <summary>
+/// Options for closed-loop absolute mouse positioning: one calibrated jump, then a bounded number of
+/// corrective relative moves based on the cursor position read back after each move.
+/// </summary>
+public class ClosedLoopPositioningOptions
+{
+    /// <summary>
+    /// Whether absolute moves read back the cursor and correct the residual error.
+    /// When disabled (the default) a single open-loop calibrated move is sent.
+    /// </summary>
+    public bool Enabled { get; set; }
+
+    /// <summary>
+    /// Maximum number of corrective moves after the initial jump.
+    /// </summary>
+    public int MaxCorrections { get; set; } = 3;
+
+    /// <summary>
+    /// Residual error (per axis, in pixels) accepted as on target.
+    /// </summary>
+    public int TolerancePixels { get; set; }
+
+    /// <summary>
+    /// Maximum time to wait for the cursor to settle after each move.
+    /// </summary>
+    public TimeSpan SettleTimeout { get; set; } = TimeSpan.FromMilliseconds(50);
+
+    /// <summary>
+    /// How long the cursor must stay still after moving to be considered settled.
+    /// </summary>
+    public TimeSpan SettleQuietTime { get; set; } = TimeSpan.FromMilliseconds(3);
+
+    /// <summary>
+    /// Creates the default options.
+    /// </summary>
+    public static ClosedLoopPositioningOptions Default() => new();
+}
@@ -1,3 +1,5 @@
+using System.Buffers.Binary;
+
 namespace MacroNex.Domain.ValueObjects;
 
 /// <summary>
@@ -10,11 +12,38 @@ public abstract class ArduinoCommand
     /// </summary>
     public abstract ArduinoCommandType CommandType { get; }
 
+    /// <summary>
+    /// Gets the number of bytes the serialized command data occupies.
+    /// </summary>
+    public abstract int SerializedLength { get; }
+
+    /// <summary>
+    /// Serializes the command data into the destination span without allocating.
+    /// </summary>
+    /// <param name="destination">The span to write to; must hold at least <see cref="SerializedLength"/> bytes.</param>
+    /// <returns>The number of bytes written.</returns>
+    /// <exception cref="ArgumentException">Thrown when the destination is too small.</exception>
+    public abstract int Serialize(Span<byte> destination);
+
     /// <summary>
     /// Serializes the command data to a byte array.
     /// </summary>
     /// <returns>The serialized command data.</returns>
-    public abstract byte[] Serialize();
+    public byte[] Serialize()
+    {
+        var data = new byte[SerializedLength];
+        Serialize(data);
+        return data;
+    }
+
+    /// <summary>
+    /// Throws when the destination cannot hold the serialized command data.
+    /// </summary>
+    protected void EnsureCapacity(Span<byte> destination)
+    {
+        if (destination.Length < SerializedLength)
+            throw new ArgumentException($"Destination must hold at least {SerializedLength} bytes.", nameof(destination));
+    }
 }
 
 /// <summary>
@@ -40,15 +69,14 @@ public sealed class ArduinoMouseMoveAbsoluteCommand : ArduinoCommand
         Y = y;
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => 4;
+
+    public override int Serialize(Span<byte> destination)
     {
-        return new byte[]
-        {
-            (byte)(X & 0xFF),
-            (byte)((X >> 8) & 0xFF),
-            (byte)(Y & 0xFF),
-            (byte)((Y >> 8) & 0xFF)
-        };
+        EnsureCapacity(destination);
+        BinaryPrimitives.WriteInt16LittleEndian(destination, unchecked((short)X));
+        BinaryPrimitives.WriteInt16LittleEndian(destination.Slice(2), unchecked((short)Y));
+        return 4;
     }
 }
 
@@ -75,15 +103,14 @@ public sealed class ArduinoMouseMoveRelativeCommand : ArduinoCommand
         DeltaY = deltaY;
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => 4;
+
+    public override int Serialize(Span<byte> destination)
     {
-        return new byte[]
-        {
-            (byte)(DeltaX & 0xFF),
-            (byte)((DeltaX >> 8) & 0xFF),
-            (byte)(DeltaY & 0xFF),
-            (byte)((DeltaY >> 8) & 0xFF)
-        };
+        EnsureCapacity(destination);
+        BinaryPrimitives.WriteInt16LittleEndian(destination, unchecked((short)DeltaX));
+        BinaryPrimitives.WriteInt16LittleEndian(destination.Slice(2), unchecked((short)DeltaY));
+        return 4;
     }
 }
 
@@ -110,13 +137,14 @@ public sealed class ArduinoMouseClickCommand : ArduinoCommand
         ClickType = clickType;
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => 2;
+
+    public override int Serialize(Span<byte> destination)
     {
-        return new byte[]
-        {
-            (byte)Button,
-            (byte)ClickType
-        };
+        EnsureCapacity(destination);
+        destination[0] = (byte)Button;
+        destination[1] = (byte)ClickType;
+        return 2;
     }
 }
 
@@ -137,9 +165,12 @@ public sealed class ArduinoKeyboardTextCommand : ArduinoCommand
         Text = text ?? throw new ArgumentNullException(nameof(text));
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => System.Text.Encoding.UTF8.GetByteCount(Text);
+
+    public override int Serialize(Span<byte> destination)
     {
-        return System.Text.Encoding.UTF8.GetBytes(Text);
+        EnsureCapacity(destination);
+        return System.Text.Encoding.UTF8.GetBytes(Text, destination);
     }
 }
 
@@ -166,14 +197,14 @@ public sealed class ArduinoKeyPressCommand : ArduinoCommand
         IsDown = isDown;
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => 3;
+
+    public override int Serialize(Span<byte> destination)
     {
-        return new byte[]
-        {
-            (byte)((ushort)Key & 0xFF),
-            (byte)(((ushort)Key >> 8) & 0xFF),
-            (byte)(IsDown ? 1 : 0)
-        };
+        EnsureCapacity(destination);
+        BinaryPrimitives.WriteUInt16LittleEndian(destination, (ushort)Key);
+        destination[2] = (byte)(IsDown ? 1 : 0);
+        return 3;
     }
 }
 
@@ -194,18 +225,184 @@ public sealed class ArduinoDelayCommand : ArduinoCommand
         DurationMs = durationMs;
     }
 
-    public override byte[] Serialize()
+    public override int SerializedLength => 4;
+
+    public override int Serialize(Span<byte> destination)
+    {
+        EnsureCapacity(destination);
+        BinaryPrimitives.WriteUInt32LittleEndian(destination, DurationMs);
+        return 4;
+    }
+}
+
+/// <summary>
+/// Command carrying a packed run of relative mouse moves that the firmware replays on its own clock.
+/// Payload: [SampleCount: varint] then per sample [DeltaX: zigzag varint][DeltaY: zigzag varint][DelayMs: varint].
+/// Small deltas and 1 ms gaps take one byte each, so a 1000 Hz sample costs about 3 bytes instead of an 8-byte frame.
+/// </summary>
+public sealed class ArduinoMouseMotionStreamCommand : ArduinoCommand
+{
+    private readonly MotionSample[] _samples;
+    private readonly int _serializedLength;
+
+    public override ArduinoCommandType CommandType => ArduinoCommandType.MouseMotionStream;
+
+    /// <summary>
+    /// Gets the samples in playback order.
+    /// </summary>
+    public IReadOnlyList<MotionSample> Samples => _samples;
+
+    /// <summary>
+    /// Gets the total playback duration in milliseconds.
+    /// </summary>
+    public long TotalDurationMs { get; }
+
+    public ArduinoMouseMotionStreamCommand(IEnumerable<MotionSample> samples)
+    {
+        if (samples == null)
+            throw new ArgumentNullException(nameof(samples));
+
+        _samples = samples.ToArray();
+        if (_samples.Length == 0)
+            throw new ArgumentException("A motion stream must contain at least one sample.", nameof(samples));
+
+        var length = GetVarUInt32Length((uint)_samples.Length);
+        foreach (var sample in _samples)
+        {
+            if (sample.DelayMs < 0)
+                throw new ArgumentException("Sample delay cannot be negative.", nameof(samples));
+
+            length += GetSampleLength(sample);
+            TotalDurationMs += sample.DelayMs;
+        }
+
+        _serializedLength = length;
+    }
+
+    public override int SerializedLength => _serializedLength;
+
+    public override int Serialize(Span<byte> destination)
+    {
+        EnsureCapacity(destination);
+
+        var offset = WriteVarUInt32(destination, (uint)_samples.Length);
+        foreach (var sample in _samples)
+        {
+            offset += WriteVarUInt32(destination.Slice(offset), ZigZagEncode(sample.DeltaX));
+            offset += WriteVarUInt32(destination.Slice(offset), ZigZagEncode(sample.DeltaY));
+            offset += WriteVarUInt32(destination.Slice(offset), (uint)sample.DelayMs);
+        }
+
+        return offset;
+    }
+
+    /// <summary>
+    /// Gets the number of payload bytes one sample occupies.
+    /// </summary>
+    public static int GetSampleLength(MotionSample sample)
+    {
+        return GetVarUInt32Length(ZigZagEncode(sample.DeltaX))
+            + GetVarUInt32Length(ZigZagEncode(sample.DeltaY))
+            + GetVarUInt32Length((uint)Math.Max(sample.DelayMs, 0));
+    }
+
+    /// <summary>
+    /// Gets the number of bytes the sample-count header occupies for a given count.
+    /// </summary>
+    public static int GetHeaderLength(int sampleCount) => GetVarUInt32Length((uint)sampleCount);
+
+    /// <summary>
+    /// Decodes a motion stream payload (the firmware-side inverse of <see cref="Serialize(Span{byte})"/>).
+    /// </summary>
+    /// <param name="data">The payload bytes.</param>
+    /// <param name="samples">The decoded samples, if successful.</param>
+    /// <returns>True if the payload was well formed.</returns>
+    public static bool TryDeserialize(ReadOnlySpan<byte> data, out IReadOnlyList<MotionSample> samples)
+    {
+        samples = Array.Empty<MotionSample>();
+
+        var offset = 0;
+        if (!TryReadVarUInt32(data, ref offset, out var count) || count > (uint)data.Length)
+            return false;
+
+        var decoded = new MotionSample[count];
+        for (int i = 0; i < decoded.Length; i++)
+        {
+            if (!TryReadVarUInt32(data, ref offset, out var dx) ||
+                !TryReadVarUInt32(data, ref offset, out var dy) ||
+                !TryReadVarUInt32(data, ref offset, out var dt) ||
+                dt > int.MaxValue)
+            {
+                return false;
+            }
+
+            decoded[i] = new MotionSample(ZigZagDecode(dx), ZigZagDecode(dy), (int)dt);
+        }
+
+        if (offset != data.Length)
+            return false;
+
+        samples = decoded;
+        return true;
+    }
+
+    private static uint ZigZagEncode(int value) => (uint)((value << 1) ^ (value >> 31));
+
+    private static int ZigZagDecode(uint value) => (int)(value >> 1) ^ -(int)(value & 1);
+
+    private static int GetVarUInt32Length(uint value)
+    {
+        var length = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            length++;
+        }
+        return length;
+    }
+
+    private static int WriteVarUInt32(Span<byte> destination, uint value)
+    {
+        var offset = 0;
+        while (value >= 0x80)
+        {
+            destination[offset++] = (byte)(value | 0x80);
+            value >>= 7;
+        }
+        destination[offset++] = (byte)value;
+        return offset;
+    }
+
+    private static bool TryReadVarUInt32(ReadOnlySpan<byte> data, ref int offset, out uint value)
     {
-        return new byte[]
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
         {
-            (byte)(DurationMs & 0xFF),
-            (byte)((DurationMs >> 8) & 0xFF),
-            (byte)((DurationMs >> 16) & 0xFF),
-            (byte)((DurationMs >> 24) & 0xFF)
-        };
+            if (offset >= data.Length)
+                return false;
+
+            var b = data[offset++];
+            value |= (uint)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+                return true;
+        }
+        return false;
     }
 }
 
+/// <summary>
+/// Emergency stop command. The firmware releases every key and mouse button it holds and discards the
+/// commands still in its receive buffer and any motion stream being replayed. No payload.
+/// </summary>
+public sealed class ArduinoReleaseAllCommand : ArduinoCommand
+{
+    public override ArduinoCommandType CommandType => ArduinoCommandType.ReleaseAll;
+
+    public override int SerializedLength => 0;
+
+    public override int Serialize(Span<byte> destination) => 0;
+}
+
 /// <summary>
 /// Command to start recording.
 /// </summary>
@@ -213,10 +410,9 @@ public sealed class ArduinoStartRecordingCommand : ArduinoCommand
 {
     public override ArduinoCommandType CommandType => ArduinoCommandType.StartRecording;
 
-    public override byte[] Serialize()
-    {
-        return Array.Empty<byte>();
-    }
+    public override int SerializedLength => 0;
+
+    public override int Serialize(Span<byte> destination) => 0;
 }
 
 /// <summary>
@@ -226,10 +422,9 @@ public sealed class ArduinoStopRecordingCommand : ArduinoCommand
 {
     public override ArduinoCommandType CommandType => ArduinoCommandType.StopRecording;
 
-    public override byte[] Serialize()
-    {
-        return Array.Empty<byte>();
-    }
+    public override int SerializedLength => 0;
+
+    public override int Serialize(Span<byte> destination) => 0;
 }
 
 /// <summary>
@@ -239,8 +434,7 @@ public sealed class ArduinoStatusQueryCommand : ArduinoCommand
 {
     public override ArduinoCommandType CommandType => ArduinoCommandType.StatusQuery;
 
-    public override byte[] Serialize()
-    {
-        return Array.Empty<byte>();
-    }
+    public override int SerializedLength => 0;
+
+    public override int Serialize(Span<byte> destination) => 0;
 }
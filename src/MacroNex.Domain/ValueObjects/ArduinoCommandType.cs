@@ -35,6 +35,16 @@ public enum ArduinoCommandType : byte
     /// </summary>
     Delay = 0x06,
 
+    /// <summary>
+    /// Replay a packed run of relative mouse moves on the firmware clock.
+    /// </summary>
+    MouseMotionStream = 0x07,
+
+    /// <summary>
+    /// Emergency stop: release every key and mouse button and drop any queued firmware-side work.
+    /// </summary>
+    ReleaseAll = 0x08,
+
     /// <summary>
     /// Start recording input.
     /// </summary>
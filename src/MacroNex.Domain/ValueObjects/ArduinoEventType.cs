@@ -21,10 +21,19 @@ public enum ArduinoEventType : byte
     KeyboardInput = 0x03,
 
     /// <summary>
-    /// Status response.
+    /// Status response: [ProtocolVersion: 1 byte][Capabilities: 1 byte], see <see cref="ArduinoFirmwareCapabilities"/>.
+    /// Older firmware sends no payload.
     /// </summary>
     StatusResponse = 0x20,
 
+    /// <summary>
+    /// Flow control report: [BufferCapacity: 2 bytes][BytesProcessed: 4 bytes], little-endian.
+    /// BytesProcessed counts every byte the firmware has taken out of its receive buffer (wrapping), so the
+    /// host knows the free space as capacity minus the bytes it sent that are not processed yet.
+    /// Sent after each status response and whenever the firmware has drained part of its buffer.
+    /// </summary>
+    FlowControl = 0x21,
+
     /// <summary>
     /// Error event.
     /// </summary>
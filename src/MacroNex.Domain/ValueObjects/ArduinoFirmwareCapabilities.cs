@@ -0,0 +1,25 @@
+namespace MacroNex.Domain.ValueObjects;
+
+/// <summary>
+/// Optional protocol features a firmware build reports in its status response.
+/// Firmware that sends an empty status response supports none of them.
+/// </summary>
+[Flags]
+public enum ArduinoFirmwareCapabilities : byte
+{
+    /// <summary>
+    /// Only the base command set.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// Understands <see cref="ArduinoCommandType.MouseMotionStream"/> frames.
+    /// </summary>
+    MotionStream = 0x01,
+
+    /// <summary>
+    /// Understands <see cref="ArduinoCommandType.ReleaseAll"/> frames. Without it an emergency stop releases
+    /// each held key and button with its own command.
+    /// </summary>
+    ReleaseAll = 0x02
+}
@@ -0,0 +1,42 @@
+namespace MacroNex.Domain.ValueObjects;
+
+/// <summary>
+/// Identifies the kind of command in a <see cref="Entities.CommandBuffer"/>. Values are persisted; never renumber.
+/// </summary>
+public enum CommandOpcode : byte
+{
+    /// <summary>
+    /// Not a command; never stored.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// Absolute mouse move to (X, Y).
+    /// </summary>
+    MouseMove = 1,
+
+    /// <summary>
+    /// Relative mouse move by (X, Y).
+    /// </summary>
+    MouseMoveRelative = 2,
+
+    /// <summary>
+    /// Mouse click: X is the <see cref="MouseButton"/>, Y the <see cref="ClickType"/>.
+    /// </summary>
+    MouseClick = 3,
+
+    /// <summary>
+    /// Key press or release: X is the <see cref="VirtualKey"/>, Y is 1 for down and 0 for up.
+    /// </summary>
+    KeyPress = 4,
+
+    /// <summary>
+    /// Text or key combination: X indexes the buffer's keyboard payloads.
+    /// </summary>
+    Keyboard = 5,
+
+    /// <summary>
+    /// Sleep: X and Y hold the low and high halves of the duration in ticks.
+    /// </summary>
+    Sleep = 6
+}
@@ -0,0 +1,12 @@
+namespace MacroNex.Domain.ValueObjects;
+
+/// <summary>
+/// One step of a relative mouse motion run: wait <see cref="DelayMs"/>, then move by (<see cref="DeltaX"/>, <see cref="DeltaY"/>).
+/// </summary>
+public readonly record struct MotionSample(int DeltaX, int DeltaY, int DelayMs)
+{
+    /// <summary>
+    /// Returns a string representation of the sample in format "(DeltaX, DeltaY) after DelayMs ms".
+    /// </summary>
+    public override string ToString() => $"({DeltaX}, {DeltaY}) after {DelayMs} ms";
+}
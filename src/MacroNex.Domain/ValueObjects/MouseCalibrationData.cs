@@ -14,6 +14,27 @@ namespace MacroNex.Domain.ValueObjects;
 /// </remarks>
 public class MouseCalibrationData
 {
+    /// <summary>
+    /// 查找表涵蓋的最大 |Δ|（像素與 HID 相同），超出範圍時回退到即時計算
+    /// </summary>
+    public const int LookupTableRange = 4096;
+
+    /// <summary>
+    /// 線上回饋只採用 |Δ| 不小於此值的移動，避免小位移的量化誤差干擾增益估計
+    /// </summary>
+    public const int MinFeedbackDelta = 32;
+
+    private const double FeedbackSmoothing = 0.5;
+    private const double MinOnlineGain = 0.5;
+    private const double MaxOnlineGain = 2.0;
+
+    // 編譯後的查找表（不序列化）；整體替換以便多執行緒讀取
+    private CalibrationLookupTables? _lookupTables;
+
+    // 閉環定位回饋的增益（實際像素 / 模型預期像素），僅存在於記憶體
+    private double _onlineGainX = 1.0;
+    private double _onlineGainY = 1.0;
+
     /// <summary>
     /// 校準時間
     /// </summary>
@@ -67,6 +88,77 @@ public class MouseCalibrationData
     /// <param name="useYAxis">是否使用 Y 軸數據</param>
     /// <returns>需要發送的 HID delta 值</returns>
     public int CalculateHidDelta(double targetPixelDelta, bool useYAxis = false)
+    {
+        var tables = _lookupTables;
+        if (tables != null)
+        {
+            var table = useYAxis ? tables.HidByPixelY : tables.HidByPixelX;
+            int index = (int)targetPixelDelta;
+            if (index == targetPixelDelta && index >= -LookupTableRange && index <= LookupTableRange)
+                return index < 0 ? -table[-index] : table[index];
+        }
+
+        return ComputeHidDelta(targetPixelDelta, useYAxis, sortedByPixel: null);
+    }
+
+    /// <summary>
+    /// 根據目前的校準點與擬合結果建立每軸的查找表（像素 → HID 及 HID → 像素），
+    /// 之後 <see cref="CalculateHidDelta"/> 與 <see cref="CalculatePixelDelta"/> 在範圍內只需查表。
+    /// 校準點或擬合參數變更後需重新呼叫。
+    /// </summary>
+    public void BuildLookupTables()
+    {
+        var sortedX = SortByPixel(PointsX);
+        var sortedY = SortByPixel(PointsY);
+
+        var tables = new CalibrationLookupTables(LookupTableRange + 1);
+        for (int delta = 0; delta <= LookupTableRange; delta++)
+        {
+            tables.HidByPixelX[delta] = ComputeHidDelta(delta, useYAxis: false, sortedX);
+            tables.HidByPixelY[delta] = ComputeHidDelta(delta, useYAxis: true, sortedY);
+            tables.PixelByHidX[delta] = ComputePixelDelta(delta, useYAxis: false);
+            tables.PixelByHidY[delta] = ComputePixelDelta(delta, useYAxis: true);
+        }
+
+        _lookupTables = tables;
+    }
+
+    /// <summary>
+    /// 捨棄已建立的查找表，之後的轉換改回即時計算
+    /// </summary>
+    public void InvalidateLookupTables() => _lookupTables = null;
+
+    /// <summary>
+    /// 是否已建立查找表
+    /// </summary>
+    public bool HasLookupTables => _lookupTables != null;
+
+    /// <summary>
+    /// 取得閉環定位學到的增益（實際像素 / 模型預期像素），1.0 表示模型準確
+    /// </summary>
+    public double GetOnlineGain(bool useYAxis = false) => useYAxis ? Volatile.Read(ref _onlineGainY) : Volatile.Read(ref _onlineGainX);
+
+    /// <summary>
+    /// 記錄一次實際移動結果，以指數移動平均更新該軸的線上增益。
+    /// </summary>
+    /// <param name="modelPixelDelta">換算 HID delta 時使用的像素量</param>
+    /// <param name="actualPixelDelta">游標實際移動的像素量</param>
+    /// <param name="useYAxis">是否為 Y 軸</param>
+    public void RecordPositioningFeedback(int modelPixelDelta, int actualPixelDelta, bool useYAxis = false)
+    {
+        if (Math.Abs(modelPixelDelta) < MinFeedbackDelta || Math.Sign(modelPixelDelta) != Math.Sign(actualPixelDelta))
+            return;
+
+        double ratio = Math.Clamp((double)actualPixelDelta / modelPixelDelta, MinOnlineGain, MaxOnlineGain);
+        double current = GetOnlineGain(useYAxis);
+        double updated = current + FeedbackSmoothing * (ratio - current);
+        if (useYAxis)
+            Volatile.Write(ref _onlineGainY, updated);
+        else
+            Volatile.Write(ref _onlineGainX, updated);
+    }
+
+    private int ComputeHidDelta(double targetPixelDelta, bool useYAxis, List<CalibrationPoint>? sortedByPixel)
     {
         var coefficients = useYAxis ? PolynomialCoefficientsY : PolynomialCoefficientsX;
         var points = useYAxis ? PointsY : PointsX;
@@ -94,13 +186,13 @@ public class MouseCalibrationData
             if (hidDelta < 0 || hidDelta >= 10000)
             {
                 // 多項式結果不合理，fallback
-                hidDelta = CalculateHidDeltaByInterpolationInternal(absTarget, points);
+                hidDelta = CalculateHidDeltaByInterpolationInternal(absTarget, sortedByPixel ?? SortByPixel(points));
             }
         }
         else
         {
             // Fallback: 使用查表插值
-            hidDelta = CalculateHidDeltaByInterpolationInternal(absTarget, points);
+            hidDelta = CalculateHidDeltaByInterpolationInternal(absTarget, sortedByPixel ?? SortByPixel(points));
         }
 
         int result = (int)Math.Round(hidDelta);
@@ -188,14 +280,16 @@ public class MouseCalibrationData
         return absHid * gain;
     }
 
-    private double CalculateHidDeltaByInterpolationInternal(double absTarget, List<CalibrationPoint> points)
-    {
-        // 排序確保點按 ActualPixelDelta 升序排列
-        var sortedPoints = points
-            .Where(p => p.ActualPixelDelta >= 0)
-            .OrderBy(p => p.ActualPixelDelta)
-            .ToList();
+    /// <summary>
+    /// 排序確保點按 ActualPixelDelta 升序排列
+    /// </summary>
+    private static List<CalibrationPoint> SortByPixel(List<CalibrationPoint> points) => points
+        .Where(p => p.ActualPixelDelta >= 0)
+        .OrderBy(p => p.ActualPixelDelta)
+        .ToList();
 
+    private double CalculateHidDeltaByInterpolationInternal(double absTarget, List<CalibrationPoint> sortedPoints)
+    {
         if (sortedPoints.Count == 0)
             return absTarget;
 
@@ -293,6 +387,9 @@ public class MouseCalibrationData
         // 同時擬合多項式作為備用
         PolynomialCoefficientsX = FitPolynomialForAxis(PointsX, degree);
         PolynomialCoefficientsY = FitPolynomialForAxis(PointsY, degree);
+
+        // 擬合完成後編譯查找表，避免每次移動重新計算
+        BuildLookupTables();
     }
 
     /// <summary>
@@ -493,6 +590,18 @@ public class MouseCalibrationData
     /// <param name="useYAxis">是否使用 Y 軸數據</param>
     /// <returns>預期的像素移動量</returns>
     public double CalculatePixelDelta(int hidDelta, bool useYAxis = false)
+    {
+        var tables = _lookupTables;
+        if (tables != null && hidDelta >= -LookupTableRange && hidDelta <= LookupTableRange)
+        {
+            var table = useYAxis ? tables.PixelByHidY : tables.PixelByHidX;
+            return hidDelta < 0 ? -table[-hidDelta] : table[hidDelta];
+        }
+
+        return ComputePixelDelta(hidDelta, useYAxis);
+    }
+
+    private double ComputePixelDelta(int hidDelta, bool useYAxis)
     {
         var points = useYAxis ? PointsY : PointsX;
         
@@ -568,6 +677,40 @@ public class MouseCalibrationData
     }
 }
 
+/// <summary>
+/// 一次閉環絕對定位的結果
+/// </summary>
+/// <param name="Corrections">首次跳躍之後的修正移動次數</param>
+/// <param name="ResidualX">結束時 X 軸剩餘誤差（目標 - 實際）</param>
+/// <param name="ResidualY">結束時 Y 軸剩餘誤差（目標 - 實際）</param>
+/// <param name="Elapsed">定位耗時</param>
+public sealed record MousePositioningResult(int Corrections, int ResidualX, int ResidualY, TimeSpan Elapsed)
+{
+    /// <summary>
+    /// 是否已到達目標
+    /// </summary>
+    public bool ReachedTarget => ResidualX == 0 && ResidualY == 0;
+}
+
+/// <summary>
+/// 每軸的預先計算轉換表，索引為 |Δ|
+/// </summary>
+internal sealed class CalibrationLookupTables
+{
+    public CalibrationLookupTables(int length)
+    {
+        HidByPixelX = new int[length];
+        HidByPixelY = new int[length];
+        PixelByHidX = new double[length];
+        PixelByHidY = new double[length];
+    }
+
+    public int[] HidByPixelX { get; }
+    public int[] HidByPixelY { get; }
+    public double[] PixelByHidX { get; }
+    public double[] PixelByHidY { get; }
+}
+
 /// <summary>
 /// 單個校準點，記錄 HID Delta 和對應的實際像素移動量
 /// </summary>
@@ -0,0 +1,24 @@
+namespace MacroNex.Domain.ValueObjects;
+
+/// <summary>
+/// Lightweight description of a stored script, available without loading its source or commands.
+/// </summary>
+/// <param name="Id">The script identifier.</param>
+/// <param name="Name">The display name.</param>
+/// <param name="CreatedAt">When the script was created.</param>
+/// <param name="ModifiedAt">When the script was last modified.</param>
+/// <param name="TriggerHotkey">The trigger hotkey, if any.</param>
+/// <param name="SourceTextLength">Length of the Lua source in characters.</param>
+public sealed record ScriptMetadata(
+    Guid Id,
+    string Name,
+    DateTime CreatedAt,
+    DateTime ModifiedAt,
+    HotkeyDefinition? TriggerHotkey,
+    int SourceTextLength)
+{
+    /// <summary>
+    /// Returns the script name.
+    /// </summary>
+    public override string ToString() => Name;
+}
@@ -0,0 +1,676 @@
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using Microsoft.Extensions.Logging;
+
+namespace MacroNex.Infrastructure.Adapters;
+
+/// <summary>
+/// Pool of Arduino Leonardo devices behind a single <see cref="IArduinoService"/>.
+/// Every device is its own <see cref="IArduinoService"/> (normally an <see cref="ArduinoSerialService"/>) with its
+/// own serial link, read loop, write queue and heartbeat, so total HID throughput grows with the number of boards.
+/// Sends are routed one at a time in call order; see <see cref="ArduinoRoutingOptions"/> for the rules.
+/// </summary>
+public sealed class ArduinoDevicePool : IArduinoDevicePool, IDisposable
+{
+    private readonly Func<IArduinoService> _deviceFactory;
+    private readonly ILogger<ArduinoDevicePool> _logger;
+    private readonly object _lockObject = new();
+    private readonly List<Device> _devices = new();
+    private readonly SemaphoreSlim _sendGate = new(1, 1);
+    private ArduinoRoutingOptions _routing = ArduinoRoutingOptions.Default();
+    private ArduinoConnectionState _aggregateState = ArduinoConnectionState.Disconnected;
+    private IArduinoService? _portProbe;
+    private bool _isDisposed;
+
+    // Routing state, guarded by _sendGate
+    private readonly List<Device> _unflushed = new(); // devices written since the last ordering barrier
+    private bool _unflushedAreMotion = true;        // whether everything written since then commutes
+    private Device? _lastTarget;
+    private int _roundRobinNext;
+
+    /// <summary>
+    /// Creates a pool whose devices are created on demand by <paramref name="deviceFactory"/>.
+    /// </summary>
+    /// <param name="deviceFactory">Creates one unconnected device; called once per <see cref="ConnectAsync"/>.</param>
+    /// <param name="logger">The logger.</param>
+    public ArduinoDevicePool(Func<IArduinoService> deviceFactory, ILogger<ArduinoDevicePool> logger)
+    {
+        _deviceFactory = deviceFactory ?? throw new ArgumentNullException(nameof(deviceFactory));
+        _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+    }
+
+    public ArduinoRoutingOptions Routing
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _routing;
+            }
+        }
+        set
+        {
+            ArgumentNullException.ThrowIfNull(value);
+            lock (_lockObject)
+            {
+                _routing = value;
+            }
+        }
+    }
+
+    public ArduinoConnectionState ConnectionState
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _aggregateState;
+            }
+        }
+    }
+
+    public bool IsConnected => GetConnectedDevices().Count > 0;
+
+    public string? ConnectedPortName
+    {
+        get
+        {
+            var connected = GetConnectedDevices();
+            return connected.Count > 0 ? connected[0].PortName : null;
+        }
+    }
+
+    /// <summary>
+    /// Gets the features every connected device reported, since a command may be routed to any of them.
+    /// </summary>
+    public ArduinoFirmwareCapabilities Capabilities
+    {
+        get
+        {
+            var connected = GetConnectedDevices();
+            if (connected.Count == 0)
+                return ArduinoFirmwareCapabilities.None;
+
+            var capabilities = connected[0].Service.Capabilities;
+            for (var i = 1; i < connected.Count; i++)
+            {
+                capabilities &= connected[i].Service.Capabilities;
+            }
+            return capabilities;
+        }
+    }
+
+    public IReadOnlyList<string> ConnectedPortNames => GetConnectedDevices().Select(d => d.PortName).ToList();
+
+    public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
+    public event EventHandler<ArduinoConnectionStateChangedEventArgs>? DeviceStateChanged;
+    public event EventHandler<ArduinoEventReceivedEventArgs>? EventReceived;
+    public event EventHandler<ArduinoErrorEventArgs>? ErrorOccurred;
+
+    public Task<IReadOnlyList<string>> GetAvailablePortsAsync()
+    {
+        ThrowIfDisposed();
+
+        IArduinoService probe;
+        lock (_lockObject)
+        {
+            probe = _portProbe ??= _deviceFactory();
+        }
+
+        return probe.GetAvailablePortsAsync();
+    }
+
+    public async Task ConnectAsync(string portName)
+    {
+        if (string.IsNullOrWhiteSpace(portName))
+            throw new ArgumentException("Port name cannot be null or empty.", nameof(portName));
+
+        ThrowIfDisposed();
+
+        Device? stale;
+        Device device;
+        lock (_lockObject)
+        {
+            stale = FindDevice(portName);
+            if (stale != null)
+            {
+                var state = stale.Service.ConnectionState;
+                if (state == ArduinoConnectionState.Connected || state == ArduinoConnectionState.Connecting)
+                    throw new InvalidOperationException($"Port {portName} is already connected or connecting. Current state: {state}");
+            }
+
+            device = new Device(_deviceFactory(), portName);
+        }
+
+        // A device that dropped out on this port is replaced by the new connection
+        if (stale != null)
+            await RemoveDeviceAsync(stale).ConfigureAwait(false);
+
+        Attach(device);
+        lock (_lockObject)
+        {
+            _devices.Add(device);
+        }
+
+        try
+        {
+            await device.Service.ConnectAsync(portName).ConfigureAwait(false);
+        }
+        catch
+        {
+            await RemoveDeviceAsync(device).ConfigureAwait(false);
+            throw;
+        }
+
+        _logger.LogInformation("Arduino on port {PortName} joined the device pool ({DeviceCount} connected)",
+            portName, GetConnectedDevices().Count);
+    }
+
+    public async Task DisconnectAsync()
+    {
+        ThrowIfDisposed();
+
+        List<Device> devices;
+        lock (_lockObject)
+        {
+            devices = _devices.ToList();
+        }
+
+        foreach (var device in devices)
+        {
+            await RemoveDeviceAsync(device).ConfigureAwait(false);
+        }
+    }
+
+    public async Task DisconnectAsync(string portName)
+    {
+        if (string.IsNullOrWhiteSpace(portName))
+            throw new ArgumentException("Port name cannot be null or empty.", nameof(portName));
+
+        ThrowIfDisposed();
+
+        Device? device;
+        lock (_lockObject)
+        {
+            device = FindDevice(portName);
+        }
+
+        if (device != null)
+            await RemoveDeviceAsync(device).ConfigureAwait(false);
+    }
+
+    public async Task SendCommandAsync(ArduinoCommand command)
+    {
+        if (command == null)
+            throw new ArgumentNullException(nameof(command));
+
+        ThrowIfDisposed();
+
+        await _sendGate.WaitAsync().ConfigureAwait(false);
+        try
+        {
+            var connected = GetConnectedDevicesOrThrow();
+            var routing = Routing;
+            var target = Route(command, connected, routing);
+
+            await BeforeSendAsync(target, IsCommutative(command), routing).ConfigureAwait(false);
+            await target.Service.SendCommandAsync(command).ConfigureAwait(false);
+            Interlocked.Increment(ref target.CommandsSent);
+            _lastTarget = target;
+        }
+        finally
+        {
+            _sendGate.Release();
+        }
+    }
+
+    public async Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands)
+    {
+        if (commands == null)
+            throw new ArgumentNullException(nameof(commands));
+        if (commands.Any(c => c == null))
+            throw new ArgumentException("Commands cannot contain null entries.", nameof(commands));
+
+        ThrowIfDisposed();
+
+        if (commands.Count == 0)
+            return;
+
+        await _sendGate.WaitAsync().ConfigureAwait(false);
+        try
+        {
+            var connected = GetConnectedDevicesOrThrow();
+            var routing = Routing;
+
+            if (routing.Mode != ArduinoRoutingMode.SplitMouseKeyboard || connected.Count == 1)
+            {
+                // The batch stays one contiguous write on one device
+                var target = Route(commands[0], connected, routing);
+                await SendRunAsync(target, commands, routing).ConfigureAwait(false);
+                return;
+            }
+
+            // Split the batch into runs of consecutive commands for the same device; each run stays contiguous
+            var start = 0;
+            var runTarget = Route(commands[0], connected, routing);
+            for (var i = 1; i <= commands.Count; i++)
+            {
+                Device? next = null;
+                if (i < commands.Count)
+                {
+                    _lastTarget = runTarget;
+                    next = Route(commands[i], connected, routing);
+                    if (ReferenceEquals(next, runTarget))
+                        continue;
+                }
+
+                var run = start == 0 && i == commands.Count ? commands : Slice(commands, start, i - start);
+                await SendRunAsync(runTarget, run, routing).ConfigureAwait(false);
+                start = i;
+                runTarget = next!;
+            }
+        }
+        finally
+        {
+            _sendGate.Release();
+        }
+    }
+
+    public async Task FlushAsync()
+    {
+        ThrowIfDisposed();
+
+        var flushes = GetConnectedDevices().Select(d => d.Service.FlushAsync()).ToList();
+        if (flushes.Count > 0)
+            await Task.WhenAll(flushes).ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Stops every connected device at once. Does not take the send gate, so it can overtake a send that is
+    /// waiting for room in a device queue.
+    /// </summary>
+    public async Task EmergencyStopAsync()
+    {
+        ThrowIfDisposed();
+
+        var stops = GetConnectedDevices().Select(d => d.Service.EmergencyStopAsync()).ToList();
+        if (stops.Count > 0)
+            await Task.WhenAll(stops).ConfigureAwait(false);
+    }
+
+    public ArduinoPoolHealth GetHealth()
+    {
+        List<Device> devices;
+        lock (_lockObject)
+        {
+            devices = _devices.ToList();
+        }
+
+        var roles = GetRoles(devices.Where(d => d.Service.IsConnected).ToList(), Routing);
+        var health = new List<ArduinoDeviceHealth>(devices.Count);
+        var primarySeen = false;
+        foreach (var device in devices)
+        {
+            var state = device.Service.IsConnected ? ArduinoConnectionState.Connected : device.Service.ConnectionState;
+            var isPrimary = !primarySeen && state == ArduinoConnectionState.Connected;
+            primarySeen |= isPrimary;
+
+            string? lastError;
+            DateTime? lastErrorTime;
+            lock (device)
+            {
+                lastError = device.LastError;
+                lastErrorTime = device.LastErrorTime;
+            }
+
+            health.Add(new ArduinoDeviceHealth(
+                device.PortName, state, isPrimary, Interlocked.Read(ref device.CommandsSent), lastError, lastErrorTime,
+                roles.GetValueOrDefault(device)));
+        }
+
+        var connectedCount = health.Count(h => h.State == ArduinoConnectionState.Connected);
+        return new ArduinoPoolHealth(ComputeAggregateState(devices), connectedCount, health);
+    }
+
+    private async Task SendRunAsync(Device target, IReadOnlyList<ArduinoCommand> run, ArduinoRoutingOptions routing)
+    {
+        var commutative = true;
+        for (var i = 0; i < run.Count && commutative; i++)
+        {
+            commutative = IsCommutative(run[i]);
+        }
+
+        await BeforeSendAsync(target, commutative, routing).ConfigureAwait(false);
+        await target.Service.SendCommandsAsync(run).ConfigureAwait(false);
+        Interlocked.Add(ref target.CommandsSent, run.Count);
+        _lastTarget = target;
+    }
+
+    /// <summary>
+    /// Ordering barrier: before writing to <paramref name="target"/>, waits until the other devices written
+    /// since the last barrier have flushed, unless both those writes and this one are commuting mouse moves.
+    /// The flush covers the serial write only; the firmware of those devices may still be running the commands.
+    /// A single device keeps order by itself through its send queue.
+    /// </summary>
+    private async Task BeforeSendAsync(Device target, bool commutative, ArduinoRoutingOptions routing)
+    {
+        if (!routing.PreserveOrderAcrossDevices)
+            return;
+
+        if (commutative && _unflushedAreMotion)
+        {
+            if (!_unflushed.Contains(target))
+                _unflushed.Add(target);
+            return;
+        }
+
+        foreach (var device in _unflushed)
+        {
+            if (ReferenceEquals(device, target))
+                continue;
+
+            try
+            {
+                await device.Service.FlushAsync().ConfigureAwait(false);
+            }
+            catch (Exception ex)
+            {
+                // The failing device has reported the error itself; it must not block the others
+                _logger.LogWarning(ex, "Failed to flush Arduino on port {PortName} before switching devices", device.PortName);
+            }
+        }
+
+        _unflushed.Clear();
+        _unflushed.Add(target);
+        _unflushedAreMotion = commutative;
+    }
+
+    private Device Route(ArduinoCommand command, IReadOnlyList<Device> connected, ArduinoRoutingOptions routing)
+    {
+        if (connected.Count == 1)
+            return connected[0];
+
+        // Control commands stay with the stream they belong to
+        var lastTarget = _lastTarget != null && connected.Contains(_lastTarget) ? _lastTarget : connected[0];
+
+        switch (routing.Mode)
+        {
+            case ArduinoRoutingMode.SplitMouseKeyboard:
+                switch (command.CommandType)
+                {
+                    case ArduinoCommandType.MouseMoveAbsolute:
+                    case ArduinoCommandType.MouseMoveRelative:
+                    case ArduinoCommandType.MouseClick:
+                    case ArduinoCommandType.MouseMotionStream:
+                        return GetMouseDevice(connected, routing);
+                    case ArduinoCommandType.KeyboardText:
+                    case ArduinoCommandType.KeyPress:
+                        return GetKeyboardDevice(connected, routing);
+                    case ArduinoCommandType.Delay:
+                        return lastTarget;
+                    default:
+                        return connected[0];
+                }
+
+            case ArduinoRoutingMode.RoundRobin:
+                if (command.CommandType == ArduinoCommandType.Delay)
+                    return lastTarget;
+
+                var index = (int)((uint)_roundRobinNext % (uint)connected.Count);
+                _roundRobinNext++;
+                return connected[index];
+
+            default:
+                return connected[0];
+        }
+    }
+
+    private static Dictionary<Device, ArduinoDeviceRoles> GetRoles(IReadOnlyList<Device> connected, ArduinoRoutingOptions routing)
+    {
+        var roles = new Dictionary<Device, ArduinoDeviceRoles>();
+        if (connected.Count == 0)
+            return roles;
+
+        const ArduinoDeviceRoles all = ArduinoDeviceRoles.Mouse | ArduinoDeviceRoles.Keyboard;
+        switch (routing.Mode)
+        {
+            case ArduinoRoutingMode.SplitMouseKeyboard:
+                var mouse = GetMouseDevice(connected, routing);
+                var keyboard = GetKeyboardDevice(connected, routing);
+                roles[mouse] = ArduinoDeviceRoles.Mouse;
+                roles[keyboard] = roles.GetValueOrDefault(keyboard) | ArduinoDeviceRoles.Keyboard;
+                break;
+
+            case ArduinoRoutingMode.RoundRobin:
+                foreach (var device in connected)
+                    roles[device] = all;
+                break;
+
+            default:
+                roles[connected[0]] = all;
+                break;
+        }
+
+        return roles;
+    }
+
+    private static Device GetMouseDevice(IReadOnlyList<Device> connected, ArduinoRoutingOptions routing)
+    {
+        return FindDevice(connected, routing.MousePortName)
+            ?? connected.FirstOrDefault(d => !IsPort(d, routing.KeyboardPortName))
+            ?? connected[0];
+    }
+
+    private static Device GetKeyboardDevice(IReadOnlyList<Device> connected, ArduinoRoutingOptions routing)
+    {
+        var mouse = GetMouseDevice(connected, routing);
+        return FindDevice(connected, routing.KeyboardPortName)
+            ?? connected.FirstOrDefault(d => !ReferenceEquals(d, mouse))
+            ?? mouse;
+    }
+
+    /// <summary>
+    /// Relative mouse moves add up to the same cursor position in any order, so they may run on several
+    /// devices at once.
+    /// </summary>
+    private static bool IsCommutative(ArduinoCommand command) =>
+        command.CommandType == ArduinoCommandType.MouseMoveRelative ||
+        command.CommandType == ArduinoCommandType.MouseMotionStream;
+
+    private static IReadOnlyList<ArduinoCommand> Slice(IReadOnlyList<ArduinoCommand> commands, int start, int count)
+    {
+        var slice = new ArduinoCommand[count];
+        for (var i = 0; i < count; i++)
+        {
+            slice[i] = commands[start + i];
+        }
+        return slice;
+    }
+
+    private List<Device> GetConnectedDevices()
+    {
+        List<Device> devices;
+        lock (_lockObject)
+        {
+            devices = _devices.ToList();
+        }
+
+        devices.RemoveAll(d => !d.Service.IsConnected);
+        return devices;
+    }
+
+    private List<Device> GetConnectedDevicesOrThrow()
+    {
+        var connected = GetConnectedDevices();
+        if (connected.Count == 0)
+            throw new InvalidOperationException("Arduino is not connected.");
+        return connected;
+    }
+
+    private Device? FindDevice(string portName) => FindDevice(_devices, portName);
+
+    private static Device? FindDevice(IReadOnlyList<Device> devices, string? portName)
+    {
+        if (portName == null)
+            return null;
+
+        foreach (var device in devices)
+        {
+            if (IsPort(device, portName))
+                return device;
+        }
+
+        return null;
+    }
+
+    private static bool IsPort(Device device, string? portName) =>
+        portName != null && string.Equals(device.PortName, portName, StringComparison.OrdinalIgnoreCase);
+
+    private async Task RemoveDeviceAsync(Device device)
+    {
+        try
+        {
+            await device.Service.DisconnectAsync().ConfigureAwait(false);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "Error disconnecting Arduino on port {PortName}", device.PortName);
+        }
+
+        Detach(device);
+        lock (_lockObject)
+        {
+            _devices.Remove(device);
+        }
+
+        (device.Service as IDisposable)?.Dispose();
+        UpdateAggregateState(device.PortName);
+    }
+
+    private void Attach(Device device)
+    {
+        device.StateChangedHandler = (_, e) => OnDeviceStateChanged(device, e);
+        device.EventReceivedHandler = (_, e) => EventReceived?.Invoke(this, e);
+        device.ErrorHandler = (_, e) => OnDeviceError(device, e);
+
+        device.Service.ConnectionStateChanged += device.StateChangedHandler;
+        device.Service.EventReceived += device.EventReceivedHandler;
+        device.Service.ErrorOccurred += device.ErrorHandler;
+    }
+
+    private static void Detach(Device device)
+    {
+        device.Service.ConnectionStateChanged -= device.StateChangedHandler;
+        device.Service.EventReceived -= device.EventReceivedHandler;
+        device.Service.ErrorOccurred -= device.ErrorHandler;
+    }
+
+    private void OnDeviceStateChanged(Device device, ArduinoConnectionStateChangedEventArgs e)
+    {
+        DeviceStateChanged?.Invoke(this, new ArduinoConnectionStateChangedEventArgs(e.PreviousState, e.NewState, device.PortName));
+        UpdateAggregateState(device.PortName);
+    }
+
+    private void OnDeviceError(Device device, ArduinoErrorEventArgs e)
+    {
+        lock (device)
+        {
+            device.LastError = e.Message;
+            device.LastErrorTime = DateTime.UtcNow;
+        }
+
+        ErrorOccurred?.Invoke(this, e);
+    }
+
+    private void UpdateAggregateState(string portName)
+    {
+        ArduinoConnectionState previous;
+        ArduinoConnectionState current;
+        lock (_lockObject)
+        {
+            previous = _aggregateState;
+            current = ComputeAggregateState(_devices);
+            _aggregateState = current;
+        }
+
+        if (previous != current)
+            ConnectionStateChanged?.Invoke(this, new ArduinoConnectionStateChangedEventArgs(previous, current, ConnectedPortName ?? portName));
+    }
+
+    /// <summary>
+    /// Connected while any device is connected; otherwise the most hopeful state among the devices.
+    /// </summary>
+    private static ArduinoConnectionState ComputeAggregateState(IEnumerable<Device> devices)
+    {
+        var aggregate = ArduinoConnectionState.Disconnected;
+        foreach (var device in devices)
+        {
+            switch (device.Service.ConnectionState)
+            {
+                case ArduinoConnectionState.Connected:
+                    return ArduinoConnectionState.Connected;
+                case ArduinoConnectionState.Connecting:
+                    aggregate = ArduinoConnectionState.Connecting;
+                    break;
+                case ArduinoConnectionState.Error when aggregate == ArduinoConnectionState.Disconnected:
+                    aggregate = ArduinoConnectionState.Error;
+                    break;
+            }
+        }
+
+        return aggregate;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (_isDisposed)
+            throw new ObjectDisposedException(nameof(ArduinoDevicePool));
+    }
+
+    public void Dispose()
+    {
+        if (_isDisposed)
+            return;
+
+        try
+        {
+            DisconnectAsync().GetAwaiter().GetResult();
+        }
+        catch
+        {
+            // Ignore errors during disposal
+        }
+
+        _isDisposed = true;
+        (_portProbe as IDisposable)?.Dispose();
+        _sendGate.Dispose();
+    }
+
+    /// <summary>
+    /// One device of the pool and its bookkeeping.
+    /// </summary>
+    private sealed class Device
+    {
+        public Device(IArduinoService service, string portName)
+        {
+            Service = service ?? throw new InvalidOperationException("The Arduino device factory returned null.");
+            PortName = portName;
+        }
+
+        public IArduinoService Service { get; }
+
+        public string PortName { get; }
+
+        public long CommandsSent;
+
+        public string? LastError { get; set; }
+
+        public DateTime? LastErrorTime { get; set; }
+
+        public EventHandler<ArduinoConnectionStateChangedEventArgs>? StateChangedHandler { get; set; }
+
+        public EventHandler<ArduinoEventReceivedEventArgs>? EventReceivedHandler { get; set; }
+
+        public EventHandler<ArduinoErrorEventArgs>? ErrorHandler { get; set; }
+    }
+}
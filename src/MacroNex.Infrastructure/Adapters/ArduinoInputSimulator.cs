@@ -1,5 +1,6 @@
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
 using MacroNex.Infrastructure.Win32;
 using Microsoft.Extensions.Logging;
 using static MacroNex.Infrastructure.Win32.Win32Api;
@@ -18,10 +19,12 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
     private readonly ILogger<ArduinoInputSimulator> _logger;
     private bool _isDisposed;
     
-    // Cached calibration data to avoid loading settings on every move
+    // Cached calibration data (with compiled lookup tables) to avoid loading settings on every move
     private MouseCalibrationData? _calibrationData;
+    private ClosedLoopPositioningOptions _positioningOptions = ClosedLoopPositioningOptions.Default();
     private DateTime _calibrationLoadedAt;
     private static readonly TimeSpan CalibrationCacheExpiry = TimeSpan.FromMinutes(5);
+    private static readonly TimeSpan SettlePollInterval = TimeSpan.FromMilliseconds(1);
 
     public ArduinoInputSimulator(
         IArduinoService arduinoService, 
@@ -33,7 +36,17 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
     }
 
-    public async Task SimulateMouseMoveAsync(Point position)
+    /// <summary>
+    /// Gets the outcome of the most recent closed-loop absolute move, if any.
+    /// </summary>
+    public MousePositioningResult? LastPositioningResult { get; private set; }
+
+    public Task SimulateMouseMoveAsync(Point position)
+    {
+        return SimulateMouseMoveAsync(position, CancellationToken.None);
+    }
+
+    public async Task SimulateMouseMoveAsync(Point position, CancellationToken cancellationToken)
     {
         ThrowIfDisposed();
         ValidatePosition(position);
@@ -45,6 +58,9 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
 
         try
         {
+            // Relative moves may still be queued; they must reach the device before the cursor is sampled
+            await _arduinoService.FlushAsync();
+
             // Get current cursor position using Win32 API
             var currentPosition = await GetCursorPositionInternalAsync();
             
@@ -64,6 +80,13 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
             
             // Load calibration data and calculate HID deltas
             await RefreshCalibrationDataAsync();
+            var positioningOptions = _positioningOptions;
+            if (positioningOptions.Enabled)
+            {
+                await MoveClosedLoopAsync(currentPosition, position, positioningOptions, cancellationToken);
+                return;
+            }
+
             int hidDeltaX = CalculateHidDelta(targetDeltaX, useYAxis: false);
             int hidDeltaY = CalculateHidDelta(targetDeltaY, useYAxis: true);
             
@@ -73,6 +96,10 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
             var command = new ArduinoMouseMoveRelativeCommand(hidDeltaX, hidDeltaY);
             await _arduinoService.SendCommandAsync(command);
         }
+        catch (OperationCanceledException)
+        {
+            throw;
+        }
         catch (Exception ex)
         {
             _logger.LogError(ex, "Failed to simulate mouse move to {Position} via Arduino", position);
@@ -121,6 +148,74 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         await SimulateMouseMoveRelativeAsync(deltaX, deltaY);
     }
 
+    public async Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples)
+    {
+        ThrowIfDisposed();
+        if (samples == null)
+            throw new ArgumentNullException(nameof(samples));
+        foreach (var sample in samples)
+        {
+            ValidateDelta(sample.DeltaX, sample.DeltaY);
+            if (sample.DelayMs < 0)
+                throw new ArgumentException("Sample delay cannot be negative.", nameof(samples));
+        }
+
+        if (samples.Count == 0)
+            return;
+
+        if (!_arduinoService.IsConnected)
+            throw new InvalidOperationException("Arduino is not connected.");
+
+        _logger.LogDebug("Simulating motion stream of {Count} samples via Arduino", samples.Count);
+
+        try
+        {
+            await RefreshCalibrationDataAsync();
+
+            var hidSamples = new MotionSample[samples.Count];
+            for (int i = 0; i < samples.Count; i++)
+            {
+                var sample = samples[i];
+                hidSamples[i] = new MotionSample(
+                    CalculateHidDelta(sample.DeltaX, useYAxis: false),
+                    CalculateHidDelta(sample.DeltaY, useYAxis: true),
+                    sample.DelayMs);
+            }
+
+            if ((_arduinoService.Capabilities & ArduinoFirmwareCapabilities.MotionStream) == 0)
+            {
+                // Firmware without motion streams: one relative move per sample, still paced on the device clock
+                var fallback = new List<ArduinoCommand>(hidSamples.Length * 2);
+                foreach (var sample in hidSamples)
+                {
+                    if (sample.DelayMs > 0)
+                        fallback.Add(new ArduinoDelayCommand((uint)sample.DelayMs));
+                    fallback.Add(new ArduinoMouseMoveRelativeCommand(sample.DeltaX, sample.DeltaY));
+                }
+
+                _logger.LogTrace("Firmware lacks motion streams; sending {Count} samples as relative moves", samples.Count);
+                await _arduinoService.SendCommandsAsync(fallback);
+                return;
+            }
+
+            var commands = ArduinoMotionStreamPacker.Pack(hidSamples);
+            _logger.LogTrace("Packed {Count} samples into {Frames} motion stream frames", samples.Count, commands.Count);
+
+            await _arduinoService.SendCommandsAsync(commands);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to simulate motion stream of {Count} samples via Arduino", samples.Count);
+            throw new InputSimulationException("Failed to simulate motion stream via Arduino", ex);
+        }
+    }
+
+    public async Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples)
+    {
+        // For Arduino, low-level and regular motion streams are the same
+        await SimulateMouseMotionAsync(samples);
+    }
+
     public async Task SimulateMouseClickAsync(MouseButton button, ClickType type)
     {
         ThrowIfDisposed();
@@ -214,17 +309,23 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
 
         try
         {
-            // Press all keys down
             foreach (var key in keyList)
             {
-                await SimulateKeyPressAsync(key, true);
+                ValidateKey(key);
             }
 
-            // Release all keys (in reverse order)
+            // Press all keys down, then release them in reverse order, as one contiguous write
+            var commands = new List<ArduinoCommand>(keyList.Count * 2);
+            foreach (var key in keyList)
+            {
+                commands.Add(new ArduinoKeyPressCommand(key, true));
+            }
             for (int i = keyList.Count - 1; i >= 0; i--)
             {
-                await SimulateKeyPressAsync(keyList[i], false);
+                commands.Add(new ArduinoKeyPressCommand(keyList[i], false));
             }
+
+            await _arduinoService.SendCommandsAsync(commands);
         }
         catch (Exception ex)
         {
@@ -268,6 +369,86 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         return await GetCursorPositionInternalAsync();
     }
     
+    /// <summary>
+    /// Jumps to the target with a calibrated relative move, then corrects the residual error from the
+    /// cursor position read back after each move.
+    /// </summary>
+    private async Task MoveClosedLoopAsync(Point start, Point target, ClosedLoopPositioningOptions options, CancellationToken cancellationToken)
+    {
+        int left = GetSystemMetrics(SM_XVIRTUALSCREEN);
+        int top = GetSystemMetrics(SM_YVIRTUALSCREEN);
+        int right = left + GetSystemMetrics(SM_CXVIRTUALSCREEN) - 1;
+        int bottom = top + GetSystemMetrics(SM_CYVIRTUALSCREEN) - 1;
+
+        // The cursor cannot leave the virtual screen, so aim for the nearest point it can reach
+        var reachable = new Point(Math.Clamp(target.X, left, right), Math.Clamp(target.Y, top, bottom));
+        if (reachable != target)
+            _logger.LogDebug("Target {Target} is off screen; positioning to {Reachable}", target, reachable);
+
+        var result = await ClosedLoopMousePositioner.MoveAsync(
+            start,
+            reachable,
+            options,
+            _calibrationData,
+            async (hidDeltaX, hidDeltaY, from) =>
+            {
+                _logger.LogTrace("Closed-loop HID Delta: ({HidDeltaX}, {HidDeltaY}) from {From}", hidDeltaX, hidDeltaY, from);
+                await _arduinoService.SendCommandAsync(new ArduinoMouseMoveRelativeCommand(hidDeltaX, hidDeltaY));
+                await _arduinoService.FlushAsync();
+                return await WaitForCursorToSettleAsync(from, options, cancellationToken);
+            },
+            landed => landed.X <= left || landed.X >= right || landed.Y <= top || landed.Y >= bottom,
+            cancellationToken);
+
+        LastPositioningResult = result;
+        if (result.ReachedTarget)
+        {
+            _logger.LogDebug("Reached {Target} with {Corrections} corrections in {ElapsedMs:F1}ms",
+                target, result.Corrections, result.Elapsed.TotalMilliseconds);
+        }
+        else
+        {
+            _logger.LogDebug("Stopped {ResidualX},{ResidualY}px from {Target} after {Corrections} corrections in {ElapsedMs:F1}ms",
+                result.ResidualX, result.ResidualY, target, result.Corrections, result.Elapsed.TotalMilliseconds);
+        }
+    }
+
+    /// <summary>
+    /// Samples the cursor on a timer until it has moved away from <paramref name="from"/> and then stayed
+    /// still for the quiet time, or until the settle timeout expires.
+    /// </summary>
+    private static async Task<Point> WaitForCursorToSettleAsync(Point from, ClosedLoopPositioningOptions options, CancellationToken cancellationToken)
+    {
+        var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+        var last = from;
+        var lastChange = TimeSpan.Zero;
+        var moved = false;
+
+        // Ticks are as coarse as the system timer resolution allows; that only delays the read-back
+        using var timer = new PeriodicTimer(SettlePollInterval);
+        while (stopwatch.Elapsed < options.SettleTimeout)
+        {
+            if (GetCursorPos(out POINT point))
+            {
+                var position = new Point(point.X, point.Y);
+                if (position != last)
+                {
+                    last = position;
+                    lastChange = stopwatch.Elapsed;
+                    moved = true;
+                }
+                else if (moved && stopwatch.Elapsed - lastChange >= options.SettleQuietTime)
+                {
+                    break;
+                }
+            }
+
+            await timer.WaitForNextTickAsync(cancellationToken).ConfigureAwait(false);
+        }
+
+        return last;
+    }
+
     /// <summary>
     /// Gets the current cursor position using Win32 API.
     /// </summary>
@@ -294,6 +475,36 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         return Task.FromResult(_arduinoService.IsConnected);
     }
 
+    /// <inheritdoc />
+    /// <remarks>
+    /// Commands already stream over the serial link as they are issued, so there is nothing to coalesce.
+    /// </remarks>
+    public IInputBatch BeginBatch() => ImmediateInputBatch.Instance;
+
+    /// <inheritdoc />
+    /// <remarks>
+    /// Drops the queued commands and sends the release command, which the firmware applies to whatever it holds.
+    /// Firmware without <see cref="ArduinoFirmwareCapabilities.ReleaseAll"/> is sent a key-up or button-up for
+    /// each input left down instead.
+    /// </remarks>
+    public async Task ReleaseAllAsync()
+    {
+        ThrowIfDisposed();
+
+        if (!_arduinoService.IsConnected)
+            return;
+
+        try
+        {
+            await _arduinoService.EmergencyStopAsync();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to release held input via Arduino");
+            throw new InputSimulationException("Failed to release held input via Arduino", ex);
+        }
+    }
+
     private static void ValidatePosition(Point position)
     {
         if (position.X < 0 || position.Y < 0)
@@ -337,8 +548,8 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
     /// </summary>
     private async Task RefreshCalibrationDataAsync()
     {
-        // Check if we need to refresh the cached calibration data
-        if (_calibrationData != null && DateTime.Now - _calibrationLoadedAt < CalibrationCacheExpiry)
+        // Check if we need to refresh the cached calibration data (also cached when there is none)
+        if (_calibrationLoadedAt != default && DateTime.Now - _calibrationLoadedAt < CalibrationCacheExpiry)
         {
             return; // Use cached data
         }
@@ -346,11 +557,19 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         try
         {
             var settings = await _settingsService.LoadAsync();
-            _calibrationData = settings.MouseCalibration;
+            var loaded = settings.MouseCalibration;
+            _positioningOptions = settings.ClosedLoopPositioning ?? ClosedLoopPositioningOptions.Default();
             _calibrationLoadedAt = DateTime.Now;
 
+            // Periodic reloads keep the already compiled tables when the calibration has not changed
+            if (IsSameCalibration(_calibrationData, loaded))
+                return;
+
+            _calibrationData = loaded;
+
             if (_calibrationData != null && _calibrationData.IsValid)
             {
+                _calibrationData.BuildLookupTables();
                 _logger.LogDebug("Loaded mouse calibration data: {Summary}", _calibrationData.GetSummary());
             }
             else
@@ -365,9 +584,19 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
         }
     }
 
+    private static bool IsSameCalibration(MouseCalibrationData? cached, MouseCalibrationData? loaded)
+    {
+        return cached != null && loaded != null &&
+               cached.HasLookupTables &&
+               cached.CalibratedAt == loaded.CalibratedAt &&
+               cached.CurveType == loaded.CurveType &&
+               cached.PointsX.Count == loaded.PointsX.Count &&
+               cached.PointsY.Count == loaded.PointsY.Count;
+    }
+
     /// <summary>
     /// Calculates the HID delta needed to achieve the target pixel movement.
-    /// Uses calibration data if available, otherwise assumes 1:1 mapping.
+    /// Uses the compiled calibration tables if available, otherwise assumes 1:1 mapping.
     /// </summary>
     /// <param name="targetPixelDelta">The target pixel movement</param>
     /// <param name="useYAxis">Whether to use Y-axis calibration data</param>
@@ -384,12 +613,14 @@ public sealed class ArduinoInputSimulator : IInputSimulator, IDisposable
     }
 
     /// <summary>
-    /// Forces a refresh of the calibration data on next mouse move.
-    /// Call this after calibration is completed.
+    /// Forces a reload (and table rebuild) of the calibration data on next mouse move.
+    /// Call this after calibration is saved.
     /// </summary>
     public void InvalidateCalibrationCache()
     {
+        _calibrationData?.InvalidateLookupTables();
         _calibrationData = null;
+        _calibrationLoadedAt = default;
         _logger.LogDebug("Calibration cache invalidated");
     }
 
@@ -0,0 +1,23 @@
+using System.IO.Ports;
+
+namespace MacroNex.Infrastructure.Adapters;
+
+/// <summary>
+/// Production implementation of <see cref="IArduinoSerialPort"/> that forwards to a <see cref="SerialPort"/>.
+/// </summary>
+internal sealed class ArduinoSerialPort : IArduinoSerialPort
+{
+    private readonly SerialPort _port;
+
+    public ArduinoSerialPort(SerialPort port)
+    {
+        _port = port ?? throw new ArgumentNullException(nameof(port));
+    }
+
+    public bool IsOpen => _port.IsOpen;
+    public void Open() => _port.Open();
+    public void Close() => _port.Close();
+    public void Write(byte[] buffer, int offset, int count) => _port.Write(buffer, offset, count);
+    public int Read(byte[] buffer, int offset, int count) => _port.Read(buffer, offset, count);
+    public void Dispose() => _port.Dispose();
+}
@@ -2,8 +2,11 @@ using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using MacroNex.Infrastructure.Utilities;
 using Microsoft.Extensions.Logging;
+using System.Buffers;
+using System.Diagnostics;
 using System.IO.Ports;
 using System.Text;
+using System.Threading.Channels;
 
 namespace MacroNex.Infrastructure.Adapters;
 
@@ -13,16 +16,42 @@ namespace MacroNex.Infrastructure.Adapters;
 public sealed class ArduinoSerialService : IArduinoService, IDisposable
 {
     private readonly ILogger<ArduinoSerialService> _logger;
+    private readonly IInputLatencyMonitor? _latencyMonitor;
     private readonly object _lockObject = new();
-    private SerialPort? _serialPort;
+    private readonly Func<string, IArduinoSerialPort> _portFactory;
+    private IArduinoSerialPort? _serialPort;
     private ArduinoConnectionState _connectionState = ArduinoConnectionState.Disconnected;
     private string? _connectedPortName;
+    private ArduinoFirmwareCapabilities _capabilities; // from the latest status response
     private CancellationTokenSource? _readCancellationTokenSource;
     private Task? _readTask;
-    private readonly List<byte> _receiveBuffer = new();
+    // Receive buffer: bytes [_receiveStart, _receiveStart + _receiveCount) are pending decode
+    private byte[] _receiveBuffer = new byte[InitialReceiveBufferSize];
+    private int _receiveStart;
+    private int _receiveCount;
     private bool _isDisposed;
 
+    // Pipelined send queue: frames are coalesced by a single writer task
+    private readonly ArduinoTransportOptions _transportOptions;
+    private Channel<OutgoingFrame>? _sendChannel;
+    private CancellationTokenSource? _writeCancellationTokenSource;
+    private Task? _writeTask;
+    private Exception? _writeFault;
+
+    // Credit-based flow control: the writer only sends what the firmware reported room for
+    private readonly ArduinoCreditWindow _creditWindow = new();
+    private readonly SemaphoreSlim _creditSignal = new(0, 1);
+    private static readonly byte[] CreditProbeFrame = ArduinoProtocolEncoder.EncodeCommand(new ArduinoStatusQueryCommand());
+    private const int MaxCreditStalls = 4; // stall timeouts without a report before flow control is suspended
+
+    // Emergency stop: frames queued before the stop are dropped and the release frame goes out next
+    private static readonly byte[] ReleaseAllFrame = ArduinoProtocolEncoder.EncodeCommand(new ArduinoReleaseAllCommand());
+    private long _discardQueuedBefore;                  // Stopwatch timestamp; data frames queued up to it are dropped
+    private TaskCompletionSource? _pendingEmergencyRelease; // set until the writer has sent the release frame
+    private readonly ArduinoHeldInputTracker _heldInputs = new(); // locked; released by hand without ReleaseAll
+
     // Serial port configuration
+    private const int InitialReceiveBufferSize = 4096;
     private const int BaudRate = 115200;
     private const int DataBits = 8;
     private const System.IO.Ports.Parity SerialParity = System.IO.Ports.Parity.None;
@@ -38,15 +67,42 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
     private DateTime? _lastHeartbeatSent;
     private DateTime? _lastHeartbeatReceived;
     private int _consecutiveHeartbeatFailures = 0;
+    private long _heartbeatSentTimestamp; // Stopwatch timestamp of the unanswered status query, 0 when none
     private readonly object _heartbeatLock = new();
 
+    // Send queue configuration
+    private const int WriteDrainTimeoutMs = 2000; // max time to flush queued frames on disconnect
+
     // Handshake configuration
     private const int HandshakeTimeoutMs = 5000; // 5 seconds - timeout for handshake response
     private TaskCompletionSource<bool>? _handshakeCompletionSource;
 
-    public ArduinoSerialService(ILogger<ArduinoSerialService> logger)
+    public ArduinoSerialService(ILogger<ArduinoSerialService> logger, ArduinoTransportOptions? transportOptions = null, IInputLatencyMonitor? latencyMonitor = null)
+        : this(logger, transportOptions, latencyMonitor, OpenSerialPort)
+    {
+    }
+
+    internal ArduinoSerialService(
+        ILogger<ArduinoSerialService> logger,
+        ArduinoTransportOptions? transportOptions,
+        IInputLatencyMonitor? latencyMonitor,
+        Func<string, IArduinoSerialPort> portFactory)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _portFactory = portFactory ?? throw new ArgumentNullException(nameof(portFactory));
+        _latencyMonitor = latencyMonitor;
+        _transportOptions = transportOptions ?? ArduinoTransportOptions.Default();
+
+        if (_transportOptions.MaxFramesInFlight <= 0)
+            throw new ArgumentException("MaxFramesInFlight must be positive.", nameof(transportOptions));
+        if (_transportOptions.MaxBatchBytes <= 0)
+            throw new ArgumentException("MaxBatchBytes must be positive.", nameof(transportOptions));
+        if (_transportOptions.BatchWindow < TimeSpan.Zero)
+            throw new ArgumentException("BatchWindow cannot be negative.", nameof(transportOptions));
+        if (_transportOptions.MaxTextChunkBytes < 4 || _transportOptions.MaxTextChunkBytes > ushort.MaxValue)
+            throw new ArgumentException("MaxTextChunkBytes must be between 4 and 65535.", nameof(transportOptions));
+        if (_transportOptions.CreditStallTimeout <= TimeSpan.Zero)
+            throw new ArgumentException("CreditStallTimeout must be positive.", nameof(transportOptions));
     }
 
     public ArduinoConnectionState ConnectionState
@@ -96,6 +152,17 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
         }
     }
 
+    public ArduinoFirmwareCapabilities Capabilities
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _capabilities;
+            }
+        }
+    }
+
     public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
     public event EventHandler<ArduinoEventReceivedEventArgs>? EventReceived;
     public event EventHandler<ArduinoErrorEventArgs>? ErrorOccurred;
@@ -142,20 +209,30 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             {
                 lock (_lockObject)
                 {
-                    _serialPort = new SerialPort(portName, BaudRate, SerialParity, DataBits, SerialStopBits)
-                    {
-                        Handshake = SerialHandshake,
-                        ReadTimeout = 1000,
-                        WriteTimeout = 1000,
-                        DtrEnable = true,
-                        RtsEnable = true
-                    };
-
+                    _serialPort = _portFactory(portName);
                     _serialPort.Open();
                     _connectedPortName = portName;
+                    _capabilities = ArduinoFirmwareCapabilities.None;
+                    _heldInputs.Clear();
                 }
             });
 
+            // Start writer task for the send queue
+            var sendChannel = Channel.CreateBounded<OutgoingFrame>(new BoundedChannelOptions(_transportOptions.MaxFramesInFlight)
+            {
+                SingleReader = true,
+                FullMode = BoundedChannelFullMode.Wait
+            });
+            _writeFault = null;
+            _creditWindow.Reset();
+            _writeCancellationTokenSource = new CancellationTokenSource();
+            var writePort = _serialPort!;
+            _writeTask = Task.Run(() => WriteLoopAsync(writePort, sendChannel.Reader, _writeCancellationTokenSource.Token), _writeCancellationTokenSource.Token);
+            lock (_lockObject)
+            {
+                _sendChannel = sendChannel;
+            }
+
             // Start reading task
             _readCancellationTokenSource = new CancellationTokenSource();
             _readTask = Task.Run(() => ReadLoopAsync(_readCancellationTokenSource.Token), _readCancellationTokenSource.Token);
@@ -177,6 +254,7 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             lock (_heartbeatLock)
             {
                 _lastHeartbeatSent = null;
+                _heartbeatSentTimestamp = 0;
                 _lastHeartbeatReceived = DateTime.UtcNow; // Assume handshake success means firmware is responsive
                 _consecutiveHeartbeatFailures = 0;
             }
@@ -202,7 +280,8 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
     {
         ThrowIfDisposed();
 
-        SerialPort? portToClose = null;
+        IArduinoSerialPort? portToClose = null;
+        Channel<OutgoingFrame>? sendChannel = null;
         lock (_lockObject)
         {
             if (_connectionState == ArduinoConnectionState.Disconnected)
@@ -211,6 +290,10 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             portToClose = _serialPort;
             _serialPort = null;
             _connectedPortName = null;
+            _capabilities = ArduinoFirmwareCapabilities.None;
+            _heldInputs.Clear();
+            sendChannel = _sendChannel;
+            _sendChannel = null;
         }
 
         // Stop heartbeat
@@ -230,6 +313,29 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             _logger.LogWarning(ex, "Error stopping heartbeat task");
         }
 
+        // Stop writing: let the writer drain what is already queued, then stop it
+        try
+        {
+            sendChannel?.Writer.TryComplete();
+            if (_writeTask != null)
+            {
+                var drained = await Task.WhenAny(_writeTask, Task.Delay(WriteDrainTimeoutMs)).ConfigureAwait(false);
+                if (drained != _writeTask)
+                {
+                    _logger.LogWarning("Send queue did not drain within {TimeoutMs}ms; dropping remaining frames", WriteDrainTimeoutMs);
+                    _writeCancellationTokenSource?.Cancel();
+                }
+                await _writeTask.ConfigureAwait(false);
+            }
+            _writeCancellationTokenSource?.Dispose();
+            _writeCancellationTokenSource = null;
+            _writeTask = null;
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "Error stopping write task");
+        }
+
         // Stop reading
         try
         {
@@ -266,13 +372,15 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
 
         lock (_lockObject)
         {
-            _receiveBuffer.Clear();
+            _receiveStart = 0;
+            _receiveCount = 0;
         }
 
         // Reset heartbeat tracking
         lock (_heartbeatLock)
         {
             _lastHeartbeatSent = null;
+            _heartbeatSentTimestamp = 0;
             _lastHeartbeatReceived = null;
             _consecutiveHeartbeatFailures = 0;
             
@@ -295,45 +403,561 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
 
         ThrowIfDisposed();
 
-        SerialPort? port;
+        var channel = GetSendChannel();
+
+        try
+        {
+            ThrowIfWriteFaulted();
+            ObserveHeldInput(command);
+
+            if (command is ArduinoKeyboardTextCommand text && text.SerializedLength > _transportOptions.MaxTextChunkBytes)
+            {
+                // Each chunk is its own frame, so the bounded queue paces long text instead of buffering all of it
+                var chunks = ArduinoKeyboardTextChunker.Chunk(text.Text, _transportOptions.MaxTextChunkBytes);
+                foreach (var chunk in chunks)
+                {
+                    await EnqueueCommandAsync(channel, chunk);
+                }
+
+                _logger.LogTrace("Queued keyboard text for Arduino as {ChunkCount} frames", chunks.Count);
+                return;
+            }
+
+            await EnqueueCommandAsync(channel, command);
+
+            _logger.LogTrace("Queued command {CommandType} for Arduino", command.CommandType);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to send command {CommandType} to Arduino", command.CommandType);
+            RaiseError($"Failed to send command {command.CommandType} to Arduino", ex);
+            throw new ArduinoCommunicationException($"Failed to send command to Arduino", ex);
+        }
+    }
+
+    public async Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands)
+    {
+        if (commands == null)
+            throw new ArgumentNullException(nameof(commands));
+        if (commands.Any(c => c == null))
+            throw new ArgumentException("Commands cannot contain null entries.", nameof(commands));
+
+        ThrowIfDisposed();
+
+        if (commands.Count == 0)
+            return;
+
+        var channel = GetSendChannel();
+
+        try
+        {
+            ThrowIfWriteFaulted();
+            for (int i = 0; i < commands.Count; i++)
+            {
+                ObserveHeldInput(commands[i]);
+            }
+
+            commands = ChunkKeyboardText(commands);
+
+            // Encode the whole batch into one frame so the writer emits it as one contiguous write.
+            var totalLength = 0;
+            for (int i = 0; i < commands.Count; i++)
+            {
+                totalLength += ArduinoProtocolEncoder.GetEncodedLength(commands[i]);
+            }
+
+            var batch = ArrayPool<byte>.Shared.Rent(totalLength);
+            var offset = 0;
+            for (int i = 0; i < commands.Count; i++)
+            {
+                ArduinoProtocolEncoder.TryEncode(commands[i], batch.AsSpan(offset), out var written);
+                offset += written;
+            }
+
+            await EnqueueFrameAsync(channel, new OutgoingFrame(batch, totalLength));
+
+            _logger.LogTrace("Queued batch of {CommandCount} commands ({ByteCount} bytes) for Arduino", commands.Count, totalLength);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to send batch of {CommandCount} commands to Arduino", commands.Count);
+            RaiseError($"Failed to send batch of {commands.Count} commands to Arduino", ex);
+            throw new ArduinoCommunicationException($"Failed to send commands to Arduino", ex);
+        }
+    }
+
+    public async Task FlushAsync()
+    {
+        ThrowIfDisposed();
+
+        Channel<OutgoingFrame>? channel;
         lock (_lockObject)
         {
-            if (_connectionState != ArduinoConnectionState.Connected || _serialPort == null || !_serialPort.IsOpen)
-                throw new InvalidOperationException("Arduino is not connected.");
+            channel = _sendChannel;
+        }
+
+        if (channel == null)
+            return;
+
+        var completion = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        try
+        {
+            await EnqueueFrameAsync(channel, OutgoingFrame.Marker(completion));
+            await completion.Task.ConfigureAwait(false);
+            ThrowIfWriteFaulted();
+        }
+        catch (ChannelClosedException)
+        {
+            // Disconnected while flushing; the writer has already drained the queue.
+        }
+        catch (Exception ex) when (ex is not ArduinoCommunicationException)
+        {
+            throw new ArduinoCommunicationException("Failed to flush queued commands to Arduino", ex);
+        }
+    }
+
+    public async Task EmergencyStopAsync()
+    {
+        ThrowIfDisposed();
 
+        var start = Stopwatch.GetTimestamp();
+        Channel<OutgoingFrame>? channel;
+        IArduinoSerialPort? port;
+        Task? writeTask;
+        lock (_lockObject)
+        {
+            channel = _sendChannel;
             port = _serialPort;
+            writeTask = _writeTask;
+        }
+
+        if (channel == null || port == null || writeTask == null)
+            return;
+
+        // Publish the cutoff before the pending release: the writer drops frames as soon as it sees the release,
+        // so it must never see the release with an older cutoff. A stop joining one in progress only moves the
+        // cutoff later, which drops the frames queued in between as intended.
+        InterlockedMax(ref _discardQueuedBefore, start);
+
+        var release = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var pending = Interlocked.CompareExchange(ref _pendingEmergencyRelease, release, null);
+        if (pending != null)
+        {
+            // Join the stop already in progress
+            release = pending;
+        }
+        else
+        {
+            // Wake the writer wherever it waits; when the queue is full it is busy and notices by itself
+            channel.Writer.TryWrite(OutgoingFrame.Marker(null));
+            SignalCredit();
+
+            if (writeTask.IsCompleted)
+            {
+                // No writer to hand the release to
+                SendEmergencyRelease(port);
+            }
+        }
+
+        await release.Task.ConfigureAwait(false);
+        _latencyMonitor?.Record(InputLatencyStage.EmergencyStop, start);
+        _logger.LogWarning("Arduino emergency stop: queued commands dropped and release command sent in {ElapsedMs:F3}ms",
+            Stopwatch.GetElapsedTime(start).TotalMilliseconds);
+    }
+
+    private static void InterlockedMax(ref long location, long value)
+    {
+        var current = Volatile.Read(ref location);
+        while (current < value)
+        {
+            var observed = Interlocked.CompareExchange(ref location, value, current);
+            if (observed == current)
+                return;
+
+            current = observed;
+        }
+    }
+
+    private Channel<OutgoingFrame> GetSendChannel()
+    {
+        lock (_lockObject)
+        {
+            if (_connectionState != ArduinoConnectionState.Connected || _serialPort == null || !_serialPort.IsOpen || _sendChannel == null)
+                throw new InvalidOperationException("Arduino is not connected.");
+
+            return _sendChannel;
+        }
+    }
+
+    private void ObserveHeldInput(ArduinoCommand command)
+    {
+        if (command is not (ArduinoKeyPressCommand or ArduinoMouseClickCommand))
+            return;
+
+        lock (_heldInputs)
+        {
+            _heldInputs.Observe(command);
+        }
+    }
+
+    private static ValueTask EnqueueCommandAsync(Channel<OutgoingFrame> channel, ArduinoCommand command)
+    {
+        var length = ArduinoProtocolEncoder.GetEncodedLength(command);
+        var buffer = ArrayPool<byte>.Shared.Rent(length);
+        ArduinoProtocolEncoder.TryEncode(command, buffer, out var written);
+        return EnqueueFrameAsync(channel, new OutgoingFrame(buffer, written));
+    }
+
+    /// <summary>
+    /// Replaces keyboard text longer than <see cref="ArduinoTransportOptions.MaxTextChunkBytes"/> by consecutive chunks.
+    /// Returns the list itself when nothing needs splitting.
+    /// </summary>
+    private IReadOnlyList<ArduinoCommand> ChunkKeyboardText(IReadOnlyList<ArduinoCommand> commands)
+    {
+        var maxTextBytes = _transportOptions.MaxTextChunkBytes;
+        List<ArduinoCommand>? chunked = null;
+
+        for (int i = 0; i < commands.Count; i++)
+        {
+            if (commands[i] is ArduinoKeyboardTextCommand text && text.SerializedLength > maxTextBytes)
+            {
+                chunked ??= new List<ArduinoCommand>(commands.Take(i));
+                chunked.AddRange(ArduinoKeyboardTextChunker.Chunk(text.Text, maxTextBytes));
+            }
+            else
+            {
+                chunked?.Add(commands[i]);
+            }
+        }
+
+        return chunked ?? commands;
+    }
+
+    private static ValueTask EnqueueFrameAsync(Channel<OutgoingFrame> channel, OutgoingFrame frame)
+    {
+        // Fast path: no thread-pool hop while there is room in flight.
+        if (channel.Writer.TryWrite(frame))
+            return ValueTask.CompletedTask;
+
+        return channel.Writer.WriteAsync(frame);
+    }
+
+    /// <summary>
+    /// Re-throws a failure from an earlier pipelined write so that senders notice a broken link.
+    /// </summary>
+    private void ThrowIfWriteFaulted()
+    {
+        var fault = Interlocked.Exchange(ref _writeFault, null);
+        if (fault != null)
+            throw new ArduinoCommunicationException("A previously queued write to Arduino failed", fault);
+    }
+
+    /// <summary>
+    /// Drains the send queue, coalescing frames queued within the batch window into single writes.
+    /// </summary>
+    private async Task WriteLoopAsync(IArduinoSerialPort port, ChannelReader<OutgoingFrame> reader, CancellationToken cancellationToken)
+    {
+        var batch = new byte[_transportOptions.MaxBatchBytes];
+        var flushCompletions = new List<TaskCompletionSource>();
+        OutgoingFrame? carried = null;
+
+        // A read wait left pending when a batch window expired; reused so the single reader never waits twice
+        Task<bool>? pendingWait = null;
+
+        async ValueTask<bool> WaitToReadAsync(TimeSpan? timeout)
+        {
+            if (pendingWait == null)
+            {
+                var wait = reader.WaitToReadAsync(cancellationToken);
+                if (wait.IsCompleted || timeout == null)
+                    return await wait;
+
+                pendingWait = wait.AsTask();
+            }
+
+            if (timeout != null &&
+                await Task.WhenAny(pendingWait, HighPrecisionTimer.WaitAsync(timeout.Value, cancellationToken)) != pendingWait)
+            {
+                return false;
+            }
+
+            var completed = pendingWait;
+            pendingWait = null;
+            return await completed;
         }
 
         try
         {
-            var encoded = ArduinoProtocolEncoder.EncodeCommand(command);
-            await Task.Run(() =>
+            while (carried.HasValue || await WaitToReadAsync(null))
             {
-                lock (port)
+                cancellationToken.ThrowIfCancellationRequested();
+
+                var length = 0;
+                var windowStart = Stopwatch.GetTimestamp();
+
+                while (true)
                 {
-                    port.Write(encoded, 0, encoded.Length);
+                    if (Volatile.Read(ref _pendingEmergencyRelease) != null)
+                    {
+                        // Emergency stop: drop what was collected and release before writing anything else
+                        length = 0;
+                        SendEmergencyRelease(port);
+                    }
+
+                    OutgoingFrame frame;
+                    if (carried.HasValue)
+                    {
+                        frame = carried.Value;
+                        carried = null;
+                    }
+                    else if (!reader.TryRead(out frame))
+                    {
+                        // Keep the batch open for the rest of the window so bursts share one write.
+                        var remaining = _transportOptions.BatchWindow - Stopwatch.GetElapsedTime(windowStart);
+                        if (length == 0 || remaining <= TimeSpan.Zero || !await WaitToReadAsync(remaining))
+                            break;
+
+                        continue;
+                    }
+
+                    if (frame.Length > 0 && frame.EnqueuedTimestamp <= Volatile.Read(ref _discardQueuedBefore))
+                    {
+                        // Queued before an emergency stop
+                        frame.ReturnBuffer();
+                        continue;
+                    }
+
+                    if (_latencyMonitor != null && frame.Length > 0)
+                        _latencyMonitor.Record(InputLatencyStage.SerialQueue, frame.EnqueuedTimestamp);
+
+                    if (frame.FlushCompletion != null)
+                    {
+                        // A flush marker closes the batch so the waiter is released promptly.
+                        flushCompletions.Add(frame.FlushCompletion);
+                        break;
+                    }
+
+                    if (length > 0 && length + frame.Length > batch.Length)
+                    {
+                        carried = frame;
+                        break;
+                    }
+
+                    if (frame.Length > batch.Length)
+                    {
+                        // Oversized frame (e.g. an explicit batch): write it on its own.
+                        await WriteWithCreditAsync(port, frame.Buffer, frame.Length, cancellationToken);
+                        frame.ReturnBuffer();
+                        continue;
+                    }
+
+                    Buffer.BlockCopy(frame.Buffer, 0, batch, length, frame.Length);
+                    length += frame.Length;
+                    frame.ReturnBuffer();
                 }
-            });
 
-            _logger.LogTrace("Sent command {CommandType} to Arduino", command.CommandType);
+                if (length > 0)
+                {
+                    await WriteWithCreditAsync(port, batch, length, cancellationToken);
+                }
+
+                if (Volatile.Read(ref _pendingEmergencyRelease) != null)
+                    SendEmergencyRelease(port);
+
+                foreach (var completion in flushCompletions)
+                {
+                    completion.TrySetResult();
+                }
+                flushCompletions.Clear();
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            // Stopping
+        }
+        finally
+        {
+            foreach (var completion in flushCompletions)
+            {
+                completion.TrySetCanceled();
+            }
+
+            // Disconnecting: nothing is queued any more, so an emergency stop has nothing left to wait for
+            Interlocked.Exchange(ref _pendingEmergencyRelease, null)?.TrySetResult();
+        }
+    }
+
+    /// <summary>
+    /// Sends the release frame of a pending emergency stop, ignoring credit: the firmware drops its
+    /// queued work when it sees the frame, so there is no buffer left to overrun. Firmware without
+    /// <see cref="ArduinoFirmwareCapabilities.ReleaseAll"/> gets a key-up or button-up for each held input
+    /// instead; those few bytes are written unthrottled as well.
+    /// </summary>
+    private void SendEmergencyRelease(IArduinoSerialPort port)
+    {
+        var release = Interlocked.Exchange(ref _pendingEmergencyRelease, null);
+        if (release == null)
+            return;
+
+        var frame = (Capabilities & ArduinoFirmwareCapabilities.ReleaseAll) != 0 ? ReleaseAllFrame : EncodeHeldInputReleases();
+        if (frame.Length == 0)
+        {
+            // Nothing held
+            release.TrySetResult();
+        }
+        else if (WriteToPort(port, frame, 0, frame.Length))
+        {
+            _creditWindow.OnSent(frame.Length);
+            release.TrySetResult();
+        }
+        else
+        {
+            release.TrySetException(new ArduinoCommunicationException("Failed to send the release command to Arduino"));
+        }
+    }
+
+    private byte[] EncodeHeldInputReleases()
+    {
+        List<ArduinoCommand> releases;
+        lock (_heldInputs)
+        {
+            releases = _heldInputs.TakeReleaseCommands();
+        }
+
+        var frame = new byte[releases.Sum(ArduinoProtocolEncoder.GetEncodedLength)];
+        var offset = 0;
+        foreach (var command in releases)
+        {
+            ArduinoProtocolEncoder.TryEncode(command, frame.AsSpan(offset), out var written);
+            offset += written;
+        }
+
+        return frame;
+    }
+
+    /// <summary>
+    /// Writes data as fast as the firmware's reported buffer space allows. Writes end on a frame boundary
+    /// whenever the credit covers at least one whole frame, so a frame is only split when it alone exceeds the
+    /// credit; the firmware's byte-stream parser does not notice either way.
+    /// An emergency stop cuts the write at the end of the frame in progress, so the parser stays in sync.
+    /// </summary>
+    private async ValueTask WriteWithCreditAsync(IArduinoSerialPort port, byte[] data, int count, CancellationToken cancellationToken)
+    {
+        var offset = 0;
+        while (offset < count)
+        {
+            if (Volatile.Read(ref _pendingEmergencyRelease) != null)
+            {
+                var frameEnd = ArduinoProtocolEncoder.FindFrameEnd(data.AsSpan(0, count), offset);
+                if (frameEnd > offset)
+                {
+                    WriteToPort(port, data, offset, frameEnd - offset);
+                    _creditWindow.OnSent(frameEnd - offset);
+                }
+                return;
+            }
+
+            var atFrameBoundary = ArduinoProtocolEncoder.FindFrameEnd(data.AsSpan(0, count), offset) == offset;
+            var credit = await WaitForCreditAsync(port, atFrameBoundary, cancellationToken);
+            if (credit == 0)
+                continue;
+
+            var chunk = Math.Min(count - offset, credit);
+            if (chunk < count - offset)
+            {
+                var boundary = ArduinoProtocolEncoder.FindFrameStart(data.AsSpan(0, count), offset + chunk);
+                if (boundary > offset)
+                    chunk = boundary - offset;
+            }
+
+            WriteToPort(port, data, offset, chunk);
+            _creditWindow.OnSent(chunk);
+            offset += chunk;
+        }
+    }
+
+    /// <summary>
+    /// Waits until the firmware reports buffer space and returns it, or 0 for an emergency stop.
+    /// </summary>
+    /// <param name="port">The port to send a credit probe on.</param>
+    /// <param name="canProbe">Whether the last write ended on a frame boundary, so a status query may follow.</param>
+    /// <param name="cancellationToken">Stops the wait.</param>
+    private async ValueTask<int> WaitForCreditAsync(IArduinoSerialPort port, bool canProbe, CancellationToken cancellationToken)
+    {
+        var stalls = 0;
+        while (true)
+        {
+            // 0 hands control back for an emergency stop
+            if (Volatile.Read(ref _pendingEmergencyRelease) != null)
+                return 0;
+
+            var available = _creditWindow.Available;
+            if (available > 0)
+                return available;
+
+            if (await _creditSignal.WaitAsync(_transportOptions.CreditStallTimeout, cancellationToken))
+            {
+                stalls = 0;
+                continue;
+            }
+
+            // No report for a while: one may have been lost. Ask for a new one with a status query, which fits
+            // in the reserve the window keeps free; the heartbeat notices firmware that stopped answering.
+            // Between the bytes of a split frame a query would corrupt the frame, so it waits for the boundary.
+            if (canProbe && _creditWindow.CanProbe(CreditProbeFrame.Length))
+            {
+                _logger.LogDebug("Out of Arduino flow control credit for {TimeoutMs}ms; requesting a report",
+                    _transportOptions.CreditStallTimeout.TotalMilliseconds);
+                WriteToPort(port, CreditProbeFrame, 0, CreditProbeFrame.Length);
+                _creditWindow.OnSent(CreditProbeFrame.Length);
+            }
+
+            if (++stalls >= MaxCreditStalls)
+            {
+                // Reports stopped and cannot be asked for: write unthrottled until the next report restarts flow control
+                _logger.LogWarning("No Arduino flow control report for {TimeoutMs}ms; writing without credit until the next report",
+                    _transportOptions.CreditStallTimeout.TotalMilliseconds * stalls);
+                _creditWindow.Reset();
+                stalls = 0;
+            }
+        }
+    }
+
+    private bool WriteToPort(IArduinoSerialPort port, byte[] data, int offset, int count)
+    {
+        try
+        {
+            if (!port.IsOpen)
+                throw new InvalidOperationException("Serial port is not open.");
+
+            var start = Stopwatch.GetTimestamp();
+            lock (port)
+            {
+                port.Write(data, offset, count);
+            }
+            _latencyMonitor?.Record(InputLatencyStage.SerialWrite, start);
+
+            _logger.LogTrace("Wrote {ByteCount} bytes to Arduino", count);
+            return true;
         }
         catch (Exception ex)
         {
-            _logger.LogError(ex, "Failed to send command {CommandType} to Arduino", command.CommandType);
-            RaiseError($"Failed to send command {command.CommandType} to Arduino", ex);
-            throw new ArduinoCommunicationException($"Failed to send command to Arduino", ex);
+            // Surface the failure to the next sender; the writer keeps draining so senders never hang.
+            Interlocked.Exchange(ref _writeFault, ex);
+            _logger.LogError(ex, "Failed to write {ByteCount} bytes to Arduino", count);
+            RaiseError("Failed to write to Arduino", ex);
+            return false;
         }
     }
 
     private async Task ReadLoopAsync(CancellationToken cancellationToken)
     {
-        var buffer = new byte[1024];
-
         while (!cancellationToken.IsCancellationRequested)
         {
             try
             {
-                SerialPort? port;
+                IArduinoSerialPort? port;
                 lock (_lockObject)
                 {
                     port = _serialPort;
@@ -345,10 +969,20 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
                     continue;
                 }
 
+                // Read straight into the free tail of the receive buffer (only this loop writes to it)
+                byte[] buffer;
+                int writeOffset;
+                lock (_lockObject)
+                {
+                    EnsureReceiveCapacity();
+                    buffer = _receiveBuffer;
+                    writeOffset = _receiveStart + _receiveCount;
+                }
+
                 int bytesRead;
                 try
                 {
-                    bytesRead = port.Read(buffer, 0, buffer.Length);
+                    bytesRead = port.Read(buffer, writeOffset, buffer.Length - writeOffset);
                 }
                 catch (TimeoutException)
                 {
@@ -360,7 +994,7 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
                 {
                     lock (_lockObject)
                     {
-                        _receiveBuffer.AddRange(buffer.Take(bytesRead));
+                        _receiveCount += bytesRead;
                     }
 
                     ProcessReceiveBuffer();
@@ -389,51 +1023,122 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
         }
     }
 
+    /// <summary>
+    /// Makes room at the tail of the receive buffer by compacting pending bytes to the front,
+    /// growing the buffer only when a partial frame fills it. Must be called under <see cref="_lockObject"/>.
+    /// </summary>
+    private void EnsureReceiveCapacity()
+    {
+        const int minFreeBytes = 256;
+
+        if (_receiveBuffer.Length - (_receiveStart + _receiveCount) >= minFreeBytes)
+            return;
+
+        if (_receiveBuffer.Length - _receiveCount >= minFreeBytes)
+        {
+            Buffer.BlockCopy(_receiveBuffer, _receiveStart, _receiveBuffer, 0, _receiveCount);
+        }
+        else
+        {
+            var grown = new byte[_receiveBuffer.Length * 2];
+            Buffer.BlockCopy(_receiveBuffer, _receiveStart, grown, 0, _receiveCount);
+            _receiveBuffer = grown;
+        }
+
+        _receiveStart = 0;
+    }
+
     private void ProcessReceiveBuffer()
     {
         lock (_lockObject)
         {
-            while (true)
+            while (_receiveCount > 0)
             {
-                if (_receiveBuffer.Count == 0)
-                    break;
+                var pending = new ReadOnlySpan<byte>(_receiveBuffer, _receiveStart, _receiveCount);
+                var consumed = ArduinoProtocolDecoder.TryDecodeEvent(pending, out var decodedEvent);
 
-                // Try to decode event - only call once and reuse the result
-                var consumed = ArduinoProtocolDecoder.TryDecodeEvent(_receiveBuffer.ToArray(), 0, out var decodedEvent);
-                
-                if (consumed > 0)
+                if (consumed == 0)
                 {
-                    if (decodedEvent != null)
-                    {
-                        // Handle heartbeat response
-                        if (decodedEvent.EventType == ArduinoEventType.StatusResponse)
-                        {
-                            HandleHeartbeatResponse();
-                        }
-
-                        var eventArgs = new ArduinoEventReceivedEventArgs(
-                            decodedEvent.EventType,
-                            decodedEvent.Data,
-                            decodedEvent.Timestamp
-                        );
+                    // Not enough data yet
+                    break;
+                }
 
-                        // Remove processed bytes
-                        _receiveBuffer.RemoveRange(0, consumed);
+                // Consume decoded frame, or skip one invalid byte to resync
+                _receiveStart += consumed;
+                _receiveCount -= consumed;
 
-                        // Raise event outside of lock
-                        Task.Run(() => EventReceived?.Invoke(this, eventArgs));
+                if (decodedEvent != null)
+                {
+                    // Flow control reports are transport bookkeeping and are not raised as events
+                    if (decodedEvent.EventType == ArduinoEventType.FlowControl)
+                    {
+                        HandleFlowControlReport(decodedEvent.Data);
+                        continue;
                     }
-                    else
+
+                    // Handle heartbeat response
+                    if (decodedEvent.EventType == ArduinoEventType.StatusResponse)
                     {
-                        // Invalid data, skip one byte
-                        _receiveBuffer.RemoveAt(0);
+                        _capabilities = ArduinoProtocolDecoder.ReadCapabilities(decodedEvent.Data);
+                        HandleHeartbeatResponse();
                     }
+
+                    var eventArgs = new ArduinoEventReceivedEventArgs(
+                        decodedEvent.EventType,
+                        decodedEvent.Data,
+                        decodedEvent.Timestamp
+                    );
+
+                    // Raise event outside of lock
+                    Task.Run(() => EventReceived?.Invoke(this, eventArgs));
                 }
-                else
-                {
-                    // Not enough data yet
-                    break;
-                }
+            }
+
+            if (_receiveCount == 0)
+            {
+                _receiveStart = 0;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Applies the firmware's reported buffer space and wakes a writer waiting for credit.
+    /// </summary>
+    private void HandleFlowControlReport(byte[] data)
+    {
+        if (!_transportOptions.EnableFlowControl)
+            return;
+
+        if (!ArduinoProtocolDecoder.TryReadFlowControl(data, out var capacity, out var bytesProcessed))
+        {
+            _logger.LogWarning("Ignoring malformed flow control report of {ByteCount} bytes", data.Length);
+            return;
+        }
+
+        var wasActive = _creditWindow.IsActive;
+        if (!_creditWindow.ApplyReport(capacity, bytesProcessed))
+            return;
+
+        if (!wasActive && capacity > 0)
+            _logger.LogInformation("Arduino flow control active with a {Capacity}-byte receive buffer", capacity);
+
+        SignalCredit();
+    }
+
+    /// <summary>
+    /// Wakes the writer if it is waiting for credit.
+    /// </summary>
+    private void SignalCredit()
+    {
+        if (_creditSignal.CurrentCount == 0)
+        {
+            try
+            {
+                _creditSignal.Release();
+            }
+            catch (SemaphoreFullException)
+            {
+                // Something else woke the writer first
             }
         }
     }
@@ -448,6 +1153,12 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             _lastHeartbeatReceived = DateTime.UtcNow;
             _consecutiveHeartbeatFailures = 0;
 
+            if (_heartbeatSentTimestamp != 0)
+            {
+                _latencyMonitor?.Record(InputLatencyStage.FirmwareRoundTrip, _heartbeatSentTimestamp);
+                _heartbeatSentTimestamp = 0;
+            }
+
             // Complete handshake if waiting
             if (_handshakeCompletionSource != null && !_handshakeCompletionSource.Task.IsCompleted)
             {
@@ -469,7 +1180,7 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
             var command = new ArduinoStatusQueryCommand();
             
             // We need to send the command directly since we're not fully connected yet
-            SerialPort? port;
+            IArduinoSerialPort? port;
             lock (_lockObject)
             {
                 port = _serialPort;
@@ -561,6 +1272,7 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
                     lock (_heartbeatLock)
                     {
                         _lastHeartbeatSent = DateTime.UtcNow;
+                        _heartbeatSentTimestamp = Stopwatch.GetTimestamp();
                     }
 
                     var command = new ArduinoStatusQueryCommand();
@@ -593,6 +1305,68 @@ public sealed class ArduinoSerialService : IArduinoService, IDisposable
         }
     }
 
+    /// <summary>
+    /// An encoded frame waiting in the send queue, or an empty marker: a flush marker when
+    /// <see cref="FlushCompletion"/> is set, otherwise a wake-up for the writer.
+    /// A frame's <see cref="Buffer"/> is rented from <see cref="ArrayPool{T}.Shared"/> and returned by the writer.
+    /// </summary>
+    private readonly struct OutgoingFrame
+    {
+        public OutgoingFrame(byte[] buffer, int length)
+            : this(buffer, length, null, isPooled: true)
+        {
+        }
+
+        private OutgoingFrame(byte[] buffer, int length, TaskCompletionSource? flushCompletion, bool isPooled)
+        {
+            Buffer = buffer;
+            Length = length;
+            FlushCompletion = flushCompletion;
+            IsPooled = isPooled;
+            EnqueuedTimestamp = Stopwatch.GetTimestamp();
+        }
+
+        /// <summary>
+        /// Creates a marker that carries no data and owns no pooled buffer.
+        /// </summary>
+        public static OutgoingFrame Marker(TaskCompletionSource? flushCompletion)
+            => new(Array.Empty<byte>(), 0, flushCompletion, isPooled: false);
+
+        public byte[] Buffer { get; }
+
+        /// <summary>
+        /// Gets whether <see cref="Buffer"/> was rented and must go back to the pool.
+        /// </summary>
+        public bool IsPooled { get; }
+
+        public int Length { get; }
+
+        public TaskCompletionSource? FlushCompletion { get; }
+
+        /// <summary>
+        /// Stopwatch timestamp taken when the frame was queued.
+        /// </summary>
+        public long EnqueuedTimestamp { get; }
+
+        public void ReturnBuffer()
+        {
+            if (IsPooled)
+                ArrayPool<byte>.Shared.Return(Buffer);
+        }
+    }
+
+    private static IArduinoSerialPort OpenSerialPort(string portName)
+    {
+        return new ArduinoSerialPort(new SerialPort(portName, BaudRate, SerialParity, DataBits, SerialStopBits)
+        {
+            Handshake = SerialHandshake,
+            ReadTimeout = 1000,
+            WriteTimeout = 1000,
+            DtrEnable = true,
+            RtsEnable = true
+        });
+    }
+
     private void RaiseError(string message, Exception? exception = null)
     {
         try
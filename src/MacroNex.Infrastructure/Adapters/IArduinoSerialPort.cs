@@ -0,0 +1,17 @@
+namespace MacroNex.Infrastructure.Adapters;
+
+/// <summary>
+/// Abstraction over the serial port used by <see cref="ArduinoSerialService"/> so the transport can be tested without hardware.
+/// </summary>
+internal interface IArduinoSerialPort : IDisposable
+{
+    bool IsOpen { get; }
+    void Open();
+    void Close();
+    void Write(byte[] buffer, int offset, int count);
+
+    /// <summary>
+    /// Reads available bytes, throwing <see cref="TimeoutException"/> when none arrive within the read timeout.
+    /// </summary>
+    int Read(byte[] buffer, int offset, int count);
+}
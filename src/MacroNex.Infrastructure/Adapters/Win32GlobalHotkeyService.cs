@@ -2,41 +2,31 @@ using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using MacroNex.Infrastructure.Win32;
 using Microsoft.Extensions.Logging;
+using Microsoft.Extensions.Logging.Abstractions;
 using System.Collections.Concurrent;
-using System.Runtime.InteropServices;
 using static MacroNex.Infrastructure.Win32.Win32Api;
-using static MacroNex.Infrastructure.Win32.Win32Structures;
 
 namespace MacroNex.Infrastructure.Adapters;
 
 /// <summary>
 /// Win32-based implementation of global hotkey service using RegisterHotKey/UnregisterHotKey APIs.
 /// Provides global hotkey registration, unregistration, and event handling with conflict detection.
+/// Registrations live on the shared <see cref="Win32InputThread"/>, which also receives their WM_HOTKEY messages.
 /// </summary>
 public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
 {
+    private static readonly TimeSpan DefaultOperationTimeout = TimeSpan.FromSeconds(5);
+
     private readonly ILogger<Win32GlobalHotkeyService> _logger;
+    private readonly TimeSpan _operationTimeout;
     private readonly IWin32HotkeyApi _api;
+    private readonly Win32InputThread _inputThread;
+    private readonly bool _ownsInputThread;
     private readonly object _lockObject = new();
     private readonly ConcurrentDictionary<int, HotkeyDefinition> _registeredHotkeys = new();
     private readonly ConcurrentDictionary<HotkeyDefinition, int> _hotkeyIds = new();
-    private readonly ConcurrentDictionary<int, HotkeyRegistrationInfo> _pendingRegistrations = new();
-    private readonly ConcurrentDictionary<int, TaskCompletionSource<bool>> _pendingUnregistrations = new();
-    private readonly ConcurrentDictionary<int, HotkeyRegistrationException> _registrationFailures = new();
 
-    private Thread? _messageLoopThread;
-    private volatile bool _isRunning = false;
     private volatile bool _isDisposed = false;
-    private int _nextHotkeyId = 1;
-    private uint _threadId;
-
-    private class HotkeyRegistrationInfo
-    {
-        public int HotkeyId { get; set; }
-        public uint Modifiers { get; set; }
-        public uint VirtualKey { get; set; }
-        public HotkeyDefinition Hotkey { get; set; } = null!;
-    }
 
     /// <inheritdoc />
     public event EventHandler<HotkeyPressedEventArgs>? HotkeyPressed;
@@ -45,18 +35,31 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
     /// Initializes a new instance of the Win32GlobalHotkeyService class.
     /// </summary>
     /// <param name="logger">Logger for diagnostic information.</param>
-    public Win32GlobalHotkeyService(ILogger<Win32GlobalHotkeyService> logger)
-        : this(logger, new Win32HotkeyApi())
+    /// <param name="inputThread">Shared thread that owns hotkey registrations and receives WM_HOTKEY.</param>
+    public Win32GlobalHotkeyService(ILogger<Win32GlobalHotkeyService> logger, Win32InputThread inputThread)
+        : this(logger, new Win32HotkeyApi(), inputThread ?? throw new ArgumentNullException(nameof(inputThread)), ownsInputThread: false, DefaultOperationTimeout)
     {
     }
 
-    internal Win32GlobalHotkeyService(ILogger<Win32GlobalHotkeyService> logger, IWin32HotkeyApi api)
+    internal Win32GlobalHotkeyService(ILogger<Win32GlobalHotkeyService> logger, IWin32HotkeyApi api, TimeSpan? operationTimeout = null)
+        : this(
+            logger ?? throw new ArgumentNullException(nameof(logger)),
+            api ?? throw new ArgumentNullException(nameof(api)),
+            new Win32InputThread(NullLogger<Win32InputThread>.Instance, api),
+            ownsInputThread: true,
+            operationTimeout ?? DefaultOperationTimeout)
+    {
+    }
+
+    private Win32GlobalHotkeyService(ILogger<Win32GlobalHotkeyService> logger, IWin32HotkeyApi api, Win32InputThread inputThread, bool ownsInputThread, TimeSpan operationTimeout)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
-        _api = api ?? throw new ArgumentNullException(nameof(api));
+        _api = api;
+        _operationTimeout = operationTimeout;
+        _inputThread = inputThread;
+        _ownsInputThread = ownsInputThread;
+        _inputThread.HotkeyPressed += HandleHotkeyMessage;
         _logger.LogDebug("Win32GlobalHotkeyService initialized");
-
-        StartMessageLoop();
     }
 
     /// <inheritdoc />
@@ -74,23 +77,9 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
 
         _logger.LogDebug("Registering hotkey: {Hotkey}", hotkey);
 
-        // Wait for message loop thread to be ready
-        var maxWaitTime = TimeSpan.FromSeconds(5);
-        var startTime = DateTime.UtcNow;
-        while (_threadId == 0 && DateTime.UtcNow - startTime < maxWaitTime)
-        {
-            await Task.Delay(10);
-        }
-
-        if (_threadId == 0)
-        {
-            throw new HotkeyRegistrationException(
-                "Message loop thread is not ready",
-                hotkey);
-        }
-
         int hotkeyId;
-        HotkeyRegistrationInfo registrationInfo;
+        uint modifiers;
+        uint virtualKey;
 
         lock (_lockObject)
         {
@@ -129,118 +118,117 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
                 return;
             }
 
-            hotkeyId = GetNextHotkeyId();
-            var modifiers = hotkey.Modifiers.ToWin32Modifiers();
+            hotkeyId = _inputThread.AllocateHotkeyId();
+            modifiers = hotkey.Modifiers.ToWin32Modifiers();
             // Only use MOD_NOREPEAT for "Once" mode; for "RepeatWhileHeld", allow Windows keyboard repeat
             if (hotkey.TriggerMode == HotkeyTriggerMode.Once)
             {
                 modifiers |= MOD_NOREPEAT;
             }
-            var virtualKey = (uint)hotkey.Key;
-
-            registrationInfo = new HotkeyRegistrationInfo
-            {
-                HotkeyId = hotkeyId,
-                Modifiers = modifiers,
-                VirtualKey = virtualKey,
-                Hotkey = hotkey
-            };
-
-            // Store pending registration before posting message
-            _pendingRegistrations[hotkeyId] = registrationInfo;
-
-            // Post a custom message to the message loop thread to register the hotkey
-            if (!_api.PostThreadMessage(_threadId, WM_HOTKEY_REGISTER, (IntPtr)hotkeyId, IntPtr.Zero))
-            {
-                _pendingRegistrations.TryRemove(hotkeyId, out _);
-                var error = _api.GetLastError();
-                _logger.LogError("Failed to post registration message for hotkey {Hotkey}. Win32 error: {Error}", hotkey, error);
-                throw new HotkeyRegistrationException(
-                    $"Failed to register hotkey {hotkey}: Could not post registration message",
-                    hotkey,
-                    (int)error);
-            }
+            virtualKey = (uint)hotkey.Key;
         }
 
-        // Wait for registration to complete (with timeout)
-        var registrationTimeout = TimeSpan.FromSeconds(5);
-        var registrationStart = DateTime.UtcNow;
-        while (!_registeredHotkeys.ContainsKey(hotkeyId) &&
-               !_registrationFailures.ContainsKey(hotkeyId) &&
-               DateTime.UtcNow - registrationStart < registrationTimeout)
+        // RegisterHotKey(NULL, ...) binds the hotkey to the calling thread's queue, so it must run on the input thread
+        var attempt = new RegistrationAttempt();
+        uint error;
+        try
         {
-            await Task.Delay(10);
+            error = await _inputThread.InvokeAsync(() => RegisterOnInputThread(hotkey, hotkeyId, modifiers, virtualKey, attempt))
+                .WaitAsync(_operationTimeout);
         }
-
-        // If message-loop reported a failure, throw it (instead of timing out).
-        if (_registrationFailures.TryRemove(hotkeyId, out var registrationFailure))
+        catch (TimeoutException)
         {
             lock (_lockObject)
             {
-                _pendingRegistrations.TryRemove(hotkeyId, out _);
+                // The work item may have finished between the timeout and this lock; then the hotkey is live
+                if (_registeredHotkeys.ContainsKey(hotkeyId))
+                {
+                    _logger.LogDebug("Hotkey {Hotkey} (ID={HotkeyId}) registered just after the timeout", hotkey, hotkeyId);
+                    return;
+                }
+
+                // The queued work item skips the registration, or undoes it if it is already under way
+                attempt.Abandoned = true;
             }
-            throw registrationFailure;
+
+            _logger.LogWarning("Hotkey registration timed out for {Hotkey} (ID={HotkeyId}). The input thread is not processing messages.", hotkey, hotkeyId);
+            throw new HotkeyRegistrationException("Hotkey registration timed out", hotkey);
+        }
+        catch (InvalidOperationException ex)
+        {
+            throw new HotkeyRegistrationException($"Failed to register hotkey {hotkey}: {ex.Message}", hotkey);
         }
 
-        if (!_registeredHotkeys.ContainsKey(hotkeyId))
+        if (error != 0)
         {
-            lock (_lockObject)
+            var errorMessage = error switch
             {
-                _pendingRegistrations.TryRemove(hotkeyId, out _);
-            }
-
-            // Check if registration failed due to already registered error
-            // This can happen if the message loop processed the registration but it failed
-            // We'll check the pending registrations to see if there was an error
-            _logger.LogWarning("Hotkey registration timed out for {Hotkey} (ID={HotkeyId}). This may indicate the hotkey is already registered by another application or the message loop is not processing messages.", hotkey, hotkeyId);
+                ERROR_HOTKEY_ALREADY_REGISTERED => "Hotkey is already registered by another application",
+                _ => $"Win32 error {error}"
+            };
 
+            _logger.LogError("Failed to register hotkey {Hotkey}. Win32 error: {Error}, Message: {ErrorMessage}", hotkey, error, errorMessage);
             throw new HotkeyRegistrationException(
-                "Hotkey registration timed out",
-                hotkey);
+                $"Failed to register hotkey {hotkey}: {errorMessage}",
+                hotkey,
+                (int)error);
         }
 
         _logger.LogDebug("Successfully registered hotkey {Hotkey} with ID {HotkeyId}", hotkey, hotkeyId);
     }
 
-    /// <inheritdoc />
-    public async Task UnregisterHotkeyAsync(HotkeyDefinition hotkey)
+    /// <summary>
+    /// Registers the hotkey with Win32 and records it before any WM_HOTKEY for it can be dispatched.
+    /// A registration whose caller already timed out is skipped, or released again if it got through.
+    /// </summary>
+    /// <returns>0 on success, otherwise the Win32 error code.</returns>
+    private uint RegisterOnInputThread(HotkeyDefinition hotkey, int hotkeyId, uint modifiers, uint virtualKey, RegistrationAttempt attempt)
     {
-        if (hotkey == null)
-            throw new ArgumentNullException(nameof(hotkey));
-
-        ThrowIfDisposed();
-
-        _logger.LogWarning("UnregisterHotkeyAsync called: {Hotkey} (Modifiers={Modifiers}, Key={Key}, TriggerMode={TriggerMode})",
-            hotkey, hotkey.Modifiers, hotkey.Key, hotkey.TriggerMode);
-
-        // Log current registered hotkeys for debugging
         lock (_lockObject)
         {
-            _logger.LogWarning("Currently registered hotkeys count before unregister: {Count}", _registeredHotkeys.Count);
-            foreach (var kvp in _registeredHotkeys)
+            if (attempt.Abandoned)
             {
-                _logger.LogWarning("  Registered: ID={Id}, Hotkey={Hotkey} (Modifiers={Modifiers}, Key={Key}, TriggerMode={TriggerMode})",
-                    kvp.Key, kvp.Value, kvp.Value.Modifiers, kvp.Value.Key, kvp.Value.TriggerMode);
+                _logger.LogDebug("Skipping timed-out registration of hotkey {Hotkey} (ID={HotkeyId})", hotkey, hotkeyId);
+                return 0;
             }
         }
 
-        // Wait for message loop thread to be ready
-        var maxWaitTime = TimeSpan.FromSeconds(5);
-        var startTime = DateTime.UtcNow;
-        while (_threadId == 0 && DateTime.UtcNow - startTime < maxWaitTime)
+        if (!_api.RegisterHotKey(IntPtr.Zero, hotkeyId, modifiers, virtualKey))
         {
-            await Task.Delay(10);
+            var error = _api.GetLastError();
+            return error == 0 ? uint.MaxValue : error;
         }
 
-        if (_threadId == 0)
+        // Store the registration only if Win32 registration succeeded
+        lock (_lockObject)
         {
-            throw new HotkeyRegistrationException(
-                "Message loop thread is not ready",
-                hotkey);
+            if (attempt.Abandoned)
+            {
+                // Still on the registering thread, so the late registration can be undone right here
+                _api.UnregisterHotKey(IntPtr.Zero, hotkeyId);
+                _logger.LogWarning("Released hotkey {Hotkey} (ID={HotkeyId}) that registered after its caller timed out", hotkey, hotkeyId);
+                return 0;
+            }
+
+            _registeredHotkeys[hotkeyId] = hotkey;
+            _hotkeyIds[hotkey] = hotkeyId;
         }
 
+        return 0;
+    }
+
+    /// <inheritdoc />
+    public async Task UnregisterHotkeyAsync(HotkeyDefinition hotkey)
+    {
+        if (hotkey == null)
+            throw new ArgumentNullException(nameof(hotkey));
+
+        ThrowIfDisposed();
+
+        _logger.LogDebug("Unregistering hotkey: {Hotkey} (Modifiers={Modifiers}, Key={Key}, TriggerMode={TriggerMode})",
+            hotkey, hotkey.Modifiers, hotkey.Key, hotkey.TriggerMode);
+
         int? hotkeyId = null;
-        HotkeyDefinition? actualHotkey = null;
 
         lock (_lockObject)
         {
@@ -248,10 +236,6 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
             if (_hotkeyIds.TryGetValue(hotkey, out var exactMatchId))
             {
                 hotkeyId = exactMatchId;
-                if (_registeredHotkeys.TryGetValue(exactMatchId, out var exactHotkey))
-                {
-                    actualHotkey = exactHotkey;
-                }
             }
             else
             {
@@ -264,7 +248,6 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
                         registeredHotkey.TriggerMode == hotkey.TriggerMode)
                     {
                         hotkeyId = kvp.Key;
-                        actualHotkey = registeredHotkey;
                         break;
                     }
                 }
@@ -276,74 +259,66 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
                     hotkey, _registeredHotkeys.Count);
                 return;
             }
-
-            // Create a task completion source to wait for unregistration to complete
-            var tcs = new TaskCompletionSource<bool>();
-            _pendingUnregistrations[hotkeyId.Value] = tcs;
-
-            // Post a custom message to the message loop thread to unregister the hotkey
-            if (!_api.PostThreadMessage(_threadId, WM_HOTKEY_UNREGISTER, (IntPtr)hotkeyId.Value, IntPtr.Zero))
-            {
-                _pendingUnregistrations.TryRemove(hotkeyId.Value, out _);
-                var error = _api.GetLastError();
-                _logger.LogError("Failed to post unregistration message for hotkey {Hotkey}. Win32 error: {Error}", hotkey, error);
-                throw new HotkeyRegistrationException(
-                    $"Failed to unregister hotkey {hotkey}: Could not post unregistration message",
-                    hotkey,
-                    (int)error);
-            }
         }
 
-        // Wait for unregistration to complete (with timeout)
-        var unregistrationTimeout = TimeSpan.FromSeconds(5);
-        var unregistrationStart = DateTime.UtcNow;
-        Task<bool> unregisterTask;
-
-        lock (_lockObject)
+        try
         {
-            if (!_pendingUnregistrations.TryGetValue(hotkeyId!.Value, out var tcs))
+            var id = hotkeyId.Value;
+            if (await _inputThread.InvokeAsync(() => UnregisterOnInputThread(id)).WaitAsync(_operationTimeout))
             {
-                // Already completed
-                return;
+                _logger.LogDebug("Successfully unregistered hotkey {Hotkey} with ID {HotkeyId}. Remaining registered hotkeys: {Count}",
+                    hotkey, id, _registeredHotkeys.Count);
             }
-            unregisterTask = tcs.Task;
         }
-
-        try
+        catch (TimeoutException)
         {
-            var completedTask = await Task.WhenAny(unregisterTask, Task.Delay(unregistrationTimeout));
-            if (completedTask == unregisterTask && await unregisterTask)
-            {
-                _logger.LogDebug("Successfully unregistered hotkey {Hotkey} with ID {HotkeyId}", hotkey, hotkeyId.Value);
-            }
-            else
-            {
-                lock (_lockObject)
-                {
-                    _pendingUnregistrations.TryRemove(hotkeyId.Value, out _);
-                }
-                _logger.LogWarning("Hotkey unregistration timed out for {Hotkey} (ID={HotkeyId})", hotkey, hotkeyId.Value);
-            }
+            _logger.LogWarning("Hotkey unregistration timed out for {Hotkey} (ID={HotkeyId})", hotkey, hotkeyId.Value);
         }
         catch (Exception ex)
         {
-            lock (_lockObject)
+            _logger.LogError(ex, "Error unregistering hotkey {Hotkey}", hotkey);
+        }
+    }
+
+    /// <summary>
+    /// Unregisters the hotkey with Win32 on the thread that registered it and drops it from tracking.
+    /// </summary>
+    /// <returns>True when the hotkey is no longer tracked; false when it was already gone.</returns>
+    private bool UnregisterOnInputThread(int hotkeyId)
+    {
+        if (!_registeredHotkeys.TryGetValue(hotkeyId, out var hotkey))
+        {
+            _logger.LogWarning("Unregistration requested for unknown hotkey ID {HotkeyId}", hotkeyId);
+            return false;
+        }
+
+        if (!_api.UnregisterHotKey(IntPtr.Zero, hotkeyId))
+        {
+            var error = _api.GetLastError();
+
+            // If the error is "not registered", it means our internal tracking is out of sync
+            if (error != ERROR_HOTKEY_NOT_REGISTERED)
             {
-                _pendingUnregistrations.TryRemove(hotkeyId.Value, out _);
+                _logger.LogError("Win32 UnregisterHotKey FAILED for hotkey {Hotkey} with ID {HotkeyId}. Win32 error: {Error}",
+                    hotkey, hotkeyId, error);
+                throw new HotkeyRegistrationException(
+                    $"Failed to unregister hotkey {hotkey}: Win32 error {error}",
+                    hotkey,
+                    (int)error);
             }
-            _logger.LogError(ex, "Error waiting for hotkey unregistration for {Hotkey}", hotkey);
+
+            _logger.LogWarning("Win32 reports hotkey {Hotkey} with ID {HotkeyId} is not registered, but it's in our tracking. Cleaning up internal state.",
+                hotkey, hotkeyId);
         }
 
-        // Log registered hotkeys after unregister to verify
+        // Remove from tracking collections
         lock (_lockObject)
         {
-            _logger.LogWarning("Currently registered hotkeys count after unregister: {Count}", _registeredHotkeys.Count);
-            foreach (var kvp in _registeredHotkeys)
-            {
-                _logger.LogWarning("  Still registered: ID={Id}, Hotkey={Hotkey} (Modifiers={Modifiers}, Key={Key}, TriggerMode={TriggerMode})",
-                    kvp.Key, kvp.Value, kvp.Value.Modifiers, kvp.Value.Key, kvp.Value.TriggerMode);
-            }
+            _hotkeyIds.TryRemove(hotkey, out _);
+            _registeredHotkeys.TryRemove(hotkeyId, out _);
         }
+
+        return true;
     }
 
     /// <inheritdoc />
@@ -412,305 +387,22 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
     }
 
     /// <inheritdoc />
-    public async Task<bool> IsReadyAsync()
+    public Task<bool> IsReadyAsync()
     {
         if (_isDisposed)
-            return false;
-
-        return await Task.Run(() =>
-        {
-            return _isRunning && _messageLoopThread != null && _messageLoopThread.IsAlive;
-        });
-    }
-
-    /// <summary>
-    /// Starts the message loop thread for handling hotkey messages.
-    /// </summary>
-    private void StartMessageLoop()
-    {
-        if (_messageLoopThread != null && _messageLoopThread.IsAlive)
-        {
-            _logger.LogWarning("Message loop thread is already running");
-            return;
-        }
-
-        _isRunning = true;
-        _messageLoopThread = new Thread(MessageLoopWorker)
-        {
-            Name = "HotkeyMessageLoop",
-            IsBackground = true
-        };
-
-        _messageLoopThread.Start();
-        _logger.LogDebug("Started hotkey message loop thread");
-    }
-
-    /// <summary>
-    /// Stops the message loop thread.
-    /// </summary>
-    private void StopMessageLoop()
-    {
-        if (!_isRunning || _messageLoopThread == null)
-            return;
+            return Task.FromResult(false);
 
-        _logger.LogDebug("Stopping hotkey message loop thread");
-        _isRunning = false;
-
-        // Post a quit message to the message loop thread
-        if (_threadId != 0)
-        {
-            _api.PostThreadMessage(_threadId, WM_QUIT, IntPtr.Zero, IntPtr.Zero);
-        }
-
-        // Wait for the thread to finish
-        if (_messageLoopThread.IsAlive)
-        {
-            _messageLoopThread.Join(TimeSpan.FromSeconds(5));
-
-            if (_messageLoopThread.IsAlive)
-            {
-                _logger.LogWarning("Message loop thread did not stop gracefully");
-            }
-        }
-
-        _messageLoopThread = null;
-        _logger.LogDebug("Stopped hotkey message loop thread");
+        return Task.FromResult(_inputThread.IsRunning);
     }
 
     /// <summary>
-    /// Worker method for the message loop thread.
+    /// Handles WM_HOTKEY messages delivered by the input thread.
     /// </summary>
-    private void MessageLoopWorker()
+    /// <param name="hotkeyId">The registration ID from the message.</param>
+    private void HandleHotkeyMessage(int hotkeyId)
     {
         try
         {
-            _threadId = _api.GetCurrentThreadId();
-            _logger.LogDebug("Message loop thread started with ID {ThreadId}", _threadId);
-
-            while (_isRunning)
-            {
-                // Check for messages without blocking
-                if (_api.PeekMessage(out MSG msg, IntPtr.Zero, 0, 0, PM_REMOVE))
-                {
-                    if (msg.message == WM_QUIT)
-                    {
-                        _logger.LogDebug("Received WM_QUIT message, stopping message loop");
-                        break;
-                    }
-
-                    if (msg.message == WM_HOTKEY)
-                    {
-                        HandleHotkeyMessage(msg);
-                    }
-                    else if (msg.message == WM_HOTKEY_REGISTER)
-                    {
-                        HandleHotkeyRegistrationMessage(msg);
-                    }
-                    else if (msg.message == WM_HOTKEY_UNREGISTER)
-                    {
-                        HandleHotkeyUnregistrationMessage(msg);
-                    }
-                    else
-                    {
-                        // Process other messages normally
-                        _api.TranslateMessage(ref msg);
-                        _api.DispatchMessage(ref msg);
-                    }
-                }
-                else
-                {
-                    // No messages available, sleep briefly to avoid busy waiting
-                    Thread.Sleep(10);
-                }
-            }
-        }
-        catch (Exception ex)
-        {
-            _logger.LogError(ex, "Error in hotkey message loop");
-        }
-        finally
-        {
-            _logger.LogDebug("Message loop thread exiting");
-        }
-    }
-
-    /// <summary>
-    /// Handles WM_HOTKEY_REGISTER messages to register hotkeys on the message loop thread.
-    /// </summary>
-    /// <param name="msg">The registration message.</param>
-    private void HandleHotkeyRegistrationMessage(MSG msg)
-    {
-        try
-        {
-            var hotkeyId = (int)msg.wParam;
-
-            if (_pendingRegistrations.TryRemove(hotkeyId, out var registrationInfo))
-            {
-                // Register the hotkey with Win32 on this thread
-                if (!_api.RegisterHotKey(IntPtr.Zero, registrationInfo.HotkeyId, registrationInfo.Modifiers, registrationInfo.VirtualKey))
-                {
-                    var error = _api.GetLastError();
-
-                    var errorMessage = error switch
-                    {
-                        ERROR_HOTKEY_ALREADY_REGISTERED => "Hotkey is already registered by another application",
-                        _ => $"Win32 error {error}"
-                    };
-
-                    // Check if the hotkey is already registered in our tracking (might be from a previous registration)
-                    lock (_lockObject)
-                    {
-                        var existingHotkey = _registeredHotkeys.Values
-                            .FirstOrDefault(h => h.Modifiers == registrationInfo.Hotkey.Modifiers &&
-                                                 h.Key == registrationInfo.Hotkey.Key &&
-                                                 h.TriggerMode == registrationInfo.Hotkey.TriggerMode);
-
-                        if (existingHotkey != null && error == ERROR_HOTKEY_ALREADY_REGISTERED)
-                        {
-                            // Hotkey is already registered in our tracking, reuse the existing ID
-                            var existingId = _hotkeyIds[existingHotkey];
-                            _logger.LogDebug("Hotkey {Hotkey} is already registered with ID {ExistingId}, reusing existing registration", registrationInfo.Hotkey, existingId);
-
-                            // Update the pending registration to use the existing ID
-                            // But we can't change the ID now, so we'll just log and return
-                            // The caller will timeout, but at least we've logged the issue
-                            _logger.LogWarning("Hotkey {Hotkey} registration failed: {ErrorMessage}. Existing registration found with ID {ExistingId}", registrationInfo.Hotkey, errorMessage, existingId);
-                        }
-                        else
-                        {
-                            _logger.LogError("Failed to register hotkey {Hotkey} on message loop thread. Win32 error: {Error}, Message: {ErrorMessage}", registrationInfo.Hotkey, error, errorMessage);
-                        }
-                    }
-
-                    // IMPORTANT:
-                    // RegisterHotkeyAsync is waiting for either a success signal (_registeredHotkeys contains ID)
-                    // or a failure signal (_registrationFailures contains ID). Record the failure to avoid timeouts.
-                    _registrationFailures[registrationInfo.HotkeyId] = new HotkeyRegistrationException(
-                        $"Failed to register hotkey {registrationInfo.Hotkey}: {errorMessage}",
-                        registrationInfo.Hotkey,
-                        (int)error);
-                    return;
-                }
-
-                // Store the registration only if Win32 registration succeeded
-                lock (_lockObject)
-                {
-                    _registeredHotkeys[registrationInfo.HotkeyId] = registrationInfo.Hotkey;
-                    _hotkeyIds[registrationInfo.Hotkey] = registrationInfo.HotkeyId;
-                }
-
-                _logger.LogDebug("Successfully registered hotkey {Hotkey} with ID {HotkeyId} on message loop thread", registrationInfo.Hotkey, registrationInfo.HotkeyId);
-            }
-            else
-            {
-                _logger.LogWarning("Received registration message for unknown hotkey ID {HotkeyId}", hotkeyId);
-            }
-        }
-        catch (Exception ex)
-        {
-            _logger.LogError(ex, "Error handling hotkey registration message");
-        }
-    }
-
-    /// <summary>
-    /// Handles WM_HOTKEY_UNREGISTER messages to unregister hotkeys on the message loop thread.
-    /// </summary>
-    /// <param name="msg">The unregistration message.</param>
-    private void HandleHotkeyUnregistrationMessage(MSG msg)
-    {
-        var hotkeyId = (int)msg.wParam;
-        TaskCompletionSource<bool>? tcs = null;
-
-        try
-        {
-            if (!_registeredHotkeys.TryGetValue(hotkeyId, out var hotkey))
-            {
-                _logger.LogWarning("Received unregistration message for unknown hotkey ID {HotkeyId}", hotkeyId);
-                // Still try to complete the task if it exists
-                if (_pendingUnregistrations.TryRemove(hotkeyId, out tcs))
-                {
-                    tcs.SetResult(false);
-                }
-                return;
-            }
-
-            _logger.LogWarning("Calling Win32 UnregisterHotKey for hotkey {Hotkey} with ID {HotkeyId} on message loop thread", hotkey, hotkeyId);
-
-            // Get the task completion source before processing
-            _pendingUnregistrations.TryRemove(hotkeyId, out tcs);
-
-            // Unregister the hotkey with Win32 on this thread (message loop thread)
-            if (!_api.UnregisterHotKey(IntPtr.Zero, hotkeyId))
-            {
-                var error = _api.GetLastError();
-
-                // If the error is "not registered", it means our internal tracking is out of sync
-                if (error == ERROR_HOTKEY_NOT_REGISTERED)
-                {
-                    _logger.LogWarning("Win32 reports hotkey {Hotkey} with ID {HotkeyId} is not registered, but it's in our tracking. Cleaning up internal state.",
-                        hotkey, hotkeyId);
-
-                    // Remove from tracking even though Win32 says it's not registered
-                    lock (_lockObject)
-                    {
-                        _hotkeyIds.TryRemove(hotkey, out _);
-                        _registeredHotkeys.TryRemove(hotkeyId, out _);
-                    }
-
-                    _logger.LogWarning("Cleaned up orphaned hotkey tracking for {Hotkey}", hotkey);
-
-                    // Complete the task with success (we cleaned up the state)
-                    tcs?.SetResult(true);
-                    return;
-                }
-
-                _logger.LogError("Win32 UnregisterHotKey FAILED for hotkey {Hotkey} with ID {HotkeyId}. Win32 error: {Error}",
-                    hotkey, hotkeyId, error);
-
-                // Complete the task with failure
-                tcs?.SetException(new HotkeyRegistrationException(
-                    $"Failed to unregister hotkey {hotkey}: Win32 error {error}",
-                    hotkey,
-                    (int)error));
-                return;
-            }
-
-            _logger.LogWarning("Win32 UnregisterHotKey SUCCESS for hotkey {Hotkey} with ID {HotkeyId}", hotkey, hotkeyId);
-
-            // Remove from tracking collections
-            lock (_lockObject)
-            {
-                _hotkeyIds.TryRemove(hotkey, out _);
-                _registeredHotkeys.TryRemove(hotkeyId, out _);
-            }
-
-            _logger.LogInformation("Successfully unregistered hotkey {Hotkey} with ID {HotkeyId}. Remaining registered hotkeys: {Count}",
-                hotkey, hotkeyId, _registeredHotkeys.Count);
-
-            // Complete the task with success
-            tcs?.SetResult(true);
-        }
-        catch (Exception ex)
-        {
-            _logger.LogError(ex, "Error handling hotkey unregistration message");
-            if (tcs == null)
-            {
-                _pendingUnregistrations.TryRemove(hotkeyId, out tcs);
-            }
-            tcs?.SetException(ex);
-        }
-    }
-
-    /// <summary>
-    /// Handles WM_HOTKEY messages.
-    /// </summary>
-    /// <param name="msg">The hotkey message.</param>
-    private void HandleHotkeyMessage(MSG msg)
-    {
-        try
-        {
-            var hotkeyId = (int)msg.wParam;
-
             if (_registeredHotkeys.TryGetValue(hotkeyId, out var hotkey))
             {
                 _logger.LogTrace("Hotkey pressed: {Hotkey}", hotkey);
@@ -734,10 +426,8 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
             {
                 // This can happen if:
                 // 1. Hotkey was unregistered but Win32 still sends messages (race condition)
-                // 2. Hotkey ID was reused but old registration wasn't cleaned up
-                // 3. Hotkey was registered by another thread/process
-                // Log at debug level to avoid spam, but track it occasionally
-                _logger.LogDebug("Received hotkey message for unknown hotkey ID {HotkeyId}. This may indicate a race condition or stale registration.", hotkeyId);
+                // 2. The ID belongs to another service sharing the input thread
+                _logger.LogTrace("Received hotkey message for unknown hotkey ID {HotkeyId}", hotkeyId);
             }
         }
         catch (Exception ex)
@@ -746,15 +436,6 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
         }
     }
 
-    /// <summary>
-    /// Gets the next available hotkey ID.
-    /// </summary>
-    /// <returns>A unique hotkey ID.</returns>
-    private int GetNextHotkeyId()
-    {
-        return Interlocked.Increment(ref _nextHotkeyId);
-    }
-
     /// <summary>
     /// Throws an ObjectDisposedException if the instance has been disposed.
     /// </summary>
@@ -779,17 +460,28 @@ public class Win32GlobalHotkeyService : IGlobalHotkeyService, IDisposable
         try
         {
             // Unregister all hotkeys
-            UnregisterAllHotkeysAsync().Wait(TimeSpan.FromSeconds(5));
+            UnregisterAllHotkeysAsync().Wait(_operationTimeout);
         }
         catch (Exception ex)
         {
             _logger.LogError(ex, "Error unregistering hotkeys during disposal");
         }
 
-        // Stop the message loop
-        StopMessageLoop();
+        _inputThread.HotkeyPressed -= HandleHotkeyMessage;
+        if (_ownsInputThread)
+        {
+            _inputThread.Dispose();
+        }
 
         _isDisposed = true;
         _logger.LogDebug("Win32GlobalHotkeyService disposed");
     }
-}
\ No newline at end of file
+
+    /// <summary>
+    /// Shared between a registration call and its queued work item; guarded by the service lock.
+    /// </summary>
+    private sealed class RegistrationAttempt
+    {
+        public bool Abandoned { get; set; }
+    }
+}
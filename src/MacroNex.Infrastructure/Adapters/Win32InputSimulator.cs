@@ -2,6 +2,8 @@ using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using MacroNex.Infrastructure.Win32;
 using Microsoft.Extensions.Logging;
+using System.Buffers;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
 using static MacroNex.Infrastructure.Win32.Win32Api;
 using static MacroNex.Infrastructure.Win32.Win32Structures;
@@ -11,20 +13,35 @@ namespace MacroNex.Infrastructure.Adapters;
 /// <summary>
 /// Win32-based implementation of input simulation using SendInput API.
 /// Provides mouse and keyboard automation capabilities with coordinate transformation and timing utilities.
+/// Inputs are built in pooled buffers; inside a batch (<see cref="BeginBatch"/>) they are coalesced into a single SendInput call.
+/// Keys and buttons left down are tracked so <see cref="ReleaseAllAsync"/> can release them.
 /// </summary>
 public class Win32InputSimulator : IInputSimulator
 {
+    private static readonly int InputSize = Marshal.SizeOf<INPUT>();
+    private static readonly Task<bool> BufferedResult = Task.FromResult(false);
+
     private readonly ILogger<Win32InputSimulator> _logger;
+    private readonly IPrecisionTimer? _precisionTimer;
+    private readonly IInputLatencyMonitor? _latencyMonitor;
     private readonly object _lockObject = new();
+    private readonly AsyncLocal<InputBatch?> _currentBatch = new();
+    private readonly Win32HeldInputTracker _heldInputs = new(); // guarded by _lockObject
+    private int _releaseEpoch; // bumped by ReleaseAllAsync; sends issued before the bump are dropped
     private bool _isDisposed = false;
 
     /// <summary>
     /// Initializes a new instance of the Win32InputSimulator class.
     /// </summary>
     /// <param name="logger">Logger for diagnostic information.</param>
-    public Win32InputSimulator(ILogger<Win32InputSimulator> logger)
+    /// <param name="precisionTimer">Optional precision timer; DelayAsync is accurate to about 1 ms while a run that
+    /// opted into high-precision timing holds one of its sessions.</param>
+    /// <param name="latencyMonitor">Optional monitor that receives the duration of each SendInput call.</param>
+    public Win32InputSimulator(ILogger<Win32InputSimulator> logger, IPrecisionTimer? precisionTimer = null, IInputLatencyMonitor? latencyMonitor = null)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _precisionTimer = precisionTimer;
+        _latencyMonitor = latencyMonitor;
         _logger.LogDebug("Win32InputSimulator initialized");
     }
 
@@ -36,6 +53,9 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating mouse move to {Position}", position);
 
+        // SetCursorPos bypasses the input stream, so buffered events must land first
+        await FlushOpenBatchAsync();
+
         await Task.Run(() =>
         {
             lock (_lockObject)
@@ -61,16 +81,9 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating low-level mouse move to {Position}", position);
 
-        await Task.Run(() =>
-        {
-            lock (_lockObject)
-            {
-                // SendInput absolute move (normalized 0..65535). Some games accept this better than SetCursorPos.
-                var input = CreateAbsoluteMouseMoveInput(position);
-                SendInputs(new[] { input });
-                _logger.LogTrace("Successfully sent low-level move to {Position}", position);
-            }
-        });
+        // SendInput absolute move (normalized 0..65535). Some games accept this better than SetCursorPos.
+        if (await SubmitAsync(CreateAbsoluteMouseMoveInput(position)))
+            _logger.LogTrace("Successfully sent low-level move to {Position}", position);
     }
 
     /// <inheritdoc />
@@ -81,6 +94,9 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating relative mouse move by ({DeltaX}, {DeltaY})", deltaX, deltaY);
 
+        // The move is computed from the current cursor position, which buffered events may still change
+        await FlushOpenBatchAsync();
+
         await Task.Run(() =>
         {
             lock (_lockObject)
@@ -124,16 +140,48 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating low-level relative mouse move by ({DeltaX}, {DeltaY})", deltaX, deltaY);
 
-        await Task.Run(() =>
+        // SendInput relative move (using MOUSEEVENTF_MOVE without MOUSEEVENTF_ABSOLUTE)
+        if (await SubmitAsync(CreateRelativeMouseMoveInput(deltaX, deltaY)))
+            _logger.LogTrace("Successfully sent low-level relative move by ({DeltaX}, {DeltaY})", deltaX, deltaY);
+    }
+
+    /// <inheritdoc />
+    public Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples)
+    {
+        return SimulateMouseMotionAsync(samples, lowLevel: false);
+    }
+
+    /// <inheritdoc />
+    public Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples)
+    {
+        return SimulateMouseMotionAsync(samples, lowLevel: true);
+    }
+
+    private async Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples, bool lowLevel)
+    {
+        ThrowIfDisposed();
+        if (samples == null)
+            throw new ArgumentNullException(nameof(samples));
+
+        _logger.LogDebug("Simulating {Mode} motion stream of {Count} samples", lowLevel ? "low-level" : "high-level", samples.Count);
+
+        // No device-side clock here, so pace the samples on the host
+        foreach (var sample in samples)
         {
-            lock (_lockObject)
+            if (sample.DelayMs > 0)
             {
-                // SendInput relative move (using MOUSEEVENTF_MOVE without MOUSEEVENTF_ABSOLUTE)
-                var input = CreateRelativeMouseMoveInput(deltaX, deltaY);
-                SendInputs(new[] { input });
-                _logger.LogTrace("Successfully sent low-level relative move by ({DeltaX}, {DeltaY})", deltaX, deltaY);
+                await DelayAsync(TimeSpan.FromMilliseconds(sample.DelayMs));
             }
-        });
+
+            if (lowLevel)
+            {
+                await SimulateMouseMoveRelativeLowLevelAsync(sample.DeltaX, sample.DeltaY);
+            }
+            else
+            {
+                await SimulateMouseMoveRelativeAsync(sample.DeltaX, sample.DeltaY);
+            }
+        }
     }
 
     /// <inheritdoc />
@@ -145,17 +193,10 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating {ClickType} {Button} click at current cursor position", type, button);
 
-        await Task.Run(() =>
-        {
-            lock (_lockObject)
-            {
-                // Perform the click action at the current cursor position
-                var inputs = CreateMouseClickInputs(button, type);
-                SendInputs(inputs);
-
-                _logger.LogTrace("Successfully performed {ClickType} {Button} click at current cursor position", type, button);
-            }
-        });
+        // Perform the click action at the current cursor position
+        var inputs = CreateMouseClickInputs(button, type, out var count);
+        if (await SubmitAsync(inputs, count))
+            _logger.LogTrace("Successfully performed {ClickType} {Button} click at current cursor position", type, button);
     }
 
     /// <inheritdoc />
@@ -174,54 +215,17 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating keyboard input: {Text}", text);
 
-        await Task.Run(() =>
+        // Use Unicode input for text: a key down and a key up per character
+        var inputs = ArrayPool<INPUT>.Shared.Rent(text.Length * 2);
+        var count = 0;
+        foreach (char c in text)
         {
-            lock (_lockObject)
-            {
-                // Use Unicode input for text
-                var inputs = new List<INPUT>();
-
-                foreach (char c in text)
-                {
-                    // Key down
-                    inputs.Add(new INPUT
-                    {
-                        type = INPUT_KEYBOARD,
-                        u = new InputUnion
-                        {
-                            ki = new KEYBDINPUT
-                            {
-                                wVk = 0,
-                                wScan = c,
-                                dwFlags = KEYEVENTF_UNICODE,
-                                time = 0,
-                                dwExtraInfo = IntPtr.Zero
-                            }
-                        }
-                    });
-
-                    // Key up
-                    inputs.Add(new INPUT
-                    {
-                        type = INPUT_KEYBOARD,
-                        u = new InputUnion
-                        {
-                            ki = new KEYBDINPUT
-                            {
-                                wVk = 0,
-                                wScan = c,
-                                dwFlags = KEYEVENTF_UNICODE | KEYEVENTF_KEYUP,
-                                time = 0,
-                                dwExtraInfo = IntPtr.Zero
-                            }
-                        }
-                    });
-                }
+            inputs[count++] = CreateUnicodeKeyInput(c, KEYEVENTF_UNICODE);
+            inputs[count++] = CreateUnicodeKeyInput(c, KEYEVENTF_UNICODE | KEYEVENTF_KEYUP);
+        }
 
-                SendInputs(inputs.ToArray());
-                _logger.LogTrace("Successfully sent keyboard input: {Text}", text);
-            }
-        });
+        if (await SubmitAsync(inputs, count))
+            _logger.LogTrace("Successfully sent keyboard input: {Text}", text);
     }
 
     /// <inheritdoc />
@@ -232,35 +236,29 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating key {Action}: {Key}", isDown ? "press" : "release", key);
 
-        await Task.Run(() =>
+        // 使用 scan code + KEYEVENTF_SCANCODE 來模?�實體鍵?�輸?��?
+        // ?��??�戲對這種?��??�支?��?比�?使用?�擬?�碼?�好??
+        var (scanCode, flags) = GetScanCodeAndFlags((uint)key);
+
+        var input = new INPUT
         {
-            lock (_lockObject)
+            type = INPUT_KEYBOARD,
+            u = new InputUnion
             {
-                // 使用 scan code + KEYEVENTF_SCANCODE 來模?�實體鍵?�輸?��?
-                // ?��??�戲對這種?��??�支?��?比�?使用?�擬?�碼?�好??
-                var (scanCode, flags) = GetScanCodeAndFlags((uint)key);
-
-                var input = new INPUT
+                ki = new KEYBDINPUT
                 {
-                    type = INPUT_KEYBOARD,
-                    u = new InputUnion
-                    {
-                        ki = new KEYBDINPUT
-                        {
-                            // 使用 scan code 模�??��?wVk 一?�設??0，由 wScan + dwFlags 決�?實�??��?
-                            wVk = 0,
-                            wScan = scanCode,
-                            dwFlags = flags | (isDown ? 0 : KEYEVENTF_KEYUP),
-                            time = 0,
-                            dwExtraInfo = IntPtr.Zero
-                        }
-                    }
-                };
-
-                SendInputs(new[] { input });
-                _logger.LogTrace("Successfully {Action} key: {Key}", isDown ? "pressed" : "released", key);
+                    // 使用 scan code 模�??��?wVk 一?�設??0，由 wScan + dwFlags 決�?實�??��?
+                    wVk = 0,
+                    wScan = scanCode,
+                    dwFlags = flags | (isDown ? 0 : KEYEVENTF_KEYUP),
+                    time = 0,
+                    dwExtraInfo = IntPtr.Zero
+                }
             }
-        });
+        };
+
+        if (await SubmitAsync(input))
+            _logger.LogTrace("Successfully {Action} key: {Key}", isDown ? "pressed" : "released", key);
     }
 
     /// <inheritdoc />
@@ -282,56 +280,23 @@ public class Win32InputSimulator : IInputSimulator
 
         _logger.LogDebug("Simulating key combination: {Keys}", string.Join(" + ", keyList));
 
-        await Task.Run(() =>
-        {
-            lock (_lockObject)
-            {
-                var inputs = new List<INPUT>();
+        var inputs = ArrayPool<INPUT>.Shared.Rent(keyList.Count * 2);
+        var count = 0;
 
-                // Press all keys down
-                foreach (var key in keyList)
-                {
-                    inputs.Add(new INPUT
-                    {
-                        type = INPUT_KEYBOARD,
-                        u = new InputUnion
-                        {
-                            ki = new KEYBDINPUT
-                            {
-                                wVk = (ushort)key,
-                                wScan = 0,
-                                dwFlags = 0,
-                                time = 0,
-                                dwExtraInfo = IntPtr.Zero
-                            }
-                        }
-                    });
-                }
+        // Press all keys down
+        foreach (var key in keyList)
+        {
+            inputs[count++] = CreateVirtualKeyInput(key, 0);
+        }
 
-                // Release all keys in reverse order
-                foreach (var key in keyList.AsEnumerable().Reverse())
-                {
-                    inputs.Add(new INPUT
-                    {
-                        type = INPUT_KEYBOARD,
-                        u = new InputUnion
-                        {
-                            ki = new KEYBDINPUT
-                            {
-                                wVk = (ushort)key,
-                                wScan = 0,
-                                dwFlags = KEYEVENTF_KEYUP,
-                                time = 0,
-                                dwExtraInfo = IntPtr.Zero
-                            }
-                        }
-                    });
-                }
+        // Release all keys in reverse order
+        for (int i = keyList.Count - 1; i >= 0; i--)
+        {
+            inputs[count++] = CreateVirtualKeyInput(keyList[i], KEYEVENTF_KEYUP);
+        }
 
-                SendInputs(inputs.ToArray());
-                _logger.LogTrace("Successfully sent key combination: {Keys}", string.Join(" + ", keyList));
-            }
-        });
+        if (await SubmitAsync(inputs, count))
+            _logger.LogTrace("Successfully sent key combination: {Keys}", string.Join(" + ", keyList));
     }
 
     /// <inheritdoc />
@@ -342,12 +307,21 @@ public class Win32InputSimulator : IInputSimulator
 
         ThrowIfDisposed();
 
+        // Whatever was queued before the delay has to be delivered before it
+        await FlushOpenBatchAsync();
+
         if (duration == TimeSpan.Zero)
         {
             return;
         }
 
         _logger.LogTrace("Delaying for {Duration}", duration);
+        if (_precisionTimer is { ActiveSessionCount: > 0 })
+        {
+            await _precisionTimer.DelayAsync(duration);
+            return;
+        }
+
         await Task.Delay(duration);
     }
 
@@ -356,6 +330,8 @@ public class Win32InputSimulator : IInputSimulator
     {
         ThrowIfDisposed();
 
+        await FlushOpenBatchAsync();
+
         return await Task.Run(() =>
         {
             lock (_lockObject)
@@ -374,6 +350,59 @@ public class Win32InputSimulator : IInputSimulator
         });
     }
 
+    /// <inheritdoc />
+    public IInputBatch BeginBatch()
+    {
+        ThrowIfDisposed();
+
+        var current = _currentBatch.Value;
+        if (current != null && !current.IsClosed)
+        {
+            return new NestedInputBatch(current);
+        }
+
+        var batch = new InputBatch(this);
+        _currentBatch.Value = batch;
+        return batch;
+    }
+
+    /// <inheritdoc />
+    /// <remarks>
+    /// Runs SendInput on the calling thread instead of hopping to the thread pool, and drops sends that were
+    /// issued before it but have not reached SendInput yet, so nothing queued can press a key again afterwards.
+    /// </remarks>
+    public Task ReleaseAllAsync()
+    {
+        ThrowIfDisposed();
+
+        var start = Stopwatch.GetTimestamp();
+        int released;
+        lock (_lockObject)
+        {
+            Interlocked.Increment(ref _releaseEpoch);
+
+            released = _heldInputs.HeldCount;
+            if (released > 0)
+            {
+                var inputs = ArrayPool<INPUT>.Shared.Rent(released);
+                try
+                {
+                    var count = _heldInputs.CopyReleaseInputs(inputs);
+                    SendInputs(inputs.AsSpan(0, count));
+                }
+                finally
+                {
+                    ArrayPool<INPUT>.Shared.Return(inputs);
+                }
+            }
+        }
+        _latencyMonitor?.Record(InputLatencyStage.EmergencyStop, start);
+
+        _logger.LogWarning("Released {Count} held keys and buttons in {ElapsedMs:F3}ms",
+            released, Stopwatch.GetElapsedTime(start).TotalMilliseconds);
+        return Task.CompletedTask;
+    }
+
     /// <inheritdoc />
     public async Task<bool> IsReadyAsync()
     {
@@ -400,29 +429,31 @@ public class Win32InputSimulator : IInputSimulator
     /// </summary>
     /// <param name="button">The mouse button to click.</param>
     /// <param name="type">The type of click action.</param>
-    /// <returns>Array of INPUT structures for the click action.</returns>
-    private INPUT[] CreateMouseClickInputs(MouseButton button, ClickType type)
+    /// <param name="count">Receives the number of inputs written.</param>
+    /// <returns>Pooled buffer holding the INPUT structures for the click action.</returns>
+    private INPUT[] CreateMouseClickInputs(MouseButton button, ClickType type, out int count)
     {
-        var inputs = new List<INPUT>();
+        var inputs = ArrayPool<INPUT>.Shared.Rent(2);
         var (downFlag, upFlag, mouseData) = GetMouseEventFlags(button);
+        count = 0;
 
         switch (type)
         {
             case ClickType.Down:
-                inputs.Add(CreateMouseInput(downFlag, mouseData));
+                inputs[count++] = CreateMouseInput(downFlag, mouseData);
                 break;
 
             case ClickType.Up:
-                inputs.Add(CreateMouseInput(upFlag, mouseData));
+                inputs[count++] = CreateMouseInput(upFlag, mouseData);
                 break;
 
             case ClickType.Click:
-                inputs.Add(CreateMouseInput(downFlag, mouseData));
-                inputs.Add(CreateMouseInput(upFlag, mouseData));
+                inputs[count++] = CreateMouseInput(downFlag, mouseData);
+                inputs[count++] = CreateMouseInput(upFlag, mouseData);
                 break;
         }
 
-        return inputs.ToArray();
+        return inputs;
     }
 
     /// <summary>
@@ -491,6 +522,56 @@ public class Win32InputSimulator : IInputSimulator
         };
     }
 
+    /// <summary>
+    /// Creates a Unicode keyboard input structure for one character.
+    /// </summary>
+    /// <param name="c">The UTF-16 code unit to send.</param>
+    /// <param name="flags">Keyboard event flags, including KEYEVENTF_UNICODE.</param>
+    /// <returns>INPUT structure for the character.</returns>
+    private static INPUT CreateUnicodeKeyInput(char c, uint flags)
+    {
+        return new INPUT
+        {
+            type = INPUT_KEYBOARD,
+            u = new InputUnion
+            {
+                ki = new KEYBDINPUT
+                {
+                    wVk = 0,
+                    wScan = c,
+                    dwFlags = flags,
+                    time = 0,
+                    dwExtraInfo = IntPtr.Zero
+                }
+            }
+        };
+    }
+
+    /// <summary>
+    /// Creates a virtual-key keyboard input structure.
+    /// </summary>
+    /// <param name="key">The virtual key.</param>
+    /// <param name="flags">Keyboard event flags.</param>
+    /// <returns>INPUT structure for the key event.</returns>
+    private static INPUT CreateVirtualKeyInput(VirtualKey key, uint flags)
+    {
+        return new INPUT
+        {
+            type = INPUT_KEYBOARD,
+            u = new InputUnion
+            {
+                ki = new KEYBDINPUT
+                {
+                    wVk = (ushort)key,
+                    wScan = 0,
+                    dwFlags = flags,
+                    time = 0,
+                    dwExtraInfo = IntPtr.Zero
+                }
+            }
+        };
+    }
+
     /// <summary>
     /// Creates a relative mouse move input structure.
     /// </summary>
@@ -536,15 +617,92 @@ public class Win32InputSimulator : IInputSimulator
     }
 
     /// <summary>
-    /// Sends input events using the Win32 SendInput API.
+    /// Appends a single input to the batch open on this flow, or sends it when there is none.
     /// </summary>
-    /// <param name="inputs">Array of input structures to send.</param>
-    private void SendInputs(INPUT[] inputs)
+    /// <param name="input">The input to submit.</param>
+    /// <returns>True when the input was sent, false when it was buffered.</returns>
+    private Task<bool> SubmitAsync(INPUT input)
     {
-        if (inputs.Length == 0)
+        var buffer = ArrayPool<INPUT>.Shared.Rent(1);
+        buffer[0] = input;
+        return SubmitAsync(buffer, 1);
+    }
+
+    /// <summary>
+    /// Appends inputs to the batch open on this flow, or sends them when there is none.
+    /// </summary>
+    /// <param name="buffer">Pooled buffer holding the inputs; ownership passes to this method.</param>
+    /// <param name="count">Number of inputs in the buffer.</param>
+    /// <returns>True when the inputs were sent, false when they were buffered.</returns>
+    private Task<bool> SubmitAsync(INPUT[] buffer, int count)
+    {
+        var batch = _currentBatch.Value;
+        if (batch != null && batch.TryAppend(buffer.AsSpan(0, count)))
+        {
+            ArrayPool<INPUT>.Shared.Return(buffer);
+            return BufferedResult;
+        }
+
+        return SendPooledAsync(buffer, count);
+    }
+
+    /// <summary>
+    /// Sends inputs from a pooled buffer on a worker thread and returns the buffer to the pool.
+    /// </summary>
+    /// <param name="buffer">Pooled buffer holding the inputs; ownership passes to this method.</param>
+    /// <param name="count">Number of inputs in the buffer.</param>
+    /// <returns>A task whose result is true once the inputs have been sent, or false when <see cref="ReleaseAllAsync"/> dropped them.</returns>
+    private Task<bool> SendPooledAsync(INPUT[] buffer, int count)
+    {
+        var epoch = Volatile.Read(ref _releaseEpoch);
+        return Task.Run(() =>
+        {
+            try
+            {
+                lock (_lockObject)
+                {
+                    if (epoch != _releaseEpoch)
+                        return false;
+
+                    SendInputs(buffer.AsSpan(0, count));
+                }
+
+                return true;
+            }
+            finally
+            {
+                ArrayPool<INPUT>.Shared.Return(buffer);
+            }
+        });
+    }
+
+    /// <summary>
+    /// Submits whatever the batch open on this flow has buffered.
+    /// </summary>
+    private Task FlushOpenBatchAsync()
+    {
+        return _currentBatch.Value?.FlushAsync() ?? Task.CompletedTask;
+    }
+
+    /// <summary>
+    /// Sends input events using the Win32 SendInput API in a single call and records which keys and buttons
+    /// are left down. Callers hold <see cref="_lockObject"/>.
+    /// </summary>
+    /// <param name="inputs">Input structures to send.</param>
+    private unsafe void SendInputs(ReadOnlySpan<INPUT> inputs)
+    {
+        if (inputs.IsEmpty)
             return;
 
-        var sent = SendInput((uint)inputs.Length, inputs, Marshal.SizeOf<INPUT>());
+        uint sent;
+        var start = Stopwatch.GetTimestamp();
+        fixed (INPUT* pInputs = inputs)
+        {
+            sent = SendInput((uint)inputs.Length, pInputs, InputSize);
+        }
+        _latencyMonitor?.Record(InputLatencyStage.SendInput, start);
+        _heldInputs.Observe(inputs.Slice(0, (int)Math.Min(sent, (uint)inputs.Length)));
+
         if (sent != inputs.Length)
         {
             var error = GetLastError();
@@ -693,4 +851,143 @@ public class Win32InputSimulator : IInputSimulator
 
         return (scanCode, flags);
     }
+
+    /// <summary>
+    /// Buffer of inputs collected between BeginBatch and CommitAsync on one asynchronous flow.
+    /// </summary>
+    private sealed class InputBatch : IInputBatch
+    {
+        private const int InitialCapacity = 64;
+
+        private readonly Win32InputSimulator _owner;
+        private readonly object _sync = new();
+        private INPUT[]? _buffer;
+        private int _count;
+
+        public InputBatch(Win32InputSimulator owner)
+        {
+            _owner = owner;
+            _buffer = ArrayPool<INPUT>.Shared.Rent(InitialCapacity);
+        }
+
+        public bool IsClosed
+        {
+            get { lock (_sync) return _buffer == null; }
+        }
+
+        public int PendingCount
+        {
+            get { lock (_sync) return _count; }
+        }
+
+        /// <summary>
+        /// Copies inputs into the buffer, or returns false when the batch is already closed.
+        /// </summary>
+        public bool TryAppend(ReadOnlySpan<INPUT> inputs)
+        {
+            lock (_sync)
+            {
+                if (_buffer == null)
+                    return false;
+
+                if (_count + inputs.Length > _buffer.Length)
+                {
+                    var grown = ArrayPool<INPUT>.Shared.Rent(Math.Max(_buffer.Length * 2, _count + inputs.Length));
+                    _buffer.AsSpan(0, _count).CopyTo(grown);
+                    ArrayPool<INPUT>.Shared.Return(_buffer);
+                    _buffer = grown;
+                }
+
+                inputs.CopyTo(_buffer.AsSpan(_count));
+                _count += inputs.Length;
+                return true;
+            }
+        }
+
+        public Task FlushAsync() => Submit(close: false);
+
+        // Not async: the AsyncLocal reset in Close must flow back to the caller
+        public Task CommitAsync() => Submit(close: true);
+
+        public ValueTask DisposeAsync()
+        {
+            INPUT[]? discarded;
+            int count;
+            lock (_sync)
+            {
+                discarded = _buffer;
+                count = _count;
+                _buffer = null;
+                _count = 0;
+            }
+
+            if (discarded != null)
+            {
+                Close();
+                ArrayPool<INPUT>.Shared.Return(discarded);
+                if (count > 0)
+                    _owner._logger.LogDebug("Discarded {Count} uncommitted batched inputs", count);
+            }
+
+            return ValueTask.CompletedTask;
+        }
+
+        private Task Submit(bool close)
+        {
+            INPUT[] pending;
+            int count;
+            lock (_sync)
+            {
+                if (_buffer == null)
+                    return Task.CompletedTask;
+
+                if (!close && _count == 0)
+                    return Task.CompletedTask;
+
+                pending = _buffer;
+                count = _count;
+                _buffer = close ? null : ArrayPool<INPUT>.Shared.Rent(InitialCapacity);
+                _count = 0;
+            }
+
+            if (close)
+                Close();
+
+            if (count == 0)
+            {
+                ArrayPool<INPUT>.Shared.Return(pending);
+                return Task.CompletedTask;
+            }
+
+            _owner._logger.LogTrace("Submitting {Count} batched inputs", count);
+            return _owner.SendPooledAsync(pending, count);
+        }
+
+        private void Close()
+        {
+            if (_owner._currentBatch.Value == this)
+                _owner._currentBatch.Value = null;
+        }
+    }
+
+    /// <summary>
+    /// Batch opened while another is open on the same flow; its inputs join the outer batch.
+    /// </summary>
+    private sealed class NestedInputBatch : IInputBatch
+    {
+        private readonly InputBatch _outer;
+
+        public NestedInputBatch(InputBatch outer)
+        {
+            _outer = outer;
+        }
+
+        public int PendingCount => _outer.PendingCount;
+
+        public Task FlushAsync() => _outer.FlushAsync();
+
+        public Task CommitAsync() => Task.CompletedTask;
+
+        public ValueTask DisposeAsync() => ValueTask.CompletedTask;
+    }
 }
\ No newline at end of file
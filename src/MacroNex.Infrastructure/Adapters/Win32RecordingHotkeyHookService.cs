@@ -10,14 +10,14 @@ namespace MacroNex.Infrastructure.Adapters;
 
 /// <summary>
 /// WH_KEYBOARD_LL based recording hotkey listener (no RegisterHotKey).
+/// Subscribes to the shared keyboard hook on <see cref="Win32InputThread"/>.
 /// </summary>
 public sealed class Win32RecordingHotkeyHookService : IRecordingHotkeyHookService, IDisposable
 {
     private readonly ILogger<Win32RecordingHotkeyHookService> _logger;
     private readonly object _lock = new();
 
-    private IntPtr _keyboardHook = IntPtr.Zero;
-    private readonly HookProc _keyboardProc;
+    private readonly IDisposable _keyboardHook;
 
     private HotkeyDefinition? _start;
     private HotkeyDefinition? _pause;
@@ -27,12 +27,13 @@ public sealed class Win32RecordingHotkeyHookService : IRecordingHotkeyHookServic
 
     public event EventHandler<HotkeyPressedEventArgs>? HotkeyPressed;
 
-    public Win32RecordingHotkeyHookService(ILogger<Win32RecordingHotkeyHookService> logger)
+    public Win32RecordingHotkeyHookService(ILogger<Win32RecordingHotkeyHookService> logger, Win32InputThread inputThread)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
-        _keyboardProc = KeyboardHookCallback;
+        if (inputThread == null) throw new ArgumentNullException(nameof(inputThread));
 
-        InstallHook();
+        _keyboardHook = inputThread.AddKeyboardHook(OnKeyboardEvent);
+        _logger.LogInformation("Recording hotkey listener subscribed to the keyboard hook.");
     }
 
     public void SetHotkeys(HotkeyDefinition? start, HotkeyDefinition? pause, HotkeyDefinition? stop)
@@ -45,33 +46,7 @@ public sealed class Win32RecordingHotkeyHookService : IRecordingHotkeyHookServic
         }
     }
 
-    private void InstallHook()
-    {
-        lock (_lock)
-        {
-            if (_keyboardHook != IntPtr.Zero)
-                return;
-
-            var moduleHandle = GetModuleHandle(null);
-            if (moduleHandle == IntPtr.Zero)
-            {
-                var error = (int)GetLastError();
-                throw new InvalidOperationException($"GetModuleHandle failed (Win32Error={error}).");
-            }
-
-            _keyboardHook = SetWindowsHookEx(WH_KEYBOARD_LL, _keyboardProc, moduleHandle, 0);
-            if (_keyboardHook == IntPtr.Zero)
-            {
-                var error = (int)GetLastError();
-                throw new InvalidOperationException($"SetWindowsHookEx(WH_KEYBOARD_LL) failed (Win32Error={error}).");
-            }
-
-            _logger.LogInformation("Recording hotkey keyboard hook installed.");
-        }
-    }
-
     private static bool IsDownMessage(int msg) => msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
-    private static bool IsUpMessage(int msg) => msg == WM_KEYUP || msg == WM_SYSKEYUP;
 
     private HotkeyModifiers GetCurrentModifiers()
     {
@@ -90,51 +65,45 @@ public sealed class Win32RecordingHotkeyHookService : IRecordingHotkeyHookServic
     private static bool Matches(HotkeyDefinition? hk, HotkeyModifiers mods, VirtualKey key)
         => hk != null && hk.Modifiers == mods && hk.Key == key;
 
-    private IntPtr KeyboardHookCallback(int nCode, IntPtr wParam, IntPtr lParam)
+    /// <returns>True to swallow the keystroke.</returns>
+    private bool OnKeyboardEvent(int msg, IntPtr lParam)
     {
         try
         {
-            if (nCode >= 0)
+            // Only act on key down to avoid double-trigger.
+            if (!IsDownMessage(msg))
+                return false;
+
+            var data = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
+            var key = (VirtualKey)data.vkCode;
+            var isInjected = (data.flags & KbdLlFlags.LLKHF_INJECTED) != 0;
+
+            // Ignore injected events (avoid recursive triggers).
+            if (isInjected)
+                return false;
+
+            HotkeyDefinition? matched = null;
+            lock (_lock)
             {
-                var msg = wParam.ToInt32();
-                if (IsDownMessage(msg) || IsUpMessage(msg))
+                var mods = GetCurrentModifiers();
+                if (Matches(_start, mods, key)) matched = _start;
+                else if (Matches(_pause, mods, key)) matched = _pause;
+                else if (Matches(_stop, mods, key)) matched = _stop;
+            }
+
+            if (matched != null)
+            {
+                try
+                {
+                    HotkeyPressed?.Invoke(this, new HotkeyPressedEventArgs(matched, DateTime.Now));
+                }
+                catch (Exception ex)
                 {
-                    // Only act on key down to avoid double-trigger.
-                    if (!IsDownMessage(msg))
-                        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
-
-                    var data = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
-                    var key = (VirtualKey)data.vkCode;
-                    var isInjected = (data.flags & KbdLlFlags.LLKHF_INJECTED) != 0;
-
-                    // Ignore injected events (avoid recursive triggers).
-                    if (isInjected)
-                        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
-
-                    HotkeyDefinition? matched = null;
-                    lock (_lock)
-                    {
-                        var mods = GetCurrentModifiers();
-                        if (Matches(_start, mods, key)) matched = _start;
-                        else if (Matches(_pause, mods, key)) matched = _pause;
-                        else if (Matches(_stop, mods, key)) matched = _stop;
-                    }
-
-                    if (matched != null)
-                    {
-                        try
-                        {
-                            HotkeyPressed?.Invoke(this, new HotkeyPressedEventArgs(matched, DateTime.Now));
-                        }
-                        catch (Exception ex)
-                        {
-                            _logger.LogError(ex, "Error in recording hotkey handler");
-                        }
-
-                        // Swallow to reduce interference/accidental recording.
-                        return (IntPtr)1;
-                    }
+                    _logger.LogError(ex, "Error in recording hotkey handler");
                 }
+
+                // Swallow to reduce interference/accidental recording.
+                return true;
             }
         }
         catch (Exception ex)
@@ -142,21 +111,14 @@ public sealed class Win32RecordingHotkeyHookService : IRecordingHotkeyHookServic
             _logger.LogDebug(ex, "Recording hotkey hook callback error (ignored).");
         }
 
-        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+        return false;
     }
 
     public void Dispose()
     {
         if (_isDisposed) return;
         _isDisposed = true;
-        lock (_lock)
-        {
-            if (_keyboardHook != IntPtr.Zero)
-            {
-                try { UnhookWindowsHookEx(_keyboardHook); } catch { }
-                _keyboardHook = IntPtr.Zero;
-            }
-        }
+        _keyboardHook.Dispose();
     }
 }
 
@@ -1,5 +1,6 @@
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Win32;
 using Microsoft.Extensions.Logging;
 using System.Runtime.InteropServices;
 using static MacroNex.Infrastructure.Win32.Win32Api;
@@ -10,14 +11,14 @@ namespace MacroNex.Infrastructure.Adapters;
 /// <summary>
 /// WH_KEYBOARD_LL based script hotkey listener (no RegisterHotKey).
 /// Supports per-hotkey swallow behavior and RepeatWhileHeld throttling.
+/// Subscribes to the shared keyboard hook on <see cref="Win32InputThread"/>.
 /// </summary>
 public sealed class Win32ScriptHotkeyHookService : IScriptHotkeyHookService, IDisposable
 {
     private readonly ILogger<Win32ScriptHotkeyHookService> _logger;
     private readonly object _lock = new();
 
-    private IntPtr _keyboardHook = IntPtr.Zero;
-    private readonly HookProc _keyboardProc;
+    private readonly IDisposable _keyboardHook;
 
     private Dictionary<Guid, HotkeyDefinition> _hotkeys = new();
 
@@ -29,11 +30,13 @@ public sealed class Win32ScriptHotkeyHookService : IScriptHotkeyHookService, IDi
 
     public event EventHandler<HotkeyPressedEventArgs>? HotkeyPressed;
 
-    public Win32ScriptHotkeyHookService(ILogger<Win32ScriptHotkeyHookService> logger)
+    public Win32ScriptHotkeyHookService(ILogger<Win32ScriptHotkeyHookService> logger, Win32InputThread inputThread)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
-        _keyboardProc = KeyboardHookCallback;
-        InstallHook();
+        if (inputThread == null) throw new ArgumentNullException(nameof(inputThread));
+
+        _keyboardHook = inputThread.AddKeyboardHook(OnKeyboardEvent);
+        _logger.LogInformation("Script hotkey listener subscribed to the keyboard hook.");
     }
 
     public void SetScriptHotkeys(IReadOnlyDictionary<Guid, HotkeyDefinition> hotkeys)
@@ -48,33 +51,7 @@ public sealed class Win32ScriptHotkeyHookService : IScriptHotkeyHookService, IDi
         }
     }
 
-    private void InstallHook()
-    {
-        lock (_lock)
-        {
-            if (_keyboardHook != IntPtr.Zero)
-                return;
-
-            var moduleHandle = GetModuleHandle(null);
-            if (moduleHandle == IntPtr.Zero)
-            {
-                var error = (int)GetLastError();
-                throw new InvalidOperationException($"GetModuleHandle failed (Win32Error={error}).");
-            }
-
-            _keyboardHook = SetWindowsHookEx(WH_KEYBOARD_LL, _keyboardProc, moduleHandle, 0);
-            if (_keyboardHook == IntPtr.Zero)
-            {
-                var error = (int)GetLastError();
-                throw new InvalidOperationException($"SetWindowsHookEx(WH_KEYBOARD_LL) failed (Win32Error={error}).");
-            }
-
-            _logger.LogInformation("Script hotkey keyboard hook installed.");
-        }
-    }
-
     private static bool IsDownMessage(int msg) => msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
-    private static bool IsUpMessage(int msg) => msg == WM_KEYUP || msg == WM_SYSKEYUP;
 
     private static HotkeyModifiers GetCurrentModifiers()
     {
@@ -87,85 +64,72 @@ public sealed class Win32ScriptHotkeyHookService : IScriptHotkeyHookService, IDi
         return mods;
     }
 
-    private IntPtr KeyboardHookCallback(int nCode, IntPtr wParam, IntPtr lParam)
+    /// <returns>True to swallow the keystroke.</returns>
+    private bool OnKeyboardEvent(int msg, IntPtr lParam)
     {
         try
         {
-            if (nCode >= 0)
-            {
-                var msg = wParam.ToInt32();
-                if (IsDownMessage(msg) || IsUpMessage(msg))
-                {
-                    // key down only
-                    if (!IsDownMessage(msg))
-                        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+            // key down only
+            if (!IsDownMessage(msg))
+                return false;
 
-                    var data = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
-                    var key = (VirtualKey)data.vkCode;
-                    var isInjected = (data.flags & KbdLlFlags.LLKHF_INJECTED) != 0;
-                    if (isInjected)
-                        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+            var data = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
+            var key = (VirtualKey)data.vkCode;
+            var isInjected = (data.flags & KbdLlFlags.LLKHF_INJECTED) != 0;
+            if (isInjected)
+                return false;
 
-                    Guid? matchedScriptId = null;
-                    HotkeyDefinition? matchedHotkey = null;
-                    var mods = GetCurrentModifiers();
+            Guid? matchedScriptId = null;
+            HotkeyDefinition? matchedHotkey = null;
+            var mods = GetCurrentModifiers();
 
-                    lock (_lock)
+            lock (_lock)
+            {
+                foreach (var kv in _hotkeys)
+                {
+                    var hk = kv.Value;
+                    if (hk.Modifiers == mods && hk.Key == key)
                     {
-                        foreach (var kv in _hotkeys)
+                        // repeat behavior
+                        if (hk.TriggerMode == HotkeyTriggerMode.RepeatWhileHeld)
                         {
-                            var hk = kv.Value;
-                            if (hk.Modifiers == mods && hk.Key == key)
+                            if (_lastFireByScript.TryGetValue(kv.Key, out var last) &&
+                                DateTime.UtcNow - last < RepeatThrottle)
                             {
-                                // repeat behavior
-                                if (hk.TriggerMode == HotkeyTriggerMode.RepeatWhileHeld)
-                                {
-                                    if (_lastFireByScript.TryGetValue(kv.Key, out var last) &&
-                                        DateTime.UtcNow - last < RepeatThrottle)
-                                    {
-                                        // still optionally swallow
-                                        return hk.SwallowKeystroke ? (IntPtr)1 : CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
-                                    }
-                                    _lastFireByScript[kv.Key] = DateTime.UtcNow;
-                                }
-
-                                matchedScriptId = kv.Key;
-                                matchedHotkey = hk;
-                                break;
+                                // still optionally swallow
+                                return hk.SwallowKeystroke;
                             }
+                            _lastFireByScript[kv.Key] = DateTime.UtcNow;
                         }
-                    }
 
-                    if (matchedScriptId.HasValue && matchedHotkey != null)
-                    {
-                        // Pack ScriptId into Name for lookup without a new EventArgs type.
-                        var evtHotkey = matchedHotkey with { Name = matchedScriptId.Value.ToString() };
-                        HotkeyPressed?.Invoke(this, new HotkeyPressedEventArgs(evtHotkey, DateTime.Now));
-                        return matchedHotkey.SwallowKeystroke ? (IntPtr)1 : CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+                        matchedScriptId = kv.Key;
+                        matchedHotkey = hk;
+                        break;
                     }
                 }
             }
+
+            if (matchedScriptId.HasValue && matchedHotkey != null)
+            {
+                // Pack ScriptId into Name for lookup without a new EventArgs type.
+                var evtHotkey = matchedHotkey with { Name = matchedScriptId.Value.ToString() };
+                HotkeyPressed?.Invoke(this, new HotkeyPressedEventArgs(evtHotkey, DateTime.Now));
+                return matchedHotkey.SwallowKeystroke;
+            }
         }
         catch (Exception ex)
         {
             _logger.LogDebug(ex, "Script hotkey hook callback error (ignored).");
         }
 
-        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+        return false;
     }
 
     public void Dispose()
     {
         if (_isDisposed) return;
         _isDisposed = true;
-        lock (_lock)
-        {
-            if (_keyboardHook != IntPtr.Zero)
-            {
-                try { UnhookWindowsHookEx(_keyboardHook); } catch { }
-                _keyboardHook = IntPtr.Zero;
-            }
-        }
+        _keyboardHook.Dispose();
     }
 }
 
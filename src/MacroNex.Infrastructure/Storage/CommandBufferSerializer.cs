@@ -0,0 +1,157 @@
+using System.Buffers.Binary;
+using System.Runtime.InteropServices;
+using System.Text;
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Infrastructure.Storage;
+
+/// <summary>
+/// Binary form of a <see cref="CommandBuffer"/>: the columns are written back to back as little-endian arrays,
+/// so on x86/x64 each is a single block copy in either direction.
+/// Layout: "MNCB", format version (1 byte), command count and keyboard payload count (int32 each), then the
+/// opcode, X, Y and delay-tick columns, then each keyboard payload as a has-text flag, the UTF-8 text
+/// (7-bit encoded length prefix) and the key count followed by the keys (int32 each).
+/// </summary>
+public static class CommandBufferSerializer
+{
+    private const byte FormatVersion = 1;
+    private const int HeaderSize = 4 + 1 + 4 + 4;
+    private static ReadOnlySpan<byte> Magic => "MNCB"u8;
+
+    /// <summary>
+    /// Serializes <paramref name="buffer"/> to bytes.
+    /// </summary>
+    public static byte[] Serialize(CommandBuffer buffer)
+    {
+        if (buffer == null) throw new ArgumentNullException(nameof(buffer));
+
+        var count = buffer.Count;
+        using var stream = new MemoryStream(HeaderSize + count * (1 + 4 + 4 + 8));
+        using (var writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true))
+        {
+            writer.Write(Magic);
+            writer.Write(FormatVersion);
+            writer.Write(count);
+            writer.Write(buffer.KeyboardPayloadCount);
+
+            writer.Write(MemoryMarshal.AsBytes(buffer.Opcodes));
+            WriteColumn(writer, buffer.X);
+            WriteColumn(writer, buffer.Y);
+            WriteColumn(writer, buffer.DelayTicks);
+
+            for (int i = 0; i < buffer.KeyboardPayloadCount; i++)
+            {
+                var (text, keys) = buffer.GetKeyboardPayload(i);
+                writer.Write(text != null);
+                if (text != null)
+                    writer.Write(text);
+
+                writer.Write(keys.Count);
+                foreach (var key in keys)
+                {
+                    writer.Write((int)key);
+                }
+            }
+        }
+
+        return stream.ToArray();
+    }
+
+    /// <summary>
+    /// Deserializes bytes written by <see cref="Serialize"/>.
+    /// </summary>
+    /// <exception cref="InvalidDataException">The data is not a valid command buffer.</exception>
+    public static CommandBuffer Deserialize(byte[] data)
+    {
+        if (data == null) throw new ArgumentNullException(nameof(data));
+        if (data.Length < HeaderSize || !data.AsSpan(0, 4).SequenceEqual(Magic))
+            throw new InvalidDataException("Command data has no valid header.");
+        if (data[4] != FormatVersion)
+            throw new InvalidDataException($"Unsupported command data version {data[4]}.");
+
+        var count = BinaryPrimitives.ReadInt32LittleEndian(data.AsSpan(5));
+        var payloadCount = BinaryPrimitives.ReadInt32LittleEndian(data.AsSpan(9));
+        // One byte per opcode plus 16 per command for the other columns must fit
+        if (count < 0 || payloadCount < 0 || (long)count * 17 > data.Length - HeaderSize)
+            throw new InvalidDataException("Command data is truncated.");
+
+        var offset = HeaderSize;
+        var opcodes = new CommandOpcode[count];
+        data.AsSpan(offset, count).CopyTo(MemoryMarshal.AsBytes(opcodes.AsSpan()));
+        offset += count;
+
+        var x = ReadColumn<int>(data, ref offset, count);
+        var y = ReadColumn<int>(data, ref offset, count);
+        var delayTicks = ReadColumn<long>(data, ref offset, count);
+
+        var payloads = new List<(string? Text, IReadOnlyList<VirtualKey> Keys)>(Math.Min(payloadCount, 1024));
+        try
+        {
+            using var reader = new BinaryReader(new MemoryStream(data, offset, data.Length - offset, writable: false), Encoding.UTF8);
+            for (int i = 0; i < payloadCount; i++)
+            {
+                var text = reader.ReadBoolean() ? reader.ReadString() : null;
+                var keyCount = reader.ReadInt32();
+                if (keyCount < 0 || keyCount > reader.BaseStream.Length - reader.BaseStream.Position)
+                    throw new InvalidDataException("Command data is truncated.");
+
+                var keys = new VirtualKey[keyCount];
+                for (int k = 0; k < keyCount; k++)
+                {
+                    keys[k] = (VirtualKey)reader.ReadInt32();
+                }
+                payloads.Add((text, keys));
+            }
+        }
+        catch (EndOfStreamException ex)
+        {
+            throw new InvalidDataException("Command data is truncated.", ex);
+        }
+
+        try
+        {
+            return CommandBuffer.FromColumns(opcodes, x, y, delayTicks, count, payloads);
+        }
+        catch (ArgumentException ex)
+        {
+            throw new InvalidDataException($"Command data is invalid: {ex.Message}", ex);
+        }
+    }
+
+    private static void WriteColumn<T>(BinaryWriter writer, ReadOnlySpan<T> column) where T : unmanaged
+    {
+        if (BitConverter.IsLittleEndian)
+        {
+            writer.Write(MemoryMarshal.AsBytes(column));
+            return;
+        }
+
+        // BinaryWriter always writes little-endian
+        foreach (var value in column)
+        {
+            if (value is int i)
+                writer.Write(i);
+            else if (value is long l)
+                writer.Write(l);
+        }
+    }
+
+    private static T[] ReadColumn<T>(byte[] data, ref int offset, int count) where T : unmanaged
+    {
+        var column = new T[count];
+        var bytes = MemoryMarshal.AsBytes(column.AsSpan());
+        data.AsSpan(offset, bytes.Length).CopyTo(bytes);
+        offset += bytes.Length;
+
+        if (!BitConverter.IsLittleEndian)
+        {
+            if (column is int[] ints)
+                BinaryPrimitives.ReverseEndianness(ints, ints);
+            else if (column is long[] longs)
+                BinaryPrimitives.ReverseEndianness(longs, longs);
+        }
+
+        return column;
+    }
+}
@@ -1,28 +1,47 @@
 using MacroNex.Domain.Interfaces;
 using Microsoft.Extensions.Logging;
 using System.Text;
+using System.Threading.Channels;
 
 namespace MacroNex.Infrastructure.Storage;
 
 /// <summary>
 /// Infrastructure service for writing log entries to persistent file storage.
 /// Handles log file rotation, formatting, and export operations.
+/// Entries are queued on a bounded channel and written in batches by a background task that keeps the
+/// log file open, so <see cref="WriteLogEntryAsync"/> never touches the disk on the caller's thread.
 /// </summary>
-public class FileLogWriter : IFileLogWriter
+public class FileLogWriter : IFileLogWriter, IAsyncDisposable, IDisposable
 {
     private readonly ILogger<FileLogWriter> _logger;
     private readonly string _logDirectory;
     private readonly string _logFileName;
-    private const long MaxLogFileSize = 10 * 1024 * 1024; // 10 MB
     private const int MaxLogFiles = 10;
-    private readonly object _fileLock = new();
+    private const int FileBufferSize = 64 * 1024;
+    private static readonly Encoding LogEncoding = new UTF8Encoding(encoderShouldEmitUTF8Identifier: false);
+
+    private readonly FileLogWriterOptions _options;
+    private readonly Channel<LogEntry> _channel;
+    private readonly Task _writerTask;
+    private readonly CancellationTokenSource _shutdown = new();
+
+    // Guards the open stream; held by the writer task per batch and by ClearLogsAsync
+    private readonly SemaphoreSlim _fileLock = new(1, 1);
+    private FileStream? _stream;
+    private long _fileSize;
+    private long _unflushedBytes;
+    private byte[] _encodeBuffer = new byte[1024];
+
+    private long _droppedEntryCount;
+    private int _disposed;
 
     /// <summary>
     /// Initializes a new instance of the FileLogWriter class.
     /// </summary>
     /// <param name="logger">Logger for diagnostic information.</param>
     /// <param name="logDirectory">Directory where log files are stored. If null, uses default application data directory.</param>
-    public FileLogWriter(ILogger<FileLogWriter> logger, string? logDirectory = null)
+    /// <param name="options">Queueing, batching and rotation options. If null, uses <see cref="FileLogWriterOptions.Default"/>.</param>
+    public FileLogWriter(ILogger<FileLogWriter> logger, string? logDirectory = null, FileLogWriterOptions? options = null)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
         _logDirectory = logDirectory ?? Path.Combine(
@@ -30,69 +49,92 @@ public class FileLogWriter : IFileLogWriter
             "MacroNex",
             "Logs");
         _logFileName = "MacroNex.log";
+        _options = options ?? FileLogWriterOptions.Default();
+
+        if (_options.QueueCapacity < 1)
+            throw new ArgumentOutOfRangeException(nameof(options), "Queue capacity must be at least 1.");
+        if (_options.MaxFileSizeBytes < 1)
+            throw new ArgumentOutOfRangeException(nameof(options), "Maximum file size must be positive.");
 
         Directory.CreateDirectory(_logDirectory);
+
+        _channel = Channel.CreateBounded<LogEntry>(new BoundedChannelOptions(_options.QueueCapacity)
+        {
+            SingleReader = true,
+            SingleWriter = false,
+            FullMode = BoundedChannelFullMode.Wait
+        });
+        _writerTask = Task.Run(WriteLoopAsync);
+
         _logger.LogDebug("FileLogWriter initialized with directory: {LogDirectory}", _logDirectory);
     }
 
+    /// <summary>
+    /// Gets the number of entries dropped because the queue was full (or the writer was disposed).
+    /// </summary>
+    public long DroppedEntryCount => Interlocked.Read(ref _droppedEntryCount);
+
     /// <inheritdoc />
-    public async Task WriteLogEntryAsync(LogEntry entry)
+    public Task WriteLogEntryAsync(LogEntry entry)
     {
         if (entry == null) throw new ArgumentNullException(nameof(entry));
 
-        var logFilePath = GetCurrentLogFilePath();
+        if (_channel.Writer.TryWrite(entry))
+            return Task.CompletedTask;
 
-        lock (_fileLock)
-        {
-            // Check if rotation is needed
-            if (File.Exists(logFilePath))
-            {
-                var fileInfo = new FileInfo(logFilePath);
-                if (fileInfo.Length >= MaxLogFileSize)
-                {
-                    RotateLogFiles();
-                }
-            }
+        if (_options.OverflowPolicy == LogOverflowPolicy.Wait && Volatile.Read(ref _disposed) == 0)
+            return WaitToEnqueueAsync(entry);
 
-            // Write log entry
-            var logLine = FormatLogEntry(entry);
-            File.AppendAllText(logFilePath, logLine + Environment.NewLine, Encoding.UTF8);
-        }
+        Interlocked.Increment(ref _droppedEntryCount);
+        return Task.CompletedTask;
+    }
 
-        await Task.CompletedTask;
+    private async Task WaitToEnqueueAsync(LogEntry entry)
+    {
+        try
+        {
+            await _channel.Writer.WriteAsync(entry).ConfigureAwait(false);
+        }
+        catch (ChannelClosedException)
+        {
+            Interlocked.Increment(ref _droppedEntryCount);
+        }
     }
 
     /// <inheritdoc />
     public async Task ClearLogsAsync()
     {
-        lock (_fileLock)
+        await _fileLock.WaitAsync().ConfigureAwait(false);
+        try
         {
-            try
+            // Close the open file first; the writer reopens it on the next batch
+            CloseStream();
+
+            // Delete all log files
+            var logFiles = Directory.GetFiles(_logDirectory, "MacroNex*.log");
+            foreach (var file in logFiles)
             {
-                // Delete all log files
-                var logFiles = Directory.GetFiles(_logDirectory, "MacroNex*.log");
-                foreach (var file in logFiles)
+                try
                 {
-                    try
-                    {
-                        File.Delete(file);
-                    }
-                    catch (Exception ex)
-                    {
-                        _logger.LogWarning(ex, "Failed to delete log file: {FilePath}", file);
-                    }
+                    File.Delete(file);
+                }
+                catch (Exception ex)
+                {
+                    _logger.LogWarning(ex, "Failed to delete log file: {FilePath}", file);
                 }
-
-                _logger.LogInformation("Cleared {Count} log files", logFiles.Length);
-            }
-            catch (Exception ex)
-            {
-                _logger.LogError(ex, "Failed to clear log files");
-                throw;
             }
-        }
 
-        await Task.CompletedTask;
+            _logger.LogInformation("Cleared {Count} log files", logFiles.Length);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to clear log files");
+            throw;
+        }
+        finally
+        {
+            _fileLock.Release();
+        }
     }
 
     /// <inheritdoc />
@@ -133,6 +175,203 @@ public class FileLogWriter : IFileLogWriter
         }
     }
 
+    /// <summary>
+    /// Stops accepting entries, writes everything already queued and closes the log file.
+    /// </summary>
+    public async ValueTask DisposeAsync()
+    {
+        if (Interlocked.Exchange(ref _disposed, 1) != 0)
+            return;
+
+        _channel.Writer.TryComplete();
+        _shutdown.Cancel();
+        await _writerTask.ConfigureAwait(false);
+        _shutdown.Dispose();
+
+        var dropped = DroppedEntryCount;
+        if (dropped > 0)
+        {
+            _logger.LogWarning("FileLogWriter dropped {Dropped} log entries because the queue was full", dropped);
+        }
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        DisposeAsync().AsTask().GetAwaiter().GetResult();
+        GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// Drains the queue in batches: a burst is written through one buffered stream and flushed when the
+    /// batch ends, when the flush interval elapses or when the unflushed size reaches the threshold.
+    /// </summary>
+    private async Task WriteLoopAsync()
+    {
+        var reader = _channel.Reader;
+        try
+        {
+            while (await reader.WaitToReadAsync().ConfigureAwait(false))
+            {
+                await WriteAvailableAsync(reader).ConfigureAwait(false);
+
+                // Let the rest of a burst accumulate so it is flushed with one write
+                if (_options.FlushInterval > TimeSpan.Zero && !_shutdown.IsCancellationRequested)
+                {
+                    try
+                    {
+                        await Task.Delay(_options.FlushInterval, _shutdown.Token).ConfigureAwait(false);
+                    }
+                    catch (OperationCanceledException)
+                    {
+                        // Disposing: write what is left without waiting
+                    }
+
+                    await WriteAvailableAsync(reader).ConfigureAwait(false);
+                }
+
+                await FlushAsync().ConfigureAwait(false);
+            }
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Log writer stopped unexpectedly");
+        }
+        finally
+        {
+            await _fileLock.WaitAsync().ConfigureAwait(false);
+            try
+            {
+                CloseStream();
+            }
+            finally
+            {
+                _fileLock.Release();
+            }
+        }
+    }
+
+    private async Task WriteAvailableAsync(ChannelReader<LogEntry> reader)
+    {
+        await _fileLock.WaitAsync().ConfigureAwait(false);
+        try
+        {
+            while (reader.TryRead(out var entry))
+            {
+                try
+                {
+                    WriteEntry(entry);
+                }
+                catch (Exception ex)
+                {
+                    // Drop the entry and reopen the file on the next one
+                    _logger.LogError(ex, "Failed to write log entry to {LogFile}", GetCurrentLogFilePath());
+                    Interlocked.Increment(ref _droppedEntryCount);
+                    CloseStream();
+                }
+            }
+        }
+        finally
+        {
+            _fileLock.Release();
+        }
+    }
+
+    private async Task FlushAsync()
+    {
+        await _fileLock.WaitAsync().ConfigureAwait(false);
+        try
+        {
+            FlushStream();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Failed to flush log file {LogFile}", GetCurrentLogFilePath());
+            CloseStream();
+        }
+        finally
+        {
+            _fileLock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Appends one formatted entry, rotating first if the file has reached its size limit. Caller holds _fileLock.
+    /// </summary>
+    private void WriteEntry(LogEntry entry)
+    {
+        var line = FormatLogEntry(entry) + Environment.NewLine;
+        var maxBytes = LogEncoding.GetMaxByteCount(line.Length);
+        if (_encodeBuffer.Length < maxBytes)
+            _encodeBuffer = new byte[Math.Max(maxBytes, _encodeBuffer.Length * 2)];
+        var byteCount = LogEncoding.GetBytes(line, 0, line.Length, _encodeBuffer, 0);
+
+        var stream = _stream ?? OpenStream();
+        if (_fileSize > 0 && _fileSize + byteCount > _options.MaxFileSizeBytes)
+        {
+            CloseStream();
+            RotateLogFiles();
+            stream = OpenStream();
+        }
+
+        stream.Write(_encodeBuffer, 0, byteCount);
+        _fileSize += byteCount;
+        _unflushedBytes += byteCount;
+
+        if (_unflushedBytes >= _options.FlushThresholdBytes)
+            FlushStream();
+    }
+
+    private FileStream OpenStream()
+    {
+        var stream = new FileStream(
+            GetCurrentLogFilePath(),
+            FileMode.Append,
+            FileAccess.Write,
+            FileShare.Read | FileShare.Delete,
+            FileBufferSize);
+
+        if (stream.Length == 0)
+        {
+            // New file: mark it as UTF-8 like File.AppendAllText did
+            var preamble = Encoding.UTF8.GetPreamble();
+            stream.Write(preamble, 0, preamble.Length);
+        }
+
+        _stream = stream;
+        _fileSize = stream.Length;
+        _unflushedBytes = 0;
+        return stream;
+    }
+
+    private void FlushStream()
+    {
+        if (_stream == null || _unflushedBytes == 0)
+            return;
+
+        _stream.Flush();
+        _unflushedBytes = 0;
+    }
+
+    private void CloseStream()
+    {
+        if (_stream == null)
+            return;
+
+        try
+        {
+            _stream.Dispose();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "Failed to close log file {LogFile}", GetCurrentLogFilePath());
+        }
+
+        _stream = null;
+        _fileSize = 0;
+        _unflushedBytes = 0;
+    }
+
     private string GetCurrentLogFilePath()
     {
         return Path.Combine(_logDirectory, _logFileName);
@@ -211,3 +450,55 @@ public class FileLogWriter : IFileLogWriter
         return sb.ToString();
     }
 }
+
+/// <summary>
+/// What <see cref="FileLogWriter"/> does when its queue is full.
+/// </summary>
+public enum LogOverflowPolicy
+{
+    /// <summary>
+    /// Drop the new entry and count it; the caller never waits.
+    /// </summary>
+    Drop,
+
+    /// <summary>
+    /// Wait asynchronously until the writer has room.
+    /// </summary>
+    Wait
+}
+
+/// <summary>
+/// Queueing, batching and rotation options for <see cref="FileLogWriter"/>.
+/// </summary>
+public class FileLogWriterOptions
+{
+    /// <summary>
+    /// Maximum number of queued entries not yet written.
+    /// </summary>
+    public int QueueCapacity { get; set; } = 8192;
+
+    /// <summary>
+    /// What to do when the queue is full.
+    /// </summary>
+    public LogOverflowPolicy OverflowPolicy { get; set; } = LogOverflowPolicy.Drop;
+
+    /// <summary>
+    /// How long a batch may accumulate before it is flushed; zero flushes after every drained batch.
+    /// </summary>
+    public TimeSpan FlushInterval { get; set; } = TimeSpan.FromMilliseconds(200);
+
+    /// <summary>
+    /// Unflushed bytes that force a flush before the interval elapses.
+    /// </summary>
+    public int FlushThresholdBytes { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// Size at which the current log file is rotated.
+    /// </summary>
+    public long MaxFileSizeBytes { get; set; } = 10 * 1024 * 1024; // 10 MB
+
+    /// <summary>
+    /// Creates the default options.
+    /// </summary>
+    public static FileLogWriterOptions Default() => new();
+}
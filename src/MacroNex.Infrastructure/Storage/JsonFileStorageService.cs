@@ -1,5 +1,6 @@
 using System.Text.Json;
 using System.Text.Json.Serialization;
+using System.Text.Json.Serialization.Metadata;
 using System.Globalization;
 using MacroNex.Domain.Entities;
 using MacroNex.Domain.Interfaces;
@@ -11,13 +12,34 @@ namespace MacroNex.Infrastructure.Storage;
 /// <summary>
 /// JSON-based file storage service implementation.
 /// Handles serialization, deserialization, and versioned schema support.
+/// Scripts are stored one file per script under <c>scripts/</c>, with a small index that keeps library order
+/// and each script's metadata, so listing the library never reads script bodies and saving a script
+/// rewrites only that script (plus the index when its metadata changed). Every write goes to a temp file that is then renamed over the target.
+/// Serialization uses the source-generated <see cref="StorageJsonContext"/>, so no reflection metadata is built at startup.
+/// Compact scripts (see <see cref="Script.Compact"/>) store their commands as one binary <see cref="CommandBufferSerializer"/>
+/// blob instead of a JSON object per command, and load back compact.
 /// </summary>
-public class JsonFileStorageService : IFileStorageService
+public partial class JsonFileStorageService : IFileStorageService
 {
+    /// <summary>
+    /// Schema version of the single-file format (legacy library file, import and export).
+    /// </summary>
+    private const string SingleFileSchemaVersion = "1.0";
+
+    /// <summary>
+    /// Schema version of the sharded library (index plus one file per script).
+    /// </summary>
+    private const string ShardedSchemaVersion = "2.0";
+
+    private const string IndexFileName = "index.json";
+    private const string TempFileSuffix = ".tmp";
+
     private readonly ILogger<JsonFileStorageService> _logger;
     private readonly string _storageDirectory;
     private readonly string _scriptsFilePath;
-    private readonly JsonSerializerOptions _jsonOptions;
+    private readonly string _scriptsDirectory;
+    private readonly string _indexFilePath;
+    private readonly SemaphoreSlim _ioLock = new(1, 1);
 
     /// <summary>
     /// Initializes a new instance of the JsonFileStorageService class.
@@ -41,61 +63,48 @@ public class JsonFileStorageService : IFileStorageService
             _storageDirectory = storageDirectory;
         }
         _scriptsFilePath = Path.Combine(_storageDirectory, "scripts.json");
+        _scriptsDirectory = Path.Combine(_storageDirectory, "scripts");
+        _indexFilePath = Path.Combine(_scriptsDirectory, IndexFileName);
 
-        // Ensure storage directory exists
+        // Ensure storage directories exist
         Directory.CreateDirectory(_storageDirectory);
+        Directory.CreateDirectory(_scriptsDirectory);
 
-        // Configure JSON serialization options
-        _jsonOptions = new JsonSerializerOptions
-        {
-            PropertyNamingPolicy = JsonNamingPolicy.CamelCase,
-            WriteIndented = true,
-            DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull,
-            Converters =
-            {
-                new CommandJsonConverter(),
-                new TimeSpanJsonConverter(),
-                new DateTimeJsonConverter()
-            }
-        };
-
-        _logger.LogDebug("JsonFileStorageService initialized. Storage path: {StoragePath}", _scriptsFilePath);
+        _logger.LogDebug("JsonFileStorageService initialized. Storage path: {StoragePath}", _scriptsDirectory);
     }
 
     /// <inheritdoc />
     public async Task<IEnumerable<Script>> LoadScriptsAsync()
     {
+        await _ioLock.WaitAsync();
         try
         {
-            if (!File.Exists(_scriptsFilePath))
-            {
-                _logger.LogInformation("Scripts file does not exist. Returning empty collection.");
-                return Array.Empty<Script>();
-            }
+            var index = await ReadIndexAsync(recoverOrphans: true);
 
-            _logger.LogDebug("Loading scripts from {FilePath}", _scriptsFilePath);
+            _logger.LogDebug("Loading {Count} scripts from {Directory}", index.Count, _scriptsDirectory);
 
-            var jsonContent = await File.ReadAllTextAsync(_scriptsFilePath);
-
-            if (string.IsNullOrWhiteSpace(jsonContent))
+            var scripts = new List<Script>(index.Count);
+            var missing = new List<ScriptIndexEntry>();
+            foreach (var entry in index)
             {
-                _logger.LogWarning("Scripts file is empty. Returning empty collection.");
-                return Array.Empty<Script>();
-            }
+                var dto = await ReadShardAsync(entry.Id);
+                if (dto == null)
+                {
+                    missing.Add(entry);
+                    continue;
+                }
 
-            var storageModel = JsonSerializer.Deserialize<ScriptStorageModel>(jsonContent, _jsonOptions);
+                scripts.Add(ConvertToScript(dto));
+            }
 
-            if (storageModel == null)
+            if (missing.Count > 0)
             {
-                _logger.LogWarning("Failed to deserialize scripts file. Returning empty collection.");
-                return Array.Empty<Script>();
+                // Shard files are authoritative; drop index entries whose file is gone
+                _logger.LogWarning("Dropping {Count} index entries without a script file", missing.Count);
+                index.RemoveAll(missing.Contains);
+                await WriteIndexAsync(index);
             }
 
-            // Handle schema migration if needed
-            var migratedModel = MigrateSchema(storageModel);
-
-            var scripts = migratedModel.Scripts.Select(s => ConvertToScript(s)).ToList();
-
             _logger.LogInformation("Loaded {Count} scripts from storage", scripts.Count);
 
             return scripts;
@@ -105,11 +114,91 @@ public class JsonFileStorageService : IFileStorageService
             _logger.LogError(ex, "JSON parsing error while loading scripts");
             throw new StorageException($"Failed to parse scripts file: {ex.Message}", ex);
         }
-        catch (Exception ex)
+        catch (Exception ex) when (!(ex is StorageException))
         {
             _logger.LogError(ex, "Error loading scripts from storage");
             throw new StorageException($"Failed to load scripts: {ex.Message}", ex);
         }
+        finally
+        {
+            _ioLock.Release();
+        }
+    }
+
+    /// <inheritdoc />
+    public async Task<IEnumerable<ScriptMetadata>> LoadScriptMetadataAsync()
+    {
+        await _ioLock.WaitAsync();
+        try
+        {
+            var index = await ReadIndexAsync(recoverOrphans: true);
+
+            // Entries without metadata (recovered orphans) are filled once from their script file
+            var incomplete = index.Where(e => !e.HasMetadata).ToList();
+            if (incomplete.Count > 0)
+            {
+                foreach (var entry in incomplete)
+                {
+                    var dto = await ReadShardAsync(entry.Id);
+                    if (dto == null)
+                    {
+                        index.Remove(entry);
+                        continue;
+                    }
+
+                    entry.Update(dto);
+                }
+
+                await WriteIndexAsync(index);
+            }
+
+            var metadata = index.Select(ConvertToMetadata).ToList();
+
+            _logger.LogInformation("Loaded metadata for {Count} scripts", metadata.Count);
+
+            return metadata;
+        }
+        catch (JsonException ex)
+        {
+            _logger.LogError(ex, "JSON parsing error while loading script metadata");
+            throw new StorageException($"Failed to parse script index: {ex.Message}", ex);
+        }
+        catch (Exception ex) when (!(ex is StorageException))
+        {
+            _logger.LogError(ex, "Error loading script metadata");
+            throw new StorageException($"Failed to load script metadata: {ex.Message}", ex);
+        }
+        finally
+        {
+            _ioLock.Release();
+        }
+    }
+
+    /// <inheritdoc />
+    public async Task<Script?> LoadScriptAsync(Guid id)
+    {
+        await _ioLock.WaitAsync();
+        try
+        {
+            _logger.LogDebug("Loading script {ScriptId}", id);
+
+            var dto = await ReadShardAsync(id);
+            return dto != null ? ConvertToScript(dto) : null;
+        }
+        catch (JsonException ex)
+        {
+            _logger.LogError(ex, "JSON parsing error while loading script {ScriptId}", id);
+            throw new StorageException($"Failed to parse script file: {ex.Message}", ex);
+        }
+        catch (Exception ex) when (!(ex is StorageException))
+        {
+            _logger.LogError(ex, "Error loading script {ScriptId}", id);
+            throw new StorageException($"Failed to load script: {ex.Message}", ex);
+        }
+        finally
+        {
+            _ioLock.Release();
+        }
     }
 
     /// <inheritdoc />
@@ -118,36 +207,40 @@ public class JsonFileStorageService : IFileStorageService
         if (script == null)
             throw new ArgumentNullException(nameof(script));
 
+        await _ioLock.WaitAsync();
         try
         {
             _logger.LogDebug("Saving script {ScriptId} ({ScriptName})", script.Id, script.Name);
 
-            // Load all existing scripts
-            var allScripts = (await LoadScriptsAsync()).ToList();
+            var index = await ReadIndexAsync(recoverOrphans: false);
 
-            // Remove the script if it already exists, then add the updated version
-            var existingIndex = allScripts.FindIndex(s => s.Id == script.Id);
-            if (existingIndex >= 0)
+            // Write the script first so a crash never leaves an index entry pointing at nothing
+            var dto = ConvertToScriptDto(script);
+            var shard = new ScriptShardModel
             {
-                allScripts[existingIndex] = script;
-                _logger.LogDebug("Updated existing script {ScriptId}", script.Id);
-            }
-            else
+                Version = ShardedSchemaVersion,
+                Script = dto
+            };
+            await WriteJsonAtomicAsync(GetShardPath(script.Id), shard, StorageJsonContext.Default.ScriptShardModel);
+
+            // The index only changes when the library membership or the script's metadata changes
+            var entry = index.Find(e => e.Id == script.Id);
+            if (entry == null)
             {
-                allScripts.Add(script);
+                entry = new ScriptIndexEntry { Id = script.Id };
+                entry.Update(dto);
+                index.Add(entry);
+                await WriteIndexAsync(index);
                 _logger.LogDebug("Added new script {ScriptId}", script.Id);
             }
-
-            // Convert to storage model
-            var storageModel = new ScriptStorageModel
+            else
             {
-                Version = "1.0",
-                Scripts = allScripts.Select(ConvertToScriptDto).ToList()
-            };
-
-            // Serialize and save
-            var jsonContent = JsonSerializer.Serialize(storageModel, _jsonOptions);
-            await File.WriteAllTextAsync(_scriptsFilePath, jsonContent);
+                if (entry.Update(dto))
+                {
+                    await WriteIndexAsync(index);
+                }
+                _logger.LogDebug("Updated existing script {ScriptId}", script.Id);
+            }
 
             _logger.LogDebug("Successfully saved script {ScriptId}", script.Id);
         }
@@ -156,35 +249,36 @@ public class JsonFileStorageService : IFileStorageService
             _logger.LogError(ex, "Error saving script {ScriptId}", script.Id);
             throw new StorageException($"Failed to save script: {ex.Message}", ex);
         }
+        finally
+        {
+            _ioLock.Release();
+        }
     }
 
     /// <inheritdoc />
     public async Task<bool> DeleteScriptAsync(Guid id)
     {
+        await _ioLock.WaitAsync();
         try
         {
             _logger.LogDebug("Deleting script {ScriptId}", id);
 
-            var allScripts = (await LoadScriptsAsync()).ToList();
-            var scriptToDelete = allScripts.FirstOrDefault(s => s.Id == id);
+            var index = await ReadIndexAsync(recoverOrphans: false);
+            var shardPath = GetShardPath(id);
+            var removed = index.RemoveAll(e => e.Id == id) > 0;
 
-            if (scriptToDelete == null)
+            if (!removed && !File.Exists(shardPath))
             {
                 _logger.LogWarning("Script {ScriptId} not found for deletion", id);
                 return false;
             }
 
-            allScripts.Remove(scriptToDelete);
-
-            // Save updated collection
-            var storageModel = new ScriptStorageModel
+            // Delete the script before the index so a crash cannot resurrect it as an orphan
+            File.Delete(shardPath);
+            if (removed)
             {
-                Version = "1.0",
-                Scripts = allScripts.Select(ConvertToScriptDto).ToList()
-            };
-
-            var jsonContent = JsonSerializer.Serialize(storageModel, _jsonOptions);
-            await File.WriteAllTextAsync(_scriptsFilePath, jsonContent);
+                await WriteIndexAsync(index);
+            }
 
             _logger.LogInformation("Successfully deleted script {ScriptId}", id);
             return true;
@@ -194,6 +288,10 @@ public class JsonFileStorageService : IFileStorageService
             _logger.LogError(ex, "Error deleting script {ScriptId}", id);
             throw new StorageException($"Failed to delete script: {ex.Message}", ex);
         }
+        finally
+        {
+            _ioLock.Release();
+        }
     }
 
     /// <inheritdoc />
@@ -210,7 +308,7 @@ public class JsonFileStorageService : IFileStorageService
             _logger.LogDebug("Importing script from {FilePath}", filePath);
 
             var jsonContent = await File.ReadAllTextAsync(filePath);
-            var storageModel = JsonSerializer.Deserialize<ScriptStorageModel>(jsonContent, _jsonOptions);
+            var storageModel = JsonSerializer.Deserialize(jsonContent, StorageJsonContext.Default.ScriptStorageModel);
 
             if (storageModel == null || storageModel.Scripts.Count == 0)
             {
@@ -262,11 +360,11 @@ public class JsonFileStorageService : IFileStorageService
 
             var storageModel = new ScriptStorageModel
             {
-                Version = "1.0",
+                Version = SingleFileSchemaVersion,
                 Scripts = new List<ScriptDto> { ConvertToScriptDto(script) }
             };
 
-            var jsonContent = JsonSerializer.Serialize(storageModel, _jsonOptions);
+            var jsonContent = JsonSerializer.Serialize(storageModel, StorageJsonContext.Default.ScriptStorageModel);
             await File.WriteAllTextAsync(filePath, jsonContent);
 
             _logger.LogInformation("Successfully exported script {ScriptId} to {FilePath}", script.Id, filePath);
@@ -278,17 +376,138 @@ public class JsonFileStorageService : IFileStorageService
         }
     }
 
+    /// <summary>
+    /// Reads the library index, migrating the legacy single-file library on first use.
+    /// The index is small and re-read per call so several service instances can share a directory.
+    /// Caller holds _ioLock.
+    /// </summary>
+    private async Task<List<ScriptIndexEntry>> ReadIndexAsync(bool recoverOrphans)
+    {
+        List<ScriptIndexEntry> index;
+        if (File.Exists(_indexFilePath))
+        {
+            await using var stream = File.OpenRead(_indexFilePath);
+            var model = await JsonSerializer.DeserializeAsync(stream, StorageJsonContext.Default.ScriptIndexModel);
+            index = model?.Scripts ?? new List<ScriptIndexEntry>();
+        }
+        else if (File.Exists(_scriptsFilePath))
+        {
+            index = await MigrateLegacyLibraryAsync();
+        }
+        else
+        {
+            index = new List<ScriptIndexEntry>();
+        }
+
+        if (!recoverOrphans)
+            return index;
+
+        // Scripts written just before a crash may not have reached the index yet
+        var known = index.Select(e => e.Id).ToHashSet();
+        var orphans = Directory.EnumerateFiles(_scriptsDirectory, "*.json")
+            .Where(path => Path.GetExtension(path) == ".json" && !string.Equals(Path.GetFileName(path), IndexFileName, StringComparison.OrdinalIgnoreCase))
+            .Select(path => Guid.TryParseExact(Path.GetFileNameWithoutExtension(path), "N", out var id) ? id : Guid.Empty)
+            .Where(id => id != Guid.Empty && !known.Contains(id))
+            .OrderBy(id => id)
+            .ToList();
+        if (orphans.Count > 0)
+        {
+            _logger.LogWarning("Recovered {Count} script files missing from the index", orphans.Count);
+            index.AddRange(orphans.Select(id => new ScriptIndexEntry { Id = id }));
+            await WriteIndexAsync(index);
+        }
+
+        return index;
+    }
+
+    /// <summary>
+    /// Splits the legacy scripts.json into per-script files and keeps the original as scripts.json.bak.
+    /// </summary>
+    private async Task<List<ScriptIndexEntry>> MigrateLegacyLibraryAsync()
+    {
+        _logger.LogInformation("Migrating {FilePath} to per-script storage", _scriptsFilePath);
+
+        var jsonContent = await File.ReadAllTextAsync(_scriptsFilePath);
+        var index = new List<ScriptIndexEntry>();
+
+        if (!string.IsNullOrWhiteSpace(jsonContent))
+        {
+            var storageModel = JsonSerializer.Deserialize(jsonContent, StorageJsonContext.Default.ScriptStorageModel);
+            if (storageModel != null)
+            {
+                foreach (var dto in MigrateSchema(storageModel).Scripts)
+                {
+                    await WriteJsonAtomicAsync(GetShardPath(dto.Id), new ScriptShardModel { Version = ShardedSchemaVersion, Script = dto }, StorageJsonContext.Default.ScriptShardModel);
+                    var entry = new ScriptIndexEntry { Id = dto.Id };
+                    entry.Update(dto);
+                    index.Add(entry);
+                }
+            }
+        }
+
+        await WriteIndexAsync(index);
+        File.Move(_scriptsFilePath, _scriptsFilePath + ".bak", overwrite: true);
+
+        _logger.LogInformation("Migrated {Count} scripts to per-script storage", index.Count);
+        return index;
+    }
+
+    /// <summary>
+    /// Reads one script file, or returns null if it does not exist.
+    /// </summary>
+    private async Task<ScriptDto?> ReadShardAsync(Guid id)
+    {
+        var path = GetShardPath(id);
+        if (!File.Exists(path))
+        {
+            _logger.LogWarning("Script file for {ScriptId} is missing", id);
+            return null;
+        }
+
+        await using var stream = File.OpenRead(path);
+        var shard = await JsonSerializer.DeserializeAsync(stream, StorageJsonContext.Default.ScriptShardModel);
+        if (shard?.Script == null)
+        {
+            throw new StorageException($"Script file for {id} is empty or invalid.");
+        }
+
+        return shard.Script;
+    }
+
+    private Task WriteIndexAsync(List<ScriptIndexEntry> index)
+    {
+        return WriteJsonAtomicAsync(_indexFilePath, new ScriptIndexModel { Version = ShardedSchemaVersion, Scripts = index }, StorageJsonContext.Default.ScriptIndexModel);
+    }
+
+    /// <summary>
+    /// Serializes to a temp file next to the target and renames it over the target,
+    /// so readers see either the old or the new file, never a partial one.
+    /// </summary>
+    private async Task WriteJsonAtomicAsync<T>(string path, T value, JsonTypeInfo<T> typeInfo)
+    {
+        var tempPath = path + TempFileSuffix;
+        await using (var stream = new FileStream(tempPath, FileMode.Create, FileAccess.Write, FileShare.None, 4096, FileOptions.Asynchronous))
+        {
+            await JsonSerializer.SerializeAsync(stream, value, typeInfo);
+            stream.Flush(flushToDisk: true);
+        }
+
+        File.Move(tempPath, path, overwrite: true);
+    }
+
+    private string GetShardPath(Guid id) => Path.Combine(_scriptsDirectory, id.ToString("N") + ".json");
+
     /// <summary>
     /// Migrates the storage model to the current schema version if needed.
     /// </summary>
     private ScriptStorageModel MigrateSchema(ScriptStorageModel model)
     {
-        if (model.Version == "1.0")
+        if (model.Version == SingleFileSchemaVersion)
         {
             return model; // Already at current version
         }
 
-        _logger.LogInformation("Migrating schema from version {OldVersion} to 1.0", model.Version);
+        _logger.LogInformation("Migrating schema from version {OldVersion} to {Version}", model.Version, SingleFileSchemaVersion);
 
         // For now, we only support version 1.0
         // Future versions would have migration logic here
@@ -300,22 +519,31 @@ public class JsonFileStorageService : IFileStorageService
     /// </summary>
     private ScriptDto ConvertToScriptDto(Script script)
     {
+        // Packing is opt-in: only scripts the caller compacted are stored packed
+        var packed = script.CommandBuffer;
+
         return new ScriptDto
         {
             Id = script.Id,
             Name = script.Name,
             CreatedAt = script.CreatedAt,
             ModifiedAt = script.ModifiedAt,
-            Commands = script.Commands.Select(ConvertToCommandDto).ToList(),
+            Commands = packed != null ? new List<CommandDto>() : script.Commands.Select(ConvertToCommandDto).ToList(),
+            PackedCommands = packed != null ? CommandBufferSerializer.Serialize(packed) : null,
             SourceText = script.SourceText,
-            TriggerHotkey = script.TriggerHotkey != null ? new HotkeyDto
-            {
-                Id = script.TriggerHotkey.Id,
-                Name = script.TriggerHotkey.Name,
-                Modifiers = script.TriggerHotkey.Modifiers.ToString(),
-                Key = script.TriggerHotkey.Key.ToString(),
-                TriggerMode = script.TriggerHotkey.TriggerMode.ToString()
-            } : null
+            TriggerHotkey = script.TriggerHotkey != null ? ConvertToHotkeyDto(script.TriggerHotkey) : null
+        };
+    }
+
+    private static HotkeyDto ConvertToHotkeyDto(HotkeyDefinition hotkey)
+    {
+        return new HotkeyDto
+        {
+            Id = hotkey.Id,
+            Name = hotkey.Name,
+            Modifiers = hotkey.Modifiers.ToString(),
+            Key = hotkey.Key.ToString(),
+            TriggerMode = hotkey.TriggerMode.ToString()
         };
     }
 
@@ -341,52 +569,34 @@ public class JsonFileStorageService : IFileStorageService
         };
 
         // Set type-specific parameters
-        switch (command)
+        dto.Parameters = command switch
         {
-            case MouseMoveCommand moveCmd:
-                dto.Parameters = new Dictionary<string, object?>
-                {
-                    ["x"] = moveCmd.Position.X,
-                    ["y"] = moveCmd.Position.Y
-                };
-                break;
-
-            case MouseClickCommand clickCmd:
-                dto.Parameters = new Dictionary<string, object?>
-                {
-                    ["button"] = clickCmd.Button.ToString(),
-                    ["clickType"] = clickCmd.Type.ToString()
-                };
-                break;
-
-            case KeyboardCommand keyCmd:
-                var keyParams = new Dictionary<string, object?>();
-                if (!string.IsNullOrEmpty(keyCmd.Text))
-                {
-                    keyParams["text"] = keyCmd.Text;
-                }
-                if (keyCmd.Keys.Count > 0)
-                {
-                    keyParams["keys"] = keyCmd.Keys.Select(k => k.ToString()).ToList();
-                }
-                dto.Parameters = keyParams;
-                break;
-
-            case KeyPressCommand kp:
-                dto.Parameters = new Dictionary<string, object?>
-                {
-                    ["key"] = kp.Key.ToString(),
-                    ["isDown"] = kp.IsDown
-                };
-                break;
-
-            case SleepCommand sleepCmd:
-                dto.Parameters = new Dictionary<string, object?>
-                {
-                    ["duration"] = sleepCmd.Duration
-                };
-                break;
-        }
+            MouseMoveCommand moveCmd => new CommandParametersDto
+            {
+                X = moveCmd.Position.X,
+                Y = moveCmd.Position.Y
+            },
+            MouseClickCommand clickCmd => new CommandParametersDto
+            {
+                Button = clickCmd.Button.ToString(),
+                ClickType = clickCmd.Type.ToString()
+            },
+            KeyboardCommand keyCmd => new CommandParametersDto
+            {
+                Text = string.IsNullOrEmpty(keyCmd.Text) ? null : keyCmd.Text,
+                Keys = keyCmd.Keys.Count > 0 ? keyCmd.Keys.Select(k => k.ToString()).ToList() : null
+            },
+            KeyPressCommand kp => new CommandParametersDto
+            {
+                Key = kp.Key.ToString(),
+                IsDown = kp.IsDown
+            },
+            SleepCommand sleepCmd => new CommandParametersDto
+            {
+                Duration = sleepCmd.Duration
+            },
+            _ => null
+        };
 
         return dto;
     }
@@ -396,73 +606,94 @@ public class JsonFileStorageService : IFileStorageService
     /// </summary>
     private Script ConvertToScript(ScriptDto dto)
     {
-        var commands = dto.Commands.Select(ConvertToCommand).ToList();
-
-        HotkeyDefinition? triggerHotkey = null;
-        if (dto.TriggerHotkey != null)
+        if (dto.PackedCommands is { Length: > 0 } packed)
         {
-            try
-            {
-                var modifiers = Enum.Parse<HotkeyModifiers>(dto.TriggerHotkey.Modifiers);
-                var key = Enum.Parse<VirtualKey>(dto.TriggerHotkey.Key);
-                // Parse TriggerMode, default to Once if not present (for backward compatibility)
-                var triggerMode = HotkeyTriggerMode.Once;
-                if (!string.IsNullOrEmpty(dto.TriggerHotkey.TriggerMode))
-                {
-                    if (Enum.TryParse<HotkeyTriggerMode>(dto.TriggerHotkey.TriggerMode, out var parsedMode))
-                    {
-                        triggerMode = parsedMode;
-                    }
-                }
-                triggerHotkey = new HotkeyDefinition(
-                    dto.TriggerHotkey.Id,
-                    dto.TriggerHotkey.Name,
-                    modifiers,
-                    key,
-                    triggerMode
-                );
-            }
-            catch (Exception ex)
-            {
-                _logger.LogWarning(ex, "Failed to parse trigger hotkey for script {ScriptId}", dto.Id);
-            }
+            return new Script(
+                dto.Id,
+                dto.Name,
+                CommandBufferSerializer.Deserialize(packed),
+                dto.CreatedAt,
+                dto.ModifiedAt,
+                ConvertToHotkey(dto.TriggerHotkey, dto.Id),
+                dto.SourceText);
         }
 
+        var commands = dto.Commands.Select(ConvertToCommand).ToList();
+
         return new Script(
             dto.Id,
             dto.Name,
             commands,
             dto.CreatedAt,
             dto.ModifiedAt,
-            triggerHotkey,
+            ConvertToHotkey(dto.TriggerHotkey, dto.Id),
             dto.SourceText
         );
     }
 
+    /// <summary>
+    /// Converts an index entry to ScriptMetadata.
+    /// </summary>
+    private ScriptMetadata ConvertToMetadata(ScriptIndexEntry entry)
+    {
+        return new ScriptMetadata(
+            entry.Id,
+            entry.Name ?? string.Empty,
+            entry.CreatedAt ?? default,
+            entry.ModifiedAt ?? default,
+            ConvertToHotkey(entry.TriggerHotkey, entry.Id),
+            entry.SourceTextLength ?? 0);
+    }
+
+    private HotkeyDefinition? ConvertToHotkey(HotkeyDto? dto, Guid scriptId)
+    {
+        if (dto == null)
+            return null;
+
+        try
+        {
+            var modifiers = Enum.Parse<HotkeyModifiers>(dto.Modifiers);
+            var key = Enum.Parse<VirtualKey>(dto.Key);
+            // Parse TriggerMode, default to Once if not present (for backward compatibility)
+            var triggerMode = HotkeyTriggerMode.Once;
+            if (!string.IsNullOrEmpty(dto.TriggerMode))
+            {
+                if (Enum.TryParse<HotkeyTriggerMode>(dto.TriggerMode, out var parsedMode))
+                {
+                    triggerMode = parsedMode;
+                }
+            }
+            return new HotkeyDefinition(
+                dto.Id,
+                dto.Name,
+                modifiers,
+                key,
+                triggerMode
+            );
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "Failed to parse trigger hotkey for script {ScriptId}", scriptId);
+            return null;
+        }
+    }
+
     /// <summary>
     /// Converts a CommandDto to a Command entity.
     /// </summary>
     private Command ConvertToCommand(CommandDto dto)
     {
+        var parameters = dto.Parameters;
         return dto.Type switch
         {
-            "MouseMove" => new MouseMoveCommand(
+            // Legacy: MouseMoveLowLevel is read back as MouseMoveCommand for backward compatibility
+            "MouseMove" or "MouseMoveLowLevel" => new MouseMoveCommand(
                 dto.Id,
                 dto.Delay,
                 dto.CreatedAt,
                 new Point(
-                    GetIntParameter(dto.Parameters, "x"),
-                    GetIntParameter(dto.Parameters, "y")
-                )
-            ),
-            // Legacy: convert old MouseMoveLowLevel to MouseMoveCommand for backward compatibility
-            "MouseMoveLowLevel" => new MouseMoveCommand(
-                dto.Id,
-                dto.Delay,
-                dto.CreatedAt,
-                new Point(
-                    GetIntParameter(dto.Parameters, "x"),
-                    GetIntParameter(dto.Parameters, "y")
+                    GetRequiredParameter(parameters?.X, "x"),
+                    GetRequiredParameter(parameters?.Y, "y")
                 )
             ),
 
@@ -470,127 +701,112 @@ public class JsonFileStorageService : IFileStorageService
                 dto.Id,
                 dto.Delay,
                 dto.CreatedAt,
-                Enum.Parse<MouseButton>(GetStringParameter(dto.Parameters, "button")),
-                Enum.Parse<ClickType>(GetStringParameter(dto.Parameters, "clickType"))
+                Enum.Parse<MouseButton>(GetRequiredParameter(parameters?.Button, "button")),
+                Enum.Parse<ClickType>(GetRequiredParameter(parameters?.ClickType, "clickType"))
             ),
 
             "KeyPress" => new KeyPressCommand(
                 dto.Id,
                 dto.Delay,
                 dto.CreatedAt,
-                Enum.Parse<VirtualKey>(GetStringParameter(dto.Parameters, "key")),
-                GetBoolParameter(dto.Parameters, "isDown")
+                Enum.Parse<VirtualKey>(GetRequiredParameter(parameters?.Key, "key")),
+                GetRequiredParameter(parameters?.IsDown, "isDown")
             ),
 
             "Keyboard" => new KeyboardCommand(
                 dto.Id,
                 dto.Delay,
                 dto.CreatedAt,
-                dto.Parameters != null && dto.Parameters.ContainsKey("text") ? GetStringParameter(dto.Parameters, "text") : null,
-                dto.Parameters != null && dto.Parameters.ContainsKey("keys")
-                    ? GetStringListParameter(dto.Parameters, "keys")
-                        .Select(k => Enum.Parse<VirtualKey>(k))
-                        .ToList()
-                    : new List<VirtualKey>()
+                parameters?.Text,
+                parameters?.Keys?.Select(Enum.Parse<VirtualKey>).ToList() ?? new List<VirtualKey>()
             ),
 
             "Sleep" => new SleepCommand(
                 dto.Id,
                 dto.Delay,
                 dto.CreatedAt,
-                GetTimeSpanParameter(dto.Parameters, "duration")
+                GetRequiredParameter(parameters?.Duration, "duration")
             ),
 
             _ => throw new NotSupportedException($"Unsupported command type: {dto.Type}")
         };
     }
 
-    private bool GetBoolParameter(Dictionary<string, object?>? parameters, string key)
+    private static T GetRequiredParameter<T>(T? value, string key) where T : struct
     {
-        if (parameters == null || !parameters.TryGetValue(key, out var value))
-            throw new StorageException($"Missing required parameter '{key}' in command");
-
-        return value switch
-        {
-            bool b => b,
-            JsonElement element when element.ValueKind == JsonValueKind.True => true,
-            JsonElement element when element.ValueKind == JsonValueKind.False => false,
-            JsonElement element when element.ValueKind == JsonValueKind.String => bool.Parse(element.GetString() ?? "false"),
-            string s => bool.Parse(s),
-            _ => throw new StorageException($"Invalid parameter type for '{key}': expected boolean")
-        };
+        return value ?? throw new StorageException($"Missing required parameter '{key}' in command");
     }
 
-    private int GetIntParameter(Dictionary<string, object?>? parameters, string key)
+    private static string GetRequiredParameter(string? value, string key)
     {
-        if (parameters == null || !parameters.TryGetValue(key, out var value))
-            throw new StorageException($"Missing required parameter '{key}' in command");
-
-        return value switch
-        {
-            int i => i,
-            long l => (int)l,
-            JsonElement element when element.ValueKind == JsonValueKind.Number => element.GetInt32(),
-            _ => throw new StorageException($"Invalid parameter type for '{key}': expected integer")
-        };
+        return value ?? throw new StorageException($"Missing required parameter '{key}' in command");
     }
 
-    private string GetStringParameter(Dictionary<string, object?>? parameters, string key)
-    {
-        if (parameters == null || !parameters.TryGetValue(key, out var value))
-            throw new StorageException($"Missing required parameter '{key}' in command");
+    #region Data Transfer Objects
 
-        return value switch
-        {
-            string s => s,
-            JsonElement element when element.ValueKind == JsonValueKind.String => element.GetString() ?? string.Empty,
-            _ => throw new StorageException($"Invalid parameter type for '{key}': expected string")
-        };
+    /// <summary>
+    /// Storage model for scripts collection with versioning.
+    /// </summary>
+    private class ScriptStorageModel
+    {
+        public string Version { get; set; } = "1.0";
+        public List<ScriptDto> Scripts { get; set; } = new();
     }
 
-    private List<string> GetStringListParameter(Dictionary<string, object?>? parameters, string key)
+    /// <summary>
+    /// Library index: script ids in library order.
+    /// </summary>
+    private class ScriptIndexModel
     {
-        if (parameters == null || !parameters.TryGetValue(key, out var value))
-            throw new StorageException($"Missing required parameter '{key}' in command");
-
-        return value switch
-        {
-            List<string> list => list,
-            JsonElement element when element.ValueKind == JsonValueKind.Array =>
-                element.EnumerateArray().Select(e => e.GetString() ?? string.Empty).ToList(),
-            _ => throw new StorageException($"Invalid parameter type for '{key}': expected string array")
-        };
+        public string Version { get; set; } = ShardedSchemaVersion;
+        public List<ScriptIndexEntry> Scripts { get; set; } = new();
     }
 
-    private TimeSpan GetTimeSpanParameter(Dictionary<string, object?>? parameters, string key)
+    /// <summary>
+    /// Index entry for one script file: everything the script list needs without reading the body.
+    /// </summary>
+    private class ScriptIndexEntry
     {
-        if (parameters == null || !parameters.TryGetValue(key, out var value))
-            throw new StorageException($"Missing required parameter '{key}' in command");
-
-        return value switch
-        {
-            TimeSpan ts => ts,
-            string s when TimeSpan.TryParse(s, out var ts) => ts,
-            long l => TimeSpan.FromMilliseconds(l),
-            int i => TimeSpan.FromMilliseconds(i),
-            double d => TimeSpan.FromMilliseconds(d),
-            JsonElement element when element.ValueKind == JsonValueKind.String =>
-                TimeSpan.Parse(element.GetString() ?? "00:00:00"),
-            JsonElement element when element.ValueKind == JsonValueKind.Number =>
-                TimeSpan.FromMilliseconds(element.GetDouble()),
-            _ => throw new StorageException($"Invalid parameter type for '{key}': expected TimeSpan")
-        };
+        public Guid Id { get; set; }
+        public string? Name { get; set; }
+        public DateTime? CreatedAt { get; set; }
+        public DateTime? ModifiedAt { get; set; }
+        public HotkeyDto? TriggerHotkey { get; set; }
+        public int? SourceTextLength { get; set; }
+
+        [JsonIgnore]
+        public bool HasMetadata => Name != null && CreatedAt.HasValue && ModifiedAt.HasValue && SourceTextLength.HasValue;
+
+        /// <summary>
+        /// Copies metadata from a script DTO.
+        /// </summary>
+        /// <returns>True if anything changed.</returns>
+        public bool Update(ScriptDto dto)
+        {
+            var sourceLength = dto.SourceText?.Length ?? 0;
+            var changed = !HasMetadata
+                || Name != dto.Name
+                || CreatedAt != dto.CreatedAt
+                || ModifiedAt != dto.ModifiedAt
+                || SourceTextLength != sourceLength
+                || !HotkeyDto.AreEqual(TriggerHotkey, dto.TriggerHotkey);
+
+            Name = dto.Name;
+            CreatedAt = dto.CreatedAt;
+            ModifiedAt = dto.ModifiedAt;
+            SourceTextLength = sourceLength;
+            TriggerHotkey = dto.TriggerHotkey;
+            return changed;
+        }
     }
 
-    #region Data Transfer Objects
-
     /// <summary>
-    /// Storage model for scripts collection with versioning.
+    /// Per-script file.
     /// </summary>
-    private class ScriptStorageModel
+    private class ScriptShardModel
     {
-        public string Version { get; set; } = "1.0";
-        public List<ScriptDto> Scripts { get; set; } = new();
+        public string Version { get; set; } = ShardedSchemaVersion;
+        public ScriptDto? Script { get; set; }
     }
 
     /// <summary>
@@ -603,6 +819,7 @@ public class JsonFileStorageService : IFileStorageService
         public DateTime CreatedAt { get; set; }
         public DateTime ModifiedAt { get; set; }
         public List<CommandDto> Commands { get; set; } = new();
+        public byte[]? PackedCommands { get; set; } // CommandBufferSerializer format, base64 in JSON
         public string? SourceText { get; set; }
         public HotkeyDto? TriggerHotkey { get; set; }
     }
@@ -617,6 +834,14 @@ public class JsonFileStorageService : IFileStorageService
         public string Modifiers { get; set; } = string.Empty;
         public string Key { get; set; } = string.Empty;
         public string TriggerMode { get; set; } = HotkeyTriggerMode.Once.ToString();
+
+        public static bool AreEqual(HotkeyDto? a, HotkeyDto? b)
+        {
+            if (a == null || b == null)
+                return a == null && b == null;
+
+            return a.Id == b.Id && a.Name == b.Name && a.Modifiers == b.Modifiers && a.Key == b.Key && a.TriggerMode == b.TriggerMode;
+        }
     }
 
     /// <summary>
@@ -628,7 +853,23 @@ public class JsonFileStorageService : IFileStorageService
         public string Type { get; set; } = string.Empty;
         public TimeSpan Delay { get; set; }
         public DateTime CreatedAt { get; set; }
-        public Dictionary<string, object?>? Parameters { get; set; }
+        public CommandParametersDto? Parameters { get; set; }
+    }
+
+    /// <summary>
+    /// Type-specific command parameters; only the members used by the command type are written.
+    /// </summary>
+    private class CommandParametersDto
+    {
+        public int? X { get; set; }
+        public int? Y { get; set; }
+        public string? Button { get; set; }
+        public string? ClickType { get; set; }
+        public string? Key { get; set; }
+        public bool? IsDown { get; set; }
+        public string? Text { get; set; }
+        public List<string>? Keys { get; set; }
+        public TimeSpan? Duration { get; set; }
     }
 
     #endregion
@@ -636,21 +877,18 @@ public class JsonFileStorageService : IFileStorageService
     #region JSON Converters
 
     /// <summary>
-    /// JSON converter for Command polymorphic serialization.
+    /// Source-generated serialization contracts for the storage models.
     /// </summary>
-    private class CommandJsonConverter : JsonConverter<Command>
+    [JsonSourceGenerationOptions(
+        PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+        WriteIndented = true,
+        DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull,
+        Converters = new[] { typeof(TimeSpanJsonConverter), typeof(DateTimeJsonConverter), typeof(LenientBooleanJsonConverter) })]
+    [JsonSerializable(typeof(ScriptStorageModel))]
+    [JsonSerializable(typeof(ScriptIndexModel))]
+    [JsonSerializable(typeof(ScriptShardModel))]
+    private partial class StorageJsonContext : JsonSerializerContext
     {
-        public override Command? Read(ref Utf8JsonReader reader, Type typeToConvert, JsonSerializerOptions options)
-        {
-            // This is handled by CommandDto deserialization
-            throw new NotImplementedException("Command deserialization is handled by CommandDto");
-        }
-
-        public override void Write(Utf8JsonWriter writer, Command value, JsonSerializerOptions options)
-        {
-            // This is handled by CommandDto serialization
-            throw new NotImplementedException("Command serialization is handled by CommandDto");
-        }
     }
 
     /// <summary>
@@ -706,5 +944,27 @@ public class JsonFileStorageService : IFileStorageService
         }
     }
 
+    /// <summary>
+    /// JSON converter for booleans that also accepts "true"/"false" strings written by older versions.
+    /// </summary>
+    private class LenientBooleanJsonConverter : JsonConverter<bool>
+    {
+        public override bool Read(ref Utf8JsonReader reader, Type typeToConvert, JsonSerializerOptions options)
+        {
+            return reader.TokenType switch
+            {
+                JsonTokenType.True => true,
+                JsonTokenType.False => false,
+                JsonTokenType.String when bool.TryParse(reader.GetString(), out var value) => value,
+                _ => throw new JsonException($"Unable to convert {reader.TokenType} to Boolean")
+            };
+        }
+
+        public override void Write(Utf8JsonWriter writer, bool value, JsonSerializerOptions options)
+        {
+            writer.WriteBooleanValue(value);
+        }
+    }
+
     #endregion
 }
@@ -1,18 +1,20 @@
 using MacroNex.Domain.Interfaces;
 using Microsoft.Extensions.Logging;
 using System.Text.Json;
+using System.Text.Json.Serialization;
 
 namespace MacroNex.Infrastructure.Storage;
 
-public sealed class JsonSettingsService : ISettingsService
+public sealed partial class JsonSettingsService : ISettingsService
 {
     private readonly ILogger<JsonSettingsService> _logger;
     private readonly string _settingsPath;
     private readonly SemaphoreSlim _fileLock = new(1, 1);
-    private readonly JsonSerializerOptions _options = new(JsonSerializerDefaults.Web)
-    {
-        WriteIndented = true
-    };
+
+    // Several view models load settings during startup; the file is read once and later loads
+    // deserialize the cached text, so each caller still gets its own instance
+    private bool _isCached;
+    private string? _cachedJson; // null when the file does not exist
 
     public JsonSettingsService(ILogger<JsonSettingsService> logger, string? settingsPath = null)
     {
@@ -30,11 +32,17 @@ public sealed class JsonSettingsService : ISettingsService
         await _fileLock.WaitAsync();
         try
         {
-            if (!File.Exists(_settingsPath))
+            if (!_isCached)
+            {
+                _cachedJson = File.Exists(_settingsPath) ? await File.ReadAllTextAsync(_settingsPath) : null;
+                _isCached = true;
+            }
+
+            var json = _cachedJson;
+            if (json == null)
                 return AppSettings.Default();
 
-            var json = await File.ReadAllTextAsync(_settingsPath);
-            var settings = JsonSerializer.Deserialize<AppSettings>(json, _options) ?? AppSettings.Default();
+            var settings = JsonSerializer.Deserialize(json, SettingsJsonContext.Default.AppSettings) ?? AppSettings.Default();
             settings.EnsureDefaults();
             return settings;
         }
@@ -56,13 +64,23 @@ public sealed class JsonSettingsService : ISettingsService
         await _fileLock.WaitAsync();
         try
         {
-            var json = JsonSerializer.Serialize(settings, _options);
+            var json = JsonSerializer.Serialize(settings, SettingsJsonContext.Default.AppSettings);
             await File.WriteAllTextAsync(_settingsPath, json);
+            _cachedJson = json;
+            _isCached = true;
         }
         finally
         {
             _fileLock.Release();
         }
     }
-}
 
+    /// <summary>
+    /// Source-generated contracts for settings.json (including the mouse calibration data).
+    /// </summary>
+    [JsonSourceGenerationOptions(JsonSerializerDefaults.Web, WriteIndented = true)]
+    [JsonSerializable(typeof(AppSettings))]
+    private partial class SettingsJsonContext : JsonSerializerContext
+    {
+    }
+}
@@ -0,0 +1,164 @@
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Host-side view of the firmware's receive buffer for credit-based flow control.
+/// The firmware reports its buffer capacity and a wrapping count of the bytes it has processed; the credit is the
+/// capacity minus the bytes sent but not processed yet. Reports are absolute, so a lost report only delays
+/// credit until the next one. A small reserve is kept back so a status query always fits to ask for a report.
+/// Thread-safe: the writer sends while the read loop applies reports.
+/// </summary>
+public sealed class ArduinoCreditWindow
+{
+    /// <summary>
+    /// Bytes of the firmware buffer held back from normal writes for status queries.
+    /// </summary>
+    public const int ProbeReserveBytes = 8;
+
+    private readonly object _lockObject = new();
+    private int _capacity;   // 0 while the firmware has not reported
+    private uint _sent;      // bytes sent, on the firmware's wrapping count
+    private uint _processed; // last reported bytes processed
+
+    /// <summary>
+    /// Gets whether the firmware has reported its buffer, i.e. whether writes are throttled.
+    /// </summary>
+    public bool IsActive
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _capacity > 0;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the reported buffer capacity in bytes, or 0 before the first report.
+    /// </summary>
+    public int Capacity
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _capacity;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of bytes sent that the firmware has not reported as processed.
+    /// </summary>
+    public int InFlight
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return GetInFlight();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of bytes that may be written now, or <see cref="int.MaxValue"/> when flow control is inactive.
+    /// </summary>
+    public int Available
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                if (_capacity == 0)
+                    return int.MaxValue;
+
+                return Math.Max(0, _capacity - GetReserve() - GetInFlight());
+            }
+        }
+    }
+
+    /// <summary>
+    /// Applies a flow control report. The first report starts flow control with nothing in flight;
+    /// a capacity of 0 stops it. Reports older than the last one are ignored.
+    /// </summary>
+    /// <param name="capacity">The firmware's receive buffer size in bytes.</param>
+    /// <param name="bytesProcessed">The wrapping count of bytes the firmware has processed.</param>
+    /// <returns>True if the report was applied.</returns>
+    public bool ApplyReport(int capacity, uint bytesProcessed)
+    {
+        if (capacity < 0)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity cannot be negative.");
+
+        lock (_lockObject)
+        {
+            if (capacity == 0)
+            {
+                _capacity = 0;
+                return true;
+            }
+
+            if (_capacity == 0)
+            {
+                // Whatever was written before flow control started is taken as processed
+                _sent = bytesProcessed;
+            }
+            else if (unchecked((int)(bytesProcessed - _processed)) < 0)
+            {
+                return false;
+            }
+            else if (unchecked((int)(_sent - bytesProcessed)) < 0)
+            {
+                // The firmware processed more than was sent (it restarted its count); resynchronize
+                _sent = bytesProcessed;
+            }
+
+            _capacity = capacity;
+            _processed = bytesProcessed;
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Records bytes written to the firmware.
+    /// </summary>
+    public void OnSent(int count)
+    {
+        if (count < 0)
+            throw new ArgumentOutOfRangeException(nameof(count), "Count cannot be negative.");
+
+        lock (_lockObject)
+        {
+            _sent = unchecked(_sent + (uint)count);
+        }
+    }
+
+    /// <summary>
+    /// Gets whether a status query of <paramref name="length"/> bytes fits the firmware buffer, reserve included.
+    /// </summary>
+    public bool CanProbe(int length)
+    {
+        lock (_lockObject)
+        {
+            return _capacity == 0 || _capacity - GetInFlight() >= length;
+        }
+    }
+
+    /// <summary>
+    /// Stops flow control until the next report, e.g. for a new connection.
+    /// </summary>
+    public void Reset()
+    {
+        lock (_lockObject)
+        {
+            _capacity = 0;
+            _sent = 0;
+            _processed = 0;
+        }
+    }
+
+    private int GetInFlight() => (int)Math.Min(unchecked(_sent - _processed), int.MaxValue);
+
+    // Tiny buffers cannot spare the full reserve
+    private int GetReserve() => Math.Min(ProbeReserveBytes, _capacity / 4);
+}
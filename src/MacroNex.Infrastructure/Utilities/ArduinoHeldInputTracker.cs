@@ -0,0 +1,71 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Tracks which keys and mouse buttons the commands sent to the firmware leave held down, so an emergency stop
+/// can release them one by one on firmware without <see cref="ArduinoFirmwareCapabilities.ReleaseAll"/>.
+/// Clicks and text never leave anything down and are ignored.
+/// Not thread-safe; the owner calls it under its lock.
+/// </summary>
+internal sealed class ArduinoHeldInputTracker
+{
+    private readonly HashSet<VirtualKey> _heldKeys = new();
+    private readonly HashSet<MouseButton> _heldButtons = new();
+
+    /// <summary>
+    /// Gets the number of keys and buttons held down.
+    /// </summary>
+    public int HeldCount => _heldKeys.Count + _heldButtons.Count;
+
+    /// <summary>
+    /// Updates the held state with a command queued for the firmware.
+    /// </summary>
+    public void Observe(ArduinoCommand command)
+    {
+        switch (command)
+        {
+            case ArduinoKeyPressCommand key when key.IsDown:
+                _heldKeys.Add(key.Key);
+                break;
+            case ArduinoKeyPressCommand key:
+                _heldKeys.Remove(key.Key);
+                break;
+            case ArduinoMouseClickCommand { ClickType: ClickType.Down } click:
+                _heldButtons.Add(click.Button);
+                break;
+            case ArduinoMouseClickCommand { ClickType: ClickType.Up } click:
+                _heldButtons.Remove(click.Button);
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Returns a key-up or button-up command for every held key and button and forgets them.
+    /// </summary>
+    public List<ArduinoCommand> TakeReleaseCommands()
+    {
+        var releases = new List<ArduinoCommand>(HeldCount);
+        foreach (var key in _heldKeys)
+        {
+            releases.Add(new ArduinoKeyPressCommand(key, false));
+        }
+
+        foreach (var button in _heldButtons)
+        {
+            releases.Add(new ArduinoMouseClickCommand(button, ClickType.Up));
+        }
+
+        Clear();
+        return releases;
+    }
+
+    /// <summary>
+    /// Forgets all held input, e.g. when the connection to the firmware changes.
+    /// </summary>
+    public void Clear()
+    {
+        _heldKeys.Clear();
+        _heldButtons.Clear();
+    }
+}
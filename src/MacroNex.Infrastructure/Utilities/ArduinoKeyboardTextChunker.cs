@@ -0,0 +1,58 @@
+using System.Text;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Splits text into <see cref="ArduinoKeyboardTextCommand"/> frames small enough for the firmware's receive buffer.
+/// </summary>
+public static class ArduinoKeyboardTextChunker
+{
+    /// <summary>
+    /// Default text budget per frame, chosen so an encoded frame fits one 64-byte USB CDC packet.
+    /// </summary>
+    public const int DefaultMaxTextBytes = ArduinoTransportOptions.DefaultMaxTextChunkBytes;
+
+    /// <summary>
+    /// Splits text into as few commands as possible, each at most <paramref name="maxTextBytes"/> UTF-8 bytes.
+    /// Splits fall between characters, never inside a UTF-8 sequence or surrogate pair.
+    /// </summary>
+    /// <param name="text">The text to type.</param>
+    /// <param name="maxTextBytes">The maximum UTF-8 size of the text of each command.</param>
+    /// <returns>The commands in typing order; a single command when the text already fits.</returns>
+    public static IReadOnlyList<ArduinoKeyboardTextCommand> Chunk(string text, int maxTextBytes = DefaultMaxTextBytes)
+    {
+        if (text == null)
+            throw new ArgumentNullException(nameof(text));
+        if (maxTextBytes < 4)
+            throw new ArgumentOutOfRangeException(nameof(maxTextBytes), "Text budget must hold at least one character (4 bytes).");
+
+        if (Encoding.UTF8.GetByteCount(text) <= maxTextBytes)
+            return new[] { new ArduinoKeyboardTextCommand(text) };
+
+        var commands = new List<ArduinoKeyboardTextCommand>();
+        var chunkStart = 0;
+        var chunkBytes = 0;
+        var index = 0;
+
+        foreach (var rune in text.EnumerateRunes())
+        {
+            var runeBytes = rune.Utf8SequenceLength;
+            if (chunkBytes + runeBytes > maxTextBytes)
+            {
+                commands.Add(new ArduinoKeyboardTextCommand(text.Substring(chunkStart, index - chunkStart)));
+                chunkStart = index;
+                chunkBytes = 0;
+            }
+
+            chunkBytes += runeBytes;
+            index += rune.Utf16SequenceLength;
+        }
+
+        if (index > chunkStart)
+            commands.Add(new ArduinoKeyboardTextCommand(text.Substring(chunkStart, index - chunkStart)));
+
+        return commands;
+    }
+}
@@ -0,0 +1,55 @@
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Splits a run of relative mouse motion samples into <see cref="ArduinoMouseMotionStreamCommand"/> frames.
+/// </summary>
+public static class ArduinoMotionStreamPacker
+{
+    /// <summary>
+    /// Default payload budget per frame, chosen so an encoded frame fits one 64-byte USB CDC packet.
+    /// </summary>
+    public const int DefaultMaxPayloadBytes = 64 - ArduinoProtocolEncoder.FrameOverhead;
+
+    /// <summary>
+    /// Packs samples into as few motion stream commands as possible.
+    /// </summary>
+    /// <param name="samples">The samples in playback order.</param>
+    /// <param name="maxPayloadBytes">The maximum payload size of each command.</param>
+    /// <returns>The commands in playback order.</returns>
+    public static IReadOnlyList<ArduinoMouseMotionStreamCommand> Pack(IEnumerable<MotionSample> samples, int maxPayloadBytes = DefaultMaxPayloadBytes)
+    {
+        if (samples == null)
+            throw new ArgumentNullException(nameof(samples));
+        if (maxPayloadBytes < 8)
+            throw new ArgumentOutOfRangeException(nameof(maxPayloadBytes), "Payload budget must be at least 8 bytes.");
+
+        var commands = new List<ArduinoMouseMotionStreamCommand>();
+        var pending = new List<MotionSample>();
+        var pendingBytes = 0;
+
+        foreach (var sample in samples)
+        {
+            var sampleLength = ArduinoMouseMotionStreamCommand.GetSampleLength(sample);
+            var headerLength = ArduinoMouseMotionStreamCommand.GetHeaderLength(pending.Count + 1);
+
+            if (pending.Count > 0 && headerLength + pendingBytes + sampleLength > maxPayloadBytes)
+            {
+                commands.Add(new ArduinoMouseMotionStreamCommand(pending));
+                pending.Clear();
+                pendingBytes = 0;
+            }
+
+            pending.Add(sample);
+            pendingBytes += sampleLength;
+        }
+
+        if (pending.Count > 0)
+        {
+            commands.Add(new ArduinoMouseMotionStreamCommand(pending));
+        }
+
+        return commands;
+    }
+}
@@ -1,4 +1,5 @@
 using MacroNex.Domain.ValueObjects;
+using System.Buffers.Binary;
 
 namespace MacroNex.Infrastructure.Utilities;
 
@@ -24,41 +25,43 @@ public static class ArduinoProtocolDecoder
         if (buffer == null || offset < 0 || offset >= buffer.Length)
             return 0;
 
-        var available = buffer.Length - offset;
-        if (available < MinEventSize)
+        return TryDecodeEvent(buffer.AsSpan(offset), out decodedEvent);
+    }
+
+    /// <summary>
+    /// Attempts to decode an event from the start of the span.
+    /// Only the event payload is copied; framing and checksum are validated in place.
+    /// </summary>
+    /// <param name="buffer">The bytes received so far.</param>
+    /// <param name="decodedEvent">The decoded event, if successful.</param>
+    /// <returns>
+    /// The number of bytes consumed, or 0 if not enough data is available.
+    /// Returns 1 with a null event when the leading byte cannot start a valid frame.
+    /// </returns>
+    public static int TryDecodeEvent(ReadOnlySpan<byte> buffer, out DecodedArduinoEvent? decodedEvent)
+    {
+        decodedEvent = null;
+
+        if (buffer.Length < MinEventSize)
             return 0; // Not enough data
 
-        var eventType = (ArduinoEventType)buffer[offset];
-        var dataLength = (ushort)(buffer[offset + 1] | (buffer[offset + 2] << 8));
+        var eventType = (ArduinoEventType)buffer[0];
+        if (!Enum.IsDefined(eventType))
+            return 1; // Cannot start a frame - resync on the next byte without waiting for more data
+
+        var dataLength = (ushort)(buffer[1] | (buffer[2] << 8));
 
         var totalSize = MinEventSize + dataLength;
-        if (available < totalSize)
+        if (buffer.Length < totalSize)
             return 0; // Not enough data for complete event
 
-        var dataStart = offset + 3;
+        const int dataStart = 3;
         var timestampStart = dataStart + dataLength;
         var checksumPos = timestampStart + 4;
 
-        // Extract data
-        var data = new byte[dataLength];
-        if (dataLength > 0)
-        {
-            Array.Copy(buffer, dataStart, data, 0, dataLength);
-        }
-
-        // Extract timestamp
-        var timestamp = (uint)(
-            buffer[timestampStart] |
-            (buffer[timestampStart + 1] << 8) |
-            (buffer[timestampStart + 2] << 16) |
-            (buffer[timestampStart + 3] << 24)
-        );
-
-        // Verify checksum
+        // Verify checksum before copying anything out
         var checksum = buffer[checksumPos];
-        var calculatedChecksum = ArduinoProtocolEncoder.CalculateChecksum(
-            buffer.Skip(offset).Take(totalSize - 1).ToArray()
-        );
+        var calculatedChecksum = ArduinoProtocolEncoder.CalculateChecksum(buffer.Slice(0, totalSize - 1));
 
         if (checksum != calculatedChecksum)
         {
@@ -66,15 +69,49 @@ public static class ArduinoProtocolDecoder
             return 1;
         }
 
+        // Extract timestamp
+        var timestamp = BinaryPrimitives.ReadUInt32LittleEndian(buffer.Slice(timestampStart, 4));
+
         decodedEvent = new DecodedArduinoEvent
         {
             EventType = eventType,
-            Data = data,
+            Data = dataLength > 0 ? buffer.Slice(dataStart, dataLength).ToArray() : Array.Empty<byte>(),
             Timestamp = timestamp
         };
 
         return totalSize;
     }
+
+    /// <summary>
+    /// Reads the payload of a <see cref="ArduinoEventType.FlowControl"/> event.
+    /// </summary>
+    /// <param name="data">The event data.</param>
+    /// <param name="capacity">The firmware's receive buffer size in bytes.</param>
+    /// <param name="bytesProcessed">The wrapping count of bytes the firmware has processed.</param>
+    /// <returns>False if the payload is too short.</returns>
+    public static bool TryReadFlowControl(ReadOnlySpan<byte> data, out ushort capacity, out uint bytesProcessed)
+    {
+        if (data.Length < 6)
+        {
+            capacity = 0;
+            bytesProcessed = 0;
+            return false;
+        }
+
+        capacity = BinaryPrimitives.ReadUInt16LittleEndian(data);
+        bytesProcessed = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(2, 4));
+        return true;
+    }
+
+    /// <summary>
+    /// Reads the capabilities from the payload of a <see cref="ArduinoEventType.StatusResponse"/> event.
+    /// </summary>
+    /// <param name="data">The event data.</param>
+    /// <returns>The reported capabilities, or None for firmware that sends no payload.</returns>
+    public static ArduinoFirmwareCapabilities ReadCapabilities(ReadOnlySpan<byte> data)
+    {
+        return data.Length >= 2 ? (ArduinoFirmwareCapabilities)data[1] : ArduinoFirmwareCapabilities.None;
+    }
 }
 
 /// <summary>
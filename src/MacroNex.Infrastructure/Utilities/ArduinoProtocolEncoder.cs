@@ -8,38 +8,114 @@ namespace MacroNex.Infrastructure.Utilities;
 /// </summary>
 public static class ArduinoProtocolEncoder
 {
+    /// <summary>
+    /// Number of framing bytes added around the command data (type, length and checksum).
+    /// </summary>
+    public const int FrameOverhead = 4;
+
+    /// <summary>
+    /// Gets the size of the encoded frame for a command.
+    /// </summary>
+    /// <param name="command">The command to measure.</param>
+    /// <returns>The number of bytes <see cref="TryEncode"/> will write.</returns>
+    public static int GetEncodedLength(ArduinoCommand command)
+    {
+        if (command == null)
+            throw new ArgumentNullException(nameof(command));
+
+        return FrameOverhead + GetDataLength(command);
+    }
+
     /// <summary>
     /// Encodes a command into binary protocol format.
     /// </summary>
     /// <param name="command">The command to encode.</param>
     /// <returns>The encoded command as a byte array.</returns>
     public static byte[] EncodeCommand(ArduinoCommand command)
+    {
+        var buffer = new byte[GetEncodedLength(command)];
+        TryEncode(command, buffer, out _);
+        return buffer;
+    }
+
+    /// <summary>
+    /// Encodes a command into the destination span without allocating.
+    /// </summary>
+    /// <param name="command">The command to encode.</param>
+    /// <param name="destination">The span to write the frame to.</param>
+    /// <param name="bytesWritten">The number of bytes written, or 0 if the destination is too small.</param>
+    /// <returns>True if the frame was written; false if the destination is too small.</returns>
+    public static bool TryEncode(ArduinoCommand command, Span<byte> destination, out int bytesWritten)
     {
         if (command == null)
             throw new ArgumentNullException(nameof(command));
 
-        var data = command.Serialize();
-        var dataLength = (ushort)data.Length;
+        var dataLength = GetDataLength(command);
+        var totalLength = FrameOverhead + dataLength;
+        if (destination.Length < totalLength)
+        {
+            bytesWritten = 0;
+            return false;
+        }
 
         // Protocol: [CommandType: 1 byte][DataLength: 2 bytes][Data: N bytes][Checksum: 1 byte]
-        var buffer = new List<byte>
+        destination[0] = (byte)command.CommandType;
+        destination[1] = (byte)(dataLength & 0xFF);
+        destination[2] = (byte)((dataLength >> 8) & 0xFF);
+        command.Serialize(destination.Slice(3, dataLength));
+
+        // Calculate checksum (simple XOR of all bytes)
+        destination[totalLength - 1] = CalculateChecksum(destination.Slice(0, totalLength - 1));
+
+        bytesWritten = totalLength;
+        return true;
+    }
+
+    /// <summary>
+    /// Finds the end of the frame that contains <paramref name="offset"/> in a run of whole encoded frames.
+    /// </summary>
+    /// <param name="frames">Consecutive frames as written by <see cref="TryEncode"/>.</param>
+    /// <param name="offset">A position in <paramref name="frames"/>.</param>
+    /// <returns>The first frame boundary at or after <paramref name="offset"/>, capped at the length of <paramref name="frames"/>.</returns>
+    public static int FindFrameEnd(ReadOnlySpan<byte> frames, int offset)
+    {
+        if (offset < 0 || offset > frames.Length)
+            throw new ArgumentOutOfRangeException(nameof(offset));
+
+        var position = 0;
+        while (position < offset)
         {
-            (byte)command.CommandType,
-            (byte)(dataLength & 0xFF),
-            (byte)((dataLength >> 8) & 0xFF)
-        };
+            if (position + 3 > frames.Length)
+                return frames.Length;
 
-        buffer.AddRange(data);
+            position += FrameOverhead + (frames[position + 1] | (frames[position + 2] << 8));
+        }
 
-        // Calculate checksum (simple XOR of all bytes)
-        byte checksum = 0;
-        foreach (var b in buffer)
+        return Math.Min(position, frames.Length);
+    }
+
+    /// <summary>
+    /// Finds the start of the frame that contains <paramref name="offset"/> in a run of whole encoded frames.
+    /// </summary>
+    /// <param name="frames">Consecutive frames as written by <see cref="TryEncode"/>.</param>
+    /// <param name="offset">A position in <paramref name="frames"/>.</param>
+    /// <returns>The last frame boundary at or before <paramref name="offset"/>.</returns>
+    public static int FindFrameStart(ReadOnlySpan<byte> frames, int offset)
+    {
+        if (offset < 0 || offset > frames.Length)
+            throw new ArgumentOutOfRangeException(nameof(offset));
+
+        var position = 0;
+        while (position + 3 <= frames.Length)
         {
-            checksum ^= b;
+            var next = position + FrameOverhead + (frames[position + 1] | (frames[position + 2] << 8));
+            if (next > offset)
+                break;
+
+            position = next;
         }
-        buffer.Add(checksum);
 
-        return buffer.ToArray();
+        return position;
     }
 
     /// <summary>
@@ -52,6 +128,16 @@ public static class ArduinoProtocolEncoder
         if (data == null || data.Length == 0)
             return 0;
 
+        return CalculateChecksum(data.AsSpan());
+    }
+
+    /// <summary>
+    /// Calculates the checksum for a span of bytes.
+    /// </summary>
+    /// <param name="data">The data to calculate checksum for.</param>
+    /// <returns>The checksum byte.</returns>
+    public static byte CalculateChecksum(ReadOnlySpan<byte> data)
+    {
         byte checksum = 0;
         foreach (var b in data)
         {
@@ -59,4 +145,13 @@ public static class ArduinoProtocolEncoder
         }
         return checksum;
     }
+
+    private static int GetDataLength(ArduinoCommand command)
+    {
+        var dataLength = command.SerializedLength;
+        if (dataLength > ushort.MaxValue)
+            throw new ArgumentException($"Command data exceeds the maximum frame payload of {ushort.MaxValue} bytes.", nameof(command));
+
+        return dataLength;
+    }
 }
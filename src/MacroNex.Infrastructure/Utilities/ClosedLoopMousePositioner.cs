@@ -0,0 +1,129 @@
+using System.Diagnostics;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Moves the cursor to an absolute position using relative HID deltas: one calibrated jump, then
+/// bounded corrective moves computed from the cursor position read back after each move.
+/// Corrections are scaled by the gain observed on the previous move (a secant step), and the outcome of
+/// the initial jump is fed back into the calibration's online gain, so later jumps land closer and need
+/// fewer corrections.
+/// </summary>
+public static class ClosedLoopMousePositioner
+{
+    // Smallest move whose observed ratio is used to scale the next correction
+    private const int MinSecantDelta = 8;
+
+    /// <summary>
+    /// Sends a relative HID move and returns the cursor position once it has settled.
+    /// </summary>
+    /// <param name="hidDeltaX">HID delta on the X axis.</param>
+    /// <param name="hidDeltaY">HID delta on the Y axis.</param>
+    /// <param name="from">Cursor position before the move.</param>
+    public delegate Task<Point> MoveAndSettleAsync(int hidDeltaX, int hidDeltaY, Point from);
+
+    /// <summary>
+    /// Converges on <paramref name="target"/>.
+    /// </summary>
+    /// <param name="start">Current cursor position.</param>
+    /// <param name="target">Target cursor position.</param>
+    /// <param name="options">Correction budget and tolerance.</param>
+    /// <param name="calibration">Calibration used to convert pixels to HID deltas, or null for 1:1.</param>
+    /// <param name="moveAndSettleAsync">Sends a move and reads back the settled cursor position.</param>
+    /// <param name="isClamped">Optional check whether a landing position was limited by the screen edge;
+    /// such moves are not used as calibration feedback, and positioning stops at one that made no progress.</param>
+    /// <param name="cancellationToken">Stops positioning between moves.</param>
+    /// <returns>Corrections used and the residual error.</returns>
+    public static async Task<MousePositioningResult> MoveAsync(
+        Point start,
+        Point target,
+        ClosedLoopPositioningOptions options,
+        MouseCalibrationData? calibration,
+        MoveAndSettleAsync moveAndSettleAsync,
+        Func<Point, bool>? isClamped = null,
+        CancellationToken cancellationToken = default)
+    {
+        if (options == null)
+            throw new ArgumentNullException(nameof(options));
+        if (moveAndSettleAsync == null)
+            throw new ArgumentNullException(nameof(moveAndSettleAsync));
+
+        var stopwatch = Stopwatch.StartNew();
+        var useCalibration = calibration != null && calibration.IsValid;
+        var tolerance = Math.Max(0, options.TolerancePixels);
+        var maxMoves = Math.Max(0, options.MaxCorrections) + 1;
+        var current = start;
+        var moves = 0;
+        double gainX = useCalibration ? calibration!.GetOnlineGain(useYAxis: false) : 1.0;
+        double gainY = useCalibration ? calibration!.GetOnlineGain(useYAxis: true) : 1.0;
+
+        while (moves < maxMoves)
+        {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            int errorX = target.X - current.X;
+            int errorY = target.Y - current.Y;
+            if (Math.Abs(errorX) <= tolerance && Math.Abs(errorY) <= tolerance)
+                break;
+
+            int modelX = (int)Math.Round(errorX / gainX);
+            int modelY = (int)Math.Round(errorY / gainY);
+            int hidX = ToHidDelta(modelX, errorX, calibration, useCalibration, useYAxis: false);
+            int hidY = ToHidDelta(modelY, errorY, calibration, useCalibration, useYAxis: true);
+
+            var landed = await moveAndSettleAsync(hidX, hidY, current);
+            moves++;
+
+            if (isClamped != null && isClamped(landed))
+            {
+                // Pinned against the edge: a move that got no closer means the rest is out of reach
+                var before = Math.Abs(errorX) + Math.Abs(errorY);
+                var after = Math.Abs(target.X - landed.X) + Math.Abs(target.Y - landed.Y);
+                current = landed;
+                if (after >= before)
+                    break;
+
+                continue;
+            }
+
+            gainX = ObservedGain(modelX, landed.X - current.X, gainX);
+            gainY = ObservedGain(modelY, landed.Y - current.Y, gainY);
+
+            // Only the jump is a reliable measurement; corrections are dominated by rounding
+            if (useCalibration && moves == 1)
+            {
+                calibration!.RecordPositioningFeedback(modelX, landed.X - current.X, useYAxis: false);
+                calibration.RecordPositioningFeedback(modelY, landed.Y - current.Y, useYAxis: true);
+            }
+
+            current = landed;
+        }
+
+        return new MousePositioningResult(
+            Math.Max(0, moves - 1),
+            target.X - current.X,
+            target.Y - current.Y,
+            stopwatch.Elapsed);
+    }
+
+    private static double ObservedGain(int modelPixelDelta, int actualPixelDelta, double previous)
+    {
+        if (Math.Abs(modelPixelDelta) < MinSecantDelta || Math.Sign(modelPixelDelta) != Math.Sign(actualPixelDelta))
+            return previous;
+
+        return Math.Clamp((double)actualPixelDelta / modelPixelDelta, 0.25, 4.0);
+    }
+
+    private static int ToHidDelta(int modelPixelDelta, int errorPixelDelta, MouseCalibrationData? calibration, bool useCalibration, bool useYAxis)
+    {
+        if (errorPixelDelta == 0)
+            return 0;
+
+        int hid = useCalibration ? calibration!.CalculateHidDelta(modelPixelDelta, useYAxis) : modelPixelDelta;
+
+        // A residual smaller than one HID step still needs a nudge to make progress
+        return hid == 0 ? Math.Sign(errorPixelDelta) : hid;
+    }
+}
@@ -0,0 +1,294 @@
+using System.Diagnostics;
+using MacroNex.Domain.Interfaces;
+using Microsoft.Extensions.Logging;
+using Microsoft.Win32.SafeHandles;
+using static MacroNex.Infrastructure.Win32.Win32Api;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Precision delay built from a coarse wait plus a spin-wait finish.
+/// The coarse wait uses a high-resolution waitable timer where available (Windows 10 1803+),
+/// otherwise Task.Delay under a timeBeginPeriod(1) session.
+/// </summary>
+public sealed class HighPrecisionTimer : IPrecisionTimer, IDisposable
+{
+    // Time left for the spin phase after a high-resolution waitable timer (typically ~0.5 ms late at worst)
+    private static readonly TimeSpan WaitableTimerSpinMargin = TimeSpan.FromMilliseconds(1);
+
+    // Task.Delay after timeBeginPeriod(1) wakes within ~1-2 ms
+    private static readonly TimeSpan TaskDelaySpinMargin = TimeSpan.FromMilliseconds(2);
+
+    private const uint HighResolutionPeriodMs = 1;
+
+    private static readonly Lazy<bool> WaitableTimerSupported = new(ProbeWaitableTimer);
+
+    private readonly ILogger<HighPrecisionTimer> _logger;
+    private readonly object _statsLock = new();
+    private readonly object _sessionLock = new();
+    private readonly bool _waitableTimerSupported;
+    private int _sessionCount;
+    private bool _isDisposed;
+
+    private long _sampleCount;
+    private double _sumAbsErrorTicks;
+    private long _maxErrorTicks;
+    private long _lastErrorTicks;
+
+    public HighPrecisionTimer(ILogger<HighPrecisionTimer> logger)
+    {
+        _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _waitableTimerSupported = WaitableTimerSupported.Value;
+        _logger.LogDebug("HighPrecisionTimer initialized (high-resolution waitable timer: {Supported})", _waitableTimerSupported);
+    }
+
+    /// <inheritdoc />
+    public async Task<PrecisionDelayResult> DelayAsync(TimeSpan duration, CancellationToken cancellationToken = default)
+    {
+        if (duration < TimeSpan.Zero)
+            throw new ArgumentException("Duration cannot be negative.", nameof(duration));
+
+        ThrowIfDisposed();
+        cancellationToken.ThrowIfCancellationRequested();
+
+        var start = Stopwatch.GetTimestamp();
+        var deadline = start + (long)(duration.TotalSeconds * Stopwatch.Frequency);
+
+        var margin = _waitableTimerSupported ? WaitableTimerSpinMargin : TaskDelaySpinMargin;
+        var coarse = duration - margin;
+        if (coarse > TimeSpan.Zero)
+        {
+            if (_waitableTimerSupported)
+            {
+                await WaitOnWaitableTimerAsync(coarse, cancellationToken).ConfigureAwait(false);
+            }
+            else
+            {
+                await Task.Delay(coarse, cancellationToken).ConfigureAwait(false);
+            }
+        }
+        else
+        {
+            // Spin from a pool thread so short waits do not run on the caller's thread
+            await Task.Yield();
+        }
+
+        SpinUntil(deadline, cancellationToken);
+
+        var result = new PrecisionDelayResult(duration, Stopwatch.GetElapsedTime(start));
+        Record(result);
+
+        _logger.LogTrace("Precision delay requested {Requested:F3}ms, achieved {Actual:F3}ms",
+            result.Requested.TotalMilliseconds, result.Actual.TotalMilliseconds);
+
+        return result;
+    }
+
+    /// <inheritdoc />
+    public IDisposable BeginHighResolutionSession()
+    {
+        ThrowIfDisposed();
+
+        lock (_sessionLock)
+        {
+            if (_sessionCount++ == 0 && OperatingSystem.IsWindows())
+            {
+                timeBeginPeriod(HighResolutionPeriodMs);
+                _logger.LogDebug("Timer resolution raised to {Period}ms", HighResolutionPeriodMs);
+            }
+        }
+
+        return new HighResolutionSession(this);
+    }
+
+    /// <inheritdoc />
+    public int ActiveSessionCount
+    {
+        get
+        {
+            lock (_sessionLock)
+            {
+                return _sessionCount;
+            }
+        }
+    }
+
+    /// <inheritdoc />
+    public TimingErrorStatistics GetErrorStatistics()
+    {
+        lock (_statsLock)
+        {
+            if (_sampleCount == 0)
+                return TimingErrorStatistics.Empty();
+
+            return new TimingErrorStatistics(
+                _sampleCount,
+                TicksToTimeSpan(_sumAbsErrorTicks / _sampleCount),
+                TicksToTimeSpan(_maxErrorTicks),
+                TicksToTimeSpan(_lastErrorTicks));
+        }
+    }
+
+    /// <inheritdoc />
+    public void ResetErrorStatistics()
+    {
+        lock (_statsLock)
+        {
+            _sampleCount = 0;
+            _sumAbsErrorTicks = 0;
+            _maxErrorTicks = 0;
+            _lastErrorTicks = 0;
+        }
+    }
+
+    public void Dispose()
+    {
+        if (_isDisposed)
+            return;
+
+        lock (_sessionLock)
+        {
+            if (_sessionCount > 0 && OperatingSystem.IsWindows())
+            {
+                timeEndPeriod(HighResolutionPeriodMs);
+            }
+            _sessionCount = 0;
+        }
+
+        _isDisposed = true;
+    }
+
+    private void EndHighResolutionSession()
+    {
+        lock (_sessionLock)
+        {
+            if (_sessionCount == 0)
+                return;
+
+            if (--_sessionCount == 0 && OperatingSystem.IsWindows() && !_isDisposed)
+            {
+                timeEndPeriod(HighResolutionPeriodMs);
+                _logger.LogDebug("Timer resolution restored");
+            }
+        }
+    }
+
+    private void Record(PrecisionDelayResult result)
+    {
+        var errorTicks = result.Error.Ticks;
+        lock (_statsLock)
+        {
+            _sampleCount++;
+            _sumAbsErrorTicks += Math.Abs(errorTicks);
+            _maxErrorTicks = Math.Max(_maxErrorTicks, errorTicks);
+            _lastErrorTicks = errorTicks;
+        }
+    }
+
+    /// <summary>
+    /// Waits without spinning, on a high-resolution waitable timer where available and on Task.Delay otherwise.
+    /// For short timeouts that should not cost a full timer tick but do not need the spin finish.
+    /// </summary>
+    internal static Task WaitAsync(TimeSpan duration, CancellationToken cancellationToken)
+    {
+        return WaitableTimerSupported.Value
+            ? WaitOnWaitableTimerAsync(duration, cancellationToken)
+            : Task.Delay(duration, cancellationToken);
+    }
+
+    private static void SpinUntil(long deadline, CancellationToken cancellationToken)
+    {
+        var spinner = new SpinWait();
+        while (Stopwatch.GetTimestamp() < deadline)
+        {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            // Never let SpinWait escalate to Sleep(1); that would cost a full timer tick
+            spinner.SpinOnce(sleep1Threshold: -1);
+        }
+    }
+
+    private static Task WaitOnWaitableTimerAsync(TimeSpan duration, CancellationToken cancellationToken)
+    {
+        var handle = CreateWaitableTimerExW(IntPtr.Zero, null, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (handle.IsInvalid)
+        {
+            handle.Dispose();
+            return Task.Delay(duration, cancellationToken);
+        }
+
+        // Negative due time = relative, in 100 ns units
+        var dueTime = -duration.Ticks;
+        if (!SetWaitableTimer(handle, ref dueTime, 0, IntPtr.Zero, IntPtr.Zero, false))
+        {
+            handle.Dispose();
+            return Task.Delay(duration, cancellationToken);
+        }
+
+        var waitHandle = new TimerWaitHandle(handle);
+        var tcs = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var registration = ThreadPool.RegisterWaitForSingleObject(
+            waitHandle,
+            static (state, _) => ((TaskCompletionSource)state!).TrySetResult(),
+            tcs,
+            Timeout.Infinite,
+            executeOnlyOnce: true);
+        var cancellation = cancellationToken.Register(static state => ((TaskCompletionSource)state!).TrySetCanceled(), tcs);
+
+        return tcs.Task.ContinueWith(t =>
+        {
+            cancellation.Dispose();
+            registration.Unregister(null);
+            waitHandle.Dispose();
+            return t;
+        }, CancellationToken.None, TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default).Unwrap();
+    }
+
+    private static bool ProbeWaitableTimer()
+    {
+        if (!OperatingSystem.IsWindows())
+            return false;
+
+        try
+        {
+            using var handle = CreateWaitableTimerExW(IntPtr.Zero, null, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            return !handle.IsInvalid;
+        }
+        catch (Exception)
+        {
+            // Older Windows versions reject the high-resolution flag
+            return false;
+        }
+    }
+
+    private static TimeSpan TicksToTimeSpan(double ticks) => TimeSpan.FromTicks((long)Math.Round(ticks));
+
+    private void ThrowIfDisposed()
+    {
+        if (_isDisposed)
+            throw new ObjectDisposedException(nameof(HighPrecisionTimer));
+    }
+
+    private sealed class TimerWaitHandle : WaitHandle
+    {
+        public TimerWaitHandle(SafeWaitHandle handle)
+        {
+            SafeWaitHandle = handle;
+        }
+    }
+
+    private sealed class HighResolutionSession : IDisposable
+    {
+        private HighPrecisionTimer? _owner;
+
+        public HighResolutionSession(HighPrecisionTimer owner)
+        {
+            _owner = owner;
+        }
+
+        public void Dispose()
+        {
+            Interlocked.Exchange(ref _owner, null)?.EndHighResolutionSession();
+        }
+    }
+}
@@ -0,0 +1,97 @@
+using System.Runtime.InteropServices;
+
+namespace MacroNex.Infrastructure.Utilities;
+
+/// <summary>
+/// Bounded, preallocated single-producer/single-consumer ring buffer.
+/// Exactly one thread may call <see cref="TryEnqueue"/> and exactly one (other) thread may call
+/// <see cref="TryDequeue"/>; neither side locks or allocates.
+/// </summary>
+/// <typeparam name="T">The element type; structs avoid per-item allocation.</typeparam>
+public sealed class SpscRingBuffer<T> where T : struct
+{
+    private readonly T[] _buffer;
+    private readonly int _mask;
+
+    // Producer and consumer cursors live on separate cache lines to avoid false sharing
+    private PaddedLong _head; // next slot to read (consumer-owned)
+    private PaddedLong _tail; // next slot to write (producer-owned)
+
+    /// <summary>
+    /// Initializes a new ring buffer.
+    /// </summary>
+    /// <param name="capacity">Number of slots; rounded up to a power of two.</param>
+    public SpscRingBuffer(int capacity)
+    {
+        if (capacity < 2)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be at least 2.");
+
+        var size = (int)System.Numerics.BitOperations.RoundUpToPowerOf2((uint)capacity);
+        _buffer = new T[size];
+        _mask = size - 1;
+    }
+
+    /// <summary>
+    /// Gets the number of slots.
+    /// </summary>
+    public int Capacity => _buffer.Length;
+
+    /// <summary>
+    /// Gets an approximate item count (exact only when called from the producer or consumer while the other is idle).
+    /// </summary>
+    public int Count => (int)(Volatile.Read(ref _tail.Value) - Volatile.Read(ref _head.Value));
+
+    /// <summary>
+    /// Gets whether the buffer currently appears empty.
+    /// </summary>
+    public bool IsEmpty => Count == 0;
+
+    /// <summary>
+    /// Adds an item. Producer thread only.
+    /// </summary>
+    /// <returns>False if the buffer is full.</returns>
+    public bool TryEnqueue(in T item)
+    {
+        var tail = _tail.Value;
+        if (tail - Volatile.Read(ref _head.Value) >= _buffer.Length)
+            return false;
+
+        _buffer[(int)tail & _mask] = item;
+
+        // Publish the slot after it is written
+        Volatile.Write(ref _tail.Value, tail + 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Removes the oldest item. Consumer thread only.
+    /// </summary>
+    /// <returns>False if the buffer is empty.</returns>
+    public bool TryDequeue(out T item)
+    {
+        var head = _head.Value;
+        if (head >= Volatile.Read(ref _tail.Value))
+        {
+            item = default;
+            return false;
+        }
+
+        var index = (int)head & _mask;
+        item = _buffer[index];
+        _buffer[index] = default;
+
+        // Release the slot after it is read
+        Volatile.Write(ref _head.Value, head + 1);
+        return true;
+    }
+}
+
+/// <summary>
+/// A long alone on its cache line. Not nested in the ring because generic types cannot use explicit layout.
+/// </summary>
+[StructLayout(LayoutKind.Explicit, Size = 128)]
+internal struct PaddedLong
+{
+    [FieldOffset(64)]
+    public long Value;
+}
@@ -1,3 +1,4 @@
+using MacroNex.Domain.Interfaces;
 using Microsoft.Extensions.Logging;
 
 namespace MacroNex.Infrastructure.Utilities;
@@ -9,18 +10,40 @@ namespace MacroNex.Infrastructure.Utilities;
 public class TimingUtilities
 {
     private readonly ILogger<TimingUtilities> _logger;
+    private readonly IPrecisionTimer? _precisionTimer;
     private readonly Random _random;
 
     /// <summary>
     /// Initializes a new instance of the TimingUtilities class.
     /// </summary>
     /// <param name="logger">Logger for diagnostic information.</param>
-    public TimingUtilities(ILogger<TimingUtilities> logger)
+    /// <param name="precisionTimer">Optional precision timer used by <see cref="DelayAsync"/>.</param>
+    public TimingUtilities(ILogger<TimingUtilities> logger, IPrecisionTimer? precisionTimer = null)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _precisionTimer = precisionTimer;
         _random = new Random();
     }
 
+    /// <summary>
+    /// Waits for the specified duration, using the precision timer when one is configured.
+    /// </summary>
+    /// <param name="duration">The delay duration.</param>
+    /// <param name="cancellationToken">Token to cancel the wait.</param>
+    /// <returns>The requested and achieved durations.</returns>
+    public async Task<PrecisionDelayResult> DelayAsync(TimeSpan duration, CancellationToken cancellationToken = default)
+    {
+        if (duration < TimeSpan.Zero)
+            throw new ArgumentException("Duration must be non-negative", nameof(duration));
+
+        if (_precisionTimer != null)
+            return await _precisionTimer.DelayAsync(duration, cancellationToken);
+
+        var start = System.Diagnostics.Stopwatch.GetTimestamp();
+        await Task.Delay(duration, cancellationToken);
+        return new PrecisionDelayResult(duration, System.Diagnostics.Stopwatch.GetElapsedTime(start));
+    }
+
     /// <summary>
     /// Calculates an appropriate delay based on the distance between two points.
     /// Simulates natural mouse movement timing.
@@ -9,6 +9,7 @@ internal interface IWin32HotkeyApi
 {
     bool RegisterHotKey(IntPtr hWnd, int id, uint fsModifiers, uint vk);
     bool UnregisterHotKey(IntPtr hWnd, int id);
+    bool GetMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax);
     bool PeekMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax, uint wRemoveMsg);
     bool TranslateMessage(ref MSG msg);
     IntPtr DispatchMessage(ref MSG msg);
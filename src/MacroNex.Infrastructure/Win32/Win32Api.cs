@@ -18,6 +18,16 @@ internal static class Win32Api
     [DllImport("user32.dll", SetLastError = true)]
     public static extern uint SendInput(uint nInputs, INPUT[] pInputs, int cbSize);
 
+    /// <summary>
+    /// Synthesizes keystrokes, mouse motions, and button clicks from a pinned or stack buffer.
+    /// </summary>
+    /// <param name="nInputs">The number of structures pointed to by pInputs.</param>
+    /// <param name="pInputs">A pointer to the first INPUT structure.</param>
+    /// <param name="cbSize">The size, in bytes, of an INPUT structure.</param>
+    /// <returns>The number of events that it successfully inserted into the keyboard or mouse input stream.</returns>
+    [DllImport("user32.dll", SetLastError = true)]
+    public static extern unsafe uint SendInput(uint nInputs, INPUT* pInputs, int cbSize);
+
     /// <summary>
     /// Retrieves the cursor's position, in screen coordinates.
     /// </summary>
@@ -185,8 +195,8 @@ internal static class Win32Api
     // Window message constants
     public const uint WM_HOTKEY = 0x0312;
     public const uint WM_QUIT = 0x0012;
-    public const uint WM_HOTKEY_REGISTER = 0x8000; // Custom message for registering hotkeys on message loop thread
-    public const uint WM_HOTKEY_UNREGISTER = 0x8001; // Custom message for unregistering hotkeys on message loop thread
+    public const uint WM_INPUT_THREAD_INVOKE = 0x8000; // Custom message: run queued work items on the input thread
+    public const uint PM_NOREMOVE = 0x0000;
     public const uint PM_REMOVE = 0x0001;
 
     // Hotkey modifier constants
@@ -257,4 +267,37 @@ internal static class Win32Api
         int cchBuff,
         uint wFlags,
         IntPtr dwhkl);
-}
\ No newline at end of file
+
+    /// <summary>
+    /// Requests a minimum resolution for periodic timers.
+    /// </summary>
+    /// <param name="uPeriod">Minimum timer resolution, in milliseconds.</param>
+    /// <returns>TIMERR_NOERROR (0) if successful.</returns>
+    [DllImport("winmm.dll")]
+    public static extern uint timeBeginPeriod(uint uPeriod);
+
+    /// <summary>
+    /// Clears a previously set minimum timer resolution.
+    /// </summary>
+    /// <param name="uPeriod">The value passed to the matching timeBeginPeriod call.</param>
+    /// <returns>TIMERR_NOERROR (0) if successful.</returns>
+    [DllImport("winmm.dll")]
+    public static extern uint timeEndPeriod(uint uPeriod);
+
+    /// <summary>
+    /// Creates or opens a waitable timer object.
+    /// </summary>
+    [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+    public static extern Microsoft.Win32.SafeHandles.SafeWaitHandle CreateWaitableTimerExW(IntPtr lpTimerAttributes, string? lpTimerName, uint dwFlags, uint dwDesiredAccess);
+
+    /// <summary>
+    /// Activates a waitable timer. A negative due time is relative, in 100-nanosecond units.
+    /// </summary>
+    [DllImport("kernel32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    public static extern bool SetWaitableTimer(Microsoft.Win32.SafeHandles.SafeWaitHandle hTimer, ref long pDueTime, int lPeriod, IntPtr pfnCompletionRoutine, IntPtr lpArgToCompletionRoutine, [MarshalAs(UnmanagedType.Bool)] bool fResume);
+
+    // Waitable timer constants
+    public const uint CREATE_WAITABLE_TIMER_HIGH_RESOLUTION = 0x00000002;
+    public const uint TIMER_ALL_ACCESS = 0x1F0003;
+}
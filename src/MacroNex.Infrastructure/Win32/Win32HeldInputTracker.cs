@@ -0,0 +1,122 @@
+using static MacroNex.Infrastructure.Win32.Win32Structures;
+
+namespace MacroNex.Infrastructure.Win32;
+
+/// <summary>
+/// Tracks which keys and mouse buttons are held down by the inputs that have been sent, so an emergency stop
+/// can release exactly those. Keys are identified the way they were sent: by scan code (plus the extended
+/// flag) or by virtual key. Unicode text is ignored; it never leaves a key down.
+/// Not thread-safe; the owner calls it under its send lock.
+/// </summary>
+internal sealed class Win32HeldInputTracker
+{
+    private const uint ScanCodeKey = 0x10000;
+    private const uint ExtendedKey = 0x20000;
+
+    private static readonly (uint Down, uint Up, uint Data)[] MouseButtons =
+    {
+        (MOUSEEVENTF_LEFTDOWN, MOUSEEVENTF_LEFTUP, 0),
+        (MOUSEEVENTF_RIGHTDOWN, MOUSEEVENTF_RIGHTUP, 0),
+        (MOUSEEVENTF_MIDDLEDOWN, MOUSEEVENTF_MIDDLEUP, 0),
+        (MOUSEEVENTF_XDOWN, MOUSEEVENTF_XUP, XBUTTON1),
+        (MOUSEEVENTF_XDOWN, MOUSEEVENTF_XUP, XBUTTON2)
+    };
+
+    // Held key id -> the key-up input that releases it
+    private readonly Dictionary<uint, INPUT> _heldKeys = new();
+    private int _heldButtons; // bit i is set while MouseButtons[i] is down
+
+    /// <summary>
+    /// Gets the number of keys and buttons held down.
+    /// </summary>
+    public int HeldCount => _heldKeys.Count + System.Numerics.BitOperations.PopCount((uint)_heldButtons);
+
+    /// <summary>
+    /// Updates the held state with inputs that have been delivered, in order.
+    /// </summary>
+    public void Observe(ReadOnlySpan<INPUT> inputs)
+    {
+        foreach (ref readonly var input in inputs)
+        {
+            if (input.type == INPUT_KEYBOARD)
+            {
+                ObserveKey(input.u.ki);
+            }
+            else if (input.type == INPUT_MOUSE)
+            {
+                ObserveMouse(input.u.mi);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Writes a release input for every held key and button. The held state only changes once the
+    /// releases are observed as delivered.
+    /// </summary>
+    /// <param name="destination">Receives the releases; must hold at least <see cref="HeldCount"/> inputs.</param>
+    /// <returns>The number of inputs written.</returns>
+    public int CopyReleaseInputs(Span<INPUT> destination)
+    {
+        var count = 0;
+        foreach (var release in _heldKeys.Values)
+        {
+            destination[count++] = release;
+        }
+
+        for (int i = 0; i < MouseButtons.Length; i++)
+        {
+            if ((_heldButtons & (1 << i)) == 0)
+                continue;
+
+            destination[count++] = new INPUT
+            {
+                type = INPUT_MOUSE,
+                u = new InputUnion
+                {
+                    mi = new MOUSEINPUT { dwFlags = MouseButtons[i].Up, mouseData = MouseButtons[i].Data }
+                }
+            };
+        }
+
+        return count;
+    }
+
+    private void ObserveKey(in KEYBDINPUT key)
+    {
+        if ((key.dwFlags & KEYEVENTF_UNICODE) != 0)
+            return;
+
+        var extended = key.dwFlags & KEYEVENTF_EXTENDEDKEY;
+        var id = (key.dwFlags & KEYEVENTF_SCANCODE) != 0
+            ? ScanCodeKey | (extended != 0 ? ExtendedKey : 0) | key.wScan
+            : key.wVk;
+
+        if ((key.dwFlags & KEYEVENTF_KEYUP) != 0)
+        {
+            _heldKeys.Remove(id);
+            return;
+        }
+
+        var release = key;
+        release.dwFlags = (key.dwFlags & (KEYEVENTF_SCANCODE | KEYEVENTF_EXTENDEDKEY)) | KEYEVENTF_KEYUP;
+        release.time = 0;
+        release.dwExtraInfo = IntPtr.Zero;
+        _heldKeys[id] = new INPUT { type = INPUT_KEYBOARD, u = new InputUnion { ki = release } };
+    }
+
+    private void ObserveMouse(in MOUSEINPUT mouse)
+    {
+        for (int i = 0; i < MouseButtons.Length; i++)
+        {
+            var (down, up, data) = MouseButtons[i];
+            if (data != 0 && (mouse.mouseData & data) == 0)
+                continue;
+
+            // A click carries both flags; down comes first
+            if ((mouse.dwFlags & down) != 0)
+                _heldButtons |= 1 << i;
+            if ((mouse.dwFlags & up) != 0)
+                _heldButtons &= ~(1 << i);
+        }
+    }
+}
@@ -10,6 +10,7 @@ internal sealed class Win32HotkeyApi : IWin32HotkeyApi
 {
     public bool RegisterHotKey(IntPtr hWnd, int id, uint fsModifiers, uint vk) => Win32Api.RegisterHotKey(hWnd, id, fsModifiers, vk);
     public bool UnregisterHotKey(IntPtr hWnd, int id) => Win32Api.UnregisterHotKey(hWnd, id);
+    public bool GetMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax) => Win32Api.GetMessage(out msg, hWnd, wMsgFilterMin, wMsgFilterMax);
     public bool PeekMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax, uint wRemoveMsg) => Win32Api.PeekMessage(out msg, hWnd, wMsgFilterMin, wMsgFilterMax, wRemoveMsg);
     public bool TranslateMessage(ref MSG msg) => Win32Api.TranslateMessage(ref msg);
     public IntPtr DispatchMessage(ref MSG msg) => Win32Api.DispatchMessage(ref msg);
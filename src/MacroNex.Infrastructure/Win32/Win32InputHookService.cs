@@ -1,7 +1,7 @@
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
 using Microsoft.Extensions.Logging;
-using System.Runtime.InteropServices;
 using static MacroNex.Infrastructure.Win32.Win32Api;
 using static MacroNex.Infrastructure.Win32.Win32Structures;
 
@@ -9,28 +9,41 @@ namespace MacroNex.Infrastructure.Win32;
 
 /// <summary>
 /// Win32 implementation of global input capture using low-level hooks (WH_MOUSE_LL / WH_KEYBOARD_LL).
+/// Subscribes to the shared hooks owned by <see cref="Win32InputThread"/>. The hook callbacks only copy the raw event into a preallocated ring; a dedicated consumer thread
+/// raises the events, so subscriber work never counts against LowLevelHooksTimeout.
 /// </summary>
 public sealed class Win32InputHookService : IInputHookService, IDisposable
 {
+    /// <summary>
+    /// Ring capacity; about one second of 8000 Hz mouse input.
+    /// </summary>
+    public const int EventBufferCapacity = 8192;
+
+    private const int ConsumerStopTimeoutMs = 1000;
+
     private readonly ILogger<Win32InputHookService> _logger;
+    private readonly Win32InputThread _inputThread;
     private readonly object _lock = new();
 
-    private RecordingOptions? _options;
+    // Both hooks fire on the input thread, so the ring has a single producer
+    private readonly SpscRingBuffer<RawHookEvent> _events = new(EventBufferCapacity);
+    private readonly ManualResetEventSlim _eventsAvailable = new(false);
+    private Thread? _consumerThread;
+    private bool _consumerAbandoned;
+    private volatile bool _stopConsumer;
+    private long _droppedEventCount;
 
-    private IntPtr _mouseHook = IntPtr.Zero;
-    private IntPtr _keyboardHook = IntPtr.Zero;
+    private RecordingOptions? _options;
 
-    // Keep delegates alive (otherwise GC can collect them and crash)
-    private readonly HookProc _mouseProc;
-    private readonly HookProc _keyboardProc;
+    private IDisposable? _mouseHook;
+    private IDisposable? _keyboardHook;
 
     private bool _isDisposed;
 
-    public Win32InputHookService(ILogger<Win32InputHookService> logger)
+    public Win32InputHookService(ILogger<Win32InputHookService> logger, Win32InputThread inputThread)
     {
         _logger = logger ?? throw new ArgumentNullException(nameof(logger));
-        _mouseProc = MouseHookCallback;
-        _keyboardProc = KeyboardHookCallback;
+        _inputThread = inputThread ?? throw new ArgumentNullException(nameof(inputThread));
     }
 
     public bool IsInstalled
@@ -39,11 +52,16 @@ public sealed class Win32InputHookService : IInputHookService, IDisposable
         {
             lock (_lock)
             {
-                return _mouseHook != IntPtr.Zero || _keyboardHook != IntPtr.Zero;
+                return _mouseHook != null || _keyboardHook != null;
             }
         }
     }
 
+    /// <summary>
+    /// Gets the number of hook events dropped because the consumer fell a full buffer behind.
+    /// </summary>
+    public long DroppedEventCount => Interlocked.Read(ref _droppedEventCount);
+
     public event EventHandler<InputHookMouseMoveEventArgs>? MouseMoved;
     public event EventHandler<InputHookMouseClickEventArgs>? MouseClicked;
     public event EventHandler<InputHookKeyEventArgs>? KeyboardInput;
@@ -57,44 +75,34 @@ public sealed class Win32InputHookService : IInputHookService, IDisposable
         {
             _options = options;
 
-            if (_mouseHook != IntPtr.Zero || _keyboardHook != IntPtr.Zero)
+            if (_mouseHook != null || _keyboardHook != null)
                 return Task.CompletedTask;
 
-            var moduleHandle = GetModuleHandle(null);
-            if (moduleHandle == IntPtr.Zero)
-            {
-                var error = (int)GetLastError();
-                throw new InvalidOperationException($"GetModuleHandle failed (Win32Error={error}).");
-            }
+            StartConsumer();
 
-            // Only install what we need (mouse and/or keyboard)
-            if (options.RecordMouseMovements || options.RecordMouseClicks)
+            try
             {
-                _mouseHook = SetWindowsHookEx(WH_MOUSE_LL, _mouseProc, moduleHandle, 0);
-                if (_mouseHook == IntPtr.Zero)
+                // Only subscribe to what we need (mouse and/or keyboard)
+                if (options.RecordMouseMovements || options.RecordMouseClicks)
                 {
-                    var error = (int)GetLastError();
-                    throw new InvalidOperationException($"SetWindowsHookEx(WH_MOUSE_LL) failed (Win32Error={error}).");
+                    _mouseHook = _inputThread.AddMouseHook(OnMouseEvent);
                 }
-            }
 
-            if (options.RecordKeyboardInput)
-            {
-                _keyboardHook = SetWindowsHookEx(WH_KEYBOARD_LL, _keyboardProc, moduleHandle, 0);
-                if (_keyboardHook == IntPtr.Zero)
+                if (options.RecordKeyboardInput)
                 {
-                    var error = (int)GetLastError();
-                    // Best effort cleanup if mouse hook already installed
-                    if (_mouseHook != IntPtr.Zero)
-                    {
-                        try { UnhookWindowsHookEx(_mouseHook); } catch { /* ignore */ }
-                        _mouseHook = IntPtr.Zero;
-                    }
-                    throw new InvalidOperationException($"SetWindowsHookEx(WH_KEYBOARD_LL) failed (Win32Error={error}).");
+                    _keyboardHook = _inputThread.AddKeyboardHook(OnKeyboardEvent);
                 }
             }
+            catch
+            {
+                // Best effort cleanup if the mouse hook already subscribed
+                _mouseHook?.Dispose();
+                _mouseHook = null;
+                StopConsumer();
+                throw;
+            }
 
-            _logger.LogInformation("Input hooks installed. Mouse={MouseInstalled}, Keyboard={KeyboardInstalled}", _mouseHook != IntPtr.Zero, _keyboardHook != IntPtr.Zero);
+            _logger.LogInformation("Input hooks installed. Mouse={MouseInstalled}, Keyboard={KeyboardInstalled}", _mouseHook != null, _keyboardHook != null);
         }
 
         return Task.CompletedTask;
@@ -106,61 +114,44 @@ public sealed class Win32InputHookService : IInputHookService, IDisposable
 
         lock (_lock)
         {
-            if (_mouseHook != IntPtr.Zero)
+            _mouseHook?.Dispose();
+            _mouseHook = null;
+
+            _keyboardHook?.Dispose();
+            _keyboardHook = null;
+
+            // Deliver whatever the hooks queued before they were removed
+            StopConsumer();
+
+            _options = null;
+
+            var dropped = DroppedEventCount;
+            if (dropped > 0)
             {
-                UnhookWindowsHookEx(_mouseHook);
-                _mouseHook = IntPtr.Zero;
+                _logger.LogWarning("Input hooks uninstalled. {Dropped} hook events were dropped because the consumer fell behind.", dropped);
             }
-
-            if (_keyboardHook != IntPtr.Zero)
+            else
             {
-                UnhookWindowsHookEx(_keyboardHook);
-                _keyboardHook = IntPtr.Zero;
+                _logger.LogInformation("Input hooks uninstalled.");
             }
-
-            _options = null;
-            _logger.LogInformation("Input hooks uninstalled.");
         }
 
         return Task.CompletedTask;
     }
 
-    private IntPtr MouseHookCallback(int nCode, IntPtr wParam, IntPtr lParam)
+    private unsafe bool OnMouseEvent(int msg, IntPtr lParam)
     {
-        try
-        {
-            if (nCode >= 0)
-            {
-                var msg = wParam.ToInt32();
-                var data = Marshal.PtrToStructure<MSLLHOOKSTRUCT>(lParam);
-                var position = new Point(data.pt.X, data.pt.Y);
-                var isInjected = (data.flags & MsLlFlags.LLMHF_INJECTED) != 0;
-
-                // Move
-                if (msg == WM_MOUSEMOVE)
-                {
-                    MouseMoved?.Invoke(this, new InputHookMouseMoveEventArgs(position));
-                }
-                else
-                {
-                    if (TryMapMouseClick(msg, data.mouseData, out var button, out var clickType))
-                    {
-                        // Optional filtering of injected/system events
-                        var opts = _options;
-                        if (opts?.FilterSystemEvents == true && isInjected)
-                            return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
-
-                        MouseClicked?.Invoke(this, new InputHookMouseClickEventArgs(position, button, clickType, isInjected));
-                    }
-                }
-            }
-        }
-        catch (Exception ex)
-        {
-            _logger.LogDebug(ex, "MouseHookCallback error (ignored).");
-        }
-
-        return CallNextHookEx(_mouseHook, nCode, wParam, lParam);
+        // Hot path: a pointer read and a ring write only. No allocation, locks or subscriber code here.
+        var data = (MSLLHOOKSTRUCT*)lParam;
+        Publish(new RawHookEvent(
+            RawHookEventKind.Mouse,
+            msg,
+            data->pt.X,
+            data->pt.Y,
+            data->mouseData,
+            (uint)data->flags));
+
+        return false;
     }
 
     private static bool TryMapMouseClick(int msg, uint mouseData, out MouseButton button, out ClickType clickType)
@@ -208,35 +199,145 @@ public sealed class Win32InputHookService : IInputHookService, IDisposable
         }
     }
 
-    private IntPtr KeyboardHookCallback(int nCode, IntPtr wParam, IntPtr lParam)
+    private unsafe bool OnKeyboardEvent(int msg, IntPtr lParam)
     {
-        try
+        if (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN || msg == WM_KEYUP || msg == WM_SYSKEYUP)
+        {
+            var data = (KBDLLHOOKSTRUCT*)lParam;
+            Publish(new RawHookEvent(RawHookEventKind.Keyboard, msg, 0, 0, data->vkCode, (uint)data->flags));
+        }
+
+        return false;
+    }
+
+    private void Publish(in RawHookEvent hookEvent)
+    {
+        if (!_events.TryEnqueue(hookEvent))
+        {
+            Interlocked.Increment(ref _droppedEventCount);
+            return;
+        }
+
+        // Always signal: skipping Set when the event looks set races with the consumer's Reset,
+        // which can clear it after this check and leave the event unsignalled with data queued
+        _eventsAvailable.Set();
+    }
+
+    private void StartConsumer()
+    {
+        if (_consumerThread != null)
+            return;
+
+        _stopConsumer = false;
+        _consumerThread = new Thread(ConsumeEvents)
         {
-            if (nCode >= 0)
+            IsBackground = true,
+            Name = "MacroNex input hook consumer",
+            Priority = ThreadPriority.AboveNormal
+        };
+        _consumerThread.Start();
+    }
+
+    private void StopConsumer()
+    {
+        var thread = _consumerThread;
+        if (thread == null)
+            return;
+
+        _stopConsumer = true;
+        _eventsAvailable.Set();
+        if (!thread.Join(ConsumerStopTimeoutMs))
+        {
+            // The thread may still wait on or set the event, so it must outlive this service
+            _consumerAbandoned = true;
+            _logger.LogWarning("Input hook consumer did not stop within {Timeout}ms.", ConsumerStopTimeoutMs);
+        }
+        _consumerThread = null;
+    }
+
+    private void ConsumeEvents()
+    {
+        while (true)
+        {
+            while (_events.TryDequeue(out var hookEvent))
+            {
+                Dispatch(hookEvent);
+            }
+
+            if (_stopConsumer)
             {
-                var msg = wParam.ToInt32();
-                if (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN || msg == WM_KEYUP || msg == WM_SYSKEYUP)
+                // Final drain for events published between the loop above and the stop request
+                while (_events.TryDequeue(out var hookEvent))
                 {
-                    var data = Marshal.PtrToStructure<KBDLLHOOKSTRUCT>(lParam);
-                    var vk = (VirtualKey)data.vkCode;
-                    var isInjected = (data.flags & KbdLlFlags.LLKHF_INJECTED) != 0;
-                    var isDown = msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
+                    Dispatch(hookEvent);
+                }
+                return;
+            }
 
-                    // Optional filtering of injected/system events
-                    var opts = _options;
-                    if (opts?.FilterSystemEvents == true && isInjected)
-                        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+            // Reset before the emptiness re-check so a concurrent Publish cannot be missed
+            _eventsAvailable.Reset();
+            if (_events.IsEmpty && !_stopConsumer)
+            {
+                _eventsAvailable.Wait();
+            }
+        }
+    }
 
-                    KeyboardInput?.Invoke(this, new InputHookKeyEventArgs(vk, isDown, isInjected));
-                }
+    private void Dispatch(in RawHookEvent hookEvent)
+    {
+        try
+        {
+            if (hookEvent.Kind == RawHookEventKind.Mouse)
+            {
+                DispatchMouse(hookEvent);
+            }
+            else
+            {
+                DispatchKeyboard(hookEvent);
             }
         }
         catch (Exception ex)
         {
-            _logger.LogDebug(ex, "KeyboardHookCallback error (ignored).");
+            _logger.LogDebug(ex, "Input hook event dispatch error (ignored).");
+        }
+    }
+
+    private void DispatchMouse(in RawHookEvent hookEvent)
+    {
+        var position = new Point(hookEvent.X, hookEvent.Y);
+
+        // Move
+        if (hookEvent.Message == WM_MOUSEMOVE)
+        {
+            MouseMoved?.Invoke(this, new InputHookMouseMoveEventArgs(position));
+            return;
         }
 
-        return CallNextHookEx(_keyboardHook, nCode, wParam, lParam);
+        if (TryMapMouseClick(hookEvent.Message, hookEvent.Data, out var button, out var clickType))
+        {
+            var isInjected = (hookEvent.Flags & (uint)MsLlFlags.LLMHF_INJECTED) != 0;
+
+            // Optional filtering of injected/system events
+            var opts = _options;
+            if (opts?.FilterSystemEvents == true && isInjected)
+                return;
+
+            MouseClicked?.Invoke(this, new InputHookMouseClickEventArgs(position, button, clickType, isInjected));
+        }
+    }
+
+    private void DispatchKeyboard(in RawHookEvent hookEvent)
+    {
+        var vk = (VirtualKey)hookEvent.Data;
+        var isInjected = (hookEvent.Flags & (uint)KbdLlFlags.LLKHF_INJECTED) != 0;
+        var isDown = hookEvent.Message == WM_KEYDOWN || hookEvent.Message == WM_SYSKEYDOWN;
+
+        // Optional filtering of injected/system events
+        var opts = _options;
+        if (opts?.FilterSystemEvents == true && isInjected)
+            return;
+
+        KeyboardInput?.Invoke(this, new InputHookKeyEventArgs(vk, isDown, isInjected));
     }
 
     // NOTE: Keyboard capture intentionally records low-level down/up events instead of translating to text.
@@ -251,7 +352,23 @@ public sealed class Win32InputHookService : IInputHookService, IDisposable
     {
         if (_isDisposed) return;
         try { UninstallHooksAsync().GetAwaiter().GetResult(); } catch { /* ignore */ }
+        lock (_lock)
+        {
+            if (!_consumerAbandoned)
+                _eventsAvailable.Dispose();
+        }
         _isDisposed = true;
     }
+
+    private enum RawHookEventKind : byte
+    {
+        Mouse,
+        Keyboard
+    }
+
+    /// <summary>
+    /// Raw hook data copied out of the hook struct. Data is mouseData for mouse events and vkCode for keys.
+    /// </summary>
+    private readonly record struct RawHookEvent(RawHookEventKind Kind, int Message, int X, int Y, uint Data, uint Flags);
 }
 
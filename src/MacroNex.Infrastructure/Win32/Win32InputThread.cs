@@ -0,0 +1,417 @@
+using System.Collections.Concurrent;
+using Microsoft.Extensions.Logging;
+using static MacroNex.Infrastructure.Win32.Win32Api;
+using static MacroNex.Infrastructure.Win32.Win32Structures;
+
+namespace MacroNex.Infrastructure.Win32;
+
+/// <summary>
+/// Handles one low-level hook event on the input thread.
+/// </summary>
+/// <param name="message">The window message (e.g. WM_KEYDOWN, WM_MOUSEMOVE).</param>
+/// <param name="lParam">Pointer to the KBDLLHOOKSTRUCT or MSLLHOOKSTRUCT; only valid during the call.</param>
+/// <returns>True to swallow the event so it does not reach other applications.</returns>
+public delegate bool LowLevelHookHandler(int message, IntPtr lParam);
+
+/// <summary>
+/// Dedicated thread that owns every RegisterHotKey registration and low-level hook in the process.
+/// Callers marshal work onto it through its message queue and await a TaskCompletionSource; between
+/// messages the thread blocks in GetMessage rather than polling. A single WH_KEYBOARD_LL and a single
+/// WH_MOUSE_LL hook are installed on demand and fanned out to every subscriber, so the system hook
+/// chain carries at most one hook of each kind for the whole application.
+/// </summary>
+public sealed class Win32InputThread : IDisposable
+{
+    private const int StopTimeoutMs = 5000;
+
+    private readonly ILogger<Win32InputThread> _logger;
+    private readonly IWin32HotkeyApi _api;
+    private readonly ConcurrentQueue<Action> _workItems = new();
+    private readonly TaskCompletionSource<uint> _started = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    private readonly Thread _thread;
+
+    // Only touched on the input thread
+    private readonly HookChain _keyboardHooks;
+    private readonly HookChain _mouseHooks;
+
+    private int _nextHotkeyId;
+    private volatile bool _isDisposed;
+
+    /// <summary>
+    /// Initializes a new instance of the Win32InputThread class and starts the thread.
+    /// </summary>
+    /// <param name="logger">Logger for diagnostic information.</param>
+    public Win32InputThread(ILogger<Win32InputThread> logger)
+        : this(logger, new Win32HotkeyApi())
+    {
+    }
+
+    internal Win32InputThread(ILogger<Win32InputThread> logger, IWin32HotkeyApi api)
+    {
+        _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+        _api = api ?? throw new ArgumentNullException(nameof(api));
+        _keyboardHooks = new HookChain(WH_KEYBOARD_LL, "WH_KEYBOARD_LL", _logger);
+        _mouseHooks = new HookChain(WH_MOUSE_LL, "WH_MOUSE_LL", _logger);
+
+        _thread = new Thread(Run)
+        {
+            Name = "MacroNex input thread",
+            IsBackground = true,
+            // Hook callbacks run here and count against LowLevelHooksTimeout
+            Priority = ThreadPriority.AboveNormal
+        };
+        _thread.Start();
+    }
+
+    /// <summary>
+    /// Raised on the input thread for every WM_HOTKEY, with the registration ID.
+    /// </summary>
+    internal event Action<int>? HotkeyPressed;
+
+    /// <summary>
+    /// Gets the Win32 thread ID, or 0 before the message queue exists.
+    /// </summary>
+    public uint ThreadId { get; private set; }
+
+    /// <summary>
+    /// Gets whether the message loop is up and processing messages.
+    /// </summary>
+    public bool IsRunning => !_isDisposed && _started.Task.IsCompletedSuccessfully && _thread.IsAlive;
+
+    /// <summary>
+    /// Gets whether the caller is running on the input thread.
+    /// </summary>
+    public bool IsCurrentThread => Environment.CurrentManagedThreadId == _thread.ManagedThreadId;
+
+    /// <summary>
+    /// Runs <paramref name="func"/> on the input thread. Runs inline when already on it.
+    /// </summary>
+    /// <returns>A task that completes with the result once the function has run.</returns>
+    public Task<T> InvokeAsync<T>(Func<T> func)
+    {
+        if (func == null)
+            throw new ArgumentNullException(nameof(func));
+
+        if (IsCurrentThread)
+        {
+            try
+            {
+                return Task.FromResult(func());
+            }
+            catch (Exception ex)
+            {
+                return Task.FromException<T>(ex);
+            }
+        }
+
+        ThrowIfDisposed();
+        if (_started.Task.IsCompleted && !_thread.IsAlive)
+            throw new InvalidOperationException("The input thread has stopped.");
+
+        var tcs = new TaskCompletionSource<T>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _workItems.Enqueue(() =>
+        {
+            try
+            {
+                tcs.TrySetResult(func());
+            }
+            catch (Exception ex)
+            {
+                tcs.TrySetException(ex);
+            }
+        });
+
+        // Before the queue exists the thread drains work items right after it starts
+        if (_started.Task.IsCompletedSuccessfully && !_api.PostThreadMessage(ThreadId, WM_INPUT_THREAD_INVOKE, IntPtr.Zero, IntPtr.Zero))
+        {
+            _logger.LogWarning("Failed to wake the input thread. Win32 error: {Error}", _api.GetLastError());
+        }
+
+        return tcs.Task;
+    }
+
+    /// <summary>
+    /// Runs <paramref name="action"/> on the input thread. Runs inline when already on it.
+    /// </summary>
+    /// <returns>A task that completes once the action has run.</returns>
+    public Task InvokeAsync(Action action)
+    {
+        if (action == null)
+            throw new ArgumentNullException(nameof(action));
+
+        return InvokeAsync(() =>
+        {
+            action();
+            return true;
+        });
+    }
+
+    /// <summary>
+    /// Subscribes to the shared WH_KEYBOARD_LL hook, installing it on first use. Blocks until the hook is in place.
+    /// </summary>
+    /// <param name="handler">Called on the input thread for every keyboard event.</param>
+    /// <returns>A registration that unsubscribes when disposed; the hook is removed with its last subscriber.</returns>
+    /// <exception cref="InvalidOperationException">Thrown when the hook cannot be installed.</exception>
+    public IDisposable AddKeyboardHook(LowLevelHookHandler handler) => AddHook(_keyboardHooks, handler);
+
+    /// <summary>
+    /// Subscribes to the shared WH_MOUSE_LL hook, installing it on first use. Blocks until the hook is in place.
+    /// </summary>
+    /// <param name="handler">Called on the input thread for every mouse event.</param>
+    /// <returns>A registration that unsubscribes when disposed; the hook is removed with its last subscriber.</returns>
+    /// <exception cref="InvalidOperationException">Thrown when the hook cannot be installed.</exception>
+    public IDisposable AddMouseHook(LowLevelHookHandler handler) => AddHook(_mouseHooks, handler);
+
+    /// <summary>
+    /// Allocates a RegisterHotKey ID that is unique across every service sharing this thread.
+    /// </summary>
+    internal int AllocateHotkeyId() => Interlocked.Increment(ref _nextHotkeyId);
+
+    private IDisposable AddHook(HookChain chain, LowLevelHookHandler handler)
+    {
+        if (handler == null)
+            throw new ArgumentNullException(nameof(handler));
+
+        InvokeAsync(() => chain.Add(handler)).GetAwaiter().GetResult();
+        return new HookRegistration(this, chain, handler);
+    }
+
+    private void RemoveHook(HookChain chain, LowLevelHookHandler handler)
+    {
+        if (_isDisposed)
+            return;
+
+        try
+        {
+            InvokeAsync(() => chain.Remove(handler)).GetAwaiter().GetResult();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogDebug(ex, "Failed to remove {Hook} subscriber", chain.Name);
+        }
+    }
+
+    private void Run()
+    {
+        try
+        {
+            // Force the thread's message queue into existence before anyone posts to it
+            _api.PeekMessage(out _, IntPtr.Zero, 0, 0, PM_NOREMOVE);
+            ThreadId = _api.GetCurrentThreadId();
+            _started.TrySetResult(ThreadId);
+            _logger.LogDebug("Input thread started with ID {ThreadId}", ThreadId);
+
+            // Work queued before the queue existed was never announced
+            DrainWorkItems();
+
+            // Disposed before the queue existed, so WM_QUIT was never posted
+            if (_isDisposed)
+                return;
+
+            // Blocks until a message arrives; low-level hook callbacks are delivered from inside this call
+            while (_api.GetMessage(out MSG msg, IntPtr.Zero, 0, 0))
+            {
+                if (msg.message == WM_INPUT_THREAD_INVOKE)
+                {
+                    DrainWorkItems();
+                }
+                else if (msg.message == WM_HOTKEY)
+                {
+                    RaiseHotkeyPressed((int)msg.wParam);
+                }
+                else
+                {
+                    _api.TranslateMessage(ref msg);
+                    _api.DispatchMessage(ref msg);
+                }
+            }
+        }
+        catch (Exception ex)
+        {
+            _started.TrySetException(ex);
+            _logger.LogError(ex, "Error in input thread message loop");
+        }
+        finally
+        {
+            _keyboardHooks.RemoveAll();
+            _mouseHooks.RemoveAll();
+
+            // Run what is left so no caller waits forever; hook work against a dead loop is harmless
+            DrainWorkItems();
+            _logger.LogDebug("Input thread exiting");
+        }
+    }
+
+    private void DrainWorkItems()
+    {
+        while (_workItems.TryDequeue(out var workItem))
+        {
+            workItem();
+        }
+    }
+
+    private void RaiseHotkeyPressed(int hotkeyId)
+    {
+        try
+        {
+            HotkeyPressed?.Invoke(hotkeyId);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogError(ex, "Error handling WM_HOTKEY for ID {HotkeyId}", hotkeyId);
+        }
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (_isDisposed)
+            throw new ObjectDisposedException(nameof(Win32InputThread));
+    }
+
+    /// <summary>
+    /// Stops the message loop, removing any hooks still installed.
+    /// </summary>
+    public void Dispose()
+    {
+        if (_isDisposed)
+            return;
+
+        _isDisposed = true;
+        Interlocked.MemoryBarrier();
+        _logger.LogDebug("Disposing input thread");
+
+        if (_started.Task.IsCompletedSuccessfully)
+        {
+            _api.PostThreadMessage(ThreadId, WM_QUIT, IntPtr.Zero, IntPtr.Zero);
+        }
+
+        if (!IsCurrentThread && _thread.IsAlive && !_thread.Join(StopTimeoutMs))
+        {
+            _logger.LogWarning("Input thread did not stop within {Timeout}ms", StopTimeoutMs);
+        }
+    }
+
+    /// <summary>
+    /// One installed low-level hook and the subscribers it fans out to.
+    /// </summary>
+    private sealed class HookChain
+    {
+        private readonly int _hookType;
+        private readonly ILogger _logger;
+
+        // Keep the delegate alive (otherwise GC can collect it and crash)
+        private readonly HookProc _proc;
+        private IntPtr _hook = IntPtr.Zero;
+        private LowLevelHookHandler[] _handlers = Array.Empty<LowLevelHookHandler>();
+
+        public HookChain(int hookType, string name, ILogger logger)
+        {
+            _hookType = hookType;
+            Name = name;
+            _logger = logger;
+            _proc = Callback;
+        }
+
+        public string Name { get; }
+
+        public void Add(LowLevelHookHandler handler)
+        {
+            if (_hook == IntPtr.Zero)
+            {
+                var moduleHandle = GetModuleHandle(null);
+                if (moduleHandle == IntPtr.Zero)
+                {
+                    var error = (int)GetLastError();
+                    throw new InvalidOperationException($"GetModuleHandle failed (Win32Error={error}).");
+                }
+
+                _hook = SetWindowsHookEx(_hookType, _proc, moduleHandle, 0);
+                if (_hook == IntPtr.Zero)
+                {
+                    var error = (int)GetLastError();
+                    throw new InvalidOperationException($"SetWindowsHookEx({Name}) failed (Win32Error={error}).");
+                }
+
+                _logger.LogInformation("{Hook} hook installed on the input thread.", Name);
+            }
+
+            var handlers = new LowLevelHookHandler[_handlers.Length + 1];
+            _handlers.CopyTo(handlers, 0);
+            handlers[^1] = handler;
+            _handlers = handlers;
+        }
+
+        public void Remove(LowLevelHookHandler handler)
+        {
+            var index = Array.IndexOf(_handlers, handler);
+            if (index < 0)
+                return;
+
+            var handlers = new LowLevelHookHandler[_handlers.Length - 1];
+            Array.Copy(_handlers, 0, handlers, 0, index);
+            Array.Copy(_handlers, index + 1, handlers, index, handlers.Length - index);
+            _handlers = handlers;
+
+            if (handlers.Length == 0)
+                RemoveAll();
+        }
+
+        public void RemoveAll()
+        {
+            _handlers = Array.Empty<LowLevelHookHandler>();
+            if (_hook == IntPtr.Zero)
+                return;
+
+            try { UnhookWindowsHookEx(_hook); } catch { /* ignore */ }
+            _hook = IntPtr.Zero;
+            _logger.LogInformation("{Hook} hook removed.", Name);
+        }
+
+        private IntPtr Callback(int nCode, IntPtr wParam, IntPtr lParam)
+        {
+            if (nCode >= 0)
+            {
+                // Every subscriber sees the event; it is swallowed if any of them asks
+                var message = wParam.ToInt32();
+                var swallow = false;
+                foreach (var handler in _handlers)
+                {
+                    try
+                    {
+                        swallow |= handler(message, lParam);
+                    }
+                    catch (Exception ex)
+                    {
+                        _logger.LogDebug(ex, "{Hook} subscriber error (ignored).", Name);
+                    }
+                }
+
+                if (swallow)
+                    return (IntPtr)1;
+            }
+
+            return CallNextHookEx(_hook, nCode, wParam, lParam);
+        }
+    }
+
+    private sealed class HookRegistration : IDisposable
+    {
+        private readonly Win32InputThread _owner;
+        private readonly HookChain _chain;
+        private LowLevelHookHandler? _handler;
+
+        public HookRegistration(Win32InputThread owner, HookChain chain, LowLevelHookHandler handler)
+        {
+            _owner = owner;
+            _chain = chain;
+            _handler = handler;
+        }
+
+        public void Dispose()
+        {
+            var handler = Interlocked.Exchange(ref _handler, null);
+            if (handler != null)
+                _owner.RemoveHook(_chain, handler);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 ﻿using System.Configuration;
 using System.Data;
 using System.Windows;
+using Microsoft.Extensions.Configuration;
 using Microsoft.Extensions.DependencyInjection;
 using Microsoft.Extensions.Hosting;
 using Microsoft.Extensions.Logging;
@@ -9,6 +10,7 @@ using MacroNex.Domain.Interfaces;
 using MacroNex.Infrastructure.Logging;
 using MacroNex.Presentation.Services;
 using System.IO;
+using System.Runtime;
 using System.Text;
 
 namespace MacroNex.Presentation;
@@ -20,12 +22,28 @@ public partial class App : System.Windows.Application
 {
     private IHost? _host;
 
+    // Created with the App instance, before any startup work, so every phase is on one clock
+    private readonly StartupProfiler _startupProfiler = new();
+
     protected override void OnStartup(StartupEventArgs e)
     {
+        StartJitProfile();
+
         try
         {
-            _host = CreateHostBuilder().Build();
-            _host.Start();
+            using (_startupProfiler.Measure("Host build"))
+            {
+                _host = CreateHostBuilder(_startupProfiler).Build();
+            }
+
+            // Read settings off the UI thread while the hosted services start
+            var settingsService = _host.Services.GetRequiredService<ISettingsService>();
+            var settingsTask = Task.Run(() => settingsService.LoadAsync());
+
+            using (_startupProfiler.Measure("Host start"))
+            {
+                _host.Start();
+            }
 
             DispatcherUnhandledException += (sender, args) =>
             {
@@ -52,10 +70,10 @@ public partial class App : System.Windows.Application
             // Apply persisted UI language before showing any windows.
             try
             {
-                var settingsService = _host.Services.GetRequiredService<ISettingsService>();
+                using var phase = _startupProfiler.Measure("Settings and language");
                 var localization = _host.Services.GetRequiredService<LocalizationService>();
-                // Avoid deadlock on UI thread: run async file I/O off the dispatcher thread.
-                var settings = Task.Run(() => settingsService.LoadAsync()).GetAwaiter().GetResult();
+                // Avoid deadlock on UI thread: the load runs off the dispatcher thread.
+                var settings = settingsTask.GetAwaiter().GetResult();
                 settings.EnsureDefaults();
                 localization.ApplyLanguage(settings.UiLanguage);
             }
@@ -64,8 +82,17 @@ public partial class App : System.Windows.Application
                 // Best-effort; fall back to default language dictionary.
             }
 
-            var mainWindow = _host.Services.GetRequiredService<MainWindow>();
-            mainWindow.Show();
+            MainWindow mainWindow;
+            using (_startupProfiler.Measure("Main window construction"))
+            {
+                mainWindow = _host.Services.GetRequiredService<MainWindow>();
+            }
+
+            mainWindow.ContentRendered += OnMainWindowContentRendered;
+            using (_startupProfiler.Measure("Main window show"))
+            {
+                mainWindow.Show();
+            }
 
             base.OnStartup(e);
         }
@@ -88,16 +115,70 @@ public partial class App : System.Windows.Application
         base.OnExit(e);
     }
 
-    private static IHostBuilder CreateHostBuilder()
+    private void OnMainWindowContentRendered(object? sender, EventArgs e)
+    {
+        if (sender is Window window)
+            window.ContentRendered -= OnMainWindowContentRendered;
+
+        _startupProfiler.MarkInteractive();
+
+        // Release non-critical work (port scans, calibration, auto-connect) now that the window is usable
+        var deferred = _host?.Services.GetService<DeferredStartupService>();
+        _ = ReportStartupTimingAsync(deferred?.Start() ?? Task.CompletedTask);
+    }
+
+    private async Task ReportStartupTimingAsync(Task deferredWork)
+    {
+        try
+        {
+            await deferredWork;
+
+            var report = _startupProfiler.FormatReport();
+            var logger = _host?.Services.GetService<ILogger<App>>();
+            if (_startupProfiler.TimeToInteractive > StartupProfiler.InteractiveTarget)
+                logger?.LogWarning("{StartupReport}", report);
+            else
+                logger?.LogInformation("{StartupReport}", report);
+
+            // Last launch only; kiosk machines relaunch too often for a growing history to be useful
+            await File.WriteAllTextAsync(Path.Combine(GetLogDirectory(), "startup-timing.log"), report);
+        }
+        catch
+        {
+            // Timing is diagnostic only
+        }
+    }
+
+    /// <summary>
+    /// Records the methods JIT-compiled during startup and, on later launches, compiles them on background
+    /// threads ahead of use. Complements ReadyToRun for code it cannot precompile (generics over app types, WPF XAML).
+    /// </summary>
+    private static void StartJitProfile()
     {
-        var logDirectory = Path.Combine(
-            Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData),
-            "MacroNex",
-            "Logs");
-        Directory.CreateDirectory(logDirectory);
-        var logFilePath = Path.Combine(logDirectory, "diagnostic.log");
+        try
+        {
+            ProfileOptimization.SetProfileRoot(GetLogDirectory());
+            ProfileOptimization.StartProfile("startup.jitprofile");
+        }
+        catch
+        {
+            // Best-effort; startup proceeds without the profile
+        }
+    }
+
+    private static IHostBuilder CreateHostBuilder(StartupProfiler startupProfiler)
+    {
+        var logFilePath = Path.Combine(GetLogDirectory(), "diagnostic.log");
 
         return Host.CreateDefaultBuilder()
+            .ConfigureHostConfiguration(config =>
+            {
+                // No file watchers on appsettings.json: the app does not reload configuration at runtime
+                config.AddInMemoryCollection(new Dictionary<string, string?>
+                {
+                    ["hostBuilder:reloadConfigOnChange"] = "false"
+                });
+            })
             .ConfigureLogging(logging =>
             {
                 // Keep default providers (Console, Debug) and add file logger
@@ -109,6 +190,7 @@ public partial class App : System.Windows.Application
             .ConfigureServices((context, services) =>
             {
                 // Register all MacroNex services
+                services.AddSingleton(startupProfiler);
                 services.AddMacroNexServices();
 
                 // Register the main window
@@ -116,13 +198,15 @@ public partial class App : System.Windows.Application
             });
     }
 
-    private static string GetStartupLogPath()
+    private static string GetLogDirectory()
     {
         var dir = Path.Combine(Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData), "MacroNex", "Logs");
         Directory.CreateDirectory(dir);
-        return Path.Combine(dir, "startup.log");
+        return dir;
     }
 
+    private static string GetStartupLogPath() => Path.Combine(GetLogDirectory(), "startup.log");
+
     private static void WriteStartupLog(string title, Exception ex)
     {
         try
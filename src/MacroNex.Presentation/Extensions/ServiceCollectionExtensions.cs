@@ -5,6 +5,8 @@ using MacroNex.Infrastructure.Storage;
 using MacroNex.Infrastructure.Utilities;
 using MacroNex.Infrastructure.Win32;
 using Microsoft.Extensions.DependencyInjection;
+using Microsoft.Extensions.DependencyInjection.Extensions;
+using Microsoft.Extensions.Logging;
 using MacroNex.Presentation.ViewModels;
 using MacroNex.Presentation.Services;
 
@@ -40,6 +42,11 @@ public static class ServiceCollectionExtensions
     private static IServiceCollection AddPresentationServices(this IServiceCollection services)
     {
         services.AddSingleton<LocalizationService>();
+        services.AddSingleton(_ => new UiUpdatePump(System.Windows.Application.Current?.Dispatcher));
+
+        // Startup pipeline: the host registers the profiler it started at launch; otherwise time from first use
+        services.TryAddSingleton<StartupProfiler>();
+        services.AddSingleton<DeferredStartupService>();
 
         // Register ViewModels
         services.AddSingleton<MainViewModel>();
@@ -104,13 +111,23 @@ public static class ServiceCollectionExtensions
         services.AddScoped<ArduinoInputSimulator>();
         services.AddScoped<CoordinateTransformer>();
         services.AddScoped<TimingUtilities>();
+        services.AddSingleton<IPrecisionTimer, HighPrecisionTimer>();
+        services.AddSingleton<IInputLatencyMonitor, InputLatencyMonitor>();
+
+        // One thread owns every low-level hook and RegisterHotKey registration
+        services.AddSingleton<Win32InputThread>();
 
         // Register input hook services for recording
         services.AddSingleton<Win32InputHookService>();
         services.AddSingleton<ArduinoInputHookService>();
 
         // Register Arduino services
-        services.AddSingleton<IArduinoService, ArduinoSerialService>();
+        // Each pooled device is its own serial service with its own read loop and heartbeat; the pool owns them
+        services.AddSingleton<ArduinoDevicePool>(sp => new ArduinoDevicePool(
+            () => ActivatorUtilities.CreateInstance<ArduinoSerialService>(sp),
+            sp.GetRequiredService<ILogger<ArduinoDevicePool>>()));
+        services.AddSingleton<IArduinoDevicePool>(sp => sp.GetRequiredService<ArduinoDevicePool>());
+        services.AddSingleton<IArduinoService>(sp => sp.GetRequiredService<ArduinoDevicePool>());
 
         // Register global hotkey service
         services.AddSingleton<IGlobalHotkeyService, Win32GlobalHotkeyService>();
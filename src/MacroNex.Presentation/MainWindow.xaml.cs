@@ -24,8 +24,8 @@ public partial class MainWindow : Window
 
     private void OnLogEntriesCollectionChanged(object? sender, NotifyCollectionChangedEventArgs e)
     {
-        // Auto-scroll to bottom when new items are added
-        if (e.Action == NotifyCollectionChangedAction.Add && LogsListBox.Items.Count > 0)
+        // Auto-scroll to bottom when new items are added (batched appends arrive as Reset)
+        if ((e.Action == NotifyCollectionChangedAction.Add || e.Action == NotifyCollectionChangedAction.Reset) && LogsListBox.Items.Count > 0)
         {
             // 使用較低的優先級，確保在集合更新完成後再滾動
             // 避免在集合變更過程中訪問 Items，導致同步問題
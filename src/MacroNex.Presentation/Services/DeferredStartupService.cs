@@ -0,0 +1,120 @@
+using System.Diagnostics;
+using Microsoft.Extensions.Logging;
+
+namespace MacroNex.Presentation.Services;
+
+/// <summary>
+/// Holds back non-critical startup work (serial port scans, calibration loads, device auto-connect) until the
+/// main window has rendered, then starts all of it at once so the items overlap instead of queueing behind
+/// the first frame. Work registered after <see cref="Start"/> starts immediately.
+/// Each item is timed on the <see cref="StartupProfiler"/>; failures are logged and never reach the caller.
+/// </summary>
+public sealed class DeferredStartupService
+{
+    private readonly StartupProfiler _profiler;
+    private readonly ILogger<DeferredStartupService> _logger;
+    private readonly object _lockObject = new();
+    private List<(string Name, Func<Task> Work)>? _pending = new(); // null once started
+
+    public DeferredStartupService(StartupProfiler profiler, ILogger<DeferredStartupService> logger)
+    {
+        _profiler = profiler ?? throw new ArgumentNullException(nameof(profiler));
+        _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+    }
+
+    /// <summary>
+    /// Gets whether the deferred work has been released.
+    /// </summary>
+    public bool IsStarted
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _pending == null;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Runs <paramref name="work"/> once startup is interactive, or right away if it already is.
+    /// The work is invoked on the thread that calls <see cref="Start"/> (the UI thread), so it may touch
+    /// bound collections; long-running parts should await off-thread I/O.
+    /// </summary>
+    /// <param name="name">Name shown in the startup timing report.</param>
+    /// <param name="work">The work to run.</param>
+    public void Register(string name, Func<Task> work)
+    {
+        ArgumentNullException.ThrowIfNull(name);
+        ArgumentNullException.ThrowIfNull(work);
+
+        lock (_lockObject)
+        {
+            if (_pending != null)
+            {
+                _pending.Add((name, work));
+                return;
+            }
+        }
+
+        _ = RunAsync(name, work);
+    }
+
+    /// <summary>
+    /// Defers <paramref name="work"/> through <paramref name="startup"/>, or runs it now when there is no
+    /// startup pipeline (tests, design time).
+    /// </summary>
+    public static void Schedule(DeferredStartupService? startup, string name, Func<Task> work)
+    {
+        if (startup != null)
+        {
+            startup.Register(name, work);
+        }
+        else
+        {
+            _ = work();
+        }
+    }
+
+    /// <summary>
+    /// Starts all registered work concurrently. Later calls do nothing.
+    /// </summary>
+    /// <returns>A task that completes when the work registered so far has finished.</returns>
+    public Task Start()
+    {
+        List<(string Name, Func<Task> Work)>? pending;
+        lock (_lockObject)
+        {
+            pending = _pending;
+            _pending = null;
+        }
+
+        if (pending == null || pending.Count == 0)
+            return Task.CompletedTask;
+
+        var tasks = new Task[pending.Count];
+        for (int i = 0; i < pending.Count; i++)
+        {
+            tasks[i] = RunAsync(pending[i].Name, pending[i].Work);
+        }
+
+        return Task.WhenAll(tasks);
+    }
+
+    private async Task RunAsync(string name, Func<Task> work)
+    {
+        var start = Stopwatch.GetTimestamp();
+        try
+        {
+            await work();
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "Deferred startup work {Name} failed", name);
+        }
+        finally
+        {
+            _profiler.Record(name, start, isDeferred: true);
+        }
+    }
+}
@@ -34,6 +34,10 @@ public sealed class LocalizationService
             }
         }
 
+        // Parsing a strings dictionary costs tens of milliseconds; keep the one already loaded (App.xaml's default)
+        if (existingIdx >= 0 && string.Equals(merged[existingIdx].Source?.OriginalString, uri.OriginalString, StringComparison.OrdinalIgnoreCase))
+            return;
+
         var newDict = new ResourceDictionary { Source = uri };
         if (existingIdx >= 0)
             merged[existingIdx] = newDict;
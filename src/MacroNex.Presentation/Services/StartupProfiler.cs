@@ -0,0 +1,203 @@
+using System.Diagnostics;
+using System.Globalization;
+using System.Text;
+
+namespace MacroNex.Presentation.Services;
+
+/// <summary>
+/// Times the phases of application startup, measured from process start: the critical path up to the
+/// first rendered frame (time-to-interactive) and the deferred work that runs after it.
+/// Thread-safe; deferred work records its timings from the thread pool.
+/// </summary>
+public sealed class StartupProfiler
+{
+    /// <summary>
+    /// Time-to-interactive the startup path is expected to stay under.
+    /// </summary>
+    public static readonly TimeSpan InteractiveTarget = TimeSpan.FromSeconds(1);
+
+    private readonly object _lockObject = new();
+    private readonly List<StartupPhaseTiming> _phases = new();
+    private readonly long _startTimestamp;
+    private readonly TimeSpan _timeBeforeStart;
+    private TimeSpan? _timeToInteractive;
+
+    /// <summary>
+    /// Creates a profiler that counts the runtime startup before it as the first phase.
+    /// </summary>
+    public StartupProfiler()
+        : this(GetTimeSinceProcessStart())
+    {
+    }
+
+    /// <summary>
+    /// Creates a profiler whose clock starts at <paramref name="timeBeforeStart"/>.
+    /// </summary>
+    /// <param name="timeBeforeStart">Time already spent since process start, reported as the runtime startup phase.</param>
+    public StartupProfiler(TimeSpan timeBeforeStart)
+    {
+        _startTimestamp = Stopwatch.GetTimestamp();
+        _timeBeforeStart = timeBeforeStart < TimeSpan.Zero ? TimeSpan.Zero : timeBeforeStart;
+        if (_timeBeforeStart > TimeSpan.Zero)
+        {
+            _phases.Add(new StartupPhaseTiming("Runtime start", TimeSpan.Zero, _timeBeforeStart, false));
+        }
+    }
+
+    /// <summary>
+    /// Gets the time since process start.
+    /// </summary>
+    public TimeSpan Elapsed => ToElapsed(Stopwatch.GetTimestamp());
+
+    /// <summary>
+    /// Gets the time from process start to the first rendered frame, or null before it.
+    /// </summary>
+    public TimeSpan? TimeToInteractive
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _timeToInteractive;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the recorded phases in the order they finished.
+    /// </summary>
+    public IReadOnlyList<StartupPhaseTiming> Phases
+    {
+        get
+        {
+            lock (_lockObject)
+            {
+                return _phases.ToArray();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Times a critical-path phase until the returned scope is disposed.
+    /// </summary>
+    public PhaseScope Measure(string name) => new(this, name, Stopwatch.GetTimestamp());
+
+    /// <summary>
+    /// Records a phase that started at <paramref name="startTimestamp"/> (a <see cref="Stopwatch"/> timestamp) and ends now.
+    /// </summary>
+    /// <param name="name">Phase name shown in the report.</param>
+    /// <param name="startTimestamp">Stopwatch timestamp taken when the phase started.</param>
+    /// <param name="isDeferred">True for work that runs after the window is interactive.</param>
+    public void Record(string name, long startTimestamp, bool isDeferred = false)
+    {
+        ArgumentNullException.ThrowIfNull(name);
+
+        var end = Stopwatch.GetTimestamp();
+        var start = ToElapsed(startTimestamp);
+        var timing = new StartupPhaseTiming(name, start, ToElapsed(end) - start, isDeferred);
+
+        lock (_lockObject)
+        {
+            _phases.Add(timing);
+        }
+    }
+
+    /// <summary>
+    /// Marks the application as interactive. Only the first call counts.
+    /// </summary>
+    /// <returns>The time-to-interactive.</returns>
+    public TimeSpan MarkInteractive()
+    {
+        var elapsed = Elapsed;
+        lock (_lockObject)
+        {
+            _timeToInteractive ??= elapsed;
+            return _timeToInteractive.Value;
+        }
+    }
+
+    /// <summary>
+    /// Formats the timings as a plain-text report, one phase per line.
+    /// </summary>
+    public string FormatReport()
+    {
+        StartupPhaseTiming[] phases;
+        TimeSpan? timeToInteractive;
+        lock (_lockObject)
+        {
+            phases = _phases.ToArray();
+            timeToInteractive = _timeToInteractive;
+        }
+
+        var builder = new StringBuilder();
+        builder.Append(CultureInfo.InvariantCulture, $"Startup timing at {DateTime.Now:yyyy-MM-dd HH:mm:ss}");
+        if (timeToInteractive is { } tti)
+        {
+            builder.Append(CultureInfo.InvariantCulture, $", time-to-interactive {tti.TotalMilliseconds:F0} ms");
+            builder.Append(tti <= InteractiveTarget ? " (within " : " (over ");
+            builder.Append(CultureInfo.InvariantCulture, $"{InteractiveTarget.TotalMilliseconds:F0} ms target)");
+        }
+        builder.AppendLine();
+
+        var nameWidth = phases.Length == 0 ? 0 : phases.Max(p => p.Name.Length + (p.IsDeferred ? 2 : 0));
+        foreach (var phase in phases.OrderBy(p => p.IsDeferred).ThenBy(p => p.Start))
+        {
+            var name = phase.IsDeferred ? "* " + phase.Name : phase.Name;
+            builder.Append(CultureInfo.InvariantCulture,
+                $"  {name.PadRight(nameWidth)}  at {phase.Start.TotalMilliseconds,8:F1} ms  took {phase.Duration.TotalMilliseconds,8:F1} ms");
+            builder.AppendLine();
+        }
+
+        if (phases.Any(p => p.IsDeferred))
+        {
+            builder.AppendLine("  (* deferred until after the first frame)");
+        }
+
+        return builder.ToString();
+    }
+
+    private TimeSpan ToElapsed(long timestamp) => _timeBeforeStart + Stopwatch.GetElapsedTime(_startTimestamp, timestamp);
+
+    private static TimeSpan GetTimeSinceProcessStart()
+    {
+        try
+        {
+            using var process = Process.GetCurrentProcess();
+            return DateTime.Now - process.StartTime;
+        }
+        catch
+        {
+            // Start time is unavailable in some sandboxes; report from profiler creation instead
+            return TimeSpan.Zero;
+        }
+    }
+
+    /// <summary>
+    /// Records a critical-path phase when disposed.
+    /// </summary>
+    public readonly struct PhaseScope : IDisposable
+    {
+        private readonly StartupProfiler? _profiler;
+        private readonly string _name;
+        private readonly long _startTimestamp;
+
+        internal PhaseScope(StartupProfiler profiler, string name, long startTimestamp)
+        {
+            _profiler = profiler;
+            _name = name;
+            _startTimestamp = startTimestamp;
+        }
+
+        /// <inheritdoc />
+        public void Dispose() => _profiler?.Record(_name, _startTimestamp);
+    }
+}
+
+/// <summary>
+/// One timed startup phase.
+/// </summary>
+/// <param name="Name">Phase name.</param>
+/// <param name="Start">Time from process start to the start of the phase.</param>
+/// <param name="Duration">How long the phase took.</param>
+/// <param name="IsDeferred">True for work that ran after the window was interactive.</param>
+public readonly record struct StartupPhaseTiming(string Name, TimeSpan Start, TimeSpan Duration, bool IsDeferred);
@@ -0,0 +1,228 @@
+using System.Collections.Concurrent;
+using System.Windows.Threading;
+
+namespace MacroNex.Presentation.Services;
+
+/// <summary>
+/// Delivers high-rate updates (log entries, progress) to the UI thread in frame-rate-limited batches.
+/// Producers post from any thread without touching the dispatcher queue; a single background-priority
+/// timer, running only while updates are pending, applies everything queued since the previous tick.
+/// Input, rendering and the stop button are always dispatched ahead of these updates.
+/// </summary>
+public sealed class UiUpdatePump : IDisposable
+{
+    /// <summary>
+    /// Default tick interval (about 30 Hz).
+    /// </summary>
+    public static readonly TimeSpan DefaultInterval = TimeSpan.FromMilliseconds(33);
+
+    private readonly Dispatcher? _dispatcher;
+    private readonly DispatcherTimer? _timer;
+    private readonly List<IPendingUpdate> _sinks = new();
+    private int _scheduled;
+
+    /// <summary>
+    /// Creates a pump bound to <paramref name="dispatcher"/>. Without a dispatcher (tests, design time)
+    /// updates are applied synchronously on the posting thread.
+    /// </summary>
+    /// <param name="dispatcher">UI dispatcher, or null to apply updates inline.</param>
+    /// <param name="interval">Tick interval; defaults to <see cref="DefaultInterval"/>.</param>
+    public UiUpdatePump(Dispatcher? dispatcher, TimeSpan? interval = null)
+    {
+        _dispatcher = dispatcher;
+        if (_dispatcher != null)
+        {
+            _timer = new DispatcherTimer(DispatcherPriority.Background, _dispatcher) { Interval = interval ?? DefaultInterval };
+            _timer.Tick += OnTick;
+        }
+    }
+
+    /// <summary>
+    /// Creates a queue whose items are applied as one batch per tick. When more than
+    /// <paramref name="capacity"/> items are pending, the oldest are discarded.
+    /// </summary>
+    public UiBatchQueue<T> CreateBatchQueue<T>(Action<IReadOnlyList<T>> apply, int capacity)
+    {
+        var queue = new UiBatchQueue<T>(this, apply, capacity);
+        lock (_sinks)
+            _sinks.Add(queue);
+        return queue;
+    }
+
+    /// <summary>
+    /// Creates a slot where only the latest posted value is applied per tick.
+    /// </summary>
+    public UiLatestValue<T> CreateLatestValue<T>(Action<T> apply) where T : class
+    {
+        var slot = new UiLatestValue<T>(this, apply);
+        lock (_sinks)
+            _sinks.Add(slot);
+        return slot;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (_timer == null)
+            return;
+
+        if (_dispatcher!.CheckAccess())
+            _timer.Stop();
+        else
+            _dispatcher.BeginInvoke(_timer.Stop);
+    }
+
+    internal void Schedule(IPendingUpdate sink)
+    {
+        if (_dispatcher == null)
+        {
+            sink.Apply();
+            return;
+        }
+
+        // Only the idle-to-busy transition touches the dispatcher queue
+        if (Interlocked.Exchange(ref _scheduled, 1) == 0)
+            _dispatcher.BeginInvoke(DispatcherPriority.Background, _timer!.Start);
+    }
+
+    private void OnTick(object? sender, EventArgs e)
+    {
+        // Clear the flag before draining so a post racing with this tick schedules the next one
+        Volatile.Write(ref _scheduled, 0);
+
+        IPendingUpdate[] sinks;
+        lock (_sinks)
+            sinks = _sinks.ToArray();
+
+        var applied = false;
+        foreach (var sink in sinks)
+        {
+            try
+            {
+                applied |= sink.Apply();
+            }
+            catch
+            {
+                // Never let a UI update break the pump.
+            }
+        }
+
+        if (!applied && Volatile.Read(ref _scheduled) == 0)
+            _timer!.Stop();
+        else
+            Interlocked.Exchange(ref _scheduled, 1);
+    }
+}
+
+/// <summary>
+/// Pending UI work registered with a <see cref="UiUpdatePump"/>.
+/// </summary>
+internal interface IPendingUpdate
+{
+    /// <summary>
+    /// Applies pending work on the UI thread.
+    /// </summary>
+    /// <returns>True if anything was applied.</returns>
+    bool Apply();
+}
+
+/// <summary>
+/// Bounded multi-producer queue drained once per pump tick.
+/// </summary>
+public sealed class UiBatchQueue<T> : IPendingUpdate
+{
+    private readonly UiUpdatePump _pump;
+    private readonly Action<IReadOnlyList<T>> _apply;
+    private readonly int _capacity;
+    private readonly ConcurrentQueue<T> _pending = new();
+    private readonly List<T> _batch = new();
+    private int _count;
+
+    internal UiBatchQueue(UiUpdatePump pump, Action<IReadOnlyList<T>> apply, int capacity)
+    {
+        if (capacity < 1)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be at least 1.");
+
+        _pump = pump;
+        _apply = apply ?? throw new ArgumentNullException(nameof(apply));
+        _capacity = capacity;
+    }
+
+    /// <summary>
+    /// Queues an item for the next tick. Safe to call from any thread.
+    /// </summary>
+    public void Post(T item)
+    {
+        _pending.Enqueue(item);
+        if (Interlocked.Increment(ref _count) > _capacity && _pending.TryDequeue(out _))
+            Interlocked.Decrement(ref _count);
+
+        _pump.Schedule(this);
+    }
+
+    /// <summary>
+    /// Discards everything not yet applied.
+    /// </summary>
+    public void Clear()
+    {
+        while (_pending.TryDequeue(out _))
+            Interlocked.Decrement(ref _count);
+    }
+
+    bool IPendingUpdate.Apply()
+    {
+        _batch.Clear();
+        while (_batch.Count < _capacity && _pending.TryDequeue(out var item))
+        {
+            Interlocked.Decrement(ref _count);
+            _batch.Add(item);
+        }
+
+        if (_batch.Count == 0)
+            return false;
+
+        _apply(_batch);
+        _batch.Clear();
+        return true;
+    }
+}
+
+/// <summary>
+/// Coalescing slot: only the most recent value posted before a tick is applied.
+/// </summary>
+public sealed class UiLatestValue<T> : IPendingUpdate where T : class
+{
+    private readonly UiUpdatePump _pump;
+    private readonly Action<T> _apply;
+    private T? _pending;
+
+    internal UiLatestValue(UiUpdatePump pump, Action<T> apply)
+    {
+        _pump = pump;
+        _apply = apply ?? throw new ArgumentNullException(nameof(apply));
+    }
+
+    /// <summary>
+    /// Replaces the pending value. Safe to call from any thread.
+    /// </summary>
+    public void Post(T value)
+    {
+        Volatile.Write(ref _pending, value);
+        _pump.Schedule(this);
+    }
+
+    /// <summary>
+    /// Discards the pending value, if any.
+    /// </summary>
+    public void Clear() => Interlocked.Exchange(ref _pending, null);
+
+    bool IPendingUpdate.Apply()
+    {
+        var value = Interlocked.Exchange(ref _pending, null);
+        if (value == null)
+            return false;
+
+        _apply(value);
+        return true;
+    }
+}
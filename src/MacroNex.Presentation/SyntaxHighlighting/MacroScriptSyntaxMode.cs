@@ -9,6 +9,8 @@ namespace MacroNex.Presentation.SyntaxHighlighting;
 
 /// <summary>
 /// Provides syntax highlighting for MacroNex script DSL.
+/// Every span closes at the end of its line, so AvalonEdit's highlighter re-colors only the edited
+/// lines instead of cascading to the rest of the document; keep new spans single-line.
 /// </summary>
 public static class MacroScriptSyntaxMode
 {
@@ -48,7 +50,7 @@ public static class MacroScriptSyntaxMode
     
     <!-- Host API functions -->
     <Rule color=""Function"">
-      \b(move|move_rel|sleep|msleep|type_text|mouse_click|mouse_down|mouse_release|key_down|key_release)\b
+      \b(move|move_rel|move_stream|sleep|msleep|type_text|mouse_click|mouse_down|mouse_release|key_down|key_release|batch)\b
     </Rule>
 
     <!-- Lua keywords -->
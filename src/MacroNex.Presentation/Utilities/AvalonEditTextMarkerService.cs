@@ -6,6 +6,7 @@ namespace MacroNex.Presentation.Utilities;
 
 /// <summary>
 /// Minimal text marker service for AvalonEdit to underline and tooltip error spans.
+/// Drawing only visits markers that overlap the visible lines, so its cost does not grow with the document.
 /// </summary>
 public sealed class AvalonEditTextMarkerService : IBackgroundRenderer
 {
@@ -21,23 +22,26 @@ public sealed class AvalonEditTextMarkerService : IBackgroundRenderer
 
     public void Draw(TextView textView, DrawingContext drawingContext)
     {
-        if (textView.Document == null)
+        // Never force a layout from inside a render pass; the text view redraws once lines are valid.
+        if (textView.Document == null || !textView.VisualLinesValid)
             return;
 
-        textView.EnsureVisualLines();
+        var visualLines = textView.VisualLines;
+        if (visualLines.Count == 0)
+            return;
+
+        var viewStart = visualLines[0].FirstDocumentLine.Offset;
+        var viewEnd = visualLines[^1].LastDocumentLine.EndOffset;
 
-        foreach (var marker in _markers)
+        foreach (var marker in _markers.FindOverlappingSegments(viewStart, viewEnd - viewStart))
         {
             foreach (var rect in BackgroundGeometryBuilder.GetRectsForSegment(textView, marker))
             {
-                var underlinePen = new Pen(marker.UnderlineColor, 1);
-                underlinePen.Freeze();
-
                 // Draw slightly above the bottom edge to avoid clipping.
                 var y = rect.Bottom - 1;
                 var start = new System.Windows.Point(rect.Left, y);
                 var end = new System.Windows.Point(rect.Right, y);
-                drawingContext.DrawLine(underlinePen, start, end);
+                drawingContext.DrawLine(marker.UnderlinePen, start, end);
             }
         }
     }
@@ -51,19 +55,24 @@ public sealed class AvalonEditTextMarkerService : IBackgroundRenderer
     {
         Clear();
         if (length <= 0) length = 1;
-        var m = new TextMarker
+        var m = new TextMarker(Brushes.IndianRed)
         {
             StartOffset = offset,
             Length = length,
-            Message = message,
-            UnderlineColor = Brushes.IndianRed
+            Message = message
         };
         _markers.Add(m);
     }
 
     private sealed class TextMarker : TextSegment
     {
-        public Brush UnderlineColor { get; init; } = Brushes.IndianRed;
+        public TextMarker(Brush underlineColor)
+        {
+            UnderlinePen = new Pen(underlineColor, 1);
+            UnderlinePen.Freeze();
+        }
+
+        public Pen UnderlinePen { get; }
         public string Message { get; init; } = string.Empty;
     }
 }
@@ -0,0 +1,57 @@
+using System.Collections.ObjectModel;
+using System.Collections.Specialized;
+using System.ComponentModel;
+
+namespace MacroNex.Presentation.Utilities;
+
+/// <summary>
+/// ObservableCollection that supports bulk changes with a single Reset notification,
+/// so a bound ItemsControl re-measures once per batch instead of once per item.
+/// </summary>
+public class RangeObservableCollection<T> : ObservableCollection<T>
+{
+    /// <summary>
+    /// Appends items, trimming from the front so at most <paramref name="maxCount"/> items remain.
+    /// </summary>
+    public void AppendRange(IReadOnlyList<T> items, int maxCount = int.MaxValue)
+    {
+        if (items == null) throw new ArgumentNullException(nameof(items));
+        if (items.Count == 0)
+            return;
+
+        CheckReentrancy();
+
+        var list = (List<T>)Items;
+        var skip = Math.Max(0, items.Count - maxCount);
+        var overflow = list.Count + items.Count - skip - maxCount;
+        if (overflow > 0)
+            list.RemoveRange(0, overflow);
+        for (var i = skip; i < items.Count; i++)
+            list.Add(items[i]);
+
+        RaiseReset();
+    }
+
+    /// <summary>
+    /// Replaces the whole contents.
+    /// </summary>
+    public void ReplaceAll(IEnumerable<T> items)
+    {
+        if (items == null) throw new ArgumentNullException(nameof(items));
+
+        CheckReentrancy();
+
+        var list = (List<T>)Items;
+        list.Clear();
+        list.AddRange(items);
+
+        RaiseReset();
+    }
+
+    private void RaiseReset()
+    {
+        OnPropertyChanged(new PropertyChangedEventArgs(nameof(Count)));
+        OnPropertyChanged(new PropertyChangedEventArgs("Item[]"));
+        OnCollectionChanged(new NotifyCollectionChangedEventArgs(NotifyCollectionChangedAction.Reset));
+    }
+}
@@ -131,14 +131,15 @@ public partial class CommandGridViewModel : ObservableObject
     {
         if (_isUpdatingDocument) return;
 
-        ScriptText = Document.Text;
-
-        // Check if text has changed from original
-        HasUnsavedChanges = CurrentScript != null && Document.Text != _originalScriptText;
-        if (HasUnsavedChanges)
+        // Keep keystrokes O(1): the document is only materialized and compared against the
+        // saved text once the debounce fires, so large scripts stay responsive while typing.
+        if (CurrentScript != null)
+        {
+            HasUnsavedChanges = true;
             EditorStatusText = "Unsaved";
+        }
 
-        // Debounced validate + autosave on UI thread (more reliable than Task.Run + dispatcher hops).
+        // Debounced validate + autosave; the timer ticks on the UI thread, parsing happens off it.
         _pendingVersion++;
         _autoSaveTimer.Stop();
         _autoSaveTimer.Start();
@@ -358,16 +359,30 @@ public partial class CommandGridViewModel : ObservableObject
 
         var version = _pendingVersion;
 
+        // Snapshots are immutable and cheap to take; the text is built from it on the worker
+        var snapshot = Document.CreateSnapshot();
+        var text = await Task.Run(() => snapshot.Text);
+        if (version != _pendingVersion)
+            return;
+
+        ScriptText = text;
+        if (CurrentScript != null)
+        {
+            HasUnsavedChanges = !string.Equals(text, _originalScriptText, StringComparison.Ordinal);
+            if (!HasUnsavedChanges)
+                EditorStatusText = string.Empty;
+        }
+
         // 1) Validate first (so we don't auto-save invalid scripts)
-        await ValidateLuaSyntaxAsync(CancellationToken.None);
+        await ValidateLuaSyntaxAsync(text, version, CancellationToken.None);
         if (version != _pendingVersion)
             return;
 
         // 2) Auto-save
-        await AutoSaveAsync(version, CancellationToken.None);
+        await AutoSaveAsync(text, version, CancellationToken.None);
     }
 
-    private async Task AutoSaveAsync(int version, CancellationToken ct)
+    private async Task AutoSaveAsync(string text, int version, CancellationToken ct)
     {
         if (CurrentScript == null)
             return;
@@ -384,7 +399,7 @@ public partial class CommandGridViewModel : ObservableObject
         try
         {
             EditorStatusText = "Saving…";
-            CurrentScript.SourceText = Document.Text ?? string.Empty;
+            CurrentScript.SourceText = text;
             await _scriptManager.UpdateScriptAsync(CurrentScript);
 
             if (version != _pendingVersion)
@@ -405,45 +420,51 @@ public partial class CommandGridViewModel : ObservableObject
         }
     }
 
-    private async Task ValidateLuaSyntaxAsync(CancellationToken ct)
+    private async Task ValidateLuaSyntaxAsync(string code, int version, CancellationToken ct)
     {
-        if (CurrentScript == null)
+        if (CurrentScript == null || string.IsNullOrWhiteSpace(code))
         {
             SetDiagnostic(null, 0, 0);
             return;
         }
 
-        var code = Document.Text ?? string.Empty;
-        if (string.IsNullOrWhiteSpace(code))
+        // A full MoonSharp parse of a recording-sized script takes longer than a frame
+        var (message, rawLine, rawCol) = await Task.Run(() => CheckLuaSyntax(code), ct);
+
+        // A newer edit is pending; its own tick will report
+        if (version != _pendingVersion)
+            return;
+
+        SetDiagnostic(message, rawLine, rawCol);
+        if (message == null)
         {
-            SetDiagnostic(null, 0, 0);
+            _lastLoggedSyntaxDiagnosticKey = null;
             return;
         }
 
+        // 也寫入下方紀錄區塊（去重避免每次 debounce 都刷一筆）。
+        await LogSyntaxDiagnosticAsync(message, rawLine, rawCol);
+    }
+
+    private static (string? Message, int RawLine, int RawColumn) CheckLuaSyntax(string code)
+    {
         try
         {
             var lua = new LuaScript(CoreModules.Basic | CoreModules.String | CoreModules.Table | CoreModules.Math);
             lua.LoadString(code);
-            SetDiagnostic(null, 0, 0);
-            _lastLoggedSyntaxDiagnosticKey = null;
+            return (null, 0, 0);
         }
         catch (SyntaxErrorException ex)
         {
             // MoonSharp 在 DecoratedMessage 中會帶 chunk_0:(line,start-end) 這種格式，
             // 這裡只解析第一個位置（MoonSharp 只回報第一個語法錯誤）。
             var (rawLine, rawCol) = TryParseLineCol(ex.DecoratedMessage);
-            SetDiagnostic(ex.DecoratedMessage, rawLine, rawCol);
-
-            // 也寫入下方紀錄區塊（去重避免每次 debounce 都刷一筆）。
-            await LogSyntaxDiagnosticAsync(ex.DecoratedMessage, rawLine, rawCol);
+            return (ex.DecoratedMessage, rawLine, rawCol);
         }
         catch (Exception ex)
         {
-            SetDiagnostic(ex.Message, 0, 0);
-            await LogSyntaxDiagnosticAsync(ex.Message, 0, 0);
+            return (ex.Message, 0, 0);
         }
-
-        await Task.CompletedTask;
     }
 
     private async Task LogSyntaxDiagnosticAsync(string? message, int rawLine, int rawCol)
@@ -493,6 +514,10 @@ public partial class CommandGridViewModel : ObservableObject
     {
         if (string.IsNullOrWhiteSpace(message))
         {
+            // Every debounce tick reports; only a real change should repaint the editor
+            if (!HasDiagnostic && DiagnosticMessage == null)
+                return;
+
             DiagnosticMessage = null;
             DiagnosticLine = 0;
             DiagnosticColumn = 0;
@@ -510,6 +535,10 @@ public partial class CommandGridViewModel : ObservableObject
             col = 1;
         }
 
+        if (HasDiagnostic && DiagnosticLine == line && DiagnosticColumn == col &&
+            string.Equals(DiagnosticMessage, message, StringComparison.Ordinal))
+            return;
+
         DiagnosticMessage = message;
         DiagnosticLine = line;
         DiagnosticColumn = col;
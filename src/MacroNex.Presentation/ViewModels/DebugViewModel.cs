@@ -3,6 +3,8 @@ using CommunityToolkit.Mvvm.Input;
 using MacroNex.Application.Services;
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Adapters;
+using MacroNex.Presentation.Services;
 using MacroNex.Presentation.Utilities;
 using System.Collections.ObjectModel;
 
@@ -17,6 +19,7 @@ public partial class DebugViewModel : ObservableObject
     private readonly ILoggingService _loggingService;
     private readonly IInputSimulatorFactory _inputSimulatorFactory;
     private readonly ISettingsService _settingsService;
+    private readonly IInputLatencyMonitor? _latencyMonitor;
 
     [ObservableProperty]
     private ArduinoConnectionState arduinoConnectionState = ArduinoConnectionState.Disconnected;
@@ -28,8 +31,19 @@ public partial class DebugViewModel : ObservableObject
     private ObservableCollection<string> availableSerialPorts = new();
 
     [ObservableProperty]
+    [NotifyCanExecuteChangedFor(nameof(ConnectCommand))]
     private string? selectedSerialPort;
 
+    // Device pool properties
+    [ObservableProperty]
+    private ObservableCollection<ArduinoDeviceHealthDisplay> arduinoDevices = new();
+
+    [ObservableProperty]
+    private string arduinoRoutingDescription = "單一裝置";
+
+    [ObservableProperty]
+    private string arduinoHealthStatus = "未連接";
+
     [ObservableProperty]
     private string statusMessage = "就緒";
 
@@ -87,30 +101,40 @@ public partial class DebugViewModel : ObservableObject
     [ObservableProperty]
     private double manualRatioY = 1.0;
 
+    // Input latency properties
+    [ObservableProperty]
+    private ObservableCollection<InputLatencyStageDisplay> inputLatencyStages = new();
+
+    [ObservableProperty]
+    private string inputLatencyStatus = "尚無資料";
+
     private CancellationTokenSource? _calibrationCts;
 
     public DebugViewModel(
         ArduinoConnectionService arduinoConnectionService,
         ILoggingService loggingService,
         IInputSimulatorFactory inputSimulatorFactory,
-        ISettingsService settingsService)
+        ISettingsService settingsService,
+        IInputLatencyMonitor? latencyMonitor = null,
+        DeferredStartupService? deferredStartup = null)
     {
         _arduinoConnectionService = arduinoConnectionService ?? throw new ArgumentNullException(nameof(arduinoConnectionService));
         _loggingService = loggingService ?? throw new ArgumentNullException(nameof(loggingService));
         _inputSimulatorFactory = inputSimulatorFactory ?? throw new ArgumentNullException(nameof(inputSimulatorFactory));
         _settingsService = settingsService ?? throw new ArgumentNullException(nameof(settingsService));
+        _latencyMonitor = latencyMonitor;
 
         _arduinoConnectionService.ConnectionStateChanged += OnArduinoConnectionStateChanged;
+        _arduinoConnectionService.DeviceStateChanged += OnArduinoDeviceStateChanged;
 
         // Initialize state
         ArduinoConnectionState = _arduinoConnectionService.ConnectionState;
-        ConnectedPortName = _arduinoConnectionService.ConnectedPortName;
+        ConnectedPortName = FormatConnectedPorts();
+        RefreshArduinoHealth();
 
-        // Load available ports
-        _ = RefreshPortsAsync();
-
-        // Load existing calibration data
-        _ = LoadCalibrationDataAsync();
+        // The debug tab is not needed for the first frame: scan ports and load calibration after it
+        DeferredStartupService.Schedule(deferredStartup, "Debug serial port scan", RefreshPortsAsync);
+        DeferredStartupService.Schedule(deferredStartup, "Calibration load", LoadCalibrationDataAsync);
     }
 
     private void OnArduinoConnectionStateChanged(object? sender, Domain.Interfaces.ArduinoConnectionStateChangedEventArgs e)
@@ -118,9 +142,10 @@ public partial class DebugViewModel : ObservableObject
         System.Windows.Application.Current?.Dispatcher.Invoke(() =>
         {
             ArduinoConnectionState = e.NewState;
-            ConnectedPortName = e.PortName;
+            ConnectedPortName = FormatConnectedPorts();
             OnPropertyChanged(nameof(ArduinoConnectionState));
             OnPropertyChanged(nameof(ConnectedPortName));
+            RefreshArduinoHealth();
 
             // Notify all connection-dependent commands to update their CanExecute state
             ConnectCommand.NotifyCanExecuteChanged();
@@ -131,6 +156,77 @@ public partial class DebugViewModel : ObservableObject
         });
     }
 
+    private void OnArduinoDeviceStateChanged(object? sender, Domain.Interfaces.ArduinoConnectionStateChangedEventArgs e)
+    {
+        System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+        {
+            ConnectedPortName = FormatConnectedPorts();
+            RefreshArduinoHealth();
+            ConnectCommand.NotifyCanExecuteChanged();
+            AutoConnectCommand.NotifyCanExecuteChanged();
+        });
+    }
+
+    private string? FormatConnectedPorts()
+    {
+        var ports = _arduinoConnectionService.ConnectedPortNames;
+        return ports.Count > 0 ? string.Join(", ", ports) : null;
+    }
+
+    [RelayCommand]
+    private void RefreshArduinoHealth()
+    {
+        var health = _arduinoConnectionService.GetHealth();
+        var routing = _arduinoConnectionService.Routing;
+
+        ArduinoDevices.Clear();
+        foreach (var device in health.Devices)
+        {
+            ArduinoDevices.Add(new ArduinoDeviceHealthDisplay
+            {
+                PortName = device.PortName,
+                Role = GetRoleDisplayName(device),
+                State = device.State.ToString(),
+                CommandsSent = device.CommandsSent,
+                LastError = device.LastErrorTime is { } time ? $"{time.ToLocalTime():HH:mm:ss} {device.LastError}" : device.LastError ?? ""
+            });
+        }
+
+        if (routing == null)
+        {
+            ArduinoRoutingDescription = "單一裝置";
+        }
+        else
+        {
+            var mode = routing.Mode switch
+            {
+                ArduinoRoutingMode.SplitMouseKeyboard => "滑鼠/鍵盤分流",
+                ArduinoRoutingMode.RoundRobin => "輪流分配",
+                ArduinoRoutingMode.Primary => "僅主裝置",
+                _ => routing.Mode.ToString()
+            };
+            ArduinoRoutingDescription = routing.PreserveOrderAcrossDevices ? $"{mode}（保持跨裝置順序）" : mode;
+        }
+
+        ArduinoHealthStatus = health.ConnectedCount == 0
+            ? "未連接"
+            : health.IsDegraded
+                ? $"部分裝置離線：{health.ConnectedCount}/{health.Devices.Count} 已連接"
+                : $"{health.ConnectedCount} 台裝置已連接";
+    }
+
+    private static string GetRoleDisplayName(ArduinoDeviceHealth device)
+    {
+        var role = device.Roles switch
+        {
+            ArduinoDeviceRoles.Mouse => "滑鼠",
+            ArduinoDeviceRoles.Keyboard => "鍵盤",
+            ArduinoDeviceRoles.Mouse | ArduinoDeviceRoles.Keyboard => "滑鼠+鍵盤",
+            _ => "待命"
+        };
+        return device.IsPrimary ? $"{role}（主）" : role;
+    }
+
     [RelayCommand]
     private async Task RefreshPortsAsync()
     {
@@ -160,10 +256,11 @@ public partial class DebugViewModel : ObservableObject
 
         try
         {
-            var success = await _arduinoConnectionService.AutoConnectAsync();
+            var settings = await _settingsService.LoadAsync();
+            var success = await _arduinoConnectionService.AutoConnectAsync(settings.ArduinoDeviceCount);
             if (success)
             {
-                StatusMessage = $"自動連接成功！已連接到 {_arduinoConnectionService.ConnectedPortName}";
+                StatusMessage = $"自動連接成功！已連接到 {FormatConnectedPorts()}";
             }
             else
             {
@@ -182,7 +279,10 @@ public partial class DebugViewModel : ObservableObject
         }
     }
 
-    private bool CanAutoConnect() => !IsAutoConnecting && ArduinoConnectionState != ArduinoConnectionState.Connected && ArduinoConnectionState != ArduinoConnectionState.Connecting;
+    private bool CanAutoConnect()
+        => !IsAutoConnecting &&
+           ArduinoConnectionState != ArduinoConnectionState.Connecting &&
+           _arduinoConnectionService.CanConnectMoreDevices;
 
     [RelayCommand(CanExecute = nameof(CanConnect))]
     private async Task ConnectAsync()
@@ -208,13 +308,16 @@ public partial class DebugViewModel : ObservableObject
         {
             ConnectCommand.NotifyCanExecuteChanged();
             DisconnectCommand.NotifyCanExecuteChanged();
+            AutoConnectCommand.NotifyCanExecuteChanged();
         }
     }
 
+    // With a device pool, further ports can be added while connected
     private bool CanConnect()
         => !string.IsNullOrWhiteSpace(SelectedSerialPort) &&
-           ArduinoConnectionState != ArduinoConnectionState.Connected &&
-           ArduinoConnectionState != ArduinoConnectionState.Connecting;
+           ArduinoConnectionState != ArduinoConnectionState.Connecting &&
+           _arduinoConnectionService.CanConnectMoreDevices &&
+           !_arduinoConnectionService.IsPortConnected(SelectedSerialPort);
 
     [RelayCommand(CanExecute = nameof(CanDisconnect))]
     private async Task DisconnectAsync()
@@ -250,6 +353,48 @@ public partial class DebugViewModel : ObservableObject
         return _inputSimulatorFactory.GetInputSimulator(settings.GlobalInputMode);
     }
 
+    /// <summary>
+    /// 校準儲存後讓硬體模擬器重新載入並重建查找表
+    /// </summary>
+    private void InvalidateHardwareCalibrationCache()
+    {
+        if (_inputSimulatorFactory.GetInputSimulator(InputMode.Hardware) is ArduinoInputSimulator arduinoSimulator)
+            arduinoSimulator.InvalidateCalibrationCache();
+    }
+
+    private bool CanUseLatencyMonitor() => _latencyMonitor != null;
+
+    [RelayCommand(CanExecute = nameof(CanUseLatencyMonitor))]
+    private void RefreshInputLatency()
+    {
+        var statistics = _latencyMonitor!.GetStatistics();
+
+        InputLatencyStages.Clear();
+        foreach (var stage in statistics)
+        {
+            InputLatencyStages.Add(new InputLatencyStageDisplay
+            {
+                Stage = stage.Stage.ToString(),
+                Count = stage.Count,
+                P50Ms = stage.P50.TotalMilliseconds,
+                P99Ms = stage.P99.TotalMilliseconds,
+                MaxMs = stage.Max.TotalMilliseconds
+            });
+        }
+
+        InputLatencyStatus = statistics.Count > 0
+            ? $"更新於 {DateTime.Now:HH:mm:ss}"
+            : "尚無資料";
+    }
+
+    [RelayCommand(CanExecute = nameof(CanUseLatencyMonitor))]
+    private void ResetInputLatency()
+    {
+        _latencyMonitor!.Reset();
+        InputLatencyStages.Clear();
+        InputLatencyStatus = "已重設";
+    }
+
     [RelayCommand]
     private async Task GetCursorPositionAsync()
     {
@@ -716,6 +861,7 @@ public partial class DebugViewModel : ObservableObject
             var settings = await _settingsService.LoadAsync();
             settings.MouseCalibration = null;
             await _settingsService.SaveAsync(settings);
+            InvalidateHardwareCalibrationCache();
 
             HasCalibrationData = false;
             LastCalibrationTime = null;
@@ -758,6 +904,7 @@ public partial class DebugViewModel : ObservableObject
             var settings = await _settingsService.LoadAsync();
             settings.MouseCalibration = calibrationData;
             await _settingsService.SaveAsync(settings);
+            InvalidateHardwareCalibrationCache();
 
             // Update UI
             HasCalibrationData = true;
@@ -891,6 +1038,7 @@ public partial class DebugViewModel : ObservableObject
         var settings = await _settingsService.LoadAsync();
         settings.MouseCalibration = calibrationData;
         await _settingsService.SaveAsync(settings);
+        InvalidateHardwareCalibrationCache();
 
         // Update UI
         HasCalibrationData = true;
@@ -1064,3 +1212,27 @@ public class CalibrationPointDisplay
     public string Axis { get; set; } = "";
     public double Ratio => HidDelta != 0 ? ActualPixelDelta / HidDelta : 0;
 }
+
+/// <summary>
+/// Display model for one input latency stage in the DataGrid.
+/// </summary>
+public class InputLatencyStageDisplay
+{
+    public string Stage { get; set; } = "";
+    public long Count { get; set; }
+    public double P50Ms { get; set; }
+    public double P99Ms { get; set; }
+    public double MaxMs { get; set; }
+}
+
+/// <summary>
+/// Display model for one connected Arduino device in the DataGrid.
+/// </summary>
+public class ArduinoDeviceHealthDisplay
+{
+    public string PortName { get; set; } = "";
+    public string Role { get; set; } = "";
+    public string State { get; set; } = "";
+    public long CommandsSent { get; set; }
+    public string LastError { get; set; } = "";
+}
@@ -5,6 +5,7 @@ using MacroNex.Domain.Events;
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using MacroNex.Application.Services;
+using MacroNex.Presentation.Services;
 using MacroNex.Presentation.Views;
 using MacroNex.Presentation.Utilities;
 
@@ -20,6 +21,7 @@ public partial class ExecutionControlViewModel : ObservableObject
     private readonly ILoggingService _loggingService;
     private readonly ISettingsService _settingsService;
     private readonly ArduinoConnectionService _arduinoConnectionService;
+    private readonly UiLatestValue<ExecutionProgressEventArgs> _pendingProgress;
 
     [ObservableProperty]
     private Script? script;
@@ -51,16 +53,26 @@ public partial class ExecutionControlViewModel : ObservableObject
     [ObservableProperty]
     private InputMode inputMode = InputMode.HighLevel;
 
+    /// <summary>
+    /// Lateness of the last run against its deadline timeline; null when it ran with relative timing.
+    /// </summary>
+    [ObservableProperty]
+    private string? timingSummary;
+
     [ObservableProperty]
     private ArduinoConnectionState arduinoConnectionState = ArduinoConnectionState.Disconnected;
 
-    public ExecutionControlViewModel(IExecutionService executionService, ILoggingService loggingService, ISettingsService settingsService, ArduinoConnectionService arduinoConnectionService)
+    public ExecutionControlViewModel(IExecutionService executionService, ILoggingService loggingService, ISettingsService settingsService, ArduinoConnectionService arduinoConnectionService, UiUpdatePump? uiUpdatePump = null)
     {
         _executionService = executionService ?? throw new ArgumentNullException(nameof(executionService));
         _loggingService = loggingService ?? throw new ArgumentNullException(nameof(loggingService));
         _settingsService = settingsService ?? throw new ArgumentNullException(nameof(settingsService));
         _arduinoConnectionService = arduinoConnectionService ?? throw new ArgumentNullException(nameof(arduinoConnectionService));
 
+        // 進度更新只保留最新值並以固定幀率套用，執行緒不會因等待 UI 而阻塞
+        var pump = uiUpdatePump ?? new UiUpdatePump(System.Windows.Application.Current?.Dispatcher);
+        _pendingProgress = pump.CreateLatestValue<ExecutionProgressEventArgs>(ApplyProgress);
+
         // Mirror service state
         State = _executionService.State;
         Script = _executionService.CurrentScript;
@@ -162,6 +174,7 @@ public partial class ExecutionControlViewModel : ObservableObject
             TotalCommandCount = Script.CommandCount;
             CompletionPercentage = 0;
             LastError = null;
+            TimingSummary = null;
         });
 
         // Get global input mode from settings
@@ -174,6 +187,8 @@ public partial class ExecutionControlViewModel : ObservableObject
         options.ShowCountdown = false; // UI handles countdown (focus warning)
         options.CountdownDuration = TimeSpan.Zero;
         options.InputMode = globalInputMode;
+        options.UseHighPrecisionTiming = settings.HighPrecisionTiming;
+        options.TimingMode = settings.PlaybackTimingMode;
 
         if (ShowCountdown && CountdownDuration > TimeSpan.Zero)
         {
@@ -314,12 +329,14 @@ public partial class ExecutionControlViewModel : ObservableObject
 
     private void OnProgressChanged(object? sender, ExecutionProgressEventArgs e)
     {
-        RunOnUiThread(() =>
-        {
-            CurrentCommandIndex = e.CurrentCommandIndex;
-            TotalCommandCount = e.TotalCommands;
-            CompletionPercentage = Math.Clamp(e.CompletionPercentage, 0.0, 100.0);
-        });
+        _pendingProgress.Post(e);
+    }
+
+    private void ApplyProgress(ExecutionProgressEventArgs e)
+    {
+        CurrentCommandIndex = e.CurrentCommandIndex;
+        TotalCommandCount = e.TotalCommands;
+        CompletionPercentage = Math.Clamp(e.CompletionPercentage, 0.0, 100.0);
     }
 
     private void OnStateChanged(object? sender, ExecutionStateChangedEventArgs e)
@@ -351,10 +368,18 @@ public partial class ExecutionControlViewModel : ObservableObject
 
     private void OnExecutionCompleted(object? sender, ExecutionCompletedEventArgs e)
     {
+        // Completed sessions stay current, so their statistics are still available here
+        var statistics = _executionService.GetExecutionStatistics();
+
         RunOnUiThread(() =>
         {
+            if (statistics != null && statistics.TimedActionCount > 0)
+                TimingSummary = FormatTimingSummary(statistics);
+
             // 執行完成後恢復到「待執行」（Idle），避免還要再按一次強制終止或停留在 Completed。
             // 仍保留 Script 選擇狀態，讓使用者可以直接再次按 Start。
+            // 先丟棄尚未套用的進度，避免重置後又被舊進度覆蓋。
+            _pendingProgress.Clear();
             State = ExecutionState.Idle;
             CurrentCommandIndex = 0;
             TotalCommandCount = Script?.CommandCount ?? e.TotalCommandCount;
@@ -363,6 +388,16 @@ public partial class ExecutionControlViewModel : ObservableObject
         });
     }
 
+    private static string FormatTimingSummary(ExecutionStatistics statistics)
+    {
+        var format = UiText.Get("Ui.Execution.TimingSummary", "Timeline: {0} actions, average {1:F1} ms late, max {2:F1} ms, {3} resyncs");
+        return string.Format(System.Globalization.CultureInfo.CurrentUICulture, format,
+            statistics.TimedActionCount,
+            statistics.AverageActionLateness.TotalMilliseconds,
+            statistics.MaxActionLateness.TotalMilliseconds,
+            statistics.TimelineResyncCount);
+    }
+
     private void RefreshFromService()
     {
         State = _executionService.State;
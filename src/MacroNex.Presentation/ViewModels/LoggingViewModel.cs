@@ -1,7 +1,8 @@
 ﻿using CommunityToolkit.Mvvm.ComponentModel;
 using CommunityToolkit.Mvvm.Input;
 using MacroNex.Domain.Interfaces;
-using System.Collections.ObjectModel;
+using MacroNex.Presentation.Services;
+using MacroNex.Presentation.Utilities;
 using System.IO;
 using System.Linq;
 using System.Windows;
@@ -13,9 +14,12 @@ namespace MacroNex.Presentation.ViewModels;
 /// </summary>
 public partial class LoggingViewModel : ObservableObject
 {
+    private const int MaxDisplayedEntries = 5000;
+
     private readonly ILoggingService _loggingService;
+    private readonly UiBatchQueue<LogEntry> _pendingEntries;
 
-    public ObservableCollection<LogEntry> Entries { get; } = new();
+    public RangeObservableCollection<LogEntry> Entries { get; } = new();
 
     [ObservableProperty]
     private string searchText = string.Empty;
@@ -26,9 +30,13 @@ public partial class LoggingViewModel : ObservableObject
     [ObservableProperty]
     private int maxResults = 200;
 
-    public LoggingViewModel(ILoggingService loggingService)
+    public LoggingViewModel(ILoggingService loggingService, UiUpdatePump? uiUpdatePump = null)
     {
         _loggingService = loggingService ?? throw new ArgumentNullException(nameof(loggingService));
+
+        // 日誌以批次方式每幀最多更新一次，避免高頻日誌塞滿 Dispatcher 佇列
+        var pump = uiUpdatePump ?? new UiUpdatePump(System.Windows.Application.Current?.Dispatcher);
+        _pendingEntries = pump.CreateBatchQueue<LogEntry>(AddLogEntries, MaxDisplayedEntries);
         _loggingService.LogEntryCreated += OnLogEntryCreated;
     }
 
@@ -49,18 +57,11 @@ public partial class LoggingViewModel : ObservableObject
         var dispatcher = System.Windows.Application.Current?.Dispatcher;
         if (dispatcher != null && !dispatcher.CheckAccess())
         {
-            await dispatcher.InvokeAsync(() =>
-            {
-                Entries.Clear();
-                foreach (var e in entries.OrderBy(e => e.Timestamp))
-                    Entries.Add(e);
-            });
+            await dispatcher.InvokeAsync(() => ReplaceEntries(entries));
         }
         else
         {
-            Entries.Clear();
-            foreach (var e in entries.OrderBy(e => e.Timestamp))
-                Entries.Add(e);
+            ReplaceEntries(entries);
         }
     }
 
@@ -73,7 +74,8 @@ public partial class LoggingViewModel : ObservableObject
         _isClearing = true;
         try
         {
-            // 確保在 UI 線程上清空集合
+            // 丟棄尚未顯示的日誌，並確保在 UI 線程上清空集合
+            _pendingEntries.Clear();
             var dispatcher = System.Windows.Application.Current?.Dispatcher;
             if (dispatcher != null && !dispatcher.CheckAccess())
             {
@@ -151,16 +153,7 @@ public partial class LoggingViewModel : ObservableObject
             if (_isClearing)
                 return;
 
-            // 確保在 UI 線程上修改集合，避免 ItemsControl 同步問題
-            var dispatcher = System.Windows.Application.Current?.Dispatcher;
-            if (dispatcher != null && !dispatcher.CheckAccess())
-            {
-                dispatcher.BeginInvoke(() => AddLogEntry(e.LogEntry), System.Windows.Threading.DispatcherPriority.Normal);
-            }
-            else
-            {
-                AddLogEntry(e.LogEntry);
-            }
+            _pendingEntries.Post(e.LogEntry);
         }
         catch
         {
@@ -168,20 +161,18 @@ public partial class LoggingViewModel : ObservableObject
         }
     }
 
-    private void AddLogEntry(LogEntry entry)
+    private void ReplaceEntries(IEnumerable<LogEntry> entries)
+    {
+        Entries.ReplaceAll(entries.OrderBy(e => e.Timestamp));
+    }
+
+    private void AddLogEntries(IReadOnlyList<LogEntry> entries)
     {
         try
         {
             // Keep a bounded list for UI responsiveness.
-            // 注意：此方法必須在 UI 線程上調用
-            const int max = 5000;
-            if (Entries.Count >= max)
-            {
-                // 使用 RemoveAt 而不是 Remove，避免在快速添加時出現同步問題
-                Entries.RemoveAt(0);
-            }
-
-            Entries.Add(entry);
+            // 注意：此方法由 UiUpdatePump 在 UI 線程上調用，整批只觸發一次集合變更通知
+            Entries.AppendRange(entries, MaxDisplayedEntries);
         }
         catch
         {
@@ -189,4 +180,3 @@ public partial class LoggingViewModel : ObservableObject
         }
     }
 }
-
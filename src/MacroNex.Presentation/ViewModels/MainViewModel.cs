@@ -111,13 +111,12 @@ public partial class MainViewModel : ObservableObject
         {
             try
             {
-                // Find script with matching hotkey
-                var scripts = await _scriptManager.GetAllScriptsAsync();
                 // Hook service encodes ScriptId in Hotkey.Name
                 if (!Guid.TryParse(e.Hotkey.Name, out var scriptId))
                     return;
 
-                var script = scripts.FirstOrDefault(s => s.Id == scriptId);
+                // Load only the triggered script (usually already cached)
+                var script = await _scriptManager.GetScriptAsync(scriptId);
 
                 if (script != null && script.TriggerHotkey != null)
                 {
@@ -132,6 +131,10 @@ public partial class MainViewModel : ObservableObject
                     options.ShowCountdown = false;
                     options.CountdownDuration = TimeSpan.Zero;
                     options.InputMode = globalInputMode;
+                    options.UseHighPrecisionTiming = settings.HighPrecisionTiming;
+                    options.TimingMode = settings.PlaybackTimingMode;
+                    // The macro the user just triggered wins input turns over scripts already running
+                    options.Priority = ExecutionPriority.Foreground;
 
                     // For "RepeatWhileHeld" mode, check if script is already executing
                     // If it is, ignore the trigger to avoid concurrent executions
@@ -210,6 +213,8 @@ public partial class MainViewModel : ObservableObject
         if (_isHotkeyCaptureActive)
             return;
 
+        // Raised on the input thread: never block it on the UI, since starting a recording installs hooks there.
+
         try
         {
             var start = Settings.RecordingStartHotkey;
@@ -223,7 +228,7 @@ public partial class MainViewModel : ObservableObject
 
             if (Match(start))
             {
-                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                System.Windows.Application.Current?.Dispatcher.InvokeAsync(() =>
                 {
                     if (Recording.StartRecordingCommand.CanExecute(null))
                         Recording.StartRecordingCommand.Execute(null);
@@ -233,7 +238,7 @@ public partial class MainViewModel : ObservableObject
 
             if (Match(pause))
             {
-                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                System.Windows.Application.Current?.Dispatcher.InvokeAsync(() =>
                 {
                     if (Recording.PauseRecordingCommand.CanExecute(null))
                         Recording.PauseRecordingCommand.Execute(null);
@@ -243,7 +248,7 @@ public partial class MainViewModel : ObservableObject
 
             if (Match(stop))
             {
-                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                System.Windows.Application.Current?.Dispatcher.InvokeAsync(() =>
                 {
                     if (Recording.StopRecordingCommand.CanExecute(null))
                         Recording.StopRecordingCommand.Execute(null);
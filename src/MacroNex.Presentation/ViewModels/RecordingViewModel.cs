@@ -5,6 +5,7 @@ using MacroNex.Domain.Events;
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using MacroNex.Application.Services;
+using MacroNex.Presentation.Services;
 using MacroNex.Presentation.Views;
 using MacroNex.Presentation.Utilities;
 using System.Collections.ObjectModel;
@@ -27,8 +28,20 @@ public partial class RecordingViewModel : ObservableObject
     private readonly ArduinoConnectionService _arduinoConnectionService;
     private readonly ISettingsService _settingsService;
 
+    /// <summary>
+    /// Number of most recent commands kept in <see cref="RecordedCommands"/>.
+    /// </summary>
+    public const int RecordedCommandsWindow = 500;
+
+    /// <summary>
+    /// The latest recorded commands, for display. The recording itself stays in its session's command buffer;
+    /// <see cref="TotalCommands"/> counts all of it.
+    /// </summary>
     public ObservableCollection<Command> RecordedCommands { get; } = new();
 
+    // The service drops its session on stop; keep it so the recording can be converted from its command buffer
+    private RecordingSession? _recordedSession;
+
     [ObservableProperty]
     private string recordingStatusText = "";
 
@@ -60,6 +73,7 @@ public partial class RecordingViewModel : ObservableObject
     private ObservableCollection<string> availableSerialPorts = new();
 
     [ObservableProperty]
+    [NotifyCanExecuteChangedFor(nameof(ConnectArduinoCommand))]
     private string? selectedSerialPort;
 
     public RecordingViewModel(
@@ -69,7 +83,8 @@ public partial class RecordingViewModel : ObservableObject
         ScriptListViewModel scriptListViewModel,
         CommandGridViewModel commandGridViewModel,
         ArduinoConnectionService arduinoConnectionService,
-        ISettingsService settingsService)
+        ISettingsService settingsService,
+        DeferredStartupService? deferredStartup = null)
     {
         _recordingService = recordingService ?? throw new ArgumentNullException(nameof(recordingService));
         _scriptManager = scriptManager ?? throw new ArgumentNullException(nameof(scriptManager));
@@ -86,7 +101,9 @@ public partial class RecordingViewModel : ObservableObject
         _arduinoConnectionService.ConnectionStateChanged += OnArduinoConnectionStateChanged;
 
         UpdateStatusFromService();
-        RefreshSerialPorts();
+
+        // Port enumeration can take hundreds of milliseconds with virtual COM drivers; run it after the first frame
+        DeferredStartupService.Schedule(deferredStartup, "Recording serial port scan", RefreshSerialPortsAsync);
         
         // Load global input mode from settings
         _ = LoadGlobalInputModeAsync();
@@ -140,11 +157,15 @@ public partial class RecordingViewModel : ObservableObject
     {
         try
         {
-            if (RecordedCommands.Count == 0)
+            if (TotalCommands == 0)
                 return;
 
             // Convert recorded commands directly to Lua/text and insert at current editor caret.
-            var text = ScriptTextConverter.CommandsToText(RecordedCommands);
+            var packRelativeMoves = InputMode == InputMode.Hardware;
+            var buffer = _recordedSession?.CopyCommandBuffer();
+            var text = buffer != null
+                ? ScriptTextConverter.CommandsToText(buffer, packRelativeMoves)
+                : ScriptTextConverter.CommandsToText(GetAllRecordedCommands(), packRelativeMoves);
             _commandGridViewModel.InsertTextAtCaret(text, ensureStandaloneLine: true);
         }
         catch (Exception ex)
@@ -153,7 +174,7 @@ public partial class RecordingViewModel : ObservableObject
         }
     }
 
-    private bool CanInsertRecordedIntoEditor() => RecordedCommands.Count > 0;
+    private bool CanInsertRecordedIntoEditor() => TotalCommands > 0;
 
     [RelayCommand]
     private void CopyCurrentScriptText()
@@ -185,6 +206,7 @@ public partial class RecordingViewModel : ObservableObject
             }
 
             RecordedCommands.Clear();
+            _recordedSession = null;
             TotalCommands = 0;
             InsertRecordedIntoEditorCommand.NotifyCanExecuteChanged();
 
@@ -199,10 +221,12 @@ public partial class RecordingViewModel : ObservableObject
                 RecordKeyboardInput = RecordKeyboardInput,
                 FilterSystemEvents = FilterSystemEvents,
                 UseRelativeMouseMove = UseRelativeMouseMove,
+                SimplifyMousePath = settings.SimplifyRecordedMousePath,
                 InputMode = globalInputMode
             };
 
             await _recordingService.StartRecordingAsync(options);
+            _recordedSession = _recordingService.CurrentSession;
         }
         catch (Exception ex)
         {
@@ -319,7 +343,7 @@ public partial class RecordingViewModel : ObservableObject
     [RelayCommand(CanExecute = nameof(CanSaveAsScript))]
     private async Task SaveAsScriptAsync()
     {
-        if (RecordedCommands.Count == 0)
+        if (TotalCommands == 0)
             return;
 
         var dlg = new InputDialog(
@@ -347,18 +371,25 @@ public partial class RecordingViewModel : ObservableObject
 
         var script = await _scriptManager.CreateScriptAsync(name);
 
-        script.SourceText = ScriptTextConverter.CommandsToText(RecordedCommands);
+        // Long hardware recordings take a while to convert; keep that off the UI thread
+        // Convert straight from the session's command buffer; the object list is only a fallback
+        var packRelativeMoves = InputMode == InputMode.Hardware;
+        var buffer = _recordedSession?.CopyCommandBuffer();
+        var recorded = buffer == null ? GetAllRecordedCommands() : null;
+        script.SourceText = await Task.Run(() => buffer != null
+            ? ScriptTextConverter.CommandsToText(buffer, packRelativeMoves)
+            : ScriptTextConverter.CommandsToText(recorded!, packRelativeMoves));
 
         await _scriptManager.UpdateScriptAsync(script);
 
         await _scriptListViewModel.RefreshAsync();
-        _scriptListViewModel.SelectedScript = _scriptListViewModel.Scripts.FirstOrDefault(s => s.Id == script.Id) ?? _scriptListViewModel.Scripts.FirstOrDefault();
+        _scriptListViewModel.SelectScript(script.Id);
 
         await _loggingService.LogInfoAsync("Recording saved as script", new Dictionary<string, object>
         {
             { "ScriptId", script.Id },
             { "ScriptName", script.Name },
-            { "CommandCount", RecordedCommands.Count },
+            { "CommandCount", TotalCommands },
             { "SourceTextLength", script.SourceTextLength }
         });
 
@@ -366,17 +397,26 @@ public partial class RecordingViewModel : ObservableObject
     }
 
     private bool CanSaveAsScript()
-        => !_recordingService.IsRecording && RecordedCommands.Count > 0;
+        => !_recordingService.IsRecording && TotalCommands > 0;
+
+    /// <summary>
+    /// Copies the whole recording as command objects, for sessions whose commands do not fit a command buffer.
+    /// </summary>
+    private IReadOnlyList<Command> GetAllRecordedCommands()
+        => _recordedSession?.Commands ?? RecordedCommands.ToList();
 
     private void OnCommandRecorded(object? sender, CommandRecordedEventArgs e)
     {
-        // Always store clones locally so we don't depend on RecordingService session lifetime.
+        // Display copies only; the session keeps the recording
         var cloned = e.Command.Clone();
 
         System.Windows.Application.Current?.Dispatcher.Invoke(() =>
         {
             RecordedCommands.Add(cloned);
-            TotalCommands = RecordedCommands.Count;
+            if (RecordedCommands.Count > RecordedCommandsWindow)
+                RecordedCommands.RemoveAt(0);
+
+            TotalCommands++;
             InsertRecordedIntoEditorCommand.NotifyCanExecuteChanged();
         });
     }
@@ -414,6 +454,8 @@ public partial class RecordingViewModel : ObservableObject
         {
             ArduinoConnectionState = e.NewState;
             OnPropertyChanged(nameof(ArduinoConnectionState));
+            ConnectArduinoCommand.NotifyCanExecuteChanged();
+            DisconnectArduinoCommand.NotifyCanExecuteChanged();
         });
     }
 
@@ -435,11 +477,6 @@ public partial class RecordingViewModel : ObservableObject
         }
     }
 
-    private void RefreshSerialPorts()
-    {
-        _ = RefreshSerialPortsAsync();
-    }
-
     [RelayCommand(CanExecute = nameof(CanConnectArduino))]
     private async Task ConnectArduinoAsync()
     {
@@ -462,10 +499,12 @@ public partial class RecordingViewModel : ObservableObject
         }
     }
 
+    // With a device pool, further ports can be added while connected
     private bool CanConnectArduino()
-        => !string.IsNullOrWhiteSpace(SelectedSerialPort) && 
-           ArduinoConnectionState != ArduinoConnectionState.Connected &&
-           ArduinoConnectionState != ArduinoConnectionState.Connecting;
+        => !string.IsNullOrWhiteSpace(SelectedSerialPort) &&
+           ArduinoConnectionState != ArduinoConnectionState.Connecting &&
+           _arduinoConnectionService.CanConnectMoreDevices &&
+           !_arduinoConnectionService.IsPortConnected(SelectedSerialPort);
 
     [RelayCommand(CanExecute = nameof(CanDisconnectArduino))]
     private async Task DisconnectArduinoAsync()
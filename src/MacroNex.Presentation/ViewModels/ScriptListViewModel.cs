@@ -13,14 +13,25 @@ namespace MacroNex.Presentation.ViewModels;
 
 /// <summary>
 /// ViewModel for listing, searching, and basic CRUD operations for scripts.
+/// The list shows script metadata only; the selected script's body is loaded on demand.
 /// </summary>
 public partial class ScriptListViewModel : ObservableObject
 {
     private readonly IScriptManager _scriptManager;
     private readonly ILoggingService _loggingService;
+    private int _selectionVersion;
 
-    public ObservableCollection<Script> Scripts { get; } = new();
+    public ObservableCollection<ScriptMetadata> Scripts { get; } = new();
 
+    /// <summary>
+    /// The list entry selected in the UI.
+    /// </summary>
+    [ObservableProperty]
+    private ScriptMetadata? selectedEntry;
+
+    /// <summary>
+    /// The fully loaded script for <see cref="SelectedEntry"/>.
+    /// </summary>
     [ObservableProperty]
     private Script? selectedScript;
 
@@ -39,11 +50,19 @@ public partial class ScriptListViewModel : ObservableObject
     public async Task RefreshAsync()
     {
         Scripts.Clear();
-        var scripts = await _scriptManager.GetAllScriptsAsync();
+        var scripts = await _scriptManager.GetScriptMetadataAsync();
         foreach (var s in scripts.OrderBy(s => s.Name))
             Scripts.Add(s);
     }
 
+    /// <summary>
+    /// Selects the list entry for a script, falling back to the first entry.
+    /// </summary>
+    public void SelectScript(Guid scriptId)
+    {
+        SelectedEntry = Scripts.FirstOrDefault(s => s.Id == scriptId) ?? Scripts.FirstOrDefault();
+    }
+
     [RelayCommand]
     private async Task CreateScriptAsync()
     {
@@ -58,23 +77,24 @@ public partial class ScriptListViewModel : ObservableObject
         }
 
         var script = await _scriptManager.CreateScriptAsync(name);
-        Scripts.Add(script);
-        SelectedScript = script;
+        var entry = script.ToMetadata();
+        Scripts.Add(entry);
+        SelectedEntry = entry;
         await _loggingService.LogInfoAsync("Script created", new Dictionary<string, object> { { "ScriptId", script.Id } });
     }
 
     [RelayCommand(CanExecute = nameof(CanDeleteSelected))]
     private async Task DeleteSelectedAsync()
     {
-        if (SelectedScript == null) return;
-        var id = SelectedScript.Id;
+        if (SelectedEntry == null) return;
+        var id = SelectedEntry.Id;
         await _scriptManager.DeleteScriptAsync(id);
-        Scripts.Remove(SelectedScript);
-        SelectedScript = Scripts.FirstOrDefault();
+        Scripts.Remove(SelectedEntry);
+        SelectedEntry = Scripts.FirstOrDefault();
         await _loggingService.LogWarningAsync("Script deleted", new Dictionary<string, object> { { "ScriptId", id } });
     }
 
-    private bool CanDeleteSelected() => SelectedScript != null;
+    private bool CanDeleteSelected() => SelectedEntry != null;
 
     [RelayCommand]
     private async Task ImportAsync()
@@ -91,7 +111,7 @@ public partial class ScriptListViewModel : ObservableObject
 
         var imported = await _scriptManager.ImportScriptAsync(dlg.FileName);
         await RefreshAsync();
-        SelectedScript = Scripts.FirstOrDefault(s => s.Id == imported.Id) ?? Scripts.FirstOrDefault();
+        SelectScript(imported.Id);
         await _loggingService.LogInfoAsync("Script imported", new Dictionary<string, object>
         {
             { "ScriptId", imported.Id },
@@ -102,36 +122,37 @@ public partial class ScriptListViewModel : ObservableObject
     [RelayCommand(CanExecute = nameof(CanExportSelected))]
     private async Task ExportSelectedAsync()
     {
-        if (SelectedScript == null) return;
+        if (SelectedEntry == null) return;
+        var entry = SelectedEntry;
 
         var dlg = new SaveFileDialog
         {
             Title = "Export Script",
             Filter = "MacroNex Script (*.json)|*.json|All files (*.*)|*.*",
-            FileName = $"{SelectedScript.Name}.json"
+            FileName = $"{entry.Name}.json"
         };
 
         if (dlg.ShowDialog() != true)
             return;
 
-        await _scriptManager.ExportScriptAsync(SelectedScript.Id, dlg.FileName);
+        await _scriptManager.ExportScriptAsync(entry.Id, dlg.FileName);
         await _loggingService.LogInfoAsync("Script exported", new Dictionary<string, object>
         {
-            { "ScriptId", SelectedScript.Id },
+            { "ScriptId", entry.Id },
             { "FilePath", dlg.FileName }
         });
     }
 
-    private bool CanExportSelected() => SelectedScript != null;
+    private bool CanExportSelected() => SelectedEntry != null;
 
     [RelayCommand]
     private async Task ApplySearchAsync()
     {
         var term = SearchText?.Trim() ?? string.Empty;
         Scripts.Clear();
-        var results = string.IsNullOrWhiteSpace(term)
-            ? await _scriptManager.GetAllScriptsAsync()
-            : await _scriptManager.SearchScriptsAsync(term);
+        var results = await _scriptManager.GetScriptMetadataAsync();
+        if (!string.IsNullOrWhiteSpace(term))
+            results = results.Where(s => s.Name.Contains(term, StringComparison.OrdinalIgnoreCase));
 
         foreach (var s in results.OrderBy(s => s.Name))
             Scripts.Add(s);
@@ -164,10 +185,10 @@ public partial class ScriptListViewModel : ObservableObject
                 // automatically refresh the ListBox item template. The most reliable fix is to run the same
                 // reload path as the "Refresh" button (clear + reload from storage), then restore selection.
                 await RefreshAsync();
-                SelectedScript = Scripts.FirstOrDefault(s => s.Id == scriptId) ?? Scripts.FirstOrDefault();
+                SelectScript(scriptId);
 
                 // Selection might be null if there are no scripts loaded; avoid null dereference.
-                var selected = SelectedScript;
+                var selected = SelectedEntry;
 
                 await _loggingService.LogInfoAsync("Script hotkey updated", new Dictionary<string, object>
                 {
@@ -189,14 +210,14 @@ public partial class ScriptListViewModel : ObservableObject
     [RelayCommand(CanExecute = nameof(CanRenameSelected))]
     private async Task RenameSelectedAsync()
     {
-        if (SelectedScript == null) return;
+        if (SelectedEntry == null) return;
 
         var mainWindow = System.Windows.Application.Current?.MainWindow;
         var dlg = new InputDialog(
             UiText.Get("Ui.Dialog.RenameScript.Title", "Rename Script"),
             UiText.Get("Ui.Dialog.RenameScript.Subtitle", "Enter a new name for the script."),
             UiText.Get("Ui.Dialog.RenameScript.Label", "Script name:"),
-            SelectedScript.Name)
+            SelectedEntry.Name)
         {
             Owner = mainWindow
         };
@@ -205,15 +226,15 @@ public partial class ScriptListViewModel : ObservableObject
             return;
 
         var newName = dlg.ValueText.Trim();
-        if (newName == SelectedScript.Name)
+        if (newName == SelectedEntry.Name)
             return;
 
         try
         {
-            var scriptId = SelectedScript.Id;
+            var scriptId = SelectedEntry.Id;
             await _scriptManager.RenameScriptAsync(scriptId, newName);
             await RefreshAsync();
-            SelectedScript = Scripts.FirstOrDefault(s => s.Id == scriptId);
+            SelectedEntry = Scripts.FirstOrDefault(s => s.Id == scriptId);
             await _loggingService.LogInfoAsync("Script renamed", new Dictionary<string, object>
             {
                 { "ScriptId", scriptId },
@@ -227,14 +248,44 @@ public partial class ScriptListViewModel : ObservableObject
         }
     }
 
-    private bool CanRenameSelected() => SelectedScript != null;
+    private bool CanRenameSelected() => SelectedEntry != null;
 
-    partial void OnSelectedScriptChanged(Script? oldValue, Script? newValue)
+    partial void OnSelectedEntryChanged(ScriptMetadata? oldValue, ScriptMetadata? newValue)
     {
         DeleteSelectedCommand.NotifyCanExecuteChanged();
         ExportSelectedCommand.NotifyCanExecuteChanged();
-        SetHotkeyCommand.NotifyCanExecuteChanged();
         RenameSelectedCommand.NotifyCanExecuteChanged();
+        _ = LoadSelectedScriptAsync(newValue);
+    }
+
+    private async Task LoadSelectedScriptAsync(ScriptMetadata? entry)
+    {
+        // Only the latest selection may publish its script
+        var version = ++_selectionVersion;
+
+        if (entry == null)
+        {
+            SelectedScript = null;
+            return;
+        }
+
+        try
+        {
+            var script = await _scriptManager.GetScriptAsync(entry.Id);
+            if (version == _selectionVersion)
+                SelectedScript = script;
+        }
+        catch (Exception ex)
+        {
+            await _loggingService.LogErrorAsync("Failed to load script", ex, new Dictionary<string, object> { { "ScriptId", entry.Id } });
+            if (version == _selectionVersion)
+                SelectedScript = null;
+        }
+    }
+
+    partial void OnSelectedScriptChanged(Script? oldValue, Script? newValue)
+    {
+        SetHotkeyCommand.NotifyCanExecuteChanged();
         SelectedScriptChanged?.Invoke(this, newValue);
     }
 }
@@ -15,6 +15,7 @@ public partial class SettingsViewModel : ObservableObject
     private readonly ILoggingService _logging;
     private readonly LocalizationService _localization;
     private readonly Application.Services.ArduinoConnectionService _arduinoConnectionService;
+    private readonly DeferredStartupService? _deferredStartup;
 
     private AppSettings? _settings;
 
@@ -33,6 +34,21 @@ public partial class SettingsViewModel : ObservableObject
         InputMode.Hardware
     };
 
+    public ObservableCollection<ExecutionTimingMode> AvailableTimingModes { get; } = new()
+    {
+        ExecutionTimingMode.Relative,
+        ExecutionTimingMode.Deadline
+    };
+
+    public ObservableCollection<int> AvailableArduinoDeviceCounts { get; } = new() { 1, 2, 3, 4 };
+
+    public ObservableCollection<ArduinoRoutingMode> AvailableArduinoRoutingModes { get; } = new()
+    {
+        ArduinoRoutingMode.SplitMouseKeyboard,
+        ArduinoRoutingMode.RoundRobin,
+        ArduinoRoutingMode.Primary
+    };
+
     [ObservableProperty]
     private UiLanguageOption? selectedUiLanguage;
 
@@ -51,18 +67,34 @@ public partial class SettingsViewModel : ObservableObject
     [ObservableProperty]
     private InputMode globalInputMode = InputMode.HighLevel;
 
+    [ObservableProperty]
+    private ExecutionTimingMode playbackTimingMode = ExecutionTimingMode.Relative;
+
+    [ObservableProperty]
+    private int arduinoDeviceCount = 1;
+
+    [ObservableProperty]
+    private ArduinoRoutingMode arduinoRoutingMode = ArduinoRoutingMode.SplitMouseKeyboard;
+
+    /// <summary>
+    /// Gets whether the Arduino service can drive more than one device.
+    /// </summary>
+    public bool SupportsMultipleArduinoDevices => _arduinoConnectionService.SupportsMultipleDevices;
+
     public SettingsViewModel(
         ISettingsService settingsService,
         IRecordingHotkeyHookService recordingHotkeyHookService,
         ILoggingService logging,
         LocalizationService localization,
-        Application.Services.ArduinoConnectionService arduinoConnectionService)
+        Application.Services.ArduinoConnectionService arduinoConnectionService,
+        DeferredStartupService? deferredStartup = null)
     {
         _settingsService = settingsService ?? throw new ArgumentNullException(nameof(settingsService));
         _recordingHotkeyHookService = recordingHotkeyHookService ?? throw new ArgumentNullException(nameof(recordingHotkeyHookService));
         _logging = logging ?? throw new ArgumentNullException(nameof(logging));
         _localization = localization ?? throw new ArgumentNullException(nameof(localization));
         _arduinoConnectionService = arduinoConnectionService ?? throw new ArgumentNullException(nameof(arduinoConnectionService));
+        _deferredStartup = deferredStartup;
 
         // Fire-and-forget initialization (load persisted settings and register hotkeys).
         _ = InitializeAsync();
@@ -88,14 +120,19 @@ public partial class SettingsViewModel : ObservableObject
             RecordingPauseHotkey = _settings.RecordingPauseHotkey;
             RecordingStopHotkey = _settings.RecordingStopHotkey;
             GlobalInputMode = _settings.GlobalInputMode;
+            PlaybackTimingMode = _settings.PlaybackTimingMode;
+            ArduinoDeviceCount = _settings.ArduinoDeviceCount;
+            ArduinoRoutingMode = _settings.ArduinoRouting.Mode;
 
             ApplyToHookService();
+            ApplyArduinoRouting(_settings.ArduinoRouting);
             LastMessage = "設定已載入";
 
-            // Auto-connect to Arduino if hardware mode is enabled at startup
+            // Auto-connect to Arduino if hardware mode is enabled at startup.
+            // The port scan and handshake run after the first frame so they never delay the window.
             if (_settings.GlobalInputMode == InputMode.Hardware)
             {
-                await TryAutoConnectArduinoAsync("應用啟動時");
+                DeferredStartupService.Schedule(_deferredStartup, "Arduino auto-connect", () => TryAutoConnectArduinoAsync("應用啟動時"));
             }
         }
         catch (Exception ex)
@@ -352,19 +389,130 @@ public partial class SettingsViewModel : ObservableObject
         });
     }
 
+    partial void OnPlaybackTimingModeChanged(ExecutionTimingMode oldValue, ExecutionTimingMode newValue)
+    {
+        // Loading the settings sets the same value; only persist real changes
+        if (_settings?.PlaybackTimingMode == newValue)
+            return;
+
+        _ = Task.Run(async () =>
+        {
+            try
+            {
+                _settings ??= AppSettings.Default();
+                _settings.EnsureDefaults();
+                _settings.PlaybackTimingMode = newValue;
+                await _settingsService.SaveAsync(_settings);
+
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"播放計時已切換為: {GetTimingModeDisplayName(newValue)}";
+                });
+            }
+            catch (Exception ex)
+            {
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"播放計時更新失敗：{ex.Message}";
+                });
+                try { await _logging.LogErrorAsync("Failed to update playback timing mode", ex); } catch { }
+            }
+        });
+    }
+
+    partial void OnArduinoDeviceCountChanged(int oldValue, int newValue)
+    {
+        if (_settings == null || _settings.ArduinoDeviceCount == newValue)
+            return;
+
+        _ = Task.Run(async () =>
+        {
+            try
+            {
+                _settings.ArduinoDeviceCount = newValue;
+                await _settingsService.SaveAsync(_settings);
+
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"Arduino 裝置數已設為: {newValue}";
+                });
+
+                // Connect the extra devices right away when hardware mode is in use
+                if (_settings.GlobalInputMode == InputMode.Hardware && newValue > _arduinoConnectionService.ConnectedPortNames.Count)
+                {
+                    await TryAutoConnectArduinoAsync("變更裝置數時");
+                }
+            }
+            catch (Exception ex)
+            {
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"Arduino 裝置數更新失敗：{ex.Message}";
+                });
+                try { await _logging.LogErrorAsync("Failed to update Arduino device count", ex); } catch { }
+            }
+        });
+    }
+
+    partial void OnArduinoRoutingModeChanged(ArduinoRoutingMode oldValue, ArduinoRoutingMode newValue)
+    {
+        if (_settings == null || _settings.ArduinoRouting.Mode == newValue)
+            return;
+
+        _ = Task.Run(async () =>
+        {
+            try
+            {
+                // Replace rather than mutate: the device pool may be reading the current options
+                var current = _settings.ArduinoRouting;
+                _settings.ArduinoRouting = new ArduinoRoutingOptions
+                {
+                    Mode = newValue,
+                    MousePortName = current.MousePortName,
+                    KeyboardPortName = current.KeyboardPortName,
+                    PreserveOrderAcrossDevices = current.PreserveOrderAcrossDevices
+                };
+                ApplyArduinoRouting(_settings.ArduinoRouting);
+                await _settingsService.SaveAsync(_settings);
+
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"Arduino 指令分配已切換為: {GetRoutingModeDisplayName(newValue)}";
+                });
+            }
+            catch (Exception ex)
+            {
+                System.Windows.Application.Current?.Dispatcher.Invoke(() =>
+                {
+                    LastMessage = $"Arduino 指令分配更新失敗：{ex.Message}";
+                });
+                try { await _logging.LogErrorAsync("Failed to update Arduino routing", ex); } catch { }
+            }
+        });
+    }
+
+    private void ApplyArduinoRouting(ArduinoRoutingOptions routing)
+    {
+        if (_arduinoConnectionService.SupportsMultipleDevices)
+            _arduinoConnectionService.Routing = routing;
+    }
+
     /// <summary>
-    /// Attempts to auto-connect to Arduino device.
+    /// Attempts to auto-connect the configured number of Arduino devices.
     /// </summary>
     private async Task TryAutoConnectArduinoAsync(string context)
     {
         try
         {
-            // Skip if already connected
-            if (_arduinoConnectionService.IsConnected)
+            var deviceCount = _settings?.ArduinoDeviceCount ?? 1;
+
+            // Skip if enough devices are connected already
+            var connectedPorts = _arduinoConnectionService.ConnectedPortNames;
+            if (connectedPorts.Count >= deviceCount || (connectedPorts.Count > 0 && !_arduinoConnectionService.SupportsMultipleDevices))
             {
                 System.Windows.Application.Current?.Dispatcher.Invoke(() =>
                 {
-                    LastMessage = $"Arduino 已連接 ({_arduinoConnectionService.ConnectedPortName})";
+                    LastMessage = $"Arduino 已連接 ({string.Join(", ", connectedPorts)})";
                 });
                 return;
             }
@@ -374,13 +522,13 @@ public partial class SettingsViewModel : ObservableObject
                 LastMessage = $"{context}：正在自動連接 Arduino...";
             });
 
-            var success = await _arduinoConnectionService.AutoConnectAsync();
+            var success = await _arduinoConnectionService.AutoConnectAsync(deviceCount);
 
             System.Windows.Application.Current?.Dispatcher.Invoke(() =>
             {
                 if (success)
                 {
-                    LastMessage = $"Arduino 自動連接成功 ({_arduinoConnectionService.ConnectedPortName})";
+                    LastMessage = $"Arduino 自動連接成功 ({string.Join(", ", _arduinoConnectionService.ConnectedPortNames)})";
                 }
                 else
                 {
@@ -398,6 +546,27 @@ public partial class SettingsViewModel : ObservableObject
         }
     }
 
+    private static string GetTimingModeDisplayName(ExecutionTimingMode mode)
+    {
+        return mode switch
+        {
+            ExecutionTimingMode.Relative => "相對延遲",
+            ExecutionTimingMode.Deadline => "時間軸（截止時間）",
+            _ => mode.ToString()
+        };
+    }
+
+    private static string GetRoutingModeDisplayName(ArduinoRoutingMode mode)
+    {
+        return mode switch
+        {
+            ArduinoRoutingMode.SplitMouseKeyboard => "滑鼠/鍵盤分流",
+            ArduinoRoutingMode.RoundRobin => "輪流分配",
+            ArduinoRoutingMode.Primary => "僅主裝置",
+            _ => mode.ToString()
+        };
+    }
+
     private static string GetInputModeDisplayName(InputMode mode)
     {
         return mode switch
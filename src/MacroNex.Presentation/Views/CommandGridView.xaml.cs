@@ -132,7 +132,7 @@ public partial class CommandGridView : UserControl
 
         if (!vm.HasDiagnostic || vm.DiagnosticLine <= 0)
         {
-            ScriptEditor.TextArea.TextView.InvalidateVisual();
+            InvalidateDiagnosticLayers();
             return;
         }
 
@@ -150,7 +150,7 @@ public partial class CommandGridView : UserControl
             // Highlight the entire error line (full width) so it's always visible on dark theme.
             _errorLineRenderer?.SetErrorLine(line.LineNumber);
 
-            ScriptEditor.TextArea.TextView.InvalidateVisual();
+            InvalidateDiagnosticLayers();
         }
         catch
         {
@@ -158,6 +158,16 @@ public partial class CommandGridView : UserControl
         }
     }
 
+    /// <summary>
+    /// Repaints only the layers the diagnostics draw on; the visual lines and their highlighting are reused.
+    /// </summary>
+    private void InvalidateDiagnosticLayers()
+    {
+        var textView = ScriptEditor.TextArea.TextView;
+        textView.InvalidateLayer(KnownLayer.Background);
+        textView.InvalidateLayer(KnownLayer.Text);
+    }
+
     private sealed class ErrorLineRenderer : IBackgroundRenderer
     {
         private int _errorLine = -1;
@@ -177,11 +187,9 @@ public partial class CommandGridView : UserControl
 
         public void Draw(TextView textView, DrawingContext drawingContext)
         {
-            if (_errorLine <= 0 || textView.Document == null)
+            if (_errorLine <= 0 || textView.Document == null || !textView.VisualLinesValid)
                 return;
 
-            textView.EnsureVisualLines();
-
             foreach (var vl in textView.VisualLines)
             {
                 // Match any visual line fragment which belongs to the target document line.
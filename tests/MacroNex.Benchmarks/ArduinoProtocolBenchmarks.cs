@@ -0,0 +1,78 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Serial protocol framing throughput: command encoding and event decoding.
+/// </summary>
+[MemoryDiagnoser]
+public class ArduinoProtocolBenchmarks
+{
+    private const int EventCount = 1000;
+
+    private readonly ArduinoCommand _moveRelative = new ArduinoMouseMoveRelativeCommand(12, -7);
+    private readonly ArduinoCommand _click = new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Down);
+    private readonly ArduinoCommand _text = new ArduinoKeyboardTextCommand("The quick brown fox jumps over the lazy dog");
+    private readonly byte[] _frameBuffer = new byte[256];
+
+    private ArduinoCommand _motionStream = null!;
+    private byte[] _eventStream = Array.Empty<byte>();
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _motionStream = new ArduinoMouseMotionStreamCommand(
+            Enumerable.Range(0, 32).Select(i => new MotionSample(i % 5 - 2, i % 3 - 1, 1)));
+
+        // Back-to-back mouse move frames, as the device streams them while recording
+        var frames = new List<byte>(EventCount * 12);
+        for (int i = 0; i < EventCount; i++)
+        {
+            var frame = new List<byte> { (byte)ArduinoEventType.MouseMove, 4, 0 };
+            frame.AddRange(BitConverter.GetBytes((short)(i % 100)));
+            frame.AddRange(BitConverter.GetBytes((short)-(i % 50)));
+            frame.AddRange(BitConverter.GetBytes((uint)i));
+            frame.Add(ArduinoProtocolEncoder.CalculateChecksum(frame.ToArray()));
+            frames.AddRange(frame);
+        }
+        _eventStream = frames.ToArray();
+    }
+
+    [Benchmark(Baseline = true)]
+    public byte[] EncodeCommand_MoveRelative() => ArduinoProtocolEncoder.EncodeCommand(_moveRelative);
+
+    [Benchmark]
+    public byte[] EncodeCommand_Click() => ArduinoProtocolEncoder.EncodeCommand(_click);
+
+    [Benchmark]
+    public byte[] EncodeCommand_Text() => ArduinoProtocolEncoder.EncodeCommand(_text);
+
+    [Benchmark]
+    public byte[] EncodeCommand_MotionStream() => ArduinoProtocolEncoder.EncodeCommand(_motionStream);
+
+    [Benchmark]
+    public int TryEncode_MoveRelative()
+    {
+        ArduinoProtocolEncoder.TryEncode(_moveRelative, _frameBuffer, out var written);
+        return written;
+    }
+
+    [Benchmark(OperationsPerInvoke = EventCount)]
+    public int TryDecodeEvent_MouseMoveStream()
+    {
+        ReadOnlySpan<byte> remaining = _eventStream;
+        int decoded = 0;
+        while (!remaining.IsEmpty)
+        {
+            var consumed = ArduinoProtocolDecoder.TryDecodeEvent(remaining, out var decodedEvent);
+            if (consumed == 0)
+                break;
+            if (decodedEvent != null)
+                decoded++;
+            remaining = remaining.Slice(consumed);
+        }
+        return decoded;
+    }
+}
@@ -0,0 +1,44 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
+using MacroNex.Infrastructure.Storage;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Compact command storage for long recordings: packing, binary persistence and text conversion.
+/// Compare against <see cref="ScriptTextConverterBenchmarks"/> for the command-object path.
+/// </summary>
+[MemoryDiagnoser]
+public class CommandBufferBenchmarks
+{
+    [Params(100_000)]
+    public int CommandCount { get; set; }
+
+    private List<Command> _commands = new();
+    private CommandBuffer _buffer = null!;
+    private byte[] _packed = Array.Empty<byte>();
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _commands = ScriptTextConverterBenchmarks.CreateRecording(CommandCount);
+        CommandBuffer.TryCreate(_commands, out _buffer);
+        _packed = CommandBufferSerializer.Serialize(_buffer);
+    }
+
+    [Benchmark]
+    public int Pack() => CommandBuffer.TryCreate(_commands, out var buffer) ? buffer.Count : 0;
+
+    [Benchmark]
+    public int Unpack() => _buffer.ToCommandList().Count;
+
+    [Benchmark]
+    public int Serialize() => CommandBufferSerializer.Serialize(_buffer).Length;
+
+    [Benchmark]
+    public int Deserialize() => CommandBufferSerializer.Deserialize(_packed).Count;
+
+    [Benchmark]
+    public void WriteCommands_PackedRelativeMoves() => ScriptTextConverter.WriteCommands(TextWriter.Null, _buffer, packRelativeMoves: true);
+}
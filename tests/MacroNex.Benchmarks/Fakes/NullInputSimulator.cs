@@ -0,0 +1,29 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Benchmarks.Fakes;
+
+/// <summary>
+/// Input simulator that completes every call synchronously, so benchmarks measure only the caller.
+/// </summary>
+internal sealed class NullInputSimulator : IInputSimulator, IInputSimulatorFactory
+{
+    public Task SimulateMouseMoveAsync(Point position) => Task.CompletedTask;
+    public Task SimulateMouseMoveLowLevelAsync(Point position) => Task.CompletedTask;
+    public Task SimulateMouseMoveRelativeAsync(int deltaX, int deltaY) => Task.CompletedTask;
+    public Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY) => Task.CompletedTask;
+    public Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+    public Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+    public Task SimulateMouseClickAsync(MouseButton button, ClickType type) => Task.CompletedTask;
+    public Task SimulateKeyboardInputAsync(string text) => Task.CompletedTask;
+    public Task SimulateKeyPressAsync(VirtualKey key, bool isDown) => Task.CompletedTask;
+    public Task SimulateKeyComboAsync(IEnumerable<VirtualKey> keys) => Task.CompletedTask;
+    public Task DelayAsync(TimeSpan duration) => Task.CompletedTask;
+    public Task<Point> GetCursorPositionAsync() => Task.FromResult(new Point(0, 0));
+    public Task<bool> IsReadyAsync() => Task.FromResult(true);
+    public IInputBatch BeginBatch() => ImmediateInputBatch.Instance;
+    public Task ReleaseAllAsync() => Task.CompletedTask;
+
+    public IInputSimulator GetInputSimulator(InputMode mode) => this;
+}
@@ -0,0 +1,65 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Domain.Entities;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Script library load/save against a real temporary directory.
+/// </summary>
+[MemoryDiagnoser]
+public class JsonFileStorageBenchmarks
+{
+    private const int ScriptSourceLines = 200;
+
+    [Params(10, 100, 1000)]
+    public int LibrarySize { get; set; }
+
+    private string _storageDirectory = string.Empty;
+    private Script _savedScript = null!;
+    private string[] _sources = Array.Empty<string>();
+    private int _saveCount;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        _storageDirectory = Path.Combine(Path.GetTempPath(), "MacroNex.Benchmarks", Guid.NewGuid().ToString("N"));
+        var storage = CreateStorage();
+
+        var source = string.Join('\n', Enumerable.Range(0, ScriptSourceLines).Select(i => $"move_rel({i % 9 - 4}, {i % 5 - 2}) msleep({i % 7})"));
+        _sources = new[] { source, source + "\n" };
+        for (int i = 0; i < LibrarySize; i++)
+        {
+            await storage.SaveScriptAsync(new Script($"Script {i:D4}") { SourceText = source });
+        }
+
+        _savedScript = (await storage.LoadScriptsAsync()).First();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        try { Directory.Delete(_storageDirectory, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    // A fresh service per load so no in-memory state carries between iterations
+    [Benchmark(Baseline = true)]
+    public async Task<int> LoadScriptsAsync() => (await CreateStorage().LoadScriptsAsync()).Count();
+
+    [Benchmark]
+    public async Task<int> LoadScriptMetadataAsync() => (await CreateStorage().LoadScriptMetadataAsync()).Count();
+
+    [Benchmark]
+    public async Task<bool> LoadScriptAsync() => await CreateStorage().LoadScriptAsync(_savedScript.Id) != null;
+
+    [Benchmark]
+    public Task SaveScriptAsync_ExistingScript()
+    {
+        // Alternate between two sources so every save writes a real change of constant size
+        _savedScript.SourceText = _sources[++_saveCount & 1];
+        return CreateStorage().SaveScriptAsync(_savedScript);
+    }
+
+    private JsonFileStorageService CreateStorage() => new(NullLogger<JsonFileStorageService>.Instance, _storageDirectory);
+}
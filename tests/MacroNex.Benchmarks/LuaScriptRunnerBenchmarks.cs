@@ -0,0 +1,54 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Application.Services;
+using MacroNex.Benchmarks.Fakes;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Lua run setup cost and the overhead of one host API call, against an input simulator that does nothing.
+/// </summary>
+[MemoryDiagnoser]
+public class LuaScriptRunnerBenchmarks
+{
+    private const int LoopCount = 1000;
+
+    private static readonly string EmptyScript = "local x = 1";
+    private static readonly string PureLuaLoop = $"local x = 0 for i = 1, {LoopCount} do x = x + i end";
+    private static readonly string MoveRelLoop = $"for i = 1, {LoopCount} do move_rel(1, 0) end";
+    private static readonly string KeyLoop = $"for i = 1, {LoopCount} do key_down('a') key_release('a') end";
+
+    private readonly NullInputSimulator _input = new();
+    private SafetyService _safety = null!;
+    private LuaScriptRunner _runner = null!;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        _safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        _runner = CreateRunner();
+
+        // Populate the compile cache so the warm benchmarks measure reuse only
+        foreach (var source in new[] { EmptyScript, PureLuaLoop, MoveRelLoop, KeyLoop })
+        {
+            await _runner.RunAsync(source, CancellationToken.None);
+        }
+    }
+
+    [Benchmark]
+    public Task RunAsync_ColdRunner() => CreateRunner().RunAsync(EmptyScript, CancellationToken.None);
+
+    [Benchmark(Baseline = true)]
+    public Task RunAsync_WarmRunner() => _runner.RunAsync(EmptyScript, CancellationToken.None);
+
+    [Benchmark(OperationsPerInvoke = LoopCount)]
+    public Task PerIteration_PureLua() => _runner.RunAsync(PureLuaLoop, CancellationToken.None);
+
+    [Benchmark(OperationsPerInvoke = LoopCount)]
+    public Task PerHostCall_MoveRel() => _runner.RunAsync(MoveRelLoop, CancellationToken.None);
+
+    [Benchmark(OperationsPerInvoke = LoopCount * 2)]
+    public Task PerHostCall_KeyPress() => _runner.RunAsync(KeyLoop, CancellationToken.None);
+
+    private LuaScriptRunner CreateRunner() => new(_input, _safety, NullLogger<LuaScriptRunner>.Instance);
+}
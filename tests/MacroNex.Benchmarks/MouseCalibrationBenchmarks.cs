@@ -0,0 +1,65 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Pixel to HID delta conversion, with and without the compiled lookup tables.
+/// </summary>
+[MemoryDiagnoser]
+public class MouseCalibrationBenchmarks
+{
+    private const int DeltaCount = 1024;
+
+    private MouseCalibrationData _tabled = null!;
+    private MouseCalibrationData _untabled = null!;
+    private double[] _integerDeltas = Array.Empty<double>();
+    private double[] _fractionalDeltas = Array.Empty<double>();
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _tabled = CreateCalibration();
+        _tabled.BuildLookupTables();
+        _untabled = CreateCalibration();
+
+        var random = new Random(42);
+        _integerDeltas = Enumerable.Range(0, DeltaCount).Select(_ => (double)random.Next(-400, 401)).ToArray();
+        _fractionalDeltas = Enumerable.Range(0, DeltaCount).Select(_ => random.NextDouble() * 800 - 400).ToArray();
+    }
+
+    [Benchmark(Baseline = true, OperationsPerInvoke = DeltaCount)]
+    public int CalculateHidDelta_Integer_LookupTable() => Sum(_tabled, _integerDeltas);
+
+    [Benchmark(OperationsPerInvoke = DeltaCount)]
+    public int CalculateHidDelta_Integer_Computed() => Sum(_untabled, _integerDeltas);
+
+    [Benchmark(OperationsPerInvoke = DeltaCount)]
+    public int CalculateHidDelta_Fractional() => Sum(_tabled, _fractionalDeltas);
+
+    private static int Sum(MouseCalibrationData calibration, double[] deltas)
+    {
+        int sum = 0;
+        for (int i = 0; i < deltas.Length; i++)
+        {
+            sum += calibration.CalculateHidDelta(deltas[i]);
+            sum += calibration.CalculateHidDelta(deltas[i], useYAxis: true);
+        }
+        return sum;
+    }
+
+    /// <summary>
+    /// Mildly accelerated curve, roughly what "Enhance pointer precision" produces.
+    /// </summary>
+    private static MouseCalibrationData CreateCalibration()
+    {
+        var data = new MouseCalibrationData();
+        foreach (var hid in new[] { 0, 1, 2, 4, 8, 16, 32, 64, 127 })
+        {
+            var pixels = hid * (1.0 + hid / 64.0);
+            data.PointsX.Add(new CalibrationPoint { HidDelta = hid, ActualPixelDelta = pixels });
+            data.PointsY.Add(new CalibrationPoint { HidDelta = hid, ActualPixelDelta = pixels });
+        }
+        return data;
+    }
+}
@@ -0,0 +1,14 @@
+using BenchmarkDotNet.Running;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Entry point. Pass BenchmarkDotNet arguments through, e.g. <c>--filter *Protocol*</c>.
+/// </summary>
+public static class Program
+{
+    public static void Main(string[] args)
+    {
+        BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
+    }
+}
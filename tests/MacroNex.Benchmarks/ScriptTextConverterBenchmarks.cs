@@ -0,0 +1,68 @@
+using BenchmarkDotNet.Attributes;
+using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Benchmarks;
+
+/// <summary>
+/// Text round-trip cost for long recordings.
+/// </summary>
+[MemoryDiagnoser]
+public class ScriptTextConverterBenchmarks
+{
+    [Params(100_000)]
+    public int CommandCount { get; set; }
+
+    private List<Command> _commands = new();
+    private string _text = string.Empty;
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _commands = CreateRecording(CommandCount);
+        _text = ScriptTextConverter.CommandsToText(_commands);
+    }
+
+    [Benchmark]
+    public string CommandsToText() => ScriptTextConverter.CommandsToText(_commands);
+
+    [Benchmark]
+    public string CommandsToText_PackedRelativeMoves() => ScriptTextConverter.CommandsToText(_commands, packRelativeMoves: true);
+
+    [Benchmark]
+    public void WriteCommands_PackedRelativeMoves() => ScriptTextConverter.WriteCommands(TextWriter.Null, _commands, packRelativeMoves: true);
+
+    [Benchmark]
+    public int Parse() => ScriptTextConverter.Parse(_text).Count;
+
+    [Benchmark]
+    public int ReadCommands()
+    {
+        var count = 0;
+        foreach (var _ in ScriptTextConverter.ReadCommands(new StringReader(_text)))
+            count++;
+        return count;
+    }
+
+    /// <summary>
+    /// Mostly relative moves with interleaved sleeps, clicks and keys, like a real mouse recording.
+    /// </summary>
+    internal static List<Command> CreateRecording(int count)
+    {
+        var commands = new List<Command>(count);
+        for (int i = 0; i < count; i++)
+        {
+            commands.Add((i % 50) switch
+            {
+                0 => new MouseClickCommand(MouseButton.Left, ClickType.Down),
+                1 => new MouseClickCommand(MouseButton.Left, ClickType.Up),
+                2 => new KeyPressCommand(VirtualKey.VK_A, isDown: true),
+                3 => new KeyPressCommand(VirtualKey.VK_A, isDown: false),
+                var n when n % 4 == 0 => new SleepCommand(TimeSpan.FromMilliseconds(1 + n % 7)),
+                var n => new MouseMoveRelativeCommand(n % 9 - 4, n % 5 - 2)
+            });
+        }
+        return commands;
+    }
+}
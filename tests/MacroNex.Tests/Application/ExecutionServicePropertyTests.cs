@@ -235,6 +235,33 @@ public class ExecutionServicePropertyTests
         }
     }
 
+    [Fact]
+    public async Task KillSwitch_TerminatesRunsAndReleasesHeldInput()
+    {
+        var inputSimulator = new FakeInputSimulator { DelayGate = new TaskCompletionSource() };
+        var inputSimulatorFactory = new FakeInputSimulatorFactory(inputSimulator);
+        var arduinoConnectionService = new ArduinoConnectionService(new FakeArduinoService(), NullLogger<ArduinoConnectionService>.Instance);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var lua = new LuaScriptRunner(inputSimulatorFactory, safety, NullLogger<LuaScriptRunner>.Instance);
+        using var service = new ExecutionService(inputSimulatorFactory, arduinoConnectionService, new FakeGlobalHotkeyService(), safety, lua, NullLogger<ExecutionService>.Instance);
+
+        // The countdown parks the run inside the device until the gate opens
+        await service.StartExecutionAsync(CreateScript("held", 1), new ExecutionOptions { ShowCountdown = true, CountdownDuration = TimeSpan.FromSeconds(1) });
+        Assert.True(WaitUntil(() => inputSimulator.DelayCalls > 0, timeoutMs: 2000));
+
+        try
+        {
+            await safety.ActivateKillSwitchAsync("Emergency stop");
+
+            Assert.True(WaitUntil(() => inputSimulator.ReleaseAllCount == 1, timeoutMs: 2000));
+            Assert.Equal(ExecutionState.Terminated, service.State);
+        }
+        finally
+        {
+            inputSimulator.DelayGate!.TrySetResult();
+        }
+    }
+
     private static bool WaitUntilCompleted(ExecutionService service, int timeoutMs)
     {
         var sw = System.Diagnostics.Stopwatch.StartNew();
@@ -269,6 +296,8 @@ public class ExecutionServicePropertyTests
         public Task SimulateMouseMoveLowLevelAsync(Point position) => Task.CompletedTask;
         public Task SimulateMouseMoveRelativeAsync(int deltaX, int deltaY) => Task.CompletedTask;
         public Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY) => Task.CompletedTask;
+        public Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+        public Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
 
         public Task SimulateMouseClickAsync(MouseButton button, ClickType type) => Task.CompletedTask;
 
@@ -278,11 +307,29 @@ public class ExecutionServicePropertyTests
 
         public Task SimulateKeyComboAsync(IEnumerable<VirtualKey> keys) => Task.CompletedTask;
 
-        public Task DelayAsync(TimeSpan duration) => Task.CompletedTask;
+        public TaskCompletionSource? DelayGate { get; init; }
+
+        public int DelayCalls;
+
+        public int ReleaseAllCount;
+
+        public Task DelayAsync(TimeSpan duration)
+        {
+            Interlocked.Increment(ref DelayCalls);
+            return DelayGate?.Task ?? Task.CompletedTask;
+        }
 
         public Task<Point> GetCursorPositionAsync() => Task.FromResult(new Point(0, 0));
 
         public Task<bool> IsReadyAsync() => Task.FromResult(true);
+
+        public IInputBatch BeginBatch() => ImmediateInputBatch.Instance;
+
+        public Task ReleaseAllAsync()
+        {
+            Interlocked.Increment(ref ReleaseAllCount);
+            return Task.CompletedTask;
+        }
     }
 
     private sealed class FakeInputSimulatorFactory : IInputSimulatorFactory
@@ -306,6 +353,7 @@ public class ExecutionServicePropertyTests
         public ArduinoConnectionState ConnectionState => ArduinoConnectionState.Disconnected;
         public bool IsConnected => false;
         public string? ConnectedPortName => null;
+        public ArduinoFirmwareCapabilities Capabilities => ArduinoFirmwareCapabilities.None;
 
 #pragma warning disable CS0067 // Events are required by IArduinoService but not used in this test double.
         public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
@@ -317,6 +365,10 @@ public class ExecutionServicePropertyTests
         public Task ConnectAsync(string portName) => Task.CompletedTask;
         public Task DisconnectAsync() => Task.CompletedTask;
         public Task SendCommandAsync(ArduinoCommand command) => Task.CompletedTask;
+        public Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands) => Task.CompletedTask;
+        public Task FlushAsync() => Task.CompletedTask;
+
+        public Task EmergencyStopAsync() => Task.CompletedTask;
     }
 
     private sealed class FakeGlobalHotkeyService : IGlobalHotkeyService
@@ -0,0 +1,173 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using Xunit;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Unit tests for per-device input arbitration between concurrent executions.
+/// </summary>
+public class InputArbiterTests
+{
+    private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(5);
+
+    [Fact]
+    public void AcquireAsync_WhenDeviceFree_CompletesSynchronously()
+    {
+        var lane = new InputArbiter().CreateLane(ExecutionPriority.Normal);
+
+        var first = lane.AcquireAsync();
+        Assert.True(first.IsCompletedSuccessfully);
+        first.Result.Dispose();
+
+        var second = lane.AcquireAsync();
+        Assert.True(second.IsCompletedSuccessfully);
+        second.Result.Dispose();
+    }
+
+    [Fact]
+    public async Task Release_SamePriority_ServesWaitersInArrivalOrder()
+    {
+        var arbiter = new InputArbiter();
+        var holder = await arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+
+        var order = new List<int>();
+        var waits = Enumerable.Range(0, 3)
+            .Select(i => WaitAndRecordAsync(arbiter.CreateLane(ExecutionPriority.Normal), order, i))
+            .ToList();
+
+        holder.Dispose();
+        await Task.WhenAll(waits).WaitAsync(Timeout);
+
+        Assert.Equal(new[] { 0, 1, 2 }, order.ToArray());
+    }
+
+    [Fact]
+    public async Task Release_HigherPriorityFirst_ButLowerAfterStarvationLimit()
+    {
+        var arbiter = new InputArbiter(starvationLimit: 2);
+        var holder = await arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+
+        var order = new List<string>();
+        var background = WaitAndRecordAsync(arbiter.CreateLane(ExecutionPriority.Background), order, "bg");
+        var foreground = Enumerable.Range(0, 4)
+            .Select(i => WaitAndRecordAsync(arbiter.CreateLane(ExecutionPriority.Foreground), order, $"fg{i}"))
+            .ToList();
+
+        holder.Dispose();
+        await Task.WhenAll(foreground.Append(background)).WaitAsync(Timeout);
+
+        Assert.Equal(new[] { "fg0", "fg1", "bg", "fg2", "fg3" }, order.ToArray());
+    }
+
+    [Fact]
+    public async Task AcquireAsync_WhenCancelledWhileWaiting_IsSkipped()
+    {
+        var arbiter = new InputArbiter();
+        var holder = await arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+
+        using var cts = new CancellationTokenSource();
+        var cancelled = arbiter.CreateLane(ExecutionPriority.Foreground, cts.Token).AcquireAsync().AsTask();
+        var next = arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync().AsTask();
+
+        cts.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => cancelled.WaitAsync(Timeout));
+
+        holder.Dispose();
+        (await next.WaitAsync(Timeout)).Dispose();
+
+        // The device is free again afterwards
+        Assert.True(arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync().IsCompletedSuccessfully);
+    }
+
+    [Fact]
+    public async Task ArbitratedInputSimulator_HoldsDeviceOnlyForInputCalls()
+    {
+        var arbiter = new InputArbiter();
+        var simulator = new ArbitratedInputSimulator(new NoOpInputSimulator(), arbiter.CreateLane(ExecutionPriority.Normal));
+        var holder = await arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+
+        var click = simulator.SimulateMouseClickAsync(MouseButton.Left, ClickType.Click);
+        await Task.Delay(50);
+        Assert.False(click.IsCompleted);
+
+        holder.Dispose();
+        await click.WaitAsync(Timeout);
+    }
+
+    [Fact]
+    public async Task ArbitratedInputSimulator_DelayTakesTurnToFlushButSleepsWithoutIt()
+    {
+        var arbiter = new InputArbiter();
+        var inner = new NoOpInputSimulator { Sleep = new TaskCompletionSource() };
+        var simulator = new ArbitratedInputSimulator(inner, arbiter.CreateLane(ExecutionPriority.Normal));
+        var holder = await arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+
+        // Delivering the open batch is input, so it waits for the device
+        var delay = simulator.DelayAsync(TimeSpan.FromSeconds(1));
+        await Task.Delay(50);
+        Assert.Equal(0, inner.Flushes);
+
+        holder.Dispose();
+        await inner.Sleeping.Task.WaitAsync(Timeout);
+        Assert.Equal(1, inner.Flushes);
+
+        // The sleep does not hold the device
+        var other = arbiter.CreateLane(ExecutionPriority.Normal).AcquireAsync();
+        Assert.True(other.IsCompletedSuccessfully);
+        other.Result.Dispose();
+
+        inner.Sleep.SetResult();
+        await delay.WaitAsync(Timeout);
+    }
+
+    private static async Task WaitAndRecordAsync<T>(InputLane lane, List<T> order, T id)
+    {
+        using var turn = await lane.AcquireAsync();
+        lock (order)
+        {
+            order.Add(id);
+        }
+    }
+
+    private sealed class NoOpInputSimulator : IInputSimulator
+    {
+        public Task SimulateMouseMoveAsync(Point position) => Task.CompletedTask;
+        public Task SimulateMouseMoveLowLevelAsync(Point position) => Task.CompletedTask;
+        public Task SimulateMouseMoveRelativeAsync(int deltaX, int deltaY) => Task.CompletedTask;
+        public Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY) => Task.CompletedTask;
+        public Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+        public Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+        public Task SimulateMouseClickAsync(MouseButton button, ClickType type) => Task.CompletedTask;
+        public Task SimulateKeyboardInputAsync(string text) => Task.CompletedTask;
+        public Task SimulateKeyPressAsync(VirtualKey key, bool isDown) => Task.CompletedTask;
+        public Task SimulateKeyComboAsync(IEnumerable<VirtualKey> keys) => Task.CompletedTask;
+        public Task<Point> GetCursorPositionAsync() => Task.FromResult(Point.Zero);
+        public Task<bool> IsReadyAsync() => Task.FromResult(true);
+        public IInputBatch BeginBatch() => ImmediateInputBatch.Instance;
+
+        public Task ReleaseAllAsync() => Task.CompletedTask;
+
+        /// <summary>
+        /// Completes non-zero delays when set; zero delays stand for the flush of an open batch.
+        /// </summary>
+        public TaskCompletionSource? Sleep { get; init; }
+
+        public TaskCompletionSource Sleeping { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public int Flushes { get; private set; }
+
+        public Task DelayAsync(TimeSpan duration)
+        {
+            if (duration == TimeSpan.Zero)
+            {
+                Flushes++;
+                return Task.CompletedTask;
+            }
+
+            Sleeping.TrySetResult();
+            return Sleep?.Task ?? Task.CompletedTask;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using MacroNex.Application.Services;
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Unit tests for per-stage input latency aggregation and its meter.
+/// </summary>
+public class InputLatencyMonitorTests
+{
+    [Fact]
+    public void GetStatistics_ReportsOnlyStagesWithSamplesInPipelineOrder()
+    {
+        using var monitor = new InputLatencyMonitor();
+        var start = Stopwatch.GetTimestamp() - Stopwatch.Frequency / 1000; // 1 ms ago
+
+        monitor.Record(InputLatencyStage.SendInput, start);
+        monitor.Record(InputLatencyStage.HostCall, start);
+        monitor.Record(InputLatencyStage.HostCall, start);
+
+        var statistics = monitor.GetStatistics();
+
+        Assert.Equal(new[] { InputLatencyStage.HostCall, InputLatencyStage.SendInput }, statistics.Select(s => s.Stage).ToArray());
+        Assert.Equal(2, statistics[0].Count);
+        Assert.True(statistics[0].P50 >= TimeSpan.FromMilliseconds(0.9));
+        Assert.True(statistics[0].Max >= statistics[0].P99);
+    }
+
+    [Fact]
+    public void Reset_ClearsEveryStage()
+    {
+        using var monitor = new InputLatencyMonitor();
+        monitor.Record(InputLatencyStage.SerialWrite, Stopwatch.GetTimestamp());
+
+        monitor.Reset();
+
+        Assert.Empty(monitor.GetStatistics());
+    }
+
+    [Fact]
+    public void Record_PublishesToMeterWithStageTag()
+    {
+        using var monitor = new InputLatencyMonitor();
+        var stages = new List<string?>();
+
+        using var listener = new MeterListener();
+        listener.InstrumentPublished = (instrument, l) =>
+        {
+            if (instrument.Meter.Name == InputLatencyMonitor.MeterName && instrument.Name == "macronex.input.latency")
+                l.EnableMeasurementEvents(instrument);
+        };
+        listener.SetMeasurementEventCallback<double>((instrument, value, tags, state) =>
+        {
+            foreach (var tag in tags)
+            {
+                if (tag.Key == "stage")
+                    stages.Add(tag.Value as string);
+            }
+        });
+        listener.Start();
+
+        monitor.Record(InputLatencyStage.SerialQueue, Stopwatch.GetTimestamp());
+
+        Assert.Contains(nameof(InputLatencyStage.SerialQueue), stages);
+    }
+}
@@ -0,0 +1,97 @@
+using MacroNex.Application.Services;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Unit tests for the lock-free log-linear latency histogram.
+/// </summary>
+public class LatencyHistogramTests
+{
+    [Fact]
+    public void GetValueAtPercentile_WhenEmpty_ReturnsZero()
+    {
+        var histogram = new LatencyHistogram();
+
+        Assert.Equal(0, histogram.Count);
+        Assert.Equal(0, histogram.GetValueAtPercentile(50));
+        Assert.Equal(0, histogram.GetValueAtPercentile(99));
+    }
+
+    [Fact]
+    public void GetValueAtPercentile_SmallValues_AreExact()
+    {
+        var histogram = new LatencyHistogram();
+        for (int i = 1; i <= 20; i++)
+            histogram.Record(i);
+
+        Assert.Equal(10, histogram.GetValueAtPercentile(50));
+        Assert.Equal(20, histogram.GetValueAtPercentile(100));
+        Assert.Equal(20, histogram.MaxMicroseconds);
+    }
+
+    [Fact]
+    public void GetValueAtPercentile_LargeValues_StayWithinBucketPrecision()
+    {
+        var histogram = new LatencyHistogram();
+        for (int i = 1; i <= 100_000; i++)
+            histogram.Record(i);
+
+        AssertWithinRelative(50_000, histogram.GetValueAtPercentile(50), 0.07);
+        AssertWithinRelative(99_000, histogram.GetValueAtPercentile(99), 0.07);
+        Assert.Equal(100_000, histogram.GetValueAtPercentile(100));
+    }
+
+    [Fact]
+    public void GetValueAtPercentile_IsCappedAtRecordedMaximum()
+    {
+        var histogram = new LatencyHistogram();
+        histogram.Record(1_000_001);
+
+        Assert.Equal(1_000_001, histogram.GetValueAtPercentile(50));
+    }
+
+    [Fact]
+    public void Record_ClampsNegativeAndHugeValues()
+    {
+        var histogram = new LatencyHistogram();
+        histogram.Record(-5);
+        histogram.Record(long.MaxValue);
+
+        Assert.Equal(2, histogram.Count);
+        Assert.Equal(0, histogram.GetValueAtPercentile(50));
+        Assert.Equal(long.MaxValue, histogram.MaxMicroseconds);
+    }
+
+    [Fact]
+    public void Record_FromManyThreads_CountsEverySample()
+    {
+        var histogram = new LatencyHistogram();
+
+        Parallel.For(0, 8, worker =>
+        {
+            for (int i = 0; i < 10_000; i++)
+                histogram.Record(worker * 1000 + i % 1000);
+        });
+
+        Assert.Equal(80_000, histogram.Count);
+        Assert.Equal(7999, histogram.MaxMicroseconds);
+    }
+
+    [Fact]
+    public void Reset_ClearsSamples()
+    {
+        var histogram = new LatencyHistogram();
+        histogram.Record(42);
+
+        histogram.Reset();
+
+        Assert.Equal(0, histogram.Count);
+        Assert.Equal(0, histogram.MaxMicroseconds);
+        Assert.Equal(0, histogram.GetValueAtPercentile(99));
+    }
+
+    private static void AssertWithinRelative(long expected, long actual, double tolerance)
+    {
+        Assert.InRange(actual, (long)(expected * (1 - tolerance)), (long)(expected * (1 + tolerance)));
+    }
+}
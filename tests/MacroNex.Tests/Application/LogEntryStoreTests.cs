@@ -0,0 +1,125 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Unit tests for the ring-buffer log store behind LoggingService.
+/// </summary>
+public class LogEntryStoreTests
+{
+    private static readonly DateTime Origin = new(2024, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+
+    private static LogEntry Entry(int i, LogLevel level = LogLevel.Info, string? message = null) =>
+        new(Guid.NewGuid(), Origin.AddMilliseconds(i), level, message ?? $"entry {i}");
+
+    [Fact]
+    public void Constructor_RoundsCapacityUpToWholeBlocks()
+    {
+        var store = new LogEntryStore(1000);
+
+        Assert.Equal(1024, store.Capacity);
+    }
+
+    [Fact]
+    public void Append_PastCapacity_KeepsNewestEntries()
+    {
+        var store = new LogEntryStore(LogEntryStore.BlockSize);
+        for (var i = 0; i < 1000; i++)
+            store.Append(Entry(i));
+
+        var entries = store.Query(LogFilter.All());
+
+        Assert.Equal(LogEntryStore.BlockSize, store.Count);
+        Assert.Equal(LogEntryStore.BlockSize, entries.Count);
+        Assert.Equal("entry 999", entries[0].Message);
+        Assert.Equal($"entry {1000 - LogEntryStore.BlockSize}", entries[^1].Message);
+    }
+
+    [Fact]
+    public void Query_ByLevel_ReturnsNewestMatchesFirstAndHonoursMaxResults()
+    {
+        var store = new LogEntryStore(10_000);
+        for (var i = 0; i < 5000; i++)
+            store.Append(Entry(i, i % 100 == 0 ? LogLevel.Error : LogLevel.Info));
+
+        var errors = store.Query(new LogFilter { MinLevel = LogLevel.Error, MaxLevel = LogLevel.Error, MaxResults = 3 });
+
+        Assert.Equal(new[] { "entry 4900", "entry 4800", "entry 4700" }, errors.Select(e => e.Message).ToArray());
+
+        // Second query is answered with block summaries; results must not change
+        var again = store.Query(new LogFilter { MinLevel = LogLevel.Error, MaxLevel = LogLevel.Error });
+        Assert.Equal(50, again.Count);
+    }
+
+    [Fact]
+    public void Query_ByTimeRangeAndSearch_FiltersEntries()
+    {
+        var store = new LogEntryStore(4096);
+        for (var i = 0; i < 3000; i++)
+            store.Append(Entry(i, message: i % 2 == 0 ? $"Mouse move {i}" : $"Key press {i}"));
+
+        var filter = new LogFilter
+        {
+            StartTime = Origin.AddMilliseconds(1000),
+            EndTime = Origin.AddMilliseconds(1009),
+            SearchTerm = "MOUSE"
+        };
+        var first = store.Query(filter);
+        var second = store.Query(filter);
+
+        Assert.Equal(5, first.Count);
+        Assert.All(first, e => Assert.StartsWith("Mouse move", e.Message));
+        Assert.Equal(first.Select(e => e.Message), second.Select(e => e.Message));
+    }
+
+    [Fact]
+    public void Clear_RemovesEntriesAndCounts()
+    {
+        var store = new LogEntryStore(1024);
+        for (var i = 0; i < 100; i++)
+            store.Append(Entry(i, LogLevel.Warning));
+
+        store.Clear();
+        store.Append(Entry(100));
+
+        var stats = store.GetStatistics();
+        Assert.Equal(1, stats.TotalEntries);
+        Assert.Equal(0, stats.WarningCount);
+        Assert.Equal("entry 100", Assert.Single(store.Query(LogFilter.All())).Message);
+    }
+
+    [Fact]
+    public void GetStatistics_TracksLevelsAcrossEviction()
+    {
+        var store = new LogEntryStore(LogEntryStore.BlockSize);
+        for (var i = 0; i < LogEntryStore.BlockSize; i++)
+            store.Append(Entry(i, LogLevel.Error));
+        for (var i = 0; i < LogEntryStore.BlockSize / 2; i++)
+            store.Append(Entry(LogEntryStore.BlockSize + i, LogLevel.Info));
+
+        var stats = store.GetStatistics();
+
+        Assert.Equal(LogEntryStore.BlockSize / 2, stats.ErrorCount);
+        Assert.Equal(LogEntryStore.BlockSize / 2, stats.InfoCount);
+        Assert.Equal(Origin.AddMilliseconds(LogEntryStore.BlockSize / 2), stats.OldestEntry);
+        Assert.Equal(Origin.AddMilliseconds(LogEntryStore.BlockSize * 3 / 2 - 1), stats.NewestEntry);
+    }
+
+    [Fact]
+    public void Append_FromManyThreads_RetainsEveryEntry()
+    {
+        const int threads = 4;
+        const int perThread = 5000;
+        var store = new LogEntryStore(threads * perThread);
+
+        Parallel.For(0, threads, t =>
+        {
+            for (var i = 0; i < perThread; i++)
+                store.Append(Entry(t * perThread + i));
+        });
+
+        Assert.Equal(threads * perThread, store.Count);
+        Assert.Equal(threads * perThread, store.Query(LogFilter.All()).Select(e => e.Message).Distinct().Count());
+    }
+}
@@ -2,6 +2,7 @@
 using MacroNex.Domain.Interfaces;
 using MacroNex.Domain.ValueObjects;
 using Microsoft.Extensions.Logging.Abstractions;
+using MoonSharp.Interpreter;
 using Moq;
 
 namespace MacroNex.Tests.Application;
@@ -14,7 +15,7 @@ public class LuaScriptRunnerTests
         var input = new Mock<IInputSimulator>(MockBehavior.Strict);
         var safety = new SafetyService(NullLogger<SafetyService>.Instance);
 
-        input.Setup(i => i.SimulateMouseMoveAsync(It.IsAny<Point>())).Returns(Task.CompletedTask);
+        input.Setup(i => i.SimulateMouseMoveAsync(It.IsAny<Point>(), It.IsAny<CancellationToken>())).Returns(Task.CompletedTask);
         input.Setup(i => i.SimulateMouseClickAsync(MouseButton.Left, ClickType.Click)).Returns(Task.CompletedTask);
         input.Setup(i => i.SimulateKeyboardInputAsync("hi")).Returns(Task.CompletedTask);
         input.Setup(i => i.SimulateKeyPressAsync(VirtualKey.VK_A, true)).Returns(Task.CompletedTask);
@@ -36,6 +37,313 @@ key_release('a')
         input.VerifyAll();
     }
 
+    [Fact]
+    public async Task RunAsync_FractionalDeltas_MoveRelAndMoveStreamTruncateAlike()
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        input.Setup(i => i.SimulateMouseMoveRelativeAsync(2, 0)).Returns(Task.CompletedTask);
+        input.Setup(i => i.SimulateMouseMoveRelativeAsync(-2, 3)).Returns(Task.CompletedTask);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await runner.RunAsync("move_rel(2.5, 0) move_rel(-2.5, 3.9) move_stream({2.5, 0, 0, -2.5, 3.9, 0})", CancellationToken.None);
+
+        input.Verify(i => i.SimulateMouseMoveRelativeAsync(2, 0), Times.Exactly(2));
+        input.Verify(i => i.SimulateMouseMoveRelativeAsync(-2, 3), Times.Exactly(2));
+    }
+
+    [Fact]
+    public async Task RunAsync_SameSourceTwice_ReusesCompiledScript()
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.SimulateKeyboardInputAsync("x")).Returns(Task.CompletedTask);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        // Globals from a previous run must not leak into the next one.
+        var lua = @"
+assert(counter == nil)
+counter = 1
+type_text('x')
+";
+
+        await runner.RunAsync(lua, CancellationToken.None);
+        await runner.RunAsync(lua, CancellationToken.None);
+
+        var stats = runner.GetCacheStatistics();
+        Assert.Equal(1, stats.Hits);
+        Assert.Equal(1, stats.Misses);
+        Assert.Equal(1, stats.CachedScripts);
+        input.Verify(i => i.SimulateKeyboardInputAsync("x"), Times.Exactly(2));
+    }
+
+    [Fact]
+    public async Task RunAsync_SameSourceTwice_RestoresPatchedLibraries()
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        // The second run must see the libraries the first one broke as they were.
+        var lua = @"
+assert(string.upper('a') == 'A')
+assert(('b'):upper() == 'B')
+assert(math.pi > 3.14 and string.custom == nil)
+string.upper = nil
+string.custom = true
+math.pi = 3
+";
+
+        await runner.RunAsync(lua, CancellationToken.None);
+        await runner.RunAsync(lua, CancellationToken.None);
+
+        Assert.Equal(1, runner.GetCacheStatistics().Hits);
+    }
+
+    [Fact]
+    public async Task RunAsync_WhenScriptFails_DoesNotKeepSandboxCached()
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await Assert.ThrowsAnyAsync<Exception>(() => runner.RunAsync("error('boom')", CancellationToken.None));
+
+        Assert.Equal(0, runner.GetCacheStatistics().CachedScripts);
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task RunAsync_InfiniteLoop_HitsStepLimit(bool useDebugger)
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+        var limits = new LuaExecutionLimits { MaxSteps = 10_000, CheckInterval = 100, UseDebugger = useDebugger };
+
+        var ex = await Assert.ThrowsAsync<ScriptRuntimeException>(() => runner.RunAsync("while true do end", CancellationToken.None, limits));
+
+        Assert.Contains("step_limit", ex.Message);
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task RunAsync_LoopThatSuspendsBeforeEachCheck_HitsStepLimit(bool useDebugger)
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+        var limits = new LuaExecutionLimits { MaxSteps = 50, MaxExecutionTime = TimeSpan.Zero, CheckInterval = 100, UseDebugger = useDebugger };
+
+        // Far fewer than CheckInterval instructions between sleeps
+        var ex = await Assert.ThrowsAsync<ScriptRuntimeException>(() =>
+            runner.RunAsync("for i = 1, 1e9 do if i % 5 == 0 then msleep(1) end end", CancellationToken.None, limits)
+                .WaitAsync(TimeSpan.FromSeconds(10)));
+
+        Assert.Contains("step_limit", ex.Message);
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task RunAsync_PcallAroundCancelledLoop_StillStops(bool useDebugger)
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+        var limits = new LuaExecutionLimits { MaxSteps = 0, MaxExecutionTime = TimeSpan.Zero, CheckInterval = 100, UseDebugger = useDebugger };
+        using var cts = new CancellationTokenSource(TimeSpan.FromMilliseconds(100));
+
+        var ex = await Assert.ThrowsAsync<ScriptRuntimeException>(() =>
+            runner.RunAsync("while true do pcall(function() while true do end end) end", cts.Token, limits)
+                .WaitAsync(TimeSpan.FromSeconds(10)));
+
+        Assert.Contains("cancelled", ex.Message);
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task RunAsync_PcallAroundHostCallAfterKillSwitch_StillStops(bool useDebugger)
+    {
+        var presses = 0;
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        input.Setup(i => i.SimulateKeyPressAsync(VirtualKey.VK_A, true))
+            .Returns(() => ++presses == 10 ? safety.ActivateKillSwitchAsync("test") : Task.CompletedTask);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+        var limits = new LuaExecutionLimits { MaxSteps = 0, MaxExecutionTime = TimeSpan.Zero, UseDebugger = useDebugger };
+
+        var ex = await Assert.ThrowsAsync<ScriptRuntimeException>(() =>
+            runner.RunAsync("while true do pcall(key_down, 'a') end", CancellationToken.None, limits)
+                .WaitAsync(TimeSpan.FromSeconds(10)));
+
+        Assert.Contains("kill_switch", ex.Message);
+        Assert.Equal(10, presses);
+    }
+
+    [Fact]
+    public async Task RunAsync_ManyConcurrentSleepingScripts_DoNotHoldThreads()
+    {
+        // Every script waits in type_text until all 64 are waiting there at once
+        const int scripts = 64;
+        var arrived = 0;
+        var allWaiting = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.SimulateKeyboardInputAsync("done"))
+            .Returns(() =>
+            {
+                if (Interlocked.Increment(ref arrived) == scripts)
+                    allWaiting.TrySetResult();
+                return allWaiting.Task;
+            });
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        var runs = Enumerable.Range(0, scripts)
+            .Select(_ => runner.RunAsync("msleep(50)\ntype_text('done')", CancellationToken.None))
+            .ToArray();
+
+        // Suspended scripts hold no thread, so neither the sleeps nor the gate wait on thread injection
+        await Task.WhenAll(runs).WaitAsync(TimeSpan.FromSeconds(30));
+        input.Verify(i => i.SimulateKeyboardInputAsync("done"), Times.Exactly(scripts));
+    }
+
+    [Fact]
+    public async Task RunAsync_HostCallsWhereLuaCannotYield_CompleteSynchronously()
+    {
+        var typed = new List<string>();
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.SimulateKeyboardInputAsync(It.IsAny<string>()))
+            .Returns(async (string text) =>
+            {
+                await Task.Delay(5);
+                lock (typed) typed.Add(text);
+            });
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        // Sort comparators and gsub replacements are called back from the host, where a yield is refused
+        var lua = @"
+local t = { 3, 1, 2 }
+table.sort(t, function(a, b) msleep(1) return a < b end)
+assert(t[1] == 1 and t[3] == 3)
+string.gsub('ab', '%a', function(c) type_text(c) end)
+assert(pcall(type_text, 'c'))
+type_text('d')
+";
+
+        await runner.RunAsync(lua, CancellationToken.None);
+
+        Assert.Equal(new[] { "a", "b", "c", "d" }, typed);
+    }
+
+    [Fact]
+    public async Task RunAsync_WithDeadlineTimeline_ReportsLatenessOfSlowActions()
+    {
+        // Each key press takes 80 ms on the timeline clock, longer than the 50 ms sleeps between them
+        var clock = new ManualTimeProvider();
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.SimulateKeyPressAsync(VirtualKey.VK_A, It.IsAny<bool>()))
+            .Callback(() => clock.Advance(TimeSpan.FromMilliseconds(80)))
+            .Returns(Task.CompletedTask);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        var lateness = new List<TimeSpan>();
+        var timeline = new PlaybackTimeline(DeadlineOverrunPolicy.CatchUp, TimeSpan.FromSeconds(1), lateness.Add, timeProvider: clock);
+
+        await runner.RunAsync("key_down('a')\nmsleep(50)\nkey_release('a')\nmsleep(50)\nkey_down('a')", CancellationToken.None, timeline: timeline);
+
+        Assert.Equal(new[] { TimeSpan.Zero, TimeSpan.FromMilliseconds(30), TimeSpan.FromMilliseconds(60) }, lateness);
+        Assert.Equal(TimeSpan.FromMilliseconds(100), timeline.ScheduledOffset);
+    }
+
+    [Fact]
+    public async Task RunAsync_Batch_CommitsInputsMadeInsideIt()
+    {
+        var calls = new List<string>();
+        var batch = new Mock<IInputBatch>(MockBehavior.Strict);
+        batch.Setup(b => b.CommitAsync()).Callback(() => calls.Add("commit")).Returns(Task.CompletedTask);
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.BeginBatch()).Callback(() => calls.Add("begin")).Returns(batch.Object);
+        input.Setup(i => i.SimulateKeyPressAsync(VirtualKey.VK_A, It.IsAny<bool>()))
+            .Callback<VirtualKey, bool>((_, isDown) => calls.Add(isDown ? "down" : "up"))
+            .Returns(Task.CompletedTask);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await runner.RunAsync("batch(function() key_down('a') key_release('a') end)", CancellationToken.None);
+
+        Assert.Equal(new[] { "begin", "down", "up", "commit" }, calls);
+    }
+
+    [Fact]
+    public async Task RunAsync_ErrorInsideBatch_DiscardsUncommittedInputs()
+    {
+        var batch = new Mock<IInputBatch>(MockBehavior.Strict);
+        batch.Setup(b => b.DisposeAsync()).Returns(ValueTask.CompletedTask);
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.BeginBatch()).Returns(batch.Object);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await Assert.ThrowsAnyAsync<Exception>(() => runner.RunAsync("batch(function() error('boom') end)", CancellationToken.None));
+
+        batch.Verify(b => b.DisposeAsync(), Times.Once);
+        batch.Verify(b => b.CommitAsync(), Times.Never);
+    }
+
+    [Fact]
+    public async Task RunAsync_BatchErrorCaughtByPcall_ClosesBatchBeforeContinuing()
+    {
+        var calls = new List<string>();
+        var batch = new Mock<IInputBatch>(MockBehavior.Strict);
+        batch.Setup(b => b.DisposeAsync()).Callback(() => calls.Add("discard")).Returns(ValueTask.CompletedTask);
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        input.Setup(i => i.BeginBatch()).Callback(() => calls.Add("begin")).Returns(batch.Object);
+        input.Setup(i => i.SimulateKeyPressAsync(VirtualKey.VK_A, It.IsAny<bool>()))
+            .Callback<VirtualKey, bool>((_, isDown) => calls.Add(isDown ? "down" : "up"))
+            .Returns(Task.CompletedTask);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await runner.RunAsync(
+            "local ok, err = pcall(batch, function() key_down('a') error('boom') end)\n" +
+            "assert(not ok and err:find('boom'))\n" +
+            "key_release('a')",
+            CancellationToken.None);
+
+        Assert.Equal(new[] { "begin", "down", "discard", "up" }, calls);
+        batch.Verify(b => b.CommitAsync(), Times.Never);
+    }
+
+    [Fact]
+    public async Task RunAsync_BatchMarkers_AreNotScriptGlobals()
+    {
+        var input = new Mock<IInputSimulator>(MockBehavior.Strict);
+        var safety = new SafetyService(NullLogger<SafetyService>.Instance);
+        var runner = new LuaScriptRunner(new FakeInputSimulatorFactory(input.Object), safety, NullLogger<LuaScriptRunner>.Instance);
+
+        await runner.RunAsync(
+            "assert(type(batch) == 'function')\n" +
+            "assert(__batch_begin == nil and __batch_end == nil and batch_begin == nil and batch_end == nil)",
+            CancellationToken.None);
+    }
+
+    private sealed class ManualTimeProvider : TimeProvider
+    {
+        private long _timestamp;
+
+        public override long TimestampFrequency => TimeSpan.TicksPerSecond;
+
+        public override long GetTimestamp() => Interlocked.Read(ref _timestamp);
+
+        public void Advance(TimeSpan elapsed) => Interlocked.Add(ref _timestamp, elapsed.Ticks);
+    }
+
     private sealed class FakeInputSimulatorFactory : IInputSimulatorFactory
     {
         private readonly IInputSimulator _inputSimulator;
@@ -0,0 +1,158 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Unit tests for the recording-time mouse path simplifier.
+/// </summary>
+public class MousePathSimplifierTests
+{
+    private static readonly DateTime Origin = new(2024, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+
+    [Fact]
+    public void Add_WithoutAnchor_EmitsFirstSampleImmediately()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.FromMilliseconds(10), 1.0);
+        var output = new List<MousePathPoint>();
+
+        simplifier.Add(new Point(5, 5), Origin, output);
+
+        Assert.Single(output);
+        Assert.Equal(new Point(5, 5), output[0].Position);
+        Assert.True(simplifier.HasAnchor);
+    }
+
+    [Fact]
+    public void Flush_StraightLine_KeepsOnlyEndpoint()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.Zero, 1.0);
+        simplifier.SetAnchor(new Point(0, 0), Origin);
+        var output = new List<MousePathPoint>();
+
+        for (var i = 1; i <= 50; i++)
+            simplifier.Add(new Point(i * 2, i), Origin.AddMilliseconds(i), output);
+        simplifier.Flush(output);
+
+        var point = Assert.Single(output);
+        Assert.Equal(new Point(100, 50), point.Position);
+        Assert.Equal(Origin.AddMilliseconds(50), point.Timestamp);
+    }
+
+    [Fact]
+    public void Flush_KeepsCorners()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.Zero, 1.0);
+        simplifier.SetAnchor(new Point(0, 0), Origin);
+        var output = new List<MousePathPoint>();
+
+        var t = 0;
+        for (var x = 1; x <= 20; x++)
+            simplifier.Add(new Point(x, 0), Origin.AddMilliseconds(++t), output);
+        for (var y = 1; y <= 20; y++)
+            simplifier.Add(new Point(20, y), Origin.AddMilliseconds(++t), output);
+        simplifier.Flush(output);
+
+        Assert.Equal(new[] { new Point(20, 0), new Point(20, 20) }, output.Select(p => p.Position).ToArray());
+    }
+
+    [Fact]
+    public void Add_WithinCoalesceInterval_ReplacesPreviousSample()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.FromMilliseconds(10), 0);
+        simplifier.SetAnchor(new Point(0, 0), Origin);
+        var output = new List<MousePathPoint>();
+
+        simplifier.Add(new Point(1, 1), Origin.AddMilliseconds(10), output);
+        simplifier.Add(new Point(2, 5), Origin.AddMilliseconds(12), output);
+        simplifier.Add(new Point(3, 9), Origin.AddMilliseconds(14), output);
+
+        Assert.Equal(1, simplifier.PendingCount);
+
+        simplifier.Flush(output);
+        var point = Assert.Single(output);
+        Assert.Equal(new Point(3, 9), point.Position);
+    }
+
+    [Fact]
+    public void Add_SteadyStreamFasterThanCoalesceInterval_KeepsOneSamplePerInterval()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.FromMilliseconds(10), 0);
+        simplifier.SetAnchor(new Point(0, 0), Origin);
+        var output = new List<MousePathPoint>();
+
+        // 1 ms apart: each sample is close to the previous one, but the slots must still advance
+        for (var i = 1; i <= 30; i++)
+            simplifier.Add(new Point(i, i * i), Origin.AddMilliseconds(i), output);
+
+        Assert.Equal(3, simplifier.PendingCount);
+    }
+
+    [Fact]
+    public void Add_AfterIdleGap_ClosesStrokeAtRestPoint()
+    {
+        var simplifier = new MousePathSimplifier(TimeSpan.Zero, 1.0, strokeBreakGap: TimeSpan.FromMilliseconds(50));
+        simplifier.SetAnchor(new Point(0, 0), Origin);
+        var output = new List<MousePathPoint>();
+
+        simplifier.Add(new Point(10, 0), Origin.AddMilliseconds(10), output);
+        simplifier.Add(new Point(20, 0), Origin.AddMilliseconds(20), output);
+
+        // Collinear continuation after a pause must not swallow the rest point
+        simplifier.Add(new Point(30, 0), Origin.AddMilliseconds(500), output);
+
+        var rest = Assert.Single(output);
+        Assert.Equal(new Point(20, 0), rest.Position);
+        Assert.Equal(Origin.AddMilliseconds(20), rest.Timestamp);
+    }
+
+    [Fact]
+    public void Simplify_LongWigglyPath_ShrinksOutputAndStaysWithinTolerance()
+    {
+        // No coalescing: every sample reaches the RDP pass, whose tolerance is the guarantee checked below
+        const double tolerance = 1.0;
+        var simplifier = new MousePathSimplifier(TimeSpan.Zero, tolerance);
+        simplifier.SetAnchor(new Point(400, 0), Origin);
+        var raw = new List<Point> { new(400, 0) };
+        var output = new List<MousePathPoint>();
+
+        // 1000 Hz sampling of a slow arc
+        for (var i = 1; i <= 5000; i++)
+        {
+            var angle = i / 5000.0 * Math.PI;
+            var position = new Point((int)Math.Round(400 * Math.Cos(angle)), (int)Math.Round(400 * Math.Sin(angle)));
+            raw.Add(position);
+            simplifier.Add(position, Origin.AddMilliseconds(i), output);
+        }
+        simplifier.Flush(output);
+
+        Assert.True(output.Count * 10 < raw.Count, $"Expected at least 10x reduction, got {output.Count} of {raw.Count}");
+        Assert.Equal(raw[^1], output[^1].Position);
+        Assert.True(output.Zip(output.Skip(1)).All(pair => pair.First.Timestamp < pair.Second.Timestamp));
+
+        // Every dropped sample must lie within the tolerance of the polyline that replaces it
+        var polyline = new[] { raw[0] }.Concat(output.Select(p => p.Position)).ToList();
+        foreach (var point in raw)
+        {
+            var distance = polyline.Zip(polyline.Skip(1)).Min(segment => DistanceToSegment(point, segment.First, segment.Second));
+            Assert.True(distance <= tolerance, $"{point} is {distance:F3}px from the simplified path");
+        }
+    }
+
+    [Fact]
+    public void Constructor_WithNegativeTolerance_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() => new MousePathSimplifier(TimeSpan.Zero, -1));
+    }
+
+    private static double DistanceToSegment(Point p, Point a, Point b)
+    {
+        double dx = b.X - a.X;
+        double dy = b.Y - a.Y;
+        var lengthSquared = dx * dx + dy * dy;
+        var t = lengthSquared == 0 ? 0 : Math.Clamp(((p.X - a.X) * dx + (p.Y - a.Y) * dy) / lengthSquared, 0, 1);
+        var ex = p.X - a.X - t * dx;
+        var ey = p.Y - a.Y - t * dy;
+        return Math.Sqrt(ex * ex + ey * ey);
+    }
+}
@@ -0,0 +1,85 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.Interfaces;
+
+namespace MacroNex.Tests.Application;
+
+public class PlaybackTimelineTests
+{
+    [Fact]
+    public void Advance_SubtractsTimeAlreadySpentFromTheNextWait()
+    {
+        var clock = new ManualTimeProvider();
+        var timeline = new PlaybackTimeline(DeadlineOverrunPolicy.CatchUp, TimeSpan.FromSeconds(1), timeProvider: clock);
+
+        clock.Advance(TimeSpan.FromMilliseconds(30));
+        var wait = timeline.Advance(TimeSpan.FromMilliseconds(100));
+
+        Assert.Equal(TimeSpan.FromMilliseconds(70), wait);
+        Assert.Equal(TimeSpan.FromMilliseconds(100), timeline.ScheduledOffset);
+    }
+
+    [Fact]
+    public void Advance_WhenBehind_ReturnsZeroAndReportsLateness()
+    {
+        var clock = new ManualTimeProvider();
+        var lateness = new List<TimeSpan>();
+        var timeline = new PlaybackTimeline(DeadlineOverrunPolicy.CatchUp, TimeSpan.FromMilliseconds(5), lateness.Add, timeProvider: clock);
+
+        clock.Advance(TimeSpan.FromMilliseconds(40));
+        Assert.Equal(TimeSpan.Zero, timeline.Advance(TimeSpan.FromMilliseconds(10)));
+        timeline.MarkAction();
+
+        Assert.Equal(TimeSpan.FromMilliseconds(30), Assert.Single(lateness));
+    }
+
+    [Fact]
+    public void Advance_WithResyncPolicy_DropsBacklogBeyondLimit()
+    {
+        var clock = new ManualTimeProvider();
+        var resyncs = 0;
+        var lateness = new List<TimeSpan>();
+        var timeline = new PlaybackTimeline(DeadlineOverrunPolicy.Resync, TimeSpan.FromMilliseconds(5), lateness.Add, () => resyncs++, clock);
+
+        clock.Advance(TimeSpan.FromMilliseconds(40));
+        timeline.Advance(TimeSpan.FromMilliseconds(10));
+        timeline.MarkAction();
+
+        // Later gaps keep their length from the re-based origin
+        clock.Advance(TimeSpan.FromMilliseconds(2));
+        var wait = timeline.Advance(TimeSpan.FromMilliseconds(10));
+
+        Assert.Equal(1, resyncs);
+        Assert.Equal(TimeSpan.Zero, lateness[0]);
+        Assert.Equal(TimeSpan.FromMilliseconds(8), wait);
+    }
+
+    [Fact]
+    public void ExecutionSession_FillLatenessStatistics_AggregatesRecordedLateness()
+    {
+        var session = new ExecutionSession(new Script("s"), ExecutionOptions.Default());
+        session.RecordActionLateness(TimeSpan.FromMilliseconds(2));
+        session.RecordActionLateness(TimeSpan.FromMilliseconds(4));
+        session.RecordActionLateness(TimeSpan.FromMilliseconds(-1));
+        session.RecordTimelineResync();
+
+        var statistics = new ExecutionStatistics();
+        session.FillLatenessStatistics(statistics);
+
+        Assert.Equal(3, statistics.TimedActionCount);
+        Assert.Equal(TimeSpan.FromMilliseconds(2), statistics.AverageActionLateness);
+        Assert.Equal(TimeSpan.FromMilliseconds(4), statistics.MaxActionLateness);
+        Assert.Equal(1, statistics.TimelineResyncCount);
+    }
+
+    private sealed class ManualTimeProvider : TimeProvider
+    {
+        private long _timestamp;
+
+        public override long TimestampFrequency => TimeSpan.TicksPerSecond;
+
+        public override long GetTimestamp() => _timestamp;
+
+        public void Advance(TimeSpan elapsed) => _timestamp += elapsed.Ticks;
+    }
+}
@@ -1,5 +1,7 @@
 using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
 using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
 using Microsoft.Extensions.Logging.Abstractions;
 using Xunit;
 
@@ -25,5 +27,21 @@ public class SafetyServiceTests
         Assert.True(service.IsKillSwitchActive);
         Assert.True(raised);
     }
+
+    [Fact]
+    public async Task ActivateKillSwitchAsync_DeniesPendingAuthorizationAtOnce()
+    {
+        var service = new SafetyService(NullLogger<SafetyService>.Instance);
+        var operation = new DangerousOperation(DangerousOperationType.SystemKeyCombo, "Alt+F4",
+            new MouseMoveCommand(new Point(0, 0)), 0, RiskLevel.Low, "Confirm");
+
+        // No handler answers, so without the kill switch this would wait for the 2-second timeout
+        var pending = service.RequestAuthorizationAsync(operation, new AuthorizationContext(new Script("s"), 0, true));
+        await service.ActivateKillSwitchAsync("Test");
+
+        var result = await pending.WaitAsync(TimeSpan.FromSeconds(1));
+        Assert.False(result.IsAuthorized);
+        Assert.Equal("Kill switch is active", result.Reason);
+    }
 }
 
@@ -0,0 +1,166 @@
+using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+using Moq;
+using Xunit;
+
+namespace MacroNex.Tests.Application;
+
+/// <summary>
+/// Tests that ScriptManager serves the library from metadata and loads script bodies on demand.
+/// </summary>
+public class ScriptManagerLazyLoadingTests : IDisposable
+{
+    private readonly string _tempDir;
+
+    public ScriptManagerLazyLoadingTests()
+    {
+        _tempDir = Path.Combine(Path.GetTempPath(), "MacroNex.Tests", "lazy", Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(_tempDir);
+    }
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_tempDir, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    [Fact]
+    public async Task Startup_UsesMetadataWithoutLoadingBodies()
+    {
+        var ids = await SeedLibraryAsync(5);
+        var storage = new CountingStorage(CreateStorage());
+        var manager = CreateManager(storage);
+
+        var metadata = (await manager.GetScriptMetadataAsync()).ToList();
+        await manager.RegisterAllScriptHotkeysAsync();
+        var nameTaken = !await manager.IsValidScriptNameAsync("Script 3");
+        var count = await manager.GetScriptCountAsync();
+
+        Assert.Equal(ids, metadata.Select(m => m.Id).ToArray());
+        Assert.Equal("msleep(10) -- 3".Length, metadata[3].SourceTextLength);
+        Assert.Equal(VirtualKey.VK_F1, metadata[0].TriggerHotkey!.Key);
+        Assert.True(nameTaken);
+        Assert.Equal(5, count);
+        Assert.Equal(0, storage.FullLoads);
+        Assert.Equal(0, storage.SingleLoads);
+    }
+
+    [Fact]
+    public async Task GetScriptAsync_LoadsOnceThenServesFromCache()
+    {
+        var ids = await SeedLibraryAsync(3);
+        var storage = new CountingStorage(CreateStorage());
+        var manager = CreateManager(storage);
+
+        var first = await manager.GetScriptAsync(ids[1]);
+        var second = await manager.GetScriptAsync(ids[1]);
+
+        Assert.NotNull(first);
+        Assert.Same(first, second);
+        Assert.Equal("msleep(10) -- 1", first!.SourceText);
+        Assert.Equal(1, storage.SingleLoads);
+        Assert.Equal(0, storage.FullLoads);
+    }
+
+    [Fact]
+    public async Task GetScriptAsync_EvictsLeastRecentlyUsedBody()
+    {
+        var ids = await SeedLibraryAsync(3);
+        var storage = new CountingStorage(CreateStorage());
+        var manager = CreateManager(storage, maxCachedScripts: 2);
+
+        await manager.GetScriptAsync(ids[0]);
+        await manager.GetScriptAsync(ids[1]);
+        await manager.GetScriptAsync(ids[0]); // ids[1] is now least recently used
+        await manager.GetScriptAsync(ids[2]);
+
+        Assert.Equal(2, manager.CachedScriptCount);
+        Assert.Equal(3, storage.SingleLoads);
+
+        await manager.GetScriptAsync(ids[0]);
+        Assert.Equal(3, storage.SingleLoads);
+
+        await manager.GetScriptAsync(ids[1]);
+        Assert.Equal(4, storage.SingleLoads);
+    }
+
+    [Fact]
+    public async Task UpdateScriptAsync_RefreshesMetadataWithoutReloadingLibrary()
+    {
+        var ids = await SeedLibraryAsync(2);
+        var storage = new CountingStorage(CreateStorage());
+        var manager = CreateManager(storage);
+
+        var script = await manager.GetScriptAsync(ids[1]);
+        script!.SourceText = "move(1, 1)";
+        await manager.UpdateScriptAsync(script);
+
+        var metadata = (await CreateStorage().LoadScriptMetadataAsync()).Single(m => m.Id == ids[1]);
+        Assert.Equal("move(1, 1)".Length, metadata.SourceTextLength);
+        Assert.Equal(script.ModifiedAt, metadata.ModifiedAt);
+        Assert.Equal(0, storage.FullLoads);
+    }
+
+    private JsonFileStorageService CreateStorage() => new(NullLogger<JsonFileStorageService>.Instance, _tempDir);
+
+    private static ScriptManager CreateManager(IFileStorageService storage, int maxCachedScripts = ScriptManager.DefaultMaxCachedScripts)
+    {
+        return new ScriptManager(storage, new Mock<IScriptHotkeyHookService>().Object, NullLogger<ScriptManager>.Instance, maxCachedScripts);
+    }
+
+    private async Task<Guid[]> SeedLibraryAsync(int count)
+    {
+        var storage = CreateStorage();
+        var ids = new Guid[count];
+        for (var i = 0; i < count; i++)
+        {
+            var script = new Script($"Script {i}") { SourceText = $"msleep(10) -- {i}" };
+            if (i == 0)
+                script.TriggerHotkey = HotkeyDefinition.Create("Trigger", HotkeyModifiers.None, VirtualKey.VK_F1, HotkeyTriggerMode.Once);
+
+            await storage.SaveScriptAsync(script);
+            ids[i] = script.Id;
+        }
+
+        return ids;
+    }
+
+    /// <summary>
+    /// Storage decorator that counts body loads.
+    /// </summary>
+    private sealed class CountingStorage : IFileStorageService
+    {
+        private readonly IFileStorageService _inner;
+
+        public CountingStorage(IFileStorageService inner) => _inner = inner;
+
+        public int FullLoads { get; private set; }
+
+        public int SingleLoads { get; private set; }
+
+        public Task<IEnumerable<Script>> LoadScriptsAsync()
+        {
+            FullLoads++;
+            return _inner.LoadScriptsAsync();
+        }
+
+        public Task<IEnumerable<ScriptMetadata>> LoadScriptMetadataAsync() => _inner.LoadScriptMetadataAsync();
+
+        public Task<Script?> LoadScriptAsync(Guid id)
+        {
+            SingleLoads++;
+            return _inner.LoadScriptAsync(id);
+        }
+
+        public Task SaveScriptAsync(Script script) => _inner.SaveScriptAsync(script);
+
+        public Task<bool> DeleteScriptAsync(Guid id) => _inner.DeleteScriptAsync(id);
+
+        public Task<Script> ImportScriptAsync(string filePath) => _inner.ImportScriptAsync(filePath);
+
+        public Task ExportScriptAsync(Script script, string filePath) => _inner.ExportScriptAsync(script, filePath);
+    }
+}
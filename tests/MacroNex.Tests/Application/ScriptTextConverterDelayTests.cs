@@ -54,5 +54,41 @@ public class ScriptTextConverterDelayTests
 
         Assert.Contains("msleep(124)", text, StringComparison.Ordinal);
     }
-}
 
+    [Fact]
+    public void CommandsToText_WithPackedRelativeMoves_EmitsMoveStreamWithPerSampleDelays()
+    {
+        var commands = new Command[]
+        {
+            new MouseMoveRelativeCommand(1, 2) { Delay = TimeSpan.FromMilliseconds(5) },
+            new MouseMoveRelativeCommand(-3, 4) { Delay = TimeSpan.FromMilliseconds(1) },
+            new KeyPressCommand(VirtualKey.VK_A, isDown: true)
+        };
+
+        var text = ScriptTextConverter.CommandsToText(commands, packRelativeMoves: true);
+
+        Assert.Contains("move_stream({1, 2, 5, -3, 4, 1})", text, StringComparison.Ordinal);
+        Assert.DoesNotContain("move_rel(", text, StringComparison.Ordinal);
+        Assert.DoesNotContain("msleep(", text, StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void Parse_MoveStream_ExpandsToRelativeMovesWithDelays()
+    {
+        var commands = ScriptTextConverter.Parse("move_stream({1, 2, 5, -3, 4, 1})");
+
+        Assert.Collection(commands,
+            c =>
+            {
+                var move = Assert.IsType<MouseMoveRelativeCommand>(c);
+                Assert.Equal((1, 2), (move.DeltaX, move.DeltaY));
+                Assert.Equal(TimeSpan.FromMilliseconds(5), move.Delay);
+            },
+            c =>
+            {
+                var move = Assert.IsType<MouseMoveRelativeCommand>(c);
+                Assert.Equal((-3, 4), (move.DeltaX, move.DeltaY));
+                Assert.Equal(TimeSpan.FromMilliseconds(1), move.Delay);
+            });
+    }
+}
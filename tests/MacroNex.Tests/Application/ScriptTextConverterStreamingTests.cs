@@ -0,0 +1,177 @@
+using System.Text;
+using MacroNex.Application.Services;
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
+using Xunit;
+
+namespace MacroNex.Tests.Application;
+
+public class ScriptTextConverterStreamingTests
+{
+    [Fact]
+    public void WriteCommands_MatchesCommandsToText()
+    {
+        var commands = CreateMixedCommands(200);
+
+        using var writer = new StringWriter();
+        ScriptTextConverter.WriteCommands(writer, commands, packRelativeMoves: true);
+
+        Assert.Equal(ScriptTextConverter.CommandsToText(commands, packRelativeMoves: true), writer.ToString());
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public void CommandsToText_CommandBuffer_MatchesCommandObjects(bool packRelativeMoves)
+    {
+        var commands = CreateMixedCommands(200);
+        commands.Add(new KeyboardCommand(new[] { VirtualKey.VK_CONTROL, VirtualKey.VK_C }));
+        Assert.True(CommandBuffer.TryCreate(commands, out var buffer));
+
+        Assert.Equal(
+            ScriptTextConverter.CommandsToText(commands, packRelativeMoves),
+            ScriptTextConverter.CommandsToText(buffer, packRelativeMoves));
+    }
+
+    [Fact]
+    public async Task WriteCommandsAsync_MatchesCommandsToText()
+    {
+        // Enough commands to cross the staging threshold several times
+        var commands = CreateMixedCommands(5000);
+
+        using var writer = new StringWriter();
+        await ScriptTextConverter.WriteCommandsAsync(writer, ToAsync(commands), packRelativeMoves: true);
+
+        Assert.Equal(ScriptTextConverter.CommandsToText(commands, packRelativeMoves: true), writer.ToString());
+    }
+
+    [Fact]
+    public void CommandsToText_RunLongerThanOneStream_SplitsAndKeepsTrailingSampleAsStream()
+    {
+        var commands = Enumerable.Range(0, ScriptTextConverter.MaxSamplesPerMotionStream + 1)
+            .Select(_ => (Command)new MouseMoveRelativeCommand(1, 0))
+            .ToList();
+
+        var text = ScriptTextConverter.CommandsToText(commands, packRelativeMoves: true);
+
+        var lines = text.Split(Environment.NewLine, StringSplitOptions.RemoveEmptyEntries);
+        Assert.Equal(2, lines.Length);
+        Assert.Equal("move_stream({1, 0, 0})", lines[1]);
+    }
+
+    [Fact]
+    public void ReadCommands_MatchesParse()
+    {
+        var text = ScriptTextConverter.CommandsToText(CreateMixedCommands(500), packRelativeMoves: true);
+
+        var streamed = ScriptTextConverter.ReadCommands(new StringReader(text)).ToList();
+        var parsed = ScriptTextConverter.Parse(text);
+
+        Assert.Equal(Describe(parsed), Describe(streamed));
+    }
+
+    [Fact]
+    public async Task ReadCommandsAsync_LinesLongerThanBuffer_AreParsedWhole()
+    {
+        var longText = new string('x', 10_000);
+        var text = $"move(1, 2)\r\ntype_text('{longText}')\nkey_down('a')";
+
+        var commands = new List<Command>();
+        await foreach (var command in ScriptTextConverter.ReadCommandsAsync(new StringReader(text)))
+        {
+            commands.Add(command);
+        }
+
+        Assert.Equal(3, commands.Count);
+        Assert.Equal(longText, Assert.IsType<KeyboardCommand>(commands[1]).Text);
+        Assert.Equal(VirtualKey.VK_A, Assert.IsType<KeyPressCommand>(commands[2]).Key);
+    }
+
+    [Fact]
+    public void ReadCommands_YieldsCommandsBeforeReachingInvalidLine()
+    {
+        var text = "move(1, 2)\n# comment\nbogus()\n";
+
+        using var commands = ScriptTextConverter.ReadCommands(new StringReader(text)).GetEnumerator();
+
+        Assert.True(commands.MoveNext());
+        Assert.IsType<MouseMoveCommand>(commands.Current);
+        var ex = Assert.Throws<FormatException>(() => commands.MoveNext());
+        Assert.StartsWith("Error on line 3:", ex.Message);
+    }
+
+    [Theory]
+    [InlineData("move(1,,2)", 1, 2)]
+    [InlineData("  MOVE ( 3 , 4 )  # trailing", 3, 4)]
+    public void Parse_MoveArguments_TrimsAndSkipsEmptyEntries(string line, int x, int y)
+    {
+        var move = Assert.IsType<MouseMoveCommand>(Assert.Single(ScriptTextConverter.Parse(line)));
+
+        Assert.Equal(new Point(x, y), move.Position);
+    }
+
+    [Theory]
+    [InlineData("move(1, 2, 3)", "Expected two arguments for move(x, y).")]
+    [InlineData("move(a, 2)", "Invalid integer arguments for move(x, y).")]
+    [InlineData("move_relx(1, 2)", "Expected function name 'move_rel', got 'move_relx'.")]
+    [InlineData("move_stream({1, 2})", "move_stream expects a non-empty list of dx, dy, dt triples.")]
+    [InlineData("mouse_click('Side')", "Unsupported mouse button 'side'. Expected 'left', 'right', or 'middle'.")]
+    [InlineData("key_down('??')", "Unsupported key '??'.")]
+    public void Parse_InvalidLine_ReportsLineAndReason(string line, string reason)
+    {
+        var ex = Assert.Throws<FormatException>(() => ScriptTextConverter.Parse("\n" + line));
+
+        Assert.Equal($"Error on line 2: {reason}", ex.Message);
+    }
+
+    [Fact]
+    public void Parse_EscapedQuotes_RoundTrip()
+    {
+        var text = ScriptTextConverter.CommandsToText(new Command[] { new KeyboardCommand("it's 'quoted'") });
+
+        var keyboard = Assert.IsType<KeyboardCommand>(Assert.Single(ScriptTextConverter.Parse(text)));
+
+        Assert.Equal("it's 'quoted'", keyboard.Text);
+    }
+
+    private static List<Command> CreateMixedCommands(int groups)
+    {
+        var commands = new List<Command>();
+        for (var i = 0; i < groups; i++)
+        {
+            commands.Add(new MouseMoveCommand(new Point(i, i * 2)) { Delay = TimeSpan.FromMilliseconds(i % 7) });
+            for (var j = 0; j < i % 40; j++)
+            {
+                commands.Add(new MouseMoveRelativeCommand(j - 20, 20 - j) { Delay = TimeSpan.FromMilliseconds(j % 3) });
+            }
+            commands.Add(new MouseClickCommand(MouseButton.Left, ClickType.Click));
+            commands.Add(new KeyPressCommand(VirtualKey.VK_A + (i % 26), isDown: true));
+            commands.Add(new KeyboardCommand($"text {i}"));
+            commands.Add(new SleepCommand(TimeSpan.FromMilliseconds(i)));
+        }
+
+        return commands;
+    }
+
+    private static async IAsyncEnumerable<Command> ToAsync(IEnumerable<Command> commands)
+    {
+        foreach (var command in commands)
+        {
+            yield return command;
+        }
+
+        await Task.Yield();
+    }
+
+    private static List<string> Describe(IEnumerable<Command> commands) =>
+        commands.Select(c => c switch
+        {
+            MouseMoveCommand m => $"move {m.Position.X} {m.Position.Y}",
+            MouseMoveRelativeCommand r => $"rel {r.DeltaX} {r.DeltaY} {r.Delay.TotalMilliseconds}",
+            MouseClickCommand k => $"click {k.Button} {k.Type}",
+            KeyPressCommand p => $"key {p.Key} {p.IsDown}",
+            KeyboardCommand t => $"text {t.Text}",
+            SleepCommand s => $"sleep {s.Duration.TotalMilliseconds}",
+            _ => c.GetType().Name
+        }).ToList();
+}
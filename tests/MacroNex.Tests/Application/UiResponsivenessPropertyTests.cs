@@ -99,6 +99,8 @@ public class UiResponsivenessPropertyTests
         public Task SimulateMouseMoveLowLevelAsync(Point position) => Task.CompletedTask;
         public Task SimulateMouseMoveRelativeAsync(int deltaX, int deltaY) => Task.CompletedTask;
         public Task SimulateMouseMoveRelativeLowLevelAsync(int deltaX, int deltaY) => Task.CompletedTask;
+        public Task SimulateMouseMotionAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
+        public Task SimulateMouseMotionLowLevelAsync(IReadOnlyList<MotionSample> samples) => Task.CompletedTask;
         public Task SimulateMouseClickAsync(MouseButton button, ClickType type) => Task.CompletedTask;
         public Task SimulateKeyboardInputAsync(string text) => Task.CompletedTask;
         public Task SimulateKeyPressAsync(VirtualKey key, bool isKeyDown) => Task.CompletedTask;
@@ -106,6 +108,9 @@ public class UiResponsivenessPropertyTests
         public Task DelayAsync(TimeSpan delay) => Task.CompletedTask;
         public Task<Point> GetCursorPositionAsync() => Task.FromResult(Point.Zero);
         public Task<bool> IsReadyAsync() => Task.FromResult(true);
+        public IInputBatch BeginBatch() => ImmediateInputBatch.Instance;
+
+        public Task ReleaseAllAsync() => Task.CompletedTask;
     }
 
     private sealed class FakeInputSimulatorFactory : IInputSimulatorFactory
@@ -129,6 +134,7 @@ public class UiResponsivenessPropertyTests
         public ArduinoConnectionState ConnectionState => ArduinoConnectionState.Disconnected;
         public bool IsConnected => false;
         public string? ConnectedPortName => null;
+        public ArduinoFirmwareCapabilities Capabilities => ArduinoFirmwareCapabilities.None;
 
 #pragma warning disable CS0067 // Events are required by IArduinoService but not used in this test double.
         public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
@@ -140,6 +146,10 @@ public class UiResponsivenessPropertyTests
         public Task ConnectAsync(string portName) => Task.CompletedTask;
         public Task DisconnectAsync() => Task.CompletedTask;
         public Task SendCommandAsync(ArduinoCommand command) => Task.CompletedTask;
+        public Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands) => Task.CompletedTask;
+        public Task FlushAsync() => Task.CompletedTask;
+
+        public Task EmergencyStopAsync() => Task.CompletedTask;
     }
 }
 
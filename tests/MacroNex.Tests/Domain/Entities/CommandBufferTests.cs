@@ -0,0 +1,155 @@
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+
+namespace MacroNex.Tests.Domain.Entities;
+
+/// <summary>
+/// Unit tests for the struct-of-arrays command storage and compact scripts.
+/// </summary>
+public class CommandBufferTests
+{
+    [Fact]
+    public void TryCreate_EveryCommandType_RoundTripsThroughRecords()
+    {
+        var commands = CreateCommands();
+
+        Assert.True(CommandBuffer.TryCreate(commands, out var buffer));
+        var restored = buffer.ToCommandList();
+
+        Assert.Equal(commands.Count, buffer.Count);
+        Assert.Equal(commands.Select(c => c.ToString()).ToArray(), restored.Select(c => c.ToString()).ToArray());
+        Assert.Equal(commands.Select(c => c.Delay).ToArray(), restored.Select(c => c.Delay).ToArray());
+        Assert.Equal(TimeSpan.FromMinutes(90), ((SleepCommand)restored[5]).Duration);
+        Assert.Equal(new[] { VirtualKey.VK_CONTROL, VirtualKey.VK_V }, ((KeyboardCommand)restored[6]).Keys.ToArray());
+    }
+
+    [Fact]
+    public void Enumerator_ReadsColumnsInPlace()
+    {
+        var buffer = new CommandBuffer();
+        buffer.Add(CommandRecord.MouseMoveRelative(3, -4, TimeSpan.FromMilliseconds(2)));
+        buffer.Add(CommandRecord.KeyPress(VirtualKey.VK_A, isDown: true));
+
+        var opcodes = new List<CommandOpcode>();
+        foreach (var record in buffer)
+        {
+            opcodes.Add(record.Opcode);
+        }
+
+        Assert.Equal(new[] { CommandOpcode.MouseMoveRelative, CommandOpcode.KeyPress }, opcodes.ToArray());
+        Assert.Equal(new[] { 3, (int)VirtualKey.VK_A }, buffer.X.ToArray());
+        Assert.Equal(TimeSpan.FromMilliseconds(2).Ticks, buffer.DelayTicks[0]);
+    }
+
+    [Fact]
+    public void Add_KeyboardRecord_CopiesKeys()
+    {
+        var command = new KeyboardCommand(VirtualKey.VK_A);
+        var buffer = new CommandBuffer();
+        Assert.True(buffer.TryAdd(command));
+
+        command.Keys.Add(VirtualKey.VK_B);
+
+        Assert.Equal(new[] { VirtualKey.VK_A }, buffer[0].Keys.ToArray());
+    }
+
+    [Fact]
+    public void FromColumns_KeyboardWithoutPayload_Throws()
+    {
+        Assert.Throws<ArgumentException>(() => CommandBuffer.FromColumns(
+            new[] { CommandOpcode.Keyboard }, new[] { 0 }, new[] { 0 }, new[] { 0L }, 1,
+            Array.Empty<(string?, IReadOnlyList<VirtualKey>)>()));
+    }
+
+    [Fact]
+    public void Script_Compact_StaysCompactWhileAppendingAndClearing()
+    {
+        var script = new Script("Recording");
+        script.AddCommand(new MouseMoveRelativeCommand(1, 1));
+
+        Assert.True(script.Compact());
+        script.AddCommand(new MouseMoveRelativeCommand(2, 2));
+
+        Assert.True(script.IsCompact);
+        Assert.Equal(2, script.CommandCount);
+        Assert.True(script.IsValid());
+        Assert.True(script.Duplicate("Copy").IsCompact);
+
+        script.ClearCommands();
+        Assert.True(script.IsCompact);
+        Assert.Equal(0, script.CommandCount);
+    }
+
+    [Fact]
+    public void Script_ObjectAccess_UnpacksOnce()
+    {
+        Assert.True(CommandBuffer.TryCreate(CreateCommands(), out var buffer));
+        var script = new Script(Guid.NewGuid(), "Packed", buffer, DateTime.UtcNow, DateTime.UtcNow);
+
+        var first = script.GetCommand(0);
+
+        Assert.False(script.IsCompact);
+        Assert.Same(first, script.Commands[0]);
+        Assert.Equal(0, script.IndexOf(first));
+    }
+
+    [Fact]
+    public void Script_ConcurrentObjectAccess_UnpacksOnce()
+    {
+        Assert.True(CommandBuffer.TryCreate(Enumerable.Repeat<Command>(new MouseMoveRelativeCommand(1, 1), 10_000), out var buffer));
+        var script = new Script(Guid.NewGuid(), "Packed", buffer, DateTime.UtcNow, DateTime.UtcNow);
+
+        var firsts = new Command[8];
+        Parallel.For(0, firsts.Length, i => firsts[i] = script.Commands[0]);
+
+        Assert.False(script.IsCompact);
+        Assert.All(firsts, command => Assert.Same(script.GetCommand(0), command));
+        Assert.Equal(10_000, script.CommandCount);
+    }
+
+    [Fact]
+    public void RecordingSession_CopyCommandBuffer_MatchesRecordedCommands()
+    {
+        var session = new RecordingSession(new RecordingOptions());
+        foreach (var command in CreateCommands())
+        {
+            session.AddCommand(command);
+        }
+
+        var buffer = session.CopyCommandBuffer();
+
+        Assert.NotNull(buffer);
+        Assert.Equal(session.CommandCount, buffer!.Count);
+        Assert.True(CommandBuffer.TryCreate(CreateCommands(), out var expected));
+        Assert.Equal(expected.Opcodes.ToArray(), buffer.Opcodes.ToArray());
+        Assert.Equal(expected.X.ToArray(), buffer.X.ToArray());
+        Assert.Equal(expected.Y.ToArray(), buffer.Y.ToArray());
+
+        session.ClearCommands();
+        Assert.Equal(0, session.CommandCount);
+        Assert.Equal(CreateCommands().Count, buffer.Count);
+    }
+
+    [Fact]
+    public void Script_RemoveForeignCommandFromCompactScript_KeepsItCompact()
+    {
+        var script = new Script("Recording");
+        script.AddCommand(new MouseMoveRelativeCommand(1, 1));
+        script.Compact();
+
+        Assert.False(script.RemoveCommand(new MouseMoveRelativeCommand(1, 1)));
+        Assert.True(script.IsCompact);
+    }
+
+    internal static List<Command> CreateCommands() => new()
+    {
+        new MouseMoveCommand(new Point(100, 200)) { Delay = TimeSpan.FromMilliseconds(5) },
+        new MouseMoveRelativeCommand(-7, 12) { Delay = TimeSpan.FromTicks(12345) },
+        new MouseClickCommand(MouseButton.Right, ClickType.Down),
+        new KeyPressCommand(VirtualKey.VK_SHIFT, isDown: false),
+        new KeyboardCommand("héllo 'world'"),
+        new SleepCommand(TimeSpan.FromMinutes(90)),
+        new KeyboardCommand(new[] { VirtualKey.VK_CONTROL, VirtualKey.VK_V })
+    };
+}
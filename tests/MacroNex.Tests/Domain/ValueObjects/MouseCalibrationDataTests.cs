@@ -0,0 +1,81 @@
+using MacroNex.Domain.ValueObjects;
+using Xunit;
+
+namespace MacroNex.Tests.Domain.ValueObjects;
+
+/// <summary>
+/// Unit tests for the compiled calibration lookup tables.
+/// </summary>
+public class MouseCalibrationDataTests
+{
+    private static MouseCalibrationData CreateAcceleratedCalibration()
+    {
+        var data = new MouseCalibrationData
+        {
+            PointsX =
+            {
+                new CalibrationPoint { HidDelta = 5, ActualPixelDelta = 4 },
+                new CalibrationPoint { HidDelta = 20, ActualPixelDelta = 22 },
+                new CalibrationPoint { HidDelta = 50, ActualPixelDelta = 70 },
+                new CalibrationPoint { HidDelta = 100, ActualPixelDelta = 165 }
+            },
+            PointsY =
+            {
+                new CalibrationPoint { HidDelta = 10, ActualPixelDelta = 10 },
+                new CalibrationPoint { HidDelta = 100, ActualPixelDelta = 100 }
+            }
+        };
+        return data;
+    }
+
+    [Fact]
+    public void FitPolynomial_BuildsLookupTables()
+    {
+        var data = CreateAcceleratedCalibration();
+
+        data.FitPolynomial();
+
+        Assert.True(data.HasLookupTables);
+    }
+
+    [Fact]
+    public void LookupTables_MatchDirectCalculationInBothDirections()
+    {
+        var direct = CreateAcceleratedCalibration();
+        direct.FitPolynomial();
+        direct.InvalidateLookupTables();
+        var compiled = CreateAcceleratedCalibration();
+        compiled.FitPolynomial();
+
+        foreach (var delta in new[] { -4096, -500, -37, -1, 0, 1, 2, 13, 99, 250, 1000, 4096 })
+        {
+            Assert.Equal(direct.CalculateHidDelta(delta), compiled.CalculateHidDelta(delta));
+            Assert.Equal(direct.CalculateHidDelta(delta, useYAxis: true), compiled.CalculateHidDelta(delta, useYAxis: true));
+            Assert.Equal(direct.CalculatePixelDelta(delta), compiled.CalculatePixelDelta(delta));
+            Assert.Equal(direct.CalculatePixelDelta(delta, useYAxis: true), compiled.CalculatePixelDelta(delta, useYAxis: true));
+        }
+    }
+
+    [Fact]
+    public void CalculateHidDelta_OutsideTableRange_FallsBackToCalculation()
+    {
+        var data = CreateAcceleratedCalibration();
+        data.BuildLookupTables();
+        var reference = CreateAcceleratedCalibration();
+
+        const int beyond = MouseCalibrationData.LookupTableRange + 10;
+
+        Assert.Equal(reference.CalculateHidDelta(beyond), data.CalculateHidDelta(beyond));
+        Assert.Equal(reference.CalculateHidDelta(12.5), data.CalculateHidDelta(12.5));
+    }
+
+    [Fact]
+    public void CalculateHidDelta_WithoutPoints_MapsOneToOne()
+    {
+        var data = new MouseCalibrationData();
+        data.BuildLookupTables();
+
+        Assert.Equal(-42, data.CalculateHidDelta(-42));
+        Assert.Equal(42.0, data.CalculatePixelDelta(42));
+    }
+}
@@ -0,0 +1,286 @@
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Adapters;
+using Microsoft.Extensions.Logging.Abstractions;
+using Xunit;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for routing commands across a pool of Arduino devices.
+/// </summary>
+public class ArduinoDevicePoolTests
+{
+    private readonly List<FakeDevice> _devices = new();
+    private readonly List<string> _log = new();
+
+    [Fact]
+    public async Task SplitMouseKeyboard_RoutesMouseAndKeyboardToSeparateDevices()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+
+        await pool.SendCommandAsync(new ArduinoMouseMoveRelativeCommand(5, 0));
+        await pool.SendCommandAsync(new ArduinoKeyPressCommand(VirtualKey.VK_A, true));
+        await pool.SendCommandAsync(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Click));
+
+        Assert.Equal(new[] { ArduinoCommandType.MouseMoveRelative, ArduinoCommandType.MouseClick }, _devices[0].Sent.ToArray());
+        Assert.Equal(new[] { ArduinoCommandType.KeyPress }, _devices[1].Sent.ToArray());
+    }
+
+    [Fact]
+    public async Task SplitMouseKeyboard_HonoursConfiguredPorts()
+    {
+        using var pool = CreatePool();
+        pool.Routing = new ArduinoRoutingOptions { MousePortName = "COM4", KeyboardPortName = "COM3" };
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+
+        await pool.SendCommandAsync(new ArduinoMouseMoveRelativeCommand(1, 1));
+        await pool.SendCommandAsync(new ArduinoKeyboardTextCommand("a"));
+
+        Assert.Equal(new[] { ArduinoCommandType.KeyboardText }, _devices[0].Sent.ToArray());
+        Assert.Equal(new[] { ArduinoCommandType.MouseMoveRelative }, _devices[1].Sent.ToArray());
+
+        var health = pool.GetHealth();
+        Assert.Equal(ArduinoDeviceRoles.Keyboard, health.Devices[0].Roles);
+        Assert.Equal(ArduinoDeviceRoles.Mouse, health.Devices[1].Roles);
+    }
+
+    [Fact]
+    public async Task SplitMouseKeyboard_WithOneDevice_SendsBatchAsOneWrite()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+
+        await pool.SendCommandsAsync(new ArduinoCommand[]
+        {
+            new ArduinoMouseMoveRelativeCommand(1, 0),
+            new ArduinoKeyPressCommand(VirtualKey.VK_A, true),
+            new ArduinoKeyPressCommand(VirtualKey.VK_A, false)
+        });
+
+        Assert.Equal(1, _devices[0].BatchCount);
+        Assert.Equal(3, _devices[0].Sent.Count);
+    }
+
+    [Fact]
+    public async Task SwitchingDevices_FlushesPreviousDeviceFirst()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+
+        await pool.SendCommandAsync(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Click));
+        await pool.SendCommandAsync(new ArduinoKeyboardTextCommand("hello"));
+
+        Assert.Equal(new[] { "COM3:send:MouseClick", "COM3:flush", "COM4:send:KeyboardText" }, _log.ToArray());
+    }
+
+    [Fact]
+    public async Task RoundRobin_RelativeMovesRunInParallelWithoutFlushing()
+    {
+        using var pool = CreatePool();
+        pool.Routing = new ArduinoRoutingOptions { Mode = ArduinoRoutingMode.RoundRobin };
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+
+        for (var i = 0; i < 4; i++)
+        {
+            await pool.SendCommandAsync(new ArduinoMouseMoveRelativeCommand(1, 0));
+        }
+
+        Assert.Equal(2, _devices[0].Sent.Count);
+        Assert.Equal(2, _devices[1].Sent.Count);
+        Assert.False(_log.Any(entry => entry.EndsWith(":flush", StringComparison.Ordinal)));
+
+        // A click must not overtake the moves still queued on the other device
+        await pool.SendCommandAsync(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Click));
+        Assert.Equal("COM4:flush", _log[^2]);
+        Assert.Equal("COM3:send:MouseClick", _log[^1]);
+    }
+
+    [Fact]
+    public async Task DeviceDropout_FailsOverAndReportsDegradedHealth()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+
+        _devices[1].Fail("Arduino firmware is not responding to heartbeat");
+        await pool.SendCommandAsync(new ArduinoKeyPressCommand(VirtualKey.VK_A, true));
+
+        Assert.Equal(new[] { ArduinoCommandType.KeyPress }, _devices[0].Sent.ToArray());
+
+        var health = pool.GetHealth();
+        Assert.Equal(ArduinoConnectionState.Connected, health.State);
+        Assert.Equal(1, health.ConnectedCount);
+        Assert.True(health.IsDegraded);
+        Assert.True(health.Devices[0].IsPrimary);
+        Assert.Equal(ArduinoConnectionState.Error, health.Devices[1].State);
+        Assert.Equal("Arduino firmware is not responding to heartbeat", health.Devices[1].LastError);
+        Assert.Equal(ArduinoDeviceRoles.Mouse | ArduinoDeviceRoles.Keyboard, health.Devices[0].Roles);
+        Assert.Equal(ArduinoDeviceRoles.None, health.Devices[1].Roles);
+    }
+
+    [Fact]
+    public async Task ConnectionStateChanged_ReportsAggregateTransitionsOnly()
+    {
+        using var pool = CreatePool();
+        var changes = new List<ArduinoConnectionState>();
+        pool.ConnectionStateChanged += (_, e) => changes.Add(e.NewState);
+
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+        await pool.DisconnectAsync("COM3");
+
+        Assert.Equal(new[] { "COM4" }, pool.ConnectedPortNames.ToArray());
+        Assert.Equal(new[] { ArduinoConnectionState.Connecting, ArduinoConnectionState.Connected }, changes.ToArray());
+
+        await pool.DisconnectAsync();
+        Assert.Equal(ArduinoConnectionState.Disconnected, changes[^1]);
+        Assert.False(pool.IsConnected);
+    }
+
+    [Fact]
+    public async Task Capabilities_AreThoseEveryConnectedDeviceReports()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+        _devices[0].Capabilities = ArduinoFirmwareCapabilities.MotionStream;
+
+        Assert.Equal(ArduinoFirmwareCapabilities.MotionStream, pool.Capabilities);
+
+        await pool.ConnectAsync("COM4");
+        Assert.Equal(ArduinoFirmwareCapabilities.None, pool.Capabilities);
+    }
+
+    [Fact]
+    public async Task EmergencyStopAsync_StopsEveryConnectedDevice()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+        await pool.ConnectAsync("COM4");
+        await pool.ConnectAsync("COM5");
+        await pool.DisconnectAsync("COM4");
+
+        await pool.EmergencyStopAsync();
+
+        Assert.Equal(new[] { "COM3:emergency", "COM5:emergency" }, _log.ToArray());
+    }
+
+    [Fact]
+    public async Task ConnectAsync_SamePortTwice_Throws()
+    {
+        using var pool = CreatePool();
+        await pool.ConnectAsync("COM3");
+
+        await Assert.ThrowsAsync<InvalidOperationException>(() => pool.ConnectAsync("com3"));
+    }
+
+    [Fact]
+    public async Task SendCommandAsync_WhenNoDeviceConnected_Throws()
+    {
+        using var pool = CreatePool();
+
+        await Assert.ThrowsAsync<InvalidOperationException>(() => pool.SendCommandAsync(new ArduinoStatusQueryCommand()));
+    }
+
+    private ArduinoDevicePool CreatePool() =>
+        new(() =>
+        {
+            var device = new FakeDevice(_log);
+            _devices.Add(device);
+            return device;
+        }, NullLogger<ArduinoDevicePool>.Instance);
+
+    private sealed class FakeDevice : IArduinoService
+    {
+        private readonly List<string> _log;
+        private ArduinoConnectionState _state = ArduinoConnectionState.Disconnected;
+
+        public FakeDevice(List<string> log)
+        {
+            _log = log;
+        }
+
+        public List<ArduinoCommandType> Sent { get; } = new();
+
+        public int BatchCount { get; private set; }
+
+        public ArduinoConnectionState ConnectionState => _state;
+
+        public bool IsConnected => _state == ArduinoConnectionState.Connected;
+
+        public string? ConnectedPortName { get; private set; }
+
+        public ArduinoFirmwareCapabilities Capabilities { get; set; }
+
+        public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
+#pragma warning disable CS0067 // Events are required by IArduinoService but not used in this test double.
+        public event EventHandler<ArduinoEventReceivedEventArgs>? EventReceived;
+#pragma warning restore CS0067
+        public event EventHandler<ArduinoErrorEventArgs>? ErrorOccurred;
+
+        public Task<IReadOnlyList<string>> GetAvailablePortsAsync() =>
+            Task.FromResult<IReadOnlyList<string>>(new[] { "COM3", "COM4" });
+
+        public Task ConnectAsync(string portName)
+        {
+            ConnectedPortName = portName;
+            SetState(ArduinoConnectionState.Connecting);
+            SetState(ArduinoConnectionState.Connected);
+            return Task.CompletedTask;
+        }
+
+        public Task DisconnectAsync()
+        {
+            SetState(ArduinoConnectionState.Disconnected);
+            return Task.CompletedTask;
+        }
+
+        public Task SendCommandAsync(ArduinoCommand command)
+        {
+            _log.Add($"{ConnectedPortName}:send:{command.CommandType}");
+            Sent.Add(command.CommandType);
+            return Task.CompletedTask;
+        }
+
+        public Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands)
+        {
+            BatchCount++;
+            foreach (var command in commands)
+            {
+                _log.Add($"{ConnectedPortName}:send:{command.CommandType}");
+                Sent.Add(command.CommandType);
+            }
+            return Task.CompletedTask;
+        }
+
+        public Task FlushAsync()
+        {
+            _log.Add($"{ConnectedPortName}:flush");
+            return Task.CompletedTask;
+        }
+
+        public Task EmergencyStopAsync()
+        {
+            _log.Add($"{ConnectedPortName}:emergency");
+            return Task.CompletedTask;
+        }
+
+        public void Fail(string message)
+        {
+            ErrorOccurred?.Invoke(this, new ArduinoErrorEventArgs(message));
+            SetState(ArduinoConnectionState.Error);
+        }
+
+        private void SetState(ArduinoConnectionState state)
+        {
+            var previous = _state;
+            _state = state;
+            ConnectionStateChanged?.Invoke(this, new ArduinoConnectionStateChangedEventArgs(previous, state, ConnectedPortName));
+        }
+    }
+}
@@ -0,0 +1,118 @@
+using System.Text;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for keyboard text chunking and the firmware credit window.
+/// </summary>
+public class ArduinoFlowControlTests
+{
+    [Fact]
+    public void Chunk_ShortText_ReturnsSingleCommand()
+    {
+        var commands = ArduinoKeyboardTextChunker.Chunk("hello");
+
+        Assert.Single(commands);
+        Assert.Equal("hello", commands[0].Text);
+    }
+
+    [Fact]
+    public void Chunk_LongText_SplitsWithinBudgetAndPreservesText()
+    {
+        var text = string.Concat(Enumerable.Repeat("The quick brown fox jumps over the lazy dog. ", 20));
+
+        var commands = ArduinoKeyboardTextChunker.Chunk(text, 60);
+
+        Assert.True(commands.Count > 1);
+        Assert.All(commands, c => Assert.True(c.SerializedLength <= 60));
+        Assert.Equal(text, string.Concat(commands.Select(c => c.Text)));
+    }
+
+    [Fact]
+    public void Chunk_NeverSplitsMultiByteCharacters()
+    {
+        // 3-byte CJK characters and 4-byte surrogate pairs
+        var text = string.Concat(Enumerable.Repeat("中文😀", 30));
+
+        var commands = ArduinoKeyboardTextChunker.Chunk(text, 10);
+
+        Assert.All(commands, c =>
+        {
+            Assert.True(c.SerializedLength <= 10);
+            Assert.False(char.IsHighSurrogate(c.Text[^1]));
+            Assert.Equal(c.SerializedLength, Encoding.UTF8.GetByteCount(c.Text));
+        });
+        Assert.Equal(text, string.Concat(commands.Select(c => c.Text)));
+    }
+
+    [Fact]
+    public void DefaultTextBudget_FillsOneUsbPacketAndMatchesTransportDefault()
+    {
+        Assert.Equal(64, ArduinoKeyboardTextChunker.DefaultMaxTextBytes + ArduinoProtocolEncoder.FrameOverhead);
+        Assert.Equal(ArduinoKeyboardTextChunker.DefaultMaxTextBytes, ArduinoTransportOptions.Default().MaxTextChunkBytes);
+    }
+
+    [Fact]
+    public void CreditWindow_BeforeFirstReport_IsUnthrottled()
+    {
+        var window = new ArduinoCreditWindow();
+        window.OnSent(1000);
+
+        Assert.False(window.IsActive);
+        Assert.Equal(int.MaxValue, window.Available);
+    }
+
+    [Fact]
+    public void CreditWindow_TracksBytesInFlightAgainstReports()
+    {
+        var window = new ArduinoCreditWindow();
+        Assert.True(window.ApplyReport(64, 100));
+
+        Assert.Equal(64 - ArduinoCreditWindow.ProbeReserveBytes, window.Available);
+
+        window.OnSent(50);
+        Assert.Equal(50, window.InFlight);
+        Assert.Equal(6, window.Available);
+
+        window.OnSent(6);
+        Assert.Equal(0, window.Available);
+        Assert.True(window.CanProbe(4));
+
+        Assert.True(window.ApplyReport(64, 130));
+        Assert.Equal(26, window.InFlight);
+        Assert.Equal(30, window.Available);
+    }
+
+    [Fact]
+    public void CreditWindow_HandlesWrappingCountAndIgnoresStaleReports()
+    {
+        var window = new ArduinoCreditWindow();
+        window.ApplyReport(64, uint.MaxValue - 9);
+        window.OnSent(40);
+
+        Assert.True(window.ApplyReport(64, 20));
+        Assert.Equal(10, window.InFlight);
+
+        Assert.False(window.ApplyReport(64, uint.MaxValue - 5));
+        Assert.Equal(10, window.InFlight);
+    }
+
+    [Fact]
+    public void CreditWindow_ZeroCapacityOrReset_StopsThrottling()
+    {
+        var window = new ArduinoCreditWindow();
+        window.ApplyReport(64, 0);
+        window.OnSent(64);
+        Assert.Equal(0, window.Available);
+
+        window.ApplyReport(0, 0);
+        Assert.False(window.IsActive);
+        Assert.Equal(int.MaxValue, window.Available);
+
+        window.ApplyReport(64, 0);
+        window.Reset();
+        Assert.False(window.IsActive);
+    }
+}
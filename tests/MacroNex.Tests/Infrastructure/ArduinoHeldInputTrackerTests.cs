@@ -0,0 +1,47 @@
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
+using Xunit;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for tracking the keys and buttons left down by commands sent to the firmware.
+/// </summary>
+public class ArduinoHeldInputTrackerTests
+{
+    [Fact]
+    public void TakeReleaseCommands_ReleasesWhatIsStillDownAndForgetsIt()
+    {
+        var tracker = new ArduinoHeldInputTracker();
+
+        tracker.Observe(new ArduinoKeyPressCommand(VirtualKey.VK_A, true));
+        tracker.Observe(new ArduinoKeyPressCommand(VirtualKey.VK_B, true));
+        tracker.Observe(new ArduinoKeyPressCommand(VirtualKey.VK_A, false));
+        tracker.Observe(new ArduinoMouseClickCommand(MouseButton.Right, ClickType.Down));
+
+        var releases = tracker.TakeReleaseCommands();
+
+        Assert.Equal(2, releases.Count);
+        var key = Assert.IsType<ArduinoKeyPressCommand>(releases[0]);
+        Assert.Equal(VirtualKey.VK_B, key.Key);
+        Assert.False(key.IsDown);
+        var button = Assert.IsType<ArduinoMouseClickCommand>(releases[1]);
+        Assert.Equal(MouseButton.Right, button.Button);
+        Assert.Equal(ClickType.Up, button.ClickType);
+        Assert.Equal(0, tracker.HeldCount);
+    }
+
+    [Fact]
+    public void Observe_ClicksAndText_LeaveNothingHeld()
+    {
+        var tracker = new ArduinoHeldInputTracker();
+
+        tracker.Observe(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Click));
+        tracker.Observe(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Down));
+        tracker.Observe(new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Up));
+        tracker.Observe(new ArduinoKeyboardTextCommand("abc"));
+
+        Assert.Equal(0, tracker.HeldCount);
+        Assert.Empty(tracker.TakeReleaseCommands());
+    }
+}
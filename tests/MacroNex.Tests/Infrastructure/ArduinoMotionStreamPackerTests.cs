@@ -0,0 +1,82 @@
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the motion stream command encoding and the host-side packer.
+/// </summary>
+public class ArduinoMotionStreamPackerTests
+{
+    [Fact]
+    public void Serialize_ThenTryDeserialize_RoundTripsSamples()
+    {
+        var samples = new[]
+        {
+            new MotionSample(1, -1, 1),
+            new MotionSample(-300, 4000, 0),
+            new MotionSample(int.MinValue, int.MaxValue, 65535)
+        };
+        var command = new ArduinoMouseMotionStreamCommand(samples);
+
+        var payload = command.Serialize();
+
+        Assert.Equal(command.SerializedLength, payload.Length);
+        Assert.True(ArduinoMouseMotionStreamCommand.TryDeserialize(payload, out var decoded));
+        Assert.Equal(samples, decoded);
+        Assert.Equal(65536, command.TotalDurationMs);
+    }
+
+    [Fact]
+    public void Serialize_SmallSamples_UseOneBytePerField()
+    {
+        var command = new ArduinoMouseMotionStreamCommand(new[] { new MotionSample(2, -3, 1) });
+
+        // count, zigzag(2)=4, zigzag(-3)=5, 1
+        Assert.Equal(new byte[] { 0x01, 0x04, 0x05, 0x01 }, command.Serialize());
+    }
+
+    [Fact]
+    public void TryDeserialize_WithTruncatedPayload_ReturnsFalse()
+    {
+        var payload = new ArduinoMouseMotionStreamCommand(new[] { new MotionSample(500, 500, 500) }).Serialize();
+
+        Assert.False(ArduinoMouseMotionStreamCommand.TryDeserialize(payload.AsSpan(0, payload.Length - 1), out _));
+    }
+
+    [Fact]
+    public void Constructor_WithNoSamples_Throws()
+    {
+        Assert.Throws<ArgumentException>(() => new ArduinoMouseMotionStreamCommand(Array.Empty<MotionSample>()));
+    }
+
+    [Fact]
+    public void Pack_KeepsEveryFrameWithinOneUsbPacket()
+    {
+        var samples = Enumerable.Range(0, 1000)
+            .Select(i => new MotionSample((i % 7) - 3, (i % 200) - 100, 1))
+            .ToList();
+
+        var commands = ArduinoMotionStreamPacker.Pack(samples);
+
+        Assert.All(commands, c => Assert.True(ArduinoProtocolEncoder.GetEncodedLength(c) <= 64));
+        Assert.Equal(samples, commands.SelectMany(c => c.Samples));
+    }
+
+    [Fact]
+    public void Pack_UsesFewerBytesThanOneRelativeMovePerSample()
+    {
+        var samples = Enumerable.Range(0, 500).Select(_ => new MotionSample(3, -2, 1)).ToList();
+
+        var packedBytes = ArduinoMotionStreamPacker.Pack(samples).Sum(ArduinoProtocolEncoder.GetEncodedLength);
+        var perFrameBytes = samples.Sum(s => ArduinoProtocolEncoder.GetEncodedLength(new ArduinoMouseMoveRelativeCommand(s.DeltaX, s.DeltaY)));
+
+        Assert.True(packedBytes * 2 < perFrameBytes, $"Packed {packedBytes} bytes vs {perFrameBytes} bytes unpacked.");
+    }
+
+    [Fact]
+    public void Pack_WithEmptyInput_ReturnsNoCommands()
+    {
+        Assert.Empty(ArduinoMotionStreamPacker.Pack(Array.Empty<MotionSample>()));
+    }
+}
@@ -0,0 +1,183 @@
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the span-based Arduino protocol encoder and decoder.
+/// </summary>
+public class ArduinoProtocolTests
+{
+    public static IEnumerable<object[]> Commands => new[]
+    {
+        new object[] { new ArduinoMouseMoveAbsoluteCommand(1920, 1080) },
+        new object[] { new ArduinoMouseMoveRelativeCommand(-5, 300) },
+        new object[] { new ArduinoMouseClickCommand(MouseButton.Right, ClickType.Down) },
+        new object[] { new ArduinoKeyboardTextCommand("héllo") },
+        new object[] { new ArduinoKeyPressCommand(VirtualKey.VK_A, true) },
+        new object[] { new ArduinoDelayCommand(123456) },
+        new object[] { new ArduinoStatusQueryCommand() },
+        new object[] { new ArduinoReleaseAllCommand() }
+    };
+
+    [Theory]
+    [MemberData(nameof(Commands))]
+    public void TryEncode_MatchesEncodeCommand(ArduinoCommand command)
+    {
+        var expected = ArduinoProtocolEncoder.EncodeCommand(command);
+        var destination = new byte[expected.Length + 8];
+
+        var success = ArduinoProtocolEncoder.TryEncode(command, destination, out var written);
+
+        Assert.True(success);
+        Assert.Equal(expected.Length, written);
+        Assert.Equal(ArduinoProtocolEncoder.GetEncodedLength(command), written);
+        Assert.Equal(expected, destination.Take(written).ToArray());
+    }
+
+    [Theory]
+    [MemberData(nameof(Commands))]
+    public void Serialize_SpanOverloadMatchesArrayOverload(ArduinoCommand command)
+    {
+        var expected = command.Serialize();
+        var destination = new byte[command.SerializedLength];
+
+        var written = command.Serialize(destination);
+
+        Assert.Equal(expected.Length, written);
+        Assert.Equal(expected, destination);
+    }
+
+    [Fact]
+    public void TryEncode_WithTooSmallDestination_ReturnsFalse()
+    {
+        var command = new ArduinoMouseMoveRelativeCommand(1, 1);
+        var destination = new byte[ArduinoProtocolEncoder.GetEncodedLength(command) - 1];
+
+        var success = ArduinoProtocolEncoder.TryEncode(command, destination, out var written);
+
+        Assert.False(success);
+        Assert.Equal(0, written);
+    }
+
+    [Fact]
+    public void EncodeCommand_MouseMoveRelative_ProducesLittleEndianFrame()
+    {
+        var encoded = ArduinoProtocolEncoder.EncodeCommand(new ArduinoMouseMoveRelativeCommand(-2, 258));
+
+        Assert.Equal(new byte[] { 0x02, 0x04, 0x00, 0xFE, 0xFF, 0x02, 0x01, 0x02 ^ 0x04 ^ 0xFE ^ 0xFF ^ 0x02 ^ 0x01 }, encoded);
+    }
+
+    [Fact]
+    public void TryDecodeEvent_DecodesFrameFromSpan()
+    {
+        var frame = BuildEventFrame(ArduinoEventType.MouseMove, new byte[] { 1, 2, 3, 4 }, 0x01020304);
+
+        var consumed = ArduinoProtocolDecoder.TryDecodeEvent(frame.AsSpan(), out var decoded);
+
+        Assert.Equal(frame.Length, consumed);
+        Assert.NotNull(decoded);
+        Assert.Equal(ArduinoEventType.MouseMove, decoded!.EventType);
+        Assert.Equal(new byte[] { 1, 2, 3, 4 }, decoded.Data);
+        Assert.Equal(0x01020304u, decoded.Timestamp);
+    }
+
+    [Fact]
+    public void TryDecodeEvent_WithPartialFrame_ReturnsZero()
+    {
+        var frame = BuildEventFrame(ArduinoEventType.StatusResponse, new byte[] { 9 }, 42);
+
+        var consumed = ArduinoProtocolDecoder.TryDecodeEvent(frame.AsSpan(0, frame.Length - 1), out var decoded);
+
+        Assert.Equal(0, consumed);
+        Assert.Null(decoded);
+    }
+
+    [Fact]
+    public void TryDecodeEvent_WithGarbagePrefix_SkipsOneByteAtATime()
+    {
+        var frame = BuildEventFrame(ArduinoEventType.KeyboardInput, new byte[] { 0x41 }, 7);
+        var stream = new byte[] { 0x7A, 0x00, 0x33 }.Concat(frame).ToArray();
+
+        var offset = 0;
+        DecodedArduinoEvent? decoded = null;
+        while (offset < stream.Length && decoded == null)
+        {
+            var consumed = ArduinoProtocolDecoder.TryDecodeEvent(stream.AsSpan(offset), out decoded);
+            Assert.True(consumed > 0);
+            offset += consumed;
+        }
+
+        Assert.Equal(stream.Length, offset);
+        Assert.NotNull(decoded);
+        Assert.Equal(ArduinoEventType.KeyboardInput, decoded!.EventType);
+    }
+
+    [Fact]
+    public void TryDecodeEvent_ArrayOverloadHonoursOffset()
+    {
+        var frame = BuildEventFrame(ArduinoEventType.MouseClick, new byte[] { 1, 1 }, 5);
+        var buffer = new byte[] { 0xAA, 0xBB }.Concat(frame).ToArray();
+
+        var consumed = ArduinoProtocolDecoder.TryDecodeEvent(buffer, 2, out var decoded);
+
+        Assert.Equal(frame.Length, consumed);
+        Assert.Equal(ArduinoEventType.MouseClick, decoded!.EventType);
+    }
+
+    [Fact]
+    public void TryDecodeEvent_FlowControlReport_ReadsCapacityAndProcessedCount()
+    {
+        var frame = BuildEventFrame(ArduinoEventType.FlowControl, new byte[] { 0x40, 0x00, 0x10, 0x00, 0x00, 0x80 }, 3);
+
+        ArduinoProtocolDecoder.TryDecodeEvent(frame, out var decoded);
+
+        Assert.Equal(ArduinoEventType.FlowControl, decoded!.EventType);
+        Assert.True(ArduinoProtocolDecoder.TryReadFlowControl(decoded.Data, out var capacity, out var processed));
+        Assert.Equal((ushort)64, capacity);
+        Assert.Equal(0x80000010u, processed);
+        Assert.False(ArduinoProtocolDecoder.TryReadFlowControl(decoded.Data.AsSpan(0, 5), out _, out _));
+    }
+
+    [Fact]
+    public void FindFrameEnd_ReturnsBoundaryAtOrAfterOffset()
+    {
+        var frames = ArduinoProtocolEncoder.EncodeCommand(new ArduinoMouseMoveRelativeCommand(1, 2))
+            .Concat(ArduinoProtocolEncoder.EncodeCommand(new ArduinoReleaseAllCommand()))
+            .ToArray();
+        var first = frames.Length - ArduinoProtocolEncoder.FrameOverhead;
+
+        Assert.Equal(0, ArduinoProtocolEncoder.FindFrameEnd(frames, 0));
+        Assert.Equal(first, ArduinoProtocolEncoder.FindFrameEnd(frames, 1));
+        Assert.Equal(first, ArduinoProtocolEncoder.FindFrameEnd(frames, first));
+        Assert.Equal(frames.Length, ArduinoProtocolEncoder.FindFrameEnd(frames, first + 1));
+    }
+
+    [Fact]
+    public void FindFrameStart_ReturnsBoundaryAtOrBeforeOffset()
+    {
+        var frames = ArduinoProtocolEncoder.EncodeCommand(new ArduinoMouseMoveRelativeCommand(1, 2))
+            .Concat(ArduinoProtocolEncoder.EncodeCommand(new ArduinoReleaseAllCommand()))
+            .ToArray();
+        var first = frames.Length - ArduinoProtocolEncoder.FrameOverhead;
+
+        Assert.Equal(0, ArduinoProtocolEncoder.FindFrameStart(frames, 0));
+        Assert.Equal(0, ArduinoProtocolEncoder.FindFrameStart(frames, first - 1));
+        Assert.Equal(first, ArduinoProtocolEncoder.FindFrameStart(frames, first));
+        Assert.Equal(frames.Length, ArduinoProtocolEncoder.FindFrameStart(frames, frames.Length));
+    }
+
+    private static byte[] BuildEventFrame(ArduinoEventType eventType, byte[] data, uint timestamp)
+    {
+        var frame = new List<byte>
+        {
+            (byte)eventType,
+            (byte)(data.Length & 0xFF),
+            (byte)((data.Length >> 8) & 0xFF)
+        };
+        frame.AddRange(data);
+        frame.AddRange(BitConverter.GetBytes(timestamp));
+        frame.Add(ArduinoProtocolEncoder.CalculateChecksum(frame.ToArray()));
+        return frame.ToArray();
+    }
+}
@@ -0,0 +1,396 @@
+using System.Buffers.Binary;
+using System.Collections.Concurrent;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Adapters;
+using MacroNex.Infrastructure.Utilities;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Tests for the pipelined writer of <see cref="ArduinoSerialService"/> against an in-memory serial port.
+/// </summary>
+public class ArduinoSerialServiceTests
+{
+    private static readonly TimeSpan WaitTimeout = TimeSpan.FromSeconds(5);
+
+    [Fact]
+    public async Task Writer_CreditStall_ProbesAtFrameBoundaryAndResumesOnReport()
+    {
+        // 32-byte buffer: 24 bytes of credit after the 8-byte probe reserve, i.e. two 12-byte frames
+        var port = new FakeSerialPort { ReportCapacity = 32, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions
+        {
+            BatchWindow = TimeSpan.Zero,
+            CreditStallTimeout = TimeSpan.FromMilliseconds(50)
+        });
+
+        try
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg" + i));
+            }
+
+            Assert.True(port.WaitForBytes(4 + 4 * 12 + 4, WaitTimeout));
+
+            var frames = ParseFrames(port.Written);
+            var types = frames.Select(f => f.Type).ToList();
+            Assert.Equal(4, types.Count(t => t == ArduinoCommandType.KeyboardText));
+            // Handshake plus at least one probe sent while out of credit, between whole frames
+            Assert.True(types.Count(t => t == ArduinoCommandType.StatusQuery) >= 2);
+            Assert.Equal(ArduinoCommandType.StatusQuery, types[0]);
+            Assert.Equal(ArduinoCommandType.StatusQuery, types[3]);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task Writer_StalledInsideFrameWithoutReports_ResumesWithoutProbing()
+    {
+        // 16-byte buffer leaves 12 bytes of credit, less than the 20-byte frame, so the write splits inside it
+        var port = new FakeSerialPort { ReportCapacity = 16, ReportOnStatusQuery = false };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions
+        {
+            BatchWindow = TimeSpan.Zero,
+            CreditStallTimeout = TimeSpan.FromMilliseconds(20)
+        });
+
+        try
+        {
+            await service.SendCommandAsync(new ArduinoKeyboardTextCommand("0123456789abcdef"));
+
+            Assert.True(port.WaitForBytes(4 + 20, WaitTimeout));
+
+            var frames = ParseFrames(port.Written);
+            Assert.Equal(new[] { ArduinoCommandType.StatusQuery, ArduinoCommandType.KeyboardText }, frames.Select(f => f.Type).ToArray());
+            Assert.Equal("0123456789abcdef", System.Text.Encoding.UTF8.GetString(frames[1].Data));
+            Assert.Equal(new[] { 4, 12, 8 }, port.WriteSizes);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task EmergencyStop_WhileOutOfCredit_DropsQueuedFramesAndSendsRelease()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 32, ReportOnStatusQuery = false, Capabilities = ArduinoFirmwareCapabilities.ReleaseAll };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions
+        {
+            BatchWindow = TimeSpan.Zero,
+            CreditStallTimeout = TimeSpan.FromSeconds(30)
+        });
+
+        try
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg" + i));
+            }
+            Assert.True(port.WaitForBytes(4 + 2 * 12, WaitTimeout));
+
+            await service.EmergencyStopAsync().WaitAsync(WaitTimeout);
+
+            var types = ParseFrames(port.Written).Select(f => f.Type).ToArray();
+            Assert.Equal(new[]
+            {
+                ArduinoCommandType.StatusQuery,
+                ArduinoCommandType.KeyboardText,
+                ArduinoCommandType.KeyboardText,
+                ArduinoCommandType.ReleaseAll
+            }, types);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task EmergencyStop_FirmwareWithoutReleaseAll_ReleasesEachHeldInput()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 1024, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions { BatchWindow = TimeSpan.Zero });
+
+        try
+        {
+            await service.SendCommandsAsync(new ArduinoCommand[]
+            {
+                new ArduinoKeyPressCommand(VirtualKey.VK_A, true),
+                new ArduinoKeyPressCommand(VirtualKey.VK_B, true),
+                new ArduinoKeyPressCommand(VirtualKey.VK_B, false),
+                new ArduinoMouseClickCommand(MouseButton.Left, ClickType.Down),
+                new ArduinoMouseClickCommand(MouseButton.Right, ClickType.Click)
+            });
+            await service.FlushAsync().WaitAsync(WaitTimeout);
+            var sent = ParseFrames(port.Written).Count;
+
+            await service.EmergencyStopAsync().WaitAsync(WaitTimeout);
+
+            var releases = ParseFrames(port.Written).Skip(sent).ToList();
+            Assert.DoesNotContain(releases, f => f.Type == ArduinoCommandType.ReleaseAll);
+            Assert.Equal(2, releases.Count);
+            Assert.Contains(releases, f => f.Type == ArduinoCommandType.KeyPress && f.Data.SequenceEqual(new byte[] { (byte)VirtualKey.VK_A, 0, 0 }));
+            Assert.Contains(releases, f => f.Type == ArduinoCommandType.MouseClick && f.Data.SequenceEqual(new byte[] { (byte)MouseButton.Left, (byte)ClickType.Up }));
+
+            // Released inputs are forgotten: a second stop has nothing to send
+            await service.EmergencyStopAsync().WaitAsync(WaitTimeout);
+            Assert.Equal(sent + 2, ParseFrames(port.Written).Count);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task Writer_FramesQueuedWithinBatchWindow_CoalesceIntoOneWrite()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 1024, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions { BatchWindow = TimeSpan.FromMilliseconds(200) });
+
+        try
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg" + i));
+            }
+
+            Assert.True(port.WaitForBytes(4 + 3 * 12, WaitTimeout));
+
+            Assert.Equal(new[] { 4, 3 * 12 }, port.WriteSizes);
+            Assert.Equal(3, ParseFrames(port.Written).Count(f => f.Type == ArduinoCommandType.KeyboardText));
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task Writer_BatchWindowExpires_WritesPartialBatch()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 1024, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions { BatchWindow = TimeSpan.FromMilliseconds(20) });
+
+        try
+        {
+            await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg0"));
+
+            // Nothing else is queued, so the frame goes out once the window runs out
+            Assert.True(port.WaitForBytes(4 + 12, WaitTimeout));
+            Assert.Equal(new[] { 4, 12 }, port.WriteSizes);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task SendCommandsAsync_BatchLargerThanMaxBatchBytes_IsWrittenInOneWrite()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 1024, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions { BatchWindow = TimeSpan.Zero, MaxBatchBytes = 64 });
+
+        try
+        {
+            var commands = Enumerable.Range(0, 8).Select(i => new ArduinoKeyboardTextCommand("abcdefg" + i)).ToArray();
+            await service.SendCommandsAsync(commands);
+
+            Assert.True(port.WaitForBytes(4 + 8 * 12, WaitTimeout));
+            Assert.Equal(new[] { 4, 8 * 12 }, port.WriteSizes);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    [Fact]
+    public async Task FlushAsync_ClosesBatchWindowAndCompletesAfterWrite()
+    {
+        var port = new FakeSerialPort { ReportCapacity = 1024, ReportOnStatusQuery = true };
+        var service = await ConnectAsync(port, new ArduinoTransportOptions { BatchWindow = TimeSpan.FromSeconds(30) });
+
+        try
+        {
+            await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg0"));
+            await service.SendCommandAsync(new ArduinoKeyboardTextCommand("abcdefg1"));
+
+            // Far shorter than the window: the flush marker must end the batch rather than wait it out
+            await service.FlushAsync().WaitAsync(WaitTimeout);
+
+            Assert.Equal(new[] { 4, 2 * 12 }, port.WriteSizes);
+        }
+        finally
+        {
+            await service.DisconnectAsync();
+        }
+    }
+
+    private static async Task<ArduinoSerialService> ConnectAsync(FakeSerialPort port, ArduinoTransportOptions options)
+    {
+        var service = new ArduinoSerialService(NullLogger<ArduinoSerialService>.Instance, options, null, _ => port);
+        await service.ConnectAsync("COM_TEST");
+        return service;
+    }
+
+    /// <summary>
+    /// Splits written bytes into frames, failing on a bad checksum (e.g. a frame interleaved into another).
+    /// </summary>
+    private static List<(ArduinoCommandType Type, byte[] Data)> ParseFrames(byte[] bytes)
+    {
+        var frames = new List<(ArduinoCommandType, byte[])>();
+        var offset = 0;
+        while (offset < bytes.Length)
+        {
+            var length = bytes[offset + 1] | (bytes[offset + 2] << 8);
+            var total = ArduinoProtocolEncoder.FrameOverhead + length;
+            Assert.True(offset + total <= bytes.Length, "Truncated frame");
+            Assert.Equal(ArduinoProtocolEncoder.CalculateChecksum(bytes.AsSpan(offset, total - 1)), bytes[offset + total - 1]);
+
+            frames.Add(((ArduinoCommandType)bytes[offset], bytes.AsSpan(offset + 3, length).ToArray()));
+            offset += total;
+        }
+
+        return frames;
+    }
+
+    /// <summary>
+    /// In-memory serial port that answers status queries like the firmware: a flow control report (optional after
+    /// the handshake) followed by a status response.
+    /// </summary>
+    internal sealed class FakeSerialPort : IArduinoSerialPort
+    {
+        private readonly object _lock = new();
+        private readonly List<byte> _written = new();
+        private readonly List<int> _writeSizes = new();
+        private readonly BlockingCollection<byte[]> _incoming = new();
+        private byte[] _pendingRead = Array.Empty<byte>();
+        private int _pendingOffset;
+        private int _reportBaseline = -1;
+
+        public int ReportCapacity { get; init; }
+
+        public bool ReportOnStatusQuery { get; init; }
+
+        public ArduinoFirmwareCapabilities Capabilities { get; init; }
+
+        public bool IsOpen { get; private set; }
+
+        public byte[] Written
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _written.ToArray();
+                }
+            }
+        }
+
+        public int[] WriteSizes
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _writeSizes.ToArray();
+                }
+            }
+        }
+
+        public void Open() => IsOpen = true;
+
+        public void Close() => IsOpen = false;
+
+        public void Dispose() => IsOpen = false;
+
+        public void Write(byte[] buffer, int offset, int count)
+        {
+            bool isStatusQuery;
+            int processed;
+            lock (_lock)
+            {
+                _written.AddRange(buffer.AsSpan(offset, count).ToArray());
+                _writeSizes.Add(count);
+                Monitor.PulseAll(_lock);
+
+                isStatusQuery = count == 4 && buffer[offset] == (byte)ArduinoCommandType.StatusQuery;
+                if (isStatusQuery && _reportBaseline < 0)
+                    _reportBaseline = _written.Count;
+                processed = _written.Count - Math.Max(_reportBaseline, 0);
+            }
+
+            if (!isStatusQuery)
+                return;
+
+            if (ReportCapacity > 0 && (ReportOnStatusQuery || processed == 0))
+            {
+                var report = new byte[6];
+                BinaryPrimitives.WriteUInt16LittleEndian(report, (ushort)ReportCapacity);
+                BinaryPrimitives.WriteUInt32LittleEndian(report.AsSpan(2), (uint)processed);
+                Push(ArduinoEventType.FlowControl, report);
+            }
+
+            if (ReportOnStatusQuery || processed == 0)
+                Push(ArduinoEventType.StatusResponse, Capabilities == ArduinoFirmwareCapabilities.None
+                    ? Array.Empty<byte>()
+                    : new byte[] { 1, (byte)Capabilities });
+        }
+
+        public int Read(byte[] buffer, int offset, int count)
+        {
+            if (_pendingOffset >= _pendingRead.Length)
+            {
+                if (!_incoming.TryTake(out var next, 20))
+                    throw new TimeoutException();
+
+                _pendingRead = next;
+                _pendingOffset = 0;
+            }
+
+            var read = Math.Min(count, _pendingRead.Length - _pendingOffset);
+            Array.Copy(_pendingRead, _pendingOffset, buffer, offset, read);
+            _pendingOffset += read;
+            return read;
+        }
+
+        public bool WaitForBytes(int count, TimeSpan timeout)
+        {
+            var deadline = DateTime.UtcNow + timeout;
+            lock (_lock)
+            {
+                while (_written.Count < count)
+                {
+                    var remaining = deadline - DateTime.UtcNow;
+                    if (remaining <= TimeSpan.Zero)
+                        return false;
+
+                    Monitor.Wait(_lock, remaining);
+                }
+
+                return true;
+            }
+        }
+
+        private void Push(ArduinoEventType type, byte[] data)
+        {
+            // [EventType][DataLength: 2][Data][Timestamp: 4][Checksum]
+            var frame = new byte[8 + data.Length];
+            frame[0] = (byte)type;
+            frame[1] = (byte)(data.Length & 0xFF);
+            frame[2] = (byte)(data.Length >> 8);
+            data.CopyTo(frame, 3);
+            frame[^1] = ArduinoProtocolEncoder.CalculateChecksum(frame.AsSpan(0, frame.Length - 1));
+            _incoming.Add(frame);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for closed-loop absolute positioning against a simulated cursor.
+/// </summary>
+public class ClosedLoopMousePositionerTests
+{
+    /// <summary>
+    /// Cursor whose real pixels-per-HID ratio differs from what the calibration believes.
+    /// </summary>
+    private sealed class SimulatedCursor
+    {
+        private readonly double _pixelsPerHid;
+        private double _x;
+        private double _y;
+
+        public SimulatedCursor(Point start, double pixelsPerHid)
+        {
+            _x = start.X;
+            _y = start.Y;
+            _pixelsPerHid = pixelsPerHid;
+        }
+
+        public int Moves { get; private set; }
+
+        /// <summary>
+        /// Left screen edge the cursor stops at.
+        /// </summary>
+        public double MinX { get; init; } = double.MinValue;
+
+        public Task<Point> MoveAsync(int hidDeltaX, int hidDeltaY, Point from)
+        {
+            Moves++;
+            _x = Math.Max(MinX, _x + hidDeltaX * _pixelsPerHid);
+            _y += hidDeltaY * _pixelsPerHid;
+            return Task.FromResult(new Point((int)Math.Round(_x), (int)Math.Round(_y)));
+        }
+    }
+
+    private static MouseCalibrationData LinearCalibration(double pixelsPerHid)
+    {
+        var data = new MouseCalibrationData
+        {
+            PointsX = { new CalibrationPoint { HidDelta = 0, ActualPixelDelta = 0 }, new CalibrationPoint { HidDelta = 100, ActualPixelDelta = 100 * pixelsPerHid } },
+            PointsY = { new CalibrationPoint { HidDelta = 0, ActualPixelDelta = 0 }, new CalibrationPoint { HidDelta = 100, ActualPixelDelta = 100 * pixelsPerHid } }
+        };
+        data.BuildLookupTables();
+        return data;
+    }
+
+    [Fact]
+    public async Task MoveAsync_WithAccurateCalibration_ReachesTargetWithoutCorrections()
+    {
+        var start = new Point(100, 100);
+        var cursor = new SimulatedCursor(start, pixelsPerHid: 1.0);
+
+        var result = await ClosedLoopMousePositioner.MoveAsync(
+            start, new Point(600, 400), ClosedLoopPositioningOptions.Default(), LinearCalibration(1.0), cursor.MoveAsync);
+
+        Assert.True(result.ReachedTarget);
+        Assert.Equal(0, result.Corrections);
+        Assert.Equal(1, cursor.Moves);
+    }
+
+    [Fact]
+    public async Task MoveAsync_WithOffCalibration_ConvergesWithinCorrectionBudget()
+    {
+        var start = new Point(100, 100);
+        var cursor = new SimulatedCursor(start, pixelsPerHid: 1.25);
+
+        var result = await ClosedLoopMousePositioner.MoveAsync(
+            start, new Point(900, 700), ClosedLoopPositioningOptions.Default(), LinearCalibration(1.0), cursor.MoveAsync);
+
+        Assert.True(result.ReachedTarget);
+        Assert.InRange(result.Corrections, 1, ClosedLoopPositioningOptions.Default().MaxCorrections);
+    }
+
+    [Fact]
+    public async Task MoveAsync_FeedsBackOnlineGain_SoLaterJumpsLandOnTarget()
+    {
+        var calibration = LinearCalibration(1.0);
+        var options = ClosedLoopPositioningOptions.Default();
+        var position = new Point(100, 100);
+        var cursor = new SimulatedCursor(position, pixelsPerHid: 0.8);
+        MousePositioningResult? last = null;
+
+        for (int i = 0; i < 10; i++)
+        {
+            var target = i % 2 == 0 ? new Point(1100, 700) : new Point(100, 100);
+            last = await ClosedLoopMousePositioner.MoveAsync(position, target, options, calibration, cursor.MoveAsync);
+            position = new Point(target.X - last.ResidualX, target.Y - last.ResidualY);
+        }
+
+        Assert.InRange(calibration.GetOnlineGain(), 0.79, 0.81);
+        Assert.InRange(calibration.GetOnlineGain(useYAxis: true), 0.79, 0.81);
+        Assert.True(last!.ReachedTarget);
+        Assert.Equal(0, last.Corrections);
+    }
+
+    [Fact]
+    public async Task MoveAsync_StopsAtCorrectionBudgetAndReportsResidual()
+    {
+        var start = new Point(0, 0);
+        var options = new ClosedLoopPositioningOptions { MaxCorrections = 0 };
+        var cursor = new SimulatedCursor(start, pixelsPerHid: 0.5);
+
+        var result = await ClosedLoopMousePositioner.MoveAsync(start, new Point(200, 0), options, calibration: null, cursor.MoveAsync);
+
+        Assert.Equal(0, result.Corrections);
+        Assert.Equal(100, result.ResidualX);
+        Assert.Equal(0, result.ResidualY);
+        Assert.Equal(1, cursor.Moves);
+    }
+
+    [Fact]
+    public async Task MoveAsync_TargetBeyondScreenEdge_StopsOnceClampedMoveMakesNoProgress()
+    {
+        var start = new Point(100, 100);
+        var cursor = new SimulatedCursor(start, pixelsPerHid: 1.0) { MinX = 0 };
+
+        var result = await ClosedLoopMousePositioner.MoveAsync(
+            start, new Point(-50, 100), ClosedLoopPositioningOptions.Default(), calibration: null, cursor.MoveAsync,
+            landed => landed.X <= 0);
+
+        // The jump lands on the edge; one correction shows it cannot get closer
+        Assert.Equal(2, cursor.Moves);
+        Assert.Equal(-50, result.ResidualX);
+        Assert.False(result.ReachedTarget);
+    }
+
+    [Fact]
+    public async Task MoveAsync_WhenCancelled_StopsBeforeMoving()
+    {
+        var start = new Point(0, 0);
+        var cursor = new SimulatedCursor(start, pixelsPerHid: 1.0);
+
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => ClosedLoopMousePositioner.MoveAsync(
+            start, new Point(200, 0), ClosedLoopPositioningOptions.Default(), calibration: null, cursor.MoveAsync,
+            cancellationToken: new CancellationToken(canceled: true)));
+
+        Assert.Equal(0, cursor.Moves);
+    }
+}
@@ -0,0 +1,97 @@
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the binary command buffer format and packed script storage.
+/// </summary>
+public class CommandBufferSerializerTests : IDisposable
+{
+    private readonly string _tempDir;
+
+    public CommandBufferSerializerTests()
+    {
+        _tempDir = Path.Combine(Path.GetTempPath(), "MacroNex.Tests", "packed", Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(_tempDir);
+    }
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_tempDir, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    [Fact]
+    public void Serialize_RoundTripsColumnsAndKeyboardPayloads()
+    {
+        var buffer = new CommandBuffer();
+        buffer.Add(CommandRecord.MouseMoveRelative(-3, 7, TimeSpan.FromTicks(98765)));
+        buffer.Add(CommandRecord.Keyboard("日本語 'text'", Array.Empty<VirtualKey>()));
+        buffer.Add(CommandRecord.Keyboard(null, new[] { VirtualKey.VK_CONTROL, VirtualKey.VK_S }, TimeSpan.FromSeconds(1)));
+        buffer.Add(CommandRecord.Sleep(TimeSpan.FromHours(3)));
+
+        var restored = CommandBufferSerializer.Deserialize(CommandBufferSerializer.Serialize(buffer));
+
+        Assert.Equal(buffer.Opcodes.ToArray(), restored.Opcodes.ToArray());
+        Assert.Equal(buffer.X.ToArray(), restored.X.ToArray());
+        Assert.Equal(buffer.Y.ToArray(), restored.Y.ToArray());
+        Assert.Equal(buffer.DelayTicks.ToArray(), restored.DelayTicks.ToArray());
+        Assert.Equal("日本語 'text'", restored[1].Text);
+        Assert.Null(restored[2].Text);
+        Assert.Equal(new[] { VirtualKey.VK_CONTROL, VirtualKey.VK_S }, restored[2].Keys.ToArray());
+        Assert.Equal(TimeSpan.FromHours(3), restored[3].Duration);
+    }
+
+    [Fact]
+    public void Deserialize_TruncatedData_Throws()
+    {
+        var buffer = new CommandBuffer();
+        buffer.Add(CommandRecord.MouseMoveRelative(1, 1));
+        buffer.Add(CommandRecord.Keyboard("abc", Array.Empty<VirtualKey>()));
+        var data = CommandBufferSerializer.Serialize(buffer);
+
+        Assert.Throws<InvalidDataException>(() => CommandBufferSerializer.Deserialize(data[..^2]));
+        Assert.Throws<InvalidDataException>(() => CommandBufferSerializer.Deserialize(data[..20]));
+    }
+
+    [Fact]
+    public async Task SaveScriptAsync_CompactRecording_IsStoredPackedAndLoadsCompact()
+    {
+        var storage = new JsonFileStorageService(NullLogger<JsonFileStorageService>.Instance, _tempDir);
+        var script = new Script("Recording");
+        for (int i = 0; i < 5000; i++)
+        {
+            script.AddCommand(new MouseMoveRelativeCommand(i % 9 - 4, i % 5 - 2) { Delay = TimeSpan.FromMilliseconds(i % 3) });
+        }
+        Assert.True(script.Compact());
+
+        await storage.SaveScriptAsync(script);
+        var loaded = await new JsonFileStorageService(NullLogger<JsonFileStorageService>.Instance, _tempDir).LoadScriptAsync(script.Id);
+
+        Assert.NotNull(loaded);
+        Assert.True(loaded!.IsCompact);
+        Assert.Equal(5000, loaded.CommandCount);
+        Assert.Equal((4999 % 9) - 4, loaded.CommandBuffer![4999].X);
+        Assert.Equal(TimeSpan.FromMilliseconds(4999 % 3), loaded.CommandBuffer[4999].Delay);
+    }
+
+    [Fact]
+    public async Task SaveScriptAsync_LargeObjectScript_StaysUnpacked()
+    {
+        var storage = new JsonFileStorageService(NullLogger<JsonFileStorageService>.Instance, _tempDir);
+        var script = new Script("Large");
+        for (int i = 0; i < 2000; i++)
+        {
+            script.AddCommand(new MouseMoveCommand(new Point(i, i)));
+        }
+
+        await storage.SaveScriptAsync(script);
+        var loaded = await new JsonFileStorageService(NullLogger<JsonFileStorageService>.Instance, _tempDir).LoadScriptAsync(script.Id);
+
+        Assert.NotNull(loaded);
+        Assert.False(loaded!.IsCompact);
+        Assert.Equal(2000, loaded.CommandCount);
+    }
+}
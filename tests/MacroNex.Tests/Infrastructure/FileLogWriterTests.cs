@@ -0,0 +1,132 @@
+using MacroNex.Domain.Interfaces;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the batched background log writer.
+/// </summary>
+public class FileLogWriterTests : IDisposable
+{
+    private readonly string _tempDir;
+
+    public FileLogWriterTests()
+    {
+        _tempDir = Path.Combine(Path.GetTempPath(), "MacroNex.Tests", "logs", Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(_tempDir);
+    }
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_tempDir, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    private string LogPath => Path.Combine(_tempDir, "MacroNex.log");
+
+    private FileLogWriter CreateWriter(FileLogWriterOptions? options = null) =>
+        new(NullLogger<FileLogWriter>.Instance, _tempDir, options);
+
+    private static LogEntry Entry(int i) =>
+        new(Guid.NewGuid(), DateTime.UtcNow, LogLevel.Info, $"entry {i}", null, null);
+
+    [Fact]
+    public async Task DisposeAsync_WritesAllQueuedEntriesInOrder()
+    {
+        var writer = CreateWriter(new FileLogWriterOptions { OverflowPolicy = LogOverflowPolicy.Wait });
+
+        for (var i = 0; i < 500; i++)
+            await writer.WriteLogEntryAsync(Entry(i));
+        await writer.DisposeAsync();
+
+        var lines = await File.ReadAllLinesAsync(LogPath);
+        Assert.Equal(500, lines.Length);
+        Assert.EndsWith("entry 0", lines[0]);
+        Assert.EndsWith("entry 499", lines[^1]);
+        Assert.Equal(0, writer.DroppedEntryCount);
+    }
+
+    [Fact]
+    public async Task WriteLogEntryAsync_FlushesAfterInterval()
+    {
+        await using var writer = CreateWriter(new FileLogWriterOptions { FlushInterval = TimeSpan.FromMilliseconds(20) });
+
+        await writer.WriteLogEntryAsync(Entry(1));
+
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (DateTime.UtcNow < deadline && !ReadShared().Contains("entry 1"))
+            await Task.Delay(10);
+
+        Assert.Contains("entry 1", ReadShared());
+    }
+
+    [Fact]
+    public async Task WriteLogEntryAsync_WhenQueueIsFull_DropsAndCounts()
+    {
+        const int total = 2000;
+        var writer = CreateWriter(new FileLogWriterOptions
+        {
+            QueueCapacity = 4,
+            OverflowPolicy = LogOverflowPolicy.Drop,
+            FlushInterval = TimeSpan.FromSeconds(30)
+        });
+
+        for (var i = 0; i < total; i++)
+            await writer.WriteLogEntryAsync(Entry(i));
+        await writer.DisposeAsync();
+
+        var written = (await File.ReadAllLinesAsync(LogPath)).Length;
+        Assert.True(writer.DroppedEntryCount > 0);
+        Assert.Equal(total, written + writer.DroppedEntryCount);
+    }
+
+    [Fact]
+    public async Task WriteLogEntryAsync_RotatesWhenFileReachesLimit()
+    {
+        var writer = CreateWriter(new FileLogWriterOptions
+        {
+            OverflowPolicy = LogOverflowPolicy.Wait,
+            MaxFileSizeBytes = 1024
+        });
+
+        for (var i = 0; i < 200; i++)
+            await writer.WriteLogEntryAsync(Entry(i));
+        await writer.DisposeAsync();
+
+        Assert.True(File.Exists(Path.Combine(_tempDir, "MacroNex.1.log")));
+        Assert.True(new FileInfo(LogPath).Length <= 1024);
+        Assert.EndsWith("entry 199", (await File.ReadAllLinesAsync(LogPath))[^1]);
+    }
+
+    [Fact]
+    public async Task ClearLogsAsync_DeletesFilesAndKeepsWriting()
+    {
+        await using var writer = CreateWriter(new FileLogWriterOptions { FlushInterval = TimeSpan.Zero, OverflowPolicy = LogOverflowPolicy.Wait });
+        await writer.WriteLogEntryAsync(Entry(1));
+        await WaitForFileAsync();
+
+        await writer.ClearLogsAsync();
+        Assert.False(File.Exists(LogPath));
+
+        await writer.WriteLogEntryAsync(Entry(2));
+        await WaitForFileAsync();
+        Assert.Contains("entry 2", ReadShared());
+    }
+
+    private string ReadShared()
+    {
+        if (!File.Exists(LogPath))
+            return string.Empty;
+
+        using var stream = new FileStream(LogPath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+        using var reader = new StreamReader(stream);
+        return reader.ReadToEnd();
+    }
+
+    private async Task WaitForFileAsync()
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (DateTime.UtcNow < deadline && ReadShared().Length == 0)
+            await Task.Delay(10);
+    }
+}
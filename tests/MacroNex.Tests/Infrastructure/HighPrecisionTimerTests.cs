@@ -0,0 +1,71 @@
+using MacroNex.Infrastructure.Utilities;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for HighPrecisionTimer.
+/// </summary>
+public class HighPrecisionTimerTests
+{
+    private readonly HighPrecisionTimer _timer = new(NullLogger<HighPrecisionTimer>.Instance);
+
+    [Fact]
+    public async Task DelayAsync_NeverWakesEarly()
+    {
+        using var session = _timer.BeginHighResolutionSession();
+
+        foreach (var ms in new[] { 0.5, 1, 3, 5, 12 })
+        {
+            var requested = TimeSpan.FromMilliseconds(ms);
+            var result = await _timer.DelayAsync(requested);
+
+            Assert.Equal(requested, result.Requested);
+            Assert.True(result.Actual >= requested, $"Woke after {result.Actual.TotalMilliseconds}ms for {ms}ms");
+        }
+    }
+
+    [Fact]
+    public async Task DelayAsync_RecordsErrorStatistics()
+    {
+        await _timer.DelayAsync(TimeSpan.FromMilliseconds(2));
+        await _timer.DelayAsync(TimeSpan.FromMilliseconds(4));
+
+        var stats = _timer.GetErrorStatistics();
+        Assert.Equal(2, stats.SampleCount);
+        Assert.True(stats.MaxError >= TimeSpan.Zero);
+        Assert.True(stats.MeanAbsoluteError <= stats.MaxError);
+
+        _timer.ResetErrorStatistics();
+        Assert.Equal(0, _timer.GetErrorStatistics().SampleCount);
+    }
+
+    [Fact]
+    public async Task DelayAsync_WithNegativeDuration_ThrowsArgumentException()
+    {
+        await Assert.ThrowsAsync<ArgumentException>(() => _timer.DelayAsync(TimeSpan.FromMilliseconds(-1)));
+    }
+
+    [Fact]
+    public async Task DelayAsync_WhenCancelled_Throws()
+    {
+        using var cts = new CancellationTokenSource(TimeSpan.FromMilliseconds(20));
+
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => _timer.DelayAsync(TimeSpan.FromSeconds(5), cts.Token));
+    }
+
+    [Fact]
+    public void BeginHighResolutionSession_IsReferenceCountedAndIdempotent()
+    {
+        var first = _timer.BeginHighResolutionSession();
+        var second = _timer.BeginHighResolutionSession();
+        Assert.Equal(2, _timer.ActiveSessionCount);
+
+        first.Dispose();
+        first.Dispose();
+        Assert.Equal(1, _timer.ActiveSessionCount);
+
+        second.Dispose();
+        Assert.Equal(0, _timer.ActiveSessionCount);
+    }
+}
@@ -0,0 +1,159 @@
+using MacroNex.Domain.Entities;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the per-script storage layout of JsonFileStorageService.
+/// </summary>
+public class JsonFileStorageShardingTests : IDisposable
+{
+    private readonly string _tempDir;
+
+    public JsonFileStorageShardingTests()
+    {
+        _tempDir = Path.Combine(Path.GetTempPath(), "MacroNex.Tests", "sharding", Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(_tempDir);
+    }
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_tempDir, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    private string ScriptsDirectory => Path.Combine(_tempDir, "scripts");
+
+    private string ShardPath(Guid id) => Path.Combine(ScriptsDirectory, id.ToString("N") + ".json");
+
+    private JsonFileStorageService CreateStorage() => new(NullLogger<JsonFileStorageService>.Instance, _tempDir);
+
+    [Fact]
+    public async Task SaveScriptAsync_WritesOneFilePerScriptAndPreservesOrder()
+    {
+        var storage = CreateStorage();
+        var first = new Script("First") { SourceText = "msleep(1)" };
+        var second = new Script("Second") { SourceText = "msleep(2)" };
+
+        await storage.SaveScriptAsync(first);
+        await storage.SaveScriptAsync(second);
+
+        Assert.True(File.Exists(ShardPath(first.Id)));
+        Assert.True(File.Exists(ShardPath(second.Id)));
+        Assert.True(File.Exists(Path.Combine(ScriptsDirectory, "index.json")));
+        Assert.False(File.Exists(Path.Combine(_tempDir, "scripts.json")));
+        Assert.Empty(Directory.GetFiles(ScriptsDirectory, "*.tmp"));
+
+        var loaded = (await CreateStorage().LoadScriptsAsync()).ToList();
+        Assert.Equal(new[] { "First", "Second" }, loaded.Select(s => s.Name).ToArray());
+        Assert.Equal("msleep(2)", loaded[1].SourceText);
+    }
+
+    [Fact]
+    public async Task SaveScriptAsync_UpdatingOneScriptDoesNotRewriteOthers()
+    {
+        var storage = CreateStorage();
+        var untouched = new Script("Untouched") { SourceText = "msleep(1)" };
+        var edited = new Script("Edited") { SourceText = "msleep(1)" };
+        await storage.SaveScriptAsync(untouched);
+        await storage.SaveScriptAsync(edited);
+
+        var past = DateTime.UtcNow.AddHours(-1);
+        File.SetLastWriteTimeUtc(ShardPath(untouched.Id), past);
+
+        edited.SourceText = "msleep(500)";
+        await storage.SaveScriptAsync(edited);
+
+        Assert.Equal(past, File.GetLastWriteTimeUtc(ShardPath(untouched.Id)));
+        Assert.NotEqual(past, File.GetLastWriteTimeUtc(ShardPath(edited.Id)));
+
+        var reloaded = (await storage.LoadScriptsAsync()).Single(s => s.Id == edited.Id);
+        Assert.Equal("msleep(500)", reloaded.SourceText);
+
+        // The index carries the metadata the script list shows
+        var metadata = (await storage.LoadScriptMetadataAsync()).Single(m => m.Id == edited.Id);
+        Assert.Equal("msleep(500)".Length, metadata.SourceTextLength);
+    }
+
+    [Fact]
+    public async Task DeleteScriptAsync_RemovesScriptFile()
+    {
+        var storage = CreateStorage();
+        var script = new Script("Doomed");
+        await storage.SaveScriptAsync(script);
+
+        Assert.True(await storage.DeleteScriptAsync(script.Id));
+        Assert.False(await storage.DeleteScriptAsync(script.Id));
+
+        Assert.False(File.Exists(ShardPath(script.Id)));
+        Assert.Empty(await storage.LoadScriptsAsync());
+    }
+
+    [Fact]
+    public async Task LoadScriptsAsync_MigratesLegacyLibraryFile()
+    {
+        var legacyStorage = CreateStorage();
+        var a = new Script("Legacy A") { SourceText = "move(1, 2)" };
+        var b = new Script("Legacy B") { SourceText = "move(3, 4)" };
+
+        // The export format is the legacy library format; build a two-script scripts.json from it
+        var exportA = Path.Combine(_tempDir, "a.json");
+        var exportB = Path.Combine(_tempDir, "b.json");
+        await legacyStorage.ExportScriptAsync(a, exportA);
+        await legacyStorage.ExportScriptAsync(b, exportB);
+        var scriptA = ExtractFirstScript(await File.ReadAllTextAsync(exportA));
+        var scriptB = ExtractFirstScript(await File.ReadAllTextAsync(exportB));
+        await File.WriteAllTextAsync(
+            Path.Combine(_tempDir, "scripts.json"),
+            $"{{\"version\":\"1.0\",\"scripts\":[{scriptA},{scriptB}]}}");
+
+        var loaded = (await CreateStorage().LoadScriptsAsync()).ToList();
+
+        Assert.Equal(new[] { a.Id, b.Id }, loaded.Select(s => s.Id).ToArray());
+        Assert.Equal("move(3, 4)", loaded[1].SourceText);
+        Assert.True(File.Exists(ShardPath(a.Id)));
+        Assert.True(File.Exists(ShardPath(b.Id)));
+        Assert.False(File.Exists(Path.Combine(_tempDir, "scripts.json")));
+        Assert.True(File.Exists(Path.Combine(_tempDir, "scripts.json.bak")));
+    }
+
+    [Fact]
+    public async Task LoadScriptMetadataAsync_FillsMetadataForRecoveredScripts()
+    {
+        var storage = CreateStorage();
+        var script = new Script("Recovered") { SourceText = "msleep(5)" };
+        await storage.SaveScriptAsync(script);
+        File.Delete(Path.Combine(ScriptsDirectory, "index.json"));
+
+        var metadata = Assert.Single(await CreateStorage().LoadScriptMetadataAsync());
+
+        Assert.Equal(script.Id, metadata.Id);
+        Assert.Equal("Recovered", metadata.Name);
+        Assert.Equal("msleep(5)".Length, metadata.SourceTextLength);
+    }
+
+    [Fact]
+    public async Task LoadScriptsAsync_RecoversScriptFileMissingFromIndex()
+    {
+        var storage = CreateStorage();
+        var indexed = new Script("Indexed");
+        var orphan = new Script("Orphan");
+        await storage.SaveScriptAsync(orphan);
+        var orphanJson = await File.ReadAllTextAsync(ShardPath(orphan.Id));
+        await storage.DeleteScriptAsync(orphan.Id);
+        await storage.SaveScriptAsync(indexed);
+
+        // Simulate a crash between writing a new script file and updating the index
+        await File.WriteAllTextAsync(ShardPath(orphan.Id), orphanJson);
+
+        var loaded = (await CreateStorage().LoadScriptsAsync()).ToList();
+
+        Assert.Equal(new[] { indexed.Id, orphan.Id }, loaded.Select(s => s.Id).ToArray());
+    }
+
+    private static string ExtractFirstScript(string exportJson)
+    {
+        using var document = System.Text.Json.JsonDocument.Parse(exportJson);
+        return document.RootElement.GetProperty("scripts")[0].GetRawText();
+    }
+}
@@ -0,0 +1,130 @@
+using MacroNex.Domain.Entities;
+using MacroNex.Domain.Interfaces;
+using MacroNex.Domain.ValueObjects;
+using MacroNex.Infrastructure.Storage;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Tests that the typed storage contracts read files written by earlier versions.
+/// </summary>
+public class JsonStorageFormatTests : IDisposable
+{
+    private readonly string _tempDir;
+
+    public JsonStorageFormatTests()
+    {
+        _tempDir = Path.Combine(Path.GetTempPath(), "MacroNex.Tests", "format", Guid.NewGuid().ToString("N"));
+        Directory.CreateDirectory(_tempDir);
+    }
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_tempDir, recursive: true); } catch { /* ignore cleanup failures */ }
+    }
+
+    [Fact]
+    public async Task ImportScriptAsync_ReadsLegacyParameterShapes()
+    {
+        const string json = """
+            {
+              "version": "1.0",
+              "scripts": [
+                {
+                  "id": "6f1c2a50-0000-4000-8000-000000000001",
+                  "name": "Legacy",
+                  "createdAt": "2024-01-01T00:00:00.0000000Z",
+                  "modifiedAt": "2024-01-02T00:00:00.0000000Z",
+                  "commands": [
+                    { "id": "6f1c2a50-0000-4000-8000-000000000010", "type": "MouseMoveLowLevel", "delay": "00:00:00.010", "createdAt": "2024-01-01T00:00:00.0000000Z", "parameters": { "x": 10, "y": 20 } },
+                    { "id": "6f1c2a50-0000-4000-8000-000000000011", "type": "MouseClick", "delay": "00:00:00.000", "createdAt": "2024-01-01T00:00:00.0000000Z", "parameters": { "button": "Left", "clickType": "Down" } },
+                    { "id": "6f1c2a50-0000-4000-8000-000000000012", "type": "KeyPress", "delay": 5, "createdAt": "2024-01-01T00:00:00.0000000Z", "parameters": { "key": "VK_A", "isDown": "true" } },
+                    { "id": "6f1c2a50-0000-4000-8000-000000000013", "type": "Keyboard", "delay": "00:00:00.000", "createdAt": "2024-01-01T00:00:00.0000000Z", "parameters": { "keys": ["VK_A"] } },
+                    { "id": "6f1c2a50-0000-4000-8000-000000000014", "type": "Sleep", "delay": "00:00:00.000", "createdAt": "2024-01-01T00:00:00.0000000Z", "parameters": { "duration": 250 } }
+                  ]
+                }
+              ]
+            }
+            """;
+        var path = Path.Combine(_tempDir, "legacy.json");
+        await File.WriteAllTextAsync(path, json);
+
+        var script = await CreateStorage().ImportScriptAsync(path);
+
+        Assert.Equal("Legacy", script.Name);
+        Assert.Equal(5, script.CommandCount);
+        var move = Assert.IsType<MouseMoveCommand>(script.Commands[0]);
+        Assert.Equal(new Point(10, 20), move.Position);
+        var keyPress = Assert.IsType<KeyPressCommand>(script.Commands[2]);
+        Assert.True(keyPress.IsDown);
+        Assert.Equal(TimeSpan.FromMilliseconds(5), keyPress.Delay);
+        var keyboard = Assert.IsType<KeyboardCommand>(script.Commands[3]);
+        Assert.Null(keyboard.Text);
+        Assert.Equal(new[] { VirtualKey.VK_A }, keyboard.Keys.ToArray());
+        var sleep = Assert.IsType<SleepCommand>(script.Commands[4]);
+        Assert.Equal(TimeSpan.FromMilliseconds(250), sleep.Duration);
+    }
+
+    [Fact]
+    public async Task ImportScriptAsync_WithMissingParameter_Throws()
+    {
+        const string json = """
+            {"version":"1.0","scripts":[{"id":"6f1c2a50-0000-4000-8000-000000000002","name":"Broken","createdAt":"2024-01-01T00:00:00Z","modifiedAt":"2024-01-01T00:00:00Z",
+             "commands":[{"id":"6f1c2a50-0000-4000-8000-000000000020","type":"MouseMove","delay":"00:00:00.000","createdAt":"2024-01-01T00:00:00Z","parameters":{"x":1}}]}]}
+            """;
+        var path = Path.Combine(_tempDir, "broken.json");
+        await File.WriteAllTextAsync(path, json);
+
+        var ex = await Assert.ThrowsAsync<StorageException>(() => CreateStorage().ImportScriptAsync(path));
+        Assert.Contains("'y'", ex.Message);
+    }
+
+    [Fact]
+    public async Task Settings_RoundTripMouseCalibration()
+    {
+        var settingsPath = Path.Combine(_tempDir, "settings.json");
+        var service = new JsonSettingsService(NullLogger<JsonSettingsService>.Instance, settingsPath);
+        var calibration = new MouseCalibrationData
+        {
+            CalibratedAt = new DateTime(2024, 5, 1, 12, 0, 0, DateTimeKind.Utc),
+            PointsX = { new CalibrationPoint { HidDelta = 10, ActualPixelDelta = 12.5 } },
+            PolynomialCoefficientsX = new[] { 0.1, 0.8 },
+            CurveType = AccelerationCurveType.WindowsEnhanced
+        };
+        var settings = AppSettings.Default();
+        settings.MouseCalibration = calibration;
+        settings.ExecutionLimits.MaxExecutionTime = TimeSpan.FromMinutes(2);
+
+        await service.SaveAsync(settings);
+        var loaded = await new JsonSettingsService(NullLogger<JsonSettingsService>.Instance, settingsPath).LoadAsync();
+
+        Assert.NotNull(loaded.MouseCalibration);
+        Assert.Equal(calibration.CalibratedAt, loaded.MouseCalibration!.CalibratedAt);
+        Assert.Equal(12.5, Assert.Single(loaded.MouseCalibration.PointsX).ActualPixelDelta);
+        Assert.Equal(new[] { 0.1, 0.8 }, loaded.MouseCalibration.PolynomialCoefficientsX);
+        Assert.Equal(AccelerationCurveType.WindowsEnhanced, loaded.MouseCalibration.CurveType);
+        Assert.Equal(TimeSpan.FromMinutes(2), loaded.ExecutionLimits.MaxExecutionTime);
+        Assert.Equal(VirtualKey.VK_F9, loaded.RecordingStartHotkey!.Key);
+    }
+
+    [Fact]
+    public async Task Settings_RepeatedLoads_ReadFileOnceAndReturnIndependentCopies()
+    {
+        var settingsPath = Path.Combine(_tempDir, "settings.json");
+        var service = new JsonSettingsService(NullLogger<JsonSettingsService>.Instance, settingsPath);
+        var settings = AppSettings.Default();
+        settings.UiLanguage = "en-US";
+        await service.SaveAsync(settings);
+
+        var first = await service.LoadAsync();
+        File.Delete(settingsPath);
+        first.UiLanguage = "zh-TW";
+        var second = await service.LoadAsync();
+
+        Assert.NotSame(first, second);
+        Assert.Equal("en-US", second.UiLanguage);
+    }
+
+    private JsonFileStorageService CreateStorage() => new(NullLogger<JsonFileStorageService>.Instance, _tempDir);
+}
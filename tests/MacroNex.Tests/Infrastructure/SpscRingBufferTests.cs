@@ -0,0 +1,112 @@
+using MacroNex.Infrastructure.Utilities;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the single-producer/single-consumer ring used by the input hook pipeline.
+/// </summary>
+public class SpscRingBufferTests
+{
+    [Fact]
+    public void Constructor_RoundsCapacityUpToPowerOfTwo()
+    {
+        var ring = new SpscRingBuffer<int>(100);
+
+        Assert.Equal(128, ring.Capacity);
+        Assert.True(ring.IsEmpty);
+    }
+
+    [Fact]
+    public void Constructor_WithTooSmallCapacity_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() => new SpscRingBuffer<int>(1));
+    }
+
+    [Fact]
+    public void TryDequeue_ReturnsItemsInFifoOrder()
+    {
+        var ring = new SpscRingBuffer<int>(8);
+        for (var i = 0; i < 5; i++)
+            Assert.True(ring.TryEnqueue(i));
+
+        Assert.Equal(5, ring.Count);
+        for (var i = 0; i < 5; i++)
+        {
+            Assert.True(ring.TryDequeue(out var item));
+            Assert.Equal(i, item);
+        }
+
+        Assert.False(ring.TryDequeue(out _));
+    }
+
+    [Fact]
+    public void TryEnqueue_WhenFull_ReturnsFalseWithoutOverwriting()
+    {
+        var ring = new SpscRingBuffer<int>(4);
+        for (var i = 0; i < 4; i++)
+            Assert.True(ring.TryEnqueue(i));
+
+        Assert.False(ring.TryEnqueue(99));
+
+        Assert.True(ring.TryDequeue(out var first));
+        Assert.Equal(0, first);
+    }
+
+    [Fact]
+    public void TryEnqueue_WrapsAroundAfterDequeue()
+    {
+        var ring = new SpscRingBuffer<int>(4);
+        var next = 0;
+        var expected = 0;
+
+        for (var round = 0; round < 10; round++)
+        {
+            Assert.True(ring.TryEnqueue(next++));
+            Assert.True(ring.TryEnqueue(next++));
+            Assert.True(ring.TryEnqueue(next++));
+
+            for (var i = 0; i < 3; i++)
+            {
+                Assert.True(ring.TryDequeue(out var item));
+                Assert.Equal(expected++, item);
+            }
+        }
+
+        Assert.True(ring.IsEmpty);
+    }
+
+    [Fact]
+    public void ConcurrentProducerAndConsumer_PreserveOrderWithoutLoss()
+    {
+        const int itemCount = 200_000;
+        var ring = new SpscRingBuffer<long>(64);
+
+        var producer = Task.Run(() =>
+        {
+            for (long i = 0; i < itemCount; i++)
+            {
+                var spinner = new SpinWait();
+                while (!ring.TryEnqueue(i))
+                    spinner.SpinOnce();
+            }
+        });
+
+        long expected = 0;
+        var spin = new SpinWait();
+        while (expected < itemCount)
+        {
+            if (ring.TryDequeue(out var item))
+            {
+                Assert.Equal(expected, item);
+                expected++;
+            }
+            else
+            {
+                spin.SpinOnce();
+            }
+        }
+
+        producer.Wait();
+        Assert.True(ring.IsEmpty);
+    }
+}
@@ -352,6 +352,23 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
         }
     }
 
+    [Fact]
+    public async Task RegisterHotkeyAsync_WhenInputThreadStalls_ReleasesLateRegistration()
+    {
+        var api = new FakeWin32HotkeyApi { RegisterGate = new ManualResetEventSlim(false) };
+        using var service = new Win32GlobalHotkeyService(_mockLogger.Object, api, TimeSpan.FromMilliseconds(100));
+        var hotkey = HotkeyDefinition.Create("Test Hotkey", HotkeyModifiers.Control | HotkeyModifiers.Alt, VirtualKey.VK_F5);
+
+        await Assert.ThrowsAsync<HotkeyRegistrationException>(() => service.RegisterHotkeyAsync(hotkey));
+
+        // The stalled work item now gets through RegisterHotKey and has to undo it
+        api.RegisterGate.Set();
+        Assert.True(SpinWait.SpinUntil(() => api.UnregisterCount == 1, TimeSpan.FromSeconds(5)));
+
+        Assert.Equal(0, api.RegisteredCount);
+        Assert.False(await service.IsHotkeyRegisteredAsync(hotkey));
+    }
+
     public void Dispose()
     {
         try
@@ -369,23 +386,43 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
     private sealed class FakeWin32HotkeyApi : IWin32HotkeyApi
     {
         private readonly object _lockObject = new();
-        private readonly HashSet<(uint modifiers, uint vk)> _registered = new();
+        private readonly Dictionary<int, (uint modifiers, uint vk)> _registered = new();
         private readonly Queue<MSG> _messageQueue = new();
         private uint _lastError;
         private uint _currentThreadId = 1;
 
+        /// <summary>
+        /// When set, RegisterHotKey blocks until it is signalled, stalling the input thread.
+        /// </summary>
+        public ManualResetEventSlim? RegisterGate { get; init; }
+
+        public int UnregisterCount { get; private set; }
+
+        public int RegisteredCount
+        {
+            get
+            {
+                lock (_lockObject)
+                {
+                    return _registered.Count;
+                }
+            }
+        }
+
         public bool RegisterHotKey(IntPtr hWnd, int id, uint fsModifiers, uint vk)
         {
+            RegisterGate?.Wait();
+
             lock (_lockObject)
             {
                 var key = (fsModifiers, vk);
-                if (_registered.Contains(key))
+                if (_registered.ContainsValue(key))
                 {
                     _lastError = Win32Api.ERROR_HOTKEY_ALREADY_REGISTERED;
                     return false;
                 }
 
-                _registered.Add(key);
+                _registered[id] = key;
                 _lastError = 0;
                 return true;
             }
@@ -393,9 +430,14 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
 
         public bool UnregisterHotKey(IntPtr hWnd, int id)
         {
-            // Service tracks IDs and calls us; for test purposes we just succeed.
-            _lastError = 0;
-            return true;
+            lock (_lockObject)
+            {
+                // The service tracks IDs itself, so unknown IDs still succeed
+                _registered.Remove(id);
+                UnregisterCount++;
+                _lastError = 0;
+                return true;
+            }
         }
 
         public bool PeekMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax, uint wRemoveMsg)
@@ -404,7 +446,7 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
             {
                 if (_messageQueue.Count > 0)
                 {
-                    msg = _messageQueue.Dequeue();
+                    msg = wRemoveMsg == Win32Api.PM_REMOVE ? _messageQueue.Dequeue() : _messageQueue.Peek();
                     return true;
                 }
             }
@@ -413,6 +455,21 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
             return false;
         }
 
+        public bool GetMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax)
+        {
+            lock (_lockObject)
+            {
+                // Block like the real GetMessage until something is posted
+                while (_messageQueue.Count == 0)
+                {
+                    Monitor.Wait(_lockObject);
+                }
+
+                msg = _messageQueue.Dequeue();
+                return msg.message != Win32Api.WM_QUIT;
+            }
+        }
+
         public bool TranslateMessage(ref MSG msg) => true;
         public IntPtr DispatchMessage(ref MSG msg) => IntPtr.Zero;
 
@@ -430,6 +487,7 @@ public class Win32GlobalHotkeyServiceTests : IDisposable
                     time = 0,
                     pt = new POINT { X = 0, Y = 0 }
                 });
+                Monitor.PulseAll(_lockObject);
                 return true;
             }
         }
@@ -0,0 +1,72 @@
+using MacroNex.Infrastructure.Win32;
+using Xunit;
+using static MacroNex.Infrastructure.Win32.Win32Structures;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for tracking the keys and buttons left down by sent inputs.
+/// </summary>
+public class Win32HeldInputTrackerTests
+{
+    [Fact]
+    public void Observe_KeyDownWithoutUp_IsReleasedByScanCode()
+    {
+        var tracker = new Win32HeldInputTracker();
+
+        tracker.Observe(new[] { Key(0, 0x1E, KEYEVENTF_SCANCODE), Key(0, 0x4B, KEYEVENTF_SCANCODE | KEYEVENTF_EXTENDEDKEY) });
+        tracker.Observe(new[] { Key(0, 0x1E, KEYEVENTF_SCANCODE | KEYEVENTF_KEYUP) });
+
+        Assert.Equal(1, tracker.HeldCount);
+        var releases = new INPUT[tracker.HeldCount];
+        Assert.Equal(1, tracker.CopyReleaseInputs(releases));
+        Assert.Equal((ushort)0x4B, releases[0].u.ki.wScan);
+        Assert.Equal(KEYEVENTF_SCANCODE | KEYEVENTF_EXTENDEDKEY | KEYEVENTF_KEYUP, releases[0].u.ki.dwFlags);
+    }
+
+    [Fact]
+    public void Observe_CombosClicksAndText_LeaveNothingHeld()
+    {
+        var tracker = new Win32HeldInputTracker();
+
+        tracker.Observe(new[]
+        {
+            Key(0x11, 0, 0), Key(0x43, 0, 0), Key(0x43, 0, KEYEVENTF_KEYUP), Key(0x11, 0, KEYEVENTF_KEYUP),
+            Mouse(MOUSEEVENTF_LEFTDOWN, 0), Mouse(MOUSEEVENTF_LEFTUP, 0),
+            Key(0, 'a', KEYEVENTF_UNICODE)
+        });
+
+        Assert.Equal(0, tracker.HeldCount);
+    }
+
+    [Fact]
+    public void Observe_HeldButtons_AreReleasedWithTheirButtonData()
+    {
+        var tracker = new Win32HeldInputTracker();
+
+        tracker.Observe(new[] { Mouse(MOUSEEVENTF_RIGHTDOWN, 0), Mouse(MOUSEEVENTF_XDOWN, XBUTTON2), Mouse(MOUSEEVENTF_MOVE, 0) });
+
+        var releases = new INPUT[tracker.HeldCount];
+        Assert.Equal(2, tracker.CopyReleaseInputs(releases));
+        Assert.Equal(MOUSEEVENTF_RIGHTUP, releases[0].u.mi.dwFlags);
+        Assert.Equal(MOUSEEVENTF_XUP, releases[1].u.mi.dwFlags);
+        Assert.Equal(XBUTTON2, releases[1].u.mi.mouseData);
+
+        // Held state only clears once the releases are delivered
+        Assert.Equal(2, tracker.HeldCount);
+        tracker.Observe(releases);
+        Assert.Equal(0, tracker.HeldCount);
+    }
+
+    private static INPUT Key(ushort virtualKey, ushort scanCode, uint flags) => new()
+    {
+        type = INPUT_KEYBOARD,
+        u = new InputUnion { ki = new KEYBDINPUT { wVk = virtualKey, wScan = scanCode, dwFlags = flags } }
+    };
+
+    private static INPUT Mouse(uint flags, uint mouseData) => new()
+    {
+        type = INPUT_MOUSE,
+        u = new InputUnion { mi = new MOUSEINPUT { dwFlags = flags, mouseData = mouseData } }
+    };
+}
@@ -178,6 +178,88 @@ public class Win32InputSimulatorTests : IDisposable
         Assert.True(stopwatch.ElapsedMilliseconds >= 40); // Allow some tolerance
     }
 
+    [Fact]
+    public async Task DelayAsync_UsesPrecisionTimerOnlyDuringHighResolutionSession()
+    {
+        // Arrange
+        var timer = new Mock<IPrecisionTimer>();
+        var sessions = 0;
+        timer.SetupGet(t => t.ActiveSessionCount).Returns(() => sessions);
+        timer.Setup(t => t.DelayAsync(It.IsAny<TimeSpan>(), It.IsAny<CancellationToken>()))
+            .ReturnsAsync((TimeSpan d, CancellationToken _) => new PrecisionDelayResult(d, d));
+        using var simulator = new Win32InputSimulator(_mockLogger.Object, timer.Object);
+
+        // Act
+        await simulator.DelayAsync(TimeSpan.FromMilliseconds(1));
+        sessions = 1;
+        await simulator.DelayAsync(TimeSpan.FromMilliseconds(1));
+
+        // Assert
+        timer.Verify(t => t.DelayAsync(It.IsAny<TimeSpan>(), It.IsAny<CancellationToken>()), Times.Once);
+    }
+
+    [Fact]
+    public async Task BeginBatch_BuffersInputsUntilClosed()
+    {
+        var batch = _inputSimulator.BeginBatch();
+
+        await _inputSimulator.SimulateKeyboardInputAsync("ab");
+        await _inputSimulator.SimulateKeyboardInputAsync("c");
+
+        // One key down and one key up per character, all held back for a single SendInput
+        Assert.Equal(6, batch.PendingCount);
+
+        await batch.DisposeAsync();
+        Assert.Equal(0, batch.PendingCount);
+    }
+
+    [Fact]
+    public async Task BeginBatch_WhileBatchOpen_JoinsOuterBatch()
+    {
+        var outer = _inputSimulator.BeginBatch();
+        var inner = _inputSimulator.BeginBatch();
+
+        await _inputSimulator.SimulateKeyboardInputAsync("a");
+        await inner.CommitAsync();
+
+        // Committing the nested batch leaves the inputs with the outer one
+        Assert.Equal(2, outer.PendingCount);
+        Assert.Equal(2, inner.PendingCount);
+
+        await outer.DisposeAsync();
+    }
+
+    [Fact]
+    public async Task BeginBatch_AfterBatchDiscarded_StartsEmptyBatch()
+    {
+        var first = _inputSimulator.BeginBatch();
+        await _inputSimulator.SimulateKeyboardInputAsync("a");
+        await first.DisposeAsync();
+
+        var second = _inputSimulator.BeginBatch();
+        await _inputSimulator.SimulateKeyboardInputAsync("b");
+
+        Assert.Equal(0, first.PendingCount);
+        Assert.Equal(2, second.PendingCount);
+
+        await second.DisposeAsync();
+    }
+
+    [Fact]
+    public async Task BeginBatch_OnChildFlow_DoesNotCaptureCallerInputs()
+    {
+        var child = await Task.Run(() => _inputSimulator.BeginBatch());
+        var batch = _inputSimulator.BeginBatch();
+
+        await _inputSimulator.SimulateKeyboardInputAsync("a");
+
+        Assert.Equal(2, batch.PendingCount);
+        Assert.Equal(0, child.PendingCount);
+
+        await batch.DisposeAsync();
+        await child.DisposeAsync();
+    }
+
     [Fact]
     public async Task GetCursorPositionAsync_WhenNotDisposed_ReturnsValidPoint()
     {
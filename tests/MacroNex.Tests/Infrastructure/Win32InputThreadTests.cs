@@ -0,0 +1,122 @@
+using MacroNex.Infrastructure.Win32;
+using Microsoft.Extensions.Logging.Abstractions;
+using Xunit;
+using static MacroNex.Infrastructure.Win32.Win32Structures;
+
+namespace MacroNex.Tests.Infrastructure;
+
+/// <summary>
+/// Unit tests for the shared Win32 input thread message loop.
+/// </summary>
+public class Win32InputThreadTests
+{
+    private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(5);
+
+    [Fact]
+    public async Task InvokeAsync_RunsOnInputThreadAndReturnsResult()
+    {
+        using var inputThread = new Win32InputThread(NullLogger<Win32InputThread>.Instance, new BlockingMessageApi());
+
+        var result = await inputThread.InvokeAsync(() => (inputThread.IsCurrentThread, Environment.CurrentManagedThreadId)).WaitAsync(Timeout);
+
+        Assert.True(result.IsCurrentThread);
+        Assert.NotEqual(Environment.CurrentManagedThreadId, result.CurrentManagedThreadId);
+        Assert.True(inputThread.IsRunning);
+    }
+
+    [Fact]
+    public async Task InvokeAsync_WhenFunctionThrows_FaultsTask()
+    {
+        using var inputThread = new Win32InputThread(NullLogger<Win32InputThread>.Instance, new BlockingMessageApi());
+
+        await Assert.ThrowsAsync<InvalidOperationException>(
+            () => inputThread.InvokeAsync(() => throw new InvalidOperationException("boom")).WaitAsync(Timeout));
+    }
+
+    [Fact]
+    public async Task HotkeyMessage_RaisesHotkeyPressedOnInputThread()
+    {
+        var api = new BlockingMessageApi();
+        using var inputThread = new Win32InputThread(NullLogger<Win32InputThread>.Instance, api);
+        var pressed = new TaskCompletionSource<(int Id, bool OnInputThread)>(TaskCreationOptions.RunContinuationsAsynchronously);
+        inputThread.HotkeyPressed += id => pressed.TrySetResult((id, inputThread.IsCurrentThread));
+
+        // Round-trip once so the loop is known to be running before posting
+        await inputThread.InvokeAsync(() => { }).WaitAsync(Timeout);
+        api.PostThreadMessage(inputThread.ThreadId, Win32Api.WM_HOTKEY, new IntPtr(42), IntPtr.Zero);
+
+        var (id, onInputThread) = await pressed.Task.WaitAsync(Timeout);
+        Assert.Equal(42, id);
+        Assert.True(onInputThread);
+    }
+
+    [Fact]
+    public async Task Dispose_StopsThreadAndRejectsFurtherWork()
+    {
+        var inputThread = new Win32InputThread(NullLogger<Win32InputThread>.Instance, new BlockingMessageApi());
+        await inputThread.InvokeAsync(() => { }).WaitAsync(Timeout);
+
+        inputThread.Dispose();
+
+        Assert.False(inputThread.IsRunning);
+        Assert.Throws<ObjectDisposedException>(() => inputThread.InvokeAsync(() => 1));
+    }
+
+    [Fact]
+    public void AllocateHotkeyId_ReturnsUniqueIds()
+    {
+        using var inputThread = new Win32InputThread(NullLogger<Win32InputThread>.Instance, new BlockingMessageApi());
+
+        var ids = Enumerable.Range(0, 100).AsParallel().Select(_ => inputThread.AllocateHotkeyId()).ToList();
+
+        Assert.Equal(ids.Count, ids.Distinct().Count());
+    }
+
+    /// <summary>
+    /// Message queue whose GetMessage blocks until a message is posted, like the real API.
+    /// </summary>
+    private sealed class BlockingMessageApi : IWin32HotkeyApi
+    {
+        private readonly object _lockObject = new();
+        private readonly Queue<MSG> _messageQueue = new();
+
+        public bool RegisterHotKey(IntPtr hWnd, int id, uint fsModifiers, uint vk) => true;
+        public bool UnregisterHotKey(IntPtr hWnd, int id) => true;
+
+        public bool GetMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax)
+        {
+            lock (_lockObject)
+            {
+                while (_messageQueue.Count == 0)
+                {
+                    Monitor.Wait(_lockObject);
+                }
+
+                msg = _messageQueue.Dequeue();
+                return msg.message != Win32Api.WM_QUIT;
+            }
+        }
+
+        public bool PeekMessage(out MSG msg, IntPtr hWnd, uint wMsgFilterMin, uint wMsgFilterMax, uint wRemoveMsg)
+        {
+            msg = default;
+            return false;
+        }
+
+        public bool TranslateMessage(ref MSG msg) => true;
+        public IntPtr DispatchMessage(ref MSG msg) => IntPtr.Zero;
+
+        public bool PostThreadMessage(uint idThread, uint msg, IntPtr wParam, IntPtr lParam)
+        {
+            lock (_lockObject)
+            {
+                _messageQueue.Enqueue(new MSG { message = msg, wParam = wParam, lParam = lParam });
+                Monitor.PulseAll(_lockObject);
+                return true;
+            }
+        }
+
+        public uint GetCurrentThreadId() => 7;
+        public uint GetLastError() => 0;
+    }
+}
@@ -0,0 +1,101 @@
+using MacroNex.Presentation.Services;
+using Microsoft.Extensions.Logging.Abstractions;
+using Xunit;
+
+namespace MacroNex.Tests.Presentation;
+
+/// <summary>
+/// Tests for deferring non-critical startup work until the main window is interactive.
+/// </summary>
+public class DeferredStartupServiceTests
+{
+    private readonly StartupProfiler _profiler = new(TimeSpan.Zero);
+
+    [Fact]
+    public async Task Register_BeforeStart_HoldsWorkUntilStart()
+    {
+        var startup = CreateService();
+        var ran = new List<string>();
+        startup.Register("Port scan", () => { ran.Add("ports"); return Task.CompletedTask; });
+        startup.Register("Calibration load", () => { ran.Add("calibration"); return Task.CompletedTask; });
+
+        Assert.Empty(ran);
+
+        await startup.Start();
+
+        Assert.Equal(new[] { "ports", "calibration" }, ran.ToArray());
+        Assert.True(startup.IsStarted);
+    }
+
+    [Fact]
+    public async Task Start_RunsRegisteredWorkConcurrently()
+    {
+        var startup = CreateService();
+        var gate = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var secondStarted = false;
+        startup.Register("Slow", () => gate.Task);
+        startup.Register("Fast", () => { secondStarted = true; return Task.CompletedTask; });
+
+        var all = startup.Start();
+
+        Assert.True(secondStarted);
+        Assert.False(all.IsCompleted);
+        gate.SetResult();
+        await all;
+    }
+
+    [Fact]
+    public async Task Register_AfterStart_RunsImmediately()
+    {
+        var startup = CreateService();
+        await startup.Start();
+
+        var ran = false;
+        startup.Register("Late", () => { ran = true; return Task.CompletedTask; });
+
+        Assert.True(ran);
+    }
+
+    [Fact]
+    public async Task Start_FailingWork_IsContainedAndTimed()
+    {
+        var startup = CreateService();
+        startup.Register("Auto-connect", () => throw new InvalidOperationException("no device"));
+        startup.Register("Port scan", () => Task.CompletedTask);
+
+        await startup.Start();
+
+        var deferred = _profiler.Phases.Where(p => p.IsDeferred).Select(p => p.Name).OrderBy(n => n).ToArray();
+        Assert.Equal(new[] { "Auto-connect", "Port scan" }, deferred);
+    }
+
+    [Fact]
+    public void Schedule_WithoutService_RunsNow()
+    {
+        var ran = false;
+
+        DeferredStartupService.Schedule(null, "Port scan", () => { ran = true; return Task.CompletedTask; });
+
+        Assert.True(ran);
+    }
+
+    [Fact]
+    public void Profiler_TimeToInteractive_KeepsFirstMarkAndReportsPhases()
+    {
+        using (_profiler.Measure("Host build"))
+        {
+        }
+
+        var first = _profiler.MarkInteractive();
+        Thread.Sleep(5);
+        var second = _profiler.MarkInteractive();
+
+        Assert.Equal(first, second);
+        Assert.Equal(first, _profiler.TimeToInteractive);
+        var report = _profiler.FormatReport();
+        Assert.Contains("time-to-interactive", report);
+        Assert.Contains("Host build", report);
+    }
+
+    private DeferredStartupService CreateService() => new(_profiler, NullLogger<DeferredStartupService>.Instance);
+}
@@ -49,6 +49,7 @@ public class ExecutionUsesCurrentlyEditedScriptTests
             // Script manager and other services (only needed to construct MainViewModel)
             var scriptManager = new Mock<IScriptManager>();
             scriptManager.Setup(x => x.GetAllScriptsAsync()).ReturnsAsync(Array.Empty<Script>());
+            scriptManager.Setup(x => x.GetScriptMetadataAsync()).ReturnsAsync(Array.Empty<ScriptMetadata>());
             scriptManager.Setup(x => x.RegisterAllScriptHotkeysAsync()).Returns(Task.CompletedTask);
 
             var recordingService = new Mock<IRecordingService>();
@@ -167,6 +168,7 @@ public class ExecutionUsesCurrentlyEditedScriptTests
         public Task StepExecutionAsync() => Task.CompletedTask;
         public Task TerminateExecutionAsync() => Task.CompletedTask;
         public Task<ExecutionValidationResult> ValidateScriptForExecutionAsync(Script script) => Task.FromResult(ExecutionValidationResult.Success());
+        public IReadOnlyList<ExecutionSession> GetActiveSessions() => Array.Empty<ExecutionSession>();
         public ExecutionStatistics? GetExecutionStatistics() => null;
         public TimeSpan? GetEstimatedRemainingTime() => null;
     }
@@ -177,6 +179,7 @@ public class ExecutionUsesCurrentlyEditedScriptTests
         public ArduinoConnectionState ConnectionState => ArduinoConnectionState.Disconnected;
         public bool IsConnected => false;
         public string? ConnectedPortName => null;
+        public ArduinoFirmwareCapabilities Capabilities => ArduinoFirmwareCapabilities.None;
 
 #pragma warning disable CS0067 // Events are required by IArduinoService but not used in this test double.
         public event EventHandler<ArduinoConnectionStateChangedEventArgs>? ConnectionStateChanged;
@@ -188,6 +191,10 @@ public class ExecutionUsesCurrentlyEditedScriptTests
         public Task ConnectAsync(string portName) => Task.CompletedTask;
         public Task DisconnectAsync() => Task.CompletedTask;
         public Task SendCommandAsync(ArduinoCommand command) => Task.CompletedTask;
+        public Task SendCommandsAsync(IReadOnlyList<ArduinoCommand> commands) => Task.CompletedTask;
+        public Task FlushAsync() => Task.CompletedTask;
+
+        public Task EmergencyStopAsync() => Task.CompletedTask;
     }
 }
 
@@ -0,0 +1,154 @@
+using System.Collections.Specialized;
+using System.Windows.Threading;
+using MacroNex.Presentation.Services;
+using MacroNex.Presentation.Utilities;
+using Xunit;
+
+namespace MacroNex.Tests.Presentation;
+
+/// <summary>
+/// Tests for batched UI delivery. A pump without a dispatcher applies updates inline; the deferred cases run
+/// a real dispatcher on an STA thread and pump it for a few ticks.
+/// </summary>
+public class UiUpdatePumpTests
+{
+    private static readonly TimeSpan TickInterval = TimeSpan.FromMilliseconds(10);
+
+    [Fact]
+    public void BatchQueue_WithoutDispatcher_AppliesEachPostInline()
+    {
+        var pump = new UiUpdatePump(null);
+        var applied = new List<int>();
+        var queue = pump.CreateBatchQueue<int>(batch => applied.AddRange(batch), capacity: 10);
+
+        queue.Post(1);
+        queue.Post(2);
+
+        Assert.Equal(new[] { 1, 2 }, applied);
+    }
+
+    [Fact]
+    public void LatestValue_Clear_DiscardsPendingValue()
+    {
+        RunInSta(() =>
+        {
+            using var pump = new UiUpdatePump(Dispatcher.CurrentDispatcher, TickInterval);
+            var applied = new List<string>();
+            var slot = pump.CreateLatestValue<string>(applied.Add);
+
+            slot.Post("first");
+            slot.Clear();
+            PumpDispatcher();
+
+            Assert.Empty(applied);
+
+            slot.Post("second");
+            PumpDispatcher();
+
+            Assert.Equal(new[] { "second" }, applied);
+        });
+    }
+
+    [Fact]
+    public void LatestValue_SeveralPostsBeforeTick_ApplyOnlyLatest()
+    {
+        RunInSta(() =>
+        {
+            using var pump = new UiUpdatePump(Dispatcher.CurrentDispatcher, TickInterval);
+            var applied = new List<string>();
+            var slot = pump.CreateLatestValue<string>(applied.Add);
+
+            slot.Post("first");
+            slot.Post("second");
+            slot.Post("third");
+
+            // Nothing runs until the dispatcher ticks
+            Assert.Empty(applied);
+
+            PumpDispatcher();
+
+            Assert.Equal(new[] { "third" }, applied);
+        });
+    }
+
+    [Fact]
+    public void BatchQueue_SeveralPostsBeforeTick_ApplyAsOneBatch()
+    {
+        RunInSta(() =>
+        {
+            using var pump = new UiUpdatePump(Dispatcher.CurrentDispatcher, TickInterval);
+            var batches = new List<int[]>();
+            var queue = pump.CreateBatchQueue<int>(batch => batches.Add(batch.ToArray()), capacity: 10);
+
+            for (var i = 1; i <= 5; i++)
+                queue.Post(i);
+            PumpDispatcher();
+
+            var batch = Assert.Single(batches);
+            Assert.Equal(new[] { 1, 2, 3, 4, 5 }, batch);
+        });
+    }
+
+    [Fact]
+    public void AppendRange_TrimsOldestAndRaisesSingleReset()
+    {
+        var collection = new RangeObservableCollection<int>();
+        collection.AppendRange(Enumerable.Range(0, 8).ToList());
+        var actions = new List<NotifyCollectionChangedAction>();
+        collection.CollectionChanged += (_, e) => actions.Add(e.Action);
+
+        collection.AppendRange(Enumerable.Range(8, 4).ToList(), maxCount: 10);
+
+        Assert.Equal(new[] { NotifyCollectionChangedAction.Reset }, actions);
+        Assert.Equal(Enumerable.Range(2, 10), collection);
+    }
+
+    [Fact]
+    public void AppendRange_WithBatchLargerThanLimit_KeepsNewestItems()
+    {
+        var collection = new RangeObservableCollection<int> { -1 };
+
+        collection.AppendRange(Enumerable.Range(0, 20).ToList(), maxCount: 5);
+
+        Assert.Equal(Enumerable.Range(15, 5), collection);
+    }
+
+    /// <summary>
+    /// Runs the dispatcher long enough for several pump ticks; the stop timer has a lower priority than the
+    /// pump's background timer, so a due tick always runs first.
+    /// </summary>
+    private static void PumpDispatcher()
+    {
+        var frame = new DispatcherFrame();
+        var stop = new DispatcherTimer(DispatcherPriority.ContextIdle) { Interval = TickInterval * 10 };
+        stop.Tick += (_, _) =>
+        {
+            stop.Stop();
+            frame.Continue = false;
+        };
+        stop.Start();
+        Dispatcher.PushFrame(frame);
+    }
+
+    private static void RunInSta(Action action)
+    {
+        Exception? ex = null;
+        var done = new ManualResetEventSlim(false);
+
+        var t = new Thread(() =>
+        {
+            try { action(); }
+            catch (Exception e) { ex = e; }
+            finally
+            {
+                Dispatcher.CurrentDispatcher.InvokeShutdown();
+                done.Set();
+            }
+        });
+        t.SetApartmentState(ApartmentState.STA);
+        t.Start();
+
+        Assert.True(done.Wait(TimeSpan.FromSeconds(15)), "STA test timed out");
+        if (ex != null) throw new Exception("STA test failed", ex);
+    }
+}